@@ -0,0 +1,296 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QMatrix4x4>
+#include <QTest>
+
+#include "core/region.h"
+#include "core/rendertarget.h"
+#include "core/renderviewport.h"
+#include "scene/itemgeometry.h"
+#include "utils/damagejournal.h"
+
+using namespace KWin;
+
+/*
+ * Makes the quads of a decorated window, i.e. the four decoration borders and the contents.
+ */
+static WindowQuadList makeWindowQuads(const RectF &geometry)
+{
+    const qreal border = 4;
+    const qreal titlebar = 30;
+
+    WindowQuadList quads;
+    quads.append(WindowQuad::fromRect(RectF(geometry.x(), geometry.y(), geometry.width(), titlebar)));
+    quads.append(WindowQuad::fromRect(RectF(geometry.x(), geometry.y() + titlebar, border, geometry.height() - titlebar - border)));
+    quads.append(WindowQuad::fromRect(RectF(geometry.right() - border, geometry.y() + titlebar, border, geometry.height() - titlebar - border)));
+    quads.append(WindowQuad::fromRect(RectF(geometry.x(), geometry.bottom() - border, geometry.width(), border)));
+    quads.append(WindowQuad::fromRect(geometry.adjusted(border, titlebar, -border, -border)));
+    return quads;
+}
+
+/*
+ * Makes damage that resembles a frame of a terminal, a few lines with some characters each.
+ */
+static Region makeFrameDamage(int frame)
+{
+    QList<Rect> rects;
+    for (int line = 0; line < 6; ++line) {
+        rects.append(Rect(40 + (frame * 37 + line * 11) % 600, 100 + ((frame + line) % 40) * 18, 10 * (1 + line % 4), 18));
+    }
+    return Region::fromUnsortedRects(rects);
+}
+
+class BenchmarkGeometry : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void makeGrid_data();
+    void makeGrid();
+    void makeRegularGrid_data();
+    void makeRegularGrid();
+    void appendWindowQuad_data();
+    void appendWindowQuad();
+    void appendWindowQuads_data();
+    void appendWindowQuads();
+    void writeWindowQuads();
+    void appendSubQuad();
+    void accumulateDamage_data();
+    void accumulateDamage();
+    void mapToDeviceCoordinates_data();
+    void mapToDeviceCoordinates();
+    void mapRegionToDeviceCoordinates_data();
+    void mapRegionToDeviceCoordinates();
+    void mapRegionFromDeviceCoordinates();
+};
+
+void BenchmarkGeometry::makeGrid_data()
+{
+    QTest::addColumn<int>("maxQuadSize");
+
+    // the wobbly windows effect uses small quads, the magic lamp effect bigger ones
+    QTest::addRow("10") << 10;
+    QTest::addRow("40") << 40;
+    QTest::addRow("100") << 100;
+}
+
+void BenchmarkGeometry::makeGrid()
+{
+    QFETCH(int, maxQuadSize);
+    const WindowQuadList quads = makeWindowQuads(RectF(0, 0, 1200, 800));
+
+    QBENCHMARK {
+        const WindowQuadList result = quads.makeGrid(maxQuadSize);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkGeometry::makeRegularGrid_data()
+{
+    QTest::addColumn<int>("subdivisions");
+
+    QTest::addRow("4") << 4;
+    QTest::addRow("20") << 20;
+    QTest::addRow("64") << 64;
+}
+
+void BenchmarkGeometry::makeRegularGrid()
+{
+    QFETCH(int, subdivisions);
+    const WindowQuadList quads = makeWindowQuads(RectF(0, 0, 1200, 800));
+
+    QBENCHMARK {
+        const WindowQuadList result = quads.makeRegularGrid(subdivisions, subdivisions);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkGeometry::appendWindowQuad_data()
+{
+    QTest::addColumn<RenderGeometry::VertexSnappingMode>("snappingMode");
+    QTest::addColumn<qreal>("scale");
+
+    QTest::addRow("no snapping, 1x") << RenderGeometry::VertexSnappingMode::None << 1.0;
+    QTest::addRow("snapping, 1x") << RenderGeometry::VertexSnappingMode::Round << 1.0;
+    QTest::addRow("snapping, 1.25x") << RenderGeometry::VertexSnappingMode::Round << 1.25;
+}
+
+void BenchmarkGeometry::appendWindowQuad()
+{
+    QFETCH(RenderGeometry::VertexSnappingMode, snappingMode);
+    QFETCH(qreal, scale);
+    const WindowQuadList quads = makeWindowQuads(RectF(0.5, 0.5, 1200, 800)).makeGrid(40);
+
+    QBENCHMARK {
+        RenderGeometry geometry;
+        geometry.setVertexSnappingMode(snappingMode);
+        geometry.reserve(quads.size() * 6);
+        for (const WindowQuad &quad : quads) {
+            geometry.appendWindowQuad(quad, scale);
+        }
+    }
+}
+
+void BenchmarkGeometry::appendWindowQuads_data()
+{
+    appendWindowQuad_data();
+}
+
+void BenchmarkGeometry::appendWindowQuads()
+{
+    QFETCH(RenderGeometry::VertexSnappingMode, snappingMode);
+    QFETCH(qreal, scale);
+    const WindowQuadList quads = makeWindowQuads(RectF(0.5, 0.5, 1200, 800)).makeGrid(40);
+
+    QBENCHMARK {
+        RenderGeometry geometry;
+        geometry.setVertexSnappingMode(snappingMode);
+        geometry.appendWindowQuads(quads, scale);
+    }
+}
+
+void BenchmarkGeometry::writeWindowQuads()
+{
+    const WindowQuadList quads = makeWindowQuads(RectF(0.5, 0.5, 1200, 800)).makeGrid(10);
+    QMatrix4x4 textureMatrix;
+    textureMatrix.scale(1.0 / 1200, 1.0 / 800);
+    QList<GLVertex2D> vertices(quads.size() * 6);
+
+    QBENCHMARK {
+        RenderGeometry::writeWindowQuads(vertices, quads, 1.25, RenderGeometry::VertexSnappingMode::Round, textureMatrix);
+    }
+}
+
+void BenchmarkGeometry::appendSubQuad()
+{
+    const WindowQuadList quads = makeWindowQuads(RectF(0, 0, 1200, 800));
+    const RegionF clip = makeFrameDamage(0).scaled(1.25);
+
+    QBENCHMARK {
+        RenderGeometry geometry;
+        for (const WindowQuad &quad : quads) {
+            const RectF bounds = quad.bounds().scaled(1.25);
+            for (const RectF &rect : clip.rects()) {
+                const RectF intersected = rect.intersected(bounds);
+                if (!intersected.isEmpty()) {
+                    geometry.appendSubQuad(quad, intersected, 1.25);
+                }
+            }
+        }
+    }
+}
+
+void BenchmarkGeometry::accumulateDamage_data()
+{
+    QTest::addColumn<int>("bufferAge");
+
+    QTest::addRow("1") << 1;
+    QTest::addRow("2") << 2;
+    QTest::addRow("3") << 3;
+    QTest::addRow("10") << 10;
+}
+
+void BenchmarkGeometry::accumulateDamage()
+{
+    QFETCH(int, bufferAge);
+
+    DamageJournal journal;
+    for (int frame = 0; frame < journal.capacity(); ++frame) {
+        journal.add(makeFrameDamage(frame));
+    }
+    QList<Region> damage;
+    for (int frame = 0; frame < 64; ++frame) {
+        damage.append(makeFrameDamage(frame));
+    }
+
+    // every frame adds new damage, so the cached unions are invalidated
+    int frame = 0;
+    QBENCHMARK {
+        journal.add(damage[frame++ % damage.size()]);
+        const Region result = journal.accumulate(bufferAge, Region::infinite());
+        Q_UNUSED(result)
+    }
+}
+
+static void addViewports()
+{
+    QTest::addColumn<qreal>("scale");
+    QTest::addColumn<QPoint>("renderOffset");
+
+    QTest::addRow("1x") << 1.0 << QPoint(0, 0);
+    QTest::addRow("1.25x") << 1.25 << QPoint(0, 0);
+    QTest::addRow("1.5x with offset") << 1.5 << QPoint(-64, -32);
+}
+
+void BenchmarkGeometry::mapToDeviceCoordinates_data()
+{
+    addViewports();
+}
+
+void BenchmarkGeometry::mapToDeviceCoordinates()
+{
+    QFETCH(qreal, scale);
+    QFETCH(QPoint, renderOffset);
+
+    QImage image(QSize(1920, 1080) * scale, QImage::Format_ARGB32_Premultiplied);
+    const RenderTarget renderTarget(&image);
+    const RenderViewport viewport(RectF(100, 50, 1920, 1080), scale, renderTarget, renderOffset);
+    const QList<RectF> rects = {
+        RectF(110.5, 60.25, 400, 300),
+        RectF(800, 400, 640, 480.75),
+        RectF(1500.25, 900.5, 300.5, 200.25),
+    };
+
+    QBENCHMARK {
+        for (const RectF &rect : rects) {
+            const Rect device = viewport.mapToDeviceCoordinatesAligned(rect);
+            const RectF target = viewport.mapToRenderTarget(rect);
+            Q_UNUSED(device)
+            Q_UNUSED(target)
+        }
+    }
+}
+
+void BenchmarkGeometry::mapRegionToDeviceCoordinates_data()
+{
+    addViewports();
+}
+
+void BenchmarkGeometry::mapRegionToDeviceCoordinates()
+{
+    QFETCH(qreal, scale);
+    QFETCH(QPoint, renderOffset);
+
+    QImage image(QSize(1920, 1080) * scale, QImage::Format_ARGB32_Premultiplied);
+    const RenderTarget renderTarget(&image);
+    const RenderViewport viewport(RectF(0, 0, 1920, 1080), scale, renderTarget, renderOffset);
+    const Region region = makeFrameDamage(0) | makeFrameDamage(1) | makeFrameDamage(2);
+
+    QBENCHMARK {
+        const Region result = viewport.mapToDeviceCoordinatesAligned(region);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkGeometry::mapRegionFromDeviceCoordinates()
+{
+    QImage image(QSize(2400, 1350), QImage::Format_ARGB32_Premultiplied);
+    const RenderTarget renderTarget(&image);
+    const RenderViewport viewport(RectF(0, 0, 1920, 1080), 1.25, renderTarget, QPoint(0, 0));
+    const Region region = viewport.mapToDeviceCoordinatesAligned(makeFrameDamage(0) | makeFrameDamage(1) | makeFrameDamage(2));
+
+    QBENCHMARK {
+        const Region aligned = viewport.mapFromDeviceCoordinatesAligned(region);
+        const Region contained = viewport.mapFromDeviceCoordinatesContained(region);
+        Q_UNUSED(aligned)
+        Q_UNUSED(contained)
+    }
+}
+
+QTEST_MAIN(BenchmarkGeometry)
+
+#include "benchmark_geometry.moc"
@@ -0,0 +1,247 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include "core/region.h"
+
+#include <algorithm>
+
+using namespace KWin;
+
+/*
+ * Makes a region that resembles the damage of a terminal or an IDE, i.e. lots of small
+ * rectangles scattered over a large area.
+ */
+static Region makeScatteredRegion(int columns, int rows, const QPoint &offset = QPoint(0, 0))
+{
+    QList<Rect> rects;
+    rects.reserve(columns * rows);
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            if ((row + column) % 3 == 0) {
+                continue;
+            }
+            rects.append(Rect(offset.x() + column * 24, offset.y() + row * 18, 20 + (column % 3), 14 + (row % 2)));
+        }
+    }
+    return Region::fromUnsortedRects(rects);
+}
+
+class BenchmarkRegion : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void united_data();
+    void united();
+    void subtracted_data();
+    void subtracted();
+    void intersected_data();
+    void intersected();
+    void xored_data();
+    void xored();
+    void unitedRegionF_data();
+    void unitedRegionF();
+    void subtractedRegionF_data();
+    void subtractedRegionF();
+    void intersectedRegionF_data();
+    void intersectedRegionF();
+    void translated();
+    void scaled();
+    void scaledRegionF();
+    void translatedRegionF();
+    void fromUnsortedRects();
+};
+
+static void addRegionPairs()
+{
+    QTest::addColumn<Region>("left");
+    QTest::addColumn<Region>("right");
+
+    QTest::addRow("rect and rect") << Region(0, 0, 100, 100) << Region(50, 50, 100, 100);
+    QTest::addRow("small and rect") << makeScatteredRegion(4, 4) << Region(10, 10, 60, 60);
+    QTest::addRow("large and rect") << makeScatteredRegion(80, 50) << Region(400, 300, 800, 400);
+    QTest::addRow("large and large") << makeScatteredRegion(80, 50) << makeScatteredRegion(80, 50, QPoint(7, 5));
+}
+
+void BenchmarkRegion::united_data()
+{
+    addRegionPairs();
+}
+
+void BenchmarkRegion::united()
+{
+    QFETCH(Region, left);
+    QFETCH(Region, right);
+
+    QBENCHMARK {
+        const Region result = left.united(right);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::subtracted_data()
+{
+    addRegionPairs();
+}
+
+void BenchmarkRegion::subtracted()
+{
+    QFETCH(Region, left);
+    QFETCH(Region, right);
+
+    QBENCHMARK {
+        const Region result = left.subtracted(right);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::intersected_data()
+{
+    addRegionPairs();
+}
+
+void BenchmarkRegion::intersected()
+{
+    QFETCH(Region, left);
+    QFETCH(Region, right);
+
+    QBENCHMARK {
+        const Region result = left.intersected(right);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::xored_data()
+{
+    addRegionPairs();
+}
+
+void BenchmarkRegion::xored()
+{
+    QFETCH(Region, left);
+    QFETCH(Region, right);
+
+    QBENCHMARK {
+        const Region result = left.xored(right);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::unitedRegionF_data()
+{
+    addRegionPairs();
+}
+
+void BenchmarkRegion::unitedRegionF()
+{
+    QFETCH(Region, left);
+    QFETCH(Region, right);
+
+    // a fractional scale factor produces the kind of regions that the scene deals with
+    const RegionF leftF = left.scaled(1.25);
+    const RegionF rightF = right.scaled(1.25);
+
+    QBENCHMARK {
+        const RegionF result = leftF.united(rightF);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::subtractedRegionF_data()
+{
+    addRegionPairs();
+}
+
+void BenchmarkRegion::subtractedRegionF()
+{
+    QFETCH(Region, left);
+    QFETCH(Region, right);
+
+    const RegionF leftF = left.scaled(1.25);
+    const RegionF rightF = right.scaled(1.25);
+
+    QBENCHMARK {
+        const RegionF result = leftF.subtracted(rightF);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::intersectedRegionF_data()
+{
+    addRegionPairs();
+}
+
+void BenchmarkRegion::intersectedRegionF()
+{
+    QFETCH(Region, left);
+    QFETCH(Region, right);
+
+    const RegionF leftF = left.scaled(1.25);
+    const RegionF rightF = right.scaled(1.25);
+
+    QBENCHMARK {
+        const RegionF result = leftF.intersected(rightF);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::translated()
+{
+    const Region region = makeScatteredRegion(80, 50);
+
+    QBENCHMARK {
+        const Region result = region.translated(13, -7);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::scaled()
+{
+    const Region region = makeScatteredRegion(80, 50);
+
+    QBENCHMARK {
+        const RegionF result = region.scaled(1.25);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::scaledRegionF()
+{
+    const RegionF region(makeScatteredRegion(80, 50));
+
+    QBENCHMARK {
+        const RegionF result = region.scaled(1.5, 1.25);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::translatedRegionF()
+{
+    const RegionF region(makeScatteredRegion(80, 50));
+
+    QBENCHMARK {
+        const RegionF result = region.translated(0.5, 1.5);
+        Q_UNUSED(result)
+    }
+}
+
+void BenchmarkRegion::fromUnsortedRects()
+{
+    const Region region = makeScatteredRegion(80, 50);
+    QList<Rect> rects(region.rects().begin(), region.rects().end());
+    std::reverse(rects.begin(), rects.end());
+
+    QBENCHMARK {
+        const Region result = Region::fromUnsortedRects(rects);
+        Q_UNUSED(result)
+    }
+}
+
+QTEST_MAIN(BenchmarkRegion)
+
+#include "benchmark_region.moc"
@@ -16,6 +16,7 @@
 #include "core/outputlayer.h"
 #include "core/session.h"
 #include "drm_backend.h"
+#include "drm_blob.h"
 #include "drm_connector.h"
 #include "drm_crtc.h"
 #include "drm_egl_backend.h"
@@ -30,6 +31,7 @@
 #include "wayland/drmlease_v1.h"
 #include "wayland/drmlease_v1_p.h"
 
+#include <array>
 #include <drm_fourcc.h>
 #include <fcntl.h>
 #include <sys/socket.h>
@@ -94,6 +96,7 @@ private Q_SLOTS:
     void testModeGeneration_data();
     void testModeGeneration();
     void testConnectorLifetime();
+    void testBlobSharing();
     void testModeset_data();
     void testModeset();
     void testVrrChange();
@@ -435,6 +438,42 @@ void DrmTest::testConnectorLifetime()
     verifyCleanup(mockGpu.get());
 }
 
+void DrmTest::testBlobSharing()
+{
+    const auto mockGpu = findPrimaryDevice(0);
+    const auto session = Session::create(Session::Type::Noop);
+    const auto backend = std::make_unique<DrmBackend>(session.get());
+    auto gpu = std::make_unique<DrmGpu>(backend.get(), mockGpu->fd, DrmDevice::open(mockGpu->devNode));
+    const size_t initialBlobs = mockGpu->propertyBlobs.size();
+
+    const std::array<uint16_t, 4> lut{1, 2, 3, 4};
+    const std::array<uint16_t, 4> otherLut{4, 3, 2, 1};
+
+    // blobs with the same contents should be shared
+    auto first = DrmBlob::create(gpu.get(), lut.data(), sizeof(lut));
+    auto second = DrmBlob::create(gpu.get(), lut.data(), sizeof(lut));
+    auto other = DrmBlob::create(gpu.get(), otherLut.data(), sizeof(otherLut));
+    QVERIFY(first);
+    QCOMPARE(first, second);
+    QCOMPARE_NE(first->blobId(), other->blobId());
+    QCOMPARE(mockGpu->propertyBlobs.size(), initialBlobs + 2);
+
+    // but only as long as they're in use
+    first.reset();
+    QCOMPARE(mockGpu->propertyBlobs.size(), initialBlobs + 2);
+    second.reset();
+    QCOMPARE(mockGpu->propertyBlobs.size(), initialBlobs + 1);
+
+    first = DrmBlob::create(gpu.get(), lut.data(), sizeof(lut));
+    QVERIFY(first);
+    QCOMPARE(mockGpu->propertyBlobs.size(), initialBlobs + 2);
+
+    first.reset();
+    other.reset();
+    gpu.reset();
+    verifyCleanup(mockGpu.get());
+}
+
 void DrmTest::testModeset_data()
 {
     QTest::addColumn<int>("AMS");
@@ -0,0 +1,466 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "kwin_wayland_test.h"
+
+#include "core/drmdevice.h"
+#include "core/graphicsbuffer.h"
+#include "core/graphicsbufferallocator.h"
+#include "core/output.h"
+#include "effect/effecthandler.h"
+#include "options.h"
+#include "pointer_input.h"
+#include "scene/workspacescene.h"
+#include "utils/envvar.h"
+#include "wayland-client/linuxdmabuf.h"
+#include "wayland_server.h"
+#include "window.h"
+#include "workspace.h"
+
+#include <KWayland/Client/subsurface.h>
+#include <KWayland/Client/surface.h>
+
+#include <drm_fourcc.h>
+#include <numeric>
+#include <time.h>
+
+using namespace std::chrono_literals;
+
+namespace KWin
+{
+
+static const int s_frameCount = environmentVariableIntValue("KWIN_BENCHMARK_FRAMES").value_or(120);
+
+/**
+ * The compositing benchmark drives the compositor on the virtual backend with synthetic clients
+ * and reports, for every scenario, how long the compositor took to prepare and render a frame,
+ * how much CPU time it spent on that, and the latency from a client commit to its presentation.
+ *
+ * The benchmark uses the QPainter scene by default, set KWIN_BENCHMARK_COMPOSE to O2 to use the
+ * OpenGL scene on the first render node. The number of measured frames per scenario can be set
+ * with KWIN_BENCHMARK_FRAMES.
+ */
+class CompositingBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void benchmarkWindows_data();
+    void benchmarkWindows();
+    void benchmarkShmVideo();
+    void benchmarkDmabufVideo();
+    void benchmarkSubsurfaces();
+    void benchmarkDragWindow();
+    void benchmarkOverview();
+};
+
+class FrameStatistics
+{
+public:
+    static std::chrono::nanoseconds percentile(std::vector<std::chrono::nanoseconds> samples, double percentile)
+    {
+        if (samples.empty()) {
+            return 0ns;
+        }
+        std::ranges::sort(samples);
+        const size_t index = std::min<size_t>(samples.size() - 1, samples.size() * percentile / 100);
+        return samples[index];
+    }
+
+    static std::chrono::nanoseconds average(const std::vector<std::chrono::nanoseconds> &samples)
+    {
+        if (samples.empty()) {
+            return 0ns;
+        }
+        return std::accumulate(samples.begin(), samples.end(), 0ns) / samples.size();
+    }
+
+    static void report(const char *metric, const std::vector<std::chrono::nanoseconds> &samples)
+    {
+        if (samples.empty()) {
+            return;
+        }
+        const auto toMs = [](std::chrono::nanoseconds duration) {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        };
+        qInfo("%s: %s average %.3f ms, p50 %.3f ms, p99 %.3f ms, %zu samples", QTest::currentDataTag() ? QTest::currentDataTag() : QTest::currentTestFunction(), metric,
+              toMs(average(samples)), toMs(percentile(samples, 50)), toMs(percentile(samples, 99)), samples.size());
+    }
+
+    std::vector<std::chrono::nanoseconds> frameTimes;
+    std::vector<std::chrono::nanoseconds> cpuTimes;
+    std::vector<std::chrono::nanoseconds> latencies;
+};
+
+/**
+ * Measures the time from WorkspaceScene::preFrameRender() to WorkspaceScene::frameRendered(),
+ * which covers the pre-paint pass of the effects and the scene as well as recording the frame.
+ * With the OpenGL scene that is the CPU side only, the GPU time isn't included.
+ */
+class FrameTimer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameTimer(FrameStatistics *statistics)
+        : m_statistics(statistics)
+    {
+        WorkspaceScene *scene = kwinApp()->scene();
+        connect(scene, &WorkspaceScene::preFrameRender, this, [this]() {
+            m_wallStart = std::chrono::steady_clock::now();
+            m_cpuStart = threadCpuTime();
+        });
+        connect(scene, &WorkspaceScene::frameRendered, this, [this]() {
+            if (!m_wallStart) {
+                return;
+            }
+            m_statistics->frameTimes.push_back(std::chrono::steady_clock::now() - *m_wallStart);
+            m_statistics->cpuTimes.push_back(threadCpuTime() - m_cpuStart);
+            m_wallStart.reset();
+        });
+    }
+
+private:
+    static std::chrono::nanoseconds threadCpuTime()
+    {
+        // the test clients run on the same thread, so only the time between the two signals counts
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+    }
+
+    FrameStatistics *m_statistics;
+    std::optional<std::chrono::steady_clock::time_point> m_wallStart;
+    std::chrono::nanoseconds m_cpuStart{0};
+};
+
+/**
+ * Commits a frame with @p commit, which has to commit @p surface, and waits until it's presented.
+ * Returns @c false if the frame got discarded or the presentation timed out.
+ */
+static bool commitAndWaitForPresentation(FrameStatistics &statistics, KWayland::Client::Surface *surface, const std::function<void()> &commit)
+{
+    const auto feedback = std::make_unique<Test::WpPresentationFeedback>(Test::presentationTime()->feedback(*surface));
+    QSignalSpy presentedSpy(feedback.get(), &Test::WpPresentationFeedback::presented);
+    QSignalSpy discardedSpy(feedback.get(), &Test::WpPresentationFeedback::discarded);
+    // presentation timestamps are in the CLOCK_MONOTONIC domain, like std::chrono::steady_clock
+    const std::chrono::nanoseconds commitTime = std::chrono::steady_clock::now().time_since_epoch();
+    commit();
+    if (!presentedSpy.wait() || !discardedSpy.isEmpty()) {
+        return false;
+    }
+    statistics.latencies.push_back(presentedSpy.last().at(0).value<std::chrono::nanoseconds>() - commitTime);
+    return true;
+}
+
+static void reportStatistics(const FrameStatistics &statistics)
+{
+    FrameStatistics::report("frame time", statistics.frameTimes);
+    FrameStatistics::report("cpu time", statistics.cpuTimes);
+    FrameStatistics::report("commit to present", statistics.latencies);
+    QTest::setBenchmarkResult(FrameStatistics::average(statistics.frameTimes).count(), QTest::WalltimeNanoseconds);
+}
+
+static QColor frameColor(int frame)
+{
+    return frame % 2 ? Qt::red : Qt::blue;
+}
+
+void CompositingBenchmark::initTestCase()
+{
+    const QByteArray compose = qgetenv("KWIN_BENCHMARK_COMPOSE");
+    if (!compose.isEmpty()) {
+        if (!Test::renderNodeAvailable()) {
+            QSKIP("no render node available");
+        }
+        qputenv("KWIN_COMPOSE", compose);
+    }
+
+    qRegisterMetaType<Window *>();
+    QVERIFY(waylandServer()->init(qAppName()));
+    kwinApp()->start();
+}
+
+void CompositingBenchmark::init()
+{
+    QVERIFY(Test::setupWaylandConnection(Test::AdditionalWaylandInterface::PresentationTime | Test::AdditionalWaylandInterface::LinuxDmabuf));
+
+    Test::setOutputConfig({
+        Test::OutputInfo{
+            .geometry = Rect(0, 0, 1920, 1080),
+            .modes = {
+                std::make_tuple(QSize(1920, 1080), 60'000u, OutputMode::Flag::Preferred),
+            },
+        },
+    });
+    workspace()->setActiveOutput(QPoint(960, 540));
+    input()->pointer()->warp(QPoint(960, 540));
+}
+
+void CompositingBenchmark::cleanup()
+{
+    Test::destroyWaylandConnection();
+}
+
+void CompositingBenchmark::benchmarkWindows_data()
+{
+    QTest::addColumn<int>("outputCount");
+    QTest::addColumn<int>("windowCount");
+    QTest::addColumn<int>("commitInterval");
+
+    // one window is animated on every frame, the others commit every commitInterval frames
+    QTest::addRow("50 idle windows") << 1 << 50 << 0;
+    QTest::addRow("50 idle windows on 4 outputs") << 4 << 50 << 0;
+    QTest::addRow("50 windows at a quarter of the refresh rate") << 1 << 50 << 4;
+    QTest::addRow("50 windows at the refresh rate") << 1 << 50 << 1;
+}
+
+void CompositingBenchmark::benchmarkWindows()
+{
+    QFETCH(int, outputCount);
+    QFETCH(int, windowCount);
+    QFETCH(int, commitInterval);
+
+    QList<Test::OutputInfo> outputs;
+    for (int i = 0; i < outputCount; i++) {
+        outputs.append(Test::OutputInfo{
+            .geometry = Rect(i * 1920, 0, 1920, 1080),
+            .modes = {
+                std::make_tuple(QSize(1920, 1080), 60'000u, OutputMode::Flag::Preferred),
+            },
+        });
+    }
+    Test::setOutputConfig(outputs);
+
+    std::vector<std::unique_ptr<KWayland::Client::Surface>> surfaces;
+    std::vector<std::unique_ptr<Test::XdgToplevel>> shellSurfaces;
+    for (int i = 0; i < windowCount; i++) {
+        surfaces.push_back(Test::createSurface());
+        shellSurfaces.push_back(Test::createXdgToplevelSurface(surfaces.back().get()));
+        Window *window = Test::renderAndWaitForShown(surfaces.back().get(), QSize(400, 300), Qt::darkGray);
+        QVERIFY(window);
+        // spread the windows across all outputs so that every output has something to paint
+        window->move(QPointF((i % outputCount) * 1920 + (i * 20) % 1500, (i * 15) % 700));
+    }
+
+    std::unique_ptr<KWayland::Client::Surface> surface = Test::createSurface();
+    std::unique_ptr<Test::XdgToplevel> shellSurface = Test::createXdgToplevelSurface(surface.get());
+    QVERIFY(Test::renderAndWaitForShown(surface.get(), QSize(200, 200), Qt::blue));
+
+    FrameStatistics statistics;
+    FrameTimer timer(&statistics);
+    for (int frame = 0; frame < s_frameCount; frame++) {
+        QVERIFY(commitAndWaitForPresentation(statistics, surface.get(), [&]() {
+            if (commitInterval && frame % commitInterval == 0) {
+                for (const auto &other : surfaces) {
+                    Test::render(other.get(), QSize(400, 300), frameColor(frame));
+                }
+            }
+            Test::render(surface.get(), QSize(200, 200), frameColor(frame));
+        }));
+    }
+    reportStatistics(statistics);
+}
+
+void CompositingBenchmark::benchmarkShmVideo()
+{
+    Test::setOutputConfig({
+        Test::OutputInfo{
+            .geometry = Rect(0, 0, 3840, 2160),
+            .modes = {
+                std::make_tuple(QSize(3840, 2160), 60'000u, OutputMode::Flag::Preferred),
+            },
+        },
+    });
+
+    std::unique_ptr<KWayland::Client::Surface> surface = Test::createSurface();
+    std::unique_ptr<Test::XdgToplevel> shellSurface = Test::createXdgToplevelSurface(surface.get(), [](Test::XdgToplevel *toplevel) {
+        toplevel->set_fullscreen(nullptr);
+    });
+    const QSize size(3840, 2160);
+    QVERIFY(Test::renderAndWaitForShown(surface.get(), size, Qt::black));
+
+    // prepare the frames up front, the benchmark is about the compositor and not the client
+    std::array<QImage, 2> images;
+    for (size_t i = 0; i < images.size(); i++) {
+        images[i] = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        images[i].fill(frameColor(i));
+    }
+
+    FrameStatistics statistics;
+    FrameTimer timer(&statistics);
+    for (int frame = 0; frame < s_frameCount; frame++) {
+        QVERIFY(commitAndWaitForPresentation(statistics, surface.get(), [&]() {
+            Test::render(surface.get(), images[frame % images.size()]);
+        }));
+    }
+    reportStatistics(statistics);
+}
+
+void CompositingBenchmark::benchmarkDmabufVideo()
+{
+    if (!Test::linuxDmabuf()) {
+        QSKIP("the compositor doesn't support linux-dmabuf with the selected scene");
+    }
+    const std::unique_ptr<DrmDevice> device = DrmDevice::open(Test::linuxDmabuf()->mainDevice());
+    if (!device) {
+        QSKIP("failed to open the main device of linux-dmabuf");
+    }
+
+    Test::setOutputConfig({
+        Test::OutputInfo{
+            .geometry = Rect(0, 0, 3840, 2160),
+            .modes = {
+                std::make_tuple(QSize(3840, 2160), 60'000u, OutputMode::Flag::Preferred),
+            },
+        },
+    });
+
+    std::unique_ptr<KWayland::Client::Surface> surface = Test::createSurface();
+    std::unique_ptr<Test::XdgToplevel> shellSurface = Test::createXdgToplevelSurface(surface.get(), [](Test::XdgToplevel *toplevel) {
+        toplevel->set_fullscreen(nullptr);
+    });
+
+    const QSize size(3840, 2160);
+    const auto formats = Test::linuxDmabuf()->formats();
+    std::array<GraphicsBufferRef, 2> buffers;
+    std::array<wl_buffer *, 2> wlBuffers;
+    for (size_t i = 0; i < buffers.size(); i++) {
+        buffers[i] = device->allocator()->allocate(GraphicsBufferOptions{
+            .size = size,
+            .format = DRM_FORMAT_XRGB8888,
+            .modifiers = formats[DRM_FORMAT_XRGB8888],
+            .software = false,
+        });
+        QVERIFY(buffers[i]);
+        wlBuffers[i] = Test::linuxDmabuf()->importBuffer(buffers[i].buffer());
+    }
+    const auto destroyBuffers = qScopeGuard([&wlBuffers]() {
+        for (wl_buffer *buffer : wlBuffers) {
+            wl_buffer_destroy(buffer);
+        }
+    });
+
+    surface->attachBuffer(wlBuffers[0]);
+    surface->damage(QRect(QPoint(0, 0), size));
+    surface->commit(KWayland::Client::Surface::CommitFlag::None);
+    QVERIFY(Test::waitForWaylandWindowShown());
+
+    FrameStatistics statistics;
+    FrameTimer timer(&statistics);
+    for (int frame = 0; frame < s_frameCount; frame++) {
+        QVERIFY(commitAndWaitForPresentation(statistics, surface.get(), [&]() {
+            surface->attachBuffer(wlBuffers[frame % wlBuffers.size()]);
+            surface->damage(QRect(QPoint(0, 0), size));
+            surface->commit(KWayland::Client::Surface::CommitFlag::None);
+        }));
+    }
+    reportStatistics(statistics);
+}
+
+void CompositingBenchmark::benchmarkSubsurfaces()
+{
+    std::unique_ptr<KWayland::Client::Surface> surface = Test::createSurface();
+    std::unique_ptr<Test::XdgToplevel> shellSurface = Test::createXdgToplevelSurface(surface.get());
+    QVERIFY(Test::renderAndWaitForShown(surface.get(), QSize(800, 600), Qt::darkGray));
+
+    // a video player like tree: the video, a control bar and a few overlays on top
+    std::vector<std::unique_ptr<KWayland::Client::Surface>> childSurfaces;
+    std::vector<std::unique_ptr<KWayland::Client::SubSurface>> subSurfaces;
+    for (int i = 0; i < 4; i++) {
+        childSurfaces.push_back(Test::createSurface());
+        subSurfaces.push_back(Test::createSubSurface(childSurfaces.back().get(), surface.get()));
+        subSurfaces.back()->setPosition(QPoint(i * 150, i * 100));
+        Test::render(childSurfaces.back().get(), QSize(320, 240), Qt::green);
+    }
+    surface->commit(KWayland::Client::Surface::CommitFlag::None);
+
+    FrameStatistics statistics;
+    FrameTimer timer(&statistics);
+    for (int frame = 0; frame < s_frameCount; frame++) {
+        QVERIFY(commitAndWaitForPresentation(statistics, surface.get(), [&]() {
+            // the subsurfaces are synchronized, their state is applied with the parent commit
+            for (const auto &child : childSurfaces) {
+                Test::render(child.get(), QSize(320, 240), frameColor(frame));
+            }
+            surface->commit(KWayland::Client::Surface::CommitFlag::None);
+        }));
+    }
+    reportStatistics(statistics);
+}
+
+void CompositingBenchmark::benchmarkDragWindow()
+{
+    std::unique_ptr<KWayland::Client::Surface> surface = Test::createSurface();
+    std::unique_ptr<Test::XdgToplevel> shellSurface = Test::createXdgToplevelSurface(surface.get());
+    Window *window = Test::renderAndWaitForShown(surface.get(), QSize(600, 400), Qt::blue);
+    QVERIFY(window);
+    window->move(QPointF(100, 100));
+
+    workspace()->performWindowOperation(window, Options::UnrestrictedMoveOp);
+    QCOMPARE(workspace()->moveResizeWindow(), window);
+
+    // the window doesn't commit while it's dragged, so only the compositor side can be measured
+    FrameStatistics statistics;
+    FrameTimer timer(&statistics);
+    QSignalSpy frameRenderedSpy(kwinApp()->scene(), &WorkspaceScene::frameRendered);
+    quint32 timestamp = 1;
+    for (int frame = 0; frame < s_frameCount; frame++) {
+        const int offset = (frame * 8) % 1000;
+        Test::pointerMotion(QPointF(400 + offset, 300 + offset / 2), timestamp++);
+        QVERIFY(frameRenderedSpy.wait());
+    }
+    window->keyPressEvent(Qt::Key_Escape);
+    QVERIFY(!workspace()->moveResizeWindow());
+    reportStatistics(statistics);
+}
+
+void CompositingBenchmark::benchmarkOverview()
+{
+    const QString effectName = QStringLiteral("overview");
+    if (!effects->loadEffect(effectName)) {
+        QSKIP("the overview effect isn't available");
+    }
+    const auto unloadEffect = qScopeGuard([&effectName]() {
+        effects->unloadEffect(effectName);
+    });
+
+    std::vector<std::unique_ptr<KWayland::Client::Surface>> surfaces;
+    std::vector<std::unique_ptr<Test::XdgToplevel>> shellSurfaces;
+    for (int i = 0; i < 10; i++) {
+        surfaces.push_back(Test::createSurface());
+        shellSurfaces.push_back(Test::createXdgToplevelSurface(surfaces.back().get()));
+        QVERIFY(Test::renderAndWaitForShown(surfaces.back().get(), QSize(400, 300), Qt::darkGray));
+    }
+
+    Effect *effect = effects->findEffect(effectName);
+    QVERIFY(effect);
+    QVERIFY(QMetaObject::invokeMethod(effect, "activate"));
+    QTRY_VERIFY(effects->isEffectActive(effectName));
+
+    // keep one thumbnail animated, otherwise nothing would be repainted once the overview is open
+    KWayland::Client::Surface *surface = surfaces.back().get();
+    FrameStatistics statistics;
+    FrameTimer timer(&statistics);
+    for (int frame = 0; frame < s_frameCount; frame++) {
+        QVERIFY(commitAndWaitForPresentation(statistics, surface, [&]() {
+            Test::render(surface, QSize(400, 300), frameColor(frame));
+        }));
+    }
+    reportStatistics(statistics);
+
+    QVERIFY(QMetaObject::invokeMethod(effect, "deactivate"));
+    QTRY_VERIFY(!effects->isEffectActive(effectName));
+}
+
+} // namespace KWin
+
+WAYLANDTEST_MAIN(KWin::CompositingBenchmark)
+#include "compositing_benchmark.moc"
@@ -9,6 +9,7 @@
 #include "kwin_wayland_test.h"
 
 #include "core/output.h"
+#include "input.h"
 #include "pointer_input.h"
 #include "wayland/seat.h"
 #include "wayland_server.h"
@@ -37,6 +38,7 @@ private Q_SLOTS:
     void init();
     void cleanup();
     void testPointerFocusUpdatesOnStackingOrderChange();
+    void testFindToplevelFollowsWindowChanges();
 
 private:
     void render(KWayland::Client::Surface *surface);
@@ -151,5 +153,50 @@ void InputStackingOrderTest::testPointerFocusUpdatesOnStackingOrderChange()
 
 }
 
+void InputStackingOrderTest::testFindToplevelFollowsWindowChanges()
+{
+    // this test verifies that the window at a position is found after the windows are
+    // moved, restacked or minimized, no matter in which part of the spatial index they are
+
+    std::unique_ptr<KWayland::Client::Surface> surface1 = Test::createSurface();
+    std::unique_ptr<Test::XdgToplevel> shellSurface1 = Test::createXdgToplevelSurface(surface1.get());
+    Window *window1 = Test::renderAndWaitForShown(surface1.get(), QSize(100, 50), Qt::blue);
+    QVERIFY(window1);
+    std::unique_ptr<KWayland::Client::Surface> surface2 = Test::createSurface();
+    std::unique_ptr<Test::XdgToplevel> shellSurface2 = Test::createXdgToplevelSurface(surface2.get());
+    Window *window2 = Test::renderAndWaitForShown(surface2.get(), QSize(100, 50), Qt::red);
+    QVERIFY(window2);
+
+    window1->move(QPointF(0, 0));
+    window2->move(QPointF(0, 0));
+    QCOMPARE(input()->findToplevel(QPointF(25, 25)), window2);
+
+    workspace()->raiseWindow(window1);
+    QCOMPARE(input()->findToplevel(QPointF(25, 25)), window1);
+
+    // move the second window across several cells of the index and onto the other output
+    window2->move(QPointF(2000, 900));
+    QCOMPARE(input()->findToplevel(QPointF(2025, 925)), window2);
+    QCOMPARE(input()->findToplevel(QPointF(2150, 925)), nullptr);
+    QCOMPARE(input()->findToplevel(QPointF(25, 25)), window1);
+
+    // a window that straddles a cell boundary is found on both sides of it
+    window1->move(QPointF(480, 480));
+    QCOMPARE(input()->findToplevel(QPointF(500, 500)), window1);
+    QCOMPARE(input()->findToplevel(QPointF(520, 520)), window1);
+    QCOMPARE(input()->findToplevel(QPointF(25, 25)), nullptr);
+
+    window2->setMinimized(true);
+    QCOMPARE(input()->findToplevel(QPointF(2025, 925)), nullptr);
+    window2->setMinimized(false);
+    QCOMPARE(input()->findToplevel(QPointF(2025, 925)), window2);
+
+    QSignalSpy windowClosedSpy(window2, &Window::closed);
+    shellSurface2.reset();
+    surface2.reset();
+    QVERIFY(windowClosedSpy.wait());
+    QCOMPARE(input()->findToplevel(QPointF(2025, 925)), nullptr);
+}
+
 WAYLANDTEST_MAIN(KWin::InputStackingOrderTest)
 #include "input_stacking_order.moc"
@@ -10,7 +10,10 @@
 
 #include "backends/virtual/virtual_backend.h"
 #include "compositor.h"
+#include "core/backendoutput.h"
+#include "core/outputbackend.h"
 #include "core/outputconfiguration.h"
+#include "core/renderloop_p.h"
 #include "core/session.h"
 #include "effect/effecthandler.h"
 #include "input.h"
@@ -32,13 +35,19 @@
 #include <KPluginMetaData>
 
 #include <QAbstractEventDispatcher>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QPluginLoader>
 #include <QSocketNotifier>
 #include <QThread>
 #include <QtConcurrentRun>
 
 // system
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <ranges>
 #include <sys/mman.h>
 #include <sys/socket.h>
@@ -51,6 +60,28 @@ Q_IMPORT_PLUGIN(KGlobalAccelImpl)
 Q_IMPORT_PLUGIN(KWindowSystemKWinPlugin)
 Q_IMPORT_PLUGIN(KWinIdleTimePoller)
 
+// counts the allocations of the whole test, for the metrics mode
+static std::atomic<uint64_t> s_allocationCount{0};
+
+void *operator new(std::size_t size)
+{
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
 namespace KWin
 {
 
@@ -106,12 +137,16 @@ WaylandTestApplication::WaylandTestApplication(int &argc, char **argv, bool runO
         setSession(Session::create(Session::Type::Noop));
         setOutputBackend(std::make_unique<VirtualBackend>());
     }
+    setupMetrics();
     m_waylandServer.reset(WaylandServer::create());
     setProcessStartupEnvironment(QProcessEnvironment::systemEnvironment());
 }
 
 WaylandTestApplication::~WaylandTestApplication()
 {
+    if (!m_metricsPath.isEmpty()) {
+        writeMetrics();
+    }
     setTerminating();
     // need to unload all effects prior to destroying X connection as they might do X calls
     // also before destroy Workspace, as effects might call into Workspace
@@ -187,6 +222,109 @@ void WaylandTestApplication::destroyVirtualInputDevices()
     }
 }
 
+void WaylandTestApplication::setupMetrics()
+{
+    m_metricsPath = qEnvironmentVariable("KWIN_TEST_METRICS");
+    if (m_metricsPath.isEmpty()) {
+        return;
+    }
+
+    connect(outputBackend(), &OutputBackend::outputAdded, this, &WaylandTestApplication::watchOutputMetrics);
+    const auto outputs = outputBackend()->outputs();
+    for (BackendOutput *output : outputs) {
+        watchOutputMetrics(output);
+    }
+
+    // the test functions wait in the event loop, so the allocations end up with the right test
+    connect(QAbstractEventDispatcher::instance(), &QAbstractEventDispatcher::aboutToBlock, this, &WaylandTestApplication::sampleMetrics);
+}
+
+void WaylandTestApplication::watchOutputMetrics(BackendOutput *output)
+{
+    RenderLoop *renderLoop = output->renderLoop();
+    if (!renderLoop) {
+        return;
+    }
+    connect(renderLoop, &RenderLoop::framePresented, this, [this](RenderLoop *loop) {
+        sampleMetrics();
+        if (!m_currentMetrics) {
+            return;
+        }
+        m_currentMetrics->frames++;
+        // not every backend can measure how long the frame took to render
+        if (const auto renderTime = RenderLoopPrivate::get(loop)->lastRenderTime) {
+            const std::chrono::nanoseconds duration = renderTime->end - renderTime->start;
+            m_currentMetrics->measuredFrames++;
+            m_currentMetrics->renderTime += duration;
+            m_currentMetrics->longestRenderTime = std::max(m_currentMetrics->longestRenderTime, duration);
+            m_currentMetrics->longestQueueDelay = std::max(m_currentMetrics->longestQueueDelay, renderTime->queueDelay);
+        }
+    });
+}
+
+void WaylandTestApplication::sampleMetrics()
+{
+    const uint64_t allocations = s_allocationCount.load(std::memory_order_relaxed);
+    if (m_currentMetrics) {
+        m_currentMetrics->allocations += allocations - m_metricsAllocations;
+    }
+    m_metricsAllocations = allocations;
+
+    const char *function = QTest::currentTestFunction();
+    const char *dataTag = QTest::currentDataTag();
+    if (m_metricsFunction == function && m_metricsDataTag == dataTag) {
+        return;
+    }
+    m_metricsFunction = function;
+    m_metricsDataTag = dataTag;
+
+    // startup and teardown outside of the test functions aren't recorded
+    if (!function) {
+        m_currentMetrics = nullptr;
+        return;
+    }
+    QString name = QString::fromLatin1(function);
+    if (dataTag) {
+        name += QLatin1Char(':') + QString::fromLatin1(dataTag);
+    }
+    m_currentMetrics = &m_metrics[name];
+}
+
+void WaylandTestApplication::writeMetrics()
+{
+    sampleMetrics();
+
+    const auto toMicroseconds = [](std::chrono::nanoseconds duration) {
+        return double(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    };
+
+    QJsonObject tests;
+    for (const auto &[name, metrics] : m_metrics) {
+        QJsonObject test{
+            {QStringLiteral("frames"), qint64(metrics.frames)},
+            {QStringLiteral("allocations"), qint64(metrics.allocations)},
+        };
+        if (metrics.measuredFrames) {
+            test[QStringLiteral("averageRenderTime")] = toMicroseconds(metrics.renderTime / metrics.measuredFrames);
+            test[QStringLiteral("longestRenderTime")] = toMicroseconds(metrics.longestRenderTime);
+            test[QStringLiteral("longestGpuQueueDelay")] = toMicroseconds(metrics.longestQueueDelay);
+        }
+        tests[name] = test;
+    }
+
+    const QJsonObject root{
+        {QStringLiteral("testCase"), applicationName()},
+        {QStringLiteral("tests"), tests},
+    };
+
+    QFile file(m_metricsPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to write the test metrics to" << m_metricsPath << ":" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson());
+}
+
 void WaylandTestApplication::performStartup()
 {
     if (!m_inputMethodServerToStart.isEmpty()) {
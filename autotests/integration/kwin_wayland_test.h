@@ -22,12 +22,15 @@
 #include <QSignalSpy>
 #include <QTest>
 
+#include <chrono>
+#include <map>
 #include <optional>
 
 #include <xkbcommon/xkbcommon.h>
 
 #include "qwayland-color-management-v1.h"
 #include "qwayland-color-representation-v1.h"
+#include "qwayland-commit-timing-v1.h"
 #include "qwayland-cursor-shape-v1.h"
 #include "qwayland-fake-input.h"
 #include "qwayland-fifo-v1.h"
@@ -96,6 +99,7 @@ class LinuxDmabufV1;
 class Viewporter;
 }
 
+class BackendOutput;
 class WaylandServer;
 
 #if KWIN_BUILD_X11
@@ -143,6 +147,26 @@ private:
     void createVirtualInputDevices();
     void destroyVirtualInputDevices();
 
+    /**
+     * The metrics mode is enabled by pointing KWIN_TEST_METRICS at a file. The frames and
+     * allocations are attributed to the test function that is running when they happen,
+     * and written to the file as JSON when the test finishes.
+     */
+    void setupMetrics();
+    void watchOutputMetrics(BackendOutput *output);
+    void sampleMetrics();
+    void writeMetrics();
+
+    struct TestMetrics
+    {
+        uint64_t frames = 0;
+        uint64_t measuredFrames = 0;
+        std::chrono::nanoseconds renderTime{0};
+        std::chrono::nanoseconds longestRenderTime{0};
+        std::chrono::nanoseconds longestQueueDelay{0};
+        uint64_t allocations = 0;
+    };
+
     QTemporaryDir m_temporaryHome;
     std::unique_ptr<WaylandServer> m_waylandServer;
 #if KWIN_BUILD_X11
@@ -156,6 +180,13 @@ private:
     std::unique_ptr<Test::VirtualInputDevice> m_virtualTabletPad;
     std::unique_ptr<Test::VirtualInputDevice> m_virtualTablet;
     std::unique_ptr<Test::VirtualInputDeviceTabletTool> m_virtualTabletTool;
+
+    QString m_metricsPath;
+    std::map<QString, TestMetrics> m_metrics;
+    TestMetrics *m_currentMetrics = nullptr;
+    QByteArray m_metricsFunction;
+    QByteArray m_metricsDataTag;
+    uint64_t m_metricsAllocations = 0;
 };
 
 namespace Test
@@ -803,6 +834,7 @@ enum class AdditionalWaylandInterface : uint64_t {
     LinuxDmabuf = 1ull << 31,
     ColorRepresentation = 1ull << 32,
     Viewporter = 1ull << 33,
+    CommitTimingV1 = 1ull << 34,
 };
 Q_DECLARE_FLAGS(AdditionalWaylandInterfaces, AdditionalWaylandInterface)
 
@@ -890,6 +922,13 @@ public:
     ~FifoManagerV1() override;
 };
 
+class CommitTimingManagerV1 : public QtWayland::wp_commit_timing_manager_v1
+{
+public:
+    explicit CommitTimingManagerV1(::wl_registry *registry, uint32_t id, int version);
+    ~CommitTimingManagerV1() override;
+};
+
 class PresentationTime : public QtWayland::wp_presentation
 {
 public:
@@ -1056,6 +1095,7 @@ struct Connection
     XdgWmDialogV1 *xdgWmDialogV1;
     std::unique_ptr<ColorManagerV1> colorManager;
     std::unique_ptr<FifoManagerV1> fifoManager;
+    std::unique_ptr<CommitTimingManagerV1> commitTimingManager;
     std::unique_ptr<PresentationTime> presentationTime;
     std::unique_ptr<XdgActivation> xdgActivation;
     std::unique_ptr<XdgSessionManagerV1> sessionManager;
@@ -1134,6 +1174,7 @@ FakeInput *waylandFakeInput();
 SecurityContextManagerV1 *waylandSecurityContextManagerV1();
 ColorManagerV1 *colorManager();
 FifoManagerV1 *fifoManager();
+CommitTimingManagerV1 *commitTimingManager();
 PresentationTime *presentationTime();
 XdgActivation *xdgActivation();
 WpTabletManagerV2 *tabletManager();
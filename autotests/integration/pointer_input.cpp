@@ -74,6 +74,7 @@ private Q_SLOTS:
     void testWarpingUpdatesFocus();
     void testWarpingGeneratesPointerMotion();
     void testWarpingBetweenWindows();
+    void testMotionCoalescing();
     void testUpdateFocusAfterScreenChange();
     void testUpdateFocusOnDecorationDestroy();
     void testModifierClickUnrestrictedMove_data();
@@ -245,6 +246,46 @@ void PointerInputTest::testWarpingGeneratesPointerMotion()
     QCOMPARE(movedSpy.last().first().toPointF(), QPointF(26, 26));
 }
 
+void PointerInputTest::testMotionCoalescing()
+{
+    // this test verifies that motion events which arrive faster than the refresh rate are
+    // merged into one, and that pending motion is sent before a button event
+
+    auto pointer = m_seat->createPointer(m_seat);
+    QVERIFY(pointer);
+    QVERIFY(pointer->isValid());
+    QSignalSpy enteredSpy(pointer, &KWayland::Client::Pointer::entered);
+    QSignalSpy movedSpy(pointer, &KWayland::Client::Pointer::motion);
+    QSignalSpy buttonStateChangedSpy(pointer, &KWayland::Client::Pointer::buttonStateChanged);
+
+    std::unique_ptr<KWayland::Client::Surface> surface = Test::createSurface();
+    std::unique_ptr<Test::XdgToplevel> shellSurface = Test::createXdgToplevelSurface(surface.get());
+    Window *window = Test::renderAndWaitForShown(surface.get(), QSize(100, 50), Qt::blue);
+    QVERIFY(window);
+    window->move(QPointF(0, 0));
+
+    quint32 timestamp = 1;
+    Test::pointerMotion(QPointF(25, 25), timestamp++);
+    QVERIFY(enteredSpy.wait());
+    input()->pointer()->flushCoalescedMotion();
+    QVERIFY(Test::waylandSync());
+    movedSpy.clear();
+
+    Test::pointerMotion(QPointF(30, 30), timestamp++);
+    Test::pointerMotion(QPointF(35, 35), timestamp++);
+    Test::pointerMotion(QPointF(40, 40), timestamp++);
+    QVERIFY(movedSpy.wait());
+    QCOMPARE(movedSpy.count(), 1);
+    QCOMPARE(movedSpy.last().first().toPointF(), QPointF(40, 40));
+
+    Test::pointerMotion(QPointF(45, 45), timestamp++);
+    Test::pointerButtonPressed(BTN_LEFT, timestamp++);
+    QVERIFY(buttonStateChangedSpy.wait());
+    QCOMPARE(movedSpy.count(), 2);
+    QCOMPARE(movedSpy.last().first().toPointF(), QPointF(45, 45));
+    Test::pointerButtonReleased(BTN_LEFT, timestamp++);
+}
+
 void PointerInputTest::testWarpingBetweenWindows()
 {
     // This test verifies that the compositor will send correct events when the pointer
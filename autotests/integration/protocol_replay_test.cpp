@@ -0,0 +1,823 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "kwin_wayland_test.h"
+
+#include "scene/workspacescene.h"
+#include "utils/envvar.h"
+#include "utils/filedescriptor.h"
+#include "utils/memorymap.h"
+#include "wayland/display.h"
+#include "wayland_server.h"
+#include "window.h"
+#include "workspace.h"
+
+#include "wayland-viewporter-client-protocol.h"
+
+#include <QTemporaryDir>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+
+namespace KWin
+{
+
+/**
+ * The protocol replay test replays a trace recorded with Display::startProtocolTrace() against
+ * the compositor running on the virtual backend. Set KWIN_PROTOCOL_REPLAY_TRACE to the trace file
+ * and run the replayTrace test function to turn a recorded session into a repeatable benchmark.
+ * KWIN_PROTOCOL_REPLAY_SPEED scales the original timing of the requests, 0 replays them as fast
+ * as possible.
+ */
+class ProtocolReplayTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void testRecordAndReplay();
+    void replayTrace();
+};
+
+struct TraceRecord
+{
+    enum class Kind {
+        Connect,
+        Disconnect,
+        Request,
+        Event,
+        Buffer,
+    };
+
+    qint64 time = 0;
+    int client = 0;
+    Kind kind = Kind::Request;
+    QByteArray interface;
+    uint32_t object = 0;
+    uint32_t opcode = 0;
+    QByteArray message;
+    // the arguments of requests and events with their type prefix, or the fields of a buffer
+    QList<QByteArray> arguments;
+
+    QByteArray argument(int index) const
+    {
+        // strip the type prefix
+        return arguments.value(index).mid(2);
+    }
+};
+
+static std::optional<QList<TraceRecord>> readTrace(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+
+    QList<TraceRecord> records;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        const QList<QByteArray> fields = line.split(' ');
+        if (fields.size() < 3) {
+            return std::nullopt;
+        }
+
+        TraceRecord record;
+        record.time = fields[0].toLongLong();
+        record.client = fields[1].toInt();
+        if (fields[2] == "connect") {
+            record.kind = TraceRecord::Kind::Connect;
+        } else if (fields[2] == "disconnect") {
+            record.kind = TraceRecord::Kind::Disconnect;
+        } else if (fields[2] == "buffer" && fields.size() >= 8) {
+            record.kind = TraceRecord::Kind::Buffer;
+            record.object = fields[3].toUInt();
+            record.arguments = fields.mid(4);
+        } else if ((fields[2] == "request" || fields[2] == "event") && fields.size() >= 7) {
+            record.kind = fields[2] == "request" ? TraceRecord::Kind::Request : TraceRecord::Kind::Event;
+            record.interface = fields[3];
+            record.object = fields[4].toUInt();
+            record.opcode = fields[5].toUInt();
+            record.message = fields[6];
+            record.arguments = fields.mid(7);
+        } else {
+            return std::nullopt;
+        }
+        records.append(record);
+    }
+    return records;
+}
+
+/**
+ * The interfaces of the globals that can be replayed. The interfaces of all other objects are
+ * found through the messages that create them.
+ */
+static const wl_interface *globalInterface(const QByteArray &name)
+{
+    static const std::array<const wl_interface *, 15> interfaces{
+        &wl_compositor_interface,
+        &wl_subcompositor_interface,
+        &wl_shm_interface,
+        &wl_seat_interface,
+        &wl_output_interface,
+        &wl_data_device_manager_interface,
+        &xdg_wm_base_interface,
+        &wp_viewporter_interface,
+        &wp_presentation_interface,
+        &wp_fractional_scale_manager_v1_interface,
+        &zxdg_decoration_manager_v1_interface,
+        &wp_cursor_shape_manager_v1_interface,
+        &xdg_activation_v1_interface,
+        &wp_fifo_manager_v1_interface,
+        &wp_commit_timing_manager_v1_interface,
+    };
+    for (const wl_interface *interface : interfaces) {
+        if (name == interface->name) {
+            return interface;
+        }
+    }
+    return nullptr;
+}
+
+// the ids of the objects that are created by the compositor start here
+static constexpr uint32_t s_serverIdStart = 0xff000000;
+
+struct SerialArgument
+{
+    const char *interface;
+    const char *message;
+    int index;
+};
+
+// serials differ between the recording and the replay, they have to be translated
+static const SerialArgument s_serialEvents[] = {
+    {"xdg_surface", "configure", 0},
+    {"xdg_wm_base", "ping", 0},
+    {"wl_pointer", "enter", 0},
+    {"wl_pointer", "leave", 0},
+    {"wl_pointer", "button", 0},
+    {"wl_keyboard", "enter", 0},
+    {"wl_keyboard", "leave", 0},
+    {"wl_keyboard", "key", 0},
+    {"wl_keyboard", "modifiers", 0},
+    {"wl_touch", "down", 0},
+    {"wl_touch", "up", 0},
+    {"wl_data_device", "enter", 0},
+};
+
+static const SerialArgument s_serialRequests[] = {
+    {"xdg_surface", "ack_configure", 0},
+    {"xdg_wm_base", "pong", 0},
+    {"wl_pointer", "set_cursor", 0},
+    {"xdg_toplevel", "move", 1},
+    {"xdg_toplevel", "resize", 1},
+    {"xdg_toplevel", "show_window_menu", 1},
+    {"xdg_popup", "grab", 1},
+    {"wl_data_device", "start_drag", 3},
+    {"wl_data_device", "set_selection", 1},
+    {"wl_data_offer", "accept", 0},
+    {"wp_cursor_shape_device_v1", "set_shape", 0},
+};
+
+static int serialIndex(std::span<const SerialArgument> table, const char *interface, const char *message)
+{
+    for (const SerialArgument &argument : table) {
+        if (!std::strcmp(argument.interface, interface) && !std::strcmp(argument.message, message)) {
+            return argument.index;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Skips the "since" version and the nullability markers in a message signature.
+ */
+static const char *nextArgument(const char *signature)
+{
+    while (*signature && (std::isdigit(*signature) || *signature == '?')) {
+        ++signature;
+    }
+    return signature;
+}
+
+class ProtocolReplay
+{
+public:
+    explicit ProtocolReplay(const QList<TraceRecord> &records);
+    ~ProtocolReplay();
+
+    void run(double speed);
+
+    int replayedRequests = 0;
+    int skippedRequests = 0;
+
+private:
+    struct ShmPool
+    {
+        FileDescriptor fd;
+        MemoryMap map;
+    };
+
+    struct ShmBuffer
+    {
+        uint32_t pool;
+        int offset;
+        int stride;
+        int height;
+    };
+
+    struct Global
+    {
+        uint32_t name;
+        uint32_t version;
+    };
+
+    struct Client
+    {
+        wl_display *display = nullptr;
+        QHash<uint32_t, wl_proxy *> objects;
+        QHash<wl_proxy *, uint32_t> traceIds;
+        QHash<uint32_t, const wl_interface *> interfaces;
+        QHash<uint32_t, uint32_t> serials;
+        QHash<QByteArray, QList<Global>> globals;
+        QHash<uint32_t, std::pair<QByteArray, int>> traceGlobals;
+        QHash<QByteArray, int> traceGlobalCounts;
+        QHash<std::pair<uint32_t, uint32_t>, QList<const TraceRecord *>> traceEvents;
+        QHash<std::pair<uint32_t, uint32_t>, int> eventCounts;
+        std::map<uint32_t, ShmPool> pools;
+        QHash<uint32_t, ShmBuffer> buffers;
+    };
+
+    static int dispatchEvent(const void *implementation, void *target, uint32_t opcode, const wl_message *message, wl_argument *arguments);
+
+    void connectClient(int id);
+    void disconnectClient(int id);
+    void addObject(Client *client, uint32_t id, wl_proxy *proxy, const wl_interface *interface);
+    void removeObject(Client *client, uint32_t id);
+    void handleEvent(Client *client, wl_proxy *proxy, uint32_t opcode, const wl_message *message, wl_argument *arguments);
+    void recordTraceEvent(Client *client, const TraceRecord &record);
+    bool replayRequest(Client *client, const TraceRecord &record);
+    void fillBuffer(Client *client, const TraceRecord &record);
+    FileDescriptor createFileDescriptor(Client *client, const TraceRecord &record);
+    void dispatch();
+    bool waitFor(const std::function<bool()> &condition);
+
+    const QList<TraceRecord> m_records;
+    std::map<int, std::unique_ptr<Client>> m_clients;
+};
+
+ProtocolReplay::ProtocolReplay(const QList<TraceRecord> &records)
+    : m_records(records)
+{
+}
+
+ProtocolReplay::~ProtocolReplay()
+{
+    while (!m_clients.empty()) {
+        disconnectClient(m_clients.begin()->first);
+    }
+}
+
+void ProtocolReplay::run(double speed)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const qint64 firstTime = m_records.isEmpty() ? 0 : m_records.first().time;
+
+    // events are matched with the recorded ones by their object and their position
+    QHash<int, QHash<std::pair<uint32_t, uint32_t>, QList<const TraceRecord *>>> traceEvents;
+    for (const TraceRecord &record : m_records) {
+        if (record.kind == TraceRecord::Kind::Event) {
+            traceEvents[record.client][std::make_pair(record.object, record.opcode)].append(&record);
+        }
+    }
+
+    for (const TraceRecord &record : m_records) {
+        if (speed > 0) {
+            const auto deadline = start + std::chrono::microseconds(qint64((record.time - firstTime) / speed));
+            while (std::chrono::steady_clock::now() < deadline) {
+                dispatch();
+                QTest::qWait(1);
+            }
+        }
+
+        switch (record.kind) {
+        case TraceRecord::Kind::Connect:
+            connectClient(record.client);
+            if (auto it = m_clients.find(record.client); it != m_clients.end()) {
+                it->second->traceEvents = traceEvents.take(record.client);
+            }
+            break;
+        case TraceRecord::Kind::Disconnect:
+            disconnectClient(record.client);
+            break;
+        case TraceRecord::Kind::Request:
+            if (auto it = m_clients.find(record.client); it != m_clients.end() && replayRequest(it->second.get(), record)) {
+                replayedRequests++;
+            } else {
+                skippedRequests++;
+            }
+            break;
+        case TraceRecord::Kind::Event:
+            if (auto it = m_clients.find(record.client); it != m_clients.end()) {
+                recordTraceEvent(it->second.get(), record);
+            }
+            break;
+        case TraceRecord::Kind::Buffer:
+            if (auto it = m_clients.find(record.client); it != m_clients.end()) {
+                fillBuffer(it->second.get(), record);
+            }
+            break;
+        }
+        dispatch();
+    }
+
+    // let the compositor catch up with the last requests
+    waitFor([]() {
+        return false;
+    });
+}
+
+void ProtocolReplay::connectClient(int id)
+{
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets) < 0) {
+        qWarning() << "Failed to create a socket pair for client" << id;
+        return;
+    }
+    if (!waylandServer()->display()->createClient(sockets[0])) {
+        close(sockets[0]);
+        close(sockets[1]);
+        return;
+    }
+    wl_display *display = wl_display_connect_to_fd(sockets[1]);
+    if (!display) {
+        close(sockets[1]);
+        return;
+    }
+
+    auto client = std::make_unique<Client>();
+    client->display = display;
+    // the display can't get a dispatcher, it has its own listener already
+    client->objects.insert(1, reinterpret_cast<wl_proxy *>(display));
+    client->interfaces.insert(1, &wl_display_interface);
+    m_clients[id] = std::move(client);
+}
+
+void ProtocolReplay::disconnectClient(int id)
+{
+    auto it = m_clients.find(id);
+    if (it == m_clients.end()) {
+        return;
+    }
+    Client *client = it->second.get();
+    for (auto object = client->objects.cbegin(); object != client->objects.cend(); ++object) {
+        if (object.key() != 1) {
+            wl_proxy_destroy(object.value());
+        }
+    }
+    wl_display_flush(client->display);
+    wl_display_disconnect(client->display);
+    m_clients.erase(it);
+}
+
+void ProtocolReplay::addObject(Client *client, uint32_t id, wl_proxy *proxy, const wl_interface *interface)
+{
+    removeObject(client, id);
+    client->objects.insert(id, proxy);
+    client->traceIds.insert(proxy, id);
+    client->interfaces.insert(id, interface);
+    wl_proxy_add_dispatcher(proxy, dispatchEvent, this, client);
+}
+
+void ProtocolReplay::removeObject(Client *client, uint32_t id)
+{
+    if (wl_proxy *proxy = client->objects.take(id)) {
+        client->traceIds.remove(proxy);
+        client->interfaces.remove(id);
+        client->pools.erase(id);
+        client->buffers.remove(id);
+        wl_proxy_destroy(proxy);
+    }
+}
+
+int ProtocolReplay::dispatchEvent(const void *implementation, void *target, uint32_t opcode, const wl_message *message, wl_argument *arguments)
+{
+    wl_proxy *proxy = static_cast<wl_proxy *>(target);
+    Client *client = static_cast<Client *>(wl_proxy_get_user_data(proxy));
+    static_cast<ProtocolReplay *>(const_cast<void *>(implementation))->handleEvent(client, proxy, opcode, message, arguments);
+    return 0;
+}
+
+void ProtocolReplay::handleEvent(Client *client, wl_proxy *proxy, uint32_t opcode, const wl_message *message, wl_argument *arguments)
+{
+    const uint32_t id = client->traceIds.value(proxy);
+    const wl_interface *interface = client->interfaces.value(id);
+    if (!id || !interface) {
+        return;
+    }
+
+    if (interface == &wl_registry_interface && !std::strcmp(message->name, "global")) {
+        client->globals[arguments[1].s].append(Global{
+            .name = arguments[0].u,
+            .version = arguments[2].u,
+        });
+        return;
+    }
+
+    const auto key = std::make_pair(id, opcode);
+    const int index = client->eventCounts[key]++;
+    const TraceRecord *record = client->traceEvents.value(key).value(index);
+    if (!record) {
+        return;
+    }
+
+    const int serial = serialIndex(s_serialEvents, interface->name, message->name);
+    const char *signature = message->signature;
+    for (int i = 0; *(signature = nextArgument(signature)); ++i, ++signature) {
+        if (i == serial) {
+            client->serials.insert(record->argument(i).toUInt(), arguments[i].u);
+        } else if (*signature == 'n' && arguments[i].o) {
+            // objects created by the compositor, e.g. a wl_data_offer
+            addObject(client, record->argument(i).toUInt(), reinterpret_cast<wl_proxy *>(arguments[i].o), message->types[i]);
+        }
+    }
+}
+
+void ProtocolReplay::recordTraceEvent(Client *client, const TraceRecord &record)
+{
+    if (record.interface == "wl_registry" && record.message == "global") {
+        const QByteArray interface = QByteArray::fromPercentEncoding(record.argument(1));
+        const int index = client->traceGlobalCounts[interface]++;
+        client->traceGlobals.insert(record.argument(0).toUInt(), std::make_pair(interface, index));
+    } else if (record.interface == "wl_display" && record.message == "delete_id") {
+        // objects that are destroyed by the compositor, e.g. wl_callback
+        removeObject(client, record.argument(0).toUInt());
+    }
+}
+
+FileDescriptor ProtocolReplay::createFileDescriptor(Client *client, const TraceRecord &record)
+{
+    if (record.interface == "wl_shm" && record.message == "create_pool") {
+        const uint32_t id = record.argument(0).toUInt();
+        const int size = record.argument(2).toInt();
+        FileDescriptor fd(memfd_create("kwin-protocol-replay", MFD_CLOEXEC));
+        if (!fd.isValid() || ftruncate(fd.get(), size) != 0) {
+            return FileDescriptor();
+        }
+        client->pools[id] = ShmPool{
+            .fd = fd.duplicate(),
+            .map = MemoryMap(size, PROT_READ | PROT_WRITE, MAP_SHARED, fd.get(), 0),
+        };
+        return fd;
+    }
+
+    // the contents of all other file descriptors aren't known, give the compositor something harmless
+    int pipeFds[2];
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+        return FileDescriptor();
+    }
+    close(pipeFds[0]);
+    return FileDescriptor(pipeFds[1]);
+}
+
+bool ProtocolReplay::replayRequest(Client *client, const TraceRecord &record)
+{
+    if (record.object >= s_serverIdStart) {
+        waitFor([client, &record]() {
+            return client->objects.contains(record.object);
+        });
+    }
+    wl_proxy *proxy = client->objects.value(record.object);
+    const wl_interface *interface = client->interfaces.value(record.object);
+    if (!proxy || !interface || record.opcode >= uint32_t(interface->method_count)) {
+        return false;
+    }
+    const wl_message &message = interface->methods[record.opcode];
+    if (record.message != message.name) {
+        return false;
+    }
+
+    const bool bind = interface == &wl_registry_interface && record.opcode == WL_REGISTRY_BIND;
+    const int serial = serialIndex(s_serialRequests, interface->name, message.name);
+
+    std::vector<wl_argument> arguments(record.arguments.size());
+    std::list<QByteArray> strings;
+    std::list<wl_array> arrays;
+    std::vector<FileDescriptor> fds;
+    const wl_interface *newInterface = nullptr;
+    uint32_t newId = 0;
+    uint32_t version = wl_proxy_get_version(proxy);
+
+    const char *signature = message.signature;
+    for (int i = 0; *(signature = nextArgument(signature)); ++i, ++signature) {
+        if (i >= record.arguments.size()) {
+            return false;
+        }
+        const QByteArray value = record.argument(i);
+        switch (*signature) {
+        case 'i':
+            arguments[i].i = value.toInt();
+            break;
+        case 'u':
+            arguments[i].u = value.toUInt();
+            if (i == serial) {
+                waitFor([client, serial = arguments[i].u]() {
+                    return client->serials.contains(serial);
+                });
+                arguments[i].u = client->serials.value(arguments[i].u, arguments[i].u);
+            }
+            break;
+        case 'f':
+            arguments[i].f = value.toInt();
+            break;
+        case 's':
+            if (record.arguments[i] == "s!") {
+                arguments[i].s = nullptr;
+            } else {
+                arguments[i].s = strings.emplace_back(QByteArray::fromPercentEncoding(value)).constData();
+            }
+            break;
+        case 'o':
+            if (const uint32_t object = value.toUInt()) {
+                if (object >= s_serverIdStart) {
+                    waitFor([client, object]() {
+                        return client->objects.contains(object);
+                    });
+                }
+                wl_proxy *argument = client->objects.value(object);
+                if (!argument) {
+                    // a request that refers to something that couldn't be replayed
+                    return false;
+                }
+                arguments[i].o = reinterpret_cast<wl_object *>(argument);
+            } else {
+                arguments[i].o = nullptr;
+            }
+            break;
+        case 'n':
+            newId = value.toUInt();
+            newInterface = message.types[i];
+            arguments[i].o = nullptr;
+            break;
+        case 'a': {
+            const QByteArray data = QByteArray::fromHex(value);
+            wl_array &array = arrays.emplace_back();
+            wl_array_init(&array);
+            std::memcpy(wl_array_add(&array, data.size()), data.constData(), data.size());
+            arguments[i].a = &array;
+            break;
+        }
+        case 'h': {
+            FileDescriptor &fd = fds.emplace_back(createFileDescriptor(client, record));
+            if (!fd.isValid()) {
+                return false;
+            }
+            arguments[i].h = fd.get();
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+
+    if (bind) {
+        // the names of the globals are different, pick the same global of the same interface
+        const QByteArray name = QByteArray::fromPercentEncoding(record.argument(1));
+        newInterface = globalInterface(name);
+        if (!newInterface) {
+            return false;
+        }
+        waitFor([client, &name]() {
+            return client->globals.contains(name);
+        });
+        const auto traceGlobal = client->traceGlobals.value(arguments[0].u, std::make_pair(name, 0));
+        const QList<Global> globals = client->globals.value(name);
+        if (globals.isEmpty()) {
+            return false;
+        }
+        const Global &global = globals.value(traceGlobal.second, globals.constLast());
+        version = std::min({arguments[2].u, global.version, uint32_t(newInterface->version)});
+        arguments[0].u = global.name;
+        arguments[2].u = version;
+    }
+
+    const bool destructor = record.message == "destroy" || record.message == "release";
+    wl_proxy *created = wl_proxy_marshal_array_flags(proxy, record.opcode, newInterface, version, destructor ? WL_MARSHAL_FLAG_DESTROY : 0, arguments.data());
+    for (wl_array &array : arrays) {
+        wl_array_release(&array);
+    }
+
+    if (destructor) {
+        // the proxy is gone already
+        client->traceIds.remove(proxy);
+        client->objects.remove(record.object);
+        client->interfaces.remove(record.object);
+        client->pools.erase(record.object);
+        client->buffers.remove(record.object);
+    }
+    if (created && newInterface) {
+        addObject(client, newId, created, newInterface);
+        if (newInterface == &wl_buffer_interface && client->pools.contains(record.object)) {
+            client->buffers[newId] = ShmBuffer{
+                .pool = record.object,
+                .offset = record.argument(1).toInt(),
+                .stride = record.argument(4).toInt(),
+                .height = record.argument(3).toInt(),
+            };
+        }
+    }
+
+    if (record.interface == "wl_shm_pool" && record.message == "resize") {
+        auto pool = client->pools.find(record.object);
+        if (pool != client->pools.end()) {
+            const int size = record.argument(0).toInt();
+            if (ftruncate(pool->second.fd.get(), size) == 0) {
+                pool->second.map = MemoryMap(size, PROT_READ | PROT_WRITE, MAP_SHARED, pool->second.fd.get(), 0);
+            }
+        }
+    }
+
+    wl_display_flush(client->display);
+    return true;
+}
+
+void ProtocolReplay::fillBuffer(Client *client, const TraceRecord &record)
+{
+    const auto buffer = client->buffers.constFind(record.object);
+    if (buffer == client->buffers.constEnd()) {
+        return;
+    }
+    const auto pool = client->pools.find(buffer->pool);
+    if (pool == client->pools.end() || !pool->second.map.isValid()) {
+        return;
+    }
+    const MemoryMap &map = pool->second.map;
+    const qsizetype size = qsizetype(buffer->stride) * buffer->height;
+    if (buffer->offset < 0 || buffer->offset + size > map.size()) {
+        return;
+    }
+
+    // the pixels aren't recorded, but changing them whenever the hash changes keeps the work
+    // of the compositor close to the recording, e.g. for uploading textures
+    const QByteArray hash = record.arguments.value(4);
+    const uint32_t color = hash == "-" ? 0xff808080 : 0xff000000 | hash.toUInt(nullptr, 16);
+    uint32_t *pixels = reinterpret_cast<uint32_t *>(static_cast<char *>(map.data()) + buffer->offset);
+    std::fill(pixels, pixels + size / 4, color);
+}
+
+void ProtocolReplay::dispatch()
+{
+    QCoreApplication::processEvents();
+    for (auto &[id, client] : m_clients) {
+        wl_display *display = client->display;
+        wl_display_flush(display);
+        while (wl_display_prepare_read(display) != 0) {
+            wl_display_dispatch_pending(display);
+        }
+        pollfd pfd{
+            .fd = wl_display_get_fd(display),
+            .events = POLLIN,
+            .revents = 0,
+        };
+        if (poll(&pfd, 1, 0) > 0) {
+            wl_display_read_events(display);
+        } else {
+            wl_display_cancel_read(display);
+        }
+        wl_display_dispatch_pending(display);
+    }
+}
+
+bool ProtocolReplay::waitFor(const std::function<bool()> &condition)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.durationElapsed() > 500ms) {
+            return false;
+        }
+        dispatch();
+        QTest::qWait(1);
+    }
+    return true;
+}
+
+void ProtocolReplayTest::initTestCase()
+{
+    qRegisterMetaType<Window *>();
+    QVERIFY(waylandServer()->init(qAppName()));
+    kwinApp()->start();
+    Test::setOutputConfig({
+        Rect(0, 0, 1280, 1024),
+    });
+}
+
+void ProtocolReplayTest::init()
+{
+    workspace()->setActiveOutput(QPoint(640, 512));
+}
+
+void ProtocolReplayTest::cleanup()
+{
+    waylandServer()->display()->stopProtocolTrace();
+}
+
+void ProtocolReplayTest::testRecordAndReplay()
+{
+    // record a client that shows a window and changes its contents a few times
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString fileName = directory.filePath(QStringLiteral("trace"));
+    QVERIFY(waylandServer()->display()->startProtocolTrace(fileName, true));
+
+    QVERIFY(Test::setupWaylandConnection());
+    {
+        std::unique_ptr<KWayland::Client::Surface> surface = Test::createSurface();
+        std::unique_ptr<Test::XdgToplevel> shellSurface = Test::createXdgToplevelSurface(surface.get());
+        Window *window = Test::renderAndWaitForShown(surface.get(), QSize(100, 50), Qt::blue);
+        QVERIFY(window);
+        for (const QColor &color : {Qt::red, Qt::green, Qt::blue}) {
+            QSignalSpy damagedSpy(window, &Window::damaged);
+            Test::render(surface.get(), QSize(100, 50), color);
+            QVERIFY(damagedSpy.wait());
+        }
+        shellSurface.reset();
+        QVERIFY(Test::waitForWindowClosed(window));
+    }
+    Test::destroyWaylandConnection();
+    waylandServer()->display()->stopProtocolTrace();
+
+    const std::optional<QList<TraceRecord>> records = readTrace(fileName);
+    QVERIFY(records);
+    const auto buffers = std::ranges::count_if(*records, [](const TraceRecord &record) {
+        return record.kind == TraceRecord::Kind::Buffer && record.arguments.value(4) != "-";
+    });
+    QCOMPARE(buffers, 4);
+
+    // the replayed client must show a window again
+    QSignalSpy windowAddedSpy(workspace(), &Workspace::windowAdded);
+    ProtocolReplay replay(*records);
+    replay.run(0);
+    QCOMPARE(windowAddedSpy.count(), 1);
+    QCOMPARE_GT(replay.replayedRequests, 0);
+}
+
+void ProtocolReplayTest::replayTrace()
+{
+    const QString fileName = qEnvironmentVariable("KWIN_PROTOCOL_REPLAY_TRACE");
+    if (fileName.isEmpty()) {
+        QSKIP("KWIN_PROTOCOL_REPLAY_TRACE is not set");
+    }
+    const std::optional<QList<TraceRecord>> records = readTrace(fileName);
+    QVERIFY2(records, qPrintable(QStringLiteral("Failed to read %1").arg(fileName)));
+
+    std::vector<std::chrono::nanoseconds> frameTimes;
+    std::optional<std::chrono::steady_clock::time_point> frameStart;
+    WorkspaceScene *scene = kwinApp()->scene();
+    connect(scene, &WorkspaceScene::preFrameRender, this, [&frameStart]() {
+        frameStart = std::chrono::steady_clock::now();
+    });
+    connect(scene, &WorkspaceScene::frameRendered, this, [&frameStart, &frameTimes]() {
+        if (frameStart) {
+            frameTimes.push_back(std::chrono::steady_clock::now() - *frameStart);
+            frameStart.reset();
+        }
+    });
+    const auto disconnectScene = qScopeGuard([this, scene]() {
+        disconnect(scene, nullptr, this, nullptr);
+    });
+
+    const double speed = qEnvironmentVariable("KWIN_PROTOCOL_REPLAY_SPEED", QStringLiteral("1")).toDouble();
+    ProtocolReplay replay(*records);
+    QElapsedTimer timer;
+    timer.start();
+    replay.run(speed);
+
+    std::ranges::sort(frameTimes);
+    const auto toMs = [](std::chrono::nanoseconds duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+    qInfo("replayed %d requests, skipped %d, in %.1f ms", replay.replayedRequests, replay.skippedRequests, double(timer.elapsed()));
+    if (!frameTimes.empty()) {
+        qInfo("rendered %zu frames, frame time p50 %.3f ms, p99 %.3f ms, max %.3f ms", frameTimes.size(),
+              toMs(frameTimes[frameTimes.size() / 2]), toMs(frameTimes[frameTimes.size() * 99 / 100]), toMs(frameTimes.back()));
+    }
+}
+
+} // namespace KWin
+
+WAYLANDTEST_MAIN(KWin::ProtocolReplayTest)
+#include "protocol_replay_test.moc"
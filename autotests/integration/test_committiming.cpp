@@ -0,0 +1,159 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "kwin_wayland_test.h"
+
+#include "core/output.h"
+#include "pointer_input.h"
+#include "wayland_server.h"
+#include "window.h"
+#include "workspace.h"
+
+#include <KWayland/Client/surface.h>
+
+using namespace std::chrono_literals;
+
+namespace KWin
+{
+
+class CommitTimingTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void testTimestamp();
+    void testTimestampInThePast();
+    void testTimestampWhileHidden();
+};
+
+class CommitTimerV1 : public QtWayland::wp_commit_timer_v1
+{
+public:
+    explicit CommitTimerV1(::wp_commit_timer_v1 *obj)
+        : QtWayland::wp_commit_timer_v1(obj)
+    {
+    }
+
+    ~CommitTimerV1() override
+    {
+        wp_commit_timer_v1_destroy(object());
+    }
+
+    void setTimestamp(std::chrono::nanoseconds timestamp)
+    {
+        const uint64_t seconds = std::chrono::duration_cast<std::chrono::seconds>(timestamp).count();
+        const uint32_t nanoseconds = (timestamp - std::chrono::seconds(seconds)).count();
+        set_timestamp(seconds >> 32, seconds & 0xffffffff, nanoseconds);
+    }
+};
+
+static std::chrono::nanoseconds now()
+{
+    return std::chrono::steady_clock::now().time_since_epoch();
+}
+
+void CommitTimingTest::initTestCase()
+{
+    qRegisterMetaType<Window *>();
+
+    QVERIFY(waylandServer()->init(qAppName()));
+    kwinApp()->start();
+    Test::setOutputConfig({
+        Test::OutputInfo{
+            .geometry = Rect(0, 0, 200, 200),
+            .modes = {
+                std::make_tuple(QSize(200, 200), 60'000, OutputMode::Flag::Preferred),
+            },
+        },
+    });
+}
+
+void CommitTimingTest::init()
+{
+    QVERIFY(Test::setupWaylandConnection(Test::AdditionalWaylandInterface::CommitTimingV1 | Test::AdditionalWaylandInterface::PresentationTime));
+
+    workspace()->setActiveOutput(QPoint(100, 100));
+    input()->pointer()->warp(QPoint(100, 100));
+}
+
+void CommitTimingTest::cleanup()
+{
+    Test::destroyWaylandConnection();
+}
+
+void CommitTimingTest::testTimestamp()
+{
+    // a commit with a timestamp must not be presented before that time, but close to it
+    std::unique_ptr<KWayland::Client::Surface> surface(Test::createSurface());
+    std::unique_ptr<Test::XdgToplevel> shellSurface(Test::createXdgToplevelSurface(surface.get()));
+    auto window = Test::renderAndWaitForShown(surface.get(), QSize(100, 50), Qt::blue);
+    QVERIFY(window);
+
+    auto timer = std::make_unique<CommitTimerV1>(Test::commitTimingManager()->get_timer(*surface));
+
+    const auto target = now() + 200ms;
+    auto feedback = std::make_unique<Test::WpPresentationFeedback>(Test::presentationTime()->feedback(*surface));
+    timer->setTimestamp(target);
+    surface->commit(KWayland::Client::Surface::CommitFlag::None);
+
+    QSignalSpy presented(feedback.get(), &Test::WpPresentationFeedback::presented);
+    QVERIFY(presented.wait(500));
+    const auto timestamp = presented.last().at(0).value<std::chrono::nanoseconds>();
+    const auto refreshDuration = presented.last().at(1).value<std::chrono::nanoseconds>();
+    QCOMPARE_GT(timestamp, target - refreshDuration);
+    QCOMPARE_LT(timestamp, target + refreshDuration * 2);
+}
+
+void CommitTimingTest::testTimestampInThePast()
+{
+    // a timestamp that has already passed doesn't delay the commit
+    std::unique_ptr<KWayland::Client::Surface> surface(Test::createSurface());
+    std::unique_ptr<Test::XdgToplevel> shellSurface(Test::createXdgToplevelSurface(surface.get()));
+    auto window = Test::renderAndWaitForShown(surface.get(), QSize(100, 50), Qt::blue);
+    QVERIFY(window);
+
+    auto timer = std::make_unique<CommitTimerV1>(Test::commitTimingManager()->get_timer(*surface));
+
+    const auto before = now();
+    auto feedback = std::make_unique<Test::WpPresentationFeedback>(Test::presentationTime()->feedback(*surface));
+    timer->setTimestamp(before - 1s);
+    surface->commit(KWayland::Client::Surface::CommitFlag::None);
+
+    QSignalSpy presented(feedback.get(), &Test::WpPresentationFeedback::presented);
+    QVERIFY(presented.wait(100));
+    QCOMPARE_LT(now() - before, 100ms);
+}
+
+void CommitTimingTest::testTimestampWhileHidden()
+{
+    // even if the surface isn't painted, the commit must be applied once its time has come
+    std::unique_ptr<KWayland::Client::Surface> surface(Test::createSurface());
+    std::unique_ptr<Test::XdgToplevel> shellSurface(Test::createXdgToplevelSurface(surface.get()));
+    auto window = Test::renderAndWaitForShown(surface.get(), QSize(100, 50), Qt::blue);
+    QVERIFY(window);
+    window->setMinimized(true);
+
+    auto timer = std::make_unique<CommitTimerV1>(Test::commitTimingManager()->get_timer(*surface));
+
+    const auto target = now() + 100ms;
+    auto feedback = std::make_unique<Test::WpPresentationFeedback>(Test::presentationTime()->feedback(*surface));
+    timer->setTimestamp(target);
+    surface->commit(KWayland::Client::Surface::CommitFlag::None);
+    // another commit, so that the first one gets discarded once it has been applied
+    surface->commit(KWayland::Client::Surface::CommitFlag::None);
+
+    QSignalSpy discarded(feedback.get(), &Test::WpPresentationFeedback::discarded);
+    QVERIFY(discarded.wait(500));
+    QCOMPARE_GE(now(), target);
+}
+}
+
+WAYLANDTEST_MAIN(KWin::CommitTimingTest)
+#include "test_committiming.moc"
@@ -539,6 +539,11 @@ std::unique_ptr<Connection> Connection::setup(AdditionalWaylandInterfaces flags)
                 c->fifoManager = std::make_unique<FifoManagerV1>(*c->registry, name, version);
             }
         }
+        if (flags & AdditionalWaylandInterface::CommitTimingV1) {
+            if (interface == wp_commit_timing_manager_v1_interface.name) {
+                c->commitTimingManager = std::make_unique<CommitTimingManagerV1>(*c->registry, name, version);
+            }
+        }
         if (interface == wp_presentation_interface.name) {
             c->presentationTime = std::make_unique<PresentationTime>(*c->registry, name, version);
         }
@@ -716,6 +721,7 @@ Connection::~Connection()
     xdgWmDialogV1 = nullptr;
     colorManager.reset();
     fifoManager.reset();
+    commitTimingManager.reset();
     presentationTime.reset();
     xdgActivation.reset();
     sessionManager.reset();
@@ -895,6 +901,11 @@ FifoManagerV1 *fifoManager()
     return s_waylandConnection->fifoManager.get();
 }
 
+CommitTimingManagerV1 *commitTimingManager()
+{
+    return s_waylandConnection->commitTimingManager.get();
+}
+
 PresentationTime *presentationTime()
 {
     return s_waylandConnection->presentationTime.get();
@@ -1966,6 +1977,16 @@ FifoManagerV1::~FifoManagerV1()
     wp_fifo_manager_v1_destroy(object());
 }
 
+CommitTimingManagerV1::CommitTimingManagerV1(::wl_registry *registry, uint32_t id, int version)
+    : QtWayland::wp_commit_timing_manager_v1(registry, id, version)
+{
+}
+
+CommitTimingManagerV1::~CommitTimingManagerV1()
+{
+    wp_commit_timing_manager_v1_destroy(object());
+}
+
 PresentationTime::PresentationTime(::wl_registry *registry, uint32_t id, int version)
     : QtWayland::wp_presentation(registry, id, version)
 {
@@ -39,6 +39,7 @@ private Q_SLOTS:
     void testScrollContinuous_data();
     void testScrollContinuous();
     void testMotion();
+    void testAccumulateMotion();
     void testAbsoluteMotion();
 
 private:
@@ -270,6 +271,31 @@ void TestLibinputPointerEvent::testMotion()
     QCOMPARE(pe->delta(), QPointF(2.1, 4.5));
 }
 
+void TestLibinputPointerEvent::testAccumulateMotion()
+{
+    // this test verifies that merging motion events adds up the deltas and keeps the latest time
+    libinput_event_pointer *first = new libinput_event_pointer;
+    first->device = m_nativeDevice;
+    first->type = LIBINPUT_EVENT_POINTER_MOTION;
+    first->delta = QPointF(2.1, 4.5);
+    first->time = 500ms;
+    libinput_event_pointer *second = new libinput_event_pointer;
+    second->device = m_nativeDevice;
+    second->type = LIBINPUT_EVENT_POINTER_MOTION;
+    second->delta = QPointF(-1, 0.5);
+    second->time = 501ms;
+
+    std::unique_ptr<Event> firstEvent(Event::create(first));
+    std::unique_ptr<Event> secondEvent(Event::create(second));
+    auto pe = static_cast<PointerEvent *>(firstEvent.get());
+    pe->accumulateMotion(*static_cast<PointerEvent *>(secondEvent.get()));
+    secondEvent.reset();
+
+    QCOMPARE(pe->time(), 501ms);
+    QCOMPARE(pe->delta(), QPointF(1.1, 5));
+    QCOMPARE(pe->deltaUnaccelerated(), QPointF(1.1, 5));
+}
+
 void TestLibinputPointerEvent::testAbsoluteMotion()
 {
     // this test verifies absolute pointer motion
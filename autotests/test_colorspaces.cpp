@@ -7,8 +7,10 @@
 #include <QImage>
 #include <QTest>
 
+#include "core/colorlut3d.h"
 #include "core/colorpipeline.h"
 #include "core/colorspace.h"
+#include "core/colortransformation.h"
 #include "core/iccprofile.h"
 #include "opengl/eglcontext.h"
 #include "opengl/egldisplay.h"
@@ -49,6 +51,7 @@ private Q_SLOTS:
     void testBlackPointCompensation();
     void testSCRGB();
     void testNightLightNoTonemapping();
+    void testLut3DSamples();
 };
 
 static bool compareVectors(const QVector3D &one, const QVector3D &two, float maxDifference)
@@ -294,18 +297,22 @@ void TestColorspaces::testOpenglShader_data()
 {
     QTest::addColumn<RenderingIntent>("intent");
     QTest::addColumn<double>("maxError");
+    QTest::addColumn<bool>("specialized");
 
     // the allowed error here needs to be this high because of llvmpipe. With real GPU drivers it's lower
-    QTest::addRow("Perceptual") << RenderingIntent::Perceptual << 7.0;
-    QTest::addRow("RelativeColorimetric") << RenderingIntent::RelativeColorimetric << 1.5;
-    QTest::addRow("AbsoluteColorimetricNoAdaptation") << RenderingIntent::AbsoluteColorimetricNoAdaptation << 1.5;
-    QTest::addRow("RelativeColorimetricWithBPC") << RenderingIntent::RelativeColorimetricWithBPC << 1.5;
+    QTest::addRow("Perceptual") << RenderingIntent::Perceptual << 7.0 << false;
+    QTest::addRow("RelativeColorimetric") << RenderingIntent::RelativeColorimetric << 1.5 << false;
+    QTest::addRow("AbsoluteColorimetricNoAdaptation") << RenderingIntent::AbsoluteColorimetricNoAdaptation << 1.5 << false;
+    QTest::addRow("RelativeColorimetricWithBPC") << RenderingIntent::RelativeColorimetricWithBPC << 1.5 << false;
+    QTest::addRow("Perceptual specialized") << RenderingIntent::Perceptual << 7.0 << true;
+    QTest::addRow("RelativeColorimetric specialized") << RenderingIntent::RelativeColorimetric << 1.5 << true;
 }
 
 void TestColorspaces::testOpenglShader()
 {
     QFETCH(RenderingIntent, intent);
     QFETCH(double, maxError);
+    QFETCH(bool, specialized);
 
     const auto display = EglDisplay::create(eglGetDisplay(EGL_DEFAULT_DISPLAY));
     const auto context = EglContext::create(display.get(), EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT);
@@ -336,7 +343,8 @@ void TestColorspaces::testOpenglShader()
 
     QImage openGlResult;
     {
-        ShaderBinder binder(ShaderTrait::MapTexture | ShaderTrait::TransformColorspace);
+        const ShaderTraits traits = ShaderTrait::MapTexture | ShaderTrait::TransformColorspace;
+        ShaderBinder binder(specialized ? ShaderManager::instance()->shader(traits, ColorspaceShape::create(src, dst, intent)) : ShaderManager::instance()->shader(traits));
         QMatrix4x4 proj;
         proj.ortho(QRectF(0, 0, input.width(), input.height()));
         binder.shader()->setUniform(GLShader::Mat4Uniform::ModelViewProjectionMatrix, proj);
@@ -689,6 +697,20 @@ void TestColorspaces::testNightLightNoTonemapping()
     QVERIFY(std::holds_alternative<InverseColorTransferFunction>(pipeline.ops[2].operation));
 }
 
+void TestColorspaces::testLut3DSamples()
+{
+    ColorLUT3D lut(ColorTransformation::createScalingTransform(QVector3D(0.5, 1, 0.25)), 3, 5, 9);
+    // the lattice is cached on the first lookup, every lookup must still get its own value
+    for (size_t z = 0; z < 9; z++) {
+        for (size_t y = 0; y < 5; y++) {
+            for (size_t x = 0; x < 3; x++) {
+                const QVector3D expected(0.5 * x / 2.0, y / 4.0, 0.25 * z / 8.0);
+                QVERIFY((lut.sample(x, y, z) - expected).length() < 0.0001);
+            }
+        }
+    }
+}
+
 QTEST_MAIN(TestColorspaces)
 
 #include "test_colorspaces.moc"
@@ -22,6 +22,8 @@ private Q_SLOTS:
     void benchmarkTraceOff();
     void benchmarkTraceDurationOff();
     void enable();
+    void benchmarkTraceOn();
+    void disable();
 
 private:
     QTemporaryFile m_tempFile;
@@ -65,6 +67,32 @@ void TestFTrace::enable()
     QCOMPARE(m_tempFile.readLine(), "TEST_DURATIONboo begin_ctx=1\n");
     QCOMPARE(m_tempFile.readLine(), "TEST123foo\n");
     QCOMPARE(m_tempFile.readLine(), "TEST_DURATIONboo end_ctx=1\n");
+
+    fTrace("Frame (", QStringLiteral("DP-1"), ") pageflip=", qint64(-42), " mode=", QByteArrayLiteral("vsync"));
+    QCOMPARE(m_tempFile.readLine(), "Frame (DP-1) pageflip=-42 mode=vsync\n");
+}
+
+void TestFTrace::benchmarkTraceOn()
+{
+    QVERIFY(KWin::FTraceLogger::self()->isEnabled());
+    QBENCHMARK {
+        fTrace("BENCH", 123, "foo");
+    }
+}
+
+void TestFTrace::disable()
+{
+    m_tempFile.readAll();
+
+    KWin::FTraceLogger::self()->setEnabled(false);
+    QVERIFY(!KWin::FTraceLogger::self()->isEnabled());
+    fTrace("TEST", 123, "foo");
+    QVERIFY(m_tempFile.readAll().isEmpty());
+
+    KWin::FTraceLogger::self()->setEnabled(true);
+    QVERIFY(KWin::FTraceLogger::self()->isEnabled());
+    fTrace("TEST", 456, "bar");
+    QCOMPARE(m_tempFile.readLine(), "TEST456bar\n");
 }
 
 QTEST_MAIN(TestFTrace)
@@ -207,6 +207,8 @@ private Q_SLOTS:
     void scaled();
     void scaledAndRoundedOut_data();
     void scaledAndRoundedOut();
+    void simplified();
+    void simplifiedFragmented();
     void fromSortedRects();
     void fromUnsortedRects();
     void fromRectsSortedByY();
@@ -590,6 +592,48 @@ void TestRegion::scaledAndRoundedOut()
     QTEST(region.scaledAndRoundedOut(scale), "expected");
 }
 
+void TestRegion::simplified()
+{
+    for (const Region &region : m_regions) {
+        for (int maxRectCount = 1; maxRectCount < 4; ++maxRectCount) {
+            const Region simplified = region.simplified(maxRectCount);
+            QVERIFY(simplified.rects().size() <= maxRectCount);
+            QCOMPARE(simplified.united(region), simplified);
+            if (region.rects().size() <= maxRectCount) {
+                QCOMPARE(simplified, region);
+            }
+        }
+    }
+
+    QCOMPARE(Region::infinite().simplified(1), Region::infinite());
+}
+
+void TestRegion::simplifiedFragmented()
+{
+    // a line of text, every glyph is a rect
+    QList<Rect> glyphs;
+    for (int i = 0; i < 100; ++i) {
+        glyphs.append(Rect(i * 10, 0, 9, 18));
+    }
+    QCOMPARE(Region::fromSortedRects(glyphs).simplified(16), Region(Rect(0, 0, 999, 18)));
+
+    // two lines far apart stay separate
+    QList<Rect> lines = glyphs;
+    for (int i = 0; i < 100; ++i) {
+        lines.append(Rect(i * 10, 500, 9, 18));
+    }
+    QCOMPARE(Region::fromSortedRects(lines).simplified(16), Region(Rect(0, 0, 999, 18)) | Rect(0, 500, 999, 18));
+
+    // a checkerboard can't be merged without adding a lot of area, so it ends up as the bounding rect
+    QList<Rect> checkerboard;
+    for (int y = 0; y < 40; ++y) {
+        for (int x = y % 2; x < 40; x += 2) {
+            checkerboard.append(Rect(x, y, 1, 1));
+        }
+    }
+    QCOMPARE(Region::fromSortedRects(checkerboard).simplified(16), Region(Rect(0, 0, 40, 40)));
+}
+
 template<typename T>
 static QList<T> spanToList(const QSpan<const T> &span)
 {
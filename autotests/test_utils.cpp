@@ -13,6 +13,7 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include "utils/damagejournal.h"
 #include "utils/ramfile.h"
 
 #include <QTest>
@@ -25,6 +26,8 @@ class TestUtils : public QObject
 private Q_SLOTS:
     void testRamFile();
     void testSealedRamFile();
+    void testDamageJournal();
+    void testDamageJournalCapacity();
 };
 
 static const QByteArray s_testByteArray = QByteArrayLiteral("Test Data \0\1\2\3");
@@ -67,5 +70,58 @@ void TestUtils::testSealedRamFile()
 #endif
 }
 
+void TestUtils::testDamageJournal()
+{
+    DamageJournal journal;
+    journal.setCapacity(3);
+
+    // An empty journal can't provide any damage.
+    QCOMPARE(journal.accumulate(1, Region::infinite()), Region::infinite());
+
+    journal.add(Region(0, 0, 10, 10));
+    journal.add(Region(10, 0, 10, 10));
+    journal.add(Region(20, 0, 10, 10));
+    QCOMPARE(journal.lastDamage(), Region(20, 0, 10, 10));
+
+    QCOMPARE(journal.accumulate(0, Region::infinite()), Region::infinite());
+    QCOMPARE(journal.accumulate(1, Region::infinite()), Region());
+    QCOMPARE(journal.accumulate(2, Region::infinite()), Region(20, 0, 10, 10));
+    QCOMPARE(journal.accumulate(3, Region::infinite()), Region(10, 0, 20, 10));
+    QCOMPARE(journal.accumulate(4, Region::infinite()), Region::infinite());
+
+    // The oldest damage must be evicted, and the cached unions must be discarded.
+    journal.add(Region(30, 0, 10, 10));
+    QCOMPARE(journal.lastDamage(), Region(30, 0, 10, 10));
+    QCOMPARE(journal.accumulate(2, Region::infinite()), Region(30, 0, 10, 10));
+    QCOMPARE(journal.accumulate(3, Region::infinite()), Region(20, 0, 20, 10));
+
+    journal.clear();
+    QCOMPARE(journal.accumulate(1, Region::infinite()), Region::infinite());
+}
+
+void TestUtils::testDamageJournalCapacity()
+{
+    DamageJournal journal;
+    journal.setCapacity(4);
+    for (int i = 0; i < 6; ++i) {
+        journal.add(Region(i * 10, 0, 10, 10));
+    }
+
+    // Shrinking the journal keeps the most recent damage.
+    journal.setCapacity(2);
+    QCOMPARE(journal.capacity(), 2);
+    QCOMPARE(journal.lastDamage(), Region(50, 0, 10, 10));
+    QCOMPARE(journal.accumulate(2, Region::infinite()), Region(50, 0, 10, 10));
+    QCOMPARE(journal.accumulate(3, Region::infinite()), Region::infinite());
+
+    // Growing the journal keeps the existing damage and makes room for more.
+    journal.setCapacity(3);
+    journal.add(Region(60, 0, 10, 10));
+    QCOMPARE(journal.lastDamage(), Region(60, 0, 10, 10));
+    QCOMPARE(journal.accumulate(3, Region::infinite()), Region(50, 0, 20, 10));
+    journal.add(Region(70, 0, 10, 10));
+    QCOMPARE(journal.accumulate(3, Region::infinite()), Region(60, 0, 20, 10));
+}
+
 QTEST_MAIN(TestUtils)
 #include "test_utils.moc"
@@ -1949,6 +1949,23 @@ void TestWaylandSeat::testKeymap()
     address = reinterpret_cast<char *>(file.map(0, keymapChangedSpy.first().last().value<quint32>()));
     QVERIFY(address);
     QCOMPARE(qstrcmp(address, "bar"), 0);
+    file.close();
+
+    // going back to the previous keymap
+    keymapChangedSpy.clear();
+    m_seatInterface->keyboard()->setKeymap(QByteArrayLiteral("foo"));
+    QVERIFY(keymapChangedSpy.wait());
+    fd = keymapChangedSpy.first().first().toInt();
+    QVERIFY(fd != -1);
+    QVERIFY(file.open(fd, QIODevice::ReadOnly));
+    address = reinterpret_cast<char *>(file.map(0, keymapChangedSpy.first().last().value<quint32>()));
+    QVERIFY(address);
+    QCOMPARE(qstrcmp(address, "foo"), 0);
+
+    // setting the same keymap again doesn't send it again
+    keymapChangedSpy.clear();
+    m_seatInterface->keyboard()->setKeymap(QByteArrayLiteral("foo"));
+    QVERIFY(!keymapChangedSpy.wait(100));
 }
 
 QTEST_GUILESS_MAIN(TestWaylandSeat)
@@ -58,6 +58,8 @@ private Q_SLOTS:
     void testIcon();
     void testPid();
     void testApplicationMenu();
+    void testStackingOrderCoalesced();
+    void testGeometryCoalesced();
 
     void cleanup();
 
@@ -599,5 +601,49 @@ void TestWindowManagement::testApplicationMenu()
     QCOMPARE(m_window->applicationMenuObjectPath(), objectPath);
 }
 
+void TestWindowManagement::testStackingOrderCoalesced()
+{
+    const QString first = QStringLiteral("{6a2e0c0a-4a6c-4b7e-9c43-8e2f1b6d6c01}");
+    const QString second = QStringLiteral("{6a2e0c0a-4a6c-4b7e-9c43-8e2f1b6d6c02}");
+    QSignalSpy stackingOrderSpy(m_windowManagement, &KWayland::Client::PlasmaWindowManagement::stackingOrderUuidsChanged);
+    m_windowManagementInterface->setStackingOrderUuids({first, second});
+    QVERIFY(stackingOrderSpy.wait());
+    stackingOrderSpy.clear();
+
+    // several changes in a row only result in one update with the last stacking order
+    m_windowManagementInterface->setStackingOrderUuids({second, first});
+    m_windowManagementInterface->setStackingOrderUuids({first});
+    m_windowManagementInterface->setStackingOrderUuids({second, first});
+    QVERIFY(stackingOrderSpy.wait());
+    QCOMPARE(m_windowManagement->stackingOrderUuids(), (QList<QString>{second, first}));
+    QVERIFY(!stackingOrderSpy.wait(100));
+    QCOMPARE(stackingOrderSpy.count(), 1);
+
+    // changes that cancel out aren't sent at all
+    m_windowManagementInterface->setStackingOrderUuids({first, second});
+    m_windowManagementInterface->setStackingOrderUuids({second, first});
+    QVERIFY(!stackingOrderSpy.wait(100));
+    QCOMPARE(stackingOrderSpy.count(), 1);
+}
+
+void TestWindowManagement::testGeometryCoalesced()
+{
+    QSignalSpy windowGeometryChangedSpy(m_window, &KWayland::Client::PlasmaWindow::geometryChanged);
+    QSignalSpy titleChangedSpy(m_window, &KWayland::Client::PlasmaWindow::titleChanged);
+
+    // an interactive move changes the geometry many times per frame
+    for (int i = 0; i < 10; ++i) {
+        m_windowInterface->setGeometry(QRect(i, i, 100, 50));
+    }
+    m_windowInterface->setTitle(QStringLiteral("first"));
+    m_windowInterface->setTitle(QStringLiteral("second"));
+    QVERIFY(windowGeometryChangedSpy.wait());
+    QCOMPARE(m_window->geometry(), QRect(9, 9, 100, 50));
+    QCOMPARE(m_window->title(), QStringLiteral("second"));
+    QVERIFY(!windowGeometryChangedSpy.wait(100));
+    QCOMPARE(windowGeometryChangedSpy.count(), 1);
+    QCOMPARE(titleChangedSpy.count(), 1);
+}
+
 QTEST_MAIN(TestWindowManagement)
 #include "test_wayland_windowmanagement.moc"
@@ -0,0 +1,94 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+// Qt
+#include <QFileInfo>
+#include <QTest>
+// WaylandServer
+#include "wayland/clientconnection.h"
+#include "wayland/display.h"
+#include "wayland/inputlatency.h"
+// system
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace KWin;
+using namespace std::chrono_literals;
+
+class TestInputLatency : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testHistogram();
+    void testTracker();
+};
+
+void TestInputLatency::testHistogram()
+{
+    InputLatencyHistogram histogram;
+    QCOMPARE(histogram.count(), uint64_t(0));
+    QVERIFY(histogram.percentile(50) == 0us);
+
+    for (int i = 0; i < 98; i++) {
+        histogram.record(4500us);
+    }
+    histogram.record(20200us);
+    histogram.record(500ms);
+
+    QCOMPARE(histogram.count(), uint64_t(100));
+    QVERIFY(histogram.percentile(50) == 5ms);
+    QVERIFY(histogram.percentile(99) == 21ms);
+    QVERIFY(histogram.percentile(100) == 500ms);
+    QVERIFY(histogram.maximum() == 500ms);
+    QVERIFY(histogram.average() == std::chrono::microseconds((98 * 4500 + 20200 + 500000) / 100));
+
+    const QVariantMap map = histogram.toVariantMap();
+    QCOMPARE(map[QStringLiteral("count")].toULongLong(), 100ull);
+    const QVariantList buckets = map[QStringLiteral("buckets")].toList();
+    QCOMPARE(buckets.size(), qsizetype(InputLatencyHistogram::s_bucketCount + 1));
+    QCOMPARE(buckets[4].toULongLong(), 98ull);
+    QCOMPARE(buckets[20].toULongLong(), 1ull);
+    QCOMPARE(buckets.last().toULongLong(), 1ull);
+}
+
+void TestInputLatency::testTracker()
+{
+    KWin::Display display;
+    display.addSocketName(QStringLiteral("kwin-wayland-server-input-latency-test"));
+    display.start();
+
+    int sv[2];
+    QVERIFY(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) >= 0);
+    ClientConnection *client = display.createClient(sv[0]);
+    QVERIFY(client);
+
+    InputLatencyTracker *tracker = display.inputLatencyTracker();
+    QVERIFY(!tracker->takeFeedback(client));
+
+    // the latency is measured from the oldest input the client hasn't reacted to yet
+    tracker->inputDelivered(client, 1000us);
+    tracker->inputDelivered(client, 3000us);
+    const std::shared_ptr<InputLatencyFeedback> feedback = tracker->takeFeedback(client);
+    QVERIFY(feedback);
+    QVERIFY(!tracker->takeFeedback(client));
+
+    feedback->presented(16ms, 11500us, PresentationMode::VSync);
+    QVERIFY(feedback->isPresented());
+    // presenting the same buffer again doesn't produce another sample
+    feedback->presented(16ms, 28000us, PresentationMode::VSync);
+
+    const QVariantMap statistics = tracker->statistics();
+    const QString name = QFileInfo(QCoreApplication::applicationFilePath()).fileName();
+    QCOMPARE(statistics.keys(), QStringList{name});
+    const QVariantMap clientStatistics = statistics[name].toMap();
+    QCOMPARE(clientStatistics[QStringLiteral("count")].toULongLong(), 1ull);
+    QCOMPARE(clientStatistics[QStringLiteral("maximum")].toDouble(), 10500.0);
+
+    client->destroy();
+    close(sv[1]);
+}
+
+QTEST_GUILESS_MAIN(TestInputLatency)
+#include "test_inputlatency.moc"
@@ -67,6 +67,8 @@ void Activities::slotServiceStatusChanged()
     if (m_controller->serviceStatus() != KActivities::Consumer::Running) {
         return;
     }
+    // restack once after all windows are updated, rather than once per window
+    StackingUpdatesBlocker blocker(Workspace::self());
     const auto windows = Workspace::self()->windows();
     for (auto *const window : windows) {
         if (!window->isClient()) {
@@ -106,11 +108,13 @@ void Activities::slotCurrentChanged(const QString &newActivity)
     if (m_previous != nullUuid()) {
         m_lastVirtualDesktop[m_previous] = VirtualDesktopManager::self()->currentDesktop()->id();
     }
+    // switching the desktop updates the windows for the new activity already
+    m_switchedDesktop = false;
     const auto it = m_lastVirtualDesktop.find(m_current);
     if (it != m_lastVirtualDesktop.end()) {
         VirtualDesktop *desktop = VirtualDesktopManager::self()->desktopForId(it->second);
         if (desktop) {
-            VirtualDesktopManager::self()->setCurrent(desktop);
+            m_switchedDesktop = VirtualDesktopManager::self()->setCurrent(desktop);
         }
     }
 
@@ -119,6 +123,7 @@ void Activities::slotCurrentChanged(const QString &newActivity)
 
 void Activities::slotRemoved(const QString &activity)
 {
+    StackingUpdatesBlocker blocker(Workspace::self());
     const auto windows = Workspace::self()->windows();
     for (auto *const window : windows) {
         if (!window->isClient()) {
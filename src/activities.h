@@ -49,6 +49,12 @@ public:
     const QString &current() const;
     const QString &previous() const;
 
+    /**
+     * Returns @c true if the last change of the current activity also switched the virtual
+     * desktop. The visibility of the windows has been updated for the new activity then.
+     */
+    bool switchedDesktop() const;
+
     static QString nullUuid();
 
     KActivities::Controller::ServiceStatus serviceStatus() const;
@@ -90,6 +96,7 @@ private:
     KActivities::Controller *m_controller;
     std::unordered_map<QString, QString> m_lastVirtualDesktop;
     KSharedConfig::Ptr m_config;
+    bool m_switchedDesktop = false;
 };
 
 inline QStringList Activities::all() const
@@ -107,6 +114,11 @@ inline const QString &Activities::previous() const
     return m_previous;
 }
 
+inline bool Activities::switchedDesktop() const
+{
+    return m_switchedDesktop;
+}
+
 inline QString Activities::nullUuid()
 {
     // cloned from kactivities/src/lib/core/consumer.cpp
@@ -0,0 +1,197 @@
+/*
+    KWin - the KDE window manager
+    This file is part of the KDE project.
+
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "drm_async_readback.h"
+#include "drm_logging.h"
+#include "opengl/eglcontext.h"
+#include "opengl/eglnativefence.h"
+#include "utils/realtime.h"
+
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace KWin
+{
+
+DrmAsyncReadback::DrmAsyncReadback(EglContext *context)
+    : m_context(context)
+{
+    m_thread.reset(QThread::create([this]() {
+        gainRealTime();
+        run();
+    }));
+    m_thread->setObjectName(QStringLiteral("mgpu copy"));
+    m_thread->start();
+}
+
+DrmAsyncReadback::~DrmAsyncReadback()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_quit = true;
+    }
+    m_jobPending.notify_all();
+    m_thread->wait();
+    for (Slot &slot : m_slots) {
+        release(slot);
+    }
+}
+
+bool DrmAsyncReadback::isSupported(EglContext *context)
+{
+    // pixel pack buffers need desktop OpenGL or OpenGL ES 3
+    return context->haveBufferStorage() && (!context->isOpenGLES() || context->hasVersion(Version(3, 0)));
+}
+
+bool DrmAsyncReadback::isIdle(Slot &slot)
+{
+    if (!slot.done.isValid()) {
+        return true;
+    }
+    if (!slot.done.isReadable()) {
+        return false;
+    }
+    slot.done = FileDescriptor{};
+    slot.target = GraphicsBufferRef{};
+    return true;
+}
+
+bool DrmAsyncReadback::allocate(Slot &slot, size_t size)
+{
+    release(slot);
+
+    const GLbitfield access = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &slot.buffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glBufferStorage(GL_PIXEL_PACK_BUFFER, size, nullptr, access);
+    slot.map = static_cast<uint8_t *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, access));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!slot.map) {
+        qCWarning(KWIN_DRM, "Failed to map a pixel pack buffer");
+        release(slot);
+        return false;
+    }
+    slot.size = size;
+    return true;
+}
+
+void DrmAsyncReadback::release(Slot &slot)
+{
+    if (slot.buffer) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glDeleteBuffers(1, &slot.buffer);
+        slot.buffer = 0;
+    }
+    slot.map = nullptr;
+    slot.size = 0;
+}
+
+FileDescriptor DrmAsyncReadback::readback(GraphicsBuffer *buffer, QImage *target)
+{
+    Slot &slot = m_slots[m_next];
+    if (!isIdle(slot)) {
+        return FileDescriptor{};
+    }
+    const qsizetype sourceStride = 4 * target->width();
+    const size_t size = sourceStride * target->height();
+    if (slot.size < size && !allocate(slot, size)) {
+        return FileDescriptor{};
+    }
+    FileDescriptor done{eventfd(0, EFD_CLOEXEC)};
+    if (!done.isValid()) {
+        qCWarning(KWIN_DRM, "Failed to create an eventfd: %s", strerror(errno));
+        return FileDescriptor{};
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    m_context->glReadnPixels(0, 0, target->width(), target->height(), GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, size, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    EGLNativeFence fence(m_context->displayObject());
+    if (!fence.isValid()) {
+        // without a fence to wait on, the copy can't be done asynchronously
+        glFinish();
+    }
+
+    slot.target = GraphicsBufferRef(buffer);
+    slot.done = std::move(done);
+    m_next = (m_next + 1) % m_slots.size();
+
+    {
+        std::unique_lock lock(m_mutex);
+        m_jobs.push_back(Job{
+            .readFence = fence.takeFileDescriptor(),
+            .done = slot.done.duplicate(),
+            .source = slot.map,
+            .destination = target->bits(),
+            .sourceStride = sourceStride,
+            .destinationStride = target->bytesPerLine(),
+            .height = target->height(),
+            .scheduled = std::chrono::steady_clock::now(),
+        });
+    }
+    m_jobPending.notify_one();
+    return slot.done.duplicate();
+}
+
+std::chrono::nanoseconds DrmAsyncReadback::averageCopyTime() const
+{
+    return std::chrono::nanoseconds(m_averageCopyTime.load(std::memory_order_relaxed));
+}
+
+void DrmAsyncReadback::run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        if (m_jobs.empty()) {
+            if (m_quit) {
+                return;
+            }
+            m_jobPending.wait(lock);
+            continue;
+        }
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lock.unlock();
+
+        if (job.readFence.isValid()) {
+            pollfd pfd{
+                .fd = job.readFence.get(),
+                .events = POLLIN,
+                .revents = 0,
+            };
+            while (poll(&pfd, 1, -1) < 0 && errno == EINTR) {
+            }
+        }
+        if (job.sourceStride == job.destinationStride) {
+            std::memcpy(job.destination, job.source, job.sourceStride * job.height);
+        } else {
+            for (int i = 0; i < job.height; i++) {
+                std::memcpy(job.destination + i * job.destinationStride, job.source + i * job.sourceStride, job.sourceStride);
+            }
+        }
+        const uint64_t value = 1;
+        if (write(job.done.get(), &value, sizeof(value)) != sizeof(value)) {
+            qCWarning(KWIN_DRM, "Failed to signal a finished multi-gpu copy: %s", strerror(errno));
+        }
+
+        // exponential moving average, so that the value follows changes within a few frames
+        const int64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - job.scheduled).count();
+        const int64_t average = m_averageCopyTime.load(std::memory_order_relaxed);
+        m_averageCopyTime.store(average == 0 ? duration : average + (duration - average) / 16, std::memory_order_relaxed);
+
+        lock.lock();
+    }
+}
+
+}
@@ -0,0 +1,107 @@
+/*
+    KWin - the KDE window manager
+    This file is part of the KDE project.
+
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "core/graphicsbuffer.h"
+#include "utils/filedescriptor.h"
+
+#include <epoxy/gl.h>
+
+#include <QImage>
+#include <QThread>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace KWin
+{
+
+class EglContext;
+
+/**
+ * The DrmAsyncReadback class copies rendered frames into CPU accessible buffers
+ * without stalling the main thread, for multi-GPU setups where the secondary GPU
+ * can only scan out dumb buffers.
+ *
+ * The framebuffer is read back into a persistently mapped pixel pack buffer, and a
+ * worker thread waits for the GPU to finish writing it before copying the pixels
+ * into the target image. Completion is signaled through an eventfd, so the commit
+ * thread can hold back the commit until the copy is done while the main thread
+ * already works on the next frame.
+ */
+class DrmAsyncReadback
+{
+public:
+    /**
+     * @p context must be current when the object is created and destroyed
+     */
+    explicit DrmAsyncReadback(EglContext *context);
+    ~DrmAsyncReadback();
+
+    /**
+     * Reads the framebuffer currently bound for reading into an idle pixel pack buffer,
+     * and schedules copying it into @p target, which must be the image of @p buffer.
+     * @p buffer is kept referenced until the copy is done.
+     *
+     * Returns an eventfd that becomes readable once @p target contains the pixels,
+     * or an invalid file descriptor if no pack buffer is idle, in which case the caller
+     * should fall back to a synchronous readback.
+     */
+    FileDescriptor readback(GraphicsBuffer *buffer, QImage *target);
+
+    /**
+     * The average time between a readback being scheduled and its copy being done
+     */
+    std::chrono::nanoseconds averageCopyTime() const;
+
+    static bool isSupported(EglContext *context);
+
+private:
+    struct Slot
+    {
+        GLuint buffer = 0;
+        uint8_t *map = nullptr;
+        size_t size = 0;
+        GraphicsBufferRef target;
+        FileDescriptor done;
+    };
+    struct Job
+    {
+        FileDescriptor readFence;
+        FileDescriptor done;
+        const uint8_t *source;
+        uint8_t *destination;
+        qsizetype sourceStride;
+        qsizetype destinationStride;
+        int height;
+        std::chrono::steady_clock::time_point scheduled;
+    };
+
+    bool isIdle(Slot &slot);
+    bool allocate(Slot &slot, size_t size);
+    void release(Slot &slot);
+    void run();
+
+    EglContext *const m_context;
+    std::array<Slot, 3> m_slots;
+    size_t m_next = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobPending;
+    std::deque<Job> m_jobs;
+    bool m_quit = false;
+    std::atomic<int64_t> m_averageCopyTime{0};
+    std::unique_ptr<QThread> m_thread;
+};
+
+}
@@ -331,6 +331,9 @@ QString DrmBackend::supportInformation() const
       << "DRM" << Qt::endl;
     for (size_t g = 0; g < m_gpus.size(); g++) {
         s << "Atomic Mode Setting on GPU " << g << ": " << m_gpus.at(g)->atomicModeSetting() << Qt::endl;
+        const auto fbCache = m_gpus.at(g)->framebufferCacheStatistics();
+        s << "Framebuffer cache on GPU " << g << ": " << fbCache.hits << " hits, " << fbCache.misses << " misses, "
+          << fbCache.evictions << " evictions, " << fbCache.retained << " retained" << Qt::endl;
     }
     return supportInfo;
 }
@@ -12,14 +12,18 @@
 namespace KWin
 {
 
-DrmBlob::DrmBlob(DrmGpu *gpu, uint32_t blobId)
+DrmBlob::DrmBlob(DrmGpu *gpu, uint32_t blobId, const QByteArray &data)
     : m_gpu(gpu)
     , m_blobId(blobId)
+    , m_data(data)
 {
 }
 
 DrmBlob::~DrmBlob()
 {
+    if (!m_data.isEmpty()) {
+        m_gpu->forgetBlob(m_data);
+    }
     if (m_blobId) {
         drmModeDestroyPropertyBlob(m_gpu->fd(), m_blobId);
     }
@@ -32,9 +36,15 @@ uint32_t DrmBlob::blobId() const
 
 std::shared_ptr<DrmBlob> DrmBlob::create(DrmGpu *gpu, const void *data, uint32_t dataSize)
 {
+    const QByteArray contents(static_cast<const char *>(data), dataSize);
+    if (auto blob = gpu->cachedBlob(contents)) {
+        return blob;
+    }
     uint32_t id = 0;
     if (drmModeCreatePropertyBlob(gpu->fd(), data, dataSize, &id) == 0) {
-        return std::make_shared<DrmBlob>(gpu, id);
+        auto blob = std::make_shared<DrmBlob>(gpu, id, contents);
+        gpu->cacheBlob(contents, blob);
+        return blob;
     } else {
         return nullptr;
     }
@@ -7,6 +7,8 @@
     SPDX-License-Identifier: GPL-2.0-or-later
 */
 #pragma once
+#include <QByteArray>
+
 #include <memory>
 #include <stdint.h>
 
@@ -18,16 +20,22 @@ class DrmGpu;
 class DrmBlob
 {
 public:
-    DrmBlob(DrmGpu *gpu, uint32_t blobId);
+    DrmBlob(DrmGpu *gpu, uint32_t blobId, const QByteArray &data = QByteArray());
     ~DrmBlob();
 
     uint32_t blobId() const;
 
+    /**
+     * Returns a blob with the given contents. Blobs are shared per GPU for as long as they're
+     * in use, so committing the same LUT or HDR metadata repeatedly doesn't create a new blob
+     * every time.
+     */
     static std::shared_ptr<DrmBlob> create(DrmGpu *gpu, const void *data, uint32_t dataSize);
 
 protected:
     DrmGpu *const m_gpu;
     const uint32_t m_blobId;
+    const QByteArray m_data;
 };
 
 }
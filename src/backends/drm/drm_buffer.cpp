@@ -90,10 +90,18 @@ const FileDescriptor &DrmFramebuffer::syncFd() const
     return m_syncFd;
 }
 
+void DrmFramebuffer::setCpuFence(FileDescriptor &&fence)
+{
+    m_cpuFence = std::move(fence);
+    m_readable = false;
+}
+
 bool DrmFramebuffer::isReadable()
 {
     if (m_readable) {
         return true;
+    } else if (m_cpuFence.isValid() && !m_cpuFence.isReadable()) {
+        return false;
     } else if (m_syncFd.isValid()) {
         return m_readable = m_syncFd.isReadable();
     } else {
@@ -47,6 +47,12 @@ public:
     bool isReadable();
 
     const FileDescriptor &syncFd() const;
+    /**
+     * Keeps the framebuffer from being readable until @p fence, which must be signaled
+     * by the CPU and not the GPU, becomes readable. Unlike the sync fd, it's never
+     * passed to the kernel as an in-fence.
+     */
+    void setCpuFence(FileDescriptor &&fence);
     void setDeadline(std::chrono::steady_clock::time_point deadline);
 
     std::shared_ptr<DrmFramebufferData> data() const;
@@ -56,6 +62,7 @@ protected:
     GraphicsBufferRef m_bufferRef;
     bool m_readable = false;
     FileDescriptor m_syncFd;
+    FileDescriptor m_cpuFence;
 };
 
 }
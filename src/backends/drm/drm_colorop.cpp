@@ -13,6 +13,7 @@
 #include "drm_object.h"
 #include "utils/envvar.h"
 
+#include <algorithm>
 #include <ranges>
 
 namespace KWin
@@ -51,23 +52,8 @@ QString DrmAbstractColorOp::name() const
     return m_name;
 }
 
-bool DrmAbstractColorOp::matchPipeline(DrmAtomicCommit *commit, const ColorPipeline &pipeline)
+std::optional<DrmAbstractColorOp::Assignments> DrmAbstractColorOp::assign(const ColorPipeline &pipeline)
 {
-    if (m_cachedPipeline && *m_cachedPipeline == pipeline) {
-        commit->merge(m_cache.get());
-        return true;
-    }
-    if (pipeline.isIdentity() && s_disableAmdgpuWorkaround.value_or(!commit->gpu()->isAmdgpu())) {
-        // Applying this config is very simple and cheap, so do it directly
-        // and avoid invalidating the cache
-        DrmAbstractColorOp *currentOp = this;
-        while (currentOp) {
-            currentOp->bypass(commit);
-            currentOp = currentOp->next();
-        }
-        return true;
-    }
-
     DrmAbstractColorOp *currentOp = this;
     const auto needsLimitedRange = [](const ColorOp &op) {
         // KMS LUTs have an input and output range of [0, 1]
@@ -75,10 +61,7 @@ bool DrmAbstractColorOp::matchPipeline(DrmAtomicCommit *commit, const ColorPipel
             || std::holds_alternative<InverseColorTransferFunction>(op.operation);
     };
 
-    // first, only check if the pipeline can be programmed in the first place
-    // don't calculate LUTs just yet
-
-    std::unordered_map<DrmAbstractColorOp *, std::vector<ColorOp::Operation>> assignments;
+    Assignments assignments;
 
     double valueScaling = 1;
     if (!pipeline.ops.empty() && needsLimitedRange(pipeline.ops.front()) && pipeline.ops.front().input.max > 1) {
@@ -95,7 +78,7 @@ bool DrmAbstractColorOp::matchPipeline(DrmAtomicCommit *commit, const ColorPipel
             currentOp = currentOp->next();
         }
         if (!currentOp) {
-            return false;
+            return std::nullopt;
         }
         assignments[currentOp].push_back(initialOp.operation);
     }
@@ -105,7 +88,7 @@ bool DrmAbstractColorOp::matchPipeline(DrmAtomicCommit *commit, const ColorPipel
             currentOp = currentOp->next();
         }
         if (!currentOp) {
-            return false;
+            return std::nullopt;
         }
         auto &hwOps = assignments[currentOp];
         if (valueScaling != 1) {
@@ -123,13 +106,60 @@ bool DrmAbstractColorOp::matchPipeline(DrmAtomicCommit *commit, const ColorPipel
         ops = ops.subspan(1);
     }
 
+    return assignments;
+}
+
+std::optional<DrmAbstractColorOp::Layout> DrmAbstractColorOp::layout(const ColorPipeline &pipeline)
+{
+    const std::optional<Assignments> assignments = assign(pipeline);
+    if (!assignments) {
+        return std::nullopt;
+    }
+    Layout ret;
+    for (DrmAbstractColorOp *currentOp = this; currentOp; currentOp = currentOp->next()) {
+        const auto it = assignments->find(currentOp);
+        if (it == assignments->end()) {
+            continue;
+        }
+        std::vector<size_t> types;
+        for (const ColorOp::Operation &operation : it->second) {
+            types.push_back(operation.index());
+        }
+        ret.emplace_back(currentOp, std::move(types));
+    }
+    return ret;
+}
+
+bool DrmAbstractColorOp::matchPipeline(DrmAtomicCommit *commit, const ColorPipeline &pipeline)
+{
+    if (m_cachedPipeline && *m_cachedPipeline == pipeline) {
+        commit->merge(m_cache.get());
+        return true;
+    }
+    if (pipeline.isIdentity() && s_disableAmdgpuWorkaround.value_or(!commit->gpu()->isAmdgpu())) {
+        // Applying this config is very simple and cheap, so do it directly
+        // and avoid invalidating the cache
+        DrmAbstractColorOp *currentOp = this;
+        while (currentOp) {
+            currentOp->bypass(commit);
+            currentOp = currentOp->next();
+        }
+        return true;
+    }
+
+    // first, only check if the pipeline can be programmed in the first place
+    // don't calculate LUTs just yet
+    const std::optional<Assignments> assignments = assign(pipeline);
+    if (!assignments) {
+        return false;
+    }
+
     // now actually program the properties
-    currentOp = this;
     m_cache = std::make_unique<DrmAtomicCommit>(commit->gpu());
-    currentOp = this;
+    DrmAbstractColorOp *currentOp = this;
     while (currentOp) {
-        const auto it = assignments.find(currentOp);
-        if (it != assignments.end()) {
+        const auto it = assignments->find(currentOp);
+        if (it != assignments->end()) {
             const auto &[op, program] = *it;
             currentOp->program(m_cache.get(), program);
         } else {
@@ -171,6 +201,15 @@ bool DrmLutColorOp16::canBeUsedFor(const ColorOp &op, bool normalizedInput)
 
 void DrmLutColorOp16::program(DrmAtomicCommit *commit, std::span<const ColorOp::Operation> operations)
 {
+    // night light and brightness changes often only touch some of the operations,
+    // don't recalculate the LUTs for the others
+    if (m_programmedBlob && std::ranges::equal(operations, m_programmedOperations)) {
+        commit->addBlob(*m_prop, m_programmedBlob);
+        if (m_bypass) {
+            commit->addProperty(*m_bypass, 0);
+        }
+        return;
+    }
     for (uint32_t i = 0; i < m_maxSize; i++) {
         const double input = i / double(m_maxSize - 1);
         QVector3D output(input, input, input);
@@ -184,7 +223,9 @@ void DrmLutColorOp16::program(DrmAtomicCommit *commit, std::span<const ColorOp::
             .reserved = 0,
         };
     }
-    commit->addBlob(*m_prop, DrmBlob::create(m_prop->drmObject()->gpu(), m_components.data(), sizeof(drm_color_lut) * m_maxSize));
+    m_programmedBlob = DrmBlob::create(m_prop->drmObject()->gpu(), m_components.data(), sizeof(drm_color_lut) * m_maxSize);
+    m_programmedOperations.assign(operations.begin(), operations.end());
+    commit->addBlob(*m_prop, m_programmedBlob);
     if (m_bypass) {
         commit->addProperty(*m_bypass, 0);
     }
@@ -227,6 +268,13 @@ bool DrmLutColorOp32::canBeUsedFor(const ColorOp &op, bool normalizedInput)
 
 void DrmLutColorOp32::program(DrmAtomicCommit *commit, std::span<const ColorOp::Operation> operations)
 {
+    if (m_programmedBlob && std::ranges::equal(operations, m_programmedOperations)) {
+        commit->addBlob(*m_prop, m_programmedBlob);
+        if (m_bypass) {
+            commit->addProperty(*m_bypass, 0);
+        }
+        return;
+    }
     for (uint32_t i = 0; i < m_maxSize; i++) {
         const double input = i / double(m_maxSize - 1);
         QVector3D output(input, input, input);
@@ -240,7 +288,9 @@ void DrmLutColorOp32::program(DrmAtomicCommit *commit, std::span<const ColorOp::
             .reserved = 0,
         };
     }
-    commit->addBlob(*m_prop, DrmBlob::create(m_prop->drmObject()->gpu(), m_components.data(), sizeof(LutComponent32) * m_maxSize));
+    m_programmedBlob = DrmBlob::create(m_prop->drmObject()->gpu(), m_components.data(), sizeof(LutComponent32) * m_maxSize);
+    m_programmedOperations.assign(operations.begin(), operations.end());
+    commit->addBlob(*m_prop, m_programmedBlob);
     if (m_bypass) {
         commit->addProperty(*m_bypass, 0);
     }
@@ -399,6 +449,13 @@ DrmLut3DColorOp::DrmLut3DColorOp(DrmAbstractColorOp *next, DrmProperty *value, D
 
 void DrmLut3DColorOp::program(DrmAtomicCommit *commit, std::span<const ColorOp::Operation> operations)
 {
+    if (m_programmedBlob && std::ranges::equal(operations, m_programmedOperations)) {
+        commit->addBlob(*m_value, m_programmedBlob);
+        if (m_bypass) {
+            commit->addProperty(*m_bypass, 0);
+        }
+        return;
+    }
     for (size_t r = 0; r < m_size; r++) {
         for (size_t g = 0; g < m_size; g++) {
             for (size_t b = 0; b < m_size; b++) {
@@ -416,7 +473,9 @@ void DrmLut3DColorOp::program(DrmAtomicCommit *commit, std::span<const ColorOp::
             }
         }
     }
-    commit->addBlob(*m_value, DrmBlob::create(m_value->drmObject()->gpu(), m_components.data(), m_components.size() * sizeof(LutComponent32)));
+    m_programmedBlob = DrmBlob::create(m_value->drmObject()->gpu(), m_components.data(), m_components.size() * sizeof(LutComponent32));
+    m_programmedOperations.assign(operations.begin(), operations.end());
+    commit->addBlob(*m_value, m_programmedBlob);
     if (m_bypass) {
         commit->addProperty(*m_bypass, 0);
     }
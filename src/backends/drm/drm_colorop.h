@@ -14,7 +14,10 @@
 #include <deque>
 #include <drm.h>
 #include <memory>
+#include <optional>
 #include <span>
+#include <unordered_map>
+#include <vector>
 
 namespace KWin
 {
@@ -42,6 +45,13 @@ public:
     virtual ~DrmAbstractColorOp();
 
     bool matchPipeline(DrmAtomicCommit *commit, const ColorPipeline &pipeline);
+    /**
+     * which hardware operations the pipeline would be programmed into, and the types of the
+     * operations each of them would get. Pipelines with the same layout only differ in the
+     * values of the properties, or std::nullopt if the pipeline can't be programmed at all
+     */
+    using Layout = std::vector<std::pair<DrmAbstractColorOp *, std::vector<size_t>>>;
+    std::optional<Layout> layout(const ColorPipeline &pipeline);
     virtual void program(DrmAtomicCommit *commit, std::span<const ColorOp::Operation> operations) = 0;
     virtual void bypass(DrmAtomicCommit *commit) = 0;
     virtual bool canBeUsedFor(const ColorOp &op, bool normalizedInput) = 0;
@@ -52,6 +62,9 @@ public:
     QString name() const;
 
 protected:
+    using Assignments = std::unordered_map<DrmAbstractColorOp *, std::vector<ColorOp::Operation>>;
+    std::optional<Assignments> assign(const ColorPipeline &pipeline);
+
     DrmAbstractColorOp *const m_next;
     const Features m_features;
     const QString m_name;
@@ -80,6 +93,8 @@ private:
     DrmEnumProperty<Lut1DInterpolation> *const m_interpolationMode;
     const uint32_t m_maxSize;
     QList<drm_color_lut> m_components;
+    std::vector<ColorOp::Operation> m_programmedOperations;
+    std::shared_ptr<DrmBlob> m_programmedBlob;
 };
 
 // TODO replace with drm_color_lut_32 once we can rely on it
@@ -106,6 +121,8 @@ private:
     DrmEnumProperty<Lut1DInterpolation> *const m_interpolationMode;
     const uint32_t m_maxSize;
     QList<LutComponent32> m_components;
+    std::vector<ColorOp::Operation> m_programmedOperations;
+    std::shared_ptr<DrmBlob> m_programmedBlob;
 };
 
 class LegacyMatrixColorOp : public DrmAbstractColorOp
@@ -167,6 +184,8 @@ private:
     const size_t m_size;
     DrmEnumProperty<Lut3DInterpolation> *const m_interpolation;
     QList<LutComponent32> m_components;
+    std::vector<ColorOp::Operation> m_programmedOperations;
+    std::shared_ptr<DrmBlob> m_programmedBlob;
 };
 
 class DrmMultiplier : public DrmAbstractColorOp
@@ -18,7 +18,9 @@
 
 #include <QCoreApplication>
 #include <QThread>
+#include <algorithm>
 #include <set>
+#include <tuple>
 
 using namespace std::chrono_literals;
 
@@ -40,6 +42,11 @@ DrmGpu *DrmCommit::gpu() const
     return m_gpu;
 }
 
+bool DrmCommit::pageflipEventReceived(uint32_t)
+{
+    return true;
+}
+
 void DrmCommit::setDefunct()
 {
     m_defunct = true;
@@ -122,7 +129,19 @@ bool DrmAtomicCommit::commit()
     if (isTearing()) {
         flags |= DRM_MODE_PAGE_FLIP_ASYNC;
     }
-    return doCommit(flags);
+    if (m_pipelines.size() > 1) {
+        // the kernel sends a separate event for each crtc
+        for (DrmPipeline *pipeline : std::as_const(m_pipelines)) {
+            if (pipeline->crtc()) {
+                m_pendingPageflips.insert(pipeline->crtc()->id());
+            }
+        }
+    }
+    if (!doCommit(flags)) {
+        m_pendingPageflips.clear();
+        return false;
+    }
+    return true;
 }
 
 bool DrmAtomicCommit::commitModeset()
@@ -131,6 +150,62 @@ bool DrmAtomicCommit::commitModeset()
     return doCommit(DRM_MODE_ATOMIC_ALLOW_MODESET);
 }
 
+QByteArray DrmAtomicCommit::testCacheKey() const
+{
+    struct Entry
+    {
+        uint32_t object;
+        uint32_t property;
+        uint64_t value;
+    };
+    std::vector<Entry> entries;
+    for (const auto &[object, properties] : m_properties) {
+        for (const auto &[property, value] : properties) {
+            entries.push_back(Entry{object, property, value});
+        }
+    }
+    std::ranges::sort(entries, [](const Entry &left, const Entry &right) {
+        return std::tie(left.object, left.property) < std::tie(right.object, right.property);
+    });
+
+    QByteArray ret;
+    const auto append = [&ret](const auto &value) {
+        ret.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    append(isTearing());
+    for (const Entry &entry : entries) {
+        append(entry.object);
+        append(entry.property);
+        const auto it = std::ranges::find_if(m_buffers, [&entry](const auto &pair) {
+            return pair.first->id() == entry.object;
+        });
+        if (it == m_buffers.end()) {
+            append(entry.value);
+            continue;
+        }
+        const auto &[plane, buffer] = *it;
+        if (entry.property == plane->inFenceFd.propId()) {
+            // the fd number is different every frame, only whether or not there's a fence matters
+            append(entry.value != uint64_t(-1));
+            continue;
+        }
+        const DmaBufAttributes *attributes = buffer && buffer->buffer() ? buffer->buffer()->dmabufAttributes() : nullptr;
+        if (entry.property != plane->fbId.propId() || !attributes) {
+            append(entry.value);
+            continue;
+        }
+        append(attributes->format);
+        append(attributes->modifier);
+        append(attributes->width);
+        append(attributes->height);
+        for (int i = 0; i < attributes->planeCount; i++) {
+            append(attributes->offset[i]);
+            append(attributes->pitch[i]);
+        }
+    }
+    return ret;
+}
+
 bool DrmAtomicCommit::doCommit(uint32_t flags)
 {
     std::vector<uint32_t> objects;
@@ -166,6 +241,17 @@ bool DrmAtomicCommit::doCommit(uint32_t flags)
     return drmIoctl(m_gpu->fd(), DRM_IOCTL_MODE_ATOMIC, &commitData) == 0;
 }
 
+bool DrmAtomicCommit::pageflipEventReceived(uint32_t crtcId)
+{
+    m_pendingPageflips.erase(crtcId);
+    return m_pendingPageflips.empty();
+}
+
+void DrmAtomicCommit::removePipeline(DrmPipeline *pipeline)
+{
+    m_pipelines.removeOne(pipeline);
+}
+
 void DrmAtomicCommit::pageFlipped(std::chrono::nanoseconds timestamp)
 {
     Q_ASSERT(QThread::currentThread() == QCoreApplication::instance()->thread());
@@ -187,7 +273,9 @@ void DrmAtomicCommit::pageFlipped(std::chrono::nanoseconds timestamp)
         frame->presented(timestamp, m_mode);
     }
     m_frames.clear();
-    for (const auto pipeline : std::as_const(m_pipelines)) {
+    // notifying the pipelines may delete this commit
+    const auto pipelines = m_pipelines;
+    for (const auto pipeline : pipelines) {
         pipeline->pageFlipped(timestamp);
     }
 }
@@ -235,6 +323,11 @@ void DrmAtomicCommit::merge(DrmAtomicCommit *onTop)
     for (const auto &[prop, blob] : onTop->m_blobs) {
         m_blobs[prop] = blob;
     }
+    for (DrmPipeline *pipeline : std::as_const(onTop->m_pipelines)) {
+        if (!m_pipelines.contains(pipeline)) {
+            m_pipelines.push_back(pipeline);
+        }
+    }
     if (onTop->m_vrr) {
         m_vrr = onTop->m_vrr;
     }
@@ -276,6 +369,43 @@ bool DrmAtomicCommit::isTearing() const
     return m_mode == PresentationMode::Async || m_mode == PresentationMode::AdaptiveAsync;
 }
 
+std::optional<Rect> DrmAtomicCommit::planeTarget(DrmPlane *plane) const
+{
+    const auto buffer = m_buffers.find(plane);
+    if (buffer == m_buffers.end() || !buffer->second) {
+        return std::nullopt;
+    }
+    const auto properties = m_properties.find(plane->id());
+    if (properties == m_properties.end()) {
+        return std::nullopt;
+    }
+    const auto value = [&properties](const DrmProperty &property) -> std::optional<int32_t> {
+        const auto it = properties->second.find(property.propId());
+        if (it == properties->second.end()) {
+            return std::nullopt;
+        }
+        return static_cast<int32_t>(it->second);
+    };
+    const auto x = value(plane->crtcX);
+    const auto y = value(plane->crtcY);
+    const auto width = value(plane->crtcW);
+    const auto height = value(plane->crtcH);
+    if (!x || !y || !width || !height) {
+        return std::nullopt;
+    }
+    return Rect(*x, *y, *width, *height);
+}
+
+void DrmAtomicCommit::movePlane(DrmPlane *plane, const Rect &target)
+{
+    const auto current = planeTarget(plane);
+    if (!current || current->size() != target.size() || current->topLeft() == target.topLeft()) {
+        return;
+    }
+    addProperty(plane->crtcX, target.x());
+    addProperty(plane->crtcY, target.y());
+}
+
 DrmLegacyCommit::DrmLegacyCommit(DrmPipeline *pipeline, const std::shared_ptr<DrmFramebuffer> &buffer, const std::shared_ptr<OutputFrame> &frame)
     : DrmCommit(pipeline->gpu())
     , m_pipeline(pipeline)
@@ -16,6 +16,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "core/rect.h"
 #include "core/renderloop.h"
 #include "drm_pointer.h"
 #include "drm_property.h"
@@ -41,6 +42,11 @@ public:
 
     DrmGpu *gpu() const;
     virtual void pageFlipped(std::chrono::nanoseconds timestamp) = 0;
+    /**
+     * Returns whether the pageflip event for @p crtcId was the last one
+     * this commit was waiting for
+     */
+    virtual bool pageflipEventReceived(uint32_t crtcId);
     void setDefunct();
 
 protected:
@@ -73,7 +79,16 @@ public:
     bool commit();
     bool commitModeset();
 
+    /**
+     * Returns a key that describes the state this commit would apply, for caching test results.
+     * Framebuffer ids are replaced with the attributes of the buffer and fences are ignored, so
+     * that commits of different buffers with the same format, modifier and size have the same key
+     */
+    QByteArray testCacheKey() const;
+
     void pageFlipped(std::chrono::nanoseconds timestamp) override;
+    bool pageflipEventReceived(uint32_t crtcId) override;
+    void removePipeline(DrmPipeline *pipeline);
 
     bool areBuffersReadable() const;
     void setDeadline(std::chrono::steady_clock::time_point deadline);
@@ -89,10 +104,19 @@ public:
     bool isReadyFor(std::chrono::steady_clock::time_point pageflipTarget) const;
     bool isTearing() const;
 
+    /**
+     * @returns the target rectangle of @p plane, if this commit enables it
+     */
+    std::optional<Rect> planeTarget(DrmPlane *plane) const;
+    /**
+     * Moves @p plane to @p target, if this commit enables it with the same size
+     */
+    void movePlane(DrmPlane *plane, const Rect &target);
+
 private:
     bool doCommit(uint32_t flags);
 
-    const QList<DrmPipeline *> m_pipelines;
+    QList<DrmPipeline *> m_pipelines;
     std::optional<std::chrono::steady_clock::time_point> m_targetPageflipTime;
     std::optional<std::chrono::nanoseconds> m_allowedVrrDelay;
     std::unordered_map<const DrmProperty *, std::shared_ptr<DrmBlob>> m_blobs;
@@ -103,6 +127,7 @@ private:
     std::unordered_map<uint32_t /* object */, std::unordered_map<uint32_t /* property */, uint64_t /* value */>> m_properties;
     bool m_modeset = false;
     PresentationMode m_mode = PresentationMode::VSync;
+    std::unordered_set<uint32_t> m_pendingPageflips;
 };
 
 class DrmLegacyCommit : public DrmCommit
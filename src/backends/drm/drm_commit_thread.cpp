@@ -10,6 +10,7 @@
 #include "drm_commit.h"
 #include "drm_gpu.h"
 #include "drm_logging.h"
+#include "ftrace.h"
 #include "utils/envvar.h"
 #include "utils/realtime.h"
 
@@ -22,6 +23,80 @@ using namespace std::chrono_literals;
 namespace KWin
 {
 
+// vblanks that are this close together are considered to be aligned
+static constexpr auto s_vblankAlignmentTolerance = 500us;
+
+void DrmCommitScheduler::addThread(DrmCommitThread *thread)
+{
+    std::unique_lock lock(m_mutex);
+    m_threads.push_back(thread);
+}
+
+void DrmCommitScheduler::removeThread(DrmCommitThread *thread)
+{
+    std::unique_lock lock(m_mutex);
+    std::erase(m_threads, thread);
+}
+
+std::vector<DrmCommitScheduler::AlignedThread> DrmCommitScheduler::lockAlignedThreads(DrmCommitThread *leader, TimePoint pageflipTarget)
+{
+    std::unique_lock lock(m_mutex);
+    std::vector<AlignedThread> ret;
+    for (DrmCommitThread *thread : m_threads) {
+        if (thread == leader) {
+            continue;
+        }
+        // the thread might be trying to do the same thing right now, don't wait for it
+        std::unique_lock threadLock(thread->m_mutex, std::try_to_lock);
+        if (!threadLock.owns_lock()) {
+            continue;
+        }
+        const auto difference = thread->m_targetPageflipTime > pageflipTarget ? thread->m_targetPageflipTime - pageflipTarget : pageflipTarget - thread->m_targetPageflipTime;
+        if (difference <= s_vblankAlignmentTolerance && thread->canShareCommit(pageflipTarget)) {
+            ret.push_back(AlignedThread{
+                .thread = thread,
+                .lock = std::move(threadLock),
+            });
+        }
+    }
+    return ret;
+}
+
+void DrmCommitScheduler::releaseSharedCommit(const DrmCommit *commit)
+{
+    // this is only called in the main thread, which is also the only one that removes threads,
+    // so the list can't get outdated after the mutex is unlocked
+    std::vector<DrmCommitThread *> threads;
+    {
+        std::unique_lock lock(m_mutex);
+        threads = m_threads;
+    }
+    for (DrmCommitThread *thread : threads) {
+        std::unique_lock lock(thread->m_mutex);
+        if (thread->m_sharedCommit == commit) {
+            thread->m_sharedCommit = nullptr;
+            thread->m_commitPending.notify_all();
+        }
+    }
+}
+
+std::chrono::microseconds DrmCommitThread::Statistics::histogramBucketLimit(size_t bucket)
+{
+    return 250us * (1 << bucket);
+}
+
+static void addToHistogram(DrmCommitThread::Statistics::Histogram &histogram, std::chrono::nanoseconds value)
+{
+    size_t bucket = 0;
+    while (bucket < histogram.size() - 1 && value >= DrmCommitThread::Statistics::histogramBucketLimit(bucket)) {
+        bucket++;
+    }
+    histogram[bucket]++;
+}
+
+static const bool s_mergeAlignedCommits = environmentVariableBoolValue("KWIN_DRM_MERGE_ALIGNED_COMMITS").value_or(false);
+static const bool s_lateLatchCursor = environmentVariableBoolValue("KWIN_DRM_LATE_LATCH_CURSOR").value_or(false);
+
 DrmCommitThread::DrmCommitThread(DrmGpu *gpu, const QString &name)
     : m_gpu(gpu)
     , m_targetPageflipTime(std::chrono::steady_clock::now())
@@ -29,6 +104,7 @@ DrmCommitThread::DrmCommitThread(DrmGpu *gpu, const QString &name)
     if (!gpu->atomicModeSetting()) {
         return;
     }
+    gpu->commitScheduler()->addThread(this);
 
     m_thread.reset(QThread::create([this]() {
         const auto thread = QThread::currentThread();
@@ -39,12 +115,12 @@ DrmCommitThread::DrmCommitThread(DrmGpu *gpu, const QString &name)
             }
             std::unique_lock lock(m_mutex);
             bool timeout = false;
-            if (m_committed) {
+            if (hasPendingPageflip()) {
                 timeout = m_commitPending.wait_for(lock, DrmGpu::s_pageflipTimeout) == std::cv_status::timeout;
             } else if (m_commits.empty()) {
                 m_commitPending.wait(lock);
             }
-            if (m_committed) {
+            if (hasPendingPageflip()) {
                 if (timeout) {
                     // if the main thread just hung for a while, the pageflip will be processed after the wait
                     // but not if it's a real pageflip timeout
@@ -53,7 +129,7 @@ DrmCommitThread::DrmCommitThread(DrmGpu *gpu, const QString &name)
                     while (!m_ping) {
                         m_pong.wait(lock);
                     }
-                    if (m_committed) {
+                    if (hasPendingPageflip()) {
                         qCCritical(KWIN_DRM, "Pageflip timed out! This is a bug in the %s kernel driver", qPrintable(m_gpu->driverName()));
                         if (m_gpu->isAmdgpu()) {
                             qCCritical(KWIN_DRM, "Please report this at https://gitlab.freedesktop.org/drm/amd/-/issues");
@@ -64,8 +140,10 @@ DrmCommitThread::DrmCommitThread(DrmGpu *gpu, const QString &name)
                         }
                         qCCritical(KWIN_DRM, "With the output of 'sudo dmesg' and 'journalctl --user-unit plasma-kwin_wayland --boot 0'");
                         m_pageflipTimeoutDetected = true;
+                        m_statistics.pageflipTimeouts++;
                     } else {
                         qCWarning(KWIN_DRM, "The main thread was hanging temporarily!");
+                        m_statistics.mainThreadHangs++;
                     }
                 } else {
                     // the commit would fail with EBUSY, wait until the pageflip is done
@@ -80,15 +158,16 @@ DrmCommitThread::DrmCommitThread(DrmGpu *gpu, const QString &name)
                 lock.unlock();
                 std::this_thread::sleep_until(m_targetPageflipTime - m_safetyMargin);
                 lock.lock();
-                // the main thread might've modified the list
-                if (m_commits.empty()) {
+                // the main thread might've modified the list, or another
+                // thread might've submitted the commit together with its own
+                if (m_commits.empty() || hasPendingPageflip()) {
                     continue;
                 }
             }
             optimizeCommits(m_targetPageflipTime);
             if (!m_commits.front()->isReadyFor(m_targetPageflipTime)) {
                 // no commit is ready yet, reschedule
-                if (m_vrr || m_tearing) {
+                if (m_vrr || m_tearing || m_commits.front()->isTearing()) {
                     m_targetPageflipTime += 50us;
                 } else {
                     m_targetPageflipTime += m_minVblankInterval;
@@ -149,35 +228,20 @@ static std::unique_ptr<DrmAtomicCommit> mergeCommits(std::span<const std::unique
 
 void DrmCommitThread::submit()
 {
+    if (s_mergeAlignedCommits && submitAligned()) {
+        return;
+    }
     DrmAtomicCommit *commit = m_commits.front().get();
+    applyCursorLatch(commit);
     const auto vrr = commit->isVrr();
+    fTraceDuration("Atomic commit (", m_thread->objectName(), ")");
     const bool success = commit->commit();
     if (success) {
         m_vrr = vrr.value_or(m_vrr);
         m_tearing = commit->isTearing();
         m_committed = std::move(m_commits.front());
         m_commits.erase(m_commits.begin());
-
-        // the kernel might still take some time to actually apply the commit
-        // after we return from the commit ioctl, but we don't have any better
-        // way to know when it's done
-        m_lastCommitTime = std::chrono::steady_clock::now();
-        // this is when we wanted to have completed the commit
-        const auto targetTimestamp = m_targetPageflipTime - m_baseSafetyMargin;
-        // this is how much safety we need to add or remove to achieve that next time
-        const auto safetyDifference = targetTimestamp - m_lastCommitTime;
-        if (safetyDifference < std::chrono::nanoseconds::zero()) {
-            // the commit was done later than desired, immediately add the
-            // required difference to make sure that it doesn't happen again
-            m_additionalSafetyMargin -= safetyDifference;
-        } else {
-            // we were done earlier than desired. This isn't problematic, but
-            // we want to keep latency at a minimum, so slowly reduce the safety margin
-            m_additionalSafetyMargin -= safetyDifference / 10;
-        }
-        const auto maximumReasonableMargin = std::min<std::chrono::nanoseconds>(3ms, m_minVblankInterval / 2);
-        m_additionalSafetyMargin = std::clamp(m_additionalSafetyMargin, 0ns, maximumReasonableMargin);
-        m_safetyMargin = m_baseSafetyMargin + m_additionalSafetyMargin;
+        updateSafetyMargin();
     } else {
         if (m_commits.size() > 1) {
             // the failure may have been because of the reordering of commits
@@ -192,6 +256,7 @@ void DrmCommitThread::submit()
                 return;
             }
         }
+        m_statistics.droppedCommits += m_commits.size();
         for (auto &commit : m_commits) {
             m_commitsToDelete.push_back(std::move(commit));
         }
@@ -201,6 +266,138 @@ void DrmCommitThread::submit()
     QMetaObject::invokeMethod(this, &DrmCommitThread::clearDroppedCommits, Qt::ConnectionType::QueuedConnection);
 }
 
+bool DrmCommitThread::submitAligned()
+{
+    if (!canShareCommit(m_targetPageflipTime)) {
+        return false;
+    }
+    auto aligned = m_gpu->commitScheduler()->lockAlignedThreads(this, m_targetPageflipTime);
+    if (aligned.empty()) {
+        return false;
+    }
+    applyCursorLatch(m_commits.front().get());
+    auto merged = std::make_unique<DrmAtomicCommit>(*m_commits.front());
+    std::vector<DrmCommitThread *> partners;
+    for (const auto &[thread, lock] : aligned) {
+        thread->applyCursorLatch(thread->m_commits.front().get());
+        auto duplicate = std::make_unique<DrmAtomicCommit>(*merged);
+        duplicate->merge(thread->m_commits.front().get());
+        if (duplicate->test()) {
+            m_commitsToDelete.push_back(std::move(merged));
+            merged = std::move(duplicate);
+            partners.push_back(thread);
+        } else {
+            m_commitsToDelete.push_back(std::move(duplicate));
+        }
+    }
+    if (partners.empty()) {
+        m_commitsToDelete.push_back(std::move(merged));
+        return false;
+    }
+    fTraceDuration("Atomic commit (", m_thread->objectName(), ", shared)");
+    if (!merged->commit()) {
+        qCDebug(KWIN_DRM) << "shared atomic commit failed:" << strerror(errno);
+        m_commitsToDelete.push_back(std::move(merged));
+        return false;
+    }
+    for (DrmCommitThread *partner : partners) {
+        partner->m_sharedCommit = merged.get();
+        partner->m_lastCommitTime = std::chrono::steady_clock::now();
+        partner->m_committedTarget = partner->m_targetPageflipTime;
+        partner->m_statistics.commits++;
+        partner->m_commitsToDelete.push_back(std::move(partner->m_commits.front()));
+        partner->m_commits.erase(partner->m_commits.begin());
+        QMetaObject::invokeMethod(partner, &DrmCommitThread::clearDroppedCommits, Qt::ConnectionType::QueuedConnection);
+    }
+    m_commitsToDelete.push_back(std::move(m_commits.front()));
+    m_commits.erase(m_commits.begin());
+    m_committed = std::move(merged);
+    updateSafetyMargin();
+    QMetaObject::invokeMethod(this, &DrmCommitThread::clearDroppedCommits, Qt::ConnectionType::QueuedConnection);
+    return true;
+}
+
+void DrmCommitThread::updateSafetyMargin()
+{
+    // the kernel might still take some time to actually apply the commit
+    // after we return from the commit ioctl, but we don't have any better
+    // way to know when it's done
+    m_lastCommitTime = std::chrono::steady_clock::now();
+    m_committedTarget = m_targetPageflipTime;
+    m_statistics.commits++;
+    addToHistogram(m_statistics.safetyMarginConsumed, std::max(m_lastCommitTime - (m_targetPageflipTime - m_safetyMargin), 0ns));
+    // this is when we wanted to have completed the commit
+    const auto targetTimestamp = m_targetPageflipTime - m_baseSafetyMargin;
+    // this is how much safety we need to add or remove to achieve that next time
+    const auto safetyDifference = targetTimestamp - m_lastCommitTime;
+    if (safetyDifference < std::chrono::nanoseconds::zero()) {
+        m_statistics.lateSubmissions++;
+        // the commit was done later than desired, immediately add the
+        // required difference to make sure that it doesn't happen again
+        m_additionalSafetyMargin -= safetyDifference;
+    } else {
+        // we were done earlier than desired. This isn't problematic, but
+        // we want to keep latency at a minimum, so slowly reduce the safety margin
+        m_additionalSafetyMargin -= safetyDifference / 10;
+    }
+    const auto maximumReasonableMargin = std::min<std::chrono::nanoseconds>(3ms, m_minVblankInterval / 2);
+    m_additionalSafetyMargin = std::clamp(m_additionalSafetyMargin, 0ns, maximumReasonableMargin);
+    recalculateSafetyMargin();
+}
+
+// the rate of missed deadlines the safety margin is tuned for, in 1/1000
+static const double s_targetMissRate = std::clamp(environmentVariableIntValue("KWIN_DRM_TARGET_MISS_RATE_PERMILLE").value_or(5), 1, 1000) / 1000.0;
+
+void DrmCommitThread::updateMissRate(bool missed)
+{
+    // roughly the last few hundred frames are taken into account
+    static constexpr double s_missRateWeight = 1.0 / 256;
+    // growing quickly and shrinking slowly keeps stutter short when the driver gets slower,
+    // while still recovering the latency over time when it's faster than expected
+    static constexpr auto s_growStep = 50us;
+    static constexpr auto s_shrinkStep = 2us;
+    // cutting into the experimentally determined s_safetyMarginMinimum too much isn't worth the risk
+    static constexpr auto s_minimumTunedMargin = -500us;
+
+    m_missRate = m_missRate * (1 - s_missRateWeight) + (missed ? s_missRateWeight : 0);
+    if (m_missRate > s_targetMissRate) {
+        m_tunedSafetyMargin += s_growStep;
+    } else {
+        m_tunedSafetyMargin -= s_shrinkStep;
+    }
+    m_tunedSafetyMargin = std::clamp<std::chrono::nanoseconds>(m_tunedSafetyMargin, s_minimumTunedMargin, m_minVblankInterval / 2);
+    recalculateSafetyMargin();
+}
+
+void DrmCommitThread::recalculateSafetyMargin()
+{
+    // never commit during vblank, the kernel rejects that
+    static constexpr auto s_minimumSlack = 250us;
+    const auto maximumMargin = std::max<std::chrono::nanoseconds>(m_minVblankInterval - s_minimumSlack, m_vblankTime + s_minimumSlack);
+    m_safetyMargin = std::clamp<std::chrono::nanoseconds>(m_baseSafetyMargin + m_additionalSafetyMargin + m_tunedSafetyMargin, m_vblankTime + s_minimumSlack, maximumMargin);
+}
+
+void DrmCommitThread::applyCursorLatch(DrmAtomicCommit *commit)
+{
+    if (m_cursorLatchPlane) {
+        commit->movePlane(m_cursorLatchPlane, m_cursorLatchTarget);
+    }
+}
+
+bool DrmCommitThread::hasPendingPageflip() const
+{
+    return m_committed || m_sharedCommit;
+}
+
+bool DrmCommitThread::canShareCommit(TimePoint pageflipTarget) const
+{
+    if (!m_thread || hasPendingPageflip() || m_commits.empty() || m_vrr || m_tearing) {
+        return false;
+    }
+    const auto &commit = m_commits.front();
+    return !commit->isTearing() && !commit->isVrr().value_or(false) && commit->isReadyFor(pageflipTarget);
+}
+
 void DrmCommitThread::optimizeCommits(TimePoint pageflipTarget)
 {
     if (m_commits.size() <= 1) {
@@ -313,6 +510,7 @@ void DrmCommitThread::optimizeCommits(TimePoint pageflipTarget)
 DrmCommitThread::~DrmCommitThread()
 {
     if (m_thread) {
+        m_gpu->commitScheduler()->removeThread(this);
         {
             std::unique_lock lock(m_mutex);
             m_thread->requestInterruption();
@@ -323,6 +521,7 @@ DrmCommitThread::~DrmCommitThread()
         m_thread->wait();
     }
     if (m_committed) {
+        m_gpu->commitScheduler()->releaseSharedCommit(m_committed.get());
         m_committed->setDefunct();
         m_gpu->addDefunctCommit(std::move(m_committed));
     }
@@ -331,10 +530,20 @@ DrmCommitThread::~DrmCommitThread()
 void DrmCommitThread::addCommit(std::unique_ptr<DrmAtomicCommit> &&commit)
 {
     std::unique_lock lock(m_mutex);
+    if (m_cursorLatchPlane && commit->modifiedPlanes().contains(m_cursorLatchPlane)) {
+        // the commit contains a newer cursor state than the latch
+        if (const auto target = commit->planeTarget(m_cursorLatchPlane)) {
+            m_cursorLatchTarget = *target;
+        } else {
+            m_cursorLatchPlane = nullptr;
+        }
+    }
     m_commits.push_back(std::move(commit));
     const auto now = std::chrono::steady_clock::now();
     TimePoint newTarget;
-    if (m_tearing) {
+    // m_tearing only reflects the last submitted commit, the first tearing commit after
+    // synchronized ones shouldn't have to wait for the next vblank either
+    if (m_tearing || m_commits.back()->isTearing()) {
         newTarget = now;
     } else if (m_vrr && now >= m_lastPageflip + m_minVblankInterval) {
         newTarget = now;
@@ -368,7 +577,8 @@ void DrmCommitThread::setModeInfo(uint32_t maximum, std::chrono::nanoseconds vbl
     // the kernel rejects commits that happen during vblank
     // the 1.5ms on top of that was chosen experimentally, for the time it takes to commit + scheduling inaccuracies
     m_baseSafetyMargin = vblankTime + s_safetyMarginMinimum;
-    m_safetyMargin = m_baseSafetyMargin + m_additionalSafetyMargin;
+    m_vblankTime = vblankTime;
+    recalculateSafetyMargin();
 }
 
 void DrmCommitThread::pageFlipped(std::chrono::nanoseconds timestamp)
@@ -379,7 +589,18 @@ void DrmCommitThread::pageFlipped(std::chrono::nanoseconds timestamp)
         m_pageflipTimeoutDetected = false;
     }
     m_lastPageflip = TimePoint(timestamp);
+    if (m_thread && hasPendingPageflip()) {
+        addToHistogram(m_statistics.commitToPageflipLatency, std::max(m_lastPageflip - m_lastCommitTime, 0ns));
+        if (!m_vrr && !m_tearing) {
+            const bool missed = m_lastPageflip > m_committedTarget + m_minVblankInterval / 2;
+            if (missed) {
+                m_statistics.missedDeadlines++;
+            }
+            updateMissRate(missed);
+        }
+    }
     m_committed.reset();
+    m_sharedCommit = nullptr;
     if (!m_commits.empty()) {
         m_targetPageflipTime = estimateNextVblank(std::chrono::steady_clock::now());
         m_commitPending.notify_all();
@@ -389,7 +610,7 @@ void DrmCommitThread::pageFlipped(std::chrono::nanoseconds timestamp)
 bool DrmCommitThread::pageflipsPending()
 {
     std::unique_lock lock(m_mutex);
-    return !m_commits.empty() || m_committed;
+    return !m_commits.empty() || hasPendingPageflip();
 }
 
 TimePoint DrmCommitThread::estimateNextVblank(TimePoint now) const
@@ -404,6 +625,42 @@ std::chrono::nanoseconds DrmCommitThread::safetyMargin() const
     return m_safetyMargin;
 }
 
+DrmCommitThread::Statistics DrmCommitThread::statistics()
+{
+    std::unique_lock lock(m_mutex);
+    Statistics ret = m_statistics;
+    ret.safetyMargin = m_safetyMargin;
+    ret.additionalSafetyMargin = m_additionalSafetyMargin;
+    ret.tunedSafetyMargin = m_tunedSafetyMargin;
+    ret.missRate = m_missRate;
+    return ret;
+}
+
+bool DrmCommitThread::latchCursorPosition(DrmPlane *plane, const Rect &target)
+{
+    if (!s_lateLatchCursor || !m_thread) {
+        return false;
+    }
+    std::unique_lock lock(m_mutex);
+    const bool sameSize = m_cursorLatchPlane == plane && m_cursorLatchTarget.size() == target.size();
+    m_cursorLatchPlane = plane;
+    m_cursorLatchTarget = target;
+    if (!sameSize) {
+        return false;
+    }
+    return std::ranges::any_of(m_commits, [plane](const auto &commit) {
+        return commit->planeTarget(plane).has_value();
+    });
+}
+
+void DrmCommitThread::forgetPipeline(DrmPipeline *pipeline)
+{
+    std::unique_lock lock(m_mutex);
+    if (m_sharedCommit) {
+        m_sharedCommit->removePipeline(pipeline);
+    }
+}
+
 void DrmCommitThread::handlePing()
 {
     // this will process the pageflip and call pageFlipped if there is one
@@ -8,8 +8,12 @@
 */
 #pragma once
 
+#include "core/rect.h"
+
 #include <QObject>
 #include <QThread>
+#include <array>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <vector>
@@ -21,9 +25,44 @@ class DrmGpu;
 class DrmCommit;
 class DrmAtomicCommit;
 class DrmLegacyCommit;
+class DrmPipeline;
+class DrmPlane;
+class DrmCommitThread;
 
 using TimePoint = std::chrono::steady_clock::time_point;
 
+/**
+ * The DrmCommitScheduler knows about all commit threads of a GPU and their next pageflip
+ * target, so that commits for outputs with aligned vblanks can be submitted in a single
+ * atomic commit, and the outputs flip together
+ */
+class DrmCommitScheduler
+{
+public:
+    void addThread(DrmCommitThread *thread);
+    void removeThread(DrmCommitThread *thread);
+
+    struct AlignedThread
+    {
+        DrmCommitThread *thread;
+        std::unique_lock<std::mutex> lock;
+    };
+    /**
+     * Returns the commit threads other than @p leader that have a commit ready for @p pageflipTarget,
+     * with their mutex locked. Threads that are busy are skipped, so this can't dead-lock
+     */
+    std::vector<AlignedThread> lockAlignedThreads(DrmCommitThread *leader, TimePoint pageflipTarget);
+    /**
+     * Makes threads that wait for the pageflip of the shared @p commit stop waiting for it,
+     * because it won't be delivered to them anymore
+     */
+    void releaseSharedCommit(const DrmCommit *commit);
+
+private:
+    std::mutex m_mutex;
+    std::vector<DrmCommitThread *> m_threads;
+};
+
 class DrmCommitThread : public QObject
 {
     Q_OBJECT
@@ -43,11 +82,63 @@ public:
      */
     std::chrono::nanoseconds safetyMargin() const;
 
+    struct Statistics
+    {
+        /**
+         * The histograms have buckets with an upper limit of 250us, 500us, 1ms and so on,
+         * with the last bucket containing all larger values
+         */
+        static constexpr size_t s_histogramSize = 9;
+        using Histogram = std::array<uint64_t, s_histogramSize>;
+        static std::chrono::microseconds histogramBucketLimit(size_t bucket);
+
+        // time between the commit ioctl returning and the pageflip
+        Histogram commitToPageflipLatency{};
+        // how much of the safety margin was used up when the commit ioctl returned
+        Histogram safetyMarginConsumed{};
+        uint64_t commits = 0;
+        // commits that were submitted after the time the safety margin aimed for
+        uint64_t lateSubmissions = 0;
+        // pageflips that didn't happen on the vblank targeted by the commit
+        uint64_t missedDeadlines = 0;
+        // commits that were dropped because the atomic commit failed
+        uint64_t droppedCommits = 0;
+        uint64_t mainThreadHangs = 0;
+        uint64_t pageflipTimeouts = 0;
+        std::chrono::nanoseconds safetyMargin{0};
+        std::chrono::nanoseconds additionalSafetyMargin{0};
+        std::chrono::nanoseconds tunedSafetyMargin{0};
+        // moving average of the rate of missed deadlines
+        double missRate = 0;
+    };
+    Statistics statistics();
+
+    /**
+     * Records the latest position of the cursor on @p plane. If late latching of the cursor
+     * is enabled, commits that show the cursor are moved to the latest position right before
+     * they're submitted
+     * @returns true if a pending commit will pick up the new position, so that no new commit is needed
+     */
+    bool latchCursorPosition(DrmPlane *plane, const Rect &target);
+
+    /**
+     * Must be called before @p pipeline is destroyed, so that a commit shared with
+     * another thread doesn't access it anymore
+     */
+    void forgetPipeline(DrmPipeline *pipeline);
+
 private:
     void clearDroppedCommits();
     TimePoint estimateNextVblank(TimePoint now) const;
     void optimizeCommits(TimePoint pageflipTarget);
     void submit();
+    bool submitAligned();
+    void updateSafetyMargin();
+    void updateMissRate(bool missed);
+    void recalculateSafetyMargin();
+    bool hasPendingPageflip() const;
+    bool canShareCommit(TimePoint pageflipTarget) const;
+    void applyCursorLatch(DrmAtomicCommit *commit);
     void handlePing();
 
     DrmGpu *const m_gpu;
@@ -67,8 +158,20 @@ private:
     std::chrono::nanoseconds m_safetyMargin{0};
     std::chrono::nanoseconds m_baseSafetyMargin{0};
     std::chrono::nanoseconds m_additionalSafetyMargin = std::chrono::milliseconds(1);
+    std::chrono::nanoseconds m_vblankTime{0};
+    // grows and shrinks to keep the rate of missed deadlines close to the target
+    std::chrono::nanoseconds m_tunedSafetyMargin{0};
+    double m_missRate = 0;
     bool m_ping = false;
     bool m_pageflipTimeoutDetected = false;
+    DrmPlane *m_cursorLatchPlane = nullptr;
+    Rect m_cursorLatchTarget;
+    Statistics m_statistics;
+    TimePoint m_committedTarget;
+    // set while the front commit was submitted by another thread, together with its own
+    DrmAtomicCommit *m_sharedCommit = nullptr;
+
+    friend class DrmCommitScheduler;
 };
 
 }
@@ -277,7 +277,12 @@ bool DrmConnector::updateProperties()
 
     // parse edid
     if (edidProp.immutableBlob()) {
-        m_edid = Edid(edidProp.immutableBlob()->data, edidProp.immutableBlob()->length);
+        // connectors are updated on every hotplug event, which docks send a lot of. Most of
+        // the time the monitor stays the same, and so does its EDID
+        const QByteArrayView blob(reinterpret_cast<const char *>(edidProp.immutableBlob()->data), edidProp.immutableBlob()->length);
+        if (m_edid.raw() != blob) {
+            m_edid = Edid(blob);
+        }
         if (!m_edid.isValid()) {
             qCWarning(KWIN_DRM) << "Couldn't parse EDID for connector" << this;
         }
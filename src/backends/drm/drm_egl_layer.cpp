@@ -131,6 +131,11 @@ std::shared_ptr<DrmFramebuffer> EglGbmLayer::currentBuffer() const
     return m_scanoutBuffer ? m_scanoutBuffer : m_surface.currentBuffer();
 }
 
+std::chrono::nanoseconds EglGbmLayer::multiGpuCopyTime() const
+{
+    return m_surface.multiGpuCopyTime();
+}
+
 void EglGbmLayer::releaseBuffers()
 {
     m_scanoutBuffer.reset();
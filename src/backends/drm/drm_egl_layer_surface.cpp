@@ -14,6 +14,7 @@
 #include "core/graphicsbufferview.h"
 #include "core/iccprofile.h"
 #include "core/renderdevice.h"
+#include "drm_async_readback.h"
 #include "drm_egl_backend.h"
 #include "drm_gpu.h"
 #include "drm_logging.h"
@@ -40,6 +41,7 @@ static const QList<uint32_t> cpuCopyFormats = {DRM_FORMAT_ARGB8888, DRM_FORMAT_X
 
 static const bool bufferAgeEnabled = environmentVariableBoolValue("KWIN_USE_BUFFER_AGE").value_or(true);
 static const bool s_forceMGPUSync = environmentVariableBoolValue("KWIN_DRM_FORCE_GL_FINISH_MGPU_COPY").value_or(false);
+static const bool s_asyncMGPUCopy = environmentVariableBoolValue("KWIN_DRM_ASYNC_MGPU_COPY").value_or(true);
 static const bool s_forcePresentSync = environmentVariableBoolValue("KWIN_DRM_FORCE_GL_FINISH_PRESENT").value_or(false);
 
 static gbm_format_name_desc formatName(uint32_t format)
@@ -126,22 +128,7 @@ std::optional<OutputLayerBeginFrameInfo> EglGbmLayerSurface::startRendering(cons
     m_surface->compositingTimeQuery->begin();
     if (m_surface->needsShadowBuffer) {
         if (!m_surface->shadowSwapchain || m_surface->shadowSwapchain->size() != m_surface->gbmSwapchain->size()) {
-            const auto formats = m_eglBackend->eglDisplayObject()->nonExternalOnlySupportedDrmFormats();
-            const QList<FormatInfo> sortedFormats = OutputLayer::filterAndSortFormats(formats, requiredAlphaBits, tradeoff);
-            for (const auto format : sortedFormats) {
-                auto modifiers = formats[format.drmFormat];
-                if (format.floatingPoint && m_eglBackend->gpu()->isAmdgpu() && qEnvironmentVariableIntValue("KWIN_DRM_NO_DCC_WORKAROUND") == 0) {
-                    // using modifiers with DCC here causes glitches on amdgpu: https://gitlab.freedesktop.org/mesa/mesa/-/issues/10875
-                    if (!modifiers.contains(DRM_FORMAT_MOD_LINEAR)) {
-                        continue;
-                    }
-                    modifiers = {DRM_FORMAT_MOD_LINEAR};
-                }
-                m_surface->shadowSwapchain = EglSwapchain::create(m_eglBackend->drmDevice()->allocator(), m_eglBackend->openglContext(), m_surface->gbmSwapchain->size(), format.drmFormat, modifiers);
-                if (m_surface->shadowSwapchain) {
-                    break;
-                }
-            }
+            m_surface->shadowSwapchain = createShadowSwapchain(m_surface->gbmSwapchain->size(), tradeoff, requiredAlphaBits);
         }
         if (!m_surface->shadowSwapchain) {
             qCCritical(KWIN_DRM) << "Failed to create shadow swapchain!";
@@ -296,6 +283,14 @@ const std::shared_ptr<ColorDescription> &EglGbmLayerSurface::colorDescription()
     }
 }
 
+std::chrono::nanoseconds EglGbmLayerSurface::multiGpuCopyTime() const
+{
+    if (!m_surface || !m_surface->asyncReadback) {
+        return std::chrono::nanoseconds::zero();
+    }
+    return m_surface->asyncReadback->averageCopyTime();
+}
+
 std::shared_ptr<DrmFramebuffer> EglGbmLayerSurface::renderTestBuffer(const QSize &bufferSize, const QHash<uint32_t, QList<uint64_t>> &formats, BackendOutput::ColorPowerTradeoff tradeoff, uint32_t requiredAlphaBits)
 {
     EglContext *context = m_eglBackend->openglContext();
@@ -320,6 +315,26 @@ void EglGbmLayerSurface::forgetDamage()
     }
 }
 
+std::shared_ptr<EglSwapchain> EglGbmLayerSurface::createShadowSwapchain(const QSize &size, BackendOutput::ColorPowerTradeoff tradeoff, uint32_t requiredAlphaBits) const
+{
+    const auto formats = m_eglBackend->eglDisplayObject()->nonExternalOnlySupportedDrmFormats();
+    const QList<FormatInfo> sortedFormats = OutputLayer::filterAndSortFormats(formats, requiredAlphaBits, tradeoff);
+    for (const auto format : sortedFormats) {
+        auto modifiers = formats[format.drmFormat];
+        if (format.floatingPoint && m_eglBackend->gpu()->isAmdgpu() && qEnvironmentVariableIntValue("KWIN_DRM_NO_DCC_WORKAROUND") == 0) {
+            // using modifiers with DCC here causes glitches on amdgpu: https://gitlab.freedesktop.org/mesa/mesa/-/issues/10875
+            if (!modifiers.contains(DRM_FORMAT_MOD_LINEAR)) {
+                continue;
+            }
+            modifiers = {DRM_FORMAT_MOD_LINEAR};
+        }
+        if (auto swapchain = EglSwapchain::create(m_eglBackend->drmDevice()->allocator(), m_eglBackend->openglContext(), size, format.drmFormat, modifiers)) {
+            return swapchain;
+        }
+    }
+    return nullptr;
+}
+
 bool EglGbmLayerSurface::checkSurface(const QSize &size, const QHash<uint32_t, QList<uint64_t>> &formats, BackendOutput::ColorPowerTradeoff tradeoff, uint32_t requiredAlphaBits)
 {
     if (doesSurfaceFit(m_surface.get(), size, formats, tradeoff, requiredAlphaBits)) {
@@ -330,6 +345,16 @@ bool EglGbmLayerSurface::checkSurface(const QSize &size, const QHash<uint32_t, Q
         return true;
     }
     if (auto newSurface = createSurface(size, formats, tradeoff, requiredAlphaBits)) {
+        // this is usually called while testing a new output configuration, allocate the buffers
+        // for the first frames now rather than stalling on the allocations once the mode is applied
+        static constexpr int preallocatedBuffers = 2;
+        newSurface->gbmSwapchain->preallocate(preallocatedBuffers);
+        if (m_surface && m_surface->needsShadowBuffer) {
+            newSurface->shadowSwapchain = createShadowSwapchain(size, tradeoff, requiredAlphaBits);
+            if (newSurface->shadowSwapchain) {
+                newSurface->shadowSwapchain->preallocate(preallocatedBuffers);
+            }
+        }
         m_oldSurface = std::move(m_surface);
         if (m_oldSurface) {
             // FIXME: Use absolute frame sequence numbers for indexing the DamageJournal
@@ -665,16 +690,27 @@ std::shared_ptr<DrmFramebuffer> EglGbmLayerSurface::importWithCpu(Surface *surfa
     EglContext *context = m_eglBackend->openglContext();
     GLFramebuffer::pushFramebuffer(source->framebuffer());
     QImage *const dst = slot->view()->image();
-    if (dst->bytesPerLine() == srcStride) {
-        context->glReadnPixels(0, 0, dst->width(), dst->height(), GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, dst->sizeInBytes(), dst->bits());
-    } else {
-        // there's padding, need to copy line by line
-        if (surface->cpuCopyCache.size() != dst->size()) {
-            surface->cpuCopyCache = QImage(dst->size(), QImage::Format_RGBA8888);
-        }
-        context->glReadnPixels(0, 0, dst->width(), dst->height(), GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, surface->cpuCopyCache.sizeInBytes(), surface->cpuCopyCache.bits());
-        for (int i = 0; i < dst->height(); i++) {
-            std::memcpy(dst->scanLine(i), surface->cpuCopyCache.scanLine(i), srcStride);
+    // for multi-gpu copies, don't block the main thread until the copy is done but only the commit
+    const bool async = s_asyncMGPUCopy && frame && surface->importMode == MultiGpuImportMode::DumbBuffer && DrmAsyncReadback::isSupported(context);
+    if (async && !surface->asyncReadback) {
+        surface->asyncReadback = std::make_unique<DrmAsyncReadback>(context);
+    }
+    FileDescriptor copyFence;
+    if (async) {
+        copyFence = surface->asyncReadback->readback(slot->buffer(), dst);
+    }
+    if (!copyFence.isValid()) {
+        if (dst->bytesPerLine() == srcStride) {
+            context->glReadnPixels(0, 0, dst->width(), dst->height(), GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, dst->sizeInBytes(), dst->bits());
+        } else {
+            // there's padding, need to copy line by line
+            if (surface->cpuCopyCache.size() != dst->size()) {
+                surface->cpuCopyCache = QImage(dst->size(), QImage::Format_RGBA8888);
+            }
+            context->glReadnPixels(0, 0, dst->width(), dst->height(), GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, surface->cpuCopyCache.sizeInBytes(), surface->cpuCopyCache.bits());
+            for (int i = 0; i < dst->height(); i++) {
+                std::memcpy(dst->scanLine(i), surface->cpuCopyCache.scanLine(i), srcStride);
+            }
         }
     }
     GLFramebuffer::popFramebuffer();
@@ -682,6 +718,8 @@ std::shared_ptr<DrmFramebuffer> EglGbmLayerSurface::importWithCpu(Surface *surfa
     const auto ret = m_gpu->importBuffer(slot->buffer(), FileDescriptor{});
     if (!ret) {
         qCWarning(KWIN_DRM, "Failed to create a framebuffer: %s", strerror(errno));
+    } else if (copyFence.isValid()) {
+        ret->setCpuFence(std::move(copyFence));
     }
     surface->importDumbSwapchain->release(slot);
     if (frame) {
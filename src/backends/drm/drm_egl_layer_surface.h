@@ -23,6 +23,7 @@
 namespace KWin
 {
 
+class DrmAsyncReadback;
 class DrmFramebuffer;
 class EglSwapchain;
 class EglSwapchainSlot;
@@ -60,6 +61,11 @@ public:
 
     std::shared_ptr<DrmFramebuffer> currentBuffer() const;
     const std::shared_ptr<ColorDescription> &colorDescription() const;
+    /**
+     * The average time multi-gpu copies that don't block the main thread take to complete,
+     * or zero if none are done
+     */
+    std::chrono::nanoseconds multiGpuCopyTime() const;
 
 private:
     enum class MultiGpuImportMode {
@@ -80,6 +86,7 @@ private:
         std::shared_ptr<EglSwapchainSlot> currentSlot;
         DamageJournal damageJournal;
         std::unique_ptr<QPainterSwapchain> importDumbSwapchain;
+        std::unique_ptr<DrmAsyncReadback> asyncReadback;
         std::shared_ptr<EglContext> importContext;
         std::shared_ptr<EglSwapchain> importGbmSwapchain;
         QHash<GraphicsBuffer *, std::shared_ptr<GLTexture>> importedTextureCache;
@@ -109,6 +116,7 @@ private:
     bool doesSurfaceFit(Surface *surface, const QSize &size, const QHash<uint32_t, QList<uint64_t>> &formats, BackendOutput::ColorPowerTradeoff tradeoff, uint32_t requiredAlphaBits) const;
     std::unique_ptr<Surface> createSurface(const QSize &size, const QHash<uint32_t, QList<uint64_t>> &formats, BackendOutput::ColorPowerTradeoff tradeoff, uint32_t requiredAlphaBits) const;
     std::unique_ptr<Surface> createSurface(const QSize &size, uint32_t format, const QList<uint64_t> &modifiers, MultiGpuImportMode importMode, BufferTarget bufferTarget, BackendOutput::ColorPowerTradeoff tradeoff, uint32_t requiredAlphaBits) const;
+    std::shared_ptr<EglSwapchain> createShadowSwapchain(const QSize &size, BackendOutput::ColorPowerTradeoff tradeoff, uint32_t requiredAlphaBits) const;
     std::shared_ptr<EglSwapchain> createGbmSwapchain(DrmGpu *gpu, EglContext *context, const QSize &size, uint32_t format, const QList<uint64_t> &modifiers, MultiGpuImportMode importMode, BufferTarget bufferTarget) const;
 
     std::shared_ptr<DrmFramebuffer> doRenderTestBuffer(Surface *surface) const;
@@ -14,6 +14,7 @@
 #include "core/renderdevice.h"
 #include "core/session.h"
 #include "drm_backend.h"
+#include "drm_blob.h"
 #include "drm_buffer.h"
 #include "drm_commit.h"
 #include "drm_commit_thread.h"
@@ -64,6 +65,7 @@ DrmGpu::DrmGpu(DrmBackend *backend, int fd, std::unique_ptr<DrmDevice> &&device)
     , m_drmDevice(std::move(device))
     , m_atomicModeSetting(false)
     , m_platform(backend)
+    , m_commitScheduler(std::make_unique<DrmCommitScheduler>())
 {
     uint64_t capability = 0;
 
@@ -133,6 +135,7 @@ DrmGpu::DrmGpu(DrmBackend *backend, int fd, std::unique_ptr<DrmDevice> &&device)
 DrmGpu::~DrmGpu()
 {
     // clean up all `DrmFramebuffer`s before destroying the egl display
+    releaseRetainedFramebuffers();
     removeOutputs();
     m_planeLayerMap.clear();
     m_legacyLayerMap.clear();
@@ -252,6 +255,7 @@ bool DrmGpu::updateOutputs()
     if (!m_isActive) {
         return false;
     }
+    invalidateTestResults();
     DrmUniquePtr<drmModeRes> resources(drmModeGetResources(m_fd));
     if (!resources) {
         qCWarning(KWIN_DRM) << "drmModeGetResources failed:" << strerror(errno);
@@ -440,8 +444,19 @@ DrmPipeline::Error DrmGpu::testPendingConfiguration()
             return c1->crtcId.value() > c2->crtcId.value();
         });
     }
+    const QByteArray assignmentKey = crtcAssignmentKey(connectors);
+    if (restoreCrtcAssignment(assignmentKey, connectors, crtcs)) {
+        const auto err = testPipelines();
+        if (err == DrmPipeline::Error::None || err == DrmPipeline::Error::NoPermission || err == DrmPipeline::Error::FramePending) {
+            return err;
+        }
+        m_crtcAssignments.remove(assignmentKey);
+    }
     m_forceLowBandwidthMode = false;
     auto err = checkCrtcAssignment(connectors, crtcs, std::chrono::steady_clock::now() + s_checkCrtcTimeout);
+    if (err == DrmPipeline::Error::None) {
+        rememberCrtcAssignment(assignmentKey, connectors);
+    }
     if (err == DrmPipeline::Error::None || err == DrmPipeline::Error::NoPermission || err == DrmPipeline::Error::FramePending) {
         return err;
     }
@@ -453,10 +468,85 @@ DrmPipeline::Error DrmGpu::testPendingConfiguration()
         // got rejected; one possibility is missing memory bandwidth.
         m_forceLowBandwidthMode = true;
         err = checkCrtcAssignment(connectors, crtcs, std::chrono::steady_clock::now() + s_checkCrtcTimeout);
+        if (err == DrmPipeline::Error::None) {
+            rememberCrtcAssignment(assignmentKey, connectors);
+        }
     }
     return err;
 }
 
+QByteArray DrmGpu::crtcAssignmentKey(const QList<DrmConnector *> &connectors) const
+{
+    auto sorted = connectors;
+    std::ranges::sort(sorted, [](const DrmConnector *left, const DrmConnector *right) {
+        return left->id() < right->id();
+    });
+    QByteArray key;
+    for (DrmConnector *connector : std::as_const(sorted)) {
+        const auto it = m_pipelineMap.find(connector);
+        if (it == m_pipelineMap.end() || !connector->isConnected()) {
+            continue;
+        }
+        const DrmPipeline *pipeline = it->second.get();
+        key += QByteArray::number(connector->id()) + ':' + connector->edid()->hash().toLatin1();
+        if (pipeline->enabled() && pipeline->mode()) {
+            const QSize size = pipeline->mode()->size();
+            key += ':' + QByteArray::number(size.width()) + 'x' + QByteArray::number(size.height()) + '@' + QByteArray::number(pipeline->mode()->refreshRate());
+        }
+        key += ';';
+    }
+    return key;
+}
+
+bool DrmGpu::restoreCrtcAssignment(const QByteArray &key, const QList<DrmConnector *> &connectors, const QList<DrmCrtc *> &crtcs)
+{
+    const auto it = m_crtcAssignments.constFind(key);
+    if (it == m_crtcAssignments.constEnd()) {
+        return false;
+    }
+    for (const auto &[connectorId, crtcId] : it->connectorCrtcs) {
+        const auto connector = std::ranges::find_if(connectors, [connectorId](const DrmConnector *connector) {
+            return connector->id() == connectorId;
+        });
+        if (connector == connectors.end()) {
+            return false;
+        }
+        DrmCrtc *crtc = nullptr;
+        if (crtcId) {
+            const auto crtcIt = std::ranges::find_if(crtcs, [crtcId](const DrmCrtc *crtc) {
+                return crtc->id() == crtcId;
+            });
+            if (crtcIt == crtcs.end() || !(*connector)->isCrtcSupported(*crtcIt)) {
+                return false;
+            }
+            crtc = *crtcIt;
+        }
+        m_pipelineMap.at(*connector)->setCrtc(crtc);
+    }
+    m_forceLowBandwidthMode = it->lowBandwidthMode;
+    return true;
+}
+
+void DrmGpu::rememberCrtcAssignment(const QByteArray &key, const QList<DrmConnector *> &connectors)
+{
+    static constexpr qsizetype maxCachedAssignments = 16;
+    if (m_crtcAssignments.size() >= maxCachedAssignments) {
+        m_crtcAssignments.clear();
+    }
+    CrtcAssignment assignment{
+        .lowBandwidthMode = m_forceLowBandwidthMode,
+    };
+    for (DrmConnector *connector : connectors) {
+        const auto it = m_pipelineMap.find(connector);
+        if (it == m_pipelineMap.end() || !connector->isConnected()) {
+            continue;
+        }
+        const DrmCrtc *crtc = it->second->crtc();
+        assignment.connectorCrtcs.append(std::make_pair(connector->id(), crtc ? crtc->id() : 0));
+    }
+    m_crtcAssignments.insert(key, assignment);
+}
+
 void DrmGpu::releaseUnusedBuffers()
 {
     const auto isLayerUsed = [this](DrmPipelineLayer *layer) {
@@ -555,6 +645,10 @@ static std::chrono::nanoseconds convertTimestamp(clockid_t sourceClock, clockid_
 void DrmGpu::pageFlipHandler(int fd, unsigned int sequence, unsigned int sec, unsigned int usec, unsigned int crtc_id, void *user_data)
 {
     const auto commit = static_cast<DrmCommit *>(user_data);
+    // commits for multiple crtcs get one event per crtc, they're only done after the last one
+    if (!commit->pageflipEventReceived(crtc_id)) {
+        return;
+    }
     const auto gpu = commit->gpu();
     const bool defunct = std::erase_if(gpu->m_defunctCommits, [commit](const auto &defunct) {
         return defunct.get() == commit;
@@ -873,6 +967,9 @@ QSize DrmGpu::cursorSize() const
 
 void DrmGpu::releaseBuffers()
 {
+    releaseRetainedFramebuffers();
+    invalidateTestResults();
+
     for (DrmPipeline *pipeline : std::as_const(m_pipelines)) {
         pipeline->setLayers({});
         pipeline->applyPendingChanges();
@@ -960,8 +1057,12 @@ std::shared_ptr<DrmFramebuffer> DrmGpu::importBuffer(GraphicsBuffer *buffer, Fil
 
     const auto it = m_fbCache.constFind(buffer);
     if (it != m_fbCache.constEnd()) {
-        return std::make_shared<DrmFramebuffer>(it->lock(), buffer, std::move(readFence));
+        auto fbData = it->lock();
+        retainFramebuffer(buffer, fbData);
+        m_fbCacheStatistics.hits++;
+        return std::make_shared<DrmFramebuffer>(fbData, buffer, std::move(readFence));
     }
+    m_fbCacheStatistics.misses++;
 
     uint32_t handles[] = {0, 0, 0, 0};
     auto cleanup = qScopeGuard([this, &handles]() {
@@ -1034,9 +1135,35 @@ std::shared_ptr<DrmFramebuffer> DrmGpu::importBuffer(GraphicsBuffer *buffer, Fil
     auto fbData = std::make_shared<DrmFramebufferData>(this, framebufferId, buffer);
     m_fbCache[buffer] = fbData;
     connect(buffer, &GraphicsBuffer::destroyed, this, &DrmGpu::forgetBufferObject);
+    retainFramebuffer(buffer, fbData);
     return std::make_shared<DrmFramebuffer>(fbData, buffer, std::move(readFence));
 }
 
+void DrmGpu::retainFramebuffer(GraphicsBuffer *buffer, const std::shared_ptr<DrmFramebufferData> &data)
+{
+    static constexpr size_t maxRetainedFramebuffers = 16;
+
+    const auto it = std::ranges::find(m_retainedFramebuffers, buffer, &decltype(m_retainedFramebuffers)::value_type::first);
+    if (it != m_retainedFramebuffers.end()) {
+        std::rotate(m_retainedFramebuffers.begin(), it, it + 1);
+        return;
+    }
+
+    m_retainedFramebuffers.emplace_front(buffer, data);
+    if (m_retainedFramebuffers.size() > maxRetainedFramebuffers) {
+        // destroying the framebuffer may call forgetBuffer(), so take it out of the list first
+        const auto evicted = std::move(m_retainedFramebuffers.back());
+        m_retainedFramebuffers.pop_back();
+        m_fbCacheStatistics.evictions++;
+    }
+}
+
+void DrmGpu::releaseRetainedFramebuffers()
+{
+    // destroying the framebuffers calls forgetBuffer(), so take them out of the list first
+    const auto retained = std::exchange(m_retainedFramebuffers, {});
+}
+
 void DrmGpu::forgetBuffer(GraphicsBuffer *buf)
 {
     disconnect(buf, &GraphicsBuffer::destroyed, this, &DrmGpu::forgetBufferObject);
@@ -1046,6 +1173,74 @@ void DrmGpu::forgetBuffer(GraphicsBuffer *buf)
 void DrmGpu::forgetBufferObject(QObject *buf)
 {
     m_fbCache.remove(static_cast<GraphicsBuffer *>(buf));
+
+    const auto it = std::ranges::find(m_retainedFramebuffers, static_cast<GraphicsBuffer *>(buf), &decltype(m_retainedFramebuffers)::value_type::first);
+    if (it != m_retainedFramebuffers.end()) {
+        const auto forgotten = std::move(*it);
+        m_retainedFramebuffers.erase(it);
+    }
+}
+
+DrmGpu::FramebufferCacheStatistics DrmGpu::framebufferCacheStatistics() const
+{
+    auto ret = m_fbCacheStatistics;
+    ret.retained = m_retainedFramebuffers.size();
+    return ret;
+}
+
+std::optional<DrmPipeline::Error> DrmGpu::cachedTestResult(const QByteArray &key) const
+{
+    const auto it = m_testResults.constFind(key);
+    if (it == m_testResults.constEnd()) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+void DrmGpu::cacheTestResult(const QByteArray &key, DrmPipeline::Error result)
+{
+    static constexpr qsizetype maxCachedTestResults = 256;
+    if (m_testResults.size() >= maxCachedTestResults) {
+        m_testResults.clear();
+    }
+    m_testResults.insert(key, result);
+}
+
+void DrmGpu::invalidateTestResults()
+{
+    m_testResults.clear();
+}
+
+std::shared_ptr<DrmBlob> DrmGpu::cachedBlob(const QByteArray &data) const
+{
+    return m_blobCache.value(data).lock();
+}
+
+void DrmGpu::cacheBlob(const QByteArray &data, const std::shared_ptr<DrmBlob> &blob)
+{
+    m_blobCache[data] = blob;
+}
+
+void DrmGpu::forgetBlob(const QByteArray &data)
+{
+    const auto it = m_blobCache.find(data);
+    if (it != m_blobCache.end() && it->expired()) {
+        m_blobCache.erase(it);
+    }
+}
+
+std::shared_ptr<const drmModePropertyRes> DrmGpu::propertyMetadata(uint32_t propertyId)
+{
+    auto &metadata = m_propertyMetadata[propertyId];
+    if (!metadata) {
+        metadata = DrmUniquePtr<drmModePropertyRes>(drmModeGetProperty(m_fd, propertyId));
+    }
+    return metadata;
+}
+
+DrmCommitScheduler *DrmGpu::commitScheduler() const
+{
+    return m_commitScheduler.get();
 }
 
 QString DrmGpu::driverName() const
@@ -22,12 +22,14 @@
 #include <QTimer>
 
 #include <chrono>
+#include <deque>
 #include <epoxy/egl.h>
 #include <sys/types.h>
 
 namespace KWin
 {
 class DrmOutput;
+class DrmBlob;
 class DrmObject;
 class DrmCrtc;
 class DrmConnector;
@@ -42,6 +44,7 @@ class GraphicsBuffer;
 class GraphicsBufferAllocator;
 class OutputFrame;
 class DrmCommit;
+class DrmCommitScheduler;
 class RenderDevice;
 
 class DrmLease : public QObject
@@ -121,6 +124,36 @@ public:
 
     std::shared_ptr<DrmFramebuffer> importBuffer(GraphicsBuffer *buffer, FileDescriptor &&explicitFence);
     void forgetBuffer(GraphicsBuffer *buf);
+
+    struct FramebufferCacheStatistics
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t retained = 0;
+    };
+    FramebufferCacheStatistics framebufferCacheStatistics() const;
+
+    /**
+     * Results of atomic test commits are cached until the outputs or modes change, see
+     * DrmAtomicCommit::testCacheKey
+     */
+    std::optional<DrmPipeline::Error> cachedTestResult(const QByteArray &key) const;
+    void cacheTestResult(const QByteArray &key, DrmPipeline::Error result);
+    void invalidateTestResults();
+
+    /**
+     * Property blobs are shared by their contents, see DrmBlob::create
+     */
+    std::shared_ptr<DrmBlob> cachedBlob(const QByteArray &data) const;
+    void cacheBlob(const QByteArray &data, const std::shared_ptr<DrmBlob> &blob);
+    void forgetBlob(const QByteArray &data);
+
+    /**
+     * Returns the name, flags, range and enum values of a property. They can't change
+     * while the device is open, so they are only read from the kernel once
+     */
+    std::shared_ptr<const drmModePropertyRes> propertyMetadata(uint32_t propertyId);
     void releaseBuffers();
     void createLayers();
     QList<OutputLayer *> compatibleOutputLayers(BackendOutput *output) const;
@@ -131,6 +164,7 @@ public:
     void dispatchEvents();
 
     void addDefunctCommit(std::unique_ptr<DrmCommit> &&commit);
+    DrmCommitScheduler *commitScheduler() const;
 
 Q_SIGNALS:
     void activeChanged(bool active);
@@ -142,10 +176,15 @@ private:
     void removeOutput(DrmOutput *output);
     void initDrmResources();
     void forgetBufferObject(QObject *buf);
+    void retainFramebuffer(GraphicsBuffer *buffer, const std::shared_ptr<DrmFramebufferData> &data);
+    void releaseRetainedFramebuffers();
     void doModeset();
 
     DrmPipeline::Error checkCrtcAssignment(QList<DrmConnector *> connectors, const QList<DrmCrtc *> &crtcs, std::chrono::steady_clock::time_point deadline);
     DrmPipeline::Error testPipelines();
+    QByteArray crtcAssignmentKey(const QList<DrmConnector *> &connectors) const;
+    bool restoreCrtcAssignment(const QByteArray &key, const QList<DrmConnector *> &connectors, const QList<DrmCrtc *> &crtcs);
+    void rememberCrtcAssignment(const QByteArray &key, const QList<DrmConnector *> &connectors);
     QList<DrmObject *> unusedModesetObjects() const;
     void assignOutputLayers();
 
@@ -174,6 +213,7 @@ private:
     std::unique_ptr<RenderDevice> m_renderDevice;
     DrmBackend *const m_platform;
     std::optional<Version> m_nvidiaDriverVersion;
+    const std::unique_ptr<DrmCommitScheduler> m_commitScheduler;
 
     std::vector<std::unique_ptr<DrmPlane>> m_planes;
     std::vector<std::unique_ptr<DrmCrtc>> m_crtcs;
@@ -192,6 +232,21 @@ private:
     std::unordered_map<DrmPipeline *, std::shared_ptr<OutputFrame>> m_pendingModesetFrames;
     bool m_inModeset = false;
     QHash<GraphicsBuffer *, std::weak_ptr<DrmFramebufferData>> m_fbCache;
+    // the most recently used framebuffers are kept alive, even if nothing uses them right now, so
+    // that switching between direct scanout and compositing doesn't cause the buffers to be re-imported
+    std::deque<std::pair<GraphicsBuffer *, std::shared_ptr<DrmFramebufferData>>> m_retainedFramebuffers;
+    FramebufferCacheStatistics m_fbCacheStatistics;
+    QHash<QByteArray, DrmPipeline::Error> m_testResults;
+    QHash<QByteArray, std::weak_ptr<DrmBlob>> m_blobCache;
+    std::unordered_map<uint32_t, std::shared_ptr<const drmModePropertyRes>> m_propertyMetadata;
+    struct CrtcAssignment
+    {
+        QList<std::pair<uint32_t, uint32_t>> connectorCrtcs;
+        bool lowBandwidthMode = false;
+    };
+    // the CRTC assignments that worked for a set of monitors, unlike the test results they survive
+    // hotplugs, so that docking into a known setup doesn't need to search for an assignment again
+    QHash<QByteArray, CrtcAssignment> m_crtcAssignments;
     std::vector<std::unique_ptr<DrmCommit>> m_defunctCommits;
     QTimer m_delayedModesetTimer;
 };
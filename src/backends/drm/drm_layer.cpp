@@ -99,6 +99,11 @@ DrmPlane *DrmPipelineLayer::plane() const
     return m_plane;
 }
 
+std::chrono::nanoseconds DrmPipelineLayer::multiGpuCopyTime() const
+{
+    return std::chrono::nanoseconds::zero();
+}
+
 DrmPipeline *DrmPipelineLayer::pipeline() const
 {
     return drmOutput()->pipeline();
@@ -11,6 +11,7 @@
 #include "core/outputlayer.h"
 #include "drm_plane.h"
 
+#include <chrono>
 #include <memory>
 #include <optional>
 
@@ -43,6 +44,11 @@ public:
     QHash<uint32_t, QList<uint64_t>> supportedAsyncDrmFormats() const override;
 
     virtual std::shared_ptr<DrmFramebuffer> currentBuffer() const = 0;
+    /**
+     * The average time it takes to copy the contents of this layer to the GPU it's
+     * displayed on, or zero if no copy is needed
+     */
+    virtual std::chrono::nanoseconds multiGpuCopyTime() const;
 
     DrmPlane *plane() const;
 
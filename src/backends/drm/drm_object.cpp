@@ -46,7 +46,21 @@ DrmPropertyList DrmObject::queryProperties(int fd, uint32_t objectId, uint32_t o
 
 DrmPropertyList DrmObject::queryProperties() const
 {
-    return queryProperties(m_gpu->fd(), m_id, m_objectType);
+    DrmUniquePtr<drmModeObjectProperties> properties(drmModeObjectGetProperties(m_gpu->fd(), m_id, m_objectType));
+    if (!properties) {
+        qCWarning(KWIN_DRM) << "Failed to get properties for object" << m_id;
+        return {};
+    }
+    DrmPropertyList ret;
+    for (uint32_t i = 0; i < properties->count_props; i++) {
+        const auto prop = m_gpu->propertyMetadata(properties->props[i]);
+        if (!prop) {
+            qCWarning(KWIN_DRM, "Getting property %d of object %d failed!", properties->props[i], m_id);
+            continue;
+        }
+        ret.addProperty(prop, properties->prop_values[i]);
+    }
+    return ret;
 }
 
 uint32_t DrmObject::id() const
@@ -78,12 +92,12 @@ QString DrmObject::typeName() const
     }
 }
 
-void DrmPropertyList::addProperty(DrmUniquePtr<drmModePropertyRes> &&prop, uint64_t value)
+void DrmPropertyList::addProperty(const std::shared_ptr<const drmModePropertyRes> &prop, uint64_t value)
 {
-    m_properties.push_back(std::make_pair(std::move(prop), value));
+    m_properties.push_back(std::make_pair(prop, value));
 }
 
-std::optional<std::pair<DrmUniquePtr<drmModePropertyRes>, uint64_t>> DrmPropertyList::takeProperty(const QByteArray &name)
+std::optional<std::pair<std::shared_ptr<const drmModePropertyRes>, uint64_t>> DrmPropertyList::takeProperty(const QByteArray &name)
 {
     const auto it = std::ranges::find_if(m_properties, [&name](const auto &pair) {
         return pair.first->name == name;
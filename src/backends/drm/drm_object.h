@@ -13,6 +13,7 @@
 #include <QList>
 #include <QMap>
 
+#include <memory>
 #include <vector>
 
 // drm
@@ -32,11 +33,11 @@ class DrmAtomicCommit;
 class KWIN_EXPORT DrmPropertyList
 {
 public:
-    void addProperty(DrmUniquePtr<drmModePropertyRes> &&prop, uint64_t value);
-    std::optional<std::pair<DrmUniquePtr<drmModePropertyRes>, uint64_t>> takeProperty(const QByteArray &name);
+    void addProperty(const std::shared_ptr<const drmModePropertyRes> &prop, uint64_t value);
+    std::optional<std::pair<std::shared_ptr<const drmModePropertyRes>, uint64_t>> takeProperty(const QByteArray &name);
 
 private:
-    std::vector<std::pair<DrmUniquePtr<drmModePropertyRes>, uint64_t>> m_properties;
+    std::vector<std::pair<std::shared_ptr<const drmModePropertyRes>, uint64_t>> m_properties;
 };
 
 class KWIN_EXPORT DrmObject
@@ -62,6 +63,10 @@ public:
 protected:
     DrmObject(DrmGpu *gpu, uint32_t objectId, uint32_t objectType);
 
+    /**
+     * Like the static variant, but the property metadata is taken from the cache of the GPU,
+     * so only the current values need to be read from the kernel
+     */
     DrmPropertyList queryProperties() const;
 
 private:
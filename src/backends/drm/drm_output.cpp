@@ -8,6 +8,7 @@
 */
 #include "drm_output.h"
 #include "drm_backend.h"
+#include "drm_commit_thread.h"
 #include "drm_connector.h"
 #include "drm_crtc.h"
 #include "drm_gpu.h"
@@ -343,6 +344,49 @@ bool DrmOutput::overlayLayersLikelyBroken() const
     return m_gpu->isNVidia();
 }
 
+QVariantMap DrmOutput::presentationStatistics() const
+{
+    if (!m_pipeline) {
+        return {};
+    }
+    using Statistics = DrmCommitThread::Statistics;
+    const Statistics statistics = m_pipeline->commitThread()->statistics();
+    const auto toMicroseconds = [](std::chrono::nanoseconds duration) {
+        return double(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    };
+    const auto toList = [](const Statistics::Histogram &histogram) {
+        QVariantList ret;
+        for (uint64_t count : histogram) {
+            ret.push_back(qulonglong(count));
+        }
+        return ret;
+    };
+    std::chrono::nanoseconds multiGpuCopyTime = std::chrono::nanoseconds::zero();
+    for (const DrmPipelineLayer *layer : m_pipeline->layers()) {
+        multiGpuCopyTime = std::max(multiGpuCopyTime, layer->multiGpuCopyTime());
+    }
+    QVariantList bucketLimits;
+    for (size_t i = 0; i < Statistics::s_histogramSize - 1; i++) {
+        bucketLimits.push_back(toMicroseconds(Statistics::histogramBucketLimit(i)));
+    }
+    return QVariantMap{
+        {QStringLiteral("commits"), qulonglong(statistics.commits)},
+        {QStringLiteral("lateSubmissions"), qulonglong(statistics.lateSubmissions)},
+        {QStringLiteral("missedDeadlines"), qulonglong(statistics.missedDeadlines)},
+        {QStringLiteral("droppedCommits"), qulonglong(statistics.droppedCommits)},
+        {QStringLiteral("mainThreadHangs"), qulonglong(statistics.mainThreadHangs)},
+        {QStringLiteral("pageflipTimeouts"), qulonglong(statistics.pageflipTimeouts)},
+        {QStringLiteral("safetyMargin"), toMicroseconds(statistics.safetyMargin)},
+        {QStringLiteral("additionalSafetyMargin"), toMicroseconds(statistics.additionalSafetyMargin)},
+        {QStringLiteral("tunedSafetyMargin"), toMicroseconds(statistics.tunedSafetyMargin)},
+        {QStringLiteral("missRate"), statistics.missRate},
+        {QStringLiteral("histogramBucketLimits"), bucketLimits},
+        {QStringLiteral("commitToPageflipLatency"), toList(statistics.commitToPageflipLatency)},
+        {QStringLiteral("safetyMarginConsumed"), toList(statistics.safetyMarginConsumed)},
+        {QStringLiteral("multiGpuCopyTime"), toMicroseconds(multiGpuCopyTime)},
+    };
+}
+
 DrmConnector *DrmOutput::connector() const
 {
     return m_connector.get();
@@ -657,11 +701,11 @@ void DrmOutput::setChannelFactors(const QVector3D &rgb)
     m_sRgbChannelFactors = rgb;
     State next = m_state;
     next.colorDescription = applyNightLight(next.originalColorDescription, m_sRgbChannelFactors);
-    tryKmsColorOffloading(next);
+    tryKmsColorOffloading(next, true);
     setState(next);
 }
 
-void DrmOutput::tryKmsColorOffloading(State &next)
+void DrmOutput::tryKmsColorOffloading(State &next, bool onlyColorChanged)
 {
     if (!m_pipeline->activePending() || m_pipeline->layers().empty() || m_lease) {
         return;
@@ -713,12 +757,28 @@ void DrmOutput::tryKmsColorOffloading(State &next)
         }
     }
     m_pipeline->setCrtcColorPipeline(colorPipeline);
-    if (DrmPipeline::commitPipelines({m_pipeline}, DrmPipeline::CommitMode::Test) == DrmPipeline::Error::None) {
+    // Steps of a night light transition only change the values of the properties, but not
+    // which of them are used. That has already been tested, so don't block every step on
+    // another test commit.
+    DrmCrtc *crtc = m_pipeline->crtc();
+    std::optional<DrmAbstractColorOp::Layout> layout;
+    if (crtc && crtc->postBlendingPipeline) {
+        layout = crtc->postBlendingPipeline->layout(colorPipeline);
+    }
+    const bool alreadyTested = onlyColorChanged && layout && crtc == m_testedColorCrtc && *layout == m_testedColorLayout;
+    if (alreadyTested || DrmPipeline::commitPipelines({m_pipeline}, DrmPipeline::CommitMode::Test) == DrmPipeline::Error::None) {
         m_pipeline->applyPendingChanges();
         next.layerBlendingColor = next.blendingColor;
         m_needsShadowBuffer = false;
+        if (layout) {
+            m_testedColorCrtc = crtc;
+            m_testedColorLayout = std::move(*layout);
+        } else {
+            m_testedColorCrtc = nullptr;
+        }
         return;
     }
+    m_testedColorCrtc = nullptr;
     if (next.colorDescription->transferFunction().type == blendingSpace && !usesICC) {
         // Allow falling back to applying night light in non-linear space.
         // This isn't technically correct, but the difference is quite small and not worth
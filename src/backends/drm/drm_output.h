@@ -45,6 +45,7 @@ public:
     bool present(const QList<OutputLayer *> &layersToUpdate, const std::shared_ptr<OutputFrame> &frame) override;
     void repairPresentation() override;
     bool overlayLayersLikelyBroken() const override;
+    QVariantMap presentationStatistics() const override;
 
     bool queueChanges(const std::shared_ptr<OutputChangeSet> &properties);
     void applyQueuedChanges(const std::shared_ptr<OutputChangeSet> &properties);
@@ -74,7 +75,7 @@ public:
     const State &nextState() const;
 
 private:
-    void tryKmsColorOffloading(State &next);
+    void tryKmsColorOffloading(State &next, bool onlyColorChanged = false);
     double calculateMaxArtificialHdrHeadroom(const State &next) const;
     std::shared_ptr<ColorDescription> createColorDescription(const State &next) const;
     Capabilities computeCapabilities() const;
@@ -94,6 +95,9 @@ private:
 
     QVector3D m_sRgbChannelFactors = {1, 1, 1};
     bool m_needsShadowBuffer = false;
+    // the CRTC color pipeline layout that last passed a test commit
+    DrmCrtc *m_testedColorCrtc = nullptr;
+    DrmAbstractColorOp::Layout m_testedColorLayout;
     PresentationMode m_desiredPresentationMode = PresentationMode::VSync;
     bool m_autoRotateAvailable = false;
     bool m_autoBrightnessAvailable = false;
@@ -47,6 +47,7 @@ DrmPipeline::~DrmPipeline()
 {
     // the commit thread may still access the pipeline until it's stopped
     // so it must be deleted before everything else
+    m_commitThread->forgetPipeline(this);
     m_commitThread.reset();
 }
 
@@ -77,9 +78,13 @@ DrmPipeline::Error DrmPipeline::present(const QList<OutputLayer *> &layersToUpda
                 return err;
             }
         }
-        if (layersToUpdate.isEmpty()) {
-            // work around amdgpu not giving us a valid pageflip timestamp
-            // if the commit doesn't contain a drm plane
+        const bool primaryLayerUpdated = std::ranges::any_of(layersToUpdate, [this](OutputLayer *layer) {
+            return layer == m_pending.layers.front();
+        });
+        // work around amdgpu not giving us a valid pageflip timestamp if the commit doesn't contain
+        // a drm plane. The color pipeline of the primary plane may also have to move between the
+        // plane and the CRTC when other layers get enabled or disabled
+        if (!primaryLayerUpdated && (layersToUpdate.isEmpty() || !m_pending.layers.front()->colorPipeline().isIdentity())) {
             if (Error err = prepareAtomicPlane(partialUpdate.get(), m_pending.layers.front()->plane(), m_pending.layers.front(), frame); err != Error::None) {
                 return err;
             }
@@ -165,14 +170,22 @@ DrmPipeline::Error DrmPipeline::commitPipelinesAtomic(const QList<DrmPipeline *>
         for (const auto pipeline : pipelines) {
             pipeline->m_next.needsModeset = pipeline->m_pending.needsModeset = false;
         }
+        pipelines.front()->gpu()->invalidateTestResults();
         commit->pageFlipped(std::chrono::steady_clock::now().time_since_epoch());
         return Error::None;
     }
     case CommitMode::Test: {
-        if (!commit->test()) {
-            return errnoToError();
+        DrmGpu *gpu = pipelines.front()->gpu();
+        const QByteArray key = commit->testCacheKey();
+        if (const auto cached = gpu->cachedTestResult(key)) {
+            return *cached;
         }
-        return Error::None;
+        const Error result = commit->test() ? Error::None : errnoToError();
+        // errors other than EINVAL are transient and don't say anything about the configuration
+        if (result == Error::None || result == Error::InvalidArguments) {
+            gpu->cacheTestResult(key, result);
+        }
+        return result;
     }
     default:
         Q_UNREACHABLE();
@@ -212,7 +225,13 @@ DrmPipeline::Error DrmPipeline::prepareAtomicPresentation(DrmAtomicCommit *commi
         commit->setVrr(m_pending.crtc, m_pending.presentationMode == PresentationMode::AdaptiveSync || m_pending.presentationMode == PresentationMode::AdaptiveAsync);
     }
 
-    const ColorPipeline &colorPipeline = m_pending.crtcColorPipeline;
+    ColorPipeline colorPipeline = m_pending.crtcColorPipeline;
+    const auto merged = std::ranges::find_if(m_pending.layers, [this](DrmPipelineLayer *layer) {
+        return mergesLayerColorPipeline(layer);
+    });
+    if (merged != m_pending.layers.end()) {
+        colorPipeline = (*merged)->colorPipeline().merged(colorPipeline);
+    }
     if (!m_pending.crtc->postBlendingPipeline) {
         if (!colorPipeline.isIdentity()) {
             return Error::InvalidArguments;
@@ -226,6 +245,36 @@ DrmPipeline::Error DrmPipeline::prepareAtomicPresentation(DrmAtomicCommit *commi
     return Error::None;
 }
 
+bool DrmPipeline::mergesLayerColorPipeline(const DrmPipelineLayer *layer) const
+{
+    if (!layer->isEnabled() || layer->colorPipeline().isIdentity() || !m_pending.crtc->postBlendingPipeline) {
+        return false;
+    }
+    // applying the color pipeline after blending is only equivalent if nothing else is blended with
+    // the layer, not even the background of the CRTC
+    if (layer->targetRect() != Rect(QPoint(), m_pending.mode->size())) {
+        return false;
+    }
+    const auto fb = layer->currentBuffer();
+    if (!fb || !fb->buffer() || fb->buffer()->hasAlphaChannel()) {
+        return false;
+    }
+    const bool otherLayersEnabled = std::ranges::any_of(m_pending.layers, [layer](DrmPipelineLayer *other) {
+        return other != layer && other->isEnabled();
+    });
+    if (otherLayersEnabled) {
+        return false;
+    }
+    // the plane's own color pipeline is preferred, if it can do the job
+    if (DrmPlane *plane = layer->plane()) {
+        const auto colorPipelines = plane->colorPipelines();
+        return std::ranges::none_of(colorPipelines, [layer](DrmColorOp *pipeline) {
+            return pipeline->colorOp()->layout(layer->colorPipeline()).has_value();
+        });
+    }
+    return true;
+}
+
 DrmPipeline::Error DrmPipeline::prepareAtomicPlane(DrmAtomicCommit *commit, DrmPlane *plane, DrmPipelineLayer *layer, const std::shared_ptr<OutputFrame> &frame)
 {
     if (!layer->isEnabled()) {
@@ -253,6 +302,12 @@ DrmPipeline::Error DrmPipeline::prepareAtomicPlane(DrmAtomicCommit *commit, DrmP
     commit->addProperty(plane->crtcId, m_pending.crtc->id());
     commit->addBuffer(plane, fb, frame);
     plane->set(commit, layer->sourceRect().toRect(), layer->targetRect());
+    if (plane->scalingFilter.isValid() && plane->scalingFilter.hasEnum(DrmPlane::ScalingFilter::Default)) {
+        // scaled buffers, like a game rendering at a lower resolution through wp_viewporter, have
+        // to look the same on the plane as in the composited result, which filters linearly.
+        // Another DRM master may have left a different filter behind
+        commit->addEnum(plane->scalingFilter, DrmPlane::ScalingFilter::Default);
+    }
     if (plane->vmHotspotX.isValid() && plane->vmHotspotY.isValid()) {
         commit->addProperty(plane->vmHotspotX, std::round(layer->hotspot().x()));
         commit->addProperty(plane->vmHotspotY, std::round(layer->hotspot().y()));
@@ -268,25 +323,32 @@ DrmPipeline::Error DrmPipeline::prepareAtomicPlane(DrmAtomicCommit *commit, DrmP
         commit->addProperty(plane->zpos, layer->zpos());
     }
 
-    const auto colorPipelines = plane->colorPipelines();
-    if (layer->colorPipeline().isIdentity()) {
+    const bool yuv = layer->colorDescription()->yuvCoefficients() != YUVMatrixCoefficients::Identity;
+    ColorPipeline planePipeline = mergesLayerColorPipeline(layer) ? ColorPipeline{} : layer->colorPipeline();
+    if (plane->colorPipeline.isValid() && yuv) {
+        // the color encoding and color range properties can't be combined with color pipelines,
+        // so the conversion to RGB has to be the first operation of the plane's pipeline instead
+        ColorPipeline conversion(ValueRange{.min = 0, .max = 1}, ColorspaceType::AnyNonRGB);
+        conversion.addMatrix(layer->colorDescription()->yuvMatrix(), ValueRange{.min = 0, .max = 1}, ColorspaceType::NonLinearRGB);
+        conversion.add(planePipeline);
+        planePipeline = conversion;
+    }
+    if (planePipeline.isIdentity()) {
         if (plane->colorPipeline.isValid()) {
             commit->addProperty(plane->colorPipeline, 0);
         }
     } else {
+        const auto colorPipelines = plane->colorPipelines();
         const auto it = std::ranges::find_if(colorPipelines, [&](DrmColorOp *pipeline) {
-            return pipeline->colorOp()->matchPipeline(commit, layer->colorPipeline());
+            return pipeline->colorOp()->matchPipeline(commit, planePipeline);
         });
         if (it == colorPipelines.end()) {
-            // TODO re-allow merging with post-blending pipeline
             return DrmPipeline::Error::InvalidArguments;
         }
         commit->addProperty(plane->colorPipeline, (*it)->id());
     }
-
-    if (plane->colorPipeline.isValid() && layer->colorDescription()->yuvCoefficients() != YUVMatrixCoefficients::Identity) {
-        // color pipelines don't support the color encoding and color range properties yet
-        return Error::InvalidArguments;
+    if (plane->colorPipeline.isValid() && yuv) {
+        return Error::None;
     }
     DrmPlane::ColorRange range = DrmPlane::ColorRange::Limited_YCbCr;
     if (layer->colorDescription()->range() == EncodingRange::Full) {
@@ -458,6 +520,10 @@ bool DrmPipeline::presentAsync(OutputLayer *layer, std::optional<std::chrono::na
     }
     const auto drmLayer = static_cast<DrmPipelineLayer *>(layer);
     if (drmLayer->plane()) {
+        if (m_commitThread->latchCursorPosition(drmLayer->plane(), drmLayer->targetRect())) {
+            // a pending commit gets moved to the new position right before it's submitted
+            return true;
+        }
         // test the full state, to take pending commits into account
         if (DrmPipeline::commitPipelinesAtomic({this}, CommitMode::Test, nullptr, {}) != Error::None) {
             return false;
@@ -136,6 +136,11 @@ private:
     bool prepareAtomicModeset(DrmAtomicCommit *commit);
     Error prepareAtomicPresentation(DrmAtomicCommit *commit, const std::shared_ptr<OutputFrame> &frame);
     Error prepareAtomicPlane(DrmAtomicCommit *commit, DrmPlane *plane, DrmPipelineLayer *layer, const std::shared_ptr<OutputFrame> &frame);
+    /**
+     * Whether the color pipeline of the layer can't be offloaded to the plane, but can be
+     * applied by the CRTC together with its own pipeline instead
+     */
+    bool mergesLayerColorPipeline(const DrmPipelineLayer *layer) const;
     void prepareAtomicDisable(DrmAtomicCommit *commit);
     static Error commitPipelinesAtomic(const QList<DrmPipeline *> &pipelines, CommitMode mode, const std::shared_ptr<OutputFrame> &frame, const QList<DrmObject *> &unusedObjects);
 
@@ -66,6 +66,10 @@ DrmPlane::DrmPlane(DrmGpu *gpu, uint32_t planeId)
                                                              QByteArrayLiteral("YCbCr limited range"),
                                                              QByteArrayLiteral("YCbCr full range"),
                                                          })
+    , scalingFilter(this, QByteArrayLiteral("SCALING_FILTER"), {
+                                                                   QByteArrayLiteral("Default"),
+                                                                   QByteArrayLiteral("Nearest Neighbor"),
+                                                               })
     , vmHotspotX(this, QByteArrayLiteral("HOTSPOT_X"))
     , vmHotspotY(this, QByteArrayLiteral("HOTSPOT_Y"))
     , inFenceFd(this, QByteArrayLiteral("IN_FENCE_FD"))
@@ -106,6 +110,7 @@ bool DrmPlane::updateProperties()
     pixelBlendMode.update(props);
     colorEncoding.update(props);
     colorRange.update(props);
+    scalingFilter.update(props);
     vmHotspotX.update(props);
     vmHotspotY.update(props);
     inFenceFd.update(props);
@@ -82,6 +82,10 @@ public:
         Limited_YCbCr,
         Full_YCbCr
     };
+    enum class ScalingFilter : uint64_t {
+        Default,
+        NearestNeighbor
+    };
 
     DrmEnumProperty<TypeIndex> type;
     DrmProperty srcX;
@@ -100,6 +104,7 @@ public:
     DrmEnumProperty<PixelBlendMode> pixelBlendMode;
     DrmEnumProperty<ColorEncoding> colorEncoding;
     DrmEnumProperty<ColorRange> colorRange;
+    DrmEnumProperty<ScalingFilter> scalingFilter;
     DrmProperty vmHotspotX;
     DrmProperty vmHotspotY;
     DrmProperty inFenceFd;
@@ -181,6 +181,15 @@ void Connection::handleEvent()
         if (!event) {
             break;
         }
+        // merge relative motion here rather than on the main thread, so that a busy main
+        // thread only has to deal with one event per device and batch
+        if (event->type() == LIBINPUT_EVENT_POINTER_MOTION && !m_eventQueue.empty()) {
+            Event *previous = m_eventQueue.back().get();
+            if (previous->type() == LIBINPUT_EVENT_POINTER_MOTION && previous->nativeDevice() == event->nativeDevice()) {
+                static_cast<PointerEvent *>(previous)->accumulateMotion(*static_cast<PointerEvent *>(event));
+                continue;
+            }
+        }
         m_eventQueue.push_back(std::move(event));
     } while (true);
     if (wasEmpty && !m_eventQueue.empty()) {
@@ -239,6 +248,7 @@ static QPointF tabletToolPosition(TabletToolEvent *event)
 
 TabletTool *Connection::getOrCreateTool(libinput_tablet_tool *handle)
 {
+    QMutexLocker locker(&m_mutex);
     for (TabletTool *tool : std::as_const(m_tools)) {
         if (tool->handle() == handle) {
             return tool;
@@ -254,357 +264,357 @@ TabletTool *Connection::getOrCreateTool(libinput_tablet_tool *handle)
 
 void Connection::processEvents()
 {
+    // take the whole batch, so that the input thread can keep reading events while they are
+    // being processed. libinput isn't thread safe though, so the events are still destroyed
+    // and devices are still created with the lock held
+    std::deque<std::unique_ptr<Event>> events;
+    {
+        QMutexLocker locker(&m_mutex);
+        events.swap(m_eventQueue);
+    }
+    for (const std::unique_ptr<Event> &event : events) {
+        processEvent(event.get());
+    }
     QMutexLocker locker(&m_mutex);
-    while (m_eventQueue.size() != 0) {
-        std::unique_ptr<Event> event = std::move(m_eventQueue.front());
-        m_eventQueue.pop_front();
-        switch (event->type()) {
-        case LIBINPUT_EVENT_DEVICE_ADDED: {
-            auto device = new Device(event->nativeDevice());
-            device->moveToThread(thread());
-            m_devices << device;
-
-            applyDeviceConfig(device);
-            applyScreenToDevice(device);
-
-            connect(device, &Device::outputNameChanged, this, [this, device] {
-                // If the output name changes from something to empty we need to
-                // re-run the assignment heuristic so that an output is assigned
-                if (device->outputName().isEmpty()) {
-                    applyScreenToDevice(device);
-                }
-            });
-
-            Q_EMIT deviceAdded(device);
-            break;
-        }
-        case LIBINPUT_EVENT_DEVICE_REMOVED: {
-            auto it = std::ranges::find_if(std::as_const(m_devices), [&event](Device *d) {
-                return event->device() == d;
-            });
-            if (it == m_devices.cend()) {
-                // we don't know this device
-                break;
-            }
-            auto device = *it;
-            m_devices.erase(it);
-            Q_EMIT deviceRemoved(device);
-            device->deleteLater();
-            break;
-        }
-        case LIBINPUT_EVENT_KEYBOARD_KEY: {
-            KeyEvent *ke = static_cast<KeyEvent *>(event.get());
-            const int seatKeyCount = libinput_event_keyboard_get_seat_key_count(*ke);
-            const int keyState = libinput_event_keyboard_get_key_state(*ke);
-            if ((keyState == LIBINPUT_KEY_STATE_PRESSED && seatKeyCount != 1) ||
-                (keyState == LIBINPUT_KEY_STATE_RELEASED && seatKeyCount != 0)) {
-                break;
-            }
-            Q_EMIT ke->device()->keyChanged(ke->key(), ke->state(), ke->time(), ke->device());
-            break;
-        }
-        case LIBINPUT_EVENT_POINTER_SCROLL_WHEEL: {
-            const PointerEvent *pointerEvent = static_cast<PointerEvent *>(event.get());
-            const auto axes = pointerEvent->axis();
-            for (const PointerAxis &axis : axes) {
-                Q_EMIT pointerEvent->device()->pointerAxisChanged(axis,
-                                                                  pointerEvent->scrollValue(axis),
-                                                                  pointerEvent->scrollValueV120(axis),
-                                                                  PointerAxisSource::Wheel,
-                                                                  pointerEvent->device()->isNaturalScroll(),
-                                                                  pointerEvent->time(),
-                                                                  pointerEvent->device());
-            }
-            Q_EMIT pointerEvent->device()->pointerFrame(pointerEvent->device());
-            break;
-        }
-        case LIBINPUT_EVENT_POINTER_SCROLL_FINGER: {
-            const PointerEvent *pointerEvent = static_cast<PointerEvent *>(event.get());
-            const auto axes = pointerEvent->axis();
-            for (const PointerAxis &axis : axes) {
-                Q_EMIT pointerEvent->device()->pointerAxisChanged(axis,
-                                                                  pointerEvent->scrollValue(axis),
-                                                                  0,
-                                                                  PointerAxisSource::Finger,
-                                                                  pointerEvent->device()->isNaturalScroll(),
-                                                                  pointerEvent->time(),
-                                                                  pointerEvent->device());
+    events.clear();
+}
+
+void Connection::processEvent(Event *event)
+{
+    switch (event->type()) {
+    case LIBINPUT_EVENT_DEVICE_ADDED: {
+        QMutexLocker locker(&m_mutex);
+        auto device = new Device(event->nativeDevice());
+        device->moveToThread(thread());
+        m_devices << device;
+
+        applyDeviceConfig(device);
+        applyScreenToDevice(device);
+
+        connect(device, &Device::outputNameChanged, this, [this, device] {
+            // If the output name changes from something to empty we need to
+            // re-run the assignment heuristic so that an output is assigned
+            if (device->outputName().isEmpty()) {
+                applyScreenToDevice(device);
             }
-            Q_EMIT pointerEvent->device()->pointerFrame(pointerEvent->device());
+        });
+
+        Q_EMIT deviceAdded(device);
+        break;
+    }
+    case LIBINPUT_EVENT_DEVICE_REMOVED: {
+        QMutexLocker locker(&m_mutex);
+        auto it = std::ranges::find_if(std::as_const(m_devices), [&event](Device *d) {
+            return event->device() == d;
+        });
+        if (it == m_devices.cend()) {
+            // we don't know this device
             break;
         }
-        case LIBINPUT_EVENT_POINTER_SCROLL_CONTINUOUS: {
-            const PointerEvent *pointerEvent = static_cast<PointerEvent *>(event.get());
-            const auto axes = pointerEvent->axis();
-            for (const PointerAxis &axis : axes) {
-                Q_EMIT pointerEvent->device()->pointerAxisChanged(axis,
-                                                                  pointerEvent->scrollValue(axis),
-                                                                  0,
-                                                                  PointerAxisSource::Continuous,
-                                                                  pointerEvent->device()->isNaturalScroll(),
-                                                                  pointerEvent->time(),
-                                                                  pointerEvent->device());
-            }
-            Q_EMIT pointerEvent->device()->pointerFrame(pointerEvent->device());
+        auto device = *it;
+        m_devices.erase(it);
+        Q_EMIT deviceRemoved(device);
+        device->deleteLater();
+        break;
+    }
+    case LIBINPUT_EVENT_KEYBOARD_KEY: {
+        KeyEvent *ke = static_cast<KeyEvent *>(event);
+        const int seatKeyCount = libinput_event_keyboard_get_seat_key_count(*ke);
+        const int keyState = libinput_event_keyboard_get_key_state(*ke);
+        if ((keyState == LIBINPUT_KEY_STATE_PRESSED && seatKeyCount != 1) ||
+            (keyState == LIBINPUT_KEY_STATE_RELEASED && seatKeyCount != 0)) {
             break;
         }
-        case LIBINPUT_EVENT_POINTER_BUTTON: {
-            PointerEvent *pe = static_cast<PointerEvent *>(event.get());
-            const int seatButtonCount = libinput_event_pointer_get_seat_button_count(*pe);
-            const int buttonState = libinput_event_pointer_get_button_state(*pe);
-            if ((buttonState == LIBINPUT_BUTTON_STATE_PRESSED && seatButtonCount != 1) ||
-                (buttonState == LIBINPUT_BUTTON_STATE_RELEASED && seatButtonCount != 0)) {
-                break;
-            }
-            Q_EMIT pe->device()->pointerButtonChanged(pe->button(), pe->buttonState(), pe->time(), pe->device());
-            Q_EMIT pe->device()->pointerFrame(pe->device());
+        Q_EMIT ke->device()->keyChanged(ke->key(), ke->state(), ke->time(), ke->device());
+        break;
+    }
+    case LIBINPUT_EVENT_POINTER_SCROLL_WHEEL: {
+        const PointerEvent *pointerEvent = static_cast<PointerEvent *>(event);
+        const auto axes = pointerEvent->axis();
+        for (const PointerAxis &axis : axes) {
+            Q_EMIT pointerEvent->device()->pointerAxisChanged(axis,
+                                                              pointerEvent->scrollValue(axis),
+                                                              pointerEvent->scrollValueV120(axis),
+                                                              PointerAxisSource::Wheel,
+                                                              pointerEvent->device()->isNaturalScroll(),
+                                                              pointerEvent->time(),
+                                                              pointerEvent->device());
+        }
+        Q_EMIT pointerEvent->device()->pointerFrame(pointerEvent->device());
+        break;
+    }
+    case LIBINPUT_EVENT_POINTER_SCROLL_FINGER: {
+        const PointerEvent *pointerEvent = static_cast<PointerEvent *>(event);
+        const auto axes = pointerEvent->axis();
+        for (const PointerAxis &axis : axes) {
+            Q_EMIT pointerEvent->device()->pointerAxisChanged(axis,
+                                                              pointerEvent->scrollValue(axis),
+                                                              0,
+                                                              PointerAxisSource::Finger,
+                                                              pointerEvent->device()->isNaturalScroll(),
+                                                              pointerEvent->time(),
+                                                              pointerEvent->device());
+        }
+        Q_EMIT pointerEvent->device()->pointerFrame(pointerEvent->device());
+        break;
+    }
+    case LIBINPUT_EVENT_POINTER_SCROLL_CONTINUOUS: {
+        const PointerEvent *pointerEvent = static_cast<PointerEvent *>(event);
+        const auto axes = pointerEvent->axis();
+        for (const PointerAxis &axis : axes) {
+            Q_EMIT pointerEvent->device()->pointerAxisChanged(axis,
+                                                              pointerEvent->scrollValue(axis),
+                                                              0,
+                                                              PointerAxisSource::Continuous,
+                                                              pointerEvent->device()->isNaturalScroll(),
+                                                              pointerEvent->time(),
+                                                              pointerEvent->device());
+        }
+        Q_EMIT pointerEvent->device()->pointerFrame(pointerEvent->device());
+        break;
+    }
+    case LIBINPUT_EVENT_POINTER_BUTTON: {
+        PointerEvent *pe = static_cast<PointerEvent *>(event);
+        const int seatButtonCount = libinput_event_pointer_get_seat_button_count(*pe);
+        const int buttonState = libinput_event_pointer_get_button_state(*pe);
+        if ((buttonState == LIBINPUT_BUTTON_STATE_PRESSED && seatButtonCount != 1) ||
+            (buttonState == LIBINPUT_BUTTON_STATE_RELEASED && seatButtonCount != 0)) {
             break;
         }
-        case LIBINPUT_EVENT_POINTER_MOTION: {
-            PointerEvent *pe = static_cast<PointerEvent *>(event.get());
-            auto delta = pe->delta();
-            auto deltaNonAccel = pe->deltaUnaccelerated();
-            auto latestTime = pe->time();
-            auto it = m_eventQueue.begin();
-            while (it != m_eventQueue.end()) {
-                if ((*it)->type() == LIBINPUT_EVENT_POINTER_MOTION) {
-                    std::unique_ptr<PointerEvent> p{static_cast<PointerEvent *>(it->release())};
-                    delta += p->delta();
-                    deltaNonAccel += p->deltaUnaccelerated();
-                    latestTime = p->time();
-                    it = m_eventQueue.erase(it);
-                } else {
-                    break;
-                }
-            }
-            Q_EMIT pe->device()->pointerMotion(delta, deltaNonAccel, latestTime, pe->device());
+        Q_EMIT pe->device()->pointerButtonChanged(pe->button(), pe->buttonState(), pe->time(), pe->device());
+        Q_EMIT pe->device()->pointerFrame(pe->device());
+        break;
+    }
+    case LIBINPUT_EVENT_POINTER_MOTION: {
+        PointerEvent *pe = static_cast<PointerEvent *>(event);
+        // consecutive motion events have already been merged on the input thread
+        Q_EMIT pe->device()->pointerMotion(pe->delta(), pe->deltaUnaccelerated(), pe->time(), pe->device());
+        Q_EMIT pe->device()->pointerFrame(pe->device());
+        break;
+    }
+    case LIBINPUT_EVENT_POINTER_MOTION_ABSOLUTE: {
+        PointerEvent *pe = static_cast<PointerEvent *>(event);
+        if (workspace()) {
+            Q_EMIT pe->device()->pointerMotionAbsolute(pe->absolutePos(workspace()->geometry().size()), pe->time(), pe->device());
             Q_EMIT pe->device()->pointerFrame(pe->device());
-            break;
-        }
-        case LIBINPUT_EVENT_POINTER_MOTION_ABSOLUTE: {
-            PointerEvent *pe = static_cast<PointerEvent *>(event.get());
-            if (workspace()) {
-                Q_EMIT pe->device()->pointerMotionAbsolute(pe->absolutePos(workspace()->geometry().size()), pe->time(), pe->device());
-                Q_EMIT pe->device()->pointerFrame(pe->device());
-            }
-            break;
         }
-        case LIBINPUT_EVENT_TOUCH_DOWN: {
+        break;
+    }
+    case LIBINPUT_EVENT_TOUCH_DOWN: {
 #ifndef KWIN_BUILD_TESTING
-            TouchEvent *te = static_cast<TouchEvent *>(event.get());
-            const auto *output = te->device()->output();
-            if (!output) {
-                qCWarning(KWIN_LIBINPUT) << "Touch down received for device with no output assigned";
-                break;
-            }
-            const QPointF globalPos = devicePointToGlobalPosition(te->absolutePos(output->modeSize()), output);
-            Q_EMIT te->device()->touchDown(te->id(), globalPos, te->time(), te->device());
-            break;
-#endif
-        }
-        case LIBINPUT_EVENT_TOUCH_UP: {
-            TouchEvent *te = static_cast<TouchEvent *>(event.get());
-            const auto *output = te->device()->output();
-            if (!output) {
-                break;
-            }
-            Q_EMIT te->device()->touchUp(te->id(), te->time(), te->device());
+        TouchEvent *te = static_cast<TouchEvent *>(event);
+        const auto *output = te->device()->output();
+        if (!output) {
+            qCWarning(KWIN_LIBINPUT) << "Touch down received for device with no output assigned";
             break;
         }
-        case LIBINPUT_EVENT_TOUCH_MOTION: {
-#ifndef KWIN_BUILD_TESTING
-            TouchEvent *te = static_cast<TouchEvent *>(event.get());
-            const auto *output = te->device()->output();
-            if (!output) {
-                break;
-            }
-            const QPointF globalPos = devicePointToGlobalPosition(te->absolutePos(output->modeSize()), output);
-            Q_EMIT te->device()->touchMotion(te->id(), globalPos, te->time(), te->device());
-            break;
+        const QPointF globalPos = devicePointToGlobalPosition(te->absolutePos(output->modeSize()), output);
+        Q_EMIT te->device()->touchDown(te->id(), globalPos, te->time(), te->device());
+        break;
 #endif
-        }
-        case LIBINPUT_EVENT_TOUCH_CANCEL: {
-            Q_EMIT event->device()->touchCanceled(event->device());
-            break;
-        }
-        case LIBINPUT_EVENT_TOUCH_FRAME: {
-            Q_EMIT event->device()->touchFrame(event->device());
-            break;
-        }
-        case LIBINPUT_EVENT_GESTURE_PINCH_BEGIN: {
-            PinchGestureEvent *pe = static_cast<PinchGestureEvent *>(event.get());
-            Q_EMIT pe->device()->pinchGestureBegin(pe->fingerCount(), pe->time(), pe->device());
-            break;
-        }
-        case LIBINPUT_EVENT_GESTURE_PINCH_UPDATE: {
-            PinchGestureEvent *pe = static_cast<PinchGestureEvent *>(event.get());
-            Q_EMIT pe->device()->pinchGestureUpdate(pe->scale(), pe->angleDelta(), pe->delta(), pe->time(), pe->device());
-            break;
-        }
-        case LIBINPUT_EVENT_GESTURE_PINCH_END: {
-            PinchGestureEvent *pe = static_cast<PinchGestureEvent *>(event.get());
-            if (pe->isCancelled()) {
-                Q_EMIT pe->device()->pinchGestureCancelled(pe->time(), pe->device());
-            } else {
-                Q_EMIT pe->device()->pinchGestureEnd(pe->time(), pe->device());
-            }
-            break;
-        }
-        case LIBINPUT_EVENT_GESTURE_SWIPE_BEGIN: {
-            SwipeGestureEvent *se = static_cast<SwipeGestureEvent *>(event.get());
-            Q_EMIT se->device()->swipeGestureBegin(se->fingerCount(), se->time(), se->device());
-            break;
-        }
-        case LIBINPUT_EVENT_GESTURE_SWIPE_UPDATE: {
-            SwipeGestureEvent *se = static_cast<SwipeGestureEvent *>(event.get());
-            Q_EMIT se->device()->swipeGestureUpdate(se->delta(), se->time(), se->device());
-            break;
-        }
-        case LIBINPUT_EVENT_GESTURE_SWIPE_END: {
-            SwipeGestureEvent *se = static_cast<SwipeGestureEvent *>(event.get());
-            if (se->isCancelled()) {
-                Q_EMIT se->device()->swipeGestureCancelled(se->time(), se->device());
-            } else {
-                Q_EMIT se->device()->swipeGestureEnd(se->time(), se->device());
-            }
-            break;
-        }
-        case LIBINPUT_EVENT_GESTURE_HOLD_BEGIN: {
-            HoldGestureEvent *he = static_cast<HoldGestureEvent *>(event.get());
-            Q_EMIT he->device()->holdGestureBegin(he->fingerCount(), he->time(), he->device());
-            break;
-        }
-        case LIBINPUT_EVENT_GESTURE_HOLD_END: {
-            HoldGestureEvent *he = static_cast<HoldGestureEvent *>(event.get());
-            if (he->isCancelled()) {
-                Q_EMIT he->device()->holdGestureCancelled(he->time(), he->device());
-            } else {
-                Q_EMIT he->device()->holdGestureEnd(he->time(), he->device());
-            }
-            break;
-        }
-        case LIBINPUT_EVENT_SWITCH_TOGGLE: {
-            SwitchEvent *se = static_cast<SwitchEvent *>(event.get());
-            Q_EMIT se->device()->switchToggle(se->state(), se->time(), se->device());
-            break;
-        }
-        case LIBINPUT_EVENT_TABLET_TOOL_AXIS: {
-            auto *tte = static_cast<TabletToolEvent *>(event.get());
-            if (libinput_tablet_tool_config_pressure_range_is_available(tte->tool())) {
-                tte->device()->setSupportsPressureRange(true);
-                libinput_tablet_tool_config_pressure_range_set(tte->tool(), tte->device()->pressureRangeMin(), tte->device()->pressureRangeMax());
-            }
-
-            if (event->device()->tabletToolIsRelative()) {
-                Q_EMIT event->device()->tabletToolAxisEventRelative(tte->delta(),
-                                                                    tte->device()->pressureCurve().valueForProgress(tte->pressure()),
-                                                                    tte->xTilt(),
-                                                                    tte->yTilt(),
-                                                                    tte->rotation(),
-                                                                    tte->distance(),
-                                                                    tte->isTipDown(),
-                                                                    tte->sliderPosition(),
-                                                                    getOrCreateTool(tte->tool()),
-                                                                    tte->time(),
-                                                                    tte->device());
-            } else {
-                Q_EMIT event->device()->tabletToolAxisEvent(tabletToolPosition(tte),
-                                                            tte->device()->pressureCurve().valueForProgress(tte->pressure()),
-                                                            tte->xTilt(),
-                                                            tte->yTilt(),
-                                                            tte->rotation(),
-                                                            tte->distance(),
-                                                            tte->isTipDown(),
-                                                            tte->sliderPosition(),
-                                                            getOrCreateTool(tte->tool()),
-                                                            tte->time(),
-                                                            tte->device());
-            }
-            break;
-        }
-        case LIBINPUT_EVENT_TABLET_TOOL_PROXIMITY: {
-            auto *tte = static_cast<TabletToolEvent *>(event.get());
-            if (libinput_tablet_tool_config_pressure_range_is_available(tte->tool())) {
-                tte->device()->setSupportsPressureRange(true);
-                libinput_tablet_tool_config_pressure_range_set(tte->tool(), tte->device()->pressureRangeMin(), tte->device()->pressureRangeMax());
-            }
-            Q_EMIT event->device()->tabletToolProximityEvent(tabletToolPosition(tte),
-                                                             tte->xTilt(),
-                                                             tte->yTilt(),
-                                                             tte->rotation(),
-                                                             tte->distance(),
-                                                             tte->isNearby(),
-                                                             tte->sliderPosition(),
-                                                             getOrCreateTool(tte->tool()),
-                                                             tte->time(),
-                                                             tte->device());
-            break;
-        }
-        case LIBINPUT_EVENT_TABLET_TOOL_TIP: {
-            auto *tte = static_cast<TabletToolEvent *>(event.get());
-            if (libinput_tablet_tool_config_pressure_range_is_available(tte->tool())) {
-                tte->device()->setSupportsPressureRange(true);
-                libinput_tablet_tool_config_pressure_range_set(tte->tool(), tte->device()->pressureRangeMin(), tte->device()->pressureRangeMax());
-            }
-            Q_EMIT event->device()->tabletToolTipEvent(tabletToolPosition(tte),
-                                                       tte->device()->pressureCurve().valueForProgress(tte->pressure()),
-                                                       tte->xTilt(),
-                                                       tte->yTilt(),
-                                                       tte->rotation(),
-                                                       tte->distance(),
-                                                       tte->isTipDown(),
-                                                       tte->sliderPosition(),
-                                                       getOrCreateTool(tte->tool()),
-                                                       tte->time(),
-                                                       tte->device());
-            break;
-        }
-        case LIBINPUT_EVENT_TABLET_TOOL_BUTTON: {
-            auto *tabletEvent = static_cast<TabletToolButtonEvent *>(event.get());
-            Q_EMIT event->device()->tabletToolButtonEvent(tabletEvent->buttonId(),
-                                                          tabletEvent->isButtonPressed(),
-                                                          getOrCreateTool(tabletEvent->tool()), tabletEvent->time(), tabletEvent->device());
+    }
+    case LIBINPUT_EVENT_TOUCH_UP: {
+        TouchEvent *te = static_cast<TouchEvent *>(event);
+        const auto *output = te->device()->output();
+        if (!output) {
             break;
         }
-        case LIBINPUT_EVENT_TABLET_PAD_BUTTON: {
-            auto *tabletEvent = static_cast<TabletPadButtonEvent *>(event.get());
-            Q_EMIT event->device()->tabletPadButtonEvent(tabletEvent->buttonId(),
-                                                         tabletEvent->isButtonPressed(),
-                                                         tabletEvent->group(),
-                                                         tabletEvent->mode(),
-                                                         tabletEvent->isModeSwitch(),
-                                                         tabletEvent->time(), tabletEvent->device());
+        Q_EMIT te->device()->touchUp(te->id(), te->time(), te->device());
+        break;
+    }
+    case LIBINPUT_EVENT_TOUCH_MOTION: {
+#ifndef KWIN_BUILD_TESTING
+        TouchEvent *te = static_cast<TouchEvent *>(event);
+        const auto *output = te->device()->output();
+        if (!output) {
             break;
         }
-        case LIBINPUT_EVENT_TABLET_PAD_RING: {
-            auto *tabletEvent = static_cast<TabletPadRingEvent *>(event.get());
-            Q_EMIT event->device()->tabletPadRingEvent(tabletEvent->number(),
-                                                       tabletEvent->position(),
-                                                       tabletEvent->source() == LIBINPUT_TABLET_PAD_RING_SOURCE_FINGER,
-                                                       tabletEvent->group(),
-                                                       tabletEvent->mode(),
-                                                       tabletEvent->time(), tabletEvent->device());
-            break;
+        const QPointF globalPos = devicePointToGlobalPosition(te->absolutePos(output->modeSize()), output);
+        Q_EMIT te->device()->touchMotion(te->id(), globalPos, te->time(), te->device());
+        break;
+#endif
+    }
+    case LIBINPUT_EVENT_TOUCH_CANCEL: {
+        Q_EMIT event->device()->touchCanceled(event->device());
+        break;
+    }
+    case LIBINPUT_EVENT_TOUCH_FRAME: {
+        Q_EMIT event->device()->touchFrame(event->device());
+        break;
+    }
+    case LIBINPUT_EVENT_GESTURE_PINCH_BEGIN: {
+        PinchGestureEvent *pe = static_cast<PinchGestureEvent *>(event);
+        Q_EMIT pe->device()->pinchGestureBegin(pe->fingerCount(), pe->time(), pe->device());
+        break;
+    }
+    case LIBINPUT_EVENT_GESTURE_PINCH_UPDATE: {
+        PinchGestureEvent *pe = static_cast<PinchGestureEvent *>(event);
+        Q_EMIT pe->device()->pinchGestureUpdate(pe->scale(), pe->angleDelta(), pe->delta(), pe->time(), pe->device());
+        break;
+    }
+    case LIBINPUT_EVENT_GESTURE_PINCH_END: {
+        PinchGestureEvent *pe = static_cast<PinchGestureEvent *>(event);
+        if (pe->isCancelled()) {
+            Q_EMIT pe->device()->pinchGestureCancelled(pe->time(), pe->device());
+        } else {
+            Q_EMIT pe->device()->pinchGestureEnd(pe->time(), pe->device());
         }
-        case LIBINPUT_EVENT_TABLET_PAD_STRIP: {
-            auto *tabletEvent = static_cast<TabletPadStripEvent *>(event.get());
-            Q_EMIT event->device()->tabletPadStripEvent(tabletEvent->number(),
-                                                        tabletEvent->position(),
-                                                        tabletEvent->source() == LIBINPUT_TABLET_PAD_STRIP_SOURCE_FINGER,
-                                                        tabletEvent->group(),
-                                                        tabletEvent->mode(),
-                                                        tabletEvent->time(), tabletEvent->device());
-            break;
+        break;
+    }
+    case LIBINPUT_EVENT_GESTURE_SWIPE_BEGIN: {
+        SwipeGestureEvent *se = static_cast<SwipeGestureEvent *>(event);
+        Q_EMIT se->device()->swipeGestureBegin(se->fingerCount(), se->time(), se->device());
+        break;
+    }
+    case LIBINPUT_EVENT_GESTURE_SWIPE_UPDATE: {
+        SwipeGestureEvent *se = static_cast<SwipeGestureEvent *>(event);
+        Q_EMIT se->device()->swipeGestureUpdate(se->delta(), se->time(), se->device());
+        break;
+    }
+    case LIBINPUT_EVENT_GESTURE_SWIPE_END: {
+        SwipeGestureEvent *se = static_cast<SwipeGestureEvent *>(event);
+        if (se->isCancelled()) {
+            Q_EMIT se->device()->swipeGestureCancelled(se->time(), se->device());
+        } else {
+            Q_EMIT se->device()->swipeGestureEnd(se->time(), se->device());
         }
-        case LIBINPUT_EVENT_TABLET_PAD_DIAL: {
-            auto *tabletEvent = static_cast<TabletPadDialEvent *>(event.get());
-            Q_EMIT event->device()->tabletPadDialEvent(tabletEvent->number(), tabletEvent->delta(), tabletEvent->group(), tabletEvent->time(), tabletEvent->device());
-            break;
+        break;
+    }
+    case LIBINPUT_EVENT_GESTURE_HOLD_BEGIN: {
+        HoldGestureEvent *he = static_cast<HoldGestureEvent *>(event);
+        Q_EMIT he->device()->holdGestureBegin(he->fingerCount(), he->time(), he->device());
+        break;
+    }
+    case LIBINPUT_EVENT_GESTURE_HOLD_END: {
+        HoldGestureEvent *he = static_cast<HoldGestureEvent *>(event);
+        if (he->isCancelled()) {
+            Q_EMIT he->device()->holdGestureCancelled(he->time(), he->device());
+        } else {
+            Q_EMIT he->device()->holdGestureEnd(he->time(), he->device());
         }
-        default:
-            // nothing
-            break;
+        break;
+    }
+    case LIBINPUT_EVENT_SWITCH_TOGGLE: {
+        SwitchEvent *se = static_cast<SwitchEvent *>(event);
+        Q_EMIT se->device()->switchToggle(se->state(), se->time(), se->device());
+        break;
+    }
+    case LIBINPUT_EVENT_TABLET_TOOL_AXIS: {
+        auto *tte = static_cast<TabletToolEvent *>(event);
+        if (libinput_tablet_tool_config_pressure_range_is_available(tte->tool())) {
+            tte->device()->setSupportsPressureRange(true);
+            libinput_tablet_tool_config_pressure_range_set(tte->tool(), tte->device()->pressureRangeMin(), tte->device()->pressureRangeMax());
+        }
+
+        if (event->device()->tabletToolIsRelative()) {
+            Q_EMIT event->device()->tabletToolAxisEventRelative(tte->delta(),
+                                                                tte->device()->pressureCurve().valueForProgress(tte->pressure()),
+                                                                tte->xTilt(),
+                                                                tte->yTilt(),
+                                                                tte->rotation(),
+                                                                tte->distance(),
+                                                                tte->isTipDown(),
+                                                                tte->sliderPosition(),
+                                                                getOrCreateTool(tte->tool()),
+                                                                tte->time(),
+                                                                tte->device());
+        } else {
+            Q_EMIT event->device()->tabletToolAxisEvent(tabletToolPosition(tte),
+                                                        tte->device()->pressureCurve().valueForProgress(tte->pressure()),
+                                                        tte->xTilt(),
+                                                        tte->yTilt(),
+                                                        tte->rotation(),
+                                                        tte->distance(),
+                                                        tte->isTipDown(),
+                                                        tte->sliderPosition(),
+                                                        getOrCreateTool(tte->tool()),
+                                                        tte->time(),
+                                                        tte->device());
         }
+        break;
+    }
+    case LIBINPUT_EVENT_TABLET_TOOL_PROXIMITY: {
+        auto *tte = static_cast<TabletToolEvent *>(event);
+        if (libinput_tablet_tool_config_pressure_range_is_available(tte->tool())) {
+            tte->device()->setSupportsPressureRange(true);
+            libinput_tablet_tool_config_pressure_range_set(tte->tool(), tte->device()->pressureRangeMin(), tte->device()->pressureRangeMax());
+        }
+        Q_EMIT event->device()->tabletToolProximityEvent(tabletToolPosition(tte),
+                                                         tte->xTilt(),
+                                                         tte->yTilt(),
+                                                         tte->rotation(),
+                                                         tte->distance(),
+                                                         tte->isNearby(),
+                                                         tte->sliderPosition(),
+                                                         getOrCreateTool(tte->tool()),
+                                                         tte->time(),
+                                                         tte->device());
+        break;
+    }
+    case LIBINPUT_EVENT_TABLET_TOOL_TIP: {
+        auto *tte = static_cast<TabletToolEvent *>(event);
+        if (libinput_tablet_tool_config_pressure_range_is_available(tte->tool())) {
+            tte->device()->setSupportsPressureRange(true);
+            libinput_tablet_tool_config_pressure_range_set(tte->tool(), tte->device()->pressureRangeMin(), tte->device()->pressureRangeMax());
+        }
+        Q_EMIT event->device()->tabletToolTipEvent(tabletToolPosition(tte),
+                                                   tte->device()->pressureCurve().valueForProgress(tte->pressure()),
+                                                   tte->xTilt(),
+                                                   tte->yTilt(),
+                                                   tte->rotation(),
+                                                   tte->distance(),
+                                                   tte->isTipDown(),
+                                                   tte->sliderPosition(),
+                                                   getOrCreateTool(tte->tool()),
+                                                   tte->time(),
+                                                   tte->device());
+        break;
+    }
+    case LIBINPUT_EVENT_TABLET_TOOL_BUTTON: {
+        auto *tabletEvent = static_cast<TabletToolButtonEvent *>(event);
+        Q_EMIT event->device()->tabletToolButtonEvent(tabletEvent->buttonId(),
+                                                      tabletEvent->isButtonPressed(),
+                                                      getOrCreateTool(tabletEvent->tool()), tabletEvent->time(), tabletEvent->device());
+        break;
+    }
+    case LIBINPUT_EVENT_TABLET_PAD_BUTTON: {
+        auto *tabletEvent = static_cast<TabletPadButtonEvent *>(event);
+        Q_EMIT event->device()->tabletPadButtonEvent(tabletEvent->buttonId(),
+                                                     tabletEvent->isButtonPressed(),
+                                                     tabletEvent->group(),
+                                                     tabletEvent->mode(),
+                                                     tabletEvent->isModeSwitch(),
+                                                     tabletEvent->time(), tabletEvent->device());
+        break;
+    }
+    case LIBINPUT_EVENT_TABLET_PAD_RING: {
+        auto *tabletEvent = static_cast<TabletPadRingEvent *>(event);
+        Q_EMIT event->device()->tabletPadRingEvent(tabletEvent->number(),
+                                                   tabletEvent->position(),
+                                                   tabletEvent->source() == LIBINPUT_TABLET_PAD_RING_SOURCE_FINGER,
+                                                   tabletEvent->group(),
+                                                   tabletEvent->mode(),
+                                                   tabletEvent->time(), tabletEvent->device());
+        break;
+    }
+    case LIBINPUT_EVENT_TABLET_PAD_STRIP: {
+        auto *tabletEvent = static_cast<TabletPadStripEvent *>(event);
+        Q_EMIT event->device()->tabletPadStripEvent(tabletEvent->number(),
+                                                    tabletEvent->position(),
+                                                    tabletEvent->source() == LIBINPUT_TABLET_PAD_STRIP_SOURCE_FINGER,
+                                                    tabletEvent->group(),
+                                                    tabletEvent->mode(),
+                                                    tabletEvent->time(), tabletEvent->device());
+        break;
+    }
+    case LIBINPUT_EVENT_TABLET_PAD_DIAL: {
+        auto *tabletEvent = static_cast<TabletPadDialEvent *>(event);
+        Q_EMIT event->device()->tabletPadDialEvent(tabletEvent->number(), tabletEvent->delta(), tabletEvent->group(), tabletEvent->time(), tabletEvent->device());
+        break;
+    }
+    default:
+        // nothing
+        break;
     }
 }
 
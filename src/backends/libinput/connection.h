@@ -77,6 +77,7 @@ private Q_SLOTS:
 private:
     Connection(std::unique_ptr<Context> &&input);
     void handleEvent();
+    void processEvent(Event *event);
     void applyDeviceConfig(Device *device);
     void applyScreenToDevice(Device *device);
     void doSetup();
@@ -133,7 +133,12 @@ std::chrono::microseconds KeyEvent::time() const
 PointerEvent::PointerEvent(libinput_event *event, libinput_event_type type)
     : Event(event, type)
     , m_pointerEvent(libinput_event_get_pointer_event(event))
+    , m_time(libinput_event_pointer_get_time_usec(m_pointerEvent))
 {
+    if (type == LIBINPUT_EVENT_POINTER_MOTION) {
+        m_delta = QPointF(libinput_event_pointer_get_dx(m_pointerEvent), libinput_event_pointer_get_dy(m_pointerEvent));
+        m_deltaUnaccelerated = QPointF(libinput_event_pointer_get_dx_unaccelerated(m_pointerEvent), libinput_event_pointer_get_dy_unaccelerated(m_pointerEvent));
+    }
 }
 
 PointerEvent::~PointerEvent() = default;
@@ -155,18 +160,26 @@ QPointF PointerEvent::absolutePos(const QSize &size) const
 QPointF PointerEvent::delta() const
 {
     Q_ASSERT(type() == LIBINPUT_EVENT_POINTER_MOTION);
-    return QPointF(libinput_event_pointer_get_dx(m_pointerEvent), libinput_event_pointer_get_dy(m_pointerEvent));
+    return m_delta;
 }
 
 QPointF PointerEvent::deltaUnaccelerated() const
 {
     Q_ASSERT(type() == LIBINPUT_EVENT_POINTER_MOTION);
-    return QPointF(libinput_event_pointer_get_dx_unaccelerated(m_pointerEvent), libinput_event_pointer_get_dy_unaccelerated(m_pointerEvent));
+    return m_deltaUnaccelerated;
+}
+
+void PointerEvent::accumulateMotion(const PointerEvent &other)
+{
+    Q_ASSERT(type() == LIBINPUT_EVENT_POINTER_MOTION && other.type() == LIBINPUT_EVENT_POINTER_MOTION);
+    m_delta += other.m_delta;
+    m_deltaUnaccelerated += other.m_deltaUnaccelerated;
+    m_time = other.m_time;
 }
 
 std::chrono::microseconds PointerEvent::time() const
 {
-    return std::chrono::microseconds(libinput_event_pointer_get_time_usec(m_pointerEvent));
+    return m_time;
 }
 
 uint32_t PointerEvent::button() const
@@ -81,6 +81,10 @@ public:
     QPointF absolutePos(const QSize &size) const;
     QPointF delta() const;
     QPointF deltaUnaccelerated() const;
+    /**
+     * Adds the motion of the later motion event @p other to this one.
+     */
+    void accumulateMotion(const PointerEvent &other);
     uint32_t button() const;
     PointerButtonState buttonState() const;
     std::chrono::microseconds time() const;
@@ -99,6 +103,9 @@ public:
 
 private:
     libinput_event_pointer *m_pointerEvent;
+    QPointF m_delta;
+    QPointF m_deltaUnaccelerated;
+    std::chrono::microseconds m_time;
 };
 
 class TouchEvent : public Event
@@ -33,7 +33,7 @@ VirtualOutput::VirtualOutput(VirtualBackend *parent, bool internal, const QSize
         .name = connectorName.value_or(QStringLiteral("Virtual-%1").arg(identifier)),
         .physicalSize = physicalSizeInMM,
         .edid = Edid{edid, edidIdentifierOverride},
-        .capabilities = Capability::CustomModes,
+        .capabilities = Capability::Dpms | Capability::CustomModes,
         .panelOrientation = panelOrientation,
         .internal = internal,
         .mstPath = mstPath.value_or(QByteArray()),
@@ -122,6 +122,14 @@ void VirtualOutput::applyChanges(const OutputConfiguration &config)
         next.modes = newModes;
     }
     next.dpmsMode = props->dpmsMode.value_or(next.dpmsMode);
+    if (next.dpmsMode != m_state.dpmsMode) {
+        // nobody can look at an output that is turned off, so don't render anything for it
+        if (next.dpmsMode == DpmsMode::On) {
+            m_renderLoop->uninhibit();
+        } else {
+            m_renderLoop->inhibit();
+        }
+    }
     next.uuid = props->uuid.value_or(next.uuid);
 
     setState(next);
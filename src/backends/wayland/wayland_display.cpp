@@ -340,6 +340,11 @@ wp_presentation *WaylandDisplay::presentationTime() const
     return m_presentationTime;
 }
 
+clockid_t WaylandDisplay::presentationClock() const
+{
+    return m_presentationClock;
+}
+
 wp_tearing_control_manager_v1 *WaylandDisplay::tearingControl() const
 {
     return m_tearingControl;
@@ -413,6 +418,12 @@ void WaylandDisplay::registry_global(void *data, wl_registry *registry, uint32_t
         display->m_linuxDmabuf = std::make_unique<WaylandClient::LinuxDmabufV1>(registry, name, std::min(version, 4u));
     } else if (strcmp(interface, wp_presentation_interface.name) == 0) {
         display->m_presentationTime = reinterpret_cast<wp_presentation *>(wl_registry_bind(registry, name, &wp_presentation_interface, std::min(version, 2u)));
+        static const wp_presentation_listener listener{
+            .clock_id = [](void *data, wp_presentation *, uint32_t clock) {
+                static_cast<WaylandDisplay *>(data)->m_presentationClock = clockid_t(clock);
+            },
+        };
+        wp_presentation_add_listener(display->m_presentationTime, &listener, display);
     } else if (strcmp(interface, wp_tearing_control_manager_v1_interface.name) == 0) {
         display->m_tearingControl = reinterpret_cast<wp_tearing_control_manager_v1 *>(wl_registry_bind(registry, name, &wp_tearing_control_manager_v1_interface, 1));
     } else if (strcmp(interface, wp_color_manager_v1_interface.name) == 0) {
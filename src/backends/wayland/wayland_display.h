@@ -11,6 +11,8 @@
 
 #include <memory>
 
+#include <time.h>
+
 struct wl_display;
 struct wl_registry;
 struct wl_shm;
@@ -74,6 +76,10 @@ public:
     KWayland::Client::XdgShell *xdgShell() const;
     WaylandClient::LinuxDmabufV1 *linuxDmabuf() const;
     wp_presentation *presentationTime() const;
+    /**
+     * The clock that the host compositor uses for presentation timestamps.
+     */
+    clockid_t presentationClock() const;
     wp_tearing_control_manager_v1 *tearingControl() const;
     ColorManager *colorManager() const;
     wp_fractional_scale_manager_v1 *fractionalScale() const;
@@ -93,6 +99,7 @@ private:
     wl_registry *m_registry = nullptr;
     wl_shm *m_shm = nullptr;
     wp_presentation *m_presentationTime = nullptr;
+    clockid_t m_presentationClock = CLOCK_MONOTONIC;
     wp_tearing_control_manager_v1 *m_tearingControl = nullptr;
     wp_fractional_scale_manager_v1 *m_fractionalScaleV1 = nullptr;
     std::unique_ptr<WaylandClient::Viewporter> m_viewporter;
@@ -210,7 +210,23 @@ void WaylandOutput::updateColor()
 static void handleDiscarded(void *data,
                             struct wp_presentation_feedback *wp_presentation_feedback)
 {
-    reinterpret_cast<WaylandOutput *>(data)->frameDiscarded();
+    reinterpret_cast<WaylandOutput *>(data)->frameDiscarded(wp_presentation_feedback);
+}
+
+static std::chrono::nanoseconds convertToMonotonic(clockid_t sourceClock, std::chrono::nanoseconds timestamp)
+{
+    if (sourceClock == CLOCK_MONOTONIC) {
+        return timestamp;
+    }
+    timespec sourceNow;
+    timespec monotonicNow;
+    if (clock_gettime(sourceClock, &sourceNow) != 0 || clock_gettime(CLOCK_MONOTONIC, &monotonicNow) != 0) {
+        return timestamp;
+    }
+    const auto toNanoseconds = [](const timespec &time) {
+        return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+    };
+    return timestamp - toNanoseconds(sourceNow) + toNanoseconds(monotonicNow);
 }
 
 static void handlePresented(void *data,
@@ -223,12 +239,17 @@ static void handlePresented(void *data,
                             uint32_t seq_lo,
                             uint32_t flags)
 {
+    auto output = reinterpret_cast<WaylandOutput *>(data);
     const auto timestamp = std::chrono::seconds((uint64_t(tv_sec_hi) << 32) | tv_sec_lo) + std::chrono::nanoseconds(tv_nsec);
-    uint32_t refreshRate = 60'000;
+    // the render loop and the frame callback times are in CLOCK_MONOTONIC, the host may use another clock
+    const auto monotonicTimestamp = convertToMonotonic(output->backend()->display()->presentationClock(), timestamp);
+    // a refresh of zero means that the host doesn't have a fixed refresh rate, e.g. with VRR
+    std::optional<uint32_t> refreshRate;
     if (refresh != 0) {
         refreshRate = 1'000'000'000'000 / refresh;
     }
-    reinterpret_cast<WaylandOutput *>(data)->framePresented(timestamp, refreshRate);
+    const PresentationMode mode = (flags & WP_PRESENTATION_FEEDBACK_KIND_VSYNC) ? PresentationMode::VSync : PresentationMode::Async;
+    output->framePresented(wp_presentation_feedback, monotonicTimestamp, refreshRate, mode);
 }
 
 static void handleSyncOutput(void *data, struct wp_presentation_feedback *, struct wl_output *)
@@ -336,15 +357,23 @@ bool WaylandOutput::present(const QList<OutputLayer *> &layersToUpdate, const st
     return true;
 }
 
-void WaylandOutput::frameDiscarded()
+void WaylandOutput::frameDiscarded(wp_presentation_feedback *feedback)
 {
-    m_frames.pop_front();
+    // the host can present or discard frames out of order, e.g. if a newer commit replaces an older one
+    const auto it = std::ranges::find(m_frames, feedback, &FrameData::presentationFeedback);
+    if (it != m_frames.end()) {
+        m_frames.erase(it);
+    }
 }
 
-void WaylandOutput::framePresented(std::chrono::nanoseconds timestamp, uint32_t refreshRate)
+void WaylandOutput::framePresented(wp_presentation_feedback *feedback, std::chrono::nanoseconds timestamp, std::optional<uint32_t> refreshRate, PresentationMode presentationMode)
 {
-    if (refreshRate != this->refreshRate()) {
-        m_refreshRate = refreshRate;
+    const auto it = std::ranges::find(m_frames, feedback, &FrameData::presentationFeedback);
+    if (it == m_frames.end()) {
+        return;
+    }
+    if (refreshRate && *refreshRate != this->refreshRate()) {
+        m_refreshRate = *refreshRate;
         const auto mode = std::make_shared<OutputMode>(pixelSize(), m_refreshRate);
         State next = m_state;
         next.modes = {mode};
@@ -352,8 +381,7 @@ void WaylandOutput::framePresented(std::chrono::nanoseconds timestamp, uint32_t
         setState(next);
         m_renderLoop->setRefreshRate(m_refreshRate);
     }
-    const auto &frame = m_frames.front();
-    if (auto t = frame.frameCallbackTime) {
+    if (auto t = it->frameCallbackTime) {
         // NOTE that the frame callback gets signaled *after* the host compositor
         // is done compositing the frame on the CPU side, not before!
         // This is the best estimate we currently have for the commit deadline, but
@@ -361,8 +389,8 @@ void WaylandOutput::framePresented(std::chrono::nanoseconds timestamp, uint32_t
         const auto difference = timestamp - t->time_since_epoch();
         m_renderLoop->setPresentationSafetyMargin(difference + std::chrono::milliseconds(1));
     }
-    frame.outputFrame->presented(timestamp, PresentationMode::VSync);
-    m_frames.pop_front();
+    it->outputFrame->presented(timestamp, presentationMode);
+    m_frames.erase(it);
 }
 
 void WaylandOutput::applyChanges(const OutputConfiguration &config)
@@ -96,8 +96,8 @@ public:
     bool testPresentation(const std::shared_ptr<OutputFrame> &frame) override;
     bool present(const QList<OutputLayer *> &layersToUpdate, const std::shared_ptr<OutputFrame> &frame) override;
 
-    void frameDiscarded();
-    void framePresented(std::chrono::nanoseconds timestamp, uint32_t refreshRate);
+    void frameDiscarded(wp_presentation_feedback *feedback);
+    void framePresented(wp_presentation_feedback *feedback, std::chrono::nanoseconds timestamp, std::optional<uint32_t> refreshRate, PresentationMode presentationMode);
 
     void applyChanges(const OutputConfiguration &config) override;
 
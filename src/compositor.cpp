@@ -49,6 +49,7 @@
 #endif
 
 #include <QQuickWindow>
+#include <expected>
 #include <optional>
 #include <ranges>
 
@@ -86,7 +87,10 @@ Compositor::Compositor(QObject *workspace)
         }
     });
 
-    FTraceLogger::create();
+    // the startup profiler might have created the logger already
+    if (!FTraceLogger::self()) {
+        FTraceLogger::create();
+    }
 }
 
 Compositor::~Compositor()
@@ -356,50 +360,60 @@ static Rect mapItemToOutputDeviceCoordinates(Item *item, RenderView *view, Logic
     return backendOutput->transform().map(scaledItemRect.translated(backendOutput->deviceOffset() - scaledOutputPos), backendOutput->pixelSize());
 }
 
-static bool prepareDirectScanout(RenderView *view, LogicalOutput *logicalOutput, BackendOutput *backendOutput, const std::shared_ptr<OutputFrame> &frame)
+static std::expected<SurfaceItem *, Compositor::ScanoutFailure> findScanoutCandidate(RenderView *view, const std::shared_ptr<OutputFrame> &frame)
 {
+    const auto layer = view->layer();
     if (!view->isVisible()) {
-        return false;
+        layer->setScanoutCandidate(nullptr);
+        return std::unexpected(Compositor::ScanoutFailure::NotVisible);
     }
-    const auto layer = view->layer();
     const auto scanoutCandidates = view->scanoutCandidates(1);
     if (scanoutCandidates.isEmpty()) {
         layer->setScanoutCandidate(nullptr);
-        return false;
+        return std::unexpected(Compositor::ScanoutFailure::NoCandidate);
     }
     SurfaceItem *candidate = scanoutCandidates.front();
+    // this also takes the scanout feedback away from the previous candidate,
+    // so that it doesn't keep allocating for a plane it won't end up on
+    layer->setScanoutCandidate(candidate);
     SurfaceItemWayland *wayland = qobject_cast<SurfaceItemWayland *>(candidate);
-    if (!wayland || !wayland->surface()) {
-        return false;
-    }
-    const auto buffer = wayland->surface()->buffer();
-    if (!buffer) {
-        return false;
+    if (!wayland || !wayland->surface() || !wayland->surface()->buffer()) {
+        return std::unexpected(Compositor::ScanoutFailure::NoBuffer);
     }
-    const auto attrs = buffer->dmabufAttributes();
+    const auto attrs = wayland->surface()->buffer()->dmabufAttributes();
     if (!attrs) {
-        return false;
+        return std::unexpected(Compositor::ScanoutFailure::NotDmabuf);
     }
     const bool tearing = frame->presentationMode() == PresentationMode::Async || frame->presentationMode() == PresentationMode::AdaptiveAsync;
     const auto formats = tearing ? layer->supportedAsyncDrmFormats() : layer->supportedDrmFormats();
     if (auto it = formats.find(attrs->format); it == formats.end() || !it->contains(attrs->modifier)) {
-        layer->setScanoutCandidate(candidate);
         candidate->setScanoutHint(layer->scanoutDevice(), formats);
-        return false;
+        return std::unexpected(Compositor::ScanoutFailure::UnsupportedFormat);
     }
+    return candidate;
+}
+
+static std::expected<void, Compositor::ScanoutFailure> prepareDirectScanout(RenderView *view, LogicalOutput *logicalOutput, BackendOutput *backendOutput, const std::shared_ptr<OutputFrame> &frame)
+{
+    const auto found = findScanoutCandidate(view, frame);
+    if (!found) {
+        return std::unexpected(found.error());
+    }
+    SurfaceItem *candidate = *found;
+    const auto layer = view->layer();
     layer->setTargetRect(mapItemToOutputDeviceCoordinates(candidate, view, logicalOutput, backendOutput));
     layer->setEnabled(true);
     layer->setSourceRect(candidate->bufferSourceBox());
     layer->setBufferTransform(candidate->bufferTransform());
     layer->setOffloadTransform(candidate->bufferTransform().combine(backendOutput->transform().inverted()));
     layer->setColor(candidate->colorDescription(), candidate->renderingIntent(), ColorPipeline::create(candidate->colorDescription(), backendOutput->layerBlendingColor(), candidate->renderingIntent()));
-    const bool ret = layer->importScanoutBuffer(candidate->buffer(), frame);
-    if (ret) {
-        candidate->resetDamage();
-        // ensure the pixmap is updated when direct scanout ends
-        candidate->destroyTexture();
+    if (!layer->importScanoutBuffer(candidate->buffer(), frame)) {
+        return std::unexpected(Compositor::ScanoutFailure::ImportFailed);
     }
-    return ret;
+    candidate->resetDamage();
+    // ensure the pixmap is updated when direct scanout ends
+    candidate->destroyTexture();
+    return {};
 }
 
 static bool prepareRendering(RenderView *view, LogicalOutput *logicalOutput, BackendOutput *backendOutput, uint32_t requiredAlphaBits)
@@ -431,18 +445,79 @@ static bool prepareRendering(RenderView *view, LogicalOutput *logicalOutput, Bac
     return layer->preparePresentationTest();
 }
 
-static bool renderLayer(RenderView *view, LogicalOutput *logicalOutput, BackendOutput *backendOutput, const std::shared_ptr<OutputFrame> &frame, const Region &surfaceDamage)
+// the damage is scissored rect by rect, with fractional scaling it can easily be made of
+// hundreds of small rects, so merge them into a few bigger ones
+static constexpr int s_maxDamageRects = 16;
+
+static bool renderLayer(RenderView *view, LogicalOutput *logicalOutput, BackendOutput *backendOutput, const std::shared_ptr<OutputFrame> &frame, const Region &damage)
 {
     auto beginInfo = view->layer()->beginFrame();
     if (!beginInfo) {
         return false;
     }
     auto &[renderTarget, repaint] = beginInfo.value();
-    const Region bufferDamage = surfaceDamage.united(repaint).intersected(renderTarget.transformedRect());
+    const Region surfaceDamage = damage.simplified(s_maxDamageRects);
+    const Region bufferDamage = surfaceDamage.united(repaint).intersected(renderTarget.transformedRect()).simplified(s_maxDamageRects);
+    fTraceDuration("Render layer (", backendOutput->name(), ")");
     view->paint(renderTarget, view->renderOffset(), bufferDamage);
     return view->layer()->endFrame(bufferDamage, surfaceDamage, frame.get());
 }
 
+// how long an item is kept off overlay planes after the driver rejected it
+static constexpr std::chrono::seconds s_rejectedOverlayTimeout{2};
+
+// after direct scanout on the primary layer ended or failed, the candidate has to stay eligible
+// for this many frames before it's tried again. The wait doubles every time scanout breaks
+// down again soon after, and is reset once scanout has been stable for a while
+static constexpr int s_minScanoutHoldoff = 4;
+static constexpr int s_maxScanoutHoldoff = 128;
+static constexpr int s_stableScanoutFrames = 300;
+
+static std::expected<void, Compositor::ScanoutFailure> holdOffDirectScanout(Compositor::ScanoutState &state, RenderView *view, const std::shared_ptr<OutputFrame> &frame)
+{
+    const auto candidate = findScanoutCandidate(view, frame);
+    if (!candidate) {
+        // a popup or similar is still covering the candidate, start over
+        state.holdoffFrames = state.penalty;
+        return std::unexpected(candidate.error());
+    }
+    state.holdoffFrames--;
+    return std::unexpected(Compositor::ScanoutFailure::HeldOff);
+}
+
+static void updateScanoutState(Compositor::ScanoutState &state, bool active, std::optional<Compositor::ScanoutFailure> failure)
+{
+    if (active) {
+        state.scanoutFrames++;
+        if (++state.stableFrames >= s_stableScanoutFrames) {
+            state.penalty = 0;
+        }
+    } else {
+        state.compositedFrames++;
+        const bool attempted = failure == Compositor::ScanoutFailure::ImportFailed
+            || failure == Compositor::ScanoutFailure::TestFailed
+            || failure == Compositor::ScanoutFailure::PresentFailed;
+        if (state.active || attempted) {
+            state.penalty = std::clamp(state.penalty * 2, s_minScanoutHoldoff, s_maxScanoutHoldoff);
+            state.holdoffFrames = state.penalty;
+        }
+        state.stableFrames = 0;
+        if (failure && failure != Compositor::ScanoutFailure::HeldOff) {
+            state.lastFailure = failure;
+        }
+    }
+    if (state.active != active) {
+        state.switches++;
+    }
+    state.active = active;
+}
+
+static bool presentFrame(BackendOutput *backendOutput, const QList<OutputLayer *> &layers, const std::shared_ptr<OutputFrame> &frame)
+{
+    fTraceDuration("Present (", backendOutput->name(), ")");
+    return backendOutput->present(layers, frame);
+}
+
 static OutputLayer *findLayer(std::span<OutputLayer *const> layers, OutputLayerType type, std::optional<int> minZPos)
 {
     const auto it = std::ranges::find_if(layers, [type, minZPos](OutputLayer *layer) {
@@ -656,6 +731,7 @@ void Compositor::composite(RenderLoop *renderLoop)
     struct LayerData
     {
         RenderView *view;
+        Item *item = nullptr;
         bool directScanout = false;
         bool directScanoutOnly = false;
         bool highPriority = false;
@@ -664,7 +740,11 @@ void Compositor::composite(RenderLoop *renderLoop)
     };
     QList<LayerData> layers;
 
-    primaryView->prePaint();
+    {
+        fTraceDuration("PrePaint (", output->name(), ")");
+        primaryView->prePaint();
+    }
+    renderLoop->setFullScreenEffectActive(effects && effects->hasActiveFullScreenEffect());
     layers.push_back(LayerData{
         .view = primaryView,
         .directScanout = false,
@@ -710,7 +790,20 @@ void Compositor::composite(RenderLoop *renderLoop)
         return layer->minZpos() < primaryView->layer()->zpos();
     });
     const auto [overlayCandidates, underlayCandidates] = scene->overlayCandidates(specialLayers.size(), maxOverlayCount, maxUnderlayCount);
-    auto overlayAssignments = assignOverlays(primaryView, underlayCandidates, overlayCandidates, specialLayers);
+    auto &rejectedOverlays = m_rejectedOverlays[renderLoop];
+    const auto now = std::chrono::steady_clock::now();
+    rejectedOverlays.removeIf([now](const RejectedOverlay &rejected) {
+        return !rejected.item || rejected.expiry < now;
+    });
+    const auto isRejected = [&rejectedOverlays](Item *item) {
+        return std::ranges::any_of(rejectedOverlays, [item](const RejectedOverlay &rejected) {
+            return rejected.item == item;
+        });
+    };
+    std::unordered_map<Item *, OutputLayer *> overlayAssignments;
+    if (!std::ranges::any_of(overlayCandidates, isRejected) && !std::ranges::any_of(underlayCandidates, isRejected)) {
+        overlayAssignments = assignOverlays(primaryView, underlayCandidates, overlayCandidates, specialLayers);
+    }
     if (overlayAssignments.empty()) {
         // the cursor is important, so try again without other over/underlays
         const auto cursorOnly = overlayCandidates | std::views::filter([](Item *item) {
@@ -737,7 +830,7 @@ void Compositor::composite(RenderLoop *renderLoop)
                         return;
                     }
                     std::optional<std::chrono::nanoseconds> maxVrrCursorDelay;
-                    if (output->renderLoop()->activeWindowControlsVrrRefreshRate()) {
+                    if (output->renderLoop()->vrrRefreshRateController()) {
                         const auto effectiveMinRate = output->minVrrRefreshRateHz().transform([](uint32_t value) {
                             // this is intentionally using a tiny bit higher refresh rate than the minimum
                             // so that slight differences in timing don't drop us below the minimum
@@ -760,6 +853,7 @@ void Compositor::composite(RenderLoop *renderLoop)
         view->prePaint();
         layers.push_back(LayerData{
             .view = view.get(),
+            .item = item,
             .directScanout = !isCursor,
             .directScanoutOnly = !isCursor,
             .highPriority = isCursor,
@@ -784,14 +878,26 @@ void Compositor::composite(RenderLoop *renderLoop)
     // disable entirely unused output layers
     for (OutputLayer *layer : unusedOutputLayers) {
         m_overlayViews[renderLoop].erase(layer);
+        layer->setScanoutCandidate(nullptr);
         layer->setEnabled(false);
         // TODO only add the layer to `toUpdate` when necessary
         toUpdate.push_back(layer);
     }
 
     // update all of them for the ideal configuration
+    auto &scanoutState = m_scanoutStates[renderLoop];
+    std::optional<ScanoutFailure> scanoutFailure;
     for (auto &layer : layers) {
-        if (prepareDirectScanout(layer.view, logicalOutput, output, frame)) {
+        std::expected<void, ScanoutFailure> scanout;
+        if (&layer == &layers.front()) {
+            scanout = scanoutState.holdoffFrames > 0 ? holdOffDirectScanout(scanoutState, layer.view, frame) : prepareDirectScanout(layer.view, logicalOutput, output, frame);
+            if (!scanout) {
+                scanoutFailure = scanout.error();
+            }
+        } else {
+            scanout = prepareDirectScanout(layer.view, logicalOutput, output, frame);
+        }
+        if (scanout) {
             layer.directScanout = true;
         } else if (!layer.directScanoutOnly && prepareRendering(layer.view, logicalOutput, output, layer.requiredAlphaBits)) {
             layer.directScanout = false;
@@ -807,6 +913,7 @@ void Compositor::composite(RenderLoop *renderLoop)
         bool primaryFailure = false;
         auto &primary = layers.front();
         if (primary.directScanout) {
+            scanoutFailure = ScanoutFailure::TestFailed;
             if (prepareRendering(primary.view, logicalOutput, output, primary.requiredAlphaBits)) {
                 primary.directScanout = false;
                 result = output->testPresentation(frame);
@@ -817,25 +924,35 @@ void Compositor::composite(RenderLoop *renderLoop)
             }
         }
         if (!result && !primaryFailure) {
-            // disable all low priority layers, and if that isn't enough
-            // the high priority layers as well
-            for (bool priority : {false, true}) {
-                auto toDisable = layers | std::views::filter([priority](const LayerData &layer) {
-                    return layer.view->layer()->isEnabled()
-                        && layer.highPriority == priority
-                        && layer.view->layer()->type() != OutputLayerType::Primary;
+            // disable the low priority layers one by one, and if that isn't enough
+            // all the high priority layers as well
+            for (auto &layer : layers | std::views::reverse) {
+                if (layer.highPriority || !layer.view->layer()->isEnabled() || layer.view->layer()->type() == OutputLayerType::Primary) {
+                    continue;
+                }
+                layer.view->layer()->setEnabled(false);
+                layer.view->layer()->scheduleRepaint(nullptr);
+                rejectedOverlays.push_back(RejectedOverlay{
+                    .item = layer.item,
+                    .expiry = now + s_rejectedOverlayTimeout,
                 });
-                if (!toDisable.empty()) {
-                    for (const auto &layer : toDisable) {
-                        layer.view->layer()->setEnabled(false);
-                        layer.view->layer()->scheduleRepaint(nullptr);
-                    }
-                    result = output->testPresentation(frame);
-                    if (result) {
-                        break;
-                    }
+                result = output->testPresentation(frame);
+                if (result) {
+                    break;
                 }
             }
+            auto toDisable = layers | std::views::filter([](const LayerData &layer) {
+                return layer.view->layer()->isEnabled()
+                    && layer.highPriority
+                    && layer.view->layer()->type() != OutputLayerType::Primary;
+            });
+            if (!result && !toDisable.empty()) {
+                for (const auto &layer : toDisable) {
+                    layer.view->layer()->setEnabled(false);
+                    layer.view->layer()->scheduleRepaint(nullptr);
+                }
+                result = output->testPresentation(frame);
+            }
         }
     }
 
@@ -874,7 +991,7 @@ void Compositor::composite(RenderLoop *renderLoop)
     // but the drm backend, where that's necessary, tracks that time itself
     totalTimeQuery->end();
     frame->addRenderTimeQuery(std::move(totalTimeQuery));
-    if (result && !output->present(toUpdate, frame)) {
+    if (result && !presentFrame(output, toUpdate, frame)) {
         // legacy modesetting can't do (useful) presentation tests
         // and even with atomic modesetting, drivers are buggy and atomic tests
         // sometimes have false positives
@@ -887,14 +1004,22 @@ void Compositor::composite(RenderLoop *renderLoop)
         });
         auto &primary = layers.front();
         if (primary.directScanout || !toDisable.empty()) {
+            if (primary.directScanout) {
+                primary.directScanout = false;
+                scanoutFailure = ScanoutFailure::PresentFailed;
+            }
             for (const auto &layer : toDisable) {
                 layer.view->layer()->setEnabled(false);
                 layer.view->setExclusive(false);
+                rejectedOverlays.push_back(RejectedOverlay{
+                    .item = layer.item,
+                    .expiry = now + s_rejectedOverlayTimeout,
+                });
             }
             // re-render without direct scanout
             if (prepareRendering(primary.view, logicalOutput, output, primary.requiredAlphaBits)
                 && renderLayer(primary.view, logicalOutput, output, frame, primary.surfaceDamage)) {
-                result = output->present(toUpdate, frame);
+                result = presentFrame(output, toUpdate, frame);
             } else {
                 qCWarning(KWIN_CORE, "Rendering the primary layer failed!");
             }
@@ -907,7 +1032,7 @@ void Compositor::composite(RenderLoop *renderLoop)
             layers[1].view->setExclusive(false);
             if (prepareRendering(primary.view, logicalOutput, output, primary.requiredAlphaBits)
                 && renderLayer(primary.view, logicalOutput, output, frame, Region::infinite())) {
-                result = output->present(toUpdate, frame);
+                result = presentFrame(output, toUpdate, frame);
                 if (result) {
                     // disabling the cursor layer helped... so disable it permanently,
                     // to prevent constantly attempting to render the hardware cursor again
@@ -922,6 +1047,9 @@ void Compositor::composite(RenderLoop *renderLoop)
         }
     }
 
+    renderLoop->setDirectScanoutActive(result && layers.front().directScanout);
+    updateScanoutState(scanoutState, result && layers.front().directScanout, scanoutFailure);
+
     scene->frame(primaryView, frame.get());
     for (auto &layer : layers) {
         layer.view->postPaint();
@@ -975,6 +1103,48 @@ void Compositor::addOutput(LogicalOutput *logicalOutput, BackendOutput *backendO
     connect(backendOutput->renderLoop(), &RenderLoop::frameRequested, this, &Compositor::handleFrameRequested);
 }
 
+static QString scanoutFailureName(Compositor::ScanoutFailure failure)
+{
+    switch (failure) {
+    case Compositor::ScanoutFailure::NotVisible:
+        return QStringLiteral("notVisible");
+    case Compositor::ScanoutFailure::NoCandidate:
+        return QStringLiteral("noCandidate");
+    case Compositor::ScanoutFailure::NoBuffer:
+        return QStringLiteral("noBuffer");
+    case Compositor::ScanoutFailure::NotDmabuf:
+        return QStringLiteral("notDmabuf");
+    case Compositor::ScanoutFailure::UnsupportedFormat:
+        return QStringLiteral("unsupportedFormat");
+    case Compositor::ScanoutFailure::ImportFailed:
+        return QStringLiteral("importFailed");
+    case Compositor::ScanoutFailure::TestFailed:
+        return QStringLiteral("testFailed");
+    case Compositor::ScanoutFailure::PresentFailed:
+        return QStringLiteral("presentFailed");
+    case Compositor::ScanoutFailure::HeldOff:
+        return QStringLiteral("heldOff");
+    }
+    Q_UNREACHABLE();
+}
+
+QVariantMap Compositor::scanoutStatistics(RenderLoop *renderLoop) const
+{
+    const auto it = m_scanoutStates.find(renderLoop);
+    if (it == m_scanoutStates.end()) {
+        return QVariantMap{};
+    }
+    const ScanoutState &state = it->second;
+    return QVariantMap{
+        {QStringLiteral("active"), state.active},
+        {QStringLiteral("lastFailure"), state.lastFailure ? scanoutFailureName(*state.lastFailure) : QString()},
+        {QStringLiteral("holdoffFrames"), state.holdoffFrames},
+        {QStringLiteral("switches"), state.switches},
+        {QStringLiteral("scanoutFrames"), state.scanoutFrames},
+        {QStringLiteral("compositedFrames"), state.compositedFrames},
+    };
+}
+
 void Compositor::removeOutput(BackendOutput *output)
 {
     if (output->isPlaceholder()) {
@@ -984,6 +1154,8 @@ void Compositor::removeOutput(BackendOutput *output)
     m_overlayViews.erase(output->renderLoop());
     m_primaryViews.erase(output->renderLoop());
     m_brokenCursors.erase(output->renderLoop());
+    m_rejectedOverlays.erase(output->renderLoop());
+    m_scanoutStates.erase(output->renderLoop());
 }
 
 void Compositor::assignOutputLayers(LogicalOutput *logicalOutput, BackendOutput *backendOutput)
@@ -14,6 +14,9 @@
 
 #include <QHash>
 #include <QObject>
+#include <QPointer>
+#include <QVariantMap>
+#include <chrono>
 
 #include <memory>
 
@@ -22,6 +25,7 @@ namespace KWin
 
 class ColorDescription;
 class GLTexture;
+class Item;
 class LogicalOutput;
 class BackendOutput;
 class RenderBackend;
@@ -73,6 +77,39 @@ public:
 
     void createRenderer();
 
+    /**
+     * The reasons why a client buffer couldn't be scanned out directly on the primary layer.
+     */
+    enum class ScanoutFailure {
+        NotVisible,
+        NoCandidate,
+        NoBuffer,
+        NotDmabuf,
+        UnsupportedFormat,
+        ImportFailed,
+        TestFailed,
+        PresentFailed,
+        HeldOff, ///< the candidate is eligible, but scanout broke down too recently
+    };
+    struct ScanoutState
+    {
+        bool active = false;
+        int holdoffFrames = 0;
+        int penalty = 0;
+        int stableFrames = 0;
+        std::optional<ScanoutFailure> lastFailure;
+        quint64 switches = 0;
+        quint64 scanoutFrames = 0;
+        quint64 compositedFrames = 0;
+    };
+
+    /**
+     * Returns whether the primary layer of the render loop is scanned out directly, why it
+     * last wasn't, how many frames direct scanout is still held off for and how often the
+     * output switched between direct scanout and compositing.
+     */
+    QVariantMap scanoutStatistics(RenderLoop *renderLoop) const;
+
 Q_SIGNALS:
     void compositingToggled(bool active);
     void aboutToDestroy();
@@ -106,6 +143,17 @@ protected:
     std::unordered_map<RenderLoop *, std::unique_ptr<SceneView>> m_primaryViews;
     std::unordered_map<RenderLoop *, std::unordered_map<OutputLayer *, std::unique_ptr<ItemView>>> m_overlayViews;
     std::unordered_set<RenderLoop *> m_brokenCursors;
+    struct RejectedOverlay
+    {
+        QPointer<Item> item;
+        std::chrono::steady_clock::time_point expiry;
+    };
+    // items the driver recently refused to put on an overlay plane; they're composited for a while
+    // instead of repeating the same failing presentation test every frame
+    std::unordered_map<RenderLoop *, QList<RejectedOverlay>> m_rejectedOverlays;
+    // hysteresis for direct scanout on the primary layer, so that brief failures
+    // don't make the output flip between scanout and compositing every few frames
+    std::unordered_map<RenderLoop *, ScanoutState> m_scanoutStates;
     std::optional<bool> m_allowOverlaysEnv;
     RenderLoopDrivenQAnimationDriver *m_renderLoopDrivenAnimationDriver;
 };
@@ -24,6 +24,7 @@ constexpr QLatin1StringView LIBEXEC_DIR("${CMAKE_INSTALL_FULL_LIBEXECDIR}");
 #cmakedefine01 HAVE_GBM_BO_GET_FD_FOR_PLANE
 #cmakedefine01 HAVE_GBM_BO_CREATE_WITH_MODIFIERS2
 #cmakedefine01 HAVE_MEMFD
+#cmakedefine01 HAVE_UDMABUF
 #cmakedefine01 HAVE_SCHED_RESET_ON_FORK
 #cmakedefine01 HAVE_XKBCOMMON_NO_SECURE_GETENV
 #cmakedefine01 HAVE_XWAYLAND_ENABLE_EI_PORTAL
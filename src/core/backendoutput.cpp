@@ -773,6 +773,11 @@ bool BackendOutput::overlayLayersLikelyBroken() const
     return false;
 }
 
+QVariantMap BackendOutput::presentationStatistics() const
+{
+    return {};
+}
+
 const AutoBrightnessCurve &BackendOutput::autoBrightnessCurve() const
 {
     return m_state.autoBrightnessCurve;
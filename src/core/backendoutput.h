@@ -10,6 +10,8 @@
 
 #include "output.h"
 
+#include <QVariantMap>
+
 class QJsonArray;
 
 namespace KWin
@@ -299,6 +301,12 @@ public:
      */
     virtual bool overlayLayersLikelyBroken() const;
 
+    /**
+     * Returns backend specific statistics about the presentation of frames on this
+     * output, like commit latencies and missed deadlines. Intended for debugging
+     */
+    virtual QVariantMap presentationStatistics() const;
+
     /**
      * The color space in which the scene is blended
      */
@@ -9,8 +9,6 @@
 #include "colorlut3d.h"
 #include "colortransformation.h"
 
-#include <QVector3D>
-
 namespace KWin
 {
 
@@ -44,7 +42,17 @@ QVector3D ColorLUT3D::sample(const QVector3D &rgb)
 
 QVector3D ColorLUT3D::sample(size_t x, size_t y, size_t z)
 {
-    return m_transformation->transform(QVector3D(x / double(m_xSize - 1), y / double(m_ySize - 1), z / double(m_zSize - 1)));
+    if (m_samples.isEmpty()) {
+        m_samples.reserve(m_xSize * m_ySize * m_zSize);
+        for (size_t sz = 0; sz < m_zSize; sz++) {
+            for (size_t sy = 0; sy < m_ySize; sy++) {
+                for (size_t sx = 0; sx < m_xSize; sx++) {
+                    m_samples.push_back(m_transformation->transform(QVector3D(sx / double(m_xSize - 1), sy / double(m_ySize - 1), sz / double(m_zSize - 1))));
+                }
+            }
+        }
+    }
+    return m_samples[(z * m_ySize + y) * m_xSize + x];
 }
 
 }
@@ -8,13 +8,12 @@
 */
 #pragma once
 
+#include <QVector3D>
 #include <QVector>
 #include <memory>
 
 #include "kwin_export.h"
 
-class QVector3D;
-
 namespace KWin
 {
 
@@ -30,6 +29,12 @@ public:
     size_t zSize() const;
 
     QVector3D sample(const QVector3D &rgb);
+    /**
+     * Returns the value at the lattice point @p x, @p y, @p z. The whole lattice is
+     * evaluated on the first call and kept, so that uploading the LUT again, for example
+     * after the input color of the ICC shader has changed, doesn't have to go through the
+     * color transformation again.
+     */
     QVector3D sample(size_t x, size_t y, size_t z);
 
 private:
@@ -37,6 +42,7 @@ private:
     const size_t m_xSize;
     const size_t m_ySize;
     const size_t m_zSize;
+    QList<QVector3D> m_samples;
 };
 
 }
@@ -8,9 +8,14 @@
 
 #include "config-kwin.h"
 
+#include "core/gpumemorystatistics.h"
 #include "core/graphicsbuffer.h"
 #include "utils/common.h"
 
+#include <QTimer>
+
+#include <algorithm>
+#include <deque>
 #include <drm_fourcc.h>
 #include <fcntl.h>
 #include <gbm.h>
@@ -20,6 +25,15 @@
 namespace KWin
 {
 
+static size_t bufferBytes(const DmaBufAttributes &attributes)
+{
+    size_t bytes = 0;
+    for (int i = 0; i < attributes.planeCount; ++i) {
+        bytes += size_t(attributes.pitch[i]) * attributes.height;
+    }
+    return bytes;
+}
+
 static inline std::optional<DmaBufAttributes> dmaBufAttributesForBo(gbm_bo *bo)
 {
     DmaBufAttributes attributes;
@@ -56,12 +70,140 @@ static inline std::optional<DmaBufAttributes> dmaBufAttributesForBo(gbm_bo *bo)
     return attributes;
 }
 
+static const size_t s_maxPooledBytes = size_t(environmentVariableIntValue("KWIN_GBM_BUFFER_POOL_SIZE").value_or(64)) * 1024 * 1024;
+static constexpr std::chrono::seconds s_maxPooledBufferIdleTime{10};
+
+/**
+ * The GbmBufferPool keeps the buffer objects of destroyed recyclable buffers for a while, so that
+ * swapchains that are torn down and created again with the same size don't go through gbm_bo
+ * allocation every time. The pool is limited in size and buffers that aren't reused are freed
+ * after a few seconds.
+ */
+class GbmBufferPool
+{
+public:
+    struct Entry
+    {
+        gbm_bo *bo;
+        DmaBufAttributes attributes;
+        QList<uint64_t> requestedModifiers;
+        size_t bytes;
+        std::chrono::steady_clock::time_point releaseTime;
+    };
+
+    GbmBufferPool();
+    ~GbmBufferPool();
+
+    std::optional<Entry> take(const GraphicsBufferOptions &options);
+    bool recycle(gbm_bo *bo, DmaBufAttributes &&attributes, const QList<uint64_t> &requestedModifiers);
+    void close();
+
+private:
+    void trim(std::chrono::steady_clock::time_point now);
+
+    std::deque<Entry> m_entries;
+    size_t m_bytes = 0;
+    bool m_closed = false;
+    QTimer m_trimTimer;
+};
+
+GbmBufferPool::GbmBufferPool()
+{
+    m_trimTimer.setSingleShot(true);
+    m_trimTimer.setInterval(s_maxPooledBufferIdleTime);
+    QObject::connect(&m_trimTimer, &QTimer::timeout, [this]() {
+        trim(std::chrono::steady_clock::now());
+        if (!m_entries.empty()) {
+            m_trimTimer.start();
+        }
+    });
+}
+
+GbmBufferPool::~GbmBufferPool()
+{
+    close();
+}
+
+std::optional<GbmBufferPool::Entry> GbmBufferPool::take(const GraphicsBufferOptions &options)
+{
+    const auto it = std::ranges::find_if(m_entries, [&options](const Entry &entry) {
+        return entry.attributes.width == options.size.width()
+            && entry.attributes.height == options.size.height()
+            && entry.attributes.format == options.format
+            && entry.requestedModifiers == options.modifiers;
+    });
+    if (it == m_entries.end()) {
+        return std::nullopt;
+    }
+    Entry entry = std::move(*it);
+    m_entries.erase(it);
+    m_bytes -= entry.bytes;
+    GpuMemoryStatistics::remove(GpuMemoryCategory::PooledGraphicsBuffers, entry.bytes);
+    return entry;
+}
+
+bool GbmBufferPool::recycle(gbm_bo *bo, DmaBufAttributes &&attributes, const QList<uint64_t> &requestedModifiers)
+{
+    if (m_closed) {
+        return false;
+    }
+    const size_t bytes = bufferBytes(attributes);
+    if (bytes > s_maxPooledBytes) {
+        return false;
+    }
+
+    // make room by dropping the buffers that have been idle the longest
+    while (m_bytes + bytes > s_maxPooledBytes) {
+        m_bytes -= m_entries.front().bytes;
+        GpuMemoryStatistics::remove(GpuMemoryCategory::PooledGraphicsBuffers, m_entries.front().bytes);
+        gbm_bo_destroy(m_entries.front().bo);
+        m_entries.pop_front();
+    }
+
+    m_entries.push_back(Entry{
+        .bo = bo,
+        .attributes = std::move(attributes),
+        .requestedModifiers = requestedModifiers,
+        .bytes = bytes,
+        .releaseTime = std::chrono::steady_clock::now(),
+    });
+    m_bytes += bytes;
+    GpuMemoryStatistics::add(GpuMemoryCategory::PooledGraphicsBuffers, bytes);
+    if (!m_trimTimer.isActive()) {
+        m_trimTimer.start();
+    }
+    return true;
+}
+
+void GbmBufferPool::trim(std::chrono::steady_clock::time_point now)
+{
+    while (!m_entries.empty() && now - m_entries.front().releaseTime >= s_maxPooledBufferIdleTime) {
+        m_bytes -= m_entries.front().bytes;
+        GpuMemoryStatistics::remove(GpuMemoryCategory::PooledGraphicsBuffers, m_entries.front().bytes);
+        gbm_bo_destroy(m_entries.front().bo);
+        m_entries.pop_front();
+    }
+}
+
+void GbmBufferPool::close()
+{
+    m_closed = true;
+    m_trimTimer.stop();
+    for (const Entry &entry : m_entries) {
+        gbm_bo_destroy(entry.bo);
+    }
+    m_entries.clear();
+    GpuMemoryStatistics::remove(GpuMemoryCategory::PooledGraphicsBuffers, m_bytes);
+    m_bytes = 0;
+}
+
 class GbmGraphicsBuffer : public GraphicsBuffer
 {
     Q_OBJECT
 
 public:
     GbmGraphicsBuffer(DmaBufAttributes attributes, gbm_bo *handle);
+    GbmGraphicsBuffer(DmaBufAttributes attributes, gbm_bo *handle, const std::shared_ptr<GbmBufferPool> &pool, const QList<uint64_t> &requestedModifiers);
     ~GbmGraphicsBuffer() override;
 
     Map map(MapFlags flags) override;
@@ -71,8 +213,13 @@ public:
     bool hasAlphaChannel() const override;
     const DmaBufAttributes *dmabufAttributes() const override;
 
+    void setPool(const std::shared_ptr<GbmBufferPool> &pool, const QList<uint64_t> &requestedModifiers);
+
 private:
     gbm_bo *m_bo;
+    // the pool the buffer object is returned to once this buffer is destroyed, if it's recyclable
+    std::shared_ptr<GbmBufferPool> m_pool;
+    QList<uint64_t> m_requestedModifiers;
     void *m_mapPtr = nullptr;
     void *m_mapData = nullptr;
     // the stride of the buffer mapping can be different from the stride of the buffer itself
@@ -80,6 +227,7 @@ private:
     DmaBufAttributes m_dmabufAttributes;
     QSize m_size;
     bool m_hasAlphaChannel;
+    size_t m_bytes;
 };
 
 class DumbGraphicsBuffer : public GraphicsBuffer
@@ -108,11 +256,15 @@ private:
 
 GbmGraphicsBufferAllocator::GbmGraphicsBufferAllocator(gbm_device *device)
     : m_gbmDevice(device)
+    , m_pool(std::make_shared<GbmBufferPool>())
 {
 }
 
 GbmGraphicsBufferAllocator::~GbmGraphicsBufferAllocator()
 {
+    // the gbm device goes away together with the allocator, buffers that are still alive can't
+    // be recycled anymore
+    m_pool->close();
 }
 
 static GraphicsBuffer *allocateDumb(gbm_device *device, const GraphicsBufferOptions &options)
@@ -207,7 +359,19 @@ GraphicsBuffer *GbmGraphicsBufferAllocator::allocate(const GraphicsBufferOptions
         return allocateDumb(m_gbmDevice, options);
     }
 
-    return allocateDmaBuf(m_gbmDevice, options);
+    if (!options.recyclable || !s_maxPooledBytes) {
+        return allocateDmaBuf(m_gbmDevice, options);
+    }
+
+    if (std::optional<GbmBufferPool::Entry> entry = m_pool->take(options)) {
+        return new GbmGraphicsBuffer(std::move(entry->attributes), entry->bo, m_pool, options.modifiers);
+    }
+
+    auto buffer = static_cast<GbmGraphicsBuffer *>(allocateDmaBuf(m_gbmDevice, options));
+    if (buffer) {
+        buffer->setPool(m_pool, options.modifiers);
+    }
+    return buffer;
 }
 
 GbmGraphicsBuffer::GbmGraphicsBuffer(DmaBufAttributes attributes, gbm_bo *handle)
@@ -215,15 +379,33 @@ GbmGraphicsBuffer::GbmGraphicsBuffer(DmaBufAttributes attributes, gbm_bo *handle
     , m_dmabufAttributes(std::move(attributes))
     , m_size(m_dmabufAttributes.width, m_dmabufAttributes.height)
     , m_hasAlphaChannel(alphaChannelFromDrmFormat(m_dmabufAttributes.format))
+    , m_bytes(bufferBytes(m_dmabufAttributes))
 {
+    GpuMemoryStatistics::add(GpuMemoryCategory::GraphicsBuffers, m_bytes);
+}
+
+GbmGraphicsBuffer::GbmGraphicsBuffer(DmaBufAttributes attributes, gbm_bo *handle, const std::shared_ptr<GbmBufferPool> &pool, const QList<uint64_t> &requestedModifiers)
+    : GbmGraphicsBuffer(std::move(attributes), handle)
+{
+    setPool(pool, requestedModifiers);
 }
 
 GbmGraphicsBuffer::~GbmGraphicsBuffer()
 {
     unmap();
+    GpuMemoryStatistics::remove(GpuMemoryCategory::GraphicsBuffers, m_bytes);
+    if (m_pool && m_pool->recycle(m_bo, std::move(m_dmabufAttributes), m_requestedModifiers)) {
+        return;
+    }
     gbm_bo_destroy(m_bo);
 }
 
+void GbmGraphicsBuffer::setPool(const std::shared_ptr<GbmBufferPool> &pool, const QList<uint64_t> &requestedModifiers)
+{
+    m_pool = pool;
+    m_requestedModifiers = requestedModifiers;
+}
+
 QSize GbmGraphicsBuffer::size() const
 {
     return m_size;
@@ -273,11 +455,13 @@ DumbGraphicsBuffer::DumbGraphicsBuffer(int drmFd, uint32_t handle, DmaBufAttribu
     , m_dmabufAttributes(std::move(attributes))
     , m_hasAlphaChannel(alphaChannelFromDrmFormat(m_dmabufAttributes.format))
 {
+    GpuMemoryStatistics::add(GpuMemoryCategory::GraphicsBuffers, m_size);
 }
 
 DumbGraphicsBuffer::~DumbGraphicsBuffer()
 {
     unmap();
+    GpuMemoryStatistics::remove(GpuMemoryCategory::GraphicsBuffers, m_size);
 
     drm_mode_destroy_dumb destroyArgs{
         .handle = m_handle,
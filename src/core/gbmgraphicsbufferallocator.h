@@ -8,11 +8,15 @@
 
 #include "core/graphicsbufferallocator.h"
 
+#include <memory>
+
 struct gbm_device;
 
 namespace KWin
 {
 
+class GbmBufferPool;
+
 class KWIN_EXPORT GbmGraphicsBufferAllocator : public GraphicsBufferAllocator
 {
 public:
@@ -23,6 +27,7 @@ public:
 
 private:
     gbm_device *m_gbmDevice;
+    std::shared_ptr<GbmBufferPool> m_pool;
 };
 
 } // namespace KWin
@@ -0,0 +1,88 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "core/gpumemorystatistics.h"
+#include "utils/envvar.h"
+
+#include <array>
+#include <atomic>
+
+namespace KWin
+{
+
+static constexpr std::array s_categories{
+    std::pair(GpuMemoryCategory::Textures, QLatin1StringView("textures")),
+    std::pair(GpuMemoryCategory::WindowContents, QLatin1StringView("windowContents")),
+    std::pair(GpuMemoryCategory::Decorations, QLatin1StringView("decorations")),
+    std::pair(GpuMemoryCategory::Shadows, QLatin1StringView("shadows")),
+    std::pair(GpuMemoryCategory::EffectTargets, QLatin1StringView("effectTargets")),
+    std::pair(GpuMemoryCategory::GraphicsBuffers, QLatin1StringView("graphicsBuffers")),
+    std::pair(GpuMemoryCategory::PooledGraphicsBuffers, QLatin1StringView("pooledGraphicsBuffers")),
+};
+
+// buffers can be released from other threads, e.g. by the screencast code
+static std::array<std::atomic<qint64>, s_categories.size()> s_usage;
+
+void GpuMemoryStatistics::add(GpuMemoryCategory category, qint64 bytes)
+{
+    s_usage[size_t(category)] += bytes;
+}
+
+void GpuMemoryStatistics::remove(GpuMemoryCategory category, qint64 bytes)
+{
+    s_usage[size_t(category)] -= bytes;
+}
+
+qint64 GpuMemoryStatistics::usage(GpuMemoryCategory category)
+{
+    return s_usage[size_t(category)];
+}
+
+qint64 GpuMemoryStatistics::totalUsage()
+{
+    qint64 total = 0;
+    for (const std::atomic<qint64> &usage : s_usage) {
+        total += usage;
+    }
+    return total;
+}
+
+qint64 GpuMemoryStatistics::budget()
+{
+    static const qint64 budget = qint64(environmentVariableIntValue("KWIN_GPU_MEMORY_BUDGET").value_or(0)) * 1024 * 1024;
+    return budget;
+}
+
+bool GpuMemoryStatistics::isOverBudget()
+{
+    return budget() > 0 && totalUsage() > budget();
+}
+
+QVariantMap GpuMemoryStatistics::statistics()
+{
+    QVariantMap ret;
+    for (const auto &[category, name] : s_categories) {
+        ret[name] = usage(category);
+    }
+    ret[QStringLiteral("total")] = totalUsage();
+    ret[QStringLiteral("budget")] = budget();
+    return ret;
+}
+
+QString GpuMemoryStatistics::supportInformation()
+{
+    QString support = QStringLiteral("GPU memory (estimated):\n");
+    for (const auto &[category, name] : s_categories) {
+        support.append(QStringLiteral("%1: %2 KiB\n").arg(name).arg(usage(category) / 1024));
+    }
+    support.append(QStringLiteral("total: %1 KiB\n").arg(totalUsage() / 1024));
+    if (budget() > 0) {
+        support.append(QStringLiteral("budget: %1 KiB\n").arg(budget() / 1024));
+    }
+    return support;
+}
+
+} // namespace KWin
@@ -0,0 +1,60 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "kwin_export.h"
+
+#include <QString>
+#include <QVariantMap>
+
+namespace KWin
+{
+
+/**
+ * The GpuMemoryCategory type specifies what a piece of graphics memory is used for.
+ */
+enum class GpuMemoryCategory {
+    Textures, ///< Textures that don't belong to any of the other categories
+    WindowContents, ///< Copies of the contents of shared memory client buffers
+    Decorations, ///< Decoration atlases
+    Shadows, ///< Shadow textures
+    EffectTargets, ///< Offscreen render targets of effects
+    GraphicsBuffers, ///< Buffers allocated by the compositor, e.g. swapchains or screencast buffers
+    PooledGraphicsBuffers, ///< Idle buffers kept around to be reused
+};
+
+/**
+ * The GpuMemoryStatistics class keeps track of the graphics memory that the compositor allocates
+ * itself. Memory that belongs to clients, e.g. imported dmabufs, isn't accounted.
+ *
+ * The numbers are estimates based on the size and the format of the allocations, drivers can
+ * allocate more for padding or compression metadata.
+ */
+class KWIN_EXPORT GpuMemoryStatistics
+{
+public:
+    static void add(GpuMemoryCategory category, qint64 bytes);
+    static void remove(GpuMemoryCategory category, qint64 bytes);
+
+    static qint64 usage(GpuMemoryCategory category);
+    static qint64 totalUsage();
+
+    /**
+     * Returns the amount of memory that the compositor tries to stay under, or 0 if there is
+     * no budget. It can be set with the KWIN_GPU_MEMORY_BUDGET environment variable, in MiB.
+     */
+    static qint64 budget();
+    static bool isOverBudget();
+
+    /**
+     * Returns the usage per category, in bytes, plus the total and the budget.
+     */
+    static QVariantMap statistics();
+    static QString supportInformation();
+};
+
+} // namespace KWin
@@ -32,6 +32,11 @@ struct GraphicsBufferOptions
 
     /// Whether the graphics buffer should be suitable for software rendering.
     bool software = false;
+
+    /// Whether the allocator may keep the buffer once it's destroyed and hand it out again. The
+    /// contents of a recycled buffer are not cleared, so only set it for buffers that are never
+    /// shared with other processes.
+    bool recyclable = false;
 };
 
 class KWIN_EXPORT GraphicsBufferAllocator
@@ -10,7 +10,9 @@
 #include "utils/common.h"
 
 #include <KLocalizedString>
-#include <QFileInfo>
+#include <QCache>
+#include <QCryptographicHash>
+#include <QFile>
 #include <lcms2.h>
 #include <span>
 #include <tuple>
@@ -379,18 +381,11 @@ static constexpr XYZ D50{
     .Z = 0.8249,
 };
 
-std::expected<std::unique_ptr<IccProfile>, QString> IccProfile::load(const QString &path)
+static std::expected<std::unique_ptr<IccProfile>, QString> parseProfile(const QString &path, const QByteArray &contents)
 {
-    if (path.isEmpty()) {
-        return nullptr;
-    }
-    cmsHPROFILE handle = cmsOpenProfileFromFile(path.toUtf8(), "r");
+    cmsHPROFILE handle = cmsOpenProfileFromMem(contents.constData(), contents.size());
     if (!handle) {
-        if (QFileInfo::exists(path)) {
-            return std::unexpected(i18n("Failed to open ICC profile \"%1\"", path));
-        } else {
-            return std::unexpected(i18n("ICC profile \"%1\" doesn't exist", path));
-        }
+        return std::unexpected(i18n("Failed to open ICC profile \"%1\"", path));
     }
     if (cmsGetDeviceClass(handle) != cmsSigDisplayClass) {
         return std::unexpected(i18n("ICC profile \"%1\" is not usable for displays", path));
@@ -578,4 +573,36 @@ std::expected<std::unique_ptr<IccProfile>, QString> IccProfile::load(const QStri
     return std::make_unique<IccProfile>(handle, Colorimetry(red, green, blue, white), std::move(bToA0), std::move(bToA1), inverseEOTF, xyzMatrix, vcgt, relativeBlackPoint, maxFALL, maxCLL);
 }
 
+std::expected<std::shared_ptr<IccProfile>, QString> IccProfile::load(const QString &path)
+{
+    if (path.isEmpty()) {
+        return nullptr;
+    }
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (file.exists()) {
+            return std::unexpected(i18n("Failed to open ICC profile \"%1\"", path));
+        } else {
+            return std::unexpected(i18n("ICC profile \"%1\" doesn't exist", path));
+        }
+    }
+    const QByteArray contents = file.readAll();
+
+    // profiles are immutable, so outputs that use the same profile can share it. Some recently
+    // used ones are also kept around, so that re-plugging a monitor doesn't parse its profile again
+    static QCache<QByteArray, std::shared_ptr<IccProfile>> cache(8);
+    const QByteArray hash = QCryptographicHash::hash(contents, QCryptographicHash::Sha1);
+    if (const std::shared_ptr<IccProfile> *cached = cache.object(hash)) {
+        return *cached;
+    }
+
+    auto profile = parseProfile(path, contents);
+    if (!profile) {
+        return std::unexpected(profile.error());
+    }
+    std::shared_ptr<IccProfile> ret = std::move(*profile);
+    cache.insert(hash, new std::shared_ptr<IccProfile>(ret));
+    return ret;
+}
+
 }
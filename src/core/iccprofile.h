@@ -57,7 +57,10 @@ public:
     std::optional<double> maxFALL() const;
     std::optional<double> maxCLL() const;
 
-    static std::expected<std::unique_ptr<IccProfile>, QString> load(const QString &path);
+    /**
+     * Profiles with the same contents are only parsed once and shared
+     */
+    static std::expected<std::shared_ptr<IccProfile>, QString> load(const QString &path);
     static const ColorDescription s_connectionSpace;
 
 private:
@@ -8,9 +8,120 @@
 
 #include <QDebug>
 
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace KWin
 {
 
+/*
+ * Rect and RectF are stored as (left, top, right, bottom) tuples, which allows processing a whole
+ * rectangle with a single SSE2 or NEON operation. SSE2 and NEON are part of the x86-64 and AArch64
+ * baselines respectively, so no runtime dispatch is needed.
+ */
+static_assert(sizeof(Rect) == 4 * sizeof(int));
+static_assert(sizeof(RectF) == 4 * sizeof(qreal));
+
+static void translateRects(Rect *rects, qsizetype count, const QPoint &offset)
+{
+#if defined(__SSE2__)
+    const __m128i delta = _mm_setr_epi32(offset.x(), offset.y(), offset.x(), offset.y());
+    for (qsizetype i = 0; i < count; ++i) {
+        __m128i *rect = reinterpret_cast<__m128i *>(rects + i);
+        _mm_storeu_si128(rect, _mm_add_epi32(_mm_loadu_si128(rect), delta));
+    }
+#elif defined(__ARM_NEON)
+    const int32_t deltaValues[] = {offset.x(), offset.y(), offset.x(), offset.y()};
+    const int32x4_t delta = vld1q_s32(deltaValues);
+    for (qsizetype i = 0; i < count; ++i) {
+        int32_t *rect = reinterpret_cast<int32_t *>(rects + i);
+        vst1q_s32(rect, vaddq_s32(vld1q_s32(rect), delta));
+    }
+#else
+    for (qsizetype i = 0; i < count; ++i) {
+        rects[i].translate(offset);
+    }
+#endif
+}
+
+/*
+ * Returns true if the two rectangles have the same left and right edges.
+ */
+static bool sameHorizontalEdges(const Rect &a, const Rect &b)
+{
+#if defined(__SSE2__)
+    const __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&a)),
+                                          _mm_loadu_si128(reinterpret_cast<const __m128i *>(&b)));
+    // Only the left (lane 0) and the right (lane 2) edges are relevant.
+    return (_mm_movemask_ps(_mm_castsi128_ps(equal)) & 0b0101) == 0b0101;
+#else
+    return a.left() == b.left() && a.right() == b.right();
+#endif
+}
+
+static void translateRects(RectF *rects, qsizetype count, const QPointF &offset)
+{
+#if defined(__SSE2__)
+    if constexpr (std::is_same_v<qreal, double>) {
+        const __m128d delta = _mm_setr_pd(offset.x(), offset.y());
+        for (qsizetype i = 0; i < count; ++i) {
+            double *rect = reinterpret_cast<double *>(rects + i);
+            _mm_storeu_pd(rect, _mm_add_pd(_mm_loadu_pd(rect), delta));
+            _mm_storeu_pd(rect + 2, _mm_add_pd(_mm_loadu_pd(rect + 2), delta));
+        }
+        return;
+    }
+#elif defined(__aarch64__)
+    if constexpr (std::is_same_v<qreal, double>) {
+        const double deltaValues[] = {offset.x(), offset.y()};
+        const float64x2_t delta = vld1q_f64(deltaValues);
+        for (qsizetype i = 0; i < count; ++i) {
+            double *rect = reinterpret_cast<double *>(rects + i);
+            vst1q_f64(rect, vaddq_f64(vld1q_f64(rect), delta));
+            vst1q_f64(rect + 2, vaddq_f64(vld1q_f64(rect + 2), delta));
+        }
+        return;
+    }
+#endif
+    for (qsizetype i = 0; i < count; ++i) {
+        rects[i].translate(offset);
+    }
+}
+
+static void scaleRects(RectF *rects, qsizetype count, qreal xScale, qreal yScale)
+{
+#if defined(__SSE2__)
+    if constexpr (std::is_same_v<qreal, double>) {
+        const __m128d factor = _mm_setr_pd(xScale, yScale);
+        for (qsizetype i = 0; i < count; ++i) {
+            double *rect = reinterpret_cast<double *>(rects + i);
+            _mm_storeu_pd(rect, _mm_mul_pd(_mm_loadu_pd(rect), factor));
+            _mm_storeu_pd(rect + 2, _mm_mul_pd(_mm_loadu_pd(rect + 2), factor));
+        }
+        return;
+    }
+#elif defined(__aarch64__)
+    if constexpr (std::is_same_v<qreal, double>) {
+        const double factorValues[] = {xScale, yScale};
+        const float64x2_t factor = vld1q_f64(factorValues);
+        for (qsizetype i = 0; i < count; ++i) {
+            double *rect = reinterpret_cast<double *>(rects + i);
+            vst1q_f64(rect, vmulq_f64(vld1q_f64(rect), factor));
+            vst1q_f64(rect + 2, vmulq_f64(vld1q_f64(rect + 2), factor));
+        }
+        return;
+    }
+#endif
+    for (qsizetype i = 0; i < count; ++i) {
+        rects[i].scale(xScale, yScale);
+    }
+}
+
 Region::Region(const QRegion &region)
 {
     const QSpan<const QRect> rects = region.rects();
@@ -199,7 +310,7 @@ QSpan<const Rect> Region::rects() const
     if (m_rects.isEmpty()) {
         return QSpan(&m_bounds, 1);
     } else {
-        return QSpan(m_rects);
+        return QSpan(m_rects.constData(), m_rects.size());
     }
 }
 
@@ -460,9 +571,7 @@ Region::BandRef Region::coalesceBands(const BandRef &previous, const BandRef &cu
     }
 
     for (qsizetype i = 0; i < currentCount; ++i) {
-        const Rect &a = m_rects[previous.start + i];
-        const Rect &b = m_rects[current.start + i];
-        if (a.left() != b.left() || a.right() != b.right()) {
+        if (!sameHorizontalEdges(m_rects[previous.start + i], m_rects[current.start + i])) {
             return current;
         }
     }
@@ -1013,8 +1122,8 @@ void Region::translate(const QPoint &offset)
     }
 
     m_bounds.translate(offset);
-    for (Rect &rect : m_rects) {
-        rect.translate(offset);
+    if (!m_rects.isEmpty()) {
+        translateRects(m_rects.data(), m_rects.size(), offset);
     }
 }
 
@@ -1085,6 +1194,65 @@ Region Region::scaledAndRoundedOut(qreal xScale, qreal yScale) const
     return result;
 }
 
+static qint64 area(const Rect &rect)
+{
+    return qint64(rect.width()) * rect.height();
+}
+
+Region Region::simplified(int maxRectCount) const
+{
+    if (*this == infinite() || m_rects.size() <= maxRectCount) {
+        return *this;
+    }
+
+    struct Cluster
+    {
+        Rect bounds;
+        qint64 area;
+    };
+
+    // The rects are sorted by y and x, so rects that are close to each other are also close
+    // in the list and the clusters stay few. A rect joins the cluster where it wastes the
+    // least area, as long as at least two thirds of the cluster bounds are actually covered.
+    QList<Cluster> clusters;
+    clusters.reserve(maxRectCount);
+    for (const Rect &rect : m_rects) {
+        const qint64 rectArea = area(rect);
+        Cluster *best = nullptr;
+        qint64 bestWaste = std::numeric_limits<qint64>::max();
+        for (Cluster &cluster : clusters) {
+            const qint64 covered = cluster.area + rectArea;
+            const qint64 waste = area(cluster.bounds.united(rect)) - covered;
+            if (waste * 2 <= covered && waste < bestWaste) {
+                best = &cluster;
+                bestWaste = waste;
+            }
+        }
+
+        if (best) {
+            best->bounds = best->bounds.united(rect);
+            best->area += rectArea;
+        } else if (clusters.size() < maxRectCount) {
+            clusters.append(Cluster{rect, rectArea});
+        } else {
+            return Region(m_bounds);
+        }
+    }
+
+    QList<Rect> rects;
+    rects.reserve(clusters.size());
+    for (const Cluster &cluster : std::as_const(clusters)) {
+        rects.append(cluster.bounds);
+    }
+
+    // Overlapping clusters can be split into more rects again
+    const Region result = fromUnsortedRects(rects);
+    if (result.rects().size() > maxRectCount) {
+        return Region(m_bounds);
+    }
+    return result;
+}
+
 void Region::assignSortedRects(const QList<Rect> &rects)
 {
     m_rects = rects;
@@ -1498,7 +1666,7 @@ QSpan<const RectF> RegionF::rects() const
     if (m_rects.isEmpty()) {
         return QSpan(&m_bounds, 1);
     } else {
-        return QSpan(m_rects);
+        return QSpan(m_rects.constData(), m_rects.size());
     }
 }
 
@@ -2312,8 +2480,8 @@ void RegionF::translate(const QPointF &offset)
     }
 
     m_bounds.translate(offset);
-    for (RectF &rect : m_rects) {
-        rect.translate(offset);
+    if (!m_rects.isEmpty()) {
+        translateRects(m_rects.data(), m_rects.size(), offset);
     }
 }
 
@@ -2343,8 +2511,8 @@ void RegionF::scale(qreal xScale, qreal yScale)
     }
 
     m_bounds.scale(xScale, yScale);
-    for (RectF &rect : m_rects) {
-        rect.scale(xScale, yScale);
+    if (!m_rects.isEmpty()) {
+        scaleRects(m_rects.data(), m_rects.size(), xScale, yScale);
     }
 }
 
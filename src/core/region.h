@@ -7,6 +7,7 @@
 #pragma once
 
 #include "core/rect.h"
+#include "core/regionstorage.h"
 
 #include <QList>
 #include <QRegion>
@@ -231,6 +232,17 @@ public:
      */
     Region scaledAndRoundedOut(qreal xScale, qreal yScale) const;
 
+    /*!
+     * Returns a region that contains this region and is made of at most \a maxRectCount
+     * rectangles. Rectangles that lie close to each other are merged as long as that doesn't
+     * add much area that is not in this region; if that is not enough, the bounding rectangle
+     * is returned.
+     *
+     * This is useful for damage, e.g. fractional scaling splits the damage into many small
+     * rectangles, which are expensive to scissor one by one.
+     */
+    Region simplified(int maxRectCount) const;
+
     /*!
      * Returns the rectangles that this region is made of.
      */
@@ -507,7 +519,7 @@ private:
     BandRef coalesceBands(const BandRef &previous, const BandRef &current);
     void appendRects(QSpan<const Rect> rects);
 
-    QList<Rect> m_rects;
+    RegionStorage<Rect, 4> m_rects;
     Rect m_bounds;
 };
 
@@ -1022,7 +1034,7 @@ private:
     BandRef coalesceBands(const BandRef &previous, const BandRef &current);
     void appendRects(QSpan<const RectF> rects);
 
-    QList<RectF> m_rects;
+    RegionStorage<RectF, 4> m_rects;
     RectF m_bounds;
 
     friend class Region;
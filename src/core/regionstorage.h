@@ -0,0 +1,251 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QList>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace KWin
+{
+
+/*!
+ * \internal
+ *
+ * The RegionStorage type is the rectangle storage used by Region and RegionF.
+ *
+ * Most regions in the damage tracking path consist of only a handful of rectangles. The storage
+ * keeps up to \c InlineCapacity rectangles inline, so building and copying such regions doesn't
+ * touch the heap allocator. Once the number of rectangles exceeds the inline capacity, they are
+ * moved to an implicitly shared QList, so large regions are still cheap to copy.
+ *
+ * The element type must be trivially copyable.
+ */
+template<typename T, qsizetype InlineCapacity>
+class RegionStorage
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(std::is_trivially_destructible_v<T>);
+
+public:
+    RegionStorage() = default;
+
+    RegionStorage(const RegionStorage &other)
+        : m_heap(other.m_heap)
+        , m_inlineSize(other.m_inlineSize)
+        , m_onHeap(other.m_onHeap)
+    {
+        if (!m_onHeap) {
+            std::memcpy(m_inline, other.m_inline, m_inlineSize * sizeof(T));
+        }
+    }
+
+    RegionStorage(RegionStorage &&other) noexcept
+        : m_heap(std::move(other.m_heap))
+        , m_inlineSize(std::exchange(other.m_inlineSize, 0))
+        , m_onHeap(std::exchange(other.m_onHeap, false))
+    {
+        if (!m_onHeap) {
+            std::memcpy(m_inline, other.m_inline, m_inlineSize * sizeof(T));
+        }
+    }
+
+    RegionStorage(const QList<T> &list)
+    {
+        if (list.size() <= InlineCapacity) {
+            std::memcpy(m_inline, list.constData(), list.size() * sizeof(T));
+            m_inlineSize = list.size();
+        } else {
+            m_heap = list;
+            m_onHeap = true;
+        }
+    }
+
+    RegionStorage &operator=(const RegionStorage &other)
+    {
+        if (this != &other) {
+            m_heap = other.m_heap;
+            m_inlineSize = other.m_inlineSize;
+            m_onHeap = other.m_onHeap;
+            if (!m_onHeap) {
+                std::memcpy(m_inline, other.m_inline, m_inlineSize * sizeof(T));
+            }
+        }
+        return *this;
+    }
+
+    RegionStorage &operator=(RegionStorage &&other) noexcept
+    {
+        if (this != &other) {
+            m_heap = std::move(other.m_heap);
+            m_inlineSize = std::exchange(other.m_inlineSize, 0);
+            m_onHeap = std::exchange(other.m_onHeap, false);
+            if (!m_onHeap) {
+                std::memcpy(m_inline, other.m_inline, m_inlineSize * sizeof(T));
+            }
+        }
+        return *this;
+    }
+
+    qsizetype size() const
+    {
+        return m_onHeap ? m_heap.size() : m_inlineSize;
+    }
+
+    bool isEmpty() const
+    {
+        return size() == 0;
+    }
+
+    T *data()
+    {
+        return m_onHeap ? m_heap.data() : inlineData();
+    }
+
+    const T *data() const
+    {
+        return m_onHeap ? m_heap.constData() : inlineData();
+    }
+
+    const T *constData() const
+    {
+        return data();
+    }
+
+    T *begin()
+    {
+        return data();
+    }
+
+    T *end()
+    {
+        return data() + size();
+    }
+
+    const T *begin() const
+    {
+        return data();
+    }
+
+    const T *end() const
+    {
+        return data() + size();
+    }
+
+    T &operator[](qsizetype index)
+    {
+        Q_ASSERT(index >= 0 && index < size());
+        return data()[index];
+    }
+
+    const T &operator[](qsizetype index) const
+    {
+        Q_ASSERT(index >= 0 && index < size());
+        return data()[index];
+    }
+
+    const T &constFirst() const
+    {
+        Q_ASSERT(!isEmpty());
+        return data()[0];
+    }
+
+    void reserve(qsizetype capacity)
+    {
+        if (m_onHeap) {
+            m_heap.reserve(capacity);
+        } else if (capacity > InlineCapacity) {
+            moveToHeap(capacity);
+        }
+    }
+
+    void resizeForOverwrite(qsizetype size)
+    {
+        if (!m_onHeap && size > InlineCapacity) {
+            moveToHeap(size);
+        }
+
+        if (m_onHeap) {
+            m_heap.resizeForOverwrite(size);
+        } else {
+            m_inlineSize = size;
+        }
+    }
+
+    template<typename... Args>
+    T &emplaceBack(Args &&...args)
+    {
+        if (!m_onHeap) {
+            if (m_inlineSize < InlineCapacity) {
+                T *slot = new (inlineData() + m_inlineSize) T(std::forward<Args>(args)...);
+                ++m_inlineSize;
+                return *slot;
+            }
+            moveToHeap(InlineCapacity * 2);
+        }
+        return m_heap.emplaceBack(std::forward<Args>(args)...);
+    }
+
+    void append(const T &value)
+    {
+        emplaceBack(value);
+    }
+
+    void remove(qsizetype index, qsizetype count = 1)
+    {
+        Q_ASSERT(index >= 0 && count >= 0 && index + count <= size());
+        if (m_onHeap) {
+            m_heap.remove(index, count);
+        } else {
+            T *items = inlineData();
+            std::memmove(items + index, items + index + count, (m_inlineSize - index - count) * sizeof(T));
+            m_inlineSize -= count;
+        }
+    }
+
+    bool operator==(const RegionStorage &other) const
+    {
+        if (m_onHeap && other.m_onHeap && m_heap.constData() == other.m_heap.constData()) {
+            return m_heap.size() == other.m_heap.size();
+        }
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+private:
+    T *inlineData()
+    {
+        return std::launder(reinterpret_cast<T *>(m_inline));
+    }
+
+    const T *inlineData() const
+    {
+        return std::launder(reinterpret_cast<const T *>(m_inline));
+    }
+
+    void moveToHeap(qsizetype capacity)
+    {
+        QList<T> heap;
+        heap.reserve(std::max(capacity, m_inlineSize));
+        for (qsizetype i = 0; i < m_inlineSize; ++i) {
+            heap.append(inlineData()[i]);
+        }
+        m_heap = std::move(heap);
+        m_inlineSize = 0;
+        m_onHeap = true;
+    }
+
+    QList<T> m_heap;
+    alignas(T) std::byte m_inline[InlineCapacity * sizeof(T)];
+    qsizetype m_inlineSize = 0;
+    bool m_onHeap = false;
+};
+
+} // namespace KWin
@@ -21,6 +21,7 @@ RenderTimeSpan RenderTimeSpan::operator|(const RenderTimeSpan &other) const
     return RenderTimeSpan{
         .start = std::min(start, other.start),
         .end = std::max(end, other.end),
+        .queueDelay = std::max(queueDelay, other.queueDelay),
     };
 }
 
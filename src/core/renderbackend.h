@@ -40,6 +40,9 @@ struct RenderTimeSpan
 {
     std::chrono::steady_clock::time_point start = std::chrono::steady_clock::time_point{std::chrono::nanoseconds::zero()};
     std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point{std::chrono::nanoseconds::zero()};
+    // how long the GPU took to start with the work after it was submitted, it grows when
+    // clients keep the GPU busy
+    std::chrono::nanoseconds queueDelay = std::chrono::nanoseconds::zero();
 
     RenderTimeSpan operator|(const RenderTimeSpan &other) const;
 };
@@ -14,7 +14,8 @@ using namespace std::chrono_literals;
 namespace KWin
 {
 
-RenderJournal::RenderJournal()
+RenderJournal::RenderJournal(Estimator estimator)
+    : m_estimator(estimator)
 {
 }
 
@@ -36,11 +37,108 @@ void RenderJournal::add(std::chrono::nanoseconds renderTime, std::chrono::nanose
     static constexpr std::chrono::nanoseconds timeConstant = 500ms;
     const double ratio = std::clamp(timeDifference.count() / double(timeConstant.count()), 0.01, 1.0);
     m_result = mix(renderTime, m_result, ratio);
+
+    if (m_samples.size() < m_windowSize) {
+        m_samples.push_back(renderTime);
+    } else {
+        m_samples[m_sampleHead] = renderTime;
+        m_sampleHead = (m_sampleHead + 1) % m_windowSize;
+    }
+    if (m_estimator == Estimator::Percentile) {
+        updatePercentile();
+    }
+}
+
+void RenderJournal::updatePercentile()
+{
+    if (m_samples.empty()) {
+        m_percentileRenderTime = 0ns;
+        return;
+    }
+    const size_t rank = std::max<size_t>(std::ceil(m_percentile * m_samples.size()), 1);
+    const size_t index = std::min(rank, m_samples.size()) - 1;
+    // the ring buffer has to stay in chronological order, so select in a copy of it
+    m_sortedSamples.assign(m_samples.begin(), m_samples.end());
+    std::nth_element(m_sortedSamples.begin(), m_sortedSamples.begin() + index, m_sortedSamples.end());
+    m_percentileRenderTime = m_sortedSamples[index];
 }
 
 std::chrono::nanoseconds RenderJournal::result() const
 {
+    if (m_estimator == Estimator::Percentile) {
+        // the deviation reacts to sudden increases in render time immediately, while
+        // the percentile only does so once enough slow frames are in the window
+        return std::max(m_percentileRenderTime, m_result + m_variance);
+    }
     return m_result + m_variance * 2;
 }
 
+RenderJournal::Estimator RenderJournal::estimator() const
+{
+    return m_estimator;
+}
+
+void RenderJournal::setEstimator(Estimator estimator)
+{
+    m_estimator = estimator;
+    if (m_estimator == Estimator::Percentile) {
+        updatePercentile();
+    }
+}
+
+double RenderJournal::percentile() const
+{
+    return m_percentile;
+}
+
+void RenderJournal::setPercentile(double percentile)
+{
+    m_percentile = std::clamp(percentile, 0.0, 1.0);
+    if (m_estimator == Estimator::Percentile) {
+        updatePercentile();
+    }
+}
+
+size_t RenderJournal::windowSize() const
+{
+    return m_windowSize;
+}
+
+void RenderJournal::setWindowSize(size_t size)
+{
+    size = std::max<size_t>(size, 1);
+    if (m_samples.size() > size) {
+        // keep the newest samples
+        std::rotate(m_samples.begin(), m_samples.begin() + m_sampleHead, m_samples.end());
+        m_samples.erase(m_samples.begin(), m_samples.end() - size);
+    } else if (m_sampleHead != 0) {
+        std::rotate(m_samples.begin(), m_samples.begin() + m_sampleHead, m_samples.end());
+    }
+    m_sampleHead = 0;
+    m_windowSize = size;
+    if (m_estimator == Estimator::Percentile) {
+        updatePercentile();
+    }
+}
+
+size_t RenderJournal::sampleCount() const
+{
+    return m_samples.size();
+}
+
+std::chrono::nanoseconds RenderJournal::average() const
+{
+    return m_result;
+}
+
+std::chrono::nanoseconds RenderJournal::variance() const
+{
+    return m_variance;
+}
+
+std::chrono::nanoseconds RenderJournal::percentileRenderTime() const
+{
+    return m_percentileRenderTime;
+}
+
 } // namespace KWin
@@ -9,6 +9,7 @@
 
 #include <chrono>
 #include <optional>
+#include <vector>
 
 namespace KWin
 {
@@ -20,16 +21,60 @@ namespace KWin
 class KWIN_EXPORT RenderJournal
 {
 public:
-    explicit RenderJournal();
+    enum class Estimator {
+        /**
+         * Exponential moving average of the render time, plus two times the exponential
+         * moving average of the positive deviation from it.
+         */
+        ExponentialAverage,
+        /**
+         * The configured percentile of the last windowSize() render times. If render times
+         * suddenly increase, this falls back to the exponential average plus deviation until
+         * the window has caught up.
+         */
+        Percentile,
+    };
+
+    explicit RenderJournal(Estimator estimator = Estimator::ExponentialAverage);
 
     void add(std::chrono::nanoseconds renderTime, std::chrono::nanoseconds presentationTimestamp);
 
     std::chrono::nanoseconds result() const;
 
+    Estimator estimator() const;
+    void setEstimator(Estimator estimator);
+
+    /**
+     * The percentile used by the Percentile estimator, in the range [0, 1]. Defaults to 0.95
+     */
+    double percentile() const;
+    void setPercentile(double percentile);
+
+    /**
+     * The number of render times the Percentile estimator looks at. Defaults to 120
+     */
+    size_t windowSize() const;
+    void setWindowSize(size_t size);
+
+    size_t sampleCount() const;
+    std::chrono::nanoseconds average() const;
+    std::chrono::nanoseconds variance() const;
+    std::chrono::nanoseconds percentileRenderTime() const;
+
 private:
+    void updatePercentile();
+
+    Estimator m_estimator;
     std::chrono::nanoseconds m_result{0};
     std::chrono::nanoseconds m_variance{0};
     std::optional<std::chrono::nanoseconds> m_lastAdd;
+
+    std::vector<std::chrono::nanoseconds> m_samples;
+    std::vector<std::chrono::nanoseconds> m_sortedSamples;
+    size_t m_sampleHead = 0;
+    size_t m_windowSize = 120;
+    double m_percentile = 0.95;
+    std::chrono::nanoseconds m_percentileRenderTime{0};
 };
 
 } // namespace KWin
@@ -6,10 +6,12 @@
 
 #include "renderloop.h"
 #include "backendoutput.h"
+#include "ftrace.h"
 #include "options.h"
 #include "renderloop_p.h"
 #include "scene/surfaceitem.h"
 #include "utils/common.h"
+#include "utils/envvar.h"
 #include "window.h"
 #include "workspace.h"
 
@@ -27,10 +29,48 @@ RenderLoopPrivate *RenderLoopPrivate::get(RenderLoop *loop)
 
 static const bool s_printDebugInfo = qEnvironmentVariableIntValue("KWIN_LOG_PERFORMANCE_DATA") != 0;
 
+static RenderLoop::SchedulingPolicy defaultSchedulingPolicy()
+{
+    const QString name = qEnvironmentVariable("KWIN_FRAME_SCHEDULING_POLICY");
+    if (name.isEmpty()) {
+        return RenderLoop::SchedulingPolicy::LowLatency;
+    }
+    if (const auto policy = RenderLoop::schedulingPolicyFromString(name)) {
+        return *policy;
+    }
+    qCWarning(KWIN_CORE) << "Unknown frame scheduling policy" << name;
+    return RenderLoop::SchedulingPolicy::LowLatency;
+}
+
+static RenderJournal::Estimator renderTimeEstimator()
+{
+    if (qgetenv("KWIN_RENDER_TIME_ESTIMATOR") == "percentile") {
+        return RenderJournal::Estimator::Percentile;
+    }
+    return RenderJournal::Estimator::ExponentialAverage;
+}
+
 RenderLoopPrivate::RenderLoopPrivate(RenderLoop *q, BackendOutput *output)
     : q(q)
     , output(output)
+    , renderJournal(renderTimeEstimator())
+    , fullScreenEffectRenderJournal(renderTimeEstimator())
+    , directScanoutRenderJournal(renderTimeEstimator())
+    , schedulingPolicy(defaultSchedulingPolicy())
+{
+    if (const auto percentile = environmentVariableIntValue("KWIN_RENDER_TIME_PERCENTILE")) {
+        renderJournal.setPercentile(*percentile / 100.0);
+        fullScreenEffectRenderJournal.setPercentile(*percentile / 100.0);
+        directScanoutRenderJournal.setPercentile(*percentile / 100.0);
+    }
+}
+
+RenderJournal &RenderLoopPrivate::currentRenderJournal()
 {
+    if (fullScreenEffectActive) {
+        return fullScreenEffectRenderJournal;
+    }
+    return directScanoutActive ? directScanoutRenderJournal : renderJournal;
 }
 
 void RenderLoopPrivate::scheduleNextRepaint()
@@ -41,6 +81,24 @@ void RenderLoopPrivate::scheduleNextRepaint()
     scheduleRepaint(nextPresentationTimestamp);
 }
 
+void RenderLoopPrivate::updateParked()
+{
+    const bool parked = !compositeTimer.isActive() && !delayedVrrTimer.isActive() && !pendingFrameCount && !pendingReschedule && !preparingNewFrame;
+    if (parked == parkedSince.has_value()) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (parked) {
+        parkedSince = now;
+        if (output) {
+            fTrace("Render loop parked (", output->name(), ")");
+        }
+    } else {
+        parkedTime += now - *parkedSince;
+        parkedSince.reset();
+    }
+}
+
 void RenderLoopPrivate::scheduleRepaint(std::chrono::nanoseconds lastTargetTimestamp)
 {
     pendingReschedule = false;
@@ -49,7 +107,7 @@ void RenderLoopPrivate::scheduleRepaint(std::chrono::nanoseconds lastTargetTimes
 
     // Estimate when it's a good time to perform the next compositing cycle.
     // the 1ms on top of the safety margin is required for timer and scheduler inaccuracies
-    std::chrono::nanoseconds expectedCompositingTime = std::min(renderJournal.result() + safetyMargin + 1ms, 2 * vblankInterval);
+    std::chrono::nanoseconds expectedCompositingTime = std::min(currentRenderJournal().result() + safetyMargin + 1ms, 2 * vblankInterval);
 
     if (presentationMode == PresentationMode::VSync) {
         // normal presentation: pageflips only happen at vblank
@@ -60,28 +118,55 @@ void RenderLoopPrivate::scheduleRepaint(std::chrono::nanoseconds lastTargetTimes
             expectedCompositingTime = std::max(vblankInterval - 1us, expectedCompositingTime);
         }
         const uint64_t pageflipsSinceLastToTarget = std::max<int64_t>(std::round((lastTargetTimestamp - lastPresentationTimestamp).count() / double(vblankInterval.count())), 0);
+        if (schedulingPolicy == RenderLoop::SchedulingPolicy::PowerSaving) {
+            // start right after the previous vblank, so that the GPU can idle for the rest of the cycle
+            expectedCompositingTime = std::max(vblankInterval - 1us, expectedCompositingTime);
+        }
         uint64_t pageflipsInAdvance = std::min<int64_t>(expectedCompositingTime / vblankInterval + 1, maxPendingFrameCount);
 
-        // switching from double to triple buffering causes a frame drop
-        // -> apply some amount of hysteresis to avoid switching back and forth constantly
-        if (pageflipsInAdvance > 1) {
-            // immediately switch to triple buffering when needed
-            wasTripleBuffering = true;
-            doubleBufferingCounter = 0;
-        } else if (wasTripleBuffering) {
-            // but wait a bit before switching back to double buffering
-            if (doubleBufferingCounter >= 10) {
-                wasTripleBuffering = false;
-            } else if (expectedCompositingTime >= vblankInterval * 0.95) {
-                // also don't switch back if render times are just barely enough for double buffering
-                pageflipsInAdvance = 2;
+        switch (schedulingPolicy) {
+        case RenderLoop::SchedulingPolicy::LowLatency:
+            // switching from double to triple buffering causes a frame drop
+            // -> apply some amount of hysteresis to avoid switching back and forth constantly
+            if (pageflipsInAdvance > 1) {
+                // immediately switch to triple buffering when needed
+                wasTripleBuffering = true;
                 doubleBufferingCounter = 0;
-                expectedCompositingTime = vblankInterval;
-            } else {
-                doubleBufferingCounter++;
-                pageflipsInAdvance = 2;
-                expectedCompositingTime = vblankInterval;
+            } else if (wasTripleBuffering) {
+                // but wait a bit before switching back to double buffering
+                if (doubleBufferingCounter >= 10) {
+                    wasTripleBuffering = false;
+                } else if (expectedCompositingTime >= vblankInterval * 0.95) {
+                    // also don't switch back if render times are just barely enough for double buffering
+                    pageflipsInAdvance = 2;
+                    doubleBufferingCounter = 0;
+                    expectedCompositingTime = vblankInterval;
+                } else {
+                    doubleBufferingCounter++;
+                    pageflipsInAdvance = 2;
+                    expectedCompositingTime = vblankInterval;
+                }
             }
+            break;
+        case RenderLoop::SchedulingPolicy::PowerSaving:
+            wasTripleBuffering = pageflipsInAdvance > 1;
+            doubleBufferingCounter = 0;
+            break;
+        case RenderLoop::SchedulingPolicy::Throughput:
+            // always keep as many frames queued as possible, a slow frame then doesn't cause a drop
+            pageflipsInAdvance = maxPendingFrameCount;
+            expectedCompositingTime = std::max<std::chrono::nanoseconds>(expectedCompositingTime, (pageflipsInAdvance - 1) * vblankInterval);
+            wasTripleBuffering = pageflipsInAdvance > 1;
+            doubleBufferingCounter = 0;
+            break;
+        case RenderLoop::SchedulingPolicy::FixedCadence:
+            // every frame starts at the previous vblank, no matter how long rendering takes, so
+            // that all outputs showing the same content stay in step
+            pageflipsInAdvance = 1;
+            expectedCompositingTime = vblankInterval - 1us;
+            wasTripleBuffering = false;
+            doubleBufferingCounter = 0;
+            break;
         }
 
         if (compositeTimer.isActive()) {
@@ -108,8 +193,8 @@ void RenderLoopPrivate::scheduleRepaint(std::chrono::nanoseconds lastTargetTimes
         }
     }
 
-    const std::chrono::nanoseconds nextRenderTimestamp = nextPresentationTimestamp - expectedCompositingTime;
-    compositeTimer.start(std::max(0ms, std::chrono::duration_cast<std::chrono::milliseconds>(nextRenderTimestamp - currentTime)), Qt::PreciseTimer, q);
+    nextRenderTimestamp = std::max(nextPresentationTimestamp - expectedCompositingTime, currentTime);
+    compositeTimer.start(std::chrono::duration_cast<std::chrono::milliseconds>(nextRenderTimestamp - currentTime), Qt::PreciseTimer, q);
 }
 
 void RenderLoopPrivate::delayScheduleRepaint()
@@ -125,6 +210,7 @@ void RenderLoopPrivate::notifyFrameDropped()
     if (!inhibitCount && pendingReschedule) {
         scheduleNextRepaint();
     }
+    updateParked();
 }
 
 void RenderLoopPrivate::notifyFrameCompleted(std::chrono::nanoseconds timestamp, std::optional<RenderTimeSpan> renderTime, PresentationMode mode, OutputFrame *frame)
@@ -140,14 +226,26 @@ void RenderLoopPrivate::notifyFrameCompleted(std::chrono::nanoseconds timestamp,
         *m_debugOutput << frame->targetPageflipTime().time_since_epoch().count() << "," << timestamp.count() << "," << times.start.time_since_epoch().count() << "," << times.end.time_since_epoch().count()
                        << "," << safetyMargin.count() << "," << frame->refreshDuration().count() << "," << (vrr ? 1 : 0) << "," << (tearing ? 1 : 0) << "," << frame->predictedRenderTime().count() << "\n";
     }
+    if (output) {
+        // all timestamps are in the steady clock domain, so they can be correlated with other trace events
+        const auto times = renderTime.value_or(RenderTimeSpan{});
+        fTrace("Frame presented (", output->name(), ") pageflip=", timestamp.count(),
+               " target_pageflip=", frame->targetPageflipTime().time_since_epoch().count(),
+               " render_start=", times.start.time_since_epoch().count(),
+               " render_end=", times.end.time_since_epoch().count(),
+               " predicted_render_time=", frame->predictedRenderTime().count(),
+               " gpu_queue_delay=", times.queueDelay.count(),
+               " safety_margin=", safetyMargin.count());
+    }
 
     Q_ASSERT(pendingFrameCount > 0);
     pendingFrameCount--;
 
     notifyVblank(timestamp);
 
+    lastRenderTime = renderTime;
     if (renderTime) {
-        renderJournal.add(renderTime->end - renderTime->start, timestamp);
+        currentRenderJournal().add(renderTime->end - renderTime->start, timestamp);
     }
     if (compositeTimer.isActive()) {
         // reschedule to match the new timestamp and render time
@@ -156,6 +254,7 @@ void RenderLoopPrivate::notifyFrameCompleted(std::chrono::nanoseconds timestamp,
     if (!inhibitCount && pendingReschedule) {
         scheduleNextRepaint();
     }
+    updateParked();
 
     Q_EMIT q->framePresented(q, timestamp, mode);
 }
@@ -177,7 +276,10 @@ void RenderLoop::timerEvent(QTimerEvent *event)
 {
     if (event->timerId() == d->compositeTimer.timerId()) {
         d->compositeTimer.stop();
+        d->reportDispatchDelay();
         d->dispatch();
+        // the compositor may have decided that there's nothing to paint
+        d->updateParked();
     } else if (event->timerId() == d->delayedVrrTimer.timerId()) {
         d->delayedVrrTimer.stop();
         scheduleRepaint(nullptr, nullptr);
@@ -186,6 +288,25 @@ void RenderLoop::timerEvent(QTimerEvent *event)
     }
 }
 
+void RenderLoopPrivate::reportDispatchDelay()
+{
+    if (!output) {
+        return;
+    }
+    // the timer has millisecond precision, only delays beyond that are worth reporting
+    const std::chrono::nanoseconds delay = std::chrono::steady_clock::now().time_since_epoch() - nextRenderTimestamp;
+    if (delay < 2ms) {
+        return;
+    }
+    fTrace("Frame dispatch delayed (", output->name(), ") delay=", delay.count());
+    const std::chrono::nanoseconds vblankInterval(1'000'000'000'000ull / refreshRate);
+    if (delay > vblankInterval / 2) {
+        qCDebug(KWIN_CORE) << "Compositing on" << output->name() << "started"
+                           << std::chrono::duration_cast<std::chrono::microseconds>(delay)
+                           << "late, the main thread was busy with something else";
+    }
+}
+
 void RenderLoopPrivate::dispatch()
 {
     Q_EMIT q->frameRequested(q);
@@ -206,6 +327,7 @@ void RenderLoop::inhibit()
 
     if (d->inhibitCount == 1) {
         d->compositeTimer.stop();
+        d->updateParked();
     }
 }
 
@@ -216,6 +338,7 @@ void RenderLoop::uninhibit()
 
     if (d->inhibitCount == 0) {
         d->scheduleNextRepaint();
+        d->updateParked();
     }
 }
 
@@ -228,6 +351,7 @@ void RenderLoop::prepareNewFrame()
 void RenderLoop::newFramePrepared()
 {
     d->preparingNewFrame = false;
+    d->updateParked();
 }
 
 int RenderLoop::refreshRate() const
@@ -253,15 +377,23 @@ void RenderLoop::setPresentationSafetyMargin(std::chrono::nanoseconds safetyMarg
     d->safetyMargin = safetyMargin;
 }
 
+static bool belongsTo(Window *window, Item *item)
+{
+    SurfaceItem *const surfaceItem = window ? window->surfaceItem() : nullptr;
+    return surfaceItem && item && (item == surfaceItem || surfaceItem->isAncestorOf(item));
+}
+
 void RenderLoop::scheduleRepaint(Item *item, OutputLayer *outputLayer)
 {
     const bool vrr = d->presentationMode == PresentationMode::AdaptiveSync || d->presentationMode == PresentationMode::AdaptiveAsync;
     const bool tearing = d->presentationMode == PresentationMode::Async || d->presentationMode == PresentationMode::AdaptiveAsync;
-    if ((vrr || tearing) && workspace() && workspace()->activeWindow() && d->output) {
-        SurfaceItem *const surfaceItem = workspace()->activeWindow()->surfaceItem();
-        if ((item || outputLayer) && activeWindowControlsVrrRefreshRate() && item != surfaceItem && !surfaceItem->isAncestorOf(item)) {
+    if ((vrr || tearing) && (item || outputLayer) && workspace() && d->output) {
+        // the active window is never slowed down, even if some other window controls the refresh rate
+        Window *const controller = vrrRefreshRateController();
+        if (controller && !belongsTo(controller, item) && !belongsTo(workspace()->activeWindow(), item)) {
             constexpr std::chrono::milliseconds s_delayVrrTimer = 1'000ms / 30;
             d->delayedVrrTimer.start(s_delayVrrTimer, Qt::PreciseTimer, this);
+            d->updateParked();
             return;
         }
     }
@@ -272,21 +404,42 @@ void RenderLoop::scheduleRepaint(Item *item, OutputLayer *outputLayer)
     } else {
         d->delayScheduleRepaint();
     }
+    d->updateParked();
 }
 
-bool RenderLoop::activeWindowControlsVrrRefreshRate() const
+Window *RenderLoop::vrrRefreshRateController() const
 {
-    Window *const activeWindow = workspace()->activeWindow();
     LogicalOutput *logical = workspace()->findOutput(d->output);
     if (!logical) {
-        return false;
+        return nullptr;
+    }
+    const auto controls = [logical](Window *window) {
+        return window
+            && window->frameGeometry().intersects(logical->geometryF())
+            && window->surfaceItem()
+            && window->surfaceItem()->recursiveFrameTimeEstimation().transform([](const auto t) {
+            return t <= std::chrono::nanoseconds(1'000'000'000) / 30;
+        }).value_or(false);
+    };
+
+    Window *const activeWindow = workspace()->activeWindow();
+    if (controls(activeWindow)) {
+        return activeWindow;
     }
-    return activeWindow
-        && activeWindow->frameGeometry().intersects(logical->geometryF())
-        && activeWindow->surfaceItem()
-        && activeWindow->surfaceItem()->recursiveFrameTimeEstimation().transform([](const auto t) {
-        return t <= std::chrono::nanoseconds(1'000'000'000) / 30;
-    }).value_or(false);
+    // otherwise let visible content that has a cadence of its own drive the refresh rate,
+    // e.g. a video that plays in a window next to the one the user is working in
+    const QList<Window *> &stackingOrder = workspace()->stackingOrder();
+    for (auto it = stackingOrder.crbegin(); it != stackingOrder.crend(); ++it) {
+        Window *const window = *it;
+        if (!window->isShown() || !window->isOnCurrentDesktop() || !window->surfaceItem()) {
+            continue;
+        }
+        const ContentType contentType = window->surfaceItem()->contentType();
+        if ((contentType == ContentType::Video || contentType == ContentType::Game) && controls(window)) {
+            return window;
+        }
+    }
+    return nullptr;
 }
 
 std::chrono::nanoseconds RenderLoop::lastPresentationTimestamp() const
@@ -312,9 +465,72 @@ void RenderLoop::setMaxPendingFrameCount(uint32_t maxCount)
     d->maxPendingFrameCount = maxCount;
 }
 
+RenderLoop::SchedulingPolicy RenderLoop::schedulingPolicy() const
+{
+    return d->schedulingPolicy;
+}
+
+void RenderLoop::setSchedulingPolicy(SchedulingPolicy policy)
+{
+    if (d->schedulingPolicy == policy) {
+        return;
+    }
+    qCDebug(KWIN_CORE) << "Changed frame scheduling policy to" << policy;
+    d->schedulingPolicy = policy;
+    d->wasTripleBuffering = false;
+    d->doubleBufferingCounter = 0;
+}
+
+std::optional<RenderLoop::SchedulingPolicy> RenderLoop::schedulingPolicyFromString(QStringView name)
+{
+    if (name == QLatin1String("lowlatency")) {
+        return SchedulingPolicy::LowLatency;
+    } else if (name == QLatin1String("powersaving")) {
+        return SchedulingPolicy::PowerSaving;
+    } else if (name == QLatin1String("throughput")) {
+        return SchedulingPolicy::Throughput;
+    } else if (name == QLatin1String("fixedcadence")) {
+        return SchedulingPolicy::FixedCadence;
+    }
+    return std::nullopt;
+}
+
 std::chrono::nanoseconds RenderLoop::predictedRenderTime() const
 {
-    return d->renderJournal.result();
+    return d->currentRenderJournal().result();
+}
+
+void RenderLoop::setFullScreenEffectActive(bool active)
+{
+    d->fullScreenEffectActive = active;
+}
+
+bool RenderLoop::isFullScreenEffectActive() const
+{
+    return d->fullScreenEffectActive;
+}
+
+void RenderLoop::setDirectScanoutActive(bool active)
+{
+    d->directScanoutActive = active;
+}
+
+bool RenderLoop::isDirectScanoutActive() const
+{
+    return d->directScanoutActive;
+}
+
+bool RenderLoop::isParked() const
+{
+    return d->parkedSince.has_value();
+}
+
+std::chrono::nanoseconds RenderLoop::parkedTime() const
+{
+    if (d->parkedSince) {
+        return d->parkedTime + (std::chrono::steady_clock::now() - *d->parkedSince);
+    }
+    return d->parkedTime;
 }
 
 } // namespace KWin
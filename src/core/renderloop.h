@@ -10,6 +10,8 @@
 
 #include <QObject>
 
+#include <optional>
+
 namespace KWin
 {
 
@@ -18,6 +20,7 @@ class SurfaceItem;
 class Item;
 class BackendOutput;
 class OutputLayer;
+class Window;
 
 /**
  * The RenderLoop class represents the compositing scheduler on a particular output.
@@ -95,14 +98,67 @@ public:
 
     void setMaxPendingFrameCount(uint32_t maxCount);
 
+    /**
+     * The SchedulingPolicy type specifies when the render loop starts compositing a frame
+     * that is presented with vsync. Adaptive sync and tearing aren't affected.
+     */
+    enum class SchedulingPolicy {
+        LowLatency, ///< As late as the predicted render time allows, this is the default
+        PowerSaving, ///< Right after the previous vblank, the GPU can idle for the rest of the refresh cycle
+        Throughput, ///< As many frames ahead as the output allows, at the cost of latency
+        FixedCadence, ///< At the same point of every refresh cycle, regardless of render times
+    };
+    Q_ENUM(SchedulingPolicy)
+
+    SchedulingPolicy schedulingPolicy() const;
+    void setSchedulingPolicy(SchedulingPolicy policy);
+
+    /**
+     * Returns the policy called @p name, which is its enumerator in lower case, or
+     * @c std::nullopt if there is no such policy. The default policy can be set with the
+     * KWIN_FRAME_SCHEDULING_POLICY environment variable.
+     */
+    static std::optional<SchedulingPolicy> schedulingPolicyFromString(QStringView name);
+
     /**
      * Returns the expected time how long it is going to take to render the next frame.
      */
     std::chrono::nanoseconds predictedRenderTime() const;
 
+    /**
+     * Sets whether a full screen effect is active on this output. Render times are tracked
+     * separately for both states, because such effects usually change them drastically.
+     */
+    void setFullScreenEffectActive(bool active);
+    bool isFullScreenEffectActive() const;
+
+    /**
+     * Sets whether the last frame only scanned out a client buffer on the primary layer. The
+     * render times of such frames are tracked separately as well, so that compositing starts
+     * as late as possible while a fullscreen client is scanned out directly.
+     */
+    void setDirectScanoutActive(bool active);
+    bool isDirectScanoutActive() const;
+
+    /**
+     * Returns @c true if no frame and no repaint is pending. A parked render loop doesn't
+     * wake up the compositor until a repaint is scheduled.
+     */
+    bool isParked() const;
+    /**
+     * Returns the total time the render loop has spent in the parked state.
+     */
+    std::chrono::nanoseconds parkedTime() const;
+
     // TODO integrate cursor updates into the render loop / frame scheduling somehow?
     // and then remove this again
-    bool activeWindowControlsVrrRefreshRate() const;
+    /**
+     * Returns the window whose content drives the refresh rate of the output with adaptive
+     * sync or tearing, or @c null if there's none. This is the active window if it updates
+     * at least 30 times per second, otherwise a visible video or game that does. Repaints
+     * of other windows, except the active one, are delayed to keep the refresh rate low.
+     */
+    Window *vrrRefreshRateController() const;
 
     void timerEvent(QTimerEvent *event) override;
 
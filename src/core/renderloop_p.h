@@ -28,6 +28,7 @@ public:
     explicit RenderLoopPrivate(RenderLoop *q, BackendOutput *output);
 
     void dispatch();
+    void reportDispatchDelay();
 
     void delayScheduleRepaint();
     void scheduleNextRepaint();
@@ -37,6 +38,14 @@ public:
     void notifyFrameCompleted(std::chrono::nanoseconds timestamp, std::optional<RenderTimeSpan> renderTime, PresentationMode mode, OutputFrame *frame);
     void notifyVblank(std::chrono::nanoseconds timestamp);
 
+    /**
+     * Moves the loop in or out of the parked state, in which neither a frame nor a repaint
+     * is pending, so the loop causes no wakeups at all until a repaint is scheduled.
+     */
+    void updateParked();
+
+    RenderJournal &currentRenderJournal();
+
     RenderLoop *const q;
     BackendOutput *const output;
     std::optional<std::fstream> m_debugOutput;
@@ -45,18 +54,35 @@ public:
     bool wasTripleBuffering = false;
     int doubleBufferingCounter = 0;
     QBasicTimer compositeTimer;
+    // when compositeTimer is supposed to fire, to find out how long
+    // the main thread kept the frame waiting
+    std::chrono::nanoseconds nextRenderTimestamp = std::chrono::nanoseconds::zero();
     RenderJournal renderJournal;
+    // the render time of the last presented frame, if the backend could measure it
+    std::optional<RenderTimeSpan> lastRenderTime;
+    // render times while a full screen effect is active are kept separately, so that
+    // the estimate is already good when such an effect starts
+    RenderJournal fullScreenEffectRenderJournal;
+    bool fullScreenEffectActive = false;
+    // frames that only scan out a client buffer take a fraction of the time of composited
+    // ones, mixing both would make compositing start too early after switching
+    RenderJournal directScanoutRenderJournal;
+    bool directScanoutActive = false;
     int refreshRate = 60000;
     int pendingFrameCount = 0;
     bool preparingNewFrame = false;
     int inhibitCount = 0;
     bool pendingReschedule = false;
     std::chrono::nanoseconds safetyMargin{0};
+    RenderLoop::SchedulingPolicy schedulingPolicy;
 
     PresentationMode presentationMode = PresentationMode::VSync;
     int maxPendingFrameCount = 1;
 
     QBasicTimer delayedVrrTimer;
+
+    std::optional<std::chrono::steady_clock::time_point> parkedSince = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds parkedTime{0};
 };
 
 } // namespace KWin
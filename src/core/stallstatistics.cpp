@@ -0,0 +1,87 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "core/stallstatistics.h"
+#include "utils/common.h"
+#include "utils/envvar.h"
+
+#include <array>
+
+namespace KWin
+{
+
+static constexpr std::array s_sources{
+    std::pair(StallSource::WaylandDispatch, QLatin1StringView("waylandDispatch")),
+    std::pair(StallSource::X11Events, QLatin1StringView("x11Events")),
+    std::pair(StallSource::Scripting, QLatin1StringView("scripting")),
+    std::pair(StallSource::Effects, QLatin1StringView("effects")),
+    std::pair(StallSource::Rendering, QLatin1StringView("rendering")),
+};
+
+struct Stalls
+{
+    uint64_t count = 0;
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds longest{0};
+};
+
+static std::array<Stalls, s_sources.size()> s_stalls;
+static StallStatistics::Scope *s_currentScope = nullptr;
+
+StallStatistics::Scope::Scope(StallSource source)
+    : m_source(source)
+    , m_start(std::chrono::steady_clock::now())
+    , m_parent(s_currentScope)
+{
+    s_currentScope = this;
+}
+
+StallStatistics::Scope::~Scope()
+{
+    s_currentScope = m_parent;
+
+    const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - m_start;
+    if (m_parent) {
+        m_parent->m_nested += elapsed;
+    }
+
+    const std::chrono::nanoseconds duration = elapsed - m_nested;
+    if (duration < threshold()) {
+        return;
+    }
+    Stalls &stalls = s_stalls[size_t(m_source)];
+    stalls.count++;
+    stalls.total += duration;
+    stalls.longest = std::max(stalls.longest, duration);
+    qCDebug(KWIN_CORE) << "The main thread was blocked in" << s_sources[size_t(m_source)].second << "for" << std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+}
+
+std::chrono::nanoseconds StallStatistics::threshold()
+{
+    static const std::chrono::nanoseconds threshold = std::chrono::milliseconds(environmentVariableIntValue("KWIN_STALL_THRESHOLD").value_or(16));
+    return threshold;
+}
+
+QVariantMap StallStatistics::statistics()
+{
+    const auto toMicroseconds = [](std::chrono::nanoseconds duration) {
+        return double(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    };
+
+    QVariantMap ret;
+    for (const auto &[source, name] : s_sources) {
+        const Stalls &stalls = s_stalls[size_t(source)];
+        ret[name] = QVariantMap{
+            {QStringLiteral("count"), qulonglong(stalls.count)},
+            {QStringLiteral("total"), toMicroseconds(stalls.total)},
+            {QStringLiteral("longest"), toMicroseconds(stalls.longest)},
+        };
+    }
+    ret[QStringLiteral("threshold")] = toMicroseconds(threshold());
+    return ret;
+}
+
+} // namespace KWin
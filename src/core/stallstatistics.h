@@ -0,0 +1,69 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "kwin_export.h"
+
+#include <QVariantMap>
+
+#include <chrono>
+
+namespace KWin
+{
+
+/**
+ * The StallSource type specifies which part of the compositor blocked the main thread.
+ */
+enum class StallSource {
+    WaylandDispatch, ///< Requests of Wayland clients
+    X11Events, ///< Events from the X server
+    Scripting, ///< KWin scripts
+    Effects, ///< Effects painting the screen
+    Rendering, ///< The scene, when it's painted on behalf of the effects
+};
+
+/**
+ * The StallStatistics class keeps track of the times the main thread was busy for longer
+ * than a frame. The work is attributed to the innermost StallStatistics::Scope it happened
+ * in, time spent in nested scopes is subtracted from the enclosing ones.
+ */
+class KWIN_EXPORT StallStatistics
+{
+public:
+    /**
+     * Measures the time the main thread spends between the construction and the destruction
+     * of the scope. Scopes must only be used on the main thread.
+     */
+    class KWIN_EXPORT Scope
+    {
+    public:
+        explicit Scope(StallSource source);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        const StallSource m_source;
+        const std::chrono::steady_clock::time_point m_start;
+        std::chrono::nanoseconds m_nested{0};
+        Scope *m_parent;
+    };
+
+    /**
+     * Returns how long a scope can run before it's counted as a stall. It can be set with
+     * the KWIN_STALL_THRESHOLD environment variable, in milliseconds.
+     */
+    static std::chrono::nanoseconds threshold();
+
+    /**
+     * Returns the number, total and longest duration of the stalls per source.
+     */
+    static QVariantMap statistics();
+};
+
+} // namespace KWin
@@ -5,7 +5,14 @@
 */
 #include "syncobjtimeline.h"
 
+#include <QCoreApplication>
+#include <QThread>
+
+#include <algorithm>
 #include <cerrno>
+#include <tuple>
+#include <utility>
+#include <vector>
 #include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <xf86drm.h>
@@ -39,7 +46,7 @@ SyncReleasePoint::~SyncReleasePoint()
     if (m_releaseFence.isValid()) {
         m_timeline->moveInto(m_timelinePoint, m_releaseFence);
     } else {
-        m_timeline->signal(m_timelinePoint);
+        SyncTimeline::scheduleSignal(m_timeline, m_timelinePoint);
     }
 }
 
@@ -126,6 +133,53 @@ void SyncTimeline::signal(uint64_t timelinePoint)
     drmSyncobjTimelineSignal(m_drmFd, &m_handle, &timelinePoint, 1);
 }
 
+struct ScheduledSignal
+{
+    std::shared_ptr<SyncTimeline> timeline;
+    uint64_t timelinePoint;
+};
+
+// only accessed from the main thread
+static std::vector<ScheduledSignal> s_scheduledSignals;
+
+void SyncTimeline::scheduleSignal(const std::shared_ptr<SyncTimeline> &timeline, uint64_t timelinePoint)
+{
+    QCoreApplication *application = QCoreApplication::instance();
+    if (!application || QThread::currentThread() != application->thread()) {
+        timeline->signal(timelinePoint);
+        return;
+    }
+    if (s_scheduledSignals.empty()) {
+        QMetaObject::invokeMethod(application, &SyncTimeline::signalScheduled, Qt::QueuedConnection);
+    }
+    s_scheduledSignals.push_back(ScheduledSignal{
+        .timeline = timeline,
+        .timelinePoint = timelinePoint,
+    });
+}
+
+void SyncTimeline::signalScheduled()
+{
+    std::vector<ScheduledSignal> scheduled = std::exchange(s_scheduledSignals, {});
+    // the points of one timeline have to be added in ascending order
+    std::ranges::sort(scheduled, {}, [](const ScheduledSignal &entry) {
+        return std::make_tuple(entry.timeline->m_drmFd, entry.timeline->m_handle, entry.timelinePoint);
+    });
+
+    std::vector<uint32_t> handles;
+    std::vector<uint64_t> points;
+    for (auto it = scheduled.begin(); it != scheduled.end();) {
+        const int32_t drmFd = it->timeline->m_drmFd;
+        handles.clear();
+        points.clear();
+        for (; it != scheduled.end() && it->timeline->m_drmFd == drmFd; ++it) {
+            handles.push_back(it->timeline->m_handle);
+            points.push_back(it->timelinePoint);
+        }
+        drmSyncobjTimelineSignal(drmFd, handles.data(), points.data(), handles.size());
+    }
+}
+
 void SyncTimeline::moveInto(uint64_t timelinePoint, const FileDescriptor &fd)
 {
     uint32_t tempHandle = 0;
@@ -53,11 +53,18 @@ public:
 
     const FileDescriptor &fileDescriptor();
     void signal(uint64_t timelinePoint);
+    /**
+     * Signals @p timelinePoint of @p timeline once control returns to the event loop. All
+     * points scheduled in the meantime are signaled with one ioctl per DRM device.
+     */
+    static void scheduleSignal(const std::shared_ptr<SyncTimeline> &timeline, uint64_t timelinePoint);
     void moveInto(uint64_t timelinePoint, const FileDescriptor &fd);
     FileDescriptor exportSyncFile(uint64_t timelinePoint);
     bool isMaterialized(uint64_t timelinePoint);
 
 private:
+    static void signalScheduled();
+
     const int32_t m_drmFd;
     uint32_t m_handle = 0;
     FileDescriptor m_fileDescriptor;
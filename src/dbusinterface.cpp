@@ -15,14 +15,23 @@
 
 // kwin
 #include "compositor.h"
+#include "core/backendoutput.h"
+#include "core/gpumemorystatistics.h"
 #include "core/output.h"
+#include "core/outputbackend.h"
 #include "core/renderbackend.h"
+#include "core/renderloop.h"
+#include "core/renderloop_p.h"
+#include "core/stallstatistics.h"
 #include "debug_console.h"
 #include "kwinadaptor.h"
 #include "main.h"
 #include "placement.h"
 #include "pluginmanager.h"
 #include "virtualdesktops.h"
+#include "wayland/display.h"
+#include "wayland/inputlatency.h"
+#include "wayland_server.h"
 #include "window.h"
 #include "workspace.h"
 #if KWIN_BUILD_ACTIVITIES
@@ -31,6 +40,7 @@
 
 // Qt
 #include <QDBusConnection>
+#include <QMetaEnum>
 #include <QOpenGLContext>
 
 namespace KWin
@@ -287,6 +297,96 @@ QStringList CompositorDBusInterface::supportedOpenGLPlatformInterfaces() const
     return {QStringLiteral("egl")};
 }
 
+static QVariantMap renderJournalStatistics(const RenderJournal &journal)
+{
+    const auto toMicroseconds = [](std::chrono::nanoseconds duration) {
+        return double(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    };
+    return QVariantMap{
+        {QStringLiteral("average"), toMicroseconds(journal.average())},
+        {QStringLiteral("deviation"), toMicroseconds(journal.variance())},
+        {QStringLiteral("percentile"), journal.percentile()},
+        {QStringLiteral("percentileRenderTime"), toMicroseconds(journal.percentileRenderTime())},
+        {QStringLiteral("estimate"), toMicroseconds(journal.result())},
+        {QStringLiteral("sampleCount"), qulonglong(journal.sampleCount())},
+    };
+}
+
+QVariantMap CompositorDBusInterface::renderTimeStatistics() const
+{
+    QVariantMap ret;
+    const auto outputs = kwinApp()->outputBackend()->outputs();
+    for (BackendOutput *output : outputs) {
+        RenderLoop *renderLoop = output->renderLoop();
+        if (!renderLoop) {
+            continue;
+        }
+        const RenderLoopPrivate *renderLoopPrivate = RenderLoopPrivate::get(renderLoop);
+        const bool percentile = renderLoopPrivate->renderJournal.estimator() == RenderJournal::Estimator::Percentile;
+        ret[output->name()] = QVariantMap{
+            {QStringLiteral("estimator"), percentile ? QStringLiteral("percentile") : QStringLiteral("exponentialAverage")},
+            {QStringLiteral("predictedRenderTime"), double(std::chrono::duration_cast<std::chrono::microseconds>(renderLoop->predictedRenderTime()).count())},
+            {QStringLiteral("fullScreenEffectActive"), renderLoop->isFullScreenEffectActive()},
+            {QStringLiteral("schedulingPolicy"), QString::fromLatin1(QMetaEnum::fromType<RenderLoop::SchedulingPolicy>().valueToKey(int(renderLoop->schedulingPolicy()))).toLower()},
+            {QStringLiteral("parked"), renderLoop->isParked()},
+            {QStringLiteral("parkedTime"), double(std::chrono::duration_cast<std::chrono::microseconds>(renderLoop->parkedTime()).count())},
+            {QStringLiteral("normal"), renderJournalStatistics(renderLoopPrivate->renderJournal)},
+            {QStringLiteral("fullScreenEffect"), renderJournalStatistics(renderLoopPrivate->fullScreenEffectRenderJournal)},
+            {QStringLiteral("directScanoutActive"), renderLoop->isDirectScanoutActive()},
+            {QStringLiteral("directScanout"), renderJournalStatistics(renderLoopPrivate->directScanoutRenderJournal)},
+            {QStringLiteral("scanout"), m_compositor->scanoutStatistics(renderLoop)},
+        };
+    }
+    return ret;
+}
+
+QVariantMap CompositorDBusInterface::presentationStatistics() const
+{
+    QVariantMap ret;
+    const auto outputs = kwinApp()->outputBackend()->outputs();
+    for (BackendOutput *output : outputs) {
+        const QVariantMap statistics = output->presentationStatistics();
+        if (!statistics.isEmpty()) {
+            ret[output->name()] = statistics;
+        }
+    }
+    return ret;
+}
+
+QVariantMap CompositorDBusInterface::inputLatencyStatistics() const
+{
+    return waylandServer()->display()->inputLatencyTracker()->statistics();
+}
+
+QVariantMap CompositorDBusInterface::clientStatistics() const
+{
+    return waylandServer()->display()->clientStatistics();
+}
+
+QVariantMap CompositorDBusInterface::gpuMemoryStatistics() const
+{
+    return GpuMemoryStatistics::statistics();
+}
+
+QVariantMap CompositorDBusInterface::stallStatistics() const
+{
+    return StallStatistics::statistics();
+}
+
+bool CompositorDBusInterface::setFrameSchedulingPolicy(const QString &outputName, const QString &policy)
+{
+    const auto schedulingPolicy = RenderLoop::schedulingPolicyFromString(policy);
+    if (!schedulingPolicy) {
+        return false;
+    }
+    BackendOutput *output = kwinApp()->outputBackend()->findOutput(outputName);
+    if (!output || !output->renderLoop()) {
+        return false;
+    }
+    output->renderLoop()->setSchedulingPolicy(*schedulingPolicy);
+    return true;
+}
+
 VirtualDesktopManagerDBusInterface::VirtualDesktopManagerDBusInterface(VirtualDesktopManager *parent)
     : QObject(parent)
     , m_manager(parent)
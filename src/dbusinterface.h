@@ -165,6 +165,65 @@ public Q_SLOTS:
      */
     void reinitialize();
 
+    /**
+     * @brief Statistics of the render time estimation, per output.
+     *
+     * Maps the output name to a map with the used estimator, the predicted render time and,
+     * for normal rendering, rendering with a full screen effect and direct scanout, the average,
+     * deviation, percentile and number of samples. It also says which scheduling policy is
+     * used, whether the render loop is parked, and how long it has been parked in total.
+     * Durations are in microseconds.
+     *
+     * @see Compositor::scanoutStatistics
+     */
+    QVariantMap renderTimeStatistics() const;
+
+    /**
+     * @brief Backend specific presentation statistics, per output.
+     *
+     * @see BackendOutput::presentationStatistics
+     */
+    QVariantMap presentationStatistics() const;
+
+    /**
+     * @brief Histograms of the input-to-photon latency, per client executable.
+     *
+     * @see InputLatencyTracker::statistics
+     */
+    QVariantMap inputLatencyStatistics() const;
+
+    /**
+     * @brief Counters of the work that every connected client causes in the compositor.
+     *
+     * @see Display::clientStatistics
+     */
+    QVariantMap clientStatistics() const;
+
+    /**
+     * @brief Estimated graphics memory that the compositor holds, per category, in bytes.
+     *
+     * @see GpuMemoryStatistics::statistics
+     */
+    QVariantMap gpuMemoryStatistics() const;
+
+    /**
+     * @brief The times the main thread was blocked for longer than a frame, per subsystem.
+     *
+     * @see StallStatistics::statistics
+     */
+    QVariantMap stallStatistics() const;
+
+    /**
+     * @brief Sets when the render loop of the output called @p outputName starts compositing.
+     *
+     * The @p policy is one of "lowlatency", "powersaving", "throughput" and "fixedcadence".
+     * The policy isn't saved, it applies until the output is removed or KWin restarts.
+     *
+     * @returns @c false if there's no such output or policy
+     * @see RenderLoop::SchedulingPolicy
+     */
+    bool setFrameSchedulingPolicy(const QString &outputName, const QString &policy);
+
 Q_SIGNALS:
     void compositingToggled(bool active);
 
@@ -8,7 +8,9 @@
 */
 #include "debug_console.h"
 #include "compositor.h"
+#include "core/backendoutput.h"
 #include "core/inputdevice.h"
+#include "core/outputbackend.h"
 #include "effect/effecthandler.h"
 #include "input_event.h"
 #include "internalwindow.h"
@@ -54,7 +56,10 @@
 #include <QPixmap>
 #include <QPushButton>
 #include <QScopeGuard>
+#include <QSet>
 #include <QSortFilterProxyModel>
+#include <QTextDocument>
+#include <QTextEdit>
 #include <QWindow>
 #include <QtConcurrentRun>
 
@@ -177,14 +182,43 @@ static const QString s_hr = QStringLiteral("<hr/>");
 static const QString s_tableStart = QStringLiteral("<table>");
 static const QString s_tableEnd = QStringLiteral("</table>");
 
+// how many events are kept, older ones are dropped from the view
+static const int s_maxEvents = 500;
+
 DebugConsoleFilter::DebugConsoleFilter(QTextEdit *textEdit)
     : InputEventSpy()
     , m_textEdit(textEdit)
 {
+    // every event is a table with a block per cell, keep roughly the last s_maxEvents events
+    m_textEdit->document()->setMaximumBlockCount(s_maxEvents * 10);
+
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(100);
+    QObject::connect(&m_flushTimer, &QTimer::timeout, &m_flushTimer, [this]() {
+        flush();
+    });
 }
 
 DebugConsoleFilter::~DebugConsoleFilter() = default;
 
+void DebugConsoleFilter::append(const QString &html)
+{
+    m_pending.append(html);
+    if (m_pending.size() > s_maxEvents) {
+        m_pending.removeFirst();
+    }
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void DebugConsoleFilter::flush()
+{
+    m_textEdit->insertHtml(m_pending.join(QString()));
+    m_textEdit->ensureCursorVisible();
+    m_pending.clear();
+}
+
 void DebugConsoleFilter::pointerMotion(PointerMotionEvent *event)
 {
     QString text = s_hr;
@@ -206,8 +240,7 @@ void DebugConsoleFilter::pointerMotion(PointerMotionEvent *event)
     text.append(tableRow(i18nc("The global mouse pointer position", "Global Position"), QStringLiteral("%1/%2").arg(event->position.x()).arg(event->position.y())));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::pointerButton(PointerButtonEvent *event)
@@ -233,8 +266,7 @@ void DebugConsoleFilter::pointerButton(PointerButtonEvent *event)
     }
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::pointerAxis(PointerAxisEvent *event)
@@ -251,8 +283,7 @@ void DebugConsoleFilter::pointerAxis(PointerAxisEvent *event)
     text.append(tableRow(i18nc("The normalized V120 angle delta of a pointer axis event. V120 is a technical term and shouldn't be changed.", "Delta (V120)"), event->deltaV120));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::keyboardKey(KeyboardKeyEvent *event)
@@ -313,8 +344,7 @@ void DebugConsoleFilter::keyboardKey(KeyboardKeyEvent *event)
 
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::touchDown(TouchDownEvent *event)
@@ -328,8 +358,7 @@ void DebugConsoleFilter::touchDown(TouchDownEvent *event)
                          QStringLiteral("%1/%2").arg(event->pos.x()).arg(event->pos.y())));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::touchMotion(TouchMotionEvent *event)
@@ -343,8 +372,7 @@ void DebugConsoleFilter::touchMotion(TouchMotionEvent *event)
                          QStringLiteral("%1/%2").arg(event->pos.x()).arg(event->pos.y())));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::touchUp(TouchUpEvent *event)
@@ -356,8 +384,7 @@ void DebugConsoleFilter::touchUp(TouchUpEvent *event)
     text.append(tableRow(i18nc("The id of the touch point in the touch event", "Point identifier"), event->id));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::pinchGestureBegin(PointerPinchGestureBeginEvent *event)
@@ -369,8 +396,7 @@ void DebugConsoleFilter::pinchGestureBegin(PointerPinchGestureBeginEvent *event)
     text.append(tableRow(i18nc("Number of fingers in this pinch gesture", "Finger count"), event->fingerCount));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::pinchGestureUpdate(PointerPinchGestureUpdateEvent *event)
@@ -385,8 +411,7 @@ void DebugConsoleFilter::pinchGestureUpdate(PointerPinchGestureUpdateEvent *even
     text.append(tableRow(i18nc("Current delta in pinch gesture", "Delta y"), event->delta.y()));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::pinchGestureEnd(PointerPinchGestureEndEvent *event)
@@ -397,8 +422,7 @@ void DebugConsoleFilter::pinchGestureEnd(PointerPinchGestureEndEvent *event)
     text.append(timestampRow(event->time));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::pinchGestureCancelled(PointerPinchGestureCancelEvent *event)
@@ -409,8 +433,7 @@ void DebugConsoleFilter::pinchGestureCancelled(PointerPinchGestureCancelEvent *e
     text.append(timestampRow(event->time));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::swipeGestureBegin(PointerSwipeGestureBeginEvent *event)
@@ -422,8 +445,7 @@ void DebugConsoleFilter::swipeGestureBegin(PointerSwipeGestureBeginEvent *event)
     text.append(tableRow(i18nc("Number of fingers in this swipe gesture", "Finger count"), event->fingerCount));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::swipeGestureUpdate(PointerSwipeGestureUpdateEvent *event)
@@ -436,8 +458,7 @@ void DebugConsoleFilter::swipeGestureUpdate(PointerSwipeGestureUpdateEvent *even
     text.append(tableRow(i18nc("Current delta in swipe gesture", "Delta y"), event->delta.y()));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::swipeGestureEnd(PointerSwipeGestureEndEvent *event)
@@ -448,8 +469,7 @@ void DebugConsoleFilter::swipeGestureEnd(PointerSwipeGestureEndEvent *event)
     text.append(timestampRow(event->time));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::swipeGestureCancelled(PointerSwipeGestureCancelEvent *event)
@@ -460,8 +480,7 @@ void DebugConsoleFilter::swipeGestureCancelled(PointerSwipeGestureCancelEvent *e
     text.append(timestampRow(event->time));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::holdGestureBegin(PointerHoldGestureBeginEvent *event)
@@ -473,8 +492,7 @@ void DebugConsoleFilter::holdGestureBegin(PointerHoldGestureBeginEvent *event)
     text.append(tableRow(i18nc("Number of fingers in this hold gesture", "Finger count"), event->fingerCount));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::holdGestureEnd(PointerHoldGestureEndEvent *event)
@@ -485,8 +503,7 @@ void DebugConsoleFilter::holdGestureEnd(PointerHoldGestureEndEvent *event)
     text.append(timestampRow(event->time));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::holdGestureCancelled(PointerHoldGestureCancelEvent *event)
@@ -497,8 +514,7 @@ void DebugConsoleFilter::holdGestureCancelled(PointerHoldGestureCancelEvent *eve
     text.append(timestampRow(event->time));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::switchEvent(SwitchEvent *event)
@@ -530,8 +546,7 @@ void DebugConsoleFilter::switchEvent(SwitchEvent *event)
     text.append(tableRow(i18nc("State of a hardware switch (on/off)", "State"), switchState));
     text.append(s_tableEnd);
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::tabletToolProximityEvent(TabletToolProximityEvent *event)
@@ -549,8 +564,7 @@ void DebugConsoleFilter::tabletToolProximityEvent(TabletToolProximityEvent *even
         + tableRow(i18n("Distance"), QString::number(event->distance))
         + s_tableEnd;
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::tabletToolAxisEvent(TabletToolAxisEvent *event)
@@ -568,8 +582,7 @@ void DebugConsoleFilter::tabletToolAxisEvent(TabletToolAxisEvent *event)
         + tableRow(i18n("Distance"), QString::number(event->distance))
         + s_tableEnd;
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::tabletToolTipEvent(TabletToolTipEvent *event)
@@ -588,8 +601,7 @@ void DebugConsoleFilter::tabletToolTipEvent(TabletToolTipEvent *event)
         + tableRow(i18n("Slider Position"), QString::number(event->sliderPosition))
         + s_tableEnd;
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::tabletToolButtonEvent(TabletToolButtonEvent *event)
@@ -602,8 +614,7 @@ void DebugConsoleFilter::tabletToolButtonEvent(TabletToolButtonEvent *event)
         + timestampRow(event->time)
         + s_tableEnd;
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::tabletPadButtonEvent(TabletPadButtonEvent *event)
@@ -620,8 +631,7 @@ void DebugConsoleFilter::tabletPadButtonEvent(TabletPadButtonEvent *event)
         + timestampRow(event->time)
         + s_tableEnd;
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::tabletPadStripEvent(TabletPadStripEvent *event)
@@ -637,8 +647,7 @@ void DebugConsoleFilter::tabletPadStripEvent(TabletPadStripEvent *event)
         + timestampRow(event->time)
         + s_tableEnd;
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::tabletPadRingEvent(TabletPadRingEvent *event)
@@ -654,8 +663,7 @@ void DebugConsoleFilter::tabletPadRingEvent(TabletPadRingEvent *event)
         + timestampRow(event->time)
         + s_tableEnd;
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 void DebugConsoleFilter::tabletPadDialEvent(TabletPadDialEvent *event)
@@ -668,8 +676,7 @@ void DebugConsoleFilter::tabletPadDialEvent(TabletPadDialEvent *event)
         + timestampRow(event->time)
         + s_tableEnd;
 
-    m_textEdit->insertHtml(text);
-    m_textEdit->ensureCursorVisible();
+    append(text);
 }
 
 static QString sourceString(const AbstractDataSource *const source)
@@ -717,6 +724,9 @@ DebugConsole::DebugConsole()
     m_ui->tabWidget->setTabIcon(0, QIcon::fromTheme(QStringLiteral("view-list-tree")));
 
     m_ui->tabWidget->addTab(new DebugConsoleEffectsTab(), i18nc("@label", "Effects"));
+    m_ui->tabWidget->addTab(new DebugConsolePresentationTab(), i18nc("@label", "Presentation"));
+    m_ui->tabWidget->addTab(new DebugConsoleClientsTab(), i18nc("@label", "Clients"));
+    m_ui->tabWidget->addTab(new DebugConsoleEffectCostsTab(), i18nc("@label", "Effect Costs"));
 
     connect(m_ui->tabWidget, &QTabWidget::currentChanged, this, [this](int index) {
         // delay creation of input event filter until the tab is selected
@@ -1860,6 +1870,157 @@ DebugConsoleEffectsTab::DebugConsoleEffectsTab(QWidget *parent)
     }
 }
 
+DebugConsolePresentationTab::DebugConsolePresentationTab(QWidget *parent)
+    : QTreeWidget(parent)
+{
+    setHeaderLabels({i18nc("@title:column", "Statistic"), i18nc("@title:column", "Value")});
+    m_updateTimer.setInterval(std::chrono::seconds(1));
+    connect(&m_updateTimer, &QTimer::timeout, this, &DebugConsolePresentationTab::updateStatistics);
+}
+
+void DebugConsolePresentationTab::showEvent(QShowEvent *event)
+{
+    QTreeWidget::showEvent(event);
+    updateStatistics();
+    m_updateTimer.start();
+}
+
+void DebugConsolePresentationTab::hideEvent(QHideEvent *event)
+{
+    QTreeWidget::hideEvent(event);
+    m_updateTimer.stop();
+}
+
+static void addStatisticItems(QTreeWidgetItem *parent, const QVariantMap &statistics)
+{
+    for (auto it = statistics.begin(); it != statistics.end(); ++it) {
+        QString value;
+        if (it.value().typeId() == QMetaType::QVariantList) {
+            QStringList values;
+            const QVariantList list = it.value().toList();
+            for (const QVariant &entry : list) {
+                values.push_back(entry.toString());
+            }
+            value = values.join(QStringLiteral(", "));
+        } else {
+            value = it.value().toString();
+        }
+        new QTreeWidgetItem(parent, {it.key(), value});
+    }
+}
+
+void DebugConsolePresentationTab::updateStatistics()
+{
+    clear();
+    const auto outputs = kwinApp()->outputBackend()->outputs();
+    for (BackendOutput *output : outputs) {
+        const QVariantMap statistics = output->presentationStatistics();
+        if (statistics.isEmpty()) {
+            continue;
+        }
+        auto outputItem = new QTreeWidgetItem(this, {output->name()});
+        addStatisticItems(outputItem, statistics);
+        outputItem->setExpanded(true);
+    }
+    resizeColumnToContents(0);
+}
+
+DebugConsoleClientsTab::DebugConsoleClientsTab(QWidget *parent)
+    : QTreeWidget(parent)
+{
+    setHeaderLabels({i18nc("@title:column", "Statistic"), i18nc("@title:column", "Value")});
+    m_updateTimer.setInterval(std::chrono::seconds(1));
+    connect(&m_updateTimer, &QTimer::timeout, this, &DebugConsoleClientsTab::updateStatistics);
+}
+
+void DebugConsoleClientsTab::showEvent(QShowEvent *event)
+{
+    QTreeWidget::showEvent(event);
+    updateStatistics();
+    m_updateTimer.start();
+}
+
+void DebugConsoleClientsTab::hideEvent(QHideEvent *event)
+{
+    QTreeWidget::hideEvent(event);
+    m_updateTimer.stop();
+}
+
+void DebugConsoleClientsTab::updateStatistics()
+{
+    // keep the clients that the user has expanded open across updates
+    QSet<QString> expanded;
+    for (int i = 0; i < topLevelItemCount(); ++i) {
+        if (topLevelItem(i)->isExpanded()) {
+            expanded.insert(topLevelItem(i)->text(0));
+        }
+    }
+
+    clear();
+    const QVariantMap clients = waylandServer()->display()->clientStatistics();
+    for (auto it = clients.begin(); it != clients.end(); ++it) {
+        auto clientItem = new QTreeWidgetItem(this, {it.key()});
+        addStatisticItems(clientItem, it.value().toMap());
+        clientItem->setExpanded(expanded.contains(it.key()));
+    }
+    resizeColumnToContents(0);
+}
+
+DebugConsoleEffectCostsTab::DebugConsoleEffectCostsTab(QWidget *parent)
+    : QTreeWidget(parent)
+{
+    setHeaderLabels({i18nc("@title:column", "Effect"), i18nc("@title:column", "Average (µs)"), i18nc("@title:column", "Maximum (µs)"), i18nc("@title:column", "Frames")});
+    m_updateTimer.setInterval(std::chrono::seconds(1));
+    connect(&m_updateTimer, &QTimer::timeout, this, &DebugConsoleEffectCostsTab::updateStatistics);
+}
+
+void DebugConsoleEffectCostsTab::showEvent(QShowEvent *event)
+{
+    QTreeWidget::showEvent(event);
+    // profiling costs a bit of time in every paint hook, so only do it while somebody looks
+    if (effects && !effects->isEffectProfilingEnabled()) {
+        effects->setEffectProfilingEnabled(true);
+        m_enabledProfiling = true;
+    }
+    updateStatistics();
+    m_updateTimer.start();
+}
+
+void DebugConsoleEffectCostsTab::hideEvent(QHideEvent *event)
+{
+    QTreeWidget::hideEvent(event);
+    m_updateTimer.stop();
+    if (effects && m_enabledProfiling) {
+        effects->setEffectProfilingEnabled(false);
+    }
+    m_enabledProfiling = false;
+}
+
+void DebugConsoleEffectCostsTab::updateStatistics()
+{
+    clear();
+    if (!effects) {
+        return;
+    }
+    const QVariantMap outputs = effects->effectStatistics();
+    for (auto it = outputs.begin(); it != outputs.end(); ++it) {
+        auto outputItem = new QTreeWidgetItem(this, {it.key()});
+        const QVariantMap costs = it.value().toMap();
+        for (auto effect = costs.begin(); effect != costs.end(); ++effect) {
+            const QVariantMap statistics = effect.value().toMap();
+            const QStringList columns{
+                effect.key(),
+                QString::number(statistics[QStringLiteral("average")].toDouble(), 'f', 1),
+                QString::number(statistics[QStringLiteral("maximum")].toDouble(), 'f', 1),
+                statistics[QStringLiteral("frames")].toString(),
+            };
+            new QTreeWidgetItem(outputItem, columns);
+        }
+        outputItem->setExpanded(true);
+    }
+    resizeColumnToContents(0);
+}
+
 } // namespace KWin
 
 #include "moc_debug_console.cpp"
@@ -18,6 +18,8 @@
 #include <QList>
 #include <QListWidget>
 #include <QStyledItemDelegate>
+#include <QTimer>
+#include <QTreeWidget>
 
 #include <functional>
 #include <memory>
@@ -152,7 +154,14 @@ public:
     void tabletPadDialEvent(TabletPadDialEvent *event) override;
 
 private:
+    void append(const QString &html);
+    void flush();
+
     QTextEdit *m_textEdit;
+    // events are formatted right away but shown in batches, laying out the text edit for every
+    // single pointer motion would cost more than the event processing that is being inspected
+    QStringList m_pending;
+    QTimer m_flushTimer;
 };
 
 class InputDeviceModel : public QAbstractItemModel
@@ -222,4 +231,57 @@ public:
     explicit DebugConsoleEffectsTab(QWidget *parent = nullptr);
 };
 
+class DebugConsolePresentationTab : public QTreeWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DebugConsolePresentationTab(QWidget *parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void updateStatistics();
+
+    QTimer m_updateTimer;
+};
+
+class DebugConsoleClientsTab : public QTreeWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DebugConsoleClientsTab(QWidget *parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void updateStatistics();
+
+    QTimer m_updateTimer;
+};
+
+class DebugConsoleEffectCostsTab : public QTreeWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DebugConsoleEffectCostsTab(QWidget *parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void updateStatistics();
+
+    QTimer m_updateTimer;
+    // whether the tab has turned on the profiler and has to turn it off again
+    bool m_enabledProfiling = false;
+};
+
 } // namespace KWin
@@ -18,6 +18,7 @@
 
 #include <QDateTime>
 #include <QTimer>
+#include <QVarLengthArray>
 #include <QVector3D>
 #include <QtDebug>
 
@@ -471,8 +472,9 @@ void AnimationEffect::prePaintWindow(RenderView *view, EffectWindow *w, WindowPr
     if (entry != d->m_animations.end()) {
         auto &[window, pair] = *entry;
         auto &[list, rect] = pair;
+        const qint64 now = clock();
         for (auto &anim : list) {
-            if (anim.startTime > clock() && !anim.waitAtSource) {
+            if (anim.startTime > now && !anim.waitAtSource) {
                 continue;
             }
 
@@ -511,33 +513,41 @@ void AnimationEffect::paintWindow(const RenderTarget &renderTarget, const Render
     Region effectiveDeviceRegion = deviceRegion;
     auto &[window, pair] = *it;
     auto &[list, rect] = pair;
+    const qint64 now = clock();
     for (auto &anim : list) {
-        if (anim.startTime > clock() && !anim.waitAtSource) {
+        if (anim.startTime > now && !anim.waitAtSource) {
             continue;
         }
 
+        // evaluate the easing curve only once, most attributes need the value several times
+        const float value = anim.timeLine.value();
+        const float prgrs = anim.startTime < now ? value : 0.0;
+        const auto interpolated = [&anim, value](int i = 0) {
+            return anim.from[i] + value * (anim.to[i] - anim.from[i]);
+        };
+
         switch (anim.attribute) {
         case Opacity:
-            data.multiplyOpacity(interpolated(anim));
+            data.multiplyOpacity(interpolated());
             break;
         case Brightness:
-            data.multiplyBrightness(interpolated(anim));
+            data.multiplyBrightness(interpolated());
             break;
         case Saturation:
-            data.multiplySaturation(interpolated(anim));
+            data.multiplySaturation(interpolated());
             break;
         case Scale: {
             const QSizeF sz = w->frameGeometry().size();
             float f1(1.0), f2(0.0);
             if (anim.from[0] >= 0.0 && anim.to[0] >= 0.0) { // scale x
-                f1 = interpolated(anim, 0);
+                f1 = interpolated(0);
                 f2 = geometryCompensation(anim.meta & AnimationEffect::Horizontal, f1);
                 data.translate(f2 * sz.width());
                 data.setXScale(data.xScale() * f1);
             }
             if (anim.from[1] >= 0.0 && anim.to[1] >= 0.0) { // scale y
                 if (!anim.isOneDimensional()) {
-                    f1 = interpolated(anim, 1);
+                    f1 = interpolated(1);
                     f2 = geometryCompensation(anim.meta & AnimationEffect::Vertical, f1);
                 } else if (((anim.meta & AnimationEffect::Vertical) >> 1) != (anim.meta & AnimationEffect::Horizontal)) {
                     f2 = geometryCompensation(anim.meta & AnimationEffect::Vertical, f1);
@@ -551,10 +561,10 @@ void AnimationEffect::paintWindow(const RenderTarget &renderTarget, const Render
             effectiveDeviceRegion &= viewport.mapToDeviceCoordinatesAligned(clipRect(w->expandedGeometry().toAlignedRect(), anim));
             break;
         case Translation:
-            data += QPointF(interpolated(anim, 0), interpolated(anim, 1));
+            data += QPointF(interpolated(0), interpolated(1));
             break;
         case Size: {
-            FPx2 dest = anim.from + progress(anim) * (anim.to - anim.from);
+            FPx2 dest = anim.from + prgrs * (anim.to - anim.from);
             const QSizeF sz = w->frameGeometry().size();
             float f;
             if (anim.from[0] >= 0.0 && anim.to[0] >= 0.0) { // resize x
@@ -571,15 +581,14 @@ void AnimationEffect::paintWindow(const RenderTarget &renderTarget, const Render
         }
         case Position: {
             const QRectF geo = w->frameGeometry();
-            const float prgrs = progress(anim);
             if (anim.from[0] >= 0.0 && anim.to[0] >= 0.0) {
-                float dest = interpolated(anim, 0);
+                float dest = interpolated(0);
                 const qreal x[2] = {xCoord(geo, metaData(SourceAnchor, anim.meta)),
                                     xCoord(geo, metaData(TargetAnchor, anim.meta))};
                 data.translate(dest - (x[0] + prgrs * (x[1] - x[0])));
             }
             if (anim.from[1] >= 0.0 && anim.to[1] >= 0.0) {
-                float dest = interpolated(anim, 1);
+                float dest = interpolated(1);
                 const qreal y[2] = {yCoord(geo, metaData(SourceAnchor, anim.meta)),
                                     yCoord(geo, metaData(TargetAnchor, anim.meta))};
                 data.translate(0.0, dest - (y[0] + prgrs * (y[1] - y[0])));
@@ -588,7 +597,6 @@ void AnimationEffect::paintWindow(const RenderTarget &renderTarget, const Render
         }
         case Rotation: {
             data.setRotationAxis((Qt::Axis)metaData(Axis, anim.meta));
-            const float prgrs = progress(anim);
             data.setRotationAngle(anim.from[0] + prgrs * (anim.to[0] - anim.from[0]));
 
             const QRect geo = w->rect().toRect();
@@ -604,23 +612,23 @@ void AnimationEffect::paintWindow(const RenderTarget &renderTarget, const Render
             break;
         }
         case Generic:
-            genericAnimation(w, data, progress(anim), anim.meta);
+            genericAnimation(w, data, prgrs, anim.meta);
             break;
         case CrossFadePrevious:
-            data.setCrossFadeProgress(progress(anim));
+            data.setCrossFadeProgress(prgrs);
             break;
         case Shader:
             if (anim.shader && anim.shader->isValid()) {
                 ShaderBinder binder{anim.shader};
-                anim.shader->setUniform("animationProgress", progress(anim));
+                anim.shader->setUniform("animationProgress", prgrs);
                 setShader(w, anim.shader);
             }
             break;
         case ShaderUniform:
             if (anim.shader && anim.shader->isValid()) {
                 ShaderBinder binder{anim.shader};
-                anim.shader->setUniform("animationProgress", progress(anim));
-                anim.shader->setUniform(anim.meta, interpolated(anim));
+                anim.shader->setUniform("animationProgress", prgrs);
+                anim.shader->setUniform(anim.meta, interpolated());
                 setShader(w, anim.shader);
             }
             break;
@@ -636,13 +644,14 @@ void AnimationEffect::postPaintScreen()
     d->m_animationsTouched = false;
     bool damageDirty = false;
     std::vector<EffectWindowDeletedRef> zombies;
+    const qint64 now = clock();
 
     for (auto entry = d->m_animations.begin(); entry != d->m_animations.end();) {
         bool invalidateLayerRect = false;
         size_t animCounter = 0;
         EffectWindow *const window = entry->first;
         for (auto anim = entry->second.first.begin(); anim != entry->second.first.end();) {
-            if (anim->isActive() || (anim->startTime > clock() && !anim->waitAtSource)) {
+            if (anim->isActive() || (anim->startTime > now && !anim->waitAtSource)) {
                 ++anim;
                 ++animCounter;
                 continue;
@@ -698,7 +707,7 @@ void AnimationEffect::postPaintScreen()
         for (const auto &[window, pair] : d->m_animations) {
             const auto &[data, rect] = pair;
             for (const auto &anim : data) {
-                if (anim.startTime > clock()) {
+                if (anim.startTime > now) {
                     continue;
                 }
                 if (!anim.timeLine.done()) {
@@ -819,6 +828,7 @@ static float fixOvershoot(float f, const AniData &d, short int dir, float s = 1.
 void AnimationEffect::updateLayerRepaints()
 {
     d->m_needSceneRepaint = false;
+    const qint64 now = clock();
     for (auto &[window, pair] : d->m_animations) {
         auto &[data, rect] = pair;
         if (!rect.isNull()) {
@@ -827,9 +837,9 @@ void AnimationEffect::updateLayerRepaints()
         float f[2] = {1.0, 1.0};
         float t[2] = {0.0, 0.0};
         bool createRegion = false;
-        QList<QRect> rects;
+        QVarLengthArray<QRect, 8> rects;
         for (auto &anim : data) {
-            if (anim.startTime > clock()) {
+            if (anim.startTime > now) {
                 continue;
             }
             switch (anim.attribute) {
@@ -404,6 +404,11 @@ bool Effect::isActive() const
     return true;
 }
 
+bool Effect::isActiveForWindow(EffectWindow *w) const
+{
+    return true;
+}
+
 QString Effect::debug(const QString &) const
 {
     return QString();
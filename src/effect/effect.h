@@ -814,6 +814,19 @@ public:
      */
     virtual bool isActive() const;
 
+    /*!
+     * Reimplement this method to tell whether the effect wants to take part in painting the
+     * window \a w in the next rendered frame.
+     *
+     * If the method returns \c false, prePaintWindow(), paintWindow() and drawWindow() are not
+     * called for \a w in that frame. The method is called at most once per window and frame,
+     * effects that only affect a few windows should use it to stay out of the way of the others.
+     *
+     * The default implementation of this method returns \c true.
+     * \since 6.7
+     */
+    virtual bool isActiveForWindow(EffectWindow *w) const;
+
     /*!
      * Reimplement this method to provide online debugging.
      *
@@ -19,6 +19,7 @@
 #include "core/renderbackend.h"
 #include "core/rendertarget.h"
 #include "core/renderviewport.h"
+#include "core/stallstatistics.h"
 #include "decorations/decorationbridge.h"
 #include "effect/effectloader.h"
 #include "effect/offscreenquickview.h"
@@ -40,6 +41,7 @@
 #include "screenedge.h"
 #include "scripting/scripting.h"
 #include "sm.h"
+#include "utils/envvar.h"
 #include "virtualdesktops.h"
 #include "wayland_server.h"
 #include "window_property_notify_x11_filter.h"
@@ -103,6 +105,8 @@ static void unregisterSupportProperty(xcb_atom_t atom)
 }
 #endif
 
+static const bool s_effectProfiling = environmentVariableBoolValue("KWIN_EFFECT_PROFILING").value_or(false);
+
 //****************************************
 // EffectsHandler
 //****************************************
@@ -113,6 +117,7 @@ EffectsHandler::EffectsHandler(Compositor *compositor, WorkspaceScene *scene)
     , compositing_type(compositor->backend()->compositingType())
     , m_compositor(compositor)
     , m_scene(scene)
+    , m_effectProfilingEnabled(s_effectProfiling)
     , m_effectLoader(new EffectLoader(this))
 {
     if (compositing_type == NoCompositing) {
@@ -312,6 +317,7 @@ EglContext *EffectsHandler::openglContext() const
 void EffectsHandler::unloadAllEffects()
 {
     m_activeEffects.clear();
+    m_windowEffectMasks.clear();
     effect_order.clear();
     m_effectLoader->clear();
 
@@ -337,11 +343,103 @@ void EffectsHandler::reconfigure()
     m_effectLoader->queryAndLoadAll();
 }
 
+template<typename Callback>
+void EffectsHandler::profileEffect(Effect *effect, Callback &&callback)
+{
+    if (!m_effectProfilingEnabled) {
+        callback();
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    m_effectProfilingStack.push_back(std::chrono::nanoseconds::zero());
+    callback();
+    const std::chrono::nanoseconds nested = m_effectProfilingStack.back();
+    m_effectProfilingStack.pop_back();
+    const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+    if (!m_effectProfilingStack.empty()) {
+        m_effectProfilingStack.back() += elapsed;
+    }
+    // the nested calls belong to the effects further down the chain or to the scene
+    if (effect) {
+        m_effectFrameCosts[effect] += elapsed - nested;
+    }
+}
+
+void EffectsHandler::beginEffectProfile(LogicalOutput *output)
+{
+    m_effectFrameCosts.clear();
+    m_effectProfilingOutput = output ? output->name() : QString();
+}
+
+void EffectsHandler::endEffectProfile()
+{
+    if (!m_effectProfilingEnabled || m_effectFrameCosts.isEmpty()) {
+        return;
+    }
+    std::map<QString, EffectProfile> &profiles = m_effectProfiles[m_effectProfilingOutput];
+    for (const EffectPair &pair : std::as_const(loaded_effects)) {
+        const auto it = m_effectFrameCosts.constFind(pair.second);
+        if (it == m_effectFrameCosts.constEnd()) {
+            continue;
+        }
+        EffectProfile &profile = profiles[pair.first];
+        profile.frames++;
+        profile.total += *it;
+        profile.maximum = std::max(profile.maximum, *it);
+    }
+    m_effectFrameCosts.clear();
+}
+
+void EffectsHandler::setEffectProfilingEnabled(bool enabled)
+{
+    if (m_effectProfilingEnabled == enabled) {
+        return;
+    }
+    m_effectProfilingEnabled = enabled;
+    m_effectFrameCosts.clear();
+    if (enabled) {
+        m_effectProfiles.clear();
+    }
+}
+
+bool EffectsHandler::isEffectProfilingEnabled() const
+{
+    return m_effectProfilingEnabled;
+}
+
+QVariantMap EffectsHandler::effectStatistics() const
+{
+    const auto toMicroseconds = [](std::chrono::nanoseconds duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+    QVariantMap ret;
+    for (const auto &[output, profiles] : m_effectProfiles) {
+        QVariantMap outputStatistics;
+        for (const auto &[name, profile] : profiles) {
+            outputStatistics[name] = QVariantMap{
+                {QStringLiteral("frames"), qulonglong(profile.frames)},
+                {QStringLiteral("average"), toMicroseconds(profile.total / profile.frames)},
+                {QStringLiteral("maximum"), toMicroseconds(profile.maximum)},
+                {QStringLiteral("total"), toMicroseconds(profile.total)},
+            };
+        }
+        ret[output] = outputStatistics;
+    }
+    return ret;
+}
+
 // the idea is that effects call this function again which calls the next one
 void EffectsHandler::prePaintScreen(ScreenPrePaintData &data)
 {
+    if (m_currentPaintScreenIterator == m_activeEffects.constBegin()) {
+        beginEffectProfile(data.screen);
+    }
     if (m_currentPaintScreenIterator != m_activeEffects.constEnd()) {
-        (*m_currentPaintScreenIterator++)->prePaintScreen(data);
+        Effect *effect = *m_currentPaintScreenIterator++;
+        profileEffect(effect, [&]() {
+            const StallStatistics::Scope stallScope(StallSource::Effects);
+            effect->prePaintScreen(data);
+        });
         --m_currentPaintScreenIterator;
     }
     // no special final code
@@ -350,39 +448,90 @@ void EffectsHandler::prePaintScreen(ScreenPrePaintData &data)
 void EffectsHandler::paintScreen(const RenderTarget &renderTarget, const RenderViewport &viewport, int mask, const Region &deviceRegion, LogicalOutput *screen)
 {
     if (m_currentPaintScreenIterator != m_activeEffects.constEnd()) {
-        (*m_currentPaintScreenIterator++)->paintScreen(renderTarget, viewport, mask, deviceRegion, screen);
+        Effect *effect = *m_currentPaintScreenIterator++;
+        profileEffect(effect, [&]() {
+            const StallStatistics::Scope stallScope(StallSource::Effects);
+            effect->paintScreen(renderTarget, viewport, mask, deviceRegion, screen);
+        });
         --m_currentPaintScreenIterator;
     } else {
-        m_scene->finalPaintScreen(renderTarget, viewport, mask, deviceRegion, screen);
+        profileEffect(nullptr, [&]() {
+            const StallStatistics::Scope stallScope(StallSource::Rendering);
+            m_scene->finalPaintScreen(renderTarget, viewport, mask, deviceRegion, screen);
+        });
     }
 }
 
 void EffectsHandler::postPaintScreen()
 {
     if (m_currentPaintScreenIterator != m_activeEffects.constEnd()) {
-        (*m_currentPaintScreenIterator++)->postPaintScreen();
+        Effect *effect = *m_currentPaintScreenIterator++;
+        profileEffect(effect, [&]() {
+            const StallStatistics::Scope stallScope(StallSource::Effects);
+            effect->postPaintScreen();
+        });
         --m_currentPaintScreenIterator;
     }
     // no special final code
+    if (m_currentPaintScreenIterator == m_activeEffects.constBegin()) {
+        endEffectProfile();
+    }
+}
+
+EffectsHandler::EffectsIterator EffectsHandler::nextEffectForWindow(EffectsIterator it, EffectWindow *w)
+{
+    const EffectsIterator end = m_activeEffects.constEnd();
+    if (it == end) {
+        return end;
+    }
+    auto mask = m_windowEffectMasks.find(w);
+    if (mask == m_windowEffectMasks.end()) {
+        quint64 bits = 0;
+        for (qsizetype i = 0; i < std::min<qsizetype>(m_activeEffects.size(), 64); ++i) {
+            if (m_activeEffects[i]->isActiveForWindow(w)) {
+                bits |= quint64(1) << i;
+            }
+        }
+        mask = m_windowEffectMasks.insert(w, bits);
+    }
+    for (; it != end; ++it) {
+        const qsizetype index = it - m_activeEffects.constBegin();
+        if (index >= 64 || (*mask & (quint64(1) << index))) {
+            break;
+        }
+    }
+    return it;
 }
 
 void EffectsHandler::prePaintWindow(RenderView *view, EffectWindow *w, WindowPrePaintData &data)
 {
+    const EffectsIterator current = m_currentPaintWindowIterator;
+    m_currentPaintWindowIterator = nextEffectForWindow(current, w);
     if (m_currentPaintWindowIterator != m_activeEffects.constEnd()) {
-        (*m_currentPaintWindowIterator++)->prePaintWindow(view, w, data);
-        --m_currentPaintWindowIterator;
+        Effect *effect = *m_currentPaintWindowIterator++;
+        profileEffect(effect, [&]() {
+            effect->prePaintWindow(view, w, data);
+        });
     }
+    m_currentPaintWindowIterator = current;
     // no special final code
 }
 
 void EffectsHandler::paintWindow(const RenderTarget &renderTarget, const RenderViewport &viewport, EffectWindow *w, int mask, const Region &deviceRegion, WindowPaintData &data)
 {
+    const EffectsIterator current = m_currentPaintWindowIterator;
+    m_currentPaintWindowIterator = nextEffectForWindow(current, w);
     if (m_currentPaintWindowIterator != m_activeEffects.constEnd()) {
-        (*m_currentPaintWindowIterator++)->paintWindow(renderTarget, viewport, w, mask, deviceRegion, data);
-        --m_currentPaintWindowIterator;
+        Effect *effect = *m_currentPaintWindowIterator++;
+        profileEffect(effect, [&]() {
+            effect->paintWindow(renderTarget, viewport, w, mask, deviceRegion, data);
+        });
     } else {
-        m_scene->finalPaintWindow(renderTarget, viewport, w, mask, deviceRegion, data);
+        profileEffect(nullptr, [&]() {
+            m_scene->finalPaintWindow(renderTarget, viewport, w, mask, deviceRegion, data);
+        });
     }
+    m_currentPaintWindowIterator = current;
 }
 
 Effect *EffectsHandler::provides(Effect::Feature ef)
@@ -397,12 +546,19 @@ Effect *EffectsHandler::provides(Effect::Feature ef)
 
 void EffectsHandler::drawWindow(const RenderTarget &renderTarget, const RenderViewport &viewport, EffectWindow *w, int mask, const Region &deviceRegion, WindowPaintData &data)
 {
+    const EffectsIterator current = m_currentDrawWindowIterator;
+    m_currentDrawWindowIterator = nextEffectForWindow(current, w);
     if (m_currentDrawWindowIterator != m_activeEffects.constEnd()) {
-        (*m_currentDrawWindowIterator++)->drawWindow(renderTarget, viewport, w, mask, deviceRegion, data);
-        --m_currentDrawWindowIterator;
+        Effect *effect = *m_currentDrawWindowIterator++;
+        profileEffect(effect, [&]() {
+            effect->drawWindow(renderTarget, viewport, w, mask, deviceRegion, data);
+        });
     } else {
-        m_scene->finalDrawWindow(renderTarget, viewport, w, mask, deviceRegion, data);
+        profileEffect(nullptr, [&]() {
+            m_scene->finalDrawWindow(renderTarget, viewport, w, mask, deviceRegion, data);
+        });
     }
+    m_currentDrawWindowIterator = current;
 }
 
 void EffectsHandler::renderWindow(const RenderTarget &renderTarget, const RenderViewport &viewport, EffectWindow *w, int mask, const Region &deviceRegion, WindowPaintData &data)
@@ -433,6 +589,7 @@ void EffectsHandler::startPaint()
     m_currentDrawWindowIterator = m_activeEffects.constBegin();
     m_currentPaintWindowIterator = m_activeEffects.constBegin();
     m_currentPaintScreenIterator = m_activeEffects.constBegin();
+    m_windowEffectMasks.clear();
 }
 
 void EffectsHandler::setActiveFullScreenEffect(Effect *e)
@@ -1192,6 +1349,8 @@ bool EffectsHandler::loadEffect(const QString &name)
 
 void EffectsHandler::unloadEffect(const QString &name)
 {
+    m_effectLoader->cancelDeferredLoad(name);
+
     auto it = std::find_if(effect_order.begin(), effect_order.end(),
                            [name](EffectPair &pair) {
                                return pair.first == name;
@@ -1306,6 +1465,7 @@ void EffectsHandler::effectsChanged()
 {
     loaded_effects.clear();
     m_activeEffects.clear(); // it's possible to have a reconfigure and a quad rebuild between two paint cycles - bug #308201
+    m_windowEffectMasks.clear();
 
     loaded_effects.reserve(effect_order.count());
     std::copy(effect_order.constBegin(), effect_order.constEnd(),
@@ -30,7 +30,9 @@
 
 #include <KConfigWatcher>
 
+#include <chrono>
 #include <functional>
+#include <map>
 
 #if KWIN_BUILD_X11
 #include <xcb/xcb.h>
@@ -1077,6 +1079,17 @@ public Q_SLOTS:
     Q_SCRIPTABLE QList<bool> areEffectsSupported(const QStringList &names);
     Q_SCRIPTABLE QString supportInformation(const QString &name) const;
     Q_SCRIPTABLE QString debug(const QString &name, const QString &parameter = QString()) const;
+    /**
+     * Enables or disables measuring how much CPU time every effect spends in its paint hooks.
+     * Enabling the profiler discards the previous measurements.
+     */
+    Q_SCRIPTABLE void setEffectProfilingEnabled(bool enabled);
+    bool isEffectProfilingEnabled() const;
+    /**
+     * Maps the name of every output to the costs of the effects that took part in painting
+     * it since the profiler was enabled. Durations are in microseconds.
+     */
+    Q_SCRIPTABLE QVariantMap effectStatistics() const;
 
 protected:
     void effectsChanged();
@@ -1090,6 +1103,23 @@ protected:
     typedef QList<Effect *> EffectsList;
     typedef EffectsList::const_iterator EffectsIterator;
 
+    /**
+     * Returns the first effect starting at @p it that is active for @p w in this frame.
+     */
+    EffectsIterator nextEffectForWindow(EffectsIterator it, EffectWindow *w);
+
+    template<typename Callback>
+    void profileEffect(Effect *effect, Callback &&callback);
+    void beginEffectProfile(LogicalOutput *output);
+    void endEffectProfile();
+
+    struct EffectProfile
+    {
+        uint64_t frames = 0;
+        std::chrono::nanoseconds total{0};
+        std::chrono::nanoseconds maximum{0};
+    };
+
     struct
     {
         QPointF position;
@@ -1109,6 +1139,14 @@ protected:
     EffectsIterator m_currentDrawWindowIterator;
     EffectsIterator m_currentPaintWindowIterator;
     EffectsIterator m_currentPaintScreenIterator;
+    // one bit per active effect, effects past the 64th are always considered to be active
+    QHash<EffectWindow *, quint64> m_windowEffectMasks;
+    bool m_effectProfilingEnabled;
+    // the time spent in the nested calls of every effect that is currently being profiled
+    std::vector<std::chrono::nanoseconds> m_effectProfilingStack;
+    QHash<Effect *, std::chrono::nanoseconds> m_effectFrameCosts;
+    QString m_effectProfilingOutput;
+    std::map<QString, std::map<QString, EffectProfile>> m_effectProfiles;
     typedef QHash<QByteArray, QList<Effect *>> PropertyEffectMap;
 #if KWIN_BUILD_X11
     PropertyEffectMap m_propertiesForEffects;
@@ -18,13 +18,18 @@
 #include "scripting/scriptedquicksceneeffect.h"
 #include "scripting/scripting.h"
 #include "utils/common.h"
+#include "utils/envvar.h"
 // KDE
 #include <KConfigGroup>
+#include <KGlobalAccel>
 #include <KPackage/Package>
 #include <KPackage/PackageLoader>
 // Qt
+#include <QAction>
 #include <QDebug>
 #include <QFutureWatcher>
+#include <QJsonArray>
+#include <QJsonObject>
 #include <QPluginLoader>
 #include <QQmlComponent>
 #include <QQmlEngine>
@@ -49,6 +54,10 @@ void AbstractEffectLoader::setConfig(KSharedConfig::Ptr config)
     m_config = config;
 }
 
+void AbstractEffectLoader::cancelDeferredLoad(const QString &name)
+{
+}
+
 LoadEffectFlags AbstractEffectLoader::readConfig(const QString &effectName, bool defaultValue) const
 {
     Q_ASSERT(m_config);
@@ -70,6 +79,7 @@ LoadEffectFlags AbstractEffectLoader::readConfig(const QString &effectName, bool
 }
 
 static const QString s_serviceType = QStringLiteral("KWin/Effect");
+static const bool s_deferEffects = environmentVariableBoolValue("KWIN_DEFER_EFFECT_LOADING").value_or(true);
 
 ScriptedEffectLoader::ScriptedEffectLoader(QObject *parent)
     : AbstractEffectLoader(parent)
@@ -375,11 +385,27 @@ bool PluginEffectLoader::loadEffect(const KPluginMetaData &info, LoadEffectFlags
         }
     }
 
+    if (flags.testFlag(LoadEffectFlag::Defer)) {
+        if (m_deferredEffects.contains(name) || deferEffect(info)) {
+            return true;
+        }
+    } else {
+        // the effect is wanted right now, drop the placeholder shortcuts before the effect
+        // registers the real ones
+        m_deferredEffects.erase(name);
+    }
+
+    return createEffect(info, effectFactory) != nullptr;
+}
+
+Effect *PluginEffectLoader::createEffect(const KPluginMetaData &info, EffectPluginFactory *effectFactory)
+{
+    const QString name = info.pluginId();
     // ok, now we can try to create the Effect
     Effect *e = effectFactory->createEffect();
     if (!e) {
         qCDebug(KWIN_CORE) << "Failed to create effect: " << name;
-        return false;
+        return nullptr;
     }
     // insert in our loaded effects
     m_loadedEffects << name;
@@ -388,15 +414,89 @@ bool PluginEffectLoader::loadEffect(const KPluginMetaData &info, LoadEffectFlags
     });
     qCDebug(KWIN_CORE) << "Successfully loaded plugin effect: " << name;
     Q_EMIT effectLoaded(e, name);
+    return e;
+}
+
+bool PluginEffectLoader::deferEffect(const KPluginMetaData &info)
+{
+    const QJsonArray shortcuts = info.rawData().value(QStringLiteral("X-KWin-Deferred-Shortcuts")).toArray();
+    if (shortcuts.isEmpty()) {
+        return false;
+    }
+
+    const QString name = info.pluginId();
+    DeferredEffect deferred{
+        .info = info,
+    };
+    for (const QJsonValue &value : shortcuts) {
+        const QJsonObject shortcut = value.toObject();
+        const QString actionName = shortcut.value(QStringLiteral("Name")).toString();
+
+        QList<QKeySequence> defaultShortcut;
+        const QJsonArray keys = shortcut.value(QStringLiteral("Shortcuts")).toArray();
+        for (const QJsonValue &key : keys) {
+            defaultShortcut.append(QKeySequence::fromString(key.toString(), QKeySequence::PortableText));
+        }
+
+        auto action = std::make_unique<QAction>();
+        action->setObjectName(actionName);
+        action->setText(shortcut.value(QStringLiteral("Text")).toString());
+        KGlobalAccel::self()->setDefaultShortcut(action.get(), defaultShortcut);
+        KGlobalAccel::self()->setShortcut(action.get(), defaultShortcut);
+        // the effect is created from the event loop, the placeholder action can't be deleted
+        // while it's being triggered
+        connect(action.get(), &QAction::triggered, this, [this, name, actionName]() {
+            QMetaObject::invokeMethod(this, [this, name, actionName]() {
+                loadDeferredEffect(name, actionName);
+            }, Qt::QueuedConnection);
+        });
+        deferred.actions.push_back(std::move(action));
+    }
+
+    qCDebug(KWIN_CORE) << "Deferred loading plugin effect until it's used:" << name;
+    m_deferredEffects[name] = std::move(deferred);
     return true;
 }
 
+void PluginEffectLoader::loadDeferredEffect(const QString &name, const QString &actionName)
+{
+    auto it = m_deferredEffects.find(name);
+    if (it == m_deferredEffects.end()) {
+        return;
+    }
+    const KPluginMetaData info = it->second.info;
+    // the placeholders must be gone before the effect registers the real shortcuts
+    m_deferredEffects.erase(it);
+
+    EffectPluginFactory *effectFactory = factory(info);
+    if (!effectFactory) {
+        return;
+    }
+    effects->makeOpenGLContextCurrent();
+    Effect *effect = createEffect(info, effectFactory);
+    if (!effect) {
+        return;
+    }
+    // replay the shortcut that brought the effect in
+    if (QAction *action = effect->findChild<QAction *>(actionName)) {
+        action->trigger();
+    }
+}
+
+void PluginEffectLoader::cancelDeferredLoad(const QString &name)
+{
+    m_deferredEffects.erase(name);
+}
+
 void PluginEffectLoader::queryAndLoadAll()
 {
     const auto effects = findAllEffects();
     for (const auto &effect : effects) {
-        const LoadEffectFlags flags = readConfig(effect.pluginId(), effect.isEnabledByDefault());
+        LoadEffectFlags flags = readConfig(effect.pluginId(), effect.isEnabledByDefault());
         if (flags.testFlag(LoadEffectFlag::Load)) {
+            if (s_deferEffects) {
+                flags |= LoadEffectFlag::Defer;
+            }
             loadEffect(effect, flags);
         }
     }
@@ -414,6 +514,7 @@ void PluginEffectLoader::setPluginSubDirectory(const QString &directory)
 
 void PluginEffectLoader::clear()
 {
+    m_deferredEffects.clear();
 }
 
 EffectLoader::EffectLoader(QObject *parent)
@@ -485,6 +586,13 @@ void EffectLoader::clear()
     }
 }
 
+void EffectLoader::cancelDeferredLoad(const QString &name)
+{
+    for (auto it = m_loaders.constBegin(); it != m_loaders.constEnd(); ++it) {
+        (*it)->cancelDeferredLoad(name);
+    }
+}
+
 KPluginMetaData EffectLoader::findEffect(const QString &name) const
 {
     for (const auto loader : m_loaders) {
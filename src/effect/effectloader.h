@@ -19,6 +19,12 @@
 #include <QQueue>
 #include <QStaticPlugin>
 
+#include <map>
+#include <memory>
+#include <vector>
+
+class QAction;
+
 namespace KWin
 {
 class Effect;
@@ -34,7 +40,8 @@ class EffectPluginFactory;
  */
 enum class LoadEffectFlag {
     Load = 1 << 0, ///< Effect should be loaded
-    CheckDefaultFunction = 1 << 2 ///< The Check Default Function needs to be invoked if the Effect provides it
+    CheckDefaultFunction = 1 << 2, ///< The Check Default Function needs to be invoked if the Effect provides it
+    Defer = 1 << 3, ///< The Effect may be created when it's used for the first time
 };
 Q_DECLARE_FLAGS(LoadEffectFlags, LoadEffectFlag)
 
@@ -156,6 +163,13 @@ public:
      */
     virtual void clear() = 0;
 
+    /**
+     * @brief Discards the Effect with the given @p name if it is waiting to be used for the first time.
+     *
+     * @see LoadEffectFlag::Defer
+     */
+    virtual void cancelDeferredLoad(const QString &name);
+
     /**
      * @brief Finds the effect with a given @p name.
      *
@@ -323,13 +337,30 @@ public:
     bool loadEffect(const KPluginMetaData &info, LoadEffectFlags flags);
     KPluginMetaData findEffect(const QString &name) const override;
 
+    void cancelDeferredLoad(const QString &name) override;
+
     void setPluginSubDirectory(const QString &directory);
 
 private:
+    /**
+     * An Effect that is only triggered by global shortcuts, which are listed in the
+     * X-KWin-Deferred-Shortcuts field of its metadata. Until one of them is pressed, only
+     * placeholder actions are registered for them and the Effect itself isn't created.
+     */
+    struct DeferredEffect
+    {
+        KPluginMetaData info;
+        std::vector<std::unique_ptr<QAction>> actions;
+    };
+
     QList<KPluginMetaData> findAllEffects() const;
     EffectPluginFactory *factory(const KPluginMetaData &info) const;
+    Effect *createEffect(const KPluginMetaData &info, EffectPluginFactory *effectFactory);
+    bool deferEffect(const KPluginMetaData &info);
+    void loadDeferredEffect(const QString &name, const QString &actionName);
     QStringList m_loadedEffects;
     QString m_pluginSubDirectory;
+    std::map<QString, DeferredEffect> m_deferredEffects;
 };
 
 class KWIN_EXPORT EffectLoader : public AbstractEffectLoader
@@ -345,6 +376,7 @@ public:
     void queryAndLoadAll() override;
     void setConfig(KSharedConfig::Ptr config) override;
     void clear() override;
+    void cancelDeferredLoad(const QString &name) override;
     KPluginMetaData findEffect(const QString &name) const override;
 
 private:
@@ -11,6 +11,7 @@
 #include "core/renderviewport.h"
 #include "effect/effecthandler.h"
 #include "opengl/eglcontext.h"
+#include "opengl/glrendertargetpool.h"
 #include "opengl/gltexture.h"
 #include "opengl/glutils.h"
 #include "scene/windowitem.h"
@@ -30,6 +31,7 @@ public:
                const WindowPaintData &data, const WindowQuadList &quads);
 
     void maybeRender(EffectWindow *window);
+    void releaseRenderTarget();
 
     std::unique_ptr<GLTexture> m_texture;
     std::unique_ptr<GLFramebuffer> m_fbo;
@@ -113,18 +115,17 @@ void OffscreenData::maybeRender(EffectWindow *window)
     const QSize textureSize = (logicalGeometry.size() * scale).toSize();
 
     if (textureSize.isEmpty()) {
-        m_fbo.reset();
-        m_texture.reset();
+        releaseRenderTarget();
         return;
     }
     if (!m_texture || m_texture->size() != textureSize) {
-        m_texture = GLTexture::allocate(GL_RGBA8, textureSize);
-        if (!m_texture) {
+        releaseRenderTarget();
+        GLRenderTarget target = EglContext::currentContext()->renderTargetPool()->acquire(GL_RGBA8, textureSize);
+        if (!target) {
             return;
         }
-        m_texture->setFilter(GL_LINEAR);
-        m_texture->setWrapMode(GL_CLAMP_TO_EDGE);
-        m_fbo = std::make_unique<GLFramebuffer>(m_texture.get());
+        m_texture = std::move(target.texture);
+        m_fbo = std::move(target.framebuffer);
         m_isDirty = true;
     }
 
@@ -149,6 +150,17 @@ void OffscreenData::maybeRender(EffectWindow *window)
 OffscreenData::~OffscreenData()
 {
     QObject::disconnect(m_windowDamagedConnection);
+    releaseRenderTarget();
+}
+
+void OffscreenData::releaseRenderTarget()
+{
+    // animations redirect windows only for a short while, let the next one reuse the texture
+    if (EglContext *context = EglContext::currentContext()) {
+        context->renderTargetPool()->release(GLRenderTarget(std::move(m_texture), std::move(m_fbo)));
+    }
+    m_fbo.reset();
+    m_texture.reset();
 }
 
 void OffscreenData::setDirty()
@@ -181,18 +193,13 @@ void OffscreenData::paint(const RenderTarget &renderTarget, const RenderViewport
     vbo->reset();
     vbo->setAttribLayout(std::span(GLVertexBuffer::GLVertex2DLayout), sizeof(GLVertex2D));
 
-    RenderGeometry geometry;
-    geometry.setVertexSnappingMode(m_vertexSnappingMode);
-    for (auto &quad : quads) {
-        geometry.appendWindowQuad(quad, scale);
-    }
-    geometry.postProcessTextureCoordinates(m_texture->matrix(NormalizedCoordinates));
-
-    const auto map = vbo->map<GLVertex2D>(geometry.size());
+    // effects with fine grids push a lot of vertices, write them straight into the buffer
+    const qsizetype vertexCount = quads.size() * 6;
+    const auto map = vbo->map<GLVertex2D>(vertexCount);
     if (!map) {
         return;
     }
-    geometry.copy(*map);
+    RenderGeometry::writeWindowQuads(*map, quads, scale, m_vertexSnappingMode, m_texture->matrix(NormalizedCoordinates));
     vbo->unmap();
 
     vbo->bindArrays();
@@ -223,7 +230,7 @@ void OffscreenData::paint(const RenderTarget &renderTarget, const RenderViewport
     glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
     m_texture->bind();
-    vbo->draw(clipRegion, GL_TRIANGLES, 0, geometry.count(), clipping);
+    vbo->draw(clipRegion, GL_TRIANGLES, 0, vertexCount, clipping);
     m_texture->unbind();
 
     glDisable(GL_BLEND);
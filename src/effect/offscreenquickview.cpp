@@ -64,6 +64,9 @@ public:
     bool m_visible = true;
     bool m_hasAlphaChannel = true;
     bool m_automaticRepaint = true;
+    // renderRequested only asks to render the existing scene graph again, polishing the items
+    // and syncing them to the scene graph is only needed after sceneChanged
+    bool m_syncRequired = true;
 
     std::optional<qreal> m_explicitDpr;
 
@@ -207,10 +210,12 @@ void OffscreenQuickView::setAutomaticRepaint(bool set)
 void OffscreenQuickView::setDevicePixelRatio(qreal dpr)
 {
     d->m_explicitDpr = dpr;
+    d->m_syncRequired = true;
 }
 
 void OffscreenQuickView::handleSceneChanged()
 {
+    d->m_syncRequired = true;
     if (d->m_automaticRepaint) {
         d->m_repaintTimer->start();
     }
@@ -257,6 +262,7 @@ void OffscreenQuickView::update()
             fboFormat.setInternalTextureFormat(GL_RGBA8);
 
             d->m_fbo = std::make_unique<QOpenGLFramebufferObject>(nativeSize, fboFormat);
+            d->m_syncRequired = true;
             if (!d->m_fbo->isValid()) {
                 d->m_fbo.reset();
                 d->m_glcontext->doneCurrent();
@@ -270,11 +276,16 @@ void OffscreenQuickView::update()
         d->m_view->setRenderTarget(renderTarget);
     }
 
-    d->m_renderControl->polishItems();
+    if (d->m_syncRequired) {
+        d->m_renderControl->polishItems();
+    }
     if (usingGl) {
         d->m_renderControl->beginFrame();
     }
-    d->m_renderControl->sync();
+    if (d->m_syncRequired) {
+        d->m_renderControl->sync();
+        d->m_syncRequired = false;
+    }
     d->m_renderControl->render();
     if (usingGl) {
         d->m_renderControl->endFrame();
@@ -541,11 +552,13 @@ void OffscreenQuickView::setGeometry(const QRect &rect)
     d->m_view->setGeometry(rect);
     // QWindow::setGeometry() won't sync output if there's no platform window.
     d->m_view->setScreen(QGuiApplication::screenAt(rect.center()));
+    d->m_syncRequired = true;
     Q_EMIT geometryChanged(oldGeometry, rect);
 }
 
 void OffscreenQuickView::Private::releaseResources()
 {
+    m_syncRequired = true;
     if (m_glcontext) {
         m_glcontext->makeCurrent(m_offscreenSurface.get());
         m_view->releaseResources();
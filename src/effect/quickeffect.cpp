@@ -10,18 +10,21 @@
 #include "input_event.h"
 
 #include "logging_p.h"
+#include "utils/envvar.h"
 
 #include <QQmlContext>
 #include <QQmlEngine>
 #include <QQmlIncubator>
 #include <QQuickItem>
 #include <QQuickWindow>
+#include <QTimer>
 #include <qpa/qwindowsysteminterface.h>
 
 namespace KWin
 {
 
 static QHash<QQuickWindow *, QuickSceneView *> s_views;
+static const bool s_preloadDelegates = environmentVariableBoolValue("KWIN_QUICK_EFFECTS_PRELOAD").value_or(true);
 
 class QuickSceneViewIncubator : public QQmlIncubator
 {
@@ -66,6 +69,8 @@ public:
         return effect->d.get();
     }
     bool isItemOnScreen(QQuickItem *item, LogicalOutput *screen) const;
+    bool loadDelegate(QuickSceneEffect *effect, QQmlComponent::CompilationMode mode);
+    void schedulePreload(QuickSceneEffect *effect);
 
     QPointer<QQmlComponent> delegate;
     QUrl source;
@@ -91,6 +96,44 @@ bool QuickSceneEffectPrivate::isItemOnScreen(QQuickItem *item, LogicalOutput *sc
     return it != views.end() && item->window() == it->second->window();
 }
 
+bool QuickSceneEffectPrivate::loadDelegate(QuickSceneEffect *effect, QQmlComponent::CompilationMode mode)
+{
+    delegate = new QQmlComponent(effects->qmlEngine(), effect);
+
+    if (!source.isEmpty()) {
+        delegate->loadUrl(source, mode);
+        if (delegate->isError()) {
+            qWarning().nospace() << "Failed to load " << source << ": " << delegate->errors();
+            delegate.clear();
+            return false;
+        }
+    } else {
+        delegate->loadFromModule(loadInfo.uri, loadInfo.typeName, mode);
+        if (delegate->isError()) {
+            qWarning().nospace() << "Failed to load " << (loadInfo.uri + u'.' + loadInfo.typeName) << delegate->errors();
+            delegate.clear();
+            return false;
+        }
+    }
+
+    Q_EMIT effect->delegateChanged();
+    return true;
+}
+
+void QuickSceneEffectPrivate::schedulePreload(QuickSceneEffect *effect)
+{
+    if (!s_preloadDelegates) {
+        return;
+    }
+    // compile the component in the background once the effect is set up, so the first
+    // activation doesn't have to wait for it
+    QTimer::singleShot(0, effect, [this, effect]() {
+        if (!delegate && !running && (!source.isEmpty() || !loadInfo.uri.isEmpty())) {
+            loadDelegate(effect, QQmlComponent::Asynchronous);
+        }
+    });
+}
+
 QuickSceneView::QuickSceneView(QuickSceneEffect *effect, LogicalOutput *screen)
     : OffscreenQuickView(ExportMode::Texture, false)
     , m_effect(effect)
@@ -257,6 +300,7 @@ void QuickSceneEffect::setSource(const QUrl &url)
         d->source = url;
         d->delegate.clear();
         d->loadInfo = {};
+        d->schedulePreload(this);
     }
 }
 
@@ -276,6 +320,7 @@ void QuickSceneEffect::loadFromModule(const QString &uri, const QString &typeNam
         d->source = QUrl();
         d->loadInfo.uri = uri;
         d->loadInfo.typeName = typeName;
+        d->schedulePreload(this);
     }
 }
 
@@ -482,31 +527,20 @@ void QuickSceneEffect::startInternal()
         return;
     }
 
+    if (d->delegate && (d->delegate->isLoading() || d->delegate->isError()) && (!d->source.isEmpty() || !d->loadInfo.uri.isEmpty())) {
+        // the preload hasn't finished yet or failed, load the component synchronously
+        d->delegate->deleteLater();
+        d->delegate.clear();
+    }
+
     if (!d->delegate) {
         if (Q_UNLIKELY(d->source.isEmpty() && d->loadInfo.uri.isEmpty())) {
             qWarning() << "QuickSceneEffect.source is empty. Did you forget to call setSource() or loadFromModule()?";
             return;
         }
-
-        d->delegate = new QQmlComponent(effects->qmlEngine(), this);
-
-        if (!d->source.isEmpty()) {
-            d->delegate->loadUrl(d->source);
-            if (d->delegate->isError()) {
-                qWarning().nospace() << "Failed to load " << d->source << ": " << d->delegate->errors();
-                d->delegate.clear();
-                return;
-            }
-        } else {
-            d->delegate->loadFromModule(d->loadInfo.uri, d->loadInfo.typeName);
-            if (d->delegate->isError()) {
-                qWarning().nospace() << "Failed to load " << (d->loadInfo.uri + u'.' + d->loadInfo.typeName) << d->delegate->errors();
-                d->delegate.clear();
-                return;
-            }
+        if (!d->loadDelegate(this, QQmlComponent::PreferSynchronous)) {
+            return;
         }
-
-        Q_EMIT delegateChanged();
     }
 
     if (!d->delegate->isReady()) {
@@ -318,13 +318,13 @@ bool X11Window::windowEvent(xcb_generic_event_t *e)
     info->event(e, &dirtyProperties, &dirtyProperties2); // pass through the NET stuff
 
     if ((dirtyProperties & NET::WMName) != 0) {
-        fetchName();
+        scheduleUpdate(DeferredUpdate::Name);
     }
     if ((dirtyProperties & NET::WMIconName) != 0) {
-        fetchIconicName();
+        scheduleUpdate(DeferredUpdate::IconicName);
     }
     if ((dirtyProperties & NET::WMIcon) != 0) {
-        getIcons();
+        scheduleUpdate(DeferredUpdate::Icons);
     }
     if ((dirtyProperties2 & NET::WM2UserTime) != 0) {
         updateUserTime(info->userTime());
@@ -511,6 +511,32 @@ void X11Window::configureRequestEvent(xcb_configure_request_event_t *e)
     // may get XRANDR resize event before kwin), but check it's still at the bottom?
 }
 
+void X11Window::scheduleUpdate(DeferredUpdate update)
+{
+    if (!m_deferredUpdates) {
+        QMetaObject::invokeMethod(this, &X11Window::performDeferredUpdates, Qt::QueuedConnection);
+    }
+    m_deferredUpdates |= update;
+}
+
+void X11Window::performDeferredUpdates()
+{
+    const DeferredUpdates updates = std::exchange(m_deferredUpdates, DeferredUpdates());
+    if (isDeleted()) {
+        return;
+    }
+
+    if (updates & DeferredUpdate::Name) {
+        fetchName();
+    }
+    if (updates & DeferredUpdate::IconicName) {
+        fetchIconicName();
+    }
+    if (updates & DeferredUpdate::Icons) {
+        getIcons();
+    }
+}
+
 /**
  * Handles property changes of the client window
  */
@@ -521,16 +547,16 @@ void X11Window::propertyNotifyEvent(xcb_property_notify_event_t *e)
         getWmNormalHints();
         break;
     case XCB_ATOM_WM_NAME:
-        fetchName();
+        scheduleUpdate(DeferredUpdate::Name);
         break;
     case XCB_ATOM_WM_ICON_NAME:
-        fetchIconicName();
+        scheduleUpdate(DeferredUpdate::IconicName);
         break;
     case XCB_ATOM_WM_TRANSIENT_FOR:
         readTransient();
         break;
     case XCB_ATOM_WM_HINTS:
-        getIcons(); // because KWin::icon() uses WMHints as fallback
+        scheduleUpdate(DeferredUpdate::Icons); // because KWin::icon() uses WMHints as fallback
         break;
     default:
         if (e->atom == atoms->motif_wm_hints) {
@@ -13,14 +13,117 @@
 namespace KWin
 {
 
+FocusChain::Chain::Chain(const Chain &other)
+{
+    *this = other;
+}
+
+FocusChain::Chain &FocusChain::Chain::operator=(const Chain &other)
+{
+    if (this == &other) {
+        return *this;
+    }
+    // the indexed positions point into the other list, they need to be rebuilt
+    m_windows = other.m_windows;
+    m_positions.clear();
+    m_positions.reserve(other.m_positions.size());
+    for (auto it = m_windows.begin(); it != m_windows.end(); ++it) {
+        m_positions.insert(*it, it);
+    }
+    return *this;
+}
+
+bool FocusChain::Chain::isEmpty() const
+{
+    return m_windows.empty();
+}
+
+bool FocusChain::Chain::contains(Window *window) const
+{
+    return m_positions.contains(window);
+}
+
+Window *FocusChain::Chain::first() const
+{
+    return m_windows.front();
+}
+
+Window *FocusChain::Chain::last() const
+{
+    return m_windows.back();
+}
+
+Window *FocusChain::Chain::previous(Window *window) const
+{
+    const auto it = m_positions.constFind(window);
+    if (it == m_positions.constEnd() || *it == m_windows.begin()) {
+        return nullptr;
+    }
+    return *std::prev(*it);
+}
+
+void FocusChain::Chain::insert(List::const_iterator position, Window *window)
+{
+    m_positions.insert(window, m_windows.insert(position, window));
+}
+
+void FocusChain::Chain::append(Window *window)
+{
+    insert(m_windows.cend(), window);
+}
+
+void FocusChain::Chain::prepend(Window *window)
+{
+    insert(m_windows.cbegin(), window);
+}
+
+void FocusChain::Chain::insertBefore(Window *window, Window *reference)
+{
+    insert(m_positions.value(reference), window);
+}
+
+void FocusChain::Chain::insertAfter(Window *window, Window *reference)
+{
+    insert(std::next(m_positions.value(reference)), window);
+}
+
+void FocusChain::Chain::remove(Window *window)
+{
+    const auto it = m_positions.constFind(window);
+    if (it != m_positions.constEnd()) {
+        m_windows.erase(*it);
+        m_positions.erase(it);
+    }
+}
+
+FocusChain::Chain::List::const_iterator FocusChain::Chain::begin() const
+{
+    return m_windows.cbegin();
+}
+
+FocusChain::Chain::List::const_iterator FocusChain::Chain::end() const
+{
+    return m_windows.cend();
+}
+
+FocusChain::Chain::List::const_reverse_iterator FocusChain::Chain::rbegin() const
+{
+    return m_windows.crbegin();
+}
+
+FocusChain::Chain::List::const_reverse_iterator FocusChain::Chain::rend() const
+{
+    return m_windows.crend();
+}
+
 void FocusChain::remove(Window *window)
 {
     for (auto it = m_desktopFocusChains.begin();
          it != m_desktopFocusChains.end();
          ++it) {
-        it.value().removeAll(window);
+        it.value().remove(window);
     }
-    m_mostRecentlyUsed.removeAll(window);
+    m_mostRecentlyUsed.remove(window);
 }
 
 void FocusChain::addDesktop(VirtualDesktop *desktop)
@@ -48,8 +151,8 @@ Window *FocusChain::getForActivation(VirtualDesktop *desktop, LogicalOutput *out
         return nullptr;
     }
     const auto &chain = it.value();
-    for (int i = chain.size() - 1; i >= 0; --i) {
-        auto tmp = chain.at(i);
+    for (auto chainIt = chain.rbegin(); chainIt != chain.rend(); ++chainIt) {
+        Window *tmp = *chainIt;
         // TODO: move the check into Window
         if (tmp->isShown() && tmp->isOnCurrentActivity()
             && (!m_separateScreenFocus || tmp->output() == output)) {
@@ -94,7 +197,7 @@ void FocusChain::update(Window *window, FocusChain::Change change)
             if (window->isOnDesktop(it.key())) {
                 updateWindowInChain(window, change, chain);
             } else {
-                chain.removeAll(window);
+                chain.remove(window);
             }
         }
     }
@@ -122,9 +225,9 @@ void FocusChain::insertWindowIntoChain(Window *window, Chain &chain)
     if (chain.contains(window)) {
         return;
     }
-    if (m_activeWindow && m_activeWindow != window && !chain.empty() && chain.last() == m_activeWindow) {
+    if (m_activeWindow && m_activeWindow != window && !chain.isEmpty() && chain.last() == m_activeWindow) {
         // Add it after the active window
-        chain.insert(chain.size() - 1, window);
+        chain.insertBefore(window, m_activeWindow);
     } else {
         // Otherwise add as the first one
         chain.append(window);
@@ -186,13 +289,13 @@ void FocusChain::moveAfterWindowInChain(Window *window, Window *reference, Chain
         return;
     }
     if (Window::belongToSameApplication(reference, window)) {
-        chain.removeAll(window);
-        chain.insert(chain.indexOf(reference), window);
+        chain.remove(window);
+        chain.insertBefore(window, reference);
     } else {
-        chain.removeAll(window);
-        for (int i = 0; i < chain.size(); ++i) {
-            if (Window::belongToSameApplication(reference, chain.at(i))) {
-                chain.insert(i, window);
+        chain.remove(window);
+        for (Window *other : chain) {
+            if (Window::belongToSameApplication(reference, other)) {
+                chain.insertBefore(window, other);
                 break;
             }
         }
@@ -208,13 +311,13 @@ void FocusChain::moveBeforeWindowInChain(Window *window, Window *reference, Chai
         return;
     }
     if (Window::belongToSameApplication(reference, window)) {
-        chain.removeAll(window);
-        chain.insert(chain.indexOf(reference) + 1, window);
+        chain.remove(window);
+        chain.insertAfter(window, reference);
     } else {
-        chain.removeAll(window);
-        for (int i = chain.size() - 1; i >= 0; --i) {
-            if (Window::belongToSameApplication(reference, chain.at(i))) {
-                chain.insert(i + 1, window);
+        chain.remove(window);
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            if (Window::belongToSameApplication(reference, *it)) {
+                chain.insertAfter(window, *it);
                 break;
             }
         }
@@ -234,20 +337,19 @@ Window *FocusChain::nextMostRecentlyUsed(Window *reference) const
     if (m_mostRecentlyUsed.isEmpty()) {
         return nullptr;
     }
-    const int index = m_mostRecentlyUsed.indexOf(reference);
-    if (index == -1) {
+    if (!m_mostRecentlyUsed.contains(reference)) {
         return m_mostRecentlyUsed.first();
     }
-    if (index == 0) {
-        return m_mostRecentlyUsed.last();
+    if (Window *previous = m_mostRecentlyUsed.previous(reference)) {
+        return previous;
     }
-    return m_mostRecentlyUsed.at(index - 1);
+    return m_mostRecentlyUsed.last();
 }
 
 // copied from activation.cpp
 bool FocusChain::isUsableFocusCandidate(Window *c, Window *prev) const
 {
-    return c != prev && c->isShown() && c->isOnCurrentDesktop() && c->isOnCurrentActivity() && (!m_separateScreenFocus || c->isOnOutput(prev ? prev->output() : workspace()->activeOutput()));
+    return c != prev && c->isShownOnCurrentDesktop() && (!m_separateScreenFocus || c->isOnOutput(prev ? prev->output() : workspace()->activeOutput()));
 }
 
 Window *FocusChain::nextForDesktop(Window *reference, VirtualDesktop *desktop) const
@@ -257,8 +359,8 @@ Window *FocusChain::nextForDesktop(Window *reference, VirtualDesktop *desktop) c
         return nullptr;
     }
     const auto &chain = it.value();
-    for (int i = chain.size() - 1; i >= 0; --i) {
-        auto window = chain.at(i);
+    for (auto chainIt = chain.rbegin(); chainIt != chain.rend(); ++chainIt) {
+        Window *window = *chainIt;
         if (isUsableFocusCandidate(window, reference)) {
             return window;
         }
@@ -271,7 +373,10 @@ void FocusChain::makeFirstInChain(Window *window, Chain &chain)
     if (window->isDeleted()) {
         return;
     }
-    chain.removeAll(window);
+    if (!chain.isEmpty() && chain.last() == window) {
+        return;
+    }
+    chain.remove(window);
     chain.append(window);
 }
 
@@ -280,7 +385,10 @@ void FocusChain::makeLastInChain(Window *window, Chain &chain)
     if (window->isDeleted()) {
         return;
     }
-    chain.removeAll(window);
+    if (!chain.isEmpty() && chain.first() == window) {
+        return;
+    }
+    chain.remove(window);
     chain.prepend(window);
 }
 
@@ -13,6 +13,8 @@
 #include <QHash>
 #include <QObject>
 
+#include <list>
+
 namespace KWin
 {
 // forward declarations
@@ -27,8 +29,9 @@ class VirtualDesktop;
  *
  * Internally this FocusChain holds multiple independent chains. There is one chain of most recently
  * used Windows which is primarily used by TabBox to build up the list of Windows for navigation.
- * The chains are organized as a normal QList of Windows with the most recently used Window being the
- * last item of the list, that is a LIFO like structure.
+ * The chains are organized as linked lists of Windows with the most recently used Window being the
+ * last item of the list, that is a LIFO like structure. Every chain indexes the position of its
+ * Windows, so that looking up, moving and removing a Window doesn't need to walk the chain.
  *
  * In addition there is one chain for each virtual desktop which is used to determine which Window
  * should get activated when the user switches to another virtual desktop.
@@ -181,7 +184,47 @@ public Q_SLOTS:
     void removeDesktop(VirtualDesktop *desktop);
 
 private:
-    using Chain = QList<Window *>;
+    class Chain
+    {
+    public:
+        using List = std::list<Window *>;
+
+        Chain() = default;
+        Chain(const Chain &other);
+        Chain &operator=(const Chain &other);
+
+        bool isEmpty() const;
+        bool contains(Window *window) const;
+        Window *first() const;
+        Window *last() const;
+        /**
+         * Returns the Window in front of @p window, or @c null if @p window is the first one.
+         */
+        Window *previous(Window *window) const;
+
+        void append(Window *window);
+        void prepend(Window *window);
+        /**
+         * Inserts @p window in front of @p reference, which has to be in the chain.
+         */
+        void insertBefore(Window *window, Window *reference);
+        /**
+         * Inserts @p window behind @p reference, which has to be in the chain.
+         */
+        void insertAfter(Window *window, Window *reference);
+        void remove(Window *window);
+
+        List::const_iterator begin() const;
+        List::const_iterator end() const;
+        List::const_reverse_iterator rbegin() const;
+        List::const_reverse_iterator rend() const;
+
+    private:
+        void insert(List::const_iterator position, Window *window);
+
+        List m_windows;
+        QHash<Window *, List::iterator> m_positions;
+    };
     /**
      * @brief Makes @p window the first Window in the given focus @p chain.
      *
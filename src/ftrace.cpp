@@ -18,6 +18,10 @@
 #include <QScopeGuard>
 #include <QTextStream>
 
+#include <fcntl.h>
+#include <tuple>
+#include <unistd.h>
+
 namespace KWin
 {
 KWIN_SINGLETON_FACTORY(KWin::FTraceLogger)
@@ -34,7 +38,7 @@ FTraceLogger::FTraceLogger(QObject *parent)
 
 bool FTraceLogger::isEnabled() const
 {
-    return m_file.isOpen();
+    return m_enabled.load(std::memory_order_relaxed);
 }
 
 void FTraceLogger::setEnabled(bool enabled)
@@ -45,27 +49,45 @@ void FTraceLogger::setEnabled(bool enabled)
     }
 
     if (enabled) {
-        open();
-    } else {
-        m_file.close();
+        if (!open()) {
+            return;
+        }
     }
+    // the file stays open after disabling, other threads might still be writing to it
+    m_enabled.store(enabled, std::memory_order_relaxed);
     Q_EMIT enabledChanged();
 }
 
 bool FTraceLogger::open()
 {
+    if (m_fd.load(std::memory_order_relaxed) != -1) {
+        return true;
+    }
+
     const QString path = filePath();
     if (path.isEmpty()) {
         return false;
     }
 
-    m_file.setFileName(path);
-    if (!m_file.open(QIODevice::WriteOnly)) {
+    const int fd = ::open(QFile::encodeName(path).constData(), O_WRONLY | O_CLOEXEC);
+    if (fd == -1) {
         qWarning() << "No access to trace marker file at:" << path;
+        return false;
     }
+    m_fd.store(fd, std::memory_order_release);
     return true;
 }
 
+void FTraceLogger::write(const QByteArray &message)
+{
+    const int fd = m_fd.load(std::memory_order_acquire);
+    if (fd == -1) {
+        return;
+    }
+    // short writes are not retried, the trace marker file accepts a whole message at once
+    std::ignore = ::write(fd, message.constData(), message.size());
+}
+
 QString FTraceLogger::filePath()
 {
     if (qEnvironmentVariableIsSet("KWIN_PERF_FTRACE_FILE")) {
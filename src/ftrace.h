@@ -11,12 +11,15 @@
 
 #include "effect/globals.h"
 
-#include <QFile>
+#include <QByteArray>
 #include <QMutex>
-#include <QMutexLocker>
 #include <QObject>
+#include <QString>
 #include <QTextStream>
 
+#include <atomic>
+#include <concepts>
+
 namespace KWin
 {
 /**
@@ -26,6 +29,10 @@ namespace KWin
  *  Set the KWIN_PERF_FTRACE environment variable before starting the application
  *  Calling on DBus /FTrace org.kde.kwin.FTrace.setEnabled true
  * After having created the ftrace mount
+ *
+ * Writing a message doesn't take any locks, the message is formatted into a thread local
+ * buffer and written to the trace marker file with a single write() call. This makes it
+ * cheap enough to keep tracing enabled while measuring frame timings.
  */
 class KWIN_EXPORT FTraceLogger : public QObject
 {
@@ -47,12 +54,31 @@ public:
     void trace(Args... args)
     {
         Q_ASSERT(isEnabled());
-        QMutexLocker lock(&m_mutex);
-        if (!m_file.isOpen()) {
-            return;
+        thread_local QByteArray buffer;
+        buffer.resize(0);
+        (format(buffer, args), ...);
+        buffer.append('\n');
+        write(buffer);
+    }
+
+    /**
+     * Appends the textual representation of \a value to \a buffer
+     */
+    template<typename T>
+    static void format(QByteArray &buffer, const T &value)
+    {
+        if constexpr (std::is_same_v<T, QByteArray>) {
+            buffer.append(value);
+        } else if constexpr (std::is_same_v<T, QString>) {
+            buffer.append(value.toUtf8());
+        } else if constexpr (std::is_convertible_v<T, const char *>) {
+            buffer.append(static_cast<const char *>(value));
+        } else if constexpr (std::integral<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>) {
+            buffer.append(QByteArray::number(value));
+        } else {
+            QTextStream stream(&buffer, QIODevice::WriteOnly | QIODevice::Append);
+            stream << value;
         }
-        QTextStream stream(&m_file);
-        (stream << ... << args) << Qt::endl;
     }
 
 Q_SIGNALS:
@@ -64,7 +90,10 @@ public Q_SLOTS:
 private:
     static QString filePath();
     bool open();
-    QFile m_file;
+    void write(const QByteArray &message);
+
+    std::atomic<int> m_fd = -1;
+    std::atomic<bool> m_enabled = false;
     QMutex m_mutex;
     KWIN_SINGLETON(FTraceLogger)
 };
@@ -76,9 +105,7 @@ public:
     FTraceDuration(Args... args)
     {
         static QAtomicInteger<quint32> s_context = 0;
-        QTextStream stream(&m_message);
-        (stream << ... << args);
-        stream.flush();
+        (FTraceLogger::format(m_message, args), ...);
         m_context = ++s_context;
         FTraceLogger::self()->trace(m_message, " begin_ctx=", m_context);
     }
@@ -99,9 +126,14 @@ private:
     if (KWin::FTraceLogger::self()->isEnabled()) \
         KWin::FTraceLogger::self()->trace(__VA_ARGS__);
 
+#define KWIN_FTRACE_CONCAT_IMPL(a, b) a##b
+#define KWIN_FTRACE_CONCAT(a, b) KWIN_FTRACE_CONCAT_IMPL(a, b)
+
 /**
  * Will insert two markers into the log. Once when called, and the second at the end of the relevant block
  * In GPUVis this will appear as a timed block with begin_ctx and end_ctx markers
+ *
+ * Several durations can be opened in the same scope, they'll show up as nested blocks
  */
 #define fTraceDuration(...) \
-    std::unique_ptr<KWin::FTraceDuration> _duration(KWin::FTraceLogger::self()->isEnabled() ? new KWin::FTraceDuration(__VA_ARGS__) : nullptr);
+    std::unique_ptr<KWin::FTraceDuration> KWIN_FTRACE_CONCAT(_duration, __LINE__)(KWin::FTraceLogger::self()->isEnabled() ? new KWin::FTraceDuration(__VA_ARGS__) : nullptr);
@@ -0,0 +1,83 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "geometryupdatebarrier.h"
+#include "core/backendoutput.h"
+#include "core/outputbackend.h"
+#include "core/renderloop.h"
+#include "main.h"
+#include "window.h"
+
+using namespace std::chrono_literals;
+
+namespace KWin
+{
+
+// long enough for clients to redraw at the new size, short enough not to be taken for a hang
+static constexpr std::chrono::milliseconds s_timeout = 100ms;
+
+GeometryUpdateBarrier::GeometryUpdateBarrier(const QSet<Window *> &windows)
+    : m_pending(windows)
+{
+    const auto outputs = kwinApp()->outputBackend()->outputs();
+    for (BackendOutput *output : outputs) {
+        if (RenderLoop *renderLoop = output->renderLoop()) {
+            renderLoop->inhibit();
+            m_renderLoops.append(renderLoop);
+        }
+    }
+
+    for (Window *window : windows) {
+        connect(window, &Window::pendingConfigureApplied, this, [this, window]() {
+            release(window);
+        });
+        connect(window, &Window::closed, this, [this, window]() {
+            release(window);
+        });
+    }
+
+    m_timeout.setSingleShot(true);
+    connect(&m_timeout, &QTimer::timeout, this, &QObject::deleteLater);
+    m_timeout.start(s_timeout);
+}
+
+GeometryUpdateBarrier::~GeometryUpdateBarrier()
+{
+    for (RenderLoop *renderLoop : std::as_const(m_renderLoops)) {
+        if (renderLoop) {
+            renderLoop->uninhibit();
+        }
+    }
+}
+
+void GeometryUpdateBarrier::synchronize(const QList<Window *> &windows)
+{
+    QSet<Window *> pending;
+    for (Window *window : windows) {
+        if (!window->isDeleted() && window->hasPendingConfigure()) {
+            pending.insert(window);
+        }
+    }
+    // a single window can't get out of sync with anything
+    if (pending.size() < 2) {
+        return;
+    }
+    new GeometryUpdateBarrier(pending);
+}
+
+void GeometryUpdateBarrier::release(Window *window)
+{
+    window->disconnect(this);
+    m_pending.remove(window);
+    if (m_pending.isEmpty()) {
+        m_timeout.stop();
+        deleteLater();
+    }
+}
+
+} // namespace KWin
+
+#include "moc_geometryupdatebarrier.cpp"
@@ -0,0 +1,52 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+
+namespace KWin
+{
+
+class RenderLoop;
+class Window;
+
+/**
+ * The GeometryUpdateBarrier class holds back the frames of all outputs until a group of
+ * windows has applied the geometry it was asked to adopt, so that the windows are shown at
+ * their new place in the same frame rather than one after another.
+ *
+ * The barrier gives up after a short timeout, so a client that doesn't respond can't keep
+ * the screen frozen.
+ */
+class GeometryUpdateBarrier : public QObject
+{
+    Q_OBJECT
+
+public:
+    ~GeometryUpdateBarrier() override;
+
+    /**
+     * Holds the frames until every window in @p windows that has a pending configure has
+     * applied it. Does nothing if fewer than two windows are still waiting for the client.
+     */
+    static void synchronize(const QList<Window *> &windows);
+
+private:
+    explicit GeometryUpdateBarrier(const QSet<Window *> &windows);
+
+    void release(Window *window);
+
+    QSet<Window *> m_pending;
+    QList<QPointer<RenderLoop>> m_renderLoops;
+    QTimer m_timeout;
+};
+
+} // namespace KWin
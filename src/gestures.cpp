@@ -74,10 +74,10 @@ GestureRecognizer::~GestureRecognizer() = default;
 
 void GestureRecognizer::registerSwipeGesture(KWin::SwipeGesture *gesture)
 {
-    Q_ASSERT(!m_swipeGestures.contains(gesture));
+    Q_ASSERT(!m_swipeGestures.value(gesture->fingerCount()).contains(gesture));
     auto connection = connect(gesture, &QObject::destroyed, this, std::bind(&GestureRecognizer::unregisterSwipeGesture, this, gesture));
     m_destroyConnections.insert(gesture, connection);
-    m_swipeGestures << gesture;
+    m_swipeGestures[gesture->fingerCount()] << gesture;
 }
 
 void GestureRecognizer::unregisterSwipeGesture(KWin::SwipeGesture *gesture)
@@ -87,7 +87,13 @@ void GestureRecognizer::unregisterSwipeGesture(KWin::SwipeGesture *gesture)
         disconnect(it.value());
         m_destroyConnections.erase(it);
     }
-    m_swipeGestures.removeAll(gesture);
+    auto gestures = m_swipeGestures.find(gesture->fingerCount());
+    if (gestures != m_swipeGestures.end()) {
+        gestures->removeAll(gesture);
+        if (gestures->isEmpty()) {
+            m_swipeGestures.erase(gestures);
+        }
+    }
     if (m_activeSwipeGestures.removeOne(gesture)) {
         Q_EMIT gesture->cancelled();
     }
@@ -95,10 +101,10 @@ void GestureRecognizer::unregisterSwipeGesture(KWin::SwipeGesture *gesture)
 
 void GestureRecognizer::registerPinchGesture(KWin::PinchGesture *gesture)
 {
-    Q_ASSERT(!m_pinchGestures.contains(gesture));
+    Q_ASSERT(!m_pinchGestures.value(gesture->fingerCount()).contains(gesture));
     auto connection = connect(gesture, &QObject::destroyed, this, std::bind(&GestureRecognizer::unregisterPinchGesture, this, gesture));
     m_destroyConnections.insert(gesture, connection);
-    m_pinchGestures << gesture;
+    m_pinchGestures[gesture->fingerCount()] << gesture;
 }
 
 void GestureRecognizer::unregisterPinchGesture(KWin::PinchGesture *gesture)
@@ -108,7 +114,13 @@ void GestureRecognizer::unregisterPinchGesture(KWin::PinchGesture *gesture)
         disconnect(it.value());
         m_destroyConnections.erase(it);
     }
-    m_pinchGestures.removeAll(gesture);
+    auto gestures = m_pinchGestures.find(gesture->fingerCount());
+    if (gestures != m_pinchGestures.end()) {
+        gestures->removeAll(gesture);
+        if (gestures->isEmpty()) {
+            m_pinchGestures.erase(gestures);
+        }
+    }
     if (m_activePinchGestures.removeOne(gesture)) {
         Q_EMIT gesture->cancelled();
     }
@@ -121,11 +133,8 @@ int GestureRecognizer::startSwipeGesture(uint fingerCount, const QPointF &startP
         return 0;
     }
     int count = 0;
-    for (SwipeGesture *gesture : std::as_const(m_swipeGestures)) {
-        if (gesture->fingerCount() != fingerCount) {
-            continue;
-        }
-
+    const QList<SwipeGesture *> candidates = m_swipeGestures.value(fingerCount);
+    for (SwipeGesture *gesture : candidates) {
         // Only add gestures who's direction aligns with current swipe axis
         switch (gesture->direction()) {
         case SwipeDirection::Up:
@@ -261,11 +270,8 @@ int GestureRecognizer::startPinchGesture(uint fingerCount)
     if (!m_activeSwipeGestures.isEmpty() || !m_activePinchGestures.isEmpty()) {
         return 0;
     }
-    for (PinchGesture *gesture : std::as_const(m_pinchGestures)) {
-        if (gesture->fingerCount() != fingerCount) {
-            continue;
-        }
-
+    const QList<PinchGesture *> candidates = m_pinchGestures.value(fingerCount);
+    for (PinchGesture *gesture : candidates) {
         // direction doesn't matter yet
         m_activePinchGestures << gesture;
         count++;
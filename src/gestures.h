@@ -11,6 +11,7 @@
 #include "effect/globals.h"
 #include <kwin_export.h>
 
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QObject>
@@ -142,8 +143,10 @@ private:
         None,
     };
     int startSwipeGesture(uint fingerCount, const QPointF &startPos);
-    QList<SwipeGesture *> m_swipeGestures;
-    QList<PinchGesture *> m_pinchGestures;
+    // the registered gestures by finger count, only the ones matching the fingers on the
+    // device need to be looked at when a gesture starts
+    QHash<uint32_t, QList<SwipeGesture *>> m_swipeGestures;
+    QHash<uint32_t, QList<PinchGesture *>> m_pinchGestures;
     QList<SwipeGesture *> m_activeSwipeGestures;
     QList<PinchGesture *> m_activePinchGestures;
     QMap<Gesture *, QMetaObject::Connection> m_destroyConnections;
@@ -14,6 +14,11 @@
 namespace KWin
 {
 
+HideCursorSpy::HideCursorSpy()
+    : InputEventSpy(InputEventType::Pointer | InputEventType::Touch | InputEventType::Tablet)
+{
+}
+
 void HideCursorSpy::pointerMotion(PointerMotionEvent *event)
 {
     if (!event->warp) {
@@ -15,6 +15,8 @@ namespace KWin
 class HideCursorSpy : public InputEventSpy
 {
 public:
+    HideCursorSpy();
+
     void pointerMotion(KWin::PointerMotionEvent *event) override;
     void pointerButton(KWin::PointerButtonEvent *event) override;
     void pointerAxis(KWin::PointerAxisEvent *event) override;
@@ -18,7 +18,7 @@ IdleDetector::IdleDetector(std::chrono::milliseconds timeout, OperatingMode mode
     , m_mode(mode)
 {
     Q_ASSERT(timeout >= 0ms);
-    m_timer.start(timeout, this);
+    m_since = std::chrono::steady_clock::now();
 
     input()->addIdleDetector(this);
 }
@@ -30,14 +30,6 @@ IdleDetector::~IdleDetector()
     }
 }
 
-void IdleDetector::timerEvent(QTimerEvent *event)
-{
-    if (event->timerId() == m_timer.timerId()) {
-        m_timer.stop();
-        markAsIdle();
-    }
-}
-
 IdleDetector::OperatingMode IdleDetector::mode() const
 {
     return m_mode;
@@ -58,18 +50,31 @@ void IdleDetector::setInhibited(bool inhibited)
         return;
     }
     m_isInhibited = inhibited;
-    if (inhibited) {
-        m_timer.stop();
-    } else {
-        m_timer.start(m_timeout, this);
+    if (!inhibited) {
+        m_since = std::chrono::steady_clock::now();
+        input()->scheduleIdleDetection();
+    }
+}
+
+bool IdleDetector::isIdle() const
+{
+    return m_isIdle;
+}
+
+std::optional<std::chrono::steady_clock::time_point> IdleDetector::idleDeadline(std::chrono::steady_clock::time_point lastActivity) const
+{
+    if (m_isIdle || m_isInhibited) {
+        return std::nullopt;
     }
+    return std::max(m_since, lastActivity) + m_timeout;
 }
 
 void IdleDetector::activity()
 {
     if (!m_isInhibited) {
-        m_timer.start(m_timeout, this);
+        m_since = std::chrono::steady_clock::now();
         markAsResumed();
+        input()->scheduleIdleDetection();
     }
 }
 
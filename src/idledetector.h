@@ -8,12 +8,21 @@
 
 #include <kwin_export.h>
 
-#include <QBasicTimer>
 #include <QObject>
 
+#include <chrono>
+#include <optional>
+
 namespace KWin
 {
 
+/**
+ * The IdleDetector class notifies when the user has been inactive for a given amount of time.
+ *
+ * The detectors don't run timers of their own. InputRedirection records the time of the last
+ * user activity and arms a single timer for the earliest deadline of all detectors, so input
+ * events only need to store a timestamp.
+ */
 class KWIN_EXPORT IdleDetector : public QObject
 {
     Q_OBJECT
@@ -34,22 +43,30 @@ public:
     bool isInhibited() const;
     void setInhibited(bool inhibited);
 
+    bool isIdle() const;
+
+    /**
+     * Returns the time at which the detector becomes idle if there's no activity after
+     * @a lastActivity, or @c std::nullopt if the detector is already idle or inhibited.
+     */
+    std::optional<std::chrono::steady_clock::time_point> idleDeadline(std::chrono::steady_clock::time_point lastActivity) const;
+
 Q_SIGNALS:
     void idle();
     void resumed();
 
-protected:
-    void timerEvent(QTimerEvent *event) override;
-
 private:
     void markAsIdle();
     void markAsResumed();
 
-    QBasicTimer m_timer;
+    // the time since which the detector counts, activity before it doesn't matter
+    std::chrono::steady_clock::time_point m_since;
     std::chrono::milliseconds m_timeout;
     bool m_isIdle = false;
     bool m_isInhibited = false;
     OperatingMode m_mode = OperatingMode::FollowsInhibitors;
+
+    friend class InputRedirection;
 };
 
 } // namespace KWin
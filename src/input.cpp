@@ -51,6 +51,7 @@
 #include "wayland/surface.h"
 #include "wayland/tablet_v2.h"
 #include "wayland_server.h"
+#include "windowhittestindex.h"
 #include "workspace.h"
 #include "xdgactivationv1.h"
 #include "xkb.h"
@@ -82,8 +83,9 @@ using namespace std::literals;
 namespace KWin
 {
 
-InputEventFilter::InputEventFilter(InputFilterOrder::Order weight)
+InputEventFilter::InputEventFilter(InputFilterOrder::Order weight, InputEventTypes eventTypes)
     : m_weight(weight)
+    , m_eventTypes(eventTypes)
 {
 }
 
@@ -99,6 +101,27 @@ int InputEventFilter::weight() const
     return m_weight;
 }
 
+InputEventTypes InputEventFilter::eventTypes() const
+{
+    return m_eventTypes;
+}
+
+bool InputEventFilter::isActive() const
+{
+    return m_active;
+}
+
+void InputEventFilter::setActive(bool active)
+{
+    if (m_active == active) {
+        return;
+    }
+    m_active = active;
+    if (input()) {
+        input()->updateInputEventFilter(this);
+    }
+}
+
 bool InputEventFilter::pointerMotion(PointerMotionEvent *event)
 {
     return false;
@@ -261,6 +284,7 @@ bool InputEventFilter::passToInputMethod(KeyboardKeyEvent *event)
     if (auto keyboardGrab = kwinApp()->inputMethod()->keyboardGrab()) {
         const auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(event->timestamp);
         keyboardGrab->sendKey(waylandServer()->display()->nextSerial(), std::chrono::duration_cast<std::chrono::milliseconds>(timestamp).count(), event->nativeScanCode, event->state);
+        kwinApp()->inputMethod()->keyForwarded();
         return true;
     } else {
         kwinApp()->inputMethod()->commitPendingText();
@@ -272,7 +296,7 @@ class VirtualTerminalFilter : public InputEventFilter
 {
 public:
     VirtualTerminalFilter()
-        : InputEventFilter(InputFilterOrder::VirtualTerminal)
+        : InputEventFilter(InputFilterOrder::VirtualTerminal, InputEventType::Keyboard)
     {
     }
     bool keyboardKey(KeyboardKeyEvent *event) override
@@ -294,7 +318,7 @@ class LockScreenFilter : public InputEventFilter
 {
 public:
     LockScreenFilter()
-        : InputEventFilter(InputFilterOrder::LockScreen)
+        : InputEventFilter(InputFilterOrder::LockScreen, InputEventType::Pointer | InputEventType::Keyboard | InputEventType::Touch | InputEventType::Gesture)
     {
     }
     bool pointerMotion(PointerMotionEvent *event) override
@@ -533,7 +557,7 @@ class EffectsFilter : public InputEventFilter
 {
 public:
     EffectsFilter()
-        : InputEventFilter(InputFilterOrder::Effects)
+        : InputEventFilter(InputFilterOrder::Effects, InputEventType::Pointer | InputEventType::Keyboard | InputEventType::Touch | InputEventType::Tablet)
     {
     }
     bool pointerMotion(PointerMotionEvent *event) override
@@ -665,7 +689,7 @@ class MoveResizeFilter : public InputEventFilter
 {
 public:
     MoveResizeFilter()
-        : InputEventFilter(InputFilterOrder::InteractiveMoveResize)
+        : InputEventFilter(InputFilterOrder::InteractiveMoveResize, InputEventType::Pointer | InputEventType::Keyboard | InputEventType::Touch | InputEventType::Tablet)
     {
     }
     bool pointerMotion(PointerMotionEvent *event) override
@@ -808,16 +832,17 @@ class WindowSelectorFilter : public InputEventFilter
 {
 public:
     WindowSelectorFilter()
-        : InputEventFilter(InputFilterOrder::WindowSelector)
+        : InputEventFilter(InputFilterOrder::WindowSelector, InputEventType::Pointer | InputEventType::Keyboard | InputEventType::Touch | InputEventType::Tablet)
     {
+        setActive(false);
     }
     bool pointerMotion(PointerMotionEvent *event) override
     {
-        return m_active;
+        return isActive();
     }
     bool pointerButton(PointerButtonEvent *event) override
     {
-        if (!m_active) {
+        if (!isActive()) {
             return false;
         }
         if (event->state == PointerButtonState::Released) {
@@ -834,11 +859,11 @@ public:
     bool pointerAxis(PointerAxisEvent *event) override
     {
         // filter out while selecting a window
-        return m_active;
+        return isActive();
     }
     bool keyboardKey(KeyboardKeyEvent *event) override
     {
-        if (!m_active) {
+        if (!isActive()) {
             return false;
         }
         waylandServer()->seat()->setFocusedKeyboardSurface(nullptr);
@@ -926,22 +951,18 @@ public:
         return true;
     }
 
-    bool isActive() const
-    {
-        return m_active;
-    }
     void start(std::function<void(Window *)> callback)
     {
-        Q_ASSERT(!m_active);
-        m_active = true;
+        Q_ASSERT(!isActive());
+        setActive(true);
         m_callback = callback;
         input()->keyboard()->update();
         input()->touch()->cancel();
     }
     void start(std::function<void(const QPoint &)> callback)
     {
-        Q_ASSERT(!m_active);
-        m_active = true;
+        Q_ASSERT(!isActive());
+        setActive(true);
         m_pointSelectionFallback = callback;
         input()->keyboard()->update();
         input()->touch()->cancel();
@@ -950,7 +971,7 @@ public:
 private:
     void deactivate()
     {
-        m_active = false;
+        setActive(false);
         m_callback = std::function<void(Window *)>();
         m_pointSelectionFallback = std::function<void(const QPoint &)>();
         input()->pointer()->removeWindowSelectionCursor();
@@ -979,7 +1000,6 @@ private:
         deactivate();
     }
 
-    bool m_active = false;
     std::function<void(Window *)> m_callback;
     std::function<void(const QPoint &)> m_pointSelectionFallback;
     QMap<quint32, QPointF> m_touchPoints;
@@ -1013,7 +1033,7 @@ class GlobalShortcutFilter : public InputEventFilter
 {
 public:
     GlobalShortcutFilter()
-        : InputEventFilter(InputFilterOrder::GlobalShortcut)
+        : InputEventFilter(InputFilterOrder::GlobalShortcut, InputEventType::Pointer | InputEventType::Keyboard | InputEventType::Touch | InputEventType::Gesture | InputEventType::Tablet)
     {
         m_powerDown.setSingleShot(true);
         m_powerDown.setInterval(1000);
@@ -1194,7 +1214,7 @@ public:
             if (m_touchPoints.count() >= 3 && !m_gestureCancelled) {
                 m_gestureTaken = true;
                 m_syntheticCancel = true;
-                input()->processFilters(&InputEventFilter::touchCancel);
+                input()->processFilters(InputEventType::Touch, &InputEventFilter::touchCancel);
                 m_syntheticCancel = false;
                 input()->shortcuts()->processSwipeStart(DeviceType::Touchscreen, m_touchPoints.count());
                 return true;
@@ -1386,7 +1406,7 @@ class InternalWindowEventFilter : public InputEventFilter
 {
 public:
     InternalWindowEventFilter()
-        : InputEventFilter(InputFilterOrder::InternalWindow)
+        : InputEventFilter(InputFilterOrder::InternalWindow, InputEventType::Pointer | InputEventType::Touch | InputEventType::Tablet)
     {
         m_touchDevice = std::make_unique<QPointingDevice>(QLatin1StringView("some touchscreen"), 0, QInputDevice::DeviceType::TouchScreen,
                                                           QPointingDevice::PointerType::Finger, QInputDevice::Capability::Position,
@@ -1597,7 +1617,7 @@ class DecorationEventFilter : public InputEventFilter
 {
 public:
     DecorationEventFilter()
-        : InputEventFilter(InputFilterOrder::Decoration)
+        : InputEventFilter(InputFilterOrder::Decoration, InputEventType::Pointer | InputEventType::Touch | InputEventType::Tablet)
     {
     }
     bool pointerMotion(PointerMotionEvent *event) override
@@ -1845,7 +1865,7 @@ class TabBoxInputFilter : public InputEventFilter
 {
 public:
     TabBoxInputFilter()
-        : InputEventFilter(InputFilterOrder::TabBox)
+        : InputEventFilter(InputFilterOrder::TabBox, InputEventType::Pointer | InputEventType::Keyboard)
     {
     }
     bool pointerMotion(PointerMotionEvent *event) override
@@ -1890,7 +1910,7 @@ class ScreenEdgeInputFilter : public InputEventFilter
 {
 public:
     ScreenEdgeInputFilter()
-        : InputEventFilter(InputFilterOrder::ScreenEdge)
+        : InputEventFilter(InputFilterOrder::ScreenEdge, InputEventType::Pointer | InputEventType::Touch)
     {
     }
     bool pointerMotion(PointerMotionEvent *event) override
@@ -1926,7 +1946,7 @@ class WindowActionInputFilter : public InputEventFilter
 {
 public:
     WindowActionInputFilter()
-        : InputEventFilter(InputFilterOrder::WindowAction)
+        : InputEventFilter(InputFilterOrder::WindowAction, InputEventType::Pointer | InputEventType::Touch | InputEventType::Tablet)
     {
     }
     bool pointerButton(PointerButtonEvent *event) override
@@ -2048,7 +2068,7 @@ class InputMethodEventFilter : public InputEventFilter
 {
 public:
     InputMethodEventFilter()
-        : InputEventFilter(InputFilterOrder::InputMethod)
+        : InputEventFilter(InputFilterOrder::InputMethod, InputEventType::Pointer | InputEventType::Keyboard | InputEventType::Touch)
     {
     }
 
@@ -2103,6 +2123,9 @@ public:
     }
     bool pointerMotion(PointerMotionEvent *event) override
     {
+        if (input()->pointer()->coalesceMotion(event)) {
+            return true;
+        }
         auto seat = waylandServer()->seat();
         seat->setTimestamp(event->timestamp);
         seat->notifyPointerMotion(event->position);
@@ -2124,6 +2147,10 @@ public:
     }
     bool pointerFrame() override
     {
+        // the frame is sent together with the coalesced motion
+        if (input()->pointer()->hasCoalescedMotion()) {
+            return true;
+        }
         auto seat = waylandServer()->seat();
         seat->notifyPointerFrame();
         return true;
@@ -2164,6 +2191,9 @@ public:
     }
     bool touchMotion(TouchMotionEvent *event) override
     {
+        if (input()->touch()->coalesceMotion(event)) {
+            return true;
+        }
         auto seat = waylandServer()->seat();
         seat->setTimestamp(event->time);
         seat->notifyTouchMotion(event->id, event->pos);
@@ -2183,6 +2213,10 @@ public:
     }
     bool touchFrame() override
     {
+        // the frame is sent together with the coalesced motion
+        if (input()->touch()->hasCoalescedMotion()) {
+            return true;
+        }
         waylandServer()->seat()->notifyTouchFrame();
         return true;
     }
@@ -2572,8 +2606,11 @@ class DragAndDropInputFilter : public QObject, public InputEventFilter
     Q_OBJECT
 public:
     DragAndDropInputFilter()
-        : InputEventFilter(InputFilterOrder::DragAndDrop)
+        : InputEventFilter(InputFilterOrder::DragAndDrop, InputEventType::Pointer | InputEventType::Keyboard | InputEventType::Touch | InputEventType::Tablet)
     {
+        // only needed while a drag is in progress
+        setActive(false);
+
         connect(waylandServer()->seat(), &SeatInterface::dragRequested, this, [](AbstractDataSource *source, SurfaceInterface *origin, quint32 serial, DragAndDropIcon *dragIcon) {
             if (auto window = waylandServer()->findWindow(origin->mainSurface())) {
                 QMatrix4x4 transformation = window->inputTransformation();
@@ -2604,6 +2641,7 @@ public:
         });
 
         connect(waylandServer()->seat(), &SeatInterface::dragStarted, this, [this]() {
+            setActive(true);
             AbstractDataSource *dragSource = waylandServer()->seat()->dragSource();
             if (!dragSource) {
                 return;
@@ -2622,6 +2660,7 @@ public:
         });
 
         connect(waylandServer()->seat(), &SeatInterface::dragEnded, this, [this] {
+            setActive(false);
             m_dragTarget = nullptr;
             m_lastPos.reset();
             if (m_currentToplevelDragWindow) {
@@ -2832,7 +2871,7 @@ private:
             if (!window->isClient()) {
                 continue;
             }
-            if (!window->isOnCurrentActivity() || !window->isOnCurrentDesktop() || window->isMinimized() || window->isHidden() || window->isHiddenByShowDesktop()) {
+            if (!window->isShownOnCurrentDesktop()) {
                 continue;
             }
             if (!window->readyForPainting()) {
@@ -2932,6 +2971,9 @@ InputRedirection::InputRedirection(QObject *parent)
 {
     setupInputBackends();
 
+    m_idleTimer.setSingleShot(true);
+    connect(&m_idleTimer, &QTimer::timeout, this, &InputRedirection::handleIdleTimeout);
+
     connect(kwinApp(), &Application::workspaceCreated, this, &InputRedirection::setupWorkspace);
 }
 
@@ -2951,21 +2993,62 @@ void InputRedirection::installInputEventFilter(InputEventFilter *filter)
         return a->weight() < b->weight();
     });
     m_filters.insert(it, filter);
+    rebuildFilterDispatch();
 }
 
 void InputRedirection::uninstallInputEventFilter(InputEventFilter *filter)
 {
-    m_filters.removeOne(filter);
+    if (m_filters.removeOne(filter)) {
+        rebuildFilterDispatch();
+    }
+}
+
+void InputRedirection::updateInputEventFilter(InputEventFilter *filter)
+{
+    if (m_filters.contains(filter)) {
+        rebuildFilterDispatch();
+    }
+}
+
+void InputRedirection::rebuildFilterDispatch()
+{
+    for (size_t i = 0; i < m_filterDispatch.size(); ++i) {
+        const InputEventType type = InputEventType(1 << i);
+        QList<InputEventFilter *> filters;
+        for (InputEventFilter *filter : std::as_const(m_filters)) {
+            if (filter->isActive() && filter->eventTypes().testFlag(type)) {
+                filters.append(filter);
+            }
+        }
+        m_filterDispatch[i] = filters;
+    }
 }
 
 void InputRedirection::installInputEventSpy(InputEventSpy *spy)
 {
     m_spies << spy;
+    rebuildSpyDispatch();
 }
 
 void InputRedirection::uninstallInputEventSpy(InputEventSpy *spy)
 {
-    m_spies.removeOne(spy);
+    if (m_spies.removeOne(spy)) {
+        rebuildSpyDispatch();
+    }
+}
+
+void InputRedirection::rebuildSpyDispatch()
+{
+    for (size_t i = 0; i < m_spyDispatch.size(); ++i) {
+        const InputEventType type = InputEventType(1 << i);
+        QList<InputEventSpy *> spies;
+        for (InputEventSpy *spy : std::as_const(m_spies)) {
+            if (spy->eventTypes().testFlag(type)) {
+                spies.append(spy);
+            }
+        }
+        m_spyDispatch[i] = spies;
+    }
 }
 
 void InputRedirection::init()
@@ -3282,8 +3365,8 @@ void InputRedirection::addInputDevice(InputDevice *device)
             .state = state,
             .timestamp = time,
         };
-        processSpies(&InputEventSpy::switchEvent, &event);
-        processFilters(&InputEventFilter::switchEvent, &event);
+        processSpies(InputEventType::Switch, &InputEventSpy::switchEvent, &event);
+        processFilters(InputEventType::Switch, &InputEventFilter::switchEvent, &event);
     });
 
     connect(device, &InputDevice::tabletToolAxisEvent,
@@ -3403,9 +3486,20 @@ Qt::MouseButtons InputRedirection::qtButtonStates() const
 
 void InputRedirection::simulateUserActivity()
 {
+    m_lastUserActivity = std::chrono::steady_clock::now();
+
+    // only detectors that went idle need to be told, the others see the new timestamp when
+    // the idle timer fires
+    bool resumed = false;
     const auto idleDetectors = m_idleDetectors; // the detector list can potentially change
     for (IdleDetector *idleDetector : idleDetectors) {
-        idleDetector->activity();
+        if (idleDetector->isIdle() && !idleDetector->isInhibited() && m_idleDetectors.contains(idleDetector)) {
+            idleDetector->markAsResumed();
+            resumed = true;
+        }
+    }
+    if (resumed || !m_idleTimer.isActive()) {
+        scheduleIdleDetection();
     }
 }
 
@@ -3414,6 +3508,38 @@ void InputRedirection::addIdleDetector(IdleDetector *detector)
     Q_ASSERT(!m_idleDetectors.contains(detector));
     detector->setInhibited(!m_idleInhibitors.isEmpty());
     m_idleDetectors.append(detector);
+    scheduleIdleDetection();
+}
+
+void InputRedirection::scheduleIdleDetection()
+{
+    std::optional<std::chrono::steady_clock::time_point> nearest;
+    for (const IdleDetector *idleDetector : std::as_const(m_idleDetectors)) {
+        if (const auto deadline = idleDetector->idleDeadline(m_lastUserActivity)) {
+            nearest = nearest ? std::min(*nearest, *deadline) : *deadline;
+        }
+    }
+    if (!nearest) {
+        m_idleTimer.stop();
+        return;
+    }
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(*nearest - std::chrono::steady_clock::now());
+    m_idleTimer.start(std::max(remaining, std::chrono::milliseconds::zero()));
+}
+
+void InputRedirection::handleIdleTimeout()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto idleDetectors = m_idleDetectors; // the detector list can potentially change
+    for (IdleDetector *idleDetector : idleDetectors) {
+        if (!m_idleDetectors.contains(idleDetector)) {
+            continue;
+        }
+        if (const auto deadline = idleDetector->idleDeadline(m_lastUserActivity); deadline && *deadline <= now) {
+            idleDetector->markAsIdle();
+        }
+    }
+    scheduleIdleDetection();
 }
 
 void InputRedirection::removeIdleDetector(IdleDetector *detector)
@@ -3457,24 +3583,8 @@ Window *InputRedirection::findToplevel(const QPointF &pos)
             return nullptr;
         }
     }
-    const QList<Window *> &stacking = Workspace::self()->stackingOrder();
-    if (stacking.isEmpty()) {
-        return nullptr;
-    }
-    auto it = stacking.end();
-    do {
-        --it;
-        Window *window = (*it);
-        if (window->isDeleted()) {
-            // a deleted window doesn't get mouse events
-            continue;
-        }
-        if (!window->isOnCurrentActivity() || !window->isOnCurrentDesktop() || window->isMinimized() || window->isHidden() || window->isHiddenByShowDesktop()) {
-            continue;
-        }
-        if (!window->readyForPainting()) {
-            continue;
-        }
+    // the index only contains windows that accept input, sorted from top to bottom
+    for (Window *window : Workspace::self()->hitTestIndex()->candidatesAt(pos)) {
         if (isScreenLocked) {
             if (!window->isLockScreen() && !window->isInputMethod() && !window->isLockScreenOverlay()) {
                 continue;
@@ -3483,7 +3593,7 @@ Window *InputRedirection::findToplevel(const QPointF &pos)
         if (window->hitTest(pos)) {
             return window;
         }
-    } while (it != stacking.begin());
+    }
     return nullptr;
 }
 
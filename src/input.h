@@ -15,11 +15,14 @@
 #include <QObject>
 #include <QPoint>
 #include <QPointer>
+#include <QTimer>
 
 #include <KConfigWatcher>
 #include <KSharedConfig>
 #include <QSet>
 
+#include <array>
+#include <bit>
 #include <functional>
 
 class KGlobalAccelInterface;
@@ -79,6 +82,21 @@ class DecoratedWindowImpl;
 class InputBackend;
 class InputDevice;
 
+/**
+ * The types of events an InputEventFilter or an InputEventSpy can be interested in.
+ */
+enum class InputEventType {
+    Pointer = 1 << 0,
+    Keyboard = 1 << 1,
+    Touch = 1 << 2,
+    Gesture = 1 << 3,
+    Switch = 1 << 4,
+    Tablet = 1 << 5,
+    All = Pointer | Keyboard | Touch | Gesture | Switch | Tablet,
+};
+Q_DECLARE_FLAGS(InputEventTypes, InputEventType)
+Q_DECLARE_OPERATORS_FOR_FLAGS(InputEventTypes)
+
 /**
  * @brief This class is responsible for redirecting incoming input to the surface which currently
  * has input or send enter/leave events.
@@ -131,6 +149,10 @@ public:
 
     void addIdleDetector(IdleDetector *detector);
     void removeIdleDetector(IdleDetector *detector);
+    /**
+     * Re-arms the idle timer for the earliest deadline of all idle detectors.
+     */
+    void scheduleIdleDetection();
 
     QList<Window *> idleInhibitors() const;
     void addIdleInhibitor(Window *inhibitor);
@@ -143,13 +165,15 @@ public:
     }
 
     /**
-     * Sends an event through all InputFilters.
+     * Sends an event through all active InputFilters interested in events of @p type.
      * The method is invoked on each input filter. Processing is stopped if
      * a filter returns @c true for it
      */
-    void processFilters(auto method, const auto &...args)
+    void processFilters(InputEventType type, auto method, const auto &...args)
     {
-        for (const auto filter : std::as_const(m_filters)) {
+        // take a copy, filters can get activated or deactivated while processing the event
+        const QList<InputEventFilter *> filters = m_filterDispatch[std::countr_zero(uint(type))];
+        for (const auto filter : filters) {
             if ((filter->*method)(args...)) {
                 return;
             }
@@ -157,12 +181,19 @@ public:
     }
 
     /**
-     * Sends an event through all input event spies.
+     * Updates the dispatch lists after @p filter has been activated or deactivated.
+     */
+    void updateInputEventFilter(InputEventFilter *filter);
+
+    /**
+     * Sends an event through all input event spies interested in events of @p type.
      * The method is invoked on each InputEventSpy.
      */
-    void processSpies(auto method, const auto &...args)
+    void processSpies(InputEventType type, auto method, const auto &...args)
     {
-        for (const auto spy : std::as_const(m_spies)) {
+        // take a copy, spies can get installed or uninstalled while processing the event
+        const QList<InputEventSpy *> spies = m_spyDispatch[std::countr_zero(uint(type))];
+        for (const auto spy : spies) {
             (spy->*method)(args...);
         }
     }
@@ -283,6 +314,9 @@ private:
     void setupInputFilters();
     void updateLeds(LEDs leds);
     void updateAvailableInputDevices();
+    void rebuildFilterDispatch();
+    void rebuildSpyDispatch();
+    void handleIdleTimeout();
     KeyboardInputRedirection *m_keyboard;
     PointerInputRedirection *m_pointer;
     TabletInputRedirection *m_tablet;
@@ -297,10 +331,17 @@ private:
 
     QList<IdleDetector *> m_idleDetectors;
     QList<Window *> m_idleInhibitors;
+    // input events only record the time, one timer fires for the earliest idle deadline
+    std::chrono::steady_clock::time_point m_lastUserActivity;
+    QTimer m_idleTimer;
     std::unique_ptr<WindowSelectorFilter> m_windowSelector;
 
     QList<InputEventFilter *> m_filters;
+    // the active filters for every InputEventType, in the order of m_filters
+    std::array<QList<InputEventFilter *>, 6> m_filterDispatch;
     QList<InputEventSpy *> m_spies;
+    // the spies for every InputEventType, in the order of m_spies
+    std::array<QList<InputEventSpy *>, 6> m_spyDispatch;
     KConfigWatcher::Ptr m_inputConfigWatcher;
 
     std::unique_ptr<InputEventFilter> m_virtualTerminalFilter;
@@ -387,6 +428,10 @@ enum Order {
  *
  * Deleting an instance of InputEventFilter automatically uninstalls it from
  * InputRedirection.
+ *
+ * A filter only sees the types of events it is interested in, and only while
+ * it is active. Filters that grab input only occasionally should be inactive
+ * the rest of the time, so that they aren't traversed for every event.
  */
 class KWIN_EXPORT InputEventFilter
 {
@@ -394,9 +439,10 @@ public:
     /**
      * Construct and install the InputEventFilter
      * @param weight The position in the input chain, lower values come first.
+     * @param eventTypes The types of events the filter gets to see.
      * @note the filter is not installed automatically
      */
-    InputEventFilter(InputFilterOrder::Order weight);
+    InputEventFilter(InputFilterOrder::Order weight, InputEventTypes eventTypes = InputEventType::All);
     /**
      * @brief ~InputEventFilter
      * This will uninstall the event filter if needed
@@ -408,6 +454,17 @@ public:
      */
     int weight() const;
 
+    /**
+     * The types of events the filter gets to see.
+     */
+    InputEventTypes eventTypes() const;
+
+    /**
+     * Whether the filter currently gets to see events. Filters are active by default.
+     */
+    bool isActive() const;
+    void setActive(bool active);
+
     virtual bool pointerMotion(PointerMotionEvent *event);
     virtual bool pointerButton(PointerButtonEvent *event);
     virtual bool pointerFrame();
@@ -461,6 +518,8 @@ protected:
 
 private:
     int m_weight = 0;
+    InputEventTypes m_eventTypes;
+    bool m_active = true;
 };
 
 class KWIN_EXPORT InputDeviceHandler : public QObject
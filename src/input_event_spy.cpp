@@ -14,7 +14,10 @@
 namespace KWin
 {
 
-InputEventSpy::InputEventSpy() = default;
+InputEventSpy::InputEventSpy(InputEventTypes eventTypes)
+    : m_eventTypes(eventTypes)
+{
+}
 
 InputEventSpy::~InputEventSpy()
 {
@@ -23,6 +26,11 @@ InputEventSpy::~InputEventSpy()
     }
 }
 
+InputEventTypes InputEventSpy::eventTypes() const
+{
+    return m_eventTypes;
+}
+
 void InputEventSpy::pointerMotion(PointerMotionEvent *event)
 {
 }
@@ -9,6 +9,8 @@
 #pragma once
 #include <kwin_export.h>
 
+#include "input.h"
+
 #include <QtGlobal>
 #include <chrono>
 
@@ -48,8 +50,9 @@ struct TouchUpEvent;
  * Base class for spying on input events inside InputRedirection.
  *
  * This class is quite similar to InputEventFilter, except that it does not
- * support event filtering. Each InputEventSpy gets to see all input events,
- * the processing happens prior to sending events through the InputEventFilters.
+ * support event filtering. Each InputEventSpy gets to see all input events of
+ * the types it is interested in, the processing happens prior to sending events
+ * through the InputEventFilters.
  *
  * Deleting an instance of InputEventSpy automatically uninstalls it from
  * InputRedirection.
@@ -57,9 +60,18 @@ struct TouchUpEvent;
 class KWIN_EXPORT InputEventSpy
 {
 public:
-    InputEventSpy();
+    /**
+     * @param eventTypes The types of events the spy gets to see.
+     * @note the spy is not installed automatically
+     */
+    explicit InputEventSpy(InputEventTypes eventTypes = InputEventType::All);
     virtual ~InputEventSpy();
 
+    /**
+     * The types of events the spy gets to see.
+     */
+    InputEventTypes eventTypes() const;
+
     virtual void pointerMotion(PointerMotionEvent *event);
     virtual void pointerButton(PointerButtonEvent *event);
     /**
@@ -103,6 +115,9 @@ public:
     virtual void tabletPadStripEvent(TabletPadStripEvent *event);
     virtual void tabletPadRingEvent(TabletPadRingEvent *event);
     virtual void tabletPadDialEvent(TabletPadDialEvent *event);
+
+private:
+    InputEventTypes m_eventTypes;
 };
 
 } // namespace KWin
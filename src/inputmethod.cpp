@@ -503,6 +503,7 @@ void InputMethod::setEnabled(bool enabled)
 
 void InputMethod::keysymReceived(quint32 serial, quint32 time, quint32 sym, KeyboardKeyState state, quint32 modifiers)
 {
+    reportRoundTrip("keysym");
     auto t2 = waylandServer()->seat()->textInputV2();
     if (t2 && t2->isEnabled()) {
         if (state != KeyboardKeyState::Released) {
@@ -528,6 +529,7 @@ void InputMethod::keysymReceived(quint32 serial, quint32 time, quint32 sym, Keyb
 
 void InputMethod::commitString(qint32 serial, const QString &text)
 {
+    reportRoundTrip("commit");
     if (auto t2 = waylandServer()->seat()->textInputV2(); t2 && t2->isEnabled()) {
         t2->commitString(text);
         t2->setPreEditCursor(0);
@@ -558,6 +560,21 @@ void InputMethod::commitString(qint32 serial, const QString &text)
     }
 }
 
+void InputMethod::keyForwarded()
+{
+    m_keyForwardedTime = std::chrono::steady_clock::now();
+}
+
+void InputMethod::reportRoundTrip(const char *response)
+{
+    if (!m_keyForwardedTime) {
+        return;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - *m_keyForwardedTime;
+    m_keyForwardedTime.reset();
+    qCDebug(KWIN_VIRTUALKEYBOARD) << "Input method responded to a key with" << response << "after" << std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+}
+
 void InputMethod::forwardKeySym(int keySym)
 {
     std::optional<Xkb::KeyCode> keyCode = input()->keyboard()->xkb()->keycodeFromKeysym(keySym);
@@ -663,6 +680,7 @@ void InputMethod::setPreeditStyling(quint32 index, quint32 length, quint32 style
 
 void InputMethod::setPreeditString(uint32_t serial, const QString &text, const QString &commit)
 {
+    reportRoundTrip("preedit");
     auto t2 = waylandServer()->seat()->textInputV2();
     if (t2 && t2->isEnabled()) {
         t2->preEdit(text, commit);
@@ -709,6 +727,7 @@ void InputMethod::setPreeditString(uint32_t serial, const QString &text, const Q
 
 void InputMethod::key(quint32 /*serial*/, quint32 time, quint32 keyCode, KeyboardKeyState state)
 {
+    reportRoundTrip("key");
     if (!input()->keyboard()) {
         return;
     }
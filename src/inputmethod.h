@@ -15,6 +15,8 @@
 #include <QPointer>
 #include <QTimer>
 
+#include <chrono>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -71,6 +73,12 @@ public:
 
     void commitPendingText();
 
+    /**
+     * Called when a key has been sent to the input method, the time until the input method
+     * responds to it is logged in the kwin_virtualkeyboard debug category.
+     */
+    void keyForwarded();
+
     // for use by the QPA
     InternalInputMethodContext *internalContext() const
     {
@@ -127,6 +135,7 @@ private:
     void refreshActive();
     void forwardKeyToEffects(KWin::KeyboardKeyState state, int keyCode, int keySym);
     void forwardKeySym(int keySym);
+    void reportRoundTrip(const char *response);
 
     // buffered till the preedit text is set
     struct
@@ -154,6 +163,7 @@ private:
     bool m_hasPendingModifiers = false;
     bool m_activeClientSupportsTextInput = false;
     bool m_shouldShowPanel = false;
+    std::optional<std::chrono::steady_clock::time_point> m_keyForwardedTime;
 };
 
 }
@@ -101,7 +101,8 @@ class KeyStateChangedSpy : public InputEventSpy
 {
 public:
     KeyStateChangedSpy(InputRedirection *input)
-        : m_input(input)
+        : InputEventSpy(InputEventType::Keyboard)
+        , m_input(input)
     {
     }
 
@@ -121,7 +122,8 @@ class ModifiersChangedSpy : public InputEventSpy
 {
 public:
     ModifiersChangedSpy(InputRedirection *input)
-        : m_input(input)
+        : InputEventSpy(InputEventType::Keyboard)
+        , m_input(input)
         , m_modifiers()
     {
     }
@@ -325,8 +327,8 @@ void KeyboardInputRedirection::processKey(uint32_t key, KeyboardKeyState state,
         }
     }
 
-    m_input->processSpies(&InputEventSpy::keyboardKey, &event);
-    m_input->processFilters(&InputEventFilter::keyboardKey, &event);
+    m_input->processSpies(InputEventType::Keyboard, &InputEventSpy::keyboardKey, &event);
+    m_input->processFilters(InputEventType::Keyboard, &InputEventFilter::keyboardKey, &event);
 
     if (state == KeyboardKeyState::Released) {
         m_filteredKeys.removeOne(key);
@@ -25,6 +25,7 @@ namespace KWin
 
 KeyboardLayout::KeyboardLayout(Xkb *xkb, const KSharedConfigPtr &config)
     : QObject()
+    , InputEventSpy(InputEventTypes())
     , m_xkb(xkb)
     , m_configWatcher(KConfigWatcher::create(config))
     , m_configGroup(config->group(QStringLiteral("Layout")))
@@ -21,22 +21,45 @@ namespace KWin
 
 KeyboardRepeat::KeyboardRepeat(Xkb *xkb)
     : QObject()
+    , InputEventSpy(InputEventType::Keyboard)
     , m_timer(new QTimer(this))
     , m_xkb(xkb)
 {
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
     connect(m_timer, &QTimer::timeout, this, &KeyboardRepeat::handleKeyRepeat);
 }
 
 KeyboardRepeat::~KeyboardRepeat() = default;
 
+void KeyboardRepeat::scheduleKeyRepeat()
+{
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(m_nextRepeat - std::chrono::steady_clock::now());
+    m_timer->start(std::max(remaining, std::chrono::milliseconds::zero()));
+}
+
 void KeyboardRepeat::handleKeyRepeat()
 {
     // TODO: don't depend on WaylandServer
     if (waylandServer()->seat()->keyboard()->keyRepeatRate() != 0) {
-        m_timer->setInterval(1000 / waylandServer()->seat()->keyboard()->keyRepeatRate());
+        m_interval = std::chrono::microseconds(1'000'000 / waylandServer()->seat()->keyboard()->keyRepeatRate());
+    }
+
+    // if the main thread was stuck for a while, deliver the repeats that were missed with their
+    // own timestamps, but not so many that the key seems to run away
+    constexpr int maxMissedRepeats = 4;
+    const auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i <= maxMissedRepeats && m_nextRepeat <= now; ++i) {
+        Q_EMIT keyRepeat(m_key, m_time);
+        m_nextRepeat += m_interval;
+        m_time += m_interval;
+    }
+    if (m_nextRepeat <= now) {
+        const auto skipped = (now - m_nextRepeat) / m_interval + 1;
+        m_nextRepeat += skipped * m_interval;
+        m_time += skipped * m_interval;
     }
-    // TODO: better time
-    Q_EMIT keyRepeat(m_key, m_time);
+    scheduleKeyRepeat();
 }
 
 void KeyboardRepeat::keyboardKey(KeyboardKeyEvent *event)
@@ -48,10 +71,12 @@ void KeyboardRepeat::keyboardKey(KeyboardKeyEvent *event)
     if (event->state == KeyboardKeyState::Pressed) {
         // TODO: don't get these values from WaylandServer
         if (m_xkb->shouldKeyRepeat(key) && waylandServer()->seat()->keyboard()->keyRepeatDelay() != 0) {
-            m_timer->setInterval(waylandServer()->seat()->keyboard()->keyRepeatDelay());
+            const std::chrono::milliseconds delay(waylandServer()->seat()->keyboard()->keyRepeatDelay());
+            m_interval = delay;
             m_key = key;
-            m_time = event->timestamp;
-            m_timer->start();
+            m_time = event->timestamp + delay;
+            m_nextRepeat = std::chrono::steady_clock::now() + delay;
+            scheduleKeyRepeat();
         }
     } else if (event->state == KeyboardKeyState::Released) {
         if (key == m_key) {
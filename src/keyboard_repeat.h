@@ -12,6 +12,8 @@
 
 #include <QObject>
 
+#include <chrono>
+
 class QTimer;
 
 namespace KWin
@@ -32,9 +34,15 @@ Q_SIGNALS:
 
 private:
     void handleKeyRepeat();
+    void scheduleKeyRepeat();
+
     QTimer *m_timer;
     Xkb *m_xkb;
+    // repeats are scheduled against absolute deadlines counted from the key press, so a busy
+    // main thread delays a repeat but doesn't shift all following ones
+    std::chrono::steady_clock::time_point m_nextRepeat;
     std::chrono::microseconds m_time;
+    std::chrono::microseconds m_interval;
     quint32 m_key = 0;
 };
 
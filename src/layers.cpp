@@ -83,6 +83,7 @@
 #include <array>
 
 #include <QDebug>
+#include <QHash>
 
 namespace KWin
 {
@@ -604,9 +605,20 @@ QList<Window *> Workspace::constrainedStackingOrder()
         }
     }
 
+    // Looking up the windows in the list would make applying the constraints quadratic, so their
+    // positions are kept on the side and updated as constraints move windows around.
+    QHash<Window *, int> positions;
+    positions.reserve(stacking.count());
+    for (int i = 0; i < stacking.count(); ++i) {
+        positions.insert(stacking[i], i);
+    }
+    auto positionOf = [&positions](Window *window) {
+        return positions.value(window, -1);
+    };
+
     // Preserve the relative order of transient siblings in the unconstrained stacking order.
-    auto constraintComparator = [&stacking](Constraint *a, Constraint *b) {
-        return stacking.indexOf(a->above) > stacking.indexOf(b->above);
+    auto constraintComparator = [&positionOf](Constraint *a, Constraint *b) {
+        return positionOf(a->above) > positionOf(b->above);
     };
     std::sort(constraints.begin(), constraints.end(), constraintComparator);
 
@@ -616,13 +628,17 @@ QList<Window *> Workspace::constrainedStackingOrder()
     while (!constraints.isEmpty()) {
         Constraint *constraint = constraints.takeFirst();
 
-        const int belowIndex = stacking.indexOf(constraint->below);
-        const int aboveIndex = stacking.indexOf(constraint->above);
+        const int belowIndex = positionOf(constraint->below);
+        const int aboveIndex = positionOf(constraint->above);
         if (belowIndex == -1 || aboveIndex == -1) {
             continue;
         } else if (aboveIndex < belowIndex) {
             stacking.removeAt(aboveIndex);
             stacking.insert(belowIndex, constraint->above);
+            // only the windows between the two have moved
+            for (int i = aboveIndex; i <= belowIndex; ++i) {
+                positions[stacking[i]] = i;
+            }
         }
 
         // Preserve the relative order of transient siblings in the unconstrained stacking order.
@@ -14,6 +14,7 @@ namespace KWin
 {
 
 LidSwitchTracker::LidSwitchTracker()
+    : InputEventSpy(InputEventType::Switch)
 {
     input()->installInputEventSpy(this);
 }
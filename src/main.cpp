@@ -18,6 +18,7 @@
 #include "core/outputbackend.h"
 #include "core/rendertarget.h"
 #include "core/session.h"
+#include "core/stallstatistics.h"
 #include "cursor.h"
 #include "cursorsource.h"
 #include "effect/effecthandler.h"
@@ -490,6 +491,7 @@ xcb_timestamp_t Application::x11Time() const
 bool XcbEventFilter::nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result)
 {
     if (eventType == "xcb_generic_event_t") {
+        const StallStatistics::Scope stallScope(StallSource::X11Events);
         return kwinApp()->dispatchEvent(static_cast<xcb_generic_event_t *>(message));
     }
     return false;
@@ -14,10 +14,14 @@
 #include "backends/virtual/virtual_backend.h"
 #include "backends/wayland/wayland_backend.h"
 #include "compositor.h"
+#include "core/backendoutput.h"
 #include "core/outputbackend.h"
+#include "core/renderloop.h"
 #include "core/session.h"
 #include "effect/effecthandler.h"
+#include "ftrace.h"
 #include "inputmethod.h"
+#include "pluginmanager.h"
 #include "tabletmodemanager.h"
 #include "utils/realtime.h"
 #include "wayland/display.h"
@@ -131,31 +135,51 @@ ApplicationWayland::~ApplicationWayland()
 
 void ApplicationWayland::performStartup()
 {
+    if (m_startupProfiler.isEnabled()) {
+        // create the logger early so all the stages can be traced
+        FTraceLogger::create();
+    }
+
+    m_startupProfiler.beginStage("Options");
     createOptions();
 
+    // the plugin libraries are loaded while the main thread sets up the outputs and the renderer
+    m_libraryPreload = PluginManager::preloadLibraries();
+
+    m_startupProfiler.beginStage("Output backend");
     if (!outputBackend()->initialize()) {
         std::exit(1);
     }
 
+    m_startupProfiler.beginStage("Input");
     createInput();
     createInputMethod();
     createTabletModeManager();
 
+    m_startupProfiler.beginStage("Renderer");
     auto compositor = Compositor::create();
     compositor->createRenderer();
+    m_startupProfiler.beginStage("Workspace");
     createWorkspace();
+    m_startupProfiler.beginStage("Scene");
     createScene();
+    m_startupProfiler.beginStage("Plugins");
+    m_libraryPreload.waitForFinished();
     createPlugins();
 
+    m_startupProfiler.beginStage("Compositor and effects");
     compositor->start();
+    profileFirstFrame();
 
     // Note that we start accepting client connections after creating the Workspace.
+    m_startupProfiler.beginStage("Wayland server");
     if (!waylandServer()->start()) {
         qFatal("Failed to initialize the Wayland server, exiting now");
     }
 
 #if KWIN_BUILD_X11
     if (m_startXWayland) {
+        m_startupProfiler.beginStage("Xwayland");
         setXwaylandScale(config()->group(QStringLiteral("Xwayland")).readEntry("Scale", 1.0));
 
         m_xwayland = std::make_unique<Xwl::Xwayland>(this);
@@ -166,9 +190,32 @@ void ApplicationWayland::performStartup()
         m_xwayland->xwaylandLauncher()->passFileDescriptors(std::move(m_xwaylandFds));
         m_xwayland->init();
         connect(m_xwayland.get(), &Xwl::Xwayland::started, this, &ApplicationWayland::applyXwaylandScale);
+        if (m_startupProfiler.isEnabled()) {
+            connect(m_xwayland.get(), &Xwl::Xwayland::started, this, [this]() {
+                m_startupProfiler.addMilestone("Xwayland started");
+            }, Qt::SingleShotConnection);
+        }
     }
 #endif
+    m_startupProfiler.beginStage("Session");
     startSession();
+    m_startupProfiler.endStage();
+}
+
+void ApplicationWayland::profileFirstFrame()
+{
+    if (!m_startupProfiler.isEnabled()) {
+        return;
+    }
+    // the report is written once the first frame reaches the screen, the shaders are compiled
+    // and the effects get to paint for the first time in that frame
+    const auto outputs = outputBackend()->outputs();
+    for (BackendOutput *output : outputs) {
+        connect(output->renderLoop(), &RenderLoop::framePresented, this, [this, output]() {
+            m_startupProfiler.addMilestone("First frame on " + output->name().toUtf8());
+            m_startupProfiler.finish();
+        }, Qt::SingleShotConnection);
+    }
 }
 
 void ApplicationWayland::refreshSettings(const KConfigGroup &group, const QByteArrayList &names)
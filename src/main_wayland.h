@@ -8,7 +8,9 @@
 */
 #pragma once
 #include "main.h"
+#include "startupprofiler.h"
 #include <KConfigWatcher>
+#include <QFuture>
 #include <QTimer>
 
 #include "utils/filedescriptor.h"
@@ -77,6 +79,7 @@ protected:
 private:
     void startSession();
     void refreshSettings(const KConfigGroup &group, const QByteArrayList &names);
+    void profileFirstFrame();
 
     QStringList m_applicationsToStart;
     QString m_inputMethodServerToStart;
@@ -92,6 +95,8 @@ private:
     std::vector<FileDescriptor> m_xwaylandFds;
 #endif
     KConfigWatcher::Ptr m_settingsWatcher;
+    StartupProfiler m_startupProfiler;
+    QFuture<void> m_libraryPreload;
 };
 
 }
@@ -40,7 +40,8 @@ private:
 };
 
 OnScreenNotificationInputEventSpy::OnScreenNotificationInputEventSpy(OnScreenNotification *parent)
-    : m_parent(parent)
+    : InputEventSpy(InputEventType::Pointer)
+    , m_parent(parent)
 {
 }
 
@@ -6,14 +6,23 @@ const int BT1886_EOTF = 4;
 
 uniform mat4 colorimetryTransform;
 
+// shaders specialized for one color transformation have the transfer functions baked in
+#ifdef SOURCE_NAMED_TRANSFER_FUNCTION
+const int sourceNamedTransferFunction = SOURCE_NAMED_TRANSFER_FUNCTION;
+#else
 uniform int sourceNamedTransferFunction;
+#endif
 /**
  * x: min luminance
  * y: max luminance - min luminance
  */
 uniform vec2 sourceTransferFunctionParams;
 
+#ifdef DESTINATION_NAMED_TRANSFER_FUNCTION
+const int destinationNamedTransferFunction = DESTINATION_NAMED_TRANSFER_FUNCTION;
+#else
 uniform int destinationNamedTransferFunction;
+#endif
 /**
  * x: min luminance
  * y: max luminance - min luminance
@@ -106,7 +115,14 @@ const mat3 fromICtCp = mat3(
     0.11102962500303, -0.111029625003, -0.32062717498732
 );
 
+#ifdef TONEMAPPING_LUT
+uniform sampler2D tonemappingLut;
+#endif
+
 vec3 doTonemapping(vec3 color) {
+#ifdef SKIP_TONEMAPPING
+    return clamp(color.rgb, vec3(0.0), vec3(maxDestinationLuminance));
+#else
     if (maxTonemappingLuminance < maxDestinationLuminance * 1.01) {
         // clipping is enough
         return clamp(color.rgb, vec3(0.0), vec3(maxDestinationLuminance));
@@ -117,6 +133,15 @@ vec3 doTonemapping(vec3 color) {
     vec3 lms = (destinationToLMS * vec4(color, 1.0)).rgb;
     vec3 lms_PQ = linearToPq(lms / 10000.0);
     vec3 ICtCp = toICtCp * lms_PQ;
+#ifdef TONEMAPPING_LUT
+    // the tone mapping curve is precomputed for PQ encoded luminance, see ShaderManager::tonemappingLut
+    vec2 lutCoordinate = vec2((ICtCp.r * float(TONEMAPPING_LUT - 1) + 0.5) / float(TONEMAPPING_LUT), 0.5);
+#if __VERSION__ >= 130
+    ICtCp.r = texture(tonemappingLut, lutCoordinate).r;
+#else
+    ICtCp.r = texture2D(tonemappingLut, lutCoordinate).r;
+#endif
+#else
     float luminance = singlePqToLinear(ICtCp.r) * 10000.0;
 
     // apply tone mapping operation (modified Reinhart)
@@ -126,12 +151,14 @@ vec3 doTonemapping(vec3 color) {
     float v = (outputRange * (1.0 + inputRange) - inputRange) / pow(inputRange, 2.0);
     relativeLuminance = relativeLuminance * (1.0 + relativeLuminance * v) / (1.0 + relativeLuminance);
     luminance = relativeLuminance * destinationReferenceLuminance;
+    ICtCp.r = singleLinearToPq(luminance / 10000.0);
+#endif
 
     // convert back to rgb
-    ICtCp.r = singleLinearToPq(luminance / 10000.0);
     color = (lmsToDestination * vec4(pqToLinear(fromICtCp * ICtCp), 1.0)).rgb * 10000.0;
     // and clip, to ensure out-of-gamut values are clipped to the correct white point
     return clamp(color, vec3(0.0), vec3(maxDestinationLuminance));
+#endif
 }
 
 vec4 encodingToNits(vec4 color, int sourceTransferFunction, float luminanceOffset, float luminanceScale) {
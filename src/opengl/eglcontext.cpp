@@ -11,7 +11,9 @@
 #include "egldisplay.h"
 #include "eglimagetexture.h"
 #include "glframebuffer.h"
+#include "glpixelbuffer.h"
 #include "glplatform.h"
+#include "glrendertargetpool.h"
 #include "glshader.h"
 #include "glshadermanager.h"
 #include "glvertexbuffer.h"
@@ -134,13 +136,27 @@ EglContext::EglContext(EglDisplay *display, EGLConfig config, ::EGLContext conte
     , m_shaderManager(std::make_unique<ShaderManager>())
     , m_streamingBuffer(std::make_unique<GLVertexBuffer>(GLVertexBuffer::Stream))
     , m_indexBuffer(std::make_unique<IndexBuffer>())
+    , m_renderTargetPool(std::make_unique<GLRenderTargetPool>())
 {
     glResolveFunctions(&getProcAddress);
     initDebugOutput();
+    if (display->hasExtension(QByteArrayLiteral("EGL_IMG_context_priority"))) {
+        // the requested priority is only a hint, the driver may silently hand out a lower one
+        EGLint priority = EGL_CONTEXT_PRIORITY_MEDIUM_IMG;
+        eglQueryContext(display->handle(), context, EGL_CONTEXT_PRIORITY_LEVEL_IMG, &priority);
+        m_isHighPriority = priority == EGL_CONTEXT_PRIORITY_HIGH_IMG;
+        if (!m_isHighPriority) {
+            qCDebug(KWIN_OPENGL) << "Did not get a high priority EGL context, clients can delay rendering on the GPU";
+        }
+    }
     if (haveBufferStorage() && haveSyncFences()) {
         if (qgetenv("KWIN_PERSISTENT_VBO") != QByteArrayLiteral("0")) {
             m_streamingBuffer->setPersistent();
         }
+        // pixel unpack buffers need desktop OpenGL or OpenGL ES 3
+        if ((!isOpenGLES() || hasVersion(Version(3, 0))) && qgetenv("KWIN_PERSISTENT_PBO") != QByteArrayLiteral("0")) {
+            m_pixelUploadBuffer = std::make_unique<GLPixelUploadBuffer>();
+        }
     }
     // It is not legal to not have a vertex array object bound in a core context
     // to make code handling old and new OpenGL versions easier, bind a dummy vao that's used for everything
@@ -159,6 +175,8 @@ EglContext::~EglContext()
     m_shaderManager.reset();
     m_streamingBuffer.reset();
     m_indexBuffer.reset();
+    m_pixelUploadBuffer.reset();
+    m_renderTargetPool.reset();
     doneCurrent();
     eglDestroyContext(m_display->handle(), m_handle);
 }
@@ -457,6 +475,11 @@ bool EglContext::supportsPackInvert() const
     return m_supportsPackInvert;
 }
 
+bool EglContext::isHighPriority() const
+{
+    return m_isHighPriority;
+}
+
 ShaderManager *EglContext::shaderManager() const
 {
     return m_shaderManager.get();
@@ -467,6 +490,16 @@ GLVertexBuffer *EglContext::streamingVbo() const
     return m_streamingBuffer.get();
 }
 
+GLPixelUploadBuffer *EglContext::pixelUploadBuffer() const
+{
+    return m_pixelUploadBuffer.get();
+}
+
+GLRenderTargetPool *EglContext::renderTargetPool() const
+{
+    return m_renderTargetPool.get();
+}
+
 IndexBuffer *EglContext::indexBuffer() const
 {
     return m_indexBuffer.get();
@@ -22,6 +22,8 @@ namespace KWin
 class EglDisplay;
 class ShaderManager;
 class IndexBuffer;
+class GLPixelUploadBuffer;
+class GLRenderTargetPool;
 class GLPlatform;
 class GLFramebuffer;
 struct DmaBufAttributes;
@@ -73,9 +75,23 @@ public:
     bool haveBufferStorage() const;
     bool haveSyncFences() const;
     bool supportsPackInvert() const;
+    /**
+     * Returns @c true if the driver granted the context a high priority, so the GPU can
+     * schedule the compositor ahead of clients.
+     */
+    bool isHighPriority() const;
     ShaderManager *shaderManager() const;
     GLVertexBuffer *streamingVbo() const;
     IndexBuffer *indexBuffer() const;
+    /**
+     * @returns the buffers used for streaming texture uploads, or @c nullptr if
+     *          persistently mapped buffers aren't supported
+     */
+    GLPixelUploadBuffer *pixelUploadBuffer() const;
+    /**
+     * @returns the pool of offscreen render targets that effects can borrow from
+     */
+    GLRenderTargetPool *renderTargetPool() const;
     GLPlatform *glPlatform() const;
     QSet<QByteArray> openglExtensions() const;
 
@@ -137,6 +153,7 @@ private:
     const bool m_haveSyncFences;
     const bool m_supportsIndexedQuads;
     const bool m_supportsPackInvert;
+    bool m_isHighPriority = false;
     const std::unique_ptr<GLPlatform> m_glPlatform;
     glGetGraphicsResetStatus_func m_glGetGraphicsResetStatus = nullptr;
     glReadnPixels_func m_glReadnPixels = nullptr;
@@ -149,6 +166,8 @@ private:
     std::unique_ptr<ShaderManager> m_shaderManager;
     std::unique_ptr<GLVertexBuffer> m_streamingBuffer;
     std::unique_ptr<IndexBuffer> m_indexBuffer;
+    std::unique_ptr<GLPixelUploadBuffer> m_pixelUploadBuffer;
+    std::unique_ptr<GLRenderTargetPool> m_renderTargetPool;
     QStack<GLFramebuffer *> m_fbos;
     uint32_t m_vao = 0;
     bool m_failed = false;
@@ -115,11 +115,26 @@ std::shared_ptr<EglSwapchainSlot> EglSwapchain::acquire()
     if (it != m_slots.cend()) {
         return *it;
     }
+    return allocateSlot();
+}
 
+bool EglSwapchain::preallocate(int count)
+{
+    while (m_slots.count() < count) {
+        if (!allocateSlot()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<EglSwapchainSlot> EglSwapchain::allocateSlot()
+{
     GraphicsBuffer *buffer = m_allocator->allocate(GraphicsBufferOptions{
         .size = m_size,
         .format = m_format,
         .modifiers = {m_modifier},
+        .recyclable = true,
     });
     if (!buffer) {
         qCWarning(KWIN_OPENGL) << "Failed to allocate an egl gbm swapchain graphics buffer";
@@ -164,6 +179,7 @@ std::shared_ptr<EglSwapchain> EglSwapchain::create(GraphicsBufferAllocator *allo
         .size = size,
         .format = format,
         .modifiers = modifiers,
+        .recyclable = true,
     });
     if (!seed) {
         return nullptr;
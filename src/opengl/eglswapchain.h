@@ -62,6 +62,11 @@ public:
     uint64_t modifier() const;
 
     std::shared_ptr<EglSwapchainSlot> acquire();
+    /**
+     * Allocates buffers until the swapchain has at least @a count of them, so that the
+     * following frames don't need to wait for the allocation.
+     */
+    bool preallocate(int count);
     void release(std::shared_ptr<EglSwapchainSlot> slot, FileDescriptor &&releaseFence);
 
     void resetBufferAge();
@@ -69,6 +74,8 @@ public:
     static std::shared_ptr<EglSwapchain> create(GraphicsBufferAllocator *allocator, EglContext *context, const QSize &size, uint32_t format, const QList<uint64_t> &modifiers);
 
 private:
+    std::shared_ptr<EglSwapchainSlot> allocateSlot();
+
     GraphicsBufferAllocator *m_allocator;
     EglContext *m_context;
     QSize m_size;
@@ -0,0 +1,119 @@
+/*
+    KWin - the KDE window manager
+    This file is part of the KDE project.
+
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "glpixelbuffer.h"
+#include "opengl/eglcontext.h"
+#include "utils/common.h"
+
+#include <algorithm>
+
+namespace KWin
+{
+
+// roughly a full 8K frame with 4 bytes per pixel, anything bigger is uploaded synchronously
+static constexpr size_t s_maximumBufferSize = 128 * 1024 * 1024;
+
+GLPixelUploadBuffer::GLPixelUploadBuffer()
+{
+}
+
+GLPixelUploadBuffer::~GLPixelUploadBuffer()
+{
+    if (!EglContext::currentContext()) {
+        qCWarning(KWIN_OPENGL, "Could not delete pixel upload buffers because no context is current");
+        return;
+    }
+    for (Slot &slot : m_slots) {
+        release(slot);
+    }
+}
+
+bool GLPixelUploadBuffer::isIdle(Slot &slot) const
+{
+    if (!slot.fence) {
+        return true;
+    }
+    GLint value;
+    glGetSynciv(slot.fence, GL_SYNC_STATUS, 1, nullptr, &value);
+    if (value != GL_SIGNALED) {
+        return false;
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    return true;
+}
+
+bool GLPixelUploadBuffer::allocate(Slot &slot, size_t size)
+{
+    release(slot);
+
+    // grow in big steps, so that windows being resized don't cause a reallocation every frame
+    const size_t bufferSize = std::min(std::max<size_t>(size + size / 2, 4 * 1024 * 1024), s_maximumBufferSize);
+    const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glGenBuffers(1, &slot.buffer);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, bufferSize, nullptr, access);
+    slot.map = static_cast<uint8_t *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bufferSize, access));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (!slot.map) {
+        qCWarning(KWIN_OPENGL, "Failed to map a pixel upload buffer");
+        release(slot);
+        return false;
+    }
+    slot.size = bufferSize;
+    return true;
+}
+
+void GLPixelUploadBuffer::release(Slot &slot)
+{
+    if (slot.fence) {
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+    if (slot.buffer) {
+        // This also unmaps the buffer
+        glDeleteBuffers(1, &slot.buffer);
+        slot.buffer = 0;
+    }
+    slot.map = nullptr;
+    slot.size = 0;
+}
+
+uint8_t *GLPixelUploadBuffer::map(size_t size)
+{
+    Q_ASSERT(!m_mapped);
+    if (size > s_maximumBufferSize) {
+        return nullptr;
+    }
+
+    Slot &slot = m_slots[m_next];
+    if (!isIdle(slot)) {
+        // the GPU is still reading from the oldest buffer, don't wait for it
+        return nullptr;
+    }
+    if (slot.size < size && !allocate(slot, size)) {
+        return nullptr;
+    }
+
+    m_next = (m_next + 1) % m_slots.size();
+    m_mapped = &slot;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+    return slot.map;
+}
+
+void GLPixelUploadBuffer::unmap()
+{
+    Q_ASSERT(m_mapped);
+    m_mapped->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    m_mapped = nullptr;
+}
+
+} // namespace KWin
@@ -0,0 +1,75 @@
+/*
+    KWin - the KDE window manager
+    This file is part of the KDE project.
+
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "kwin_export.h"
+
+#include <epoxy/gl.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace KWin
+{
+
+/**
+ * The GLPixelUploadBuffer class is a ring of persistently mapped pixel unpack buffers
+ * used to stream texture uploads.
+ *
+ * Pixels written to a mapped buffer are copied into textures by the GPU asynchronously,
+ * so uploading large images doesn't stall rendering. Every buffer is protected by a fence,
+ * if all of them are still in use, map() fails and the caller should fall back to a
+ * synchronous upload.
+ */
+class KWIN_EXPORT GLPixelUploadBuffer
+{
+public:
+    explicit GLPixelUploadBuffer();
+    ~GLPixelUploadBuffer();
+
+    /**
+     * Binds an idle buffer to GL_PIXEL_UNPACK_BUFFER and returns a pointer to at least
+     * @p size bytes of its mapped storage. Texture uploads issued until unmap() is called
+     * read from the buffer, with the pixel pointer being an offset into it.
+     *
+     * Returns @c nullptr if no buffer is idle or @p size exceeds the maximum buffer size.
+     */
+    uint8_t *map(size_t size);
+
+    /**
+     * Protects the buffer returned by the last successful map() call with a fence and
+     * unbinds it.
+     */
+    void unmap();
+
+    /**
+     * The minimum amount of bytes for which streaming a texture upload is worth it.
+     */
+    static constexpr size_t s_minimumUploadSize = 256 * 1024;
+
+private:
+    struct Slot
+    {
+        GLuint buffer = 0;
+        uint8_t *map = nullptr;
+        size_t size = 0;
+        GLsync fence = nullptr;
+    };
+
+    bool isIdle(Slot &slot) const;
+    bool allocate(Slot &slot, size_t size);
+    void release(Slot &slot);
+
+    std::array<Slot, 3> m_slots;
+    size_t m_next = 0;
+    Slot *m_mapped = nullptr;
+};
+
+} // namespace KWin
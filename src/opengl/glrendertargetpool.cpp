@@ -0,0 +1,136 @@
+/*
+    KWin - the KDE window manager
+    This file is part of the KDE project.
+
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "glrendertargetpool.h"
+#include "core/gpumemorystatistics.h"
+#include "opengl/eglcontext.h"
+#include "opengl/glframebuffer.h"
+#include "opengl/gltexture.h"
+#include "utils/common.h"
+
+#include <algorithm>
+
+namespace KWin
+{
+
+static const size_t s_maximumPoolSize = size_t(environmentVariableIntValue("KWIN_GL_RENDER_TARGET_POOL_SIZE").value_or(128)) * 1024 * 1024;
+static constexpr std::chrono::seconds s_maximumIdleTime{5};
+
+static size_t bytesPerPixel(GLenum internalFormat)
+{
+    switch (internalFormat) {
+    case GL_RGBA16F:
+    case GL_RGBA16:
+        return 8;
+    case GL_RGBA32F:
+        return 16;
+    default:
+        return 4;
+    }
+}
+
+GLRenderTarget::GLRenderTarget() = default;
+
+GLRenderTarget::GLRenderTarget(std::unique_ptr<GLTexture> &&texture, std::unique_ptr<GLFramebuffer> &&framebuffer)
+    : texture(std::move(texture))
+    , framebuffer(std::move(framebuffer))
+{
+}
+
+GLRenderTarget::GLRenderTarget(GLRenderTarget &&other) = default;
+GLRenderTarget::~GLRenderTarget() = default;
+GLRenderTarget &GLRenderTarget::operator=(GLRenderTarget &&other) = default;
+
+GLRenderTarget::operator bool() const
+{
+    return texture && framebuffer && framebuffer->valid();
+}
+
+GLRenderTargetPool::GLRenderTargetPool()
+{
+}
+
+GLRenderTargetPool::~GLRenderTargetPool()
+{
+    clear();
+}
+
+GLRenderTarget GLRenderTargetPool::acquire(GLenum internalFormat, const QSize &size)
+{
+    trim(std::chrono::steady_clock::now());
+
+    const auto it = std::ranges::find_if(m_entries, [internalFormat, size](const Entry &entry) {
+        return entry.target.texture->internalFormat() == internalFormat && entry.target.texture->size() == size;
+    });
+    if (it != m_entries.end()) {
+        GLRenderTarget target = std::move(it->target);
+        m_bytes -= it->bytes;
+        m_entries.erase(it);
+
+        target.texture->setFilter(GL_LINEAR);
+        target.texture->setWrapMode(GL_CLAMP_TO_EDGE);
+        target.texture->setContentTransform(OutputTransform::Normal);
+        return target;
+    }
+
+    auto texture = GLTexture::allocate(internalFormat, size);
+    if (!texture) {
+        return GLRenderTarget();
+    }
+    texture->setMemoryCategory(GpuMemoryCategory::EffectTargets);
+    texture->setFilter(GL_LINEAR);
+    texture->setWrapMode(GL_CLAMP_TO_EDGE);
+    auto framebuffer = std::make_unique<GLFramebuffer>(texture.get());
+    if (!framebuffer->valid()) {
+        return GLRenderTarget();
+    }
+    return GLRenderTarget(std::move(texture), std::move(framebuffer));
+}
+
+void GLRenderTargetPool::release(GLRenderTarget &&target)
+{
+    if (!target) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    trim(now);
+
+    const size_t bytes = size_t(target.texture->width()) * target.texture->height() * bytesPerPixel(target.texture->internalFormat());
+    if (bytes > s_maximumPoolSize) {
+        return;
+    }
+    // make room by freeing the render targets that have been idle the longest
+    while (m_bytes + bytes > s_maximumPoolSize) {
+        m_bytes -= m_entries.front().bytes;
+        m_entries.pop_front();
+    }
+
+    m_entries.push_back(Entry{
+        .target = std::move(target),
+        .bytes = bytes,
+        .releaseTime = now,
+    });
+    m_bytes += bytes;
+}
+
+void GLRenderTargetPool::clear()
+{
+    m_entries.clear();
+    m_bytes = 0;
+}
+
+void GLRenderTargetPool::trim(std::chrono::steady_clock::time_point now)
+{
+    while (!m_entries.empty() && now - m_entries.front().releaseTime >= s_maximumIdleTime) {
+        m_bytes -= m_entries.front().bytes;
+        m_entries.pop_front();
+    }
+}
+
+} // namespace KWin
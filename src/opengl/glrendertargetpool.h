@@ -0,0 +1,90 @@
+/*
+    KWin - the KDE window manager
+    This file is part of the KDE project.
+
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "kwin_export.h"
+
+#include <QSize>
+
+#include <epoxy/gl.h>
+
+#include <chrono>
+#include <deque>
+#include <memory>
+
+namespace KWin
+{
+
+class GLFramebuffer;
+class GLTexture;
+
+/**
+ * A texture together with a framebuffer that renders into it.
+ */
+struct KWIN_EXPORT GLRenderTarget
+{
+    GLRenderTarget();
+    GLRenderTarget(std::unique_ptr<GLTexture> &&texture, std::unique_ptr<GLFramebuffer> &&framebuffer);
+    GLRenderTarget(GLRenderTarget &&other);
+    ~GLRenderTarget();
+
+    GLRenderTarget &operator=(GLRenderTarget &&other);
+
+    explicit operator bool() const;
+
+    std::unique_ptr<GLTexture> texture;
+    std::unique_ptr<GLFramebuffer> framebuffer;
+};
+
+/**
+ * The GLRenderTargetPool class keeps the offscreen render targets that effects don't need anymore,
+ * so that the next effect asking for a render target of the same size and format can reuse it
+ * instead of allocating a new texture. Animations that redirect windows offscreen would otherwise
+ * allocate and free big textures every time they run.
+ *
+ * The contents of a reused render target are undefined. The pool is limited in size, and render
+ * targets that haven't been reused for a few seconds are freed on the next acquire() or release().
+ *
+ * All functions must be called with the context that owns the pool being current.
+ */
+class KWIN_EXPORT GLRenderTargetPool
+{
+public:
+    GLRenderTargetPool();
+    ~GLRenderTargetPool();
+
+    /**
+     * Returns a render target with the given @p internalFormat and @p size, or an invalid render
+     * target if the texture can't be allocated. The texture uses linear filtering and clamps to
+     * its edges.
+     */
+    GLRenderTarget acquire(GLenum internalFormat, const QSize &size);
+
+    /**
+     * Gives the render target back to the pool, so it can be handed out again.
+     */
+    void release(GLRenderTarget &&target);
+
+    void clear();
+
+private:
+    struct Entry
+    {
+        GLRenderTarget target;
+        size_t bytes;
+        std::chrono::steady_clock::time_point releaseTime;
+    };
+
+    void trim(std::chrono::steady_clock::time_point now);
+
+    std::deque<Entry> m_entries;
+    size_t m_bytes = 0;
+};
+
+} // namespace KWin
@@ -18,6 +18,7 @@ GLRenderTimeQuery::GLRenderTimeQuery(const std::shared_ptr<EglContext> &context)
 {
     if (context->supportsTimerQueries()) {
         glGenQueries(1, &m_gpuProbe.query);
+        glGenQueries(1, &m_gpuProbe.startQuery);
     }
 }
 
@@ -33,6 +34,7 @@ GLRenderTimeQuery::~GLRenderTimeQuery()
         return;
     }
     glDeleteQueries(1, &m_gpuProbe.query);
+    glDeleteQueries(1, &m_gpuProbe.startQuery);
     if (previousContext && previousContext != context.get()) {
         previousContext->makeCurrent();
     }
@@ -44,6 +46,7 @@ void GLRenderTimeQuery::begin()
         GLint64 start = 0;
         glGetInteger64v(GL_TIMESTAMP, &start);
         m_gpuProbe.start = std::chrono::nanoseconds(start);
+        glQueryCounter(m_gpuProbe.startQuery, GL_TIMESTAMP);
     }
     m_cpuProbe.start = std::chrono::steady_clock::now();
 }
@@ -67,8 +70,11 @@ std::optional<RenderTimeSpan> GLRenderTimeQuery::query()
         if (!context || !context->makeCurrent()) {
             return std::nullopt;
         }
+        GLint64 executionStart = 0;
         GLint64 end = 0;
+        glGetQueryObjecti64v(m_gpuProbe.startQuery, GL_QUERY_RESULT, &executionStart);
         glGetQueryObjecti64v(m_gpuProbe.query, GL_QUERY_RESULT, &end);
+        m_gpuProbe.executionStart = std::chrono::nanoseconds(executionStart);
         m_gpuProbe.end = std::chrono::nanoseconds(end);
         if (previousContext && previousContext != context.get()) {
             previousContext->makeCurrent();
@@ -82,6 +88,7 @@ std::optional<RenderTimeSpan> GLRenderTimeQuery::query()
     return RenderTimeSpan{
         .start = m_cpuProbe.start,
         .end = end,
+        .queueDelay = std::max(m_gpuProbe.executionStart - m_gpuProbe.start, std::chrono::nanoseconds::zero()),
     };
 }
 }
@@ -46,7 +46,10 @@ private:
     struct
     {
         GLuint query = 0;
+        // when the GPU got to the first command of the frame
+        GLuint startQuery = 0;
         std::chrono::nanoseconds start{0};
+        std::chrono::nanoseconds executionStart{0};
         std::chrono::nanoseconds end{0};
     } m_gpuProbe;
 };
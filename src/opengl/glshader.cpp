@@ -9,7 +9,9 @@
     SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "glshader.h"
+#include "gllut.h"
 #include "glplatform.h"
+#include "glshadermanager.h"
 #include "glutils.h"
 #include "utils/common.h"
 
@@ -185,6 +187,35 @@ bool GLShader::load(const QByteArray &vertexSource, const QByteArray &fragmentSo
     return link();
 }
 
+bool GLShader::loadBinary(GLenum format, const QByteArray &binary)
+{
+    glProgramBinary(m_program, format, binary.constData(), binary.size());
+
+    int status;
+    glGetProgramiv(m_program, GL_LINK_STATUS, &status);
+    m_valid = status != 0;
+    return m_valid;
+}
+
+QByteArray GLShader::programBinary(GLenum *format) const
+{
+    int length = 0;
+    glGetProgramiv(m_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return QByteArray();
+    }
+    QByteArray binary(length, Qt::Uninitialized);
+    GLsizei written = 0;
+    glGetProgramBinary(m_program, length, &written, format, binary.data());
+    binary.resize(written);
+    return binary;
+}
+
+void GLShader::setBinaryRetrievable()
+{
+    glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
 void GLShader::bindAttributeLocation(const char *name, int index)
 {
     glBindAttribLocation(m_program, index, name);
@@ -250,6 +281,7 @@ void GLShader::resolveLocations()
     m_intLocations[IntUniform::SourceNamedTransferFunction] = uniformLocation("sourceNamedTransferFunction");
     m_intLocations[IntUniform::DestinationNamedTransferFunction] = uniformLocation("destinationNamedTransferFunction");
     m_intLocations[IntUniform::Thickness] = uniformLocation("thickness");
+    m_intLocations[IntUniform::TonemappingLut] = uniformLocation("tonemappingLut");
 
     m_locationsResolved = true;
 }
@@ -480,8 +512,30 @@ QMatrix4x4 GLShader::getUniformMatrix4x4(const char *name)
     }
 }
 
+// a texture unit that the textures of effects and windows are unlikely to use
+static constexpr int s_tonemappingLutUnit = 7;
+
 static bool s_disableTonemapping = qEnvironmentVariableIntValue("KWIN_DISABLE_TONEMAPPING") == 1;
 
+static double maxTonemappingLuminance(const std::shared_ptr<ColorDescription> &src, const std::shared_ptr<ColorDescription> &dst, RenderingIntent intent)
+{
+    if (!s_disableTonemapping && intent == RenderingIntent::Perceptual) {
+        return src->maxHdrLuminance().value_or(src->referenceLuminance()) * dst->referenceLuminance() / src->referenceLuminance();
+    } else {
+        return dst->maxHdrLuminance().value_or(10'000);
+    }
+}
+
+ColorspaceShape ColorspaceShape::create(const std::shared_ptr<ColorDescription> &src, const std::shared_ptr<ColorDescription> &dst, RenderingIntent intent)
+{
+    return ColorspaceShape{
+        .sourceTransferFunction = src->transferFunction().type,
+        .destinationTransferFunction = dst->transferFunction().type,
+        // same check as in doTonemapping()
+        .tonemapping = maxTonemappingLuminance(src, dst, intent) >= dst->maxHdrLuminance().value_or(10'000) * 1.01,
+    };
+}
+
 void GLShader::setColorspaceUniforms(const std::shared_ptr<ColorDescription> &src, const std::shared_ptr<ColorDescription> &dst, RenderingIntent intent)
 {
     setUniform(Mat4Uniform::ColorimetryTransformation, src->toOther(*dst, intent));
@@ -499,13 +553,25 @@ void GLShader::setColorspaceUniforms(const std::shared_ptr<ColorDescription> &sr
         setUniform(Vec2Uniform::DestinationTransferFunctionParams, QVector2D(dst->transferFunction().minLuminance, dst->transferFunction().maxLuminance - dst->transferFunction().minLuminance));
     }
     setUniform(FloatUniform::DestinationReferenceLuminance, dst->referenceLuminance());
-    setUniform(FloatUniform::MaxDestinationLuminance, dst->maxHdrLuminance().value_or(10'000));
-    if (!s_disableTonemapping && intent == RenderingIntent::Perceptual) {
-        setUniform(FloatUniform::MaxTonemappingLuminance, src->maxHdrLuminance().value_or(src->referenceLuminance()) * dst->referenceLuminance() / src->referenceLuminance());
-    } else {
-        setUniform(FloatUniform::MaxTonemappingLuminance, dst->maxHdrLuminance().value_or(10'000));
-    }
+    const double maxDestinationLuminance = dst->maxHdrLuminance().value_or(10'000);
+    const double maxTonemapping = maxTonemappingLuminance(src, dst, intent);
+    setUniform(FloatUniform::MaxDestinationLuminance, maxDestinationLuminance);
+    setUniform(FloatUniform::MaxTonemappingLuminance, maxTonemapping);
     setUniform(Mat4Uniform::DestinationToLMS, dst->containerColorimetry().toLMS());
     setUniform(Mat4Uniform::LMSToDestination, dst->containerColorimetry().fromLMS());
+    if (setUniform(IntUniform::TonemappingLut, s_tonemappingLutUnit)) {
+        // same check as in doTonemapping(), clipping doesn't need the lookup table
+        GlLookUpTable *lut = nullptr;
+        if (maxTonemapping >= maxDestinationLuminance * 1.01) {
+            lut = ShaderManager::instance()->tonemappingLut(dst->referenceLuminance(), maxTonemapping, maxDestinationLuminance);
+        }
+        glActiveTexture(GL_TEXTURE0 + s_tonemappingLutUnit);
+        if (lut) {
+            lut->bind();
+        } else {
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+        glActiveTexture(GL_TEXTURE0);
+    }
 }
 }
@@ -22,6 +22,22 @@
 namespace KWin
 {
 
+/**
+ * The shape of the color transformation done by a shader with ShaderTrait::TransformColorspace.
+ * Shaders specialized for a shape have the transfer functions and the tone mapping baked in,
+ * instead of branching on uniforms for every pixel.
+ */
+struct KWIN_EXPORT ColorspaceShape
+{
+    static ColorspaceShape create(const std::shared_ptr<ColorDescription> &src, const std::shared_ptr<ColorDescription> &dst, RenderingIntent intent);
+
+    TransferFunction::Type sourceTransferFunction;
+    TransferFunction::Type destinationTransferFunction;
+    bool tonemapping;
+
+    auto operator<=>(const ColorspaceShape &) const = default;
+};
+
 class KWIN_EXPORT GLShader
 {
 public:
@@ -127,6 +143,7 @@ public:
         Sampler,
         Sampler1,
         Thickness,
+        TonemappingLut,
         IntUniformCount
     };
 
@@ -153,6 +170,17 @@ protected:
     bool load(const QByteArray &vertexSource, const QByteArray &fragmentSource);
     const QByteArray prepareSource(GLenum shaderType, const QByteArray &sourceCode) const;
     bool compile(GLuint program, GLenum shaderType, const QByteArray &sourceCode) const;
+    /**
+     * Loads the program from a @p binary previously returned by programBinary(). Returns
+     * @c false if the driver doesn't accept the binary anymore.
+     */
+    bool loadBinary(GLenum format, const QByteArray &binary);
+    /**
+     * Returns the binary of the linked program, or an empty byte array if the driver can't
+     * provide it. Must be called after link().
+     */
+    QByteArray programBinary(GLenum *format) const;
+    void setBinaryRetrievable();
     void bind();
     void unbind();
     void resolveLocations();
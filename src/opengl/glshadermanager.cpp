@@ -9,18 +9,30 @@
     SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "glshadermanager.h"
+#include "core/colorpipeline.h"
 #include "eglcontext.h"
+#include "gllut.h"
 #include "glplatform.h"
 #include "glshader.h"
 #include "glvertexbuffer.h"
 #include "utils/common.h"
+#include "utils/envvar.h"
 
+#include <QCryptographicHash>
+#include <QDir>
 #include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QTextStream>
 
+#include <algorithm>
+#include <cstring>
+
 namespace KWin
 {
 
+static const bool s_programCache = environmentVariableBoolValue("KWIN_SHADER_CACHE").value_or(true);
+
 ShaderManager *ShaderManager::instance()
 {
     return EglContext::currentContext()->shaderManager();
@@ -37,6 +49,40 @@ ShaderManager::~ShaderManager()
     }
 }
 
+GlLookUpTable *ShaderManager::tonemappingLut(double referenceLuminance, double maxInputLuminance, double maxOutputLuminance)
+{
+    const auto it = std::ranges::find_if(m_tonemappingLuts, [&](const TonemappingLut &lut) {
+        return lut.referenceLuminance == referenceLuminance && lut.maxInputLuminance == maxInputLuminance && lut.maxOutputLuminance == maxOutputLuminance;
+    });
+    if (it != m_tonemappingLuts.end()) {
+        if (it != m_tonemappingLuts.begin()) {
+            std::rotate(m_tonemappingLuts.begin(), it, it + 1);
+        }
+        return m_tonemappingLuts.front().lut.get();
+    }
+
+    const ColorTonemapper tonemapper(referenceLuminance, maxInputLuminance, maxOutputLuminance);
+    const auto sample = [&tonemapper](size_t index) {
+        const double mapped = tonemapper.map(index / double(s_tonemappingLutSize - 1));
+        return QVector3D(mapped, mapped, mapped);
+    };
+    auto lut = GlLookUpTable::create(sample, s_tonemappingLutSize);
+    if (!lut) {
+        return nullptr;
+    }
+    // usually there's only a handful of HDR videos or games and outputs with different brightness
+    if (m_tonemappingLuts.size() >= 8) {
+        m_tonemappingLuts.pop_back();
+    }
+    m_tonemappingLuts.push_front(TonemappingLut{
+        .referenceLuminance = referenceLuminance,
+        .maxInputLuminance = maxInputLuminance,
+        .maxOutputLuminance = maxOutputLuminance,
+        .lut = std::move(lut),
+    });
+    return m_tonemappingLuts.front().lut.get();
+}
+
 QByteArray ShaderManager::generateVertexSource(ShaderTraits traits) const
 {
     QByteArray source;
@@ -95,7 +141,7 @@ QByteArray ShaderManager::generateVertexSource(ShaderTraits traits) const
     return source;
 }
 
-QByteArray ShaderManager::generateFragmentSource(ShaderTraits traits) const
+QByteArray ShaderManager::generateFragmentSource(ShaderTraits traits, const ColorspaceShape *shape) const
 {
     QByteArray source;
     QTextStream stream(&source);
@@ -167,6 +213,16 @@ QByteArray ShaderManager::generateFragmentSource(ShaderTraits traits) const
         stream << "#include \"saturation.glsl\"\n";
     }
     if (traits & ShaderTrait::TransformColorspace) {
+        if (shape) {
+            stream << "#define SOURCE_NAMED_TRANSFER_FUNCTION " << int(shape->sourceTransferFunction) << "\n";
+            stream << "#define DESTINATION_NAMED_TRANSFER_FUNCTION " << int(shape->destinationTransferFunction) << "\n";
+            if (!shape->tonemapping) {
+                stream << "#define SKIP_TONEMAPPING\n";
+            } else if (context->hasVersion(Version(3, 0))) {
+                // filtering half float textures needs OpenGL (ES) 3.0
+                stream << "#define TONEMAPPING_LUT " << s_tonemappingLutSize << "\n";
+            }
+        }
         stream << "#include \"colormanagement.glsl\"\n";
     }
     if (traits & ShaderTrait::RoundedCorners) {
@@ -229,9 +285,9 @@ QByteArray ShaderManager::generateFragmentSource(ShaderTraits traits) const
     return source;
 }
 
-std::unique_ptr<GLShader> ShaderManager::generateShader(ShaderTraits traits)
+std::unique_ptr<GLShader> ShaderManager::generateShader(ShaderTraits traits, const ColorspaceShape *shape)
 {
-    return generateCustomShader(traits);
+    return generateCustomShader(traits, QByteArray(), generateFragmentSource(traits, shape));
 }
 
 std::optional<QByteArray> ShaderManager::preprocess(const QByteArray &src, int recursionDepth) const
@@ -275,6 +331,19 @@ std::unique_ptr<GLShader> ShaderManager::generateCustomShader(ShaderTraits trait
         return nullptr;
     }
 
+    const QString cacheDirectory = programCacheDirectory();
+    QString cacheFileName;
+    if (!cacheDirectory.isEmpty()) {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(*vertex);
+        hash.addData(QByteArrayView("\0", 1));
+        hash.addData(*fragment);
+        cacheFileName = cacheDirectory + QString::fromLatin1(hash.result().toHex());
+        if (auto shader = loadCachedProgram(cacheFileName)) {
+            return shader;
+        }
+    }
+
     std::unique_ptr<GLShader> shader{new GLShader(GLShader::ExplicitLinking)};
     if (!shader->load(*vertex, *fragment)) {
         return nullptr;
@@ -284,10 +353,108 @@ std::unique_ptr<GLShader> ShaderManager::generateCustomShader(ShaderTraits trait
     shader->bindAttributeLocation("texcoord", VA_TexCoord);
     shader->bindFragDataLocation("fragColor", 0);
 
+    if (!cacheFileName.isEmpty()) {
+        shader->setBinaryRetrievable();
+    }
     shader->link();
+    if (!cacheFileName.isEmpty() && shader->isValid()) {
+        storeCachedProgram(cacheFileName, shader.get());
+    }
+    return shader;
+}
+
+QString ShaderManager::programCacheDirectory()
+{
+    if (m_programCacheDirectory) {
+        return *m_programCacheDirectory;
+    }
+    m_programCacheDirectory = QString();
+    if (!s_programCache) {
+        return QString();
+    }
+
+    const auto context = EglContext::currentContext();
+    const bool supported = context->isOpenGLES() ? context->hasVersion(Version(3, 0)) : (context->hasVersion(Version(4, 1)) || context->hasOpenglExtension(QByteArrayLiteral("GL_ARB_get_program_binary")));
+    if (!supported) {
+        return QString();
+    }
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) {
+        return QString();
+    }
+
+    // the binaries only work with the driver and the gpu they have been made for, a driver
+    // update changes the version string
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(context->vendor());
+    hash.addData(context->renderer());
+    hash.addData(context->openglVersionString());
+    const QString driver = QString::fromLatin1(hash.result().toHex());
+
+    // several sessions on the same host can share a cache, e.g. on multi-seat or VDI hosts. The
+    // binaries are written atomically, so concurrent sessions never see partially written files
+    const QString sharedCacheRoot = qEnvironmentVariable("KWIN_SHADER_CACHE_DIR");
+    QDir cacheRoot(sharedCacheRoot.isEmpty() ? QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1StringView("/kwin/shaders") : sharedCacheRoot);
+    if (!cacheRoot.mkpath(driver)) {
+        qCWarning(KWIN_OPENGL) << "Failed to create the shader cache in" << cacheRoot.path();
+        return QString();
+    }
+    // the binaries for other drivers are never going to be used again. A shared cache can
+    // be used by sessions on different gpus at the same time though
+    if (sharedCacheRoot.isEmpty()) {
+        const QStringList entries = cacheRoot.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const QString &entry : entries) {
+            if (entry != driver && entry.size() == driver.size()) {
+                QDir(cacheRoot.filePath(entry)).removeRecursively();
+            }
+        }
+    }
+
+    m_programCacheDirectory = cacheRoot.filePath(driver) + QLatin1Char('/');
+    return *m_programCacheDirectory;
+}
+
+std::unique_ptr<GLShader> ShaderManager::loadCachedProgram(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    const QByteArray data = file.readAll();
+    GLenum format;
+    if (data.size() <= qsizetype(sizeof(format))) {
+        return nullptr;
+    }
+    std::memcpy(&format, data.constData(), sizeof(format));
+
+    std::unique_ptr<GLShader> shader{new GLShader(GLShader::ExplicitLinking)};
+    if (!shader->loadBinary(format, data.mid(sizeof(format)))) {
+        qCDebug(KWIN_OPENGL) << "Discarding the cached shader" << fileName;
+        file.remove();
+        return nullptr;
+    }
     return shader;
 }
 
+void ShaderManager::storeCachedProgram(const QString &fileName, GLShader *shader)
+{
+    GLenum format = 0;
+    const QByteArray binary = shader->programBinary(&format);
+    if (binary.isEmpty()) {
+        return;
+    }
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    file.write(reinterpret_cast<const char *>(&format), sizeof(format));
+    file.write(binary);
+    if (!file.commit()) {
+        qCDebug(KWIN_OPENGL) << "Failed to write the cached shader" << fileName;
+    }
+}
+
 static QString resolveShaderFilePath(const QString &filePath)
 {
     QString suffix;
@@ -348,6 +515,16 @@ GLShader *ShaderManager::shader(ShaderTraits traits)
     return shader.get();
 }
 
+GLShader *ShaderManager::shader(ShaderTraits traits, const ColorspaceShape &shape)
+{
+    Q_ASSERT(traits & ShaderTrait::TransformColorspace);
+    std::unique_ptr<GLShader> &shader = m_specializedShaders[std::make_pair(traits.toInt(), shape)];
+    if (!shader) {
+        shader = generateShader(traits, &shape);
+    }
+    return shader.get();
+}
+
 GLShader *ShaderManager::getBoundShader() const
 {
     if (m_boundShaders.isEmpty()) {
@@ -369,6 +546,13 @@ GLShader *ShaderManager::pushShader(ShaderTraits traits)
     return shader;
 }
 
+GLShader *ShaderManager::pushShader(ShaderTraits traits, const ColorspaceShape &shape)
+{
+    GLShader *shader = this->shader(traits, shape);
+    pushShader(shader);
+    return shader;
+}
+
 void ShaderManager::pushShader(GLShader *shader)
 {
     // only bind shader if it is not already bound
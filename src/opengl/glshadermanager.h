@@ -10,17 +10,21 @@
 */
 #pragma once
 #include "kwin_export.h"
+#include "opengl/glshader.h"
 
 #include <QByteArray>
 #include <QFlags>
 #include <QStack>
+#include <QString>
+#include <deque>
 #include <map>
 #include <memory>
 
 namespace KWin
 {
 
-class GLShader;
+class GlLookUpTable;
+
 
 enum class ShaderTrait {
     MapTexture = (1 << 0),
@@ -58,6 +62,11 @@ public:
      * Returns a shader with the given traits, creating it if necessary.
      */
     GLShader *shader(ShaderTraits traits);
+    /**
+     * Returns a shader with the given traits that is specialized for the color transformation
+     * @p shape, creating it if necessary. The @p traits must contain ShaderTrait::TransformColorspace.
+     */
+    GLShader *shader(ShaderTraits traits, const ColorspaceShape &shape);
 
     /**
      * @return The currently bound shader or @c null if no shader is bound.
@@ -74,6 +83,7 @@ public:
      * with the given traits.
      */
     GLShader *pushShader(ShaderTraits traits);
+    GLShader *pushShader(ShaderTraits traits, const ColorspaceShape &shape);
 
     /**
      * Binds the @p shader.
@@ -147,17 +157,42 @@ public:
      */
     static ShaderManager *instance();
 
+    /**
+     * Returns a lookup table that maps PQ encoded luminance to tone mapped PQ encoded luminance.
+     * Shaders generated for a ColorspaceShape with tone mapping use it instead of evaluating
+     * the tone mapping curve for every pixel.
+     */
+    GlLookUpTable *tonemappingLut(double referenceLuminance, double maxInputLuminance, double maxOutputLuminance);
+    static constexpr int s_tonemappingLutSize = 1024;
+
 private:
     void bindFragDataLocations(GLShader *shader);
     void bindAttributeLocations(GLShader *shader) const;
 
     std::optional<QByteArray> preprocess(const QByteArray &src, int recursionDepth = 0) const;
     QByteArray generateVertexSource(ShaderTraits traits) const;
-    QByteArray generateFragmentSource(ShaderTraits traits) const;
-    std::unique_ptr<GLShader> generateShader(ShaderTraits traits);
+    QByteArray generateFragmentSource(ShaderTraits traits, const ColorspaceShape *shape = nullptr) const;
+    std::unique_ptr<GLShader> generateShader(ShaderTraits traits, const ColorspaceShape *shape = nullptr);
+
+    QString programCacheDirectory();
+    std::unique_ptr<GLShader> loadCachedProgram(const QString &fileName);
+    void storeCachedProgram(const QString &fileName, GLShader *shader);
+
+    // empty if program binaries can't be cached
+    std::optional<QString> m_programCacheDirectory;
 
     QStack<GLShader *> m_boundShaders;
     std::map<ShaderTraits, std::unique_ptr<GLShader>> m_shaderHash;
+    std::map<std::pair<int, ColorspaceShape>, std::unique_ptr<GLShader>> m_specializedShaders;
+    struct TonemappingLut
+    {
+        double referenceLuminance;
+        double maxInputLuminance;
+        double maxOutputLuminance;
+        std::unique_ptr<GlLookUpTable> lut;
+    };
+    // the most recently used one is at the front
+    std::deque<TonemappingLut> m_tonemappingLuts;
 };
 
 /**
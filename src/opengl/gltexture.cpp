@@ -11,6 +11,7 @@
 
 #include "gltexture_p.h"
 #include "opengl/glframebuffer.h"
+#include "opengl/glpixelbuffer.h"
 #include "opengl/glplatform.h"
 #include "opengl/glutils.h"
 #include "utils/common.h"
@@ -21,9 +22,19 @@
 #include <QVector3D>
 #include <QVector4D>
 
+#include <cstring>
+
 namespace KWin
 {
 
+// offsets into pixel buffers are kept aligned, some drivers take a slow path otherwise
+static constexpr size_t s_pixelBufferAlignment = 16;
+
+static size_t align(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
 // Table of GL formats/types associated with different values of QImage::Format.
 // Zero values indicate a direct upload is not feasible.
 //
@@ -121,6 +132,7 @@ GLTexturePrivate::GLTexturePrivate()
 
 GLTexturePrivate::~GLTexturePrivate()
 {
+    GpuMemoryStatistics::remove(m_memoryCategory, m_accountedBytes);
     if (!EglContext::currentContext()) {
         qCWarning(KWIN_OPENGL, "Could not delete texture because no context is current");
         return;
@@ -130,6 +142,45 @@ GLTexturePrivate::~GLTexturePrivate()
     }
 }
 
+static qint64 bytesPerPixel(GLenum internalFormat)
+{
+    switch (internalFormat) {
+    case GL_R8:
+        return 1;
+    case GL_RG8:
+    case GL_R16:
+        return 2;
+    case GL_RGBA16F:
+    case GL_RGBA16:
+        return 8;
+    case GL_RGBA32F:
+        return 16;
+    default:
+        return 4;
+    }
+}
+
+// Only the storage allocated by the compositor itself is accounted, not imported buffers
+static void accountStorage(GLTexturePrivate *d)
+{
+    qint64 bytes = qint64(d->m_size.width()) * d->m_size.height() * bytesPerPixel(d->m_internalFormat);
+    if (d->m_mipLevels > 1) {
+        bytes = bytes * 4 / 3;
+    }
+    d->m_accountedBytes = bytes;
+    GpuMemoryStatistics::add(d->m_memoryCategory, bytes);
+}
+
+void GLTexture::setMemoryCategory(GpuMemoryCategory category)
+{
+    if (d->m_memoryCategory == category) {
+        return;
+    }
+    GpuMemoryStatistics::remove(d->m_memoryCategory, d->m_accountedBytes);
+    d->m_memoryCategory = category;
+    GpuMemoryStatistics::add(d->m_memoryCategory, d->m_accountedBytes);
+}
+
 bool GLTexture::isNull() const
 {
     return GL_NONE == d->m_texture;
@@ -192,18 +243,47 @@ void GLTexture::update(const QImage &image, const Region &region, const QPoint &
 
     bind();
 
-    for (const Rect &rect : region.rects()) {
-        Q_ASSERT(im.depth() % 8 == 0);
-        glPixelStorei(GL_UNPACK_ROW_LENGTH, im.bytesPerLine() / (im.depth() / 8));
-        glPixelStorei(GL_UNPACK_SKIP_PIXELS, rect.x());
-        glPixelStorei(GL_UNPACK_SKIP_ROWS, rect.y());
+    Q_ASSERT(im.depth() % 8 == 0);
+    const size_t bytesPerPixel = im.depth() / 8;
 
-        glTexSubImage2D(d->m_target, 0, offset.x() + rect.x(), offset.y() + rect.y(), rect.width(), rect.height(), glFormat, type, im.constBits());
+    // Big uploads are copied into a pixel buffer first, so the GPU can copy them into the
+    // texture asynchronously instead of the driver blocking until it's done
+    size_t uploadSize = 0;
+    for (const Rect &rect : region.rects()) {
+        uploadSize += align(size_t(rect.width()) * rect.height() * bytesPerPixel, s_pixelBufferAlignment);
     }
+    GLPixelUploadBuffer *pixelBuffer = context->pixelUploadBuffer();
+    uint8_t *staging = pixelBuffer && uploadSize >= GLPixelUploadBuffer::s_minimumUploadSize ? pixelBuffer->map(uploadSize) : nullptr;
 
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    if (staging) {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        size_t stagingOffset = 0;
+        for (const Rect &rect : region.rects()) {
+            const size_t rowSize = rect.width() * bytesPerPixel;
+            for (int y = 0; y < rect.height(); ++y) {
+                std::memcpy(staging + stagingOffset + y * rowSize, im.constScanLine(rect.y() + y) + rect.x() * bytesPerPixel, rowSize);
+            }
+
+            glTexSubImage2D(d->m_target, 0, offset.x() + rect.x(), offset.y() + rect.y(), rect.width(), rect.height(), glFormat, type, reinterpret_cast<const void *>(stagingOffset));
+            stagingOffset += align(rowSize * rect.height(), s_pixelBufferAlignment);
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        pixelBuffer->unmap();
+    } else {
+        for (const Rect &rect : region.rects()) {
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, im.bytesPerLine() / bytesPerPixel);
+            glPixelStorei(GL_UNPACK_SKIP_PIXELS, rect.x());
+            glPixelStorei(GL_UNPACK_SKIP_ROWS, rect.y());
+
+            glTexSubImage2D(d->m_target, 0, offset.x() + rect.x(), offset.y() + rect.y(), rect.width(), rect.height(), glFormat, type, im.constBits());
+        }
+
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+        glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    }
 
     unbind();
 }
@@ -507,7 +587,9 @@ std::unique_ptr<GLTexture> GLTexture::allocate(GLenum internalFormat, const QSiz
         // internalFormat() won't need to be specialized for GLES2.
     }
     glBindTexture(GL_TEXTURE_2D, 0);
-    return std::unique_ptr<GLTexture>(new GLTexture(GL_TEXTURE_2D, texture, internalFormat, size, levels, true, OutputTransform{}));
+    auto ret = std::unique_ptr<GLTexture>(new GLTexture(GL_TEXTURE_2D, texture, internalFormat, size, levels, true, OutputTransform{}));
+    accountStorage(ret->d.get());
+    return ret;
 }
 
 std::unique_ptr<GLTexture> GLTexture::upload(const QImage &image)
@@ -575,7 +657,9 @@ std::unique_ptr<GLTexture> GLTexture::upload(const QImage &image)
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    return std::unique_ptr<GLTexture>(new GLTexture(GL_TEXTURE_2D, texture, internalFormat, image.size(), 1, true, OutputTransform::FlipY));
+    auto ret = std::unique_ptr<GLTexture>(new GLTexture(GL_TEXTURE_2D, texture, internalFormat, image.size(), 1, true, OutputTransform::FlipY));
+    accountStorage(ret->d.get());
+    return ret;
 }
 
 std::unique_ptr<GLTexture> GLTexture::upload(const QPixmap &pixmap)
@@ -29,6 +29,7 @@ namespace KWin
 
 class GLVertexBuffer;
 class GLTexturePrivate;
+enum class GpuMemoryCategory;
 
 enum TextureCoordinateType {
     NormalizedCoordinates = 0,
@@ -102,6 +103,13 @@ public:
 
     void generateMipmaps();
 
+    /**
+     * Accounts the storage of this texture to the given @a category in GpuMemoryStatistics.
+     * By default, textures that are allocated or uploaded by the compositor are accounted as
+     * GpuMemoryCategory::Textures.
+     */
+    void setMemoryCategory(GpuMemoryCategory category);
+
     /**
      * Returns true if texture swizzle is supported, and false otherwise
      *
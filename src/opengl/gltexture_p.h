@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "core/gpumemorystatistics.h"
 #include "opengl/glutils.h"
 
 #include <QImage>
@@ -47,6 +48,8 @@ public:
     bool m_wrapModeChanged;
     bool m_owning;
     int m_mipLevels;
+    GpuMemoryCategory m_memoryCategory = GpuMemoryCategory::Textures;
+    qint64 m_accountedBytes = 0;
 
     int m_unnormalizeActive; // 0 - no, otherwise refcount
     int m_normalizeActive; // 0 - no, otherwise refcount
@@ -18,6 +18,7 @@
 #include "utils/common.h"
 
 #include <QVector4D>
+#include <algorithm>
 #include <bitset>
 #include <deque>
 
@@ -137,6 +138,11 @@ public:
         return sum / Count;
     }
 
+    size_t peak() const
+    {
+        return *std::max_element(m_array.begin(), m_array.end());
+    }
+
 private:
     std::array<size_t, Count> m_array;
     int m_index = 0;
@@ -195,6 +201,7 @@ public:
     void reallocatePersistentBuffer(size_t size);
     bool awaitFence(intptr_t offset);
     GLvoid *getIdleRange(size_t size);
+    size_t streamingSize(size_t minSize) const;
 
     GLuint buffer;
     GLenum usage;
@@ -209,7 +216,8 @@ public:
     intptr_t baseAddress;
     uint8_t *map;
     std::deque<BufferFence> fences;
-    FrameSizesArray<4> frameSizes;
+    FrameSizesArray<8> frameSizes;
+    GLVertexBuffer::Statistics statistics;
     std::array<VertexAttrib, VertexAttributeCount> attrib;
     size_t attribStride = 0;
     std::bitset<32> enabledArrays;
@@ -237,6 +245,17 @@ void GLVertexBufferPrivate::unbindArrays()
     }
 }
 
+// The number of frames that the GPU can still be reading from the persistent buffer while
+// the next frame is being written. The buffer should hold them all, or we'll stall.
+static constexpr size_t s_framesInFlight = 3;
+
+size_t GLVertexBufferPrivate::streamingSize(size_t minSize) const
+{
+    // Leave room for one more frame, so a frame slightly bigger than the recent ones
+    // doesn't wait for the GPU, and round the size up to 64 kb
+    return align(std::max(frameSizes.peak() * (s_framesInFlight + 1), minSize), 64 * 1024);
+}
+
 void GLVertexBufferPrivate::reallocatePersistentBuffer(size_t size)
 {
     if (buffer != 0) {
@@ -251,9 +270,7 @@ void GLVertexBufferPrivate::reallocatePersistentBuffer(size_t size)
         glGenBuffers(1, &buffer);
     }
 
-    // Round the size up to 64 kb
-    size_t minSize = std::max<size_t>(frameSizes.average() * 3, 128 * 1024);
-    bufferSize = std::max(size, minSize);
+    bufferSize = std::max(size, streamingSize(128 * 1024));
 
     const GLbitfield storage = GL_DYNAMIC_STORAGE_BIT;
     const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
@@ -285,6 +302,7 @@ bool GLVertexBufferPrivate::awaitFence(intptr_t end)
 
     if (!fence.signaled()) {
         qCDebug(KWIN_OPENGL) << "Stalling on VBO fence";
+        statistics.stalls++;
         const GLenum ret = glClientWaitSync(fence.sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
 
         if (ret == GL_TIMEOUT_EXPIRED || ret == GL_WAIT_FAILED) {
@@ -305,6 +323,12 @@ bool GLVertexBufferPrivate::awaitFence(intptr_t end)
 GLvoid *GLVertexBufferPrivate::getIdleRange(size_t size)
 {
     if (size > bufferSize) {
+        // The buffer is released between frames when it needs to be resized, running out
+        // of space in the middle of a frame means that the frame is bigger than expected
+        if (bufferSize != 0) {
+            qCDebug(KWIN_OPENGL) << "Streaming VBO overflow, requested" << size << "bytes, the buffer has" << bufferSize;
+            statistics.overflows++;
+        }
         reallocatePersistentBuffer(size * 2);
     }
 
@@ -338,8 +362,10 @@ GLvoid *GLVertexBufferPrivate::getIdleRange(size_t size)
 void GLVertexBufferPrivate::reallocateBuffer(size_t size)
 {
     // Round the size up to 4 Kb for streaming/dynamic buffers.
+    // Streaming buffers are sized to hold the data of a whole frame so they are orphaned
+    // at most once per frame.
     const size_t minSize = 32768; // Minimum size for streaming buffers
-    const size_t alloc = usage != GL_STATIC_DRAW ? std::max(size, minSize) : size;
+    const size_t alloc = usage != GL_STATIC_DRAW ? std::max(size, streamingSize(minSize)) : size;
 
     glBufferData(GL_ARRAY_BUFFER, alloc, nullptr, usage);
 
@@ -351,9 +377,10 @@ GLvoid *GLVertexBufferPrivate::mapNextFreeRange(size_t size)
     GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
 
     if ((nextOffset + size) > bufferSize) {
-        // Reallocate the data store if it's too small.
-        if (size > bufferSize) {
+        // Reallocate the data store if it's too small, or if it can't hold the data of a frame.
+        if (size > bufferSize || (usage == GL_STREAM_DRAW && streamingSize(size) > bufferSize)) {
             reallocateBuffer(size);
+            statistics.reallocations++;
         } else {
             access |= GL_MAP_INVALIDATE_BUFFER_BIT;
             access ^= GL_MAP_UNSYNCHRONIZED_BIT;
@@ -537,31 +564,35 @@ void GLVertexBuffer::reset()
 
 void GLVertexBuffer::endOfFrame()
 {
-    if (!d->persistent) {
+    if (d->frameSize == 0) {
         return;
     }
 
-    // Emit a fence if we have uploaded data
-    if (d->frameSize > 0) {
-        d->frameSizes.push(d->frameSize);
-        d->frameSize = 0;
+    d->frameSizes.push(d->frameSize);
+    d->frameSize = 0;
 
-        // Force the buffer to be reallocated at the beginning of the next frame
-        // if the average frame size is greater than half the size of the buffer
-        if (d->frameSizes.average() > d->bufferSize / 2) {
-            deleteAll(d->fences);
-            glDeleteBuffers(1, &d->buffer);
+    if (!d->persistent) {
+        return;
+    }
 
-            d->buffer = 0;
-            d->bufferSize = 0;
-            d->nextOffset = 0;
-            d->map = nullptr;
-        } else {
-            if (auto sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)) {
-                d->fences.push_back(BufferFence{
-                    .sync = sync,
-                    .nextEnd = intptr_t(d->nextOffset + d->bufferSize)});
-            }
+    // Force the buffer to be reallocated at the beginning of the next frame if it can't
+    // hold all frames in flight, or if it has become much bigger than needed. Otherwise
+    // emit a fence for the uploaded data
+    const size_t required = d->frameSizes.peak() * s_framesInFlight;
+    if (required > d->bufferSize || (d->bufferSize > 128 * 1024 && required * 4 < d->bufferSize)) {
+        d->statistics.reallocations++;
+        deleteAll(d->fences);
+        glDeleteBuffers(1, &d->buffer);
+
+        d->buffer = 0;
+        d->bufferSize = 0;
+        d->nextOffset = 0;
+        d->map = nullptr;
+    } else {
+        if (auto sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)) {
+            d->fences.push_back(BufferFence{
+                .sync = sync,
+                .nextEnd = intptr_t(d->nextOffset + d->bufferSize)});
         }
     }
 }
@@ -592,4 +623,9 @@ void GLVertexBuffer::setPersistent()
     d->persistent = true;
 }
 
+GLVertexBuffer::Statistics GLVertexBuffer::statistics() const
+{
+    return d->statistics;
+}
+
 }
@@ -244,6 +244,27 @@ public:
 
     void setPersistent();
 
+    struct Statistics
+    {
+        /**
+         * The number of times the buffer was resized to match the amount of data per frame.
+         */
+        quint64 reallocations = 0;
+        /**
+         * The number of times a frame didn't fit into the persistent buffer.
+         */
+        quint64 overflows = 0;
+        /**
+         * The number of times the CPU had to wait for the GPU to finish using the buffer.
+         */
+        quint64 stalls = 0;
+    };
+
+    /**
+     * Returns the statistics of the streaming usage of this buffer.
+     */
+    Statistics statistics() const;
+
     /**
      * @return A shared VBO for streaming data
      * @since 4.7
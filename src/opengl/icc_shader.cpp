@@ -48,6 +48,7 @@ bool IccShader::setProfile(const std::shared_ptr<IccProfile> &profile, const std
         m_matrix2.setToIdentity();
         m_M.reset();
         m_C.reset();
+        m_lut3D.reset();
         m_A.reset();
         return false;
     }
@@ -58,6 +59,7 @@ bool IccShader::setProfile(const std::shared_ptr<IccProfile> &profile, const std
         QMatrix4x4 matrix2;
         std::unique_ptr<GlLookUpTable> M;
         std::unique_ptr<GlLookUpTable3D> C;
+        std::shared_ptr<ColorLUT3D> lut3D;
         std::unique_ptr<GlLookUpTable> A;
         const ColorDescription linearizedInput(inputColor->containerColorimetry(), TransferFunction(TransferFunction::linear, 0, 1), 1, 0, 1, 1);
         const ColorDescription linearizedProfile(profile->colorimetry(), TransferFunction(TransferFunction::linear, 0, 1), 1, 0, 1, 1);
@@ -114,13 +116,19 @@ bool IccShader::setProfile(const std::shared_ptr<IccProfile> &profile, const std
             }
             if (it != tag->ops.end() && std::holds_alternative<std::shared_ptr<ColorLUT3D>>(it->operation)) {
                 const auto &op = std::get<std::shared_ptr<ColorLUT3D>>(it->operation);
-                const auto sample = [op](size_t x, size_t y, size_t z) {
-                    return op->sample(x, y, z);
-                };
-                C = GlLookUpTable3D::create(sample, op->xSize(), op->ySize(), op->zSize());
-                if (!C) {
-                    return false;
+                if (m_C && m_lut3D == op) {
+                    // the 3D LUT only depends on the profile, not on the input color
+                    C = std::move(m_C);
+                } else {
+                    const auto sample = [op](size_t x, size_t y, size_t z) {
+                        return op->sample(x, y, z);
+                    };
+                    C = GlLookUpTable3D::create(sample, op->xSize(), op->ySize(), op->zSize());
+                    if (!C) {
+                        return false;
+                    }
                 }
+                lut3D = op;
                 it++;
             }
             if (it != tag->ops.end() && std::holds_alternative<std::shared_ptr<ColorTransformation>>(it->operation)) {
@@ -179,6 +187,7 @@ bool IccShader::setProfile(const std::shared_ptr<IccProfile> &profile, const std
         m_matrix2 = matrix2;
         m_M = std::move(M);
         m_C = std::move(C);
+        m_lut3D = std::move(lut3D);
         m_A = std::move(A);
         m_profile = profile;
         m_inputColor = inputColor;
@@ -13,6 +13,7 @@
 namespace KWin
 {
 
+class ColorLUT3D;
 class IccProfile;
 class GLShader;
 class GlLookUpTable;
@@ -41,6 +42,7 @@ private:
     QMatrix4x4 m_matrix2;
     std::unique_ptr<GlLookUpTable> m_M;
     std::unique_ptr<GlLookUpTable3D> m_C;
+    std::shared_ptr<ColorLUT3D> m_lut3D;
     std::unique_ptr<GlLookUpTable> m_A;
     struct Locations
     {
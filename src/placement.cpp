@@ -21,6 +21,8 @@
 #include <QTextStream>
 #include <QTimer>
 
+#include <vector>
+
 namespace KWin
 {
 
@@ -176,6 +178,33 @@ std::optional<PlacementCommand> Placement::placeSmart(const Window *window, cons
     int xl, xr, yt, yb; // temp coords
     int basket; // temp holder
 
+    // the candidate positions are tested against the same windows over and over again,
+    // so look them up only once rather than walking the whole stacking order every time
+    struct Obstacle
+    {
+        int xl, xr, yt, yb;
+        int weight;
+    };
+    std::vector<Obstacle> obstacles;
+    for (Window *client : workspace()->stackingOrder()) {
+        if (isIrrelevant(client, window, desktop)) {
+            continue;
+        }
+        Obstacle obstacle;
+        obstacle.xl = client->x();
+        obstacle.yt = client->y();
+        obstacle.xr = obstacle.xl + client->width();
+        obstacle.yb = obstacle.yt + client->height();
+        if (client->keepAbove()) {
+            obstacle.weight = 16;
+        } else if (client->keepBelow() && !client->isDock()) { // ignore KeepBelow windows
+            obstacle.weight = 0; // for placement (see X11Window::belongsToLayer() for Dock)
+        } else {
+            obstacle.weight = 1;
+        }
+        obstacles.push_back(obstacle);
+    }
+
     // get the maximum allowed windows space
     int x = area.left();
     int y = area.top();
@@ -207,29 +236,14 @@ std::optional<PlacementCommand> Placement::placeSmart(const Window *window, cons
             cxr = x + cw;
             cyt = y;
             cyb = y + ch;
-            for (auto l = workspace()->stackingOrder().constBegin(); l != workspace()->stackingOrder().constEnd(); ++l) {
-                auto client = *l;
-                if (isIrrelevant(client, window, desktop)) {
-                    continue;
-                }
-                xl = client->x();
-                yt = client->y();
-                xr = xl + client->width();
-                yb = yt + client->height();
-
+            for (const Obstacle &obstacle : obstacles) {
                 // if windows overlap, calc the overall overlapping
-                if ((cxl < xr) && (cxr > xl) && (cyt < yb) && (cyb > yt)) {
-                    xl = std::max(cxl, xl);
-                    xr = std::min(cxr, xr);
-                    yt = std::max(cyt, yt);
-                    yb = std::min(cyb, yb);
-                    if (client->keepAbove()) {
-                        overlap += 16 * (xr - xl) * (yb - yt);
-                    } else if (client->keepBelow() && !client->isDock()) { // ignore KeepBelow windows
-                        overlap += 0; // for placement (see X11Window::belongsToLayer() for Dock)
-                    } else {
-                        overlap += (xr - xl) * (yb - yt);
-                    }
+                if ((cxl < obstacle.xr) && (cxr > obstacle.xl) && (cyt < obstacle.yb) && (cyb > obstacle.yt)) {
+                    xl = std::max(cxl, obstacle.xl);
+                    xr = std::min(cxr, obstacle.xr);
+                    yt = std::max(cyt, obstacle.yt);
+                    yb = std::min(cyb, obstacle.yb);
+                    overlap += obstacle.weight * (xr - xl) * (yb - yt);
                 }
             }
         }
@@ -261,16 +275,11 @@ std::optional<PlacementCommand> Placement::placeSmart(const Window *window, cons
             }
 
             // compare to the position of each client on the same desk
-            for (auto l = workspace()->stackingOrder().constBegin(); l != workspace()->stackingOrder().constEnd(); ++l) {
-                auto client = *l;
-                if (isIrrelevant(client, window, desktop)) {
-                    continue;
-                }
-
-                xl = client->x();
-                yt = client->y();
-                xr = xl + client->width();
-                yb = yt + client->height();
+            for (const Obstacle &obstacle : obstacles) {
+                xl = obstacle.xl;
+                yt = obstacle.yt;
+                xr = obstacle.xr;
+                yb = obstacle.yb;
 
                 // if not enough room above or under the current tested client
                 // determine the first non-overlapped x position
@@ -299,16 +308,11 @@ std::optional<PlacementCommand> Placement::placeSmart(const Window *window, cons
             }
 
             // test the position of each window on the desk
-            for (auto l = workspace()->stackingOrder().constBegin(); l != workspace()->stackingOrder().constEnd(); ++l) {
-                auto client = *l;
-                if (isIrrelevant(client, window, desktop)) {
-                    continue;
-                }
-
-                xl = client->x();
-                yt = client->y();
-                xr = xl + client->width();
-                yb = yt + client->height();
+            for (const Obstacle &obstacle : obstacles) {
+                xl = obstacle.xl;
+                yt = obstacle.yt;
+                xr = obstacle.xr;
+                yb = obstacle.yb;
 
                 // if not enough room to the left or right of the current tested client
                 // determine the first non-overlapped y position
@@ -6,6 +6,7 @@
 
 #include "pluginmanager.h"
 #include "dbusinterface.h"
+#include "effect/effect.h"
 #include "main.h"
 #include "plugin.h"
 #include "utils/common.h"
@@ -14,6 +15,7 @@
 #include <KPluginFactory>
 #include <KPluginMetaData>
 #include <QPluginLoader>
+#include <QtConcurrentRun>
 
 namespace KWin
 {
@@ -53,6 +55,36 @@ PluginManager::PluginManager()
 
 PluginManager::~PluginManager() = default;
 
+QFuture<void> PluginManager::preloadLibraries()
+{
+    // the config isn't safe to be read from another thread, take a copy of the enabled states
+    const QMap<QString, QString> config = KConfigGroup(kwinApp()->config(), QStringLiteral("Plugins")).entryMap();
+
+    return QtConcurrent::run([config]() {
+        const auto preload = [&config](const QString &directory, const QString &iid) {
+            const QList<KPluginMetaData> plugins = KPluginMetaData::findPlugins(directory);
+            for (const KPluginMetaData &metadata : plugins) {
+                if (metadata.isStaticPlugin()) {
+                    continue;
+                }
+                const auto it = config.constFind(metadata.pluginId() + QLatin1StringView("Enabled"));
+                const bool enabled = it != config.constEnd() ? QVariant(*it).toBool() : metadata.isEnabledByDefault();
+                if (!enabled) {
+                    continue;
+                }
+                QPluginLoader loader(metadata.fileName());
+                if (loader.metaData().value("IID").toString() == iid) {
+                    // the library stays loaded after the loader is gone, only instance() has
+                    // to be called on the main thread
+                    loader.load();
+                }
+            }
+        };
+        preload(s_pluginDirectory, QStringLiteral(PluginFactory_iid));
+        preload(QStringLiteral("kwin/effects/plugins"), QStringLiteral(EffectPluginFactory_iid));
+    });
+}
+
 QStringList PluginManager::loadedPlugins() const
 {
     QStringList ret;
@@ -8,6 +8,7 @@
 
 #include "effect/globals.h"
 
+#include <QFuture>
 #include <QHash>
 #include <QObject>
 
@@ -32,6 +33,13 @@ public:
     QStringList loadedPlugins() const;
     QStringList availablePlugins() const;
 
+    /**
+     * Loads the shared libraries of the enabled plugins and effect plugins in a worker thread,
+     * so creating the plugins on the main thread later doesn't have to wait for the dynamic
+     * linker. The plugins themselves are not created.
+     */
+    static QFuture<void> preloadLibraries();
+
 public Q_SLOTS:
     bool loadPlugin(const QString &pluginId);
     void unloadPlugin(const QString &pluginId);
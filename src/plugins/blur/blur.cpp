@@ -10,11 +10,13 @@
 // KConfigSkeleton
 #include "blurconfig.h"
 
+#include "core/outputlayer.h"
 #include "core/pixelgrid.h"
 #include "core/rendertarget.h"
 #include "core/renderviewport.h"
 #include "effect/effecthandler.h"
 #include "opengl/glplatform.h"
+#include "opengl/glrendertargetpool.h"
 #include "scene/decorationitem.h"
 #include "scene/scene.h"
 #include "scene/surfaceitem.h"
@@ -258,6 +260,12 @@ void BlurEffect::reconfigure(ReconfigureFlags flags)
     m_noiseStrength = BlurConfig::noiseStrength();
     m_colorMatrix = colorTransformMatrix(BlurConfig::saturation() / 100.0, 1.0);
 
+    for (auto &[window, data] : m_windows) {
+        for (auto &[view, renderInfo] : data.render) {
+            renderInfo.backgroundChanged = true;
+        }
+    }
+
     // Update all windows for the blur to take effect
     effects->addRepaintFull();
 }
@@ -469,11 +477,22 @@ Region BlurEffect::blurRegion(EffectWindow *w) const
     return region;
 }
 
+static void addPendingRepaints(Item *item, RenderView *view, Region &region)
+{
+    region += item->deviceRepaints(view);
+    const auto childItems = item->childItems();
+    for (Item *childItem : childItems) {
+        addPendingRepaints(childItem, view, region);
+    }
+}
+
 void BlurEffect::prePaintScreen(ScreenPrePaintData &data)
 {
     m_paintedDeviceArea = Region();
     m_currentDeviceBlur = Region();
     m_currentView = data.view;
+    // repaints that don't belong to any window, e.g. the ones requested by effects
+    m_changedDeviceArea = data.view->layer() ? data.view->layer()->deviceRepaints() : Region::infinite();
 
     effects->prePaintScreen(data);
 }
@@ -506,6 +525,13 @@ void BlurEffect::prePaintWindow(RenderView *view, EffectWindow *w, WindowPrePain
     // in case this window has regions to be blurred
     const Region blurArea = view->mapToDeviceCoordinatesAligned(QRectF(blurRegion(w).boundingRect()).translated(w->pos()));
 
+    // the cached blurred background is only stale if something underneath has changed
+    if (m_changedDeviceArea.intersects(blurArea)) {
+        if (auto it = m_windows.find(w); it != m_windows.end()) {
+            it->second.render[view].backgroundChanged = true;
+        }
+    }
+
     // if this window or a window underneath the blurred area is painted again we have to
     // blur everything
     if (m_paintedDeviceArea.intersects(blurArea) || data.devicePaint.intersects(blurArea)) {
@@ -521,6 +547,10 @@ void BlurEffect::prePaintWindow(RenderView *view, EffectWindow *w, WindowPrePain
 
     m_paintedDeviceArea -= data.deviceOpaque;
     m_paintedDeviceArea += data.devicePaint;
+
+    // the damage of this window is only collected after all windows have been pre-painted
+    m_changedDeviceArea += data.devicePaint;
+    addPendingRepaints(w->windowItem(), view, m_changedDeviceArea);
 }
 
 bool BlurEffect::shouldBlur(const EffectWindow *w, int mask, const WindowPaintData &data) const
@@ -652,36 +682,42 @@ void BlurEffect::blur(const RenderTarget &renderTarget, const RenderViewport &vi
     }
 
     if (renderInfo.framebuffers.size() != (m_iterationCount + 1) || renderInfo.textures[0]->size() != backgroundRect.size() || renderInfo.textures[0]->internalFormat() != textureFormat) {
+        // interactive resizes change the size every frame, recycle the render targets
+        GLRenderTargetPool *pool = EglContext::currentContext()->renderTargetPool();
+        for (size_t i = 0; i < renderInfo.textures.size() && i < renderInfo.framebuffers.size(); ++i) {
+            pool->release(GLRenderTarget(std::move(renderInfo.textures[i]), std::move(renderInfo.framebuffers[i])));
+        }
         renderInfo.framebuffers.clear();
         renderInfo.textures.clear();
 
         glClearColor(0, 0, 0, 0);
         for (size_t i = 0; i <= m_iterationCount; ++i) {
-            auto texture = GLTexture::allocate(textureFormat, backgroundRect.size() / (1 << i));
-            if (!texture) {
-                qCWarning(KWIN_BLUR) << "Failed to allocate an offscreen texture";
-                return;
-            }
-            texture->setFilter(GL_LINEAR);
-            texture->setWrapMode(GL_CLAMP_TO_EDGE);
-
-            auto framebuffer = std::make_unique<GLFramebuffer>(texture.get());
-            if (!framebuffer->valid()) {
-                qCWarning(KWIN_BLUR) << "Failed to create an offscreen framebuffer";
+            GLRenderTarget target = pool->acquire(textureFormat, backgroundRect.size() / (1 << i));
+            if (!target) {
+                qCWarning(KWIN_BLUR) << "Failed to allocate an offscreen render target";
                 return;
             }
-            EglContext::currentContext()->pushFramebuffer(framebuffer.get());
+            EglContext::currentContext()->pushFramebuffer(target.framebuffer.get());
             glClear(GL_COLOR_BUFFER_BIT);
             EglContext::currentContext()->popFramebuffer();
-            renderInfo.textures.push_back(std::move(texture));
-            renderInfo.framebuffers.push_back(std::move(framebuffer));
+            renderInfo.textures.push_back(std::move(target.texture));
+            renderInfo.framebuffers.push_back(std::move(target.framebuffer));
         }
+        renderInfo.backgroundChanged = true;
     }
+    if (renderInfo.backgroundRect != backgroundRect) {
+        renderInfo.backgroundRect = backgroundRect;
+        renderInfo.backgroundChanged = true;
+    }
+    const bool blurBackground = renderInfo.backgroundChanged;
+    renderInfo.backgroundChanged = false;
 
     // Fetch the pixels behind the shape that is going to be blurred.
-    const Region dirtyRegion = viewport.mapFromDeviceCoordinatesContained(deviceRegion) & backgroundRect;
-    for (const Rect &dirtyRect : dirtyRegion.rects()) {
-        renderInfo.framebuffers[0]->blitFromRenderTarget(renderTarget, viewport, dirtyRect, dirtyRect.translated(-backgroundRect.topLeft()));
+    if (blurBackground) {
+        const Region dirtyRegion = viewport.mapFromDeviceCoordinatesContained(deviceRegion) & backgroundRect;
+        for (const Rect &dirtyRect : dirtyRegion.rects()) {
+            renderInfo.framebuffers[0]->blitFromRenderTarget(renderTarget, viewport, dirtyRect, dirtyRect.translated(-backgroundRect.topLeft()));
+        }
     }
 
     // Upload the geometry: the first 6 vertices are used when downsampling and upsampling offscreen,
@@ -789,7 +825,7 @@ void BlurEffect::blur(const RenderTarget &renderTarget, const RenderViewport &vi
     vbo->bindArrays();
 
     // The downsample pass of the dual Kawase algorithm: the background will be scaled down 50% every iteration.
-    {
+    if (blurBackground) {
         ShaderManager::instance()->pushShader(m_downsamplePass.shader.get());
 
         QMatrix4x4 projectionMatrix;
@@ -816,7 +852,7 @@ void BlurEffect::blur(const RenderTarget &renderTarget, const RenderViewport &vi
     }
 
     // The upsample pass of the dual Kawase algorithm: the background will be scaled up 200% every iteration.
-    {
+    if (blurBackground) {
         ShaderManager::instance()->pushShader(m_upsamplePass.shader.get());
 
         QMatrix4x4 projectionMatrix;
@@ -837,6 +873,7 @@ void BlurEffect::blur(const RenderTarget &renderTarget, const RenderViewport &vi
 
             vbo->draw(GL_TRIANGLES, 0, 6);
         }
+        GLFramebuffer::popFramebuffer();
 
         ShaderManager::instance()->popShader();
     }
@@ -849,7 +886,6 @@ void BlurEffect::blur(const RenderTarget &renderTarget, const RenderViewport &vi
         QMatrix4x4 projectionMatrix = viewport.projectionMatrix();
         projectionMatrix.translate(scaledBackgroundRect.x(), scaledBackgroundRect.y());
 
-        GLFramebuffer::popFramebuffer();
         const auto &read = renderInfo.framebuffers[1];
 
         const QVector2D halfpixel(0.5 / read->colorAttachment()->width(),
@@ -889,7 +925,6 @@ void BlurEffect::blur(const RenderTarget &renderTarget, const RenderViewport &vi
         QMatrix4x4 projectionMatrix = viewport.projectionMatrix();
         projectionMatrix.translate(scaledBackgroundRect.x(), scaledBackgroundRect.y());
 
-        GLFramebuffer::popFramebuffer();
         const auto &read = renderInfo.framebuffers[1];
 
         const QVector2D halfpixel(0.5 / read->colorAttachment()->width(),
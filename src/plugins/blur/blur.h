@@ -24,6 +24,11 @@ struct BlurRenderData
     /// contains not blurred background behind the window, it's cached.
     std::vector<std::unique_ptr<GLTexture>> textures;
     std::vector<std::unique_ptr<GLFramebuffer>> framebuffers;
+
+    /// The second texture contains the blurred background after the Dual Kawase passes, it's
+    /// only blurred again if something beneath the window has been repainted or it has moved
+    bool backgroundChanged = true;
+    QRect backgroundRect;
 };
 
 struct BlurEffectData
@@ -145,6 +150,7 @@ private:
 #endif
     Region m_paintedDeviceArea; // keeps track of all painted areas (from bottom to top)
     Region m_currentDeviceBlur; // keeps track of currently blurred area of the windows (from bottom to top)
+    Region m_changedDeviceArea; // keeps track of all areas whose contents change (from bottom to top)
     RenderView *m_currentView = nullptr;
 
     QMatrix4x4 m_colorMatrix;
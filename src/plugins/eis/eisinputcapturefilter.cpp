@@ -15,6 +15,12 @@
 
 namespace KWin
 {
+// libeis wants the timestamps of frames in microseconds
+static std::chrono::microseconds currentTime()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch());
+}
+
 EisInputCaptureFilter::EisInputCaptureFilter(EisInputCaptureManager *manager)
     : InputEventFilter(InputFilterOrder::EisInput)
     , m_manager(manager)
@@ -34,9 +40,9 @@ bool EisInputCaptureFilter::pointerMotion(PointerMotionEvent *event)
     if (!m_manager->activeCapture()) {
         return false;
     }
-    if (const auto pointer = m_manager->activeCapture()->pointer()) {
-        eis_device_pointer_motion(pointer, event->delta.x(), event->delta.y());
-    }
+    // high rate mice send many motion events per frame, only send their sum to the receiver
+    m_pendingMotion += event->delta;
+    m_pointerTimestamp = event->timestamp;
     return true;
 }
 
@@ -47,17 +53,23 @@ bool EisInputCaptureFilter::pointerButton(PointerButtonEvent *event)
     }
     if (const auto pointer = m_manager->activeCapture()->pointer()) {
         eis_device_button_button(pointer, event->nativeButton, event->state == PointerButtonState::Pressed);
+        m_pointerTimestamp = event->timestamp;
     }
     return true;
 }
 
 bool EisInputCaptureFilter::pointerFrame()
 {
+    const QPointF motion = std::exchange(m_pendingMotion, QPointF());
+    const std::chrono::microseconds timestamp = std::exchange(m_pointerTimestamp, std::chrono::microseconds::zero());
     if (!m_manager->activeCapture()) {
         return false;
     }
     if (const auto pointer = m_manager->activeCapture()->pointer()) {
-        eis_device_frame(pointer, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        if (!motion.isNull()) {
+            eis_device_pointer_motion(pointer, motion.x(), motion.y());
+        }
+        eis_device_frame(pointer, (timestamp != std::chrono::microseconds::zero() ? timestamp : currentTime()).count());
     }
     return true;
 }
@@ -100,7 +112,7 @@ bool EisInputCaptureFilter::keyboardKey(KeyboardKeyEvent *event)
     }
     if (const auto keyboard = m_manager->activeCapture()->keyboard()) {
         eis_device_keyboard_key(keyboard, event->nativeScanCode, event->state != KeyboardKeyState::Released);
-        eis_device_frame(keyboard, std::chrono::duration_cast<std::chrono::milliseconds>(event->timestamp).count());
+        eis_device_frame(keyboard, event->timestamp.count());
     }
     return true;
 }
@@ -158,7 +170,7 @@ bool EisInputCaptureFilter::touchFrame()
         return false;
     }
     if (const auto abs = m_manager->activeCapture()->absoluteDevice()) {
-        eis_device_frame(abs, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        eis_device_frame(abs, currentTime().count());
     }
     return true;
 }
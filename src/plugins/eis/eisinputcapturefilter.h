@@ -53,5 +53,7 @@ public:
 private:
     EisInputCaptureManager *m_manager;
     QHash<qint32, eis_touch *> m_touches;
+    QPointF m_pendingMotion;
+    std::chrono::microseconds m_pointerTimestamp = std::chrono::microseconds::zero();
 };
 }
@@ -39,7 +39,8 @@ class BarrierSpy : public InputEventSpy
 {
 public:
     BarrierSpy(EisInputCaptureManager *manager)
-        : manager(manager)
+        : InputEventSpy(InputEventType::Pointer | InputEventType::Keyboard)
+        , manager(manager)
     {
     }
     void pointerMotion(KWin::PointerMotionEvent *event) override
@@ -8,9 +8,11 @@
 */
 
 #include "emulatedinputdevice.h"
+#include "core/output.h"
 #include "gamecontroller_logging.h"
 #include "inputmethod.h"
 #include "main.h"
+#include "workspace.h"
 #include "xkb.h"
 
 #include <QKeySequence>
@@ -43,6 +45,9 @@ uint RebindScope::s_scopes = 0;
 
 static constexpr double s_deadzone = 0.25;
 
+// the pointer speeds are tuned for a motion event every 5ms
+static constexpr std::chrono::microseconds s_speedInterval = std::chrono::milliseconds(5);
+
 EmulatedInputDevice::EmulatedInputDevice(libevdev *device)
     : m_device(device)
     , m_leftStickMin(libevdev_get_abs_minimum(device, ABS_X), libevdev_get_abs_minimum(device, ABS_Y))
@@ -51,7 +56,6 @@ EmulatedInputDevice::EmulatedInputDevice(libevdev *device)
     , m_rightStickMax(libevdev_get_abs_maximum(device, ABS_RX), libevdev_get_abs_maximum(device, ABS_RY))
 {
     m_timer.setSingleShot(false);
-    m_timer.setInterval(5);
     m_timer.setTimerType(Qt::PreciseTimer);
     connect(&m_timer, &QTimer::timeout, this, &EmulatedInputDevice::handleAnalogStickInput);
 }
@@ -228,7 +232,11 @@ void EmulatedInputDevice::updateAnalogStick(input_event *ev)
     if (m_leftStick.isNull() && m_rightStick.isNull()) {
         m_timer.stop();
     } else if (!m_timer.isActive()) {
-        m_timer.start();
+        // there's no point in moving the pointer more often than the screen can show it
+        const Output *output = workspace()->activeOutput();
+        const uint32_t refreshRate = output && output->refreshRate() ? output->refreshRate() : 60000;
+        m_motionInterval = std::chrono::microseconds(1'000'000'000 / refreshRate);
+        m_timer.start(std::chrono::duration_cast<std::chrono::milliseconds>(m_motionInterval));
     }
 }
 
@@ -247,7 +255,7 @@ void EmulatedInputDevice::handleAnalogStickInput()
     // Provides more precise control at low speeds
     // and faster movement at high deflection (magnitude)
     const qreal speedMultiplier = MOUSE_BASE_SPEED + (MOUSE_MAX_SPEED - MOUSE_BASE_SPEED) * std::pow(magnitude, SPEED_CURVE_EXPONENT);
-    const QPointF delta = stick * speedMultiplier;
+    const QPointF delta = stick * speedMultiplier * (qreal(m_motionInterval.count()) / s_speedInterval.count());
     if (!delta.isNull()) {
         Q_EMIT pointerMotion(delta, delta, time, this);
         Q_EMIT pointerFrame(this);
@@ -58,6 +58,7 @@ private:
     const QPointF m_rightStickMin;
     const QPointF m_rightStickMax;
     QTimer m_timer;
+    std::chrono::microseconds m_motionInterval = std::chrono::milliseconds(5);
     QPointF m_leftStick;
     QPointF m_rightStick;
     PointerButtonState m_leftClick = PointerButtonState::Released;
@@ -103,6 +103,7 @@ void GameController::handleEvdevEvent()
 {
     input_event ev;
     int rc;
+    bool activity = false;
 
     while ((rc = libevdev_next_event(m_evdev.get(), LIBEVDEV_READ_FLAG_NORMAL, &ev)) != -EAGAIN) {
         if (rc == LIBEVDEV_READ_STATUS_SYNC) {
@@ -115,20 +116,24 @@ void GameController::handleEvdevEvent()
 
         if (rc == -ENODEV) {
             // device got removed, we can safely ignore this
-            return;
+            break;
         } else if (rc < 0) {
             qCWarning(KWIN_GAMECONTROLLER) << "Error reading event:" << strerror(-rc);
             break;
         }
 
         logEvent(&ev);
-
-        input()->simulateUserActivity();
+        activity = true;
 
         if (m_usageCount == 0 || isTestEnvironment) {
             m_inputdevice->emulateInputDevice(ev);
         }
     }
+
+    // analog sticks report many events per frame, reset the idle timers only once per batch
+    if (activity) {
+        input()->simulateUserActivity();
+    }
 }
 
 void GameController::logEvent(input_event *ev)
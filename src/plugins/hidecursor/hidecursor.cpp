@@ -14,7 +14,8 @@ namespace KWin
 {
 
 HideCursorEffect::HideCursorEffect()
-    : m_cursor(Cursors::self()->mouse())
+    : InputEventSpy(InputEventType::Pointer | InputEventType::Keyboard | InputEventType::Tablet)
+    , m_cursor(Cursors::self()->mouse())
 {
     input()->installInputEventSpy(this);
 
@@ -398,7 +398,28 @@ void ExpoLayout::updatePolish()
         const QMarginsF scaledMargins(margins.left() / scale, margins.top() / scale, margins.right() / scale, margins.bottom() / scale);
         windowSizes.emplace_back(cell->naturalRect().marginsAdded(scaledMargins));
     }
-    auto windowLayouts = ExpoLayout::layout(area, windowSizes);
+    const std::array<qreal, 9> parameters{
+        m_searchTolerance,
+        m_idealWidthRatio,
+        m_relativeMarginLeft,
+        m_relativeMarginRight,
+        m_relativeMarginTop,
+        m_relativeMarginBottom,
+        m_relativeMinLength,
+        m_maxGapRatio,
+        m_maxScale,
+    };
+    if (!m_cachedLayout || m_cachedLayout->area != area || m_cachedLayout->windowSizes != windowSizes
+        || m_cachedLayout->placementMode != m_placementMode || m_cachedLayout->parameters != parameters) {
+        m_cachedLayout = CachedLayout{
+            .area = area,
+            .windowSizes = windowSizes,
+            .placementMode = m_placementMode,
+            .parameters = parameters,
+            .windowLayouts = ExpoLayout::layout(area, windowSizes),
+        };
+    }
+    const QList<QRectF> &windowLayouts = m_cachedLayout->windowLayouts;
     for (int i = 0; i < windowLayouts.size(); ++i) {
         ExpoCell *cell = m_cells[i];
         QRectF target = windowLayouts[i];
@@ -473,7 +494,8 @@ LayeredPacking::LayeredPacking(qreal maxWidth, const QList<QRectF> &windowSizes,
  * @param leastWeightCandidate leastWeightCandidate(i, j) is the weight of arranging the first j windows,
  * if we use the optimal arrangement of the first i windows, and the last layest consists of windows [i, j)
  */
-static bool isDominated(size_t candidate, size_t alternativeSmall, size_t alternativeBig, size_t length, std::function<qreal(size_t, size_t)> leastWeightCandidate)
+template<typename LeastWeightCandidate>
+static bool isDominated(size_t candidate, size_t alternativeSmall, size_t alternativeBig, size_t length, const LeastWeightCandidate &leastWeightCandidate)
 {
     Q_ASSERT(alternativeSmall < candidate && candidate < alternativeBig);
     if (alternativeBig == length) {
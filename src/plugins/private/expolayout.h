@@ -12,6 +12,7 @@
 #include <QQuickItem>
 #include <QRect>
 
+#include <array>
 #include <optional>
 
 class ExpoCell;
@@ -184,6 +185,18 @@ private:
     qreal m_relativeMinLength = 0.15;
     qreal m_maxGapRatio = 1.5;
     qreal m_maxScale = 1.0;
+
+    // The cells get polished whenever anything about them changes, but the layout only depends on
+    // their natural geometry, so the last result is reused if that and the settings are the same
+    struct CachedLayout
+    {
+        QRectF area;
+        QList<QRectF> windowSizes;
+        PlacementMode placementMode;
+        std::array<qreal, 9> parameters;
+        QList<QRectF> windowLayouts;
+    };
+    std::optional<CachedLayout> m_cachedLayout;
 };
 
 class ExpoCell : public QQuickItem
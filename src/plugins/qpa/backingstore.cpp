@@ -37,6 +37,9 @@ void BackingStore::resize(const QSize &size, const QRegion &staticContents)
 {
     QPlatformWindow *platformWindow = static_cast<QPlatformWindow *>(window()->handle());
     platformWindow->invalidateSurface();
+
+    m_bufferFrames.clear();
+    m_damageJournal.clear();
 }
 
 void BackingStore::beginPaint(const QRegion &region)
@@ -61,11 +64,25 @@ void BackingStore::beginPaint(const QRegion &region)
         return;
     }
 
+    // The buffers of the previous swapchain are gone, so is their content
+    if (!oldBuffer) {
+        m_bufferFrames.clear();
+        m_damageJournal.clear();
+    }
+
+    // Only the parts that have changed since the buffer was painted the last time need to be
+    // copied from the previous buffer, just like with buffer age
+    const Rect bufferRect(QPoint(0, 0), m_buffer->size());
     if (oldBuffer && oldBuffer != m_buffer && oldBuffer->size() == m_buffer->size()) {
-        const GraphicsBufferView oldView(oldBuffer, GraphicsBuffer::Read);
-        std::memcpy(m_bufferView->image()->bits(), oldView.image()->constBits(), oldView.image()->sizeInBytes());
+        const auto it = m_bufferFrames.constFind(m_buffer);
+        const int bufferAge = it != m_bufferFrames.constEnd() ? int(m_frame - *it + 1) : 0;
+        repair(oldBuffer, m_damageJournal.accumulate(bufferAge, bufferRect));
     }
 
+    m_frame++;
+    m_bufferFrames[m_buffer] = m_frame;
+    m_damageJournal.add(Region(region).scaledAndRoundedOut(platformWindow->devicePixelRatio()).intersected(bufferRect));
+
     QImage *image = m_bufferView->image();
     image->setDevicePixelRatio(platformWindow->devicePixelRatio());
 
@@ -79,6 +96,27 @@ void BackingStore::beginPaint(const QRegion &region)
     }
 }
 
+void BackingStore::repair(GraphicsBuffer *source, const Region &region)
+{
+    if (region.isEmpty()) {
+        return;
+    }
+
+    const GraphicsBufferView sourceView(source, GraphicsBuffer::Read);
+    if (sourceView.isNull()) {
+        return;
+    }
+
+    const QImage *from = sourceView.image();
+    QImage *to = m_bufferView->image();
+    const int bytesPerPixel = from->depth() / 8;
+    for (const Rect &rect : region.rects()) {
+        for (int y = rect.top(); y < rect.bottom(); ++y) {
+            std::memcpy(to->scanLine(y) + rect.left() * bytesPerPixel, from->constScanLine(y) + rect.left() * bytesPerPixel, rect.width() * bytesPerPixel);
+        }
+    }
+}
+
 void BackingStore::endPaint()
 {
     m_bufferView.reset();
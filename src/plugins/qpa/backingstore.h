@@ -9,6 +9,9 @@
 */
 #pragma once
 
+#include "utils/damagejournal.h"
+
+#include <QHash>
 #include <QPointer>
 
 #include <qpa/qplatformbackingstore.h>
@@ -34,8 +37,13 @@ public:
     void endPaint() override;
 
 private:
+    void repair(GraphicsBuffer *source, const Region &region);
+
     QPointer<GraphicsBuffer> m_buffer;
     std::unique_ptr<GraphicsBufferView> m_bufferView;
+    DamageJournal m_damageJournal;
+    QHash<GraphicsBuffer *, quint64> m_bufferFrames;
+    quint64 m_frame = 0;
 };
 
 }
@@ -0,0 +1,242 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "outputscreencastrenderer.h"
+#include "filteredsceneview.h"
+#include "screencastlayer.h"
+
+#include "compositor.h"
+#include "core/colorspace.h"
+#include "core/graphicsbuffer.h"
+#include "core/output.h"
+#include "core/rendertarget.h"
+#include "core/renderviewport.h"
+#include "opengl/eglbackend.h"
+#include "opengl/egldisplay.h"
+#include "opengl/glframebuffer.h"
+#include "opengl/gltexture.h"
+#include "opengl/glutils.h"
+#include "scene/surfaceitem.h"
+#include "scene/workspacescene.h"
+
+namespace KWin
+{
+
+static QList<OutputScreenCastRenderer *> s_renderers;
+
+OutputScreenCastRenderer::OutputScreenCastRenderer(LogicalOutput *output, std::optional<pid_t> pidToHide, bool renderCursor)
+    : m_output(output)
+    , m_pidToHide(pidToHide)
+    , m_renderCursor(renderCursor)
+{
+    m_layer = std::make_unique<ScreencastLayer>(output, static_cast<EglBackend *>(Compositor::self()->backend())->openglContext()->displayObject()->nonExternalOnlySupportedDrmFormats());
+
+    m_sceneView = std::make_unique<FilteredSceneView>(kwinApp()->scene(), output, m_layer.get(), pidToHide);
+    m_sceneView->setViewport(output->geometryF());
+    m_sceneView->setScale(output->scale());
+    m_sceneView->setRefreshRate(output->refreshRate());
+    connect(output, &LogicalOutput::changed, m_sceneView.get(), [this]() {
+        m_sceneView->setViewport(m_output->geometryF());
+        m_sceneView->setScale(m_output->scale());
+        m_sceneView->setRefreshRate(m_output->refreshRate());
+    });
+
+    m_cursorView = std::make_unique<ItemTreeView>(m_sceneView.get(), kwinApp()->scene()->cursorItem(), output, nullptr, nullptr);
+    m_cursorView->setExclusive(!renderCursor);
+
+    connect(m_layer.get(), &OutputLayer::repaintScheduled, this, [this]() {
+        m_dirty = true;
+        Q_EMIT frame();
+    });
+}
+
+OutputScreenCastRenderer::~OutputScreenCastRenderer()
+{
+    s_renderers.removeOne(this);
+}
+
+std::shared_ptr<OutputScreenCastRenderer> OutputScreenCastRenderer::acquire(LogicalOutput *output, std::optional<pid_t> pidToHide, bool renderCursor)
+{
+    if (auto renderer = find(output, pidToHide, renderCursor)) {
+        return renderer;
+    }
+
+    std::shared_ptr<OutputScreenCastRenderer> renderer(new OutputScreenCastRenderer(output, pidToHide, renderCursor));
+    s_renderers.append(renderer.get());
+    return renderer;
+}
+
+std::shared_ptr<OutputScreenCastRenderer> OutputScreenCastRenderer::find(LogicalOutput *output, std::optional<pid_t> pidToHide, bool renderCursor)
+{
+    for (OutputScreenCastRenderer *renderer : std::as_const(s_renderers)) {
+        if (renderer->m_output == output && renderer->m_pidToHide == pidToHide && renderer->m_renderCursor == renderCursor) {
+            return renderer->shared_from_this();
+        }
+    }
+    return nullptr;
+}
+
+quint64 OutputScreenCastRenderer::update()
+{
+    if (!m_output) {
+        return m_sequence;
+    }
+
+    Region bufferRepair;
+    const QSize size = m_output->pixelSize();
+    if (!m_texture || m_texture->size() != size) {
+        m_texture = GLTexture::allocate(GL_RGBA8, size);
+        if (!m_texture) {
+            m_framebuffer.reset();
+            return 0;
+        }
+        // same orientation as dmabufs, so copying into them is a plain blit
+        m_texture->setContentTransform(OutputTransform::FlipY);
+        m_framebuffer = std::make_unique<GLFramebuffer>(m_texture.get());
+        m_damageJournal.clear();
+        bufferRepair = Region::infinite();
+        m_dirty = true;
+    }
+
+    if (!m_dirty) {
+        return m_sequence;
+    }
+    m_dirty = false;
+
+    const Rect bounds(QPoint(), size);
+    m_layer->setFramebuffer(m_framebuffer.get(), bufferRepair & bounds);
+    if (!m_layer->preparePresentationTest()) {
+        return m_sequence;
+    }
+    const auto beginInfo = m_layer->beginFrame();
+    if (!beginInfo) {
+        return m_sequence;
+    }
+    m_sceneView->prePaint();
+    const auto bufferDamage = (m_layer->deviceRepaints() | m_sceneView->collectDamage()) & bounds;
+    const auto repaints = beginInfo->repaint | bufferDamage;
+    m_layer->resetRepaints();
+    if (!copyScanoutCandidate(repaints)) {
+        m_sceneView->paint(beginInfo->renderTarget, QPoint(), repaints);
+    }
+    m_sceneView->postPaint();
+    if (!m_layer->endFrame(repaints, bufferDamage, nullptr)) {
+        return m_sequence;
+    }
+
+    m_damageJournal.add(repaints);
+    return ++m_sequence;
+}
+
+bool OutputScreenCastRenderer::copyScanoutCandidate(const Region &region)
+{
+    if (!EglContext::currentContext()->supportsBlits()) {
+        return false;
+    }
+    const auto candidates = m_sceneView->scanoutCandidates(1);
+    if (candidates.size() != 1) {
+        return false;
+    }
+
+    // the buffer must cover the whole output as is, anything else needs the scene to be rendered
+    SurfaceItem *candidate = candidates.front();
+    GraphicsBuffer *buffer = candidate->buffer();
+    if (!buffer || buffer->size() != m_texture->size()) {
+        return false;
+    }
+    const DmaBufAttributes *attributes = buffer->dmabufAttributes();
+    if (!attributes) {
+        return false;
+    }
+    if (candidate->bufferTransform() != OutputTransform::Normal || candidate->bufferSourceBox() != RectF(QPointF(), buffer->size()) || candidate->colorDescription() != ColorDescription::sRGB) {
+        return false;
+    }
+    const RectF deviceRect = candidate->mapToView(candidate->rect(), m_sceneView.get()).translated(-m_sceneView->viewport().topLeft()).scaled(m_sceneView->scale());
+    if (deviceRect.rounded() != Rect(QPoint(), m_texture->size())) {
+        return false;
+    }
+
+    const auto texture = EglContext::currentContext()->importDmaBufAsTexture(*attributes);
+    if (!texture || texture->target() != GL_TEXTURE_2D) {
+        return false;
+    }
+    GLFramebuffer source(texture.get());
+    if (!source.valid()) {
+        return false;
+    }
+
+    // both textures are laid out like dmabufs, so rects can be copied without flipping
+    GLFramebuffer::pushFramebuffer(m_framebuffer.get());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, source.handle());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer->handle());
+    for (const Rect &rect : (region & Rect(QPoint(), m_texture->size())).rects()) {
+        glBlitFramebuffer(rect.x(), rect.y(), rect.x() + rect.width(), rect.y() + rect.height(),
+                          rect.x(), rect.y(), rect.x() + rect.width(), rect.y() + rect.height(),
+                          GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+    GLFramebuffer::popFramebuffer();
+    return true;
+}
+
+Region OutputScreenCastRenderer::damageSince(quint64 sequence) const
+{
+    if (sequence == 0 || sequence > m_sequence) {
+        return Region::infinite();
+    }
+    return m_damageJournal.accumulate(m_sequence - sequence + 1, Region::infinite());
+}
+
+bool OutputScreenCastRenderer::copy(GLFramebuffer *target, const Region &region, const QPoint &sourceOffset)
+{
+    if (!m_framebuffer) {
+        return false;
+    }
+
+    const Region clipped = region & Rect(QPoint(), m_texture->size()).translated(-sourceOffset) & Rect(QPoint(), target->size());
+    if (clipped.isEmpty()) {
+        return true;
+    }
+
+    const OutputTransform targetTransform = target->colorAttachment() ? target->colorAttachment()->contentTransform() : OutputTransform();
+    if (!EglContext::currentContext()->supportsBlits() || (targetTransform != OutputTransform::Normal && targetTransform != OutputTransform::FlipY)) {
+        if (!sourceOffset.isNull()) {
+            return false;
+        }
+        RenderTarget renderTarget(target);
+        RenderViewport viewport(RectF(QPointF(), target->size()), 1, renderTarget, QPoint());
+
+        GLFramebuffer::pushFramebuffer(target);
+        ShaderBinder binder(ShaderTrait::MapTexture);
+        binder.shader()->setUniform(GLShader::Mat4Uniform::ModelViewProjectionMatrix, viewport.projectionMatrix());
+        m_texture->render(target->size());
+        GLFramebuffer::popFramebuffer();
+        return true;
+    }
+
+    // maps the top and the bottom of a row range to framebuffer coordinates, the texture
+    // of this renderer is flipped like a dmabuf
+    const auto rows = [](const Rect &rect, int height, bool flipped) {
+        return flipped ? std::make_pair(rect.y(), rect.y() + rect.height()) : std::make_pair(height - rect.y(), height - rect.y() - rect.height());
+    };
+
+    GLFramebuffer::pushFramebuffer(target);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer->handle());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target->handle());
+    for (const Rect &rect : clipped.rects()) {
+        const Rect sourceRect = rect.translated(sourceOffset);
+        const auto [sourceTop, sourceBottom] = rows(sourceRect, m_texture->size().height(), true);
+        const auto [targetTop, targetBottom] = rows(rect, target->size().height(), targetTransform == OutputTransform::FlipY);
+        glBlitFramebuffer(sourceRect.x(), sourceTop, sourceRect.x() + sourceRect.width(), sourceBottom,
+                          rect.x(), targetTop, rect.x() + rect.width(), targetBottom,
+                          GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+    GLFramebuffer::popFramebuffer();
+    return true;
+}
+
+} // namespace KWin
+
+#include "moc_outputscreencastrenderer.cpp"
@@ -0,0 +1,97 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "utils/damagejournal.h"
+
+#include <QObject>
+#include <QPointer>
+
+#include <memory>
+#include <optional>
+
+namespace KWin
+{
+
+class FilteredSceneView;
+class GLFramebuffer;
+class GLTexture;
+class ItemTreeView;
+class LogicalOutput;
+class ScreencastLayer;
+
+/**
+ * The OutputScreenCastRenderer class renders an output for screencasting.
+ *
+ * The renderer is shared by all screencasts of the same output with the same settings, so
+ * the scene is rendered only once per frame no matter how many clients are capturing the
+ * output. The frame is kept in a texture of its own and copied into the buffer of every
+ * stream, together with the damage that stream hasn't seen yet.
+ *
+ * If the output only shows a single client buffer, typically a fullscreen game that is
+ * being scanned out directly, the buffer is blitted into the frame instead of rendering
+ * the scene.
+ */
+class OutputScreenCastRenderer : public QObject, public std::enable_shared_from_this<OutputScreenCastRenderer>
+{
+    Q_OBJECT
+
+public:
+    ~OutputScreenCastRenderer() override;
+
+    /**
+     * Returns the renderer for casting @p output, creating it if no screencast with the
+     * same settings exists yet.
+     */
+    static std::shared_ptr<OutputScreenCastRenderer> acquire(LogicalOutput *output, std::optional<pid_t> pidToHide, bool renderCursor);
+
+    /**
+     * Returns the renderer for casting @p output if a screencast with the same settings
+     * exists already, or @c nullptr otherwise.
+     */
+    static std::shared_ptr<OutputScreenCastRenderer> find(LogicalOutput *output, std::optional<pid_t> pidToHide, bool renderCursor);
+
+    /**
+     * Renders the pending repaints, if there are any, and returns the sequence number of
+     * the current frame. The sequence number is @c 0 if no frame has been rendered yet.
+     */
+    quint64 update();
+
+    /**
+     * Returns the damage since the frame with the given @p sequence number, or an infinite
+     * region if that frame is too old.
+     */
+    Region damageSince(quint64 sequence) const;
+
+    /**
+     * Copies the @p region of the current frame, moved by @p sourceOffset, to @p target.
+     * Returns @c false if the frame can't be copied, which only happens with an offset.
+     */
+    bool copy(GLFramebuffer *target, const Region &region, const QPoint &sourceOffset = QPoint());
+
+Q_SIGNALS:
+    void frame();
+
+private:
+    explicit OutputScreenCastRenderer(LogicalOutput *output, std::optional<pid_t> pidToHide, bool renderCursor);
+
+    bool copyScanoutCandidate(const Region &region);
+
+    QPointer<LogicalOutput> m_output;
+    const std::optional<pid_t> m_pidToHide;
+    const bool m_renderCursor;
+    std::unique_ptr<ScreencastLayer> m_layer;
+    std::unique_ptr<FilteredSceneView> m_sceneView;
+    std::unique_ptr<ItemTreeView> m_cursorView;
+    std::shared_ptr<GLTexture> m_texture;
+    std::unique_ptr<GLFramebuffer> m_framebuffer;
+    DamageJournal m_damageJournal;
+    quint64 m_sequence = 0;
+    bool m_dirty = true;
+};
+
+} // namespace KWin
@@ -5,20 +5,15 @@
 */
 
 #include "outputscreencastsource.h"
-#include "filteredsceneview.h"
-#include "screencastlayer.h"
+#include "outputscreencastrenderer.h"
 #include "screencastutils.h"
 
-#include "compositor.h"
 #include "core/output.h"
 #include "core/renderbackend.h"
 #include "core/renderloop.h"
 #include "cursor.h"
-#include "opengl/eglbackend.h"
-#include "opengl/egldisplay.h"
 #include "opengl/glframebuffer.h"
 #include "opengl/gltexture.h"
-#include "scene/workspacescene.h"
 #include "workspace.h"
 
 #include <drm_fourcc.h>
@@ -60,9 +55,16 @@ qreal OutputScreenCastSource::devicePixelRatio() const
 
 void OutputScreenCastSource::setRenderCursor(bool enable)
 {
+    if (m_renderCursor == enable) {
+        return;
+    }
     m_renderCursor = enable;
-    if (m_cursorView) {
-        m_cursorView->setExclusive(!enable);
+    if (m_active) {
+        // the cursor is rendered into the shared frame, so another renderer is needed
+        disconnect(m_renderer.get(), &OutputScreenCastRenderer::frame, this, &OutputScreenCastSource::frame);
+        m_renderer = OutputScreenCastRenderer::acquire(m_output, m_pidToHide, m_renderCursor);
+        m_sequence = 0;
+        connect(m_renderer.get(), &OutputScreenCastRenderer::frame, this, &OutputScreenCastSource::frame);
     }
 }
 
@@ -80,24 +82,18 @@ Region OutputScreenCastSource::render(QImage *target, const Region &bufferRepair
 
 Region OutputScreenCastSource::render(GLFramebuffer *target, const Region &bufferRepair)
 {
-    m_layer->setFramebuffer(target, bufferRepair & Rect(QPoint(), target->size()));
-    if (!m_layer->preparePresentationTest()) {
-        return Region{};
-    }
-    const auto beginInfo = m_layer->beginFrame();
-    if (!beginInfo) {
+    if (!m_renderer) {
         return Region{};
     }
-    m_sceneView->prePaint();
-    const auto bufferDamage = (m_layer->deviceRepaints() | m_sceneView->collectDamage()) & Rect(QPoint(), target->size());
-    const auto repaints = beginInfo->repaint | bufferDamage;
-    m_layer->resetRepaints();
-    m_sceneView->paint(beginInfo->renderTarget, QPoint(), repaints);
-    m_sceneView->postPaint();
-    if (!m_layer->endFrame(repaints, bufferDamage, nullptr)) {
+    const quint64 sequence = m_renderer->update();
+    if (sequence == 0) {
         return Region{};
     }
-    return bufferDamage;
+    const Rect bounds(QPoint(), target->size());
+    const Region damage = m_renderer->damageSince(m_sequence) & bounds;
+    m_sequence = sequence;
+    m_renderer->copy(target, (damage | bufferRepair) & bounds);
+    return damage;
 }
 
 std::chrono::nanoseconds OutputScreenCastSource::clock() const
@@ -116,22 +112,9 @@ void OutputScreenCastSource::resume()
         return;
     }
 
-    m_layer = std::make_unique<ScreencastLayer>(m_output, static_cast<EglBackend *>(Compositor::self()->backend())->openglContext()->displayObject()->nonExternalOnlySupportedDrmFormats());
-
-    m_sceneView = std::make_unique<FilteredSceneView>(kwinApp()->scene(), m_output, m_layer.get(), m_pidToHide);
-    m_sceneView->setViewport(m_output->geometryF());
-    m_sceneView->setScale(m_output->scale());
-    m_sceneView->setRefreshRate(m_output->refreshRate());
-    connect(m_output, &LogicalOutput::changed, m_sceneView.get(), [this]() {
-        m_sceneView->setViewport(m_output->geometryF());
-        m_sceneView->setScale(m_output->scale());
-        m_sceneView->setRefreshRate(m_output->refreshRate());
-    });
-
-    m_cursorView = std::make_unique<ItemTreeView>(m_sceneView.get(), kwinApp()->scene()->cursorItem(), m_output, nullptr, nullptr);
-    m_cursorView->setExclusive(!m_renderCursor);
-
-    connect(m_layer.get(), &OutputLayer::repaintScheduled, this, &OutputScreenCastSource::frame);
+    m_renderer = OutputScreenCastRenderer::acquire(m_output, m_pidToHide, m_renderCursor);
+    m_sequence = 0;
+    connect(m_renderer.get(), &OutputScreenCastRenderer::frame, this, &OutputScreenCastSource::frame);
     Q_EMIT frame();
 
     m_active = true;
@@ -143,11 +126,8 @@ void OutputScreenCastSource::pause()
         return;
     }
 
-    disconnect(m_layer.get(), &OutputLayer::repaintScheduled, this, &OutputScreenCastSource::frame);
-
-    m_cursorView.reset();
-    m_sceneView.reset();
-    m_layer.reset();
+    disconnect(m_renderer.get(), &OutputScreenCastRenderer::frame, this, &OutputScreenCastSource::frame);
+    m_renderer.reset();
 
     m_active = false;
 }
@@ -13,10 +13,8 @@
 namespace KWin
 {
 
-class FilteredSceneView;
-class ItemTreeView;
 class LogicalOutput;
-class ScreencastLayer;
+class OutputScreenCastRenderer;
 
 class OutputScreenCastSource : public ScreenCastSource
 {
@@ -47,9 +45,9 @@ public:
 private:
     QPointer<LogicalOutput> m_output;
     std::optional<pid_t> m_pidToHide;
-    std::unique_ptr<ScreencastLayer> m_layer;
-    std::unique_ptr<FilteredSceneView> m_sceneView;
-    std::unique_ptr<ItemTreeView> m_cursorView;
+    std::shared_ptr<OutputScreenCastRenderer> m_renderer;
+    // the frame of the renderer that was last copied into a stream buffer
+    quint64 m_sequence = 0;
     bool m_active = false;
     bool m_renderCursor = false;
 };
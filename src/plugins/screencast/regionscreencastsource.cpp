@@ -6,6 +6,7 @@
 
 #include "regionscreencastsource.h"
 #include "filteredsceneview.h"
+#include "outputscreencastrenderer.h"
 #include "screencastlayer.h"
 #include "screencastutils.h"
 
@@ -69,10 +70,62 @@ void RegionScreenCastSource::setRenderCursor(bool enable)
     }
 }
 
+std::shared_ptr<OutputScreenCastRenderer> RegionScreenCastSource::findOutputRenderer(QPoint *sourceOffset) const
+{
+    const auto outputs = workspace()->outputs();
+    for (LogicalOutput *output : outputs) {
+        if (!output->geometry().contains(m_region)) {
+            continue;
+        }
+        // the frame can only be copied as is if its pixels line up with the ones of the stream
+        const QPointF offset = QPointF(m_region.topLeft() - output->geometry().topLeft()) * m_scale;
+        if (output->scale() != m_scale || offset != QPointF(offset.toPoint())) {
+            return nullptr;
+        }
+        *sourceOffset = offset.toPoint();
+        return OutputScreenCastRenderer::find(output, m_pidToHide, m_renderCursor);
+    }
+    return nullptr;
+}
+
+std::optional<Region> RegionScreenCastSource::copyFromOutputRenderer(GLFramebuffer *target, const Region &bufferRepair)
+{
+    QPoint sourceOffset;
+    const std::shared_ptr<OutputScreenCastRenderer> renderer = findOutputRenderer(&sourceOffset);
+    if (!renderer) {
+        return std::nullopt;
+    }
+    const quint64 sequence = renderer->update();
+    if (sequence == 0) {
+        return std::nullopt;
+    }
+
+    const Rect bounds(QPoint(), target->size());
+    const Region damage = (m_outputRenderer.lock() == renderer ? renderer->damageSince(m_outputSequence) : Region::infinite()).translated(-sourceOffset) & bounds;
+    if (!renderer->copy(target, (damage | bufferRepair) & bounds, sourceOffset)) {
+        return std::nullopt;
+    }
+    m_outputRenderer = renderer;
+    m_outputSequence = sequence;
+    return damage;
+}
+
 Region RegionScreenCastSource::render(GLFramebuffer *target, const Region &bufferRepair)
 {
     m_last = std::chrono::steady_clock::now().time_since_epoch();
-    m_layer->setFramebuffer(target, bufferRepair & Rect(QPoint(), target->size()));
+
+    // if the output is being cast already, its frame contains the region, no need to render it again
+    if (const auto damage = copyFromOutputRenderer(target, bufferRepair)) {
+        return *damage;
+    }
+    Region repair = bufferRepair;
+    if (!m_outputRenderer.expired()) {
+        // the scene view hasn't been painted while the frames were copied, so its damage is stale
+        m_outputRenderer.reset();
+        repair = Region::infinite();
+    }
+
+    m_layer->setFramebuffer(target, repair & Rect(QPoint(), target->size()));
     if (!m_layer->preparePresentationTest()) {
         return Region{};
     }
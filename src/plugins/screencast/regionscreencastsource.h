@@ -14,6 +14,7 @@ namespace KWin
 
 class FilteredSceneView;
 class ItemTreeView;
+class OutputScreenCastRenderer;
 class RegionScreenCastSource;
 class ScreencastLayer;
 
@@ -45,6 +46,9 @@ public:
     RectF mapFromGlobal(const RectF &rect) const override;
 
 private:
+    std::shared_ptr<OutputScreenCastRenderer> findOutputRenderer(QPoint *sourceOffset) const;
+    std::optional<Region> copyFromOutputRenderer(GLFramebuffer *target, const Region &bufferRepair);
+
     const Rect m_region;
     const qreal m_scale;
     const std::optional<pid_t> m_pidToHide;
@@ -56,6 +60,8 @@ private:
     std::unique_ptr<ScreencastLayer> m_layer;
     std::unique_ptr<FilteredSceneView> m_sceneView;
     std::unique_ptr<ItemTreeView> m_cursorView;
+    std::weak_ptr<OutputScreenCastRenderer> m_outputRenderer;
+    quint64 m_outputSequence = 0;
 };
 
 } // namespace KWin
@@ -10,6 +10,9 @@
 #include "core/shmgraphicsbufferallocator.h"
 #include "opengl/eglbackend.h"
 #include "opengl/glframebuffer.h"
+#include "opengl/gltexture.h"
+
+#include <cstring>
 
 namespace KWin
 {
@@ -116,6 +119,22 @@ MemFdScreenCastBuffer::MemFdScreenCastBuffer(GraphicsBuffer *buffer, GraphicsBuf
 {
 }
 
+MemFdScreenCastBuffer::~MemFdScreenCastBuffer()
+{
+    if (!m_context) {
+        return;
+    }
+    m_context->makeCurrent();
+    if (m_fence) {
+        glDeleteSync(m_fence);
+    }
+    if (m_pixelBuffer) {
+        glDeleteBuffers(1, &m_pixelBuffer);
+    }
+    m_framebuffer.reset();
+    m_texture.reset();
+}
+
 MemFdScreenCastBuffer *MemFdScreenCastBuffer::create(pw_buffer *pwBuffer, const GraphicsBufferOptions &options)
 {
     GraphicsBuffer *buffer = ShmGraphicsBufferAllocator().allocate(options);
@@ -146,4 +165,124 @@ MemFdScreenCastBuffer *MemFdScreenCastBuffer::create(pw_buffer *pwBuffer, const
     return new MemFdScreenCastBuffer(buffer, std::move(view));
 }
 
+GLFramebuffer *MemFdScreenCastBuffer::framebuffer(EglContext *context)
+{
+    if (m_framebuffer) {
+        return m_framebuffer.get();
+    }
+    if (m_context) {
+        // a previous attempt has failed
+        return nullptr;
+    }
+    m_context = context;
+
+    // mapping pixel pack buffers needs either desktop OpenGL or GLES 3
+    if (!context->haveSyncFences() || !context->hasMapBufferRange() || (context->isOpenGLES() && !context->hasVersion(Version(3, 0)))) {
+        return nullptr;
+    }
+    if (view.image()->format() != QImage::Format_ARGB32 && view.image()->format() != QImage::Format_ARGB32_Premultiplied && view.image()->format() != QImage::Format_RGB32) {
+        return nullptr;
+    }
+
+    auto texture = GLTexture::allocate(GL_RGBA8, view.image()->size());
+    if (!texture) {
+        return nullptr;
+    }
+    // same orientation as imported dmabufs, the first row in memory is the top of the image
+    texture->setContentTransform(OutputTransform::FlipY);
+
+    auto framebuffer = std::make_unique<GLFramebuffer>(texture.get());
+    if (!framebuffer->valid()) {
+        return nullptr;
+    }
+
+    const QSize size = view.image()->size();
+    glGenBuffers(1, &m_pixelBuffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, size.width() * size.height() * 4, nullptr, GL_STREAM_READ);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_texture = std::move(texture);
+    m_framebuffer = std::move(framebuffer);
+    return m_framebuffer.get();
+}
+
+void MemFdScreenCastBuffer::startDownload(const Region &region)
+{
+    const QSize size = m_texture->size();
+    const qsizetype stride = size.width() * 4;
+
+    m_downloadRegion = region & Rect(QPoint(), size);
+    // a few large reads are cheaper than many small ones
+    if (m_downloadRegion.rects().size() > 16) {
+        m_downloadRegion = m_downloadRegion.boundingRect();
+    }
+    if (m_downloadRegion.isEmpty()) {
+        return;
+    }
+
+    // every rect lands at the same offset as in a tightly packed image of the whole framebuffer
+    GLFramebuffer::pushFramebuffer(m_framebuffer.get());
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffer);
+    glPixelStorei(GL_PACK_ROW_LENGTH, size.width());
+    for (const Rect &rect : m_downloadRegion.rects()) {
+        const qsizetype offset = rect.y() * stride + rect.x() * 4;
+        m_context->glReadnPixels(rect.x(), rect.y(), rect.width(), rect.height(), GL_BGRA, GL_UNSIGNED_BYTE, stride * size.height() - offset, reinterpret_cast<GLvoid *>(offset));
+    }
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    GLFramebuffer::popFramebuffer();
+
+    if (m_fence) {
+        glDeleteSync(m_fence);
+    }
+    m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+}
+
+bool MemFdScreenCastBuffer::isDownloading() const
+{
+    return m_fence;
+}
+
+bool MemFdScreenCastBuffer::isDownloadFinished() const
+{
+    GLint value = GL_UNSIGNALED;
+    glGetSynciv(m_fence, GL_SYNC_STATUS, 1, nullptr, &value);
+    return value == GL_SIGNALED;
+}
+
+bool MemFdScreenCastBuffer::finishDownload()
+{
+    glDeleteSync(m_fence);
+    m_fence = nullptr;
+
+    const QSize size = m_texture->size();
+    const qsizetype stride = size.width() * 4;
+    const Rect bounds = m_downloadRegion.boundingRect();
+
+    // only map the rows that have been downloaded
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffer);
+    const auto pixels = static_cast<const uchar *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, bounds.y() * stride, bounds.height() * stride, GL_MAP_READ_BIT));
+    if (!pixels) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return false;
+    }
+
+    QImage *image = view.image();
+    for (const Rect &rect : m_downloadRegion.rects()) {
+        if (rect.width() == size.width() && image->bytesPerLine() == stride) {
+            std::memcpy(image->scanLine(rect.y()), pixels + (rect.y() - bounds.y()) * stride, rect.height() * stride);
+            continue;
+        }
+        for (int y = rect.y(); y < rect.y() + rect.height(); ++y) {
+            std::memcpy(image->scanLine(y) + rect.x() * 4, pixels + (y - bounds.y()) * stride + rect.x() * 4, rect.width() * 4);
+        }
+    }
+
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return true;
+}
+
 } // namespace KWin
@@ -7,13 +7,16 @@
 #pragma once
 
 #include "core/graphicsbufferview.h"
+#include "core/region.h"
 #include "core/syncobjtimeline.h"
 
+#include <epoxy/gl.h>
 #include <pipewire/pipewire.h>
 
 namespace KWin
 {
 
+class EglContext;
 class GLFramebuffer;
 class GLTexture;
 class GraphicsBuffer;
@@ -47,12 +50,43 @@ private:
 class MemFdScreenCastBuffer : public ScreenCastBuffer
 {
 public:
+    ~MemFdScreenCastBuffer() override;
+
     static MemFdScreenCastBuffer *create(pw_buffer *pwBuffer, const GraphicsBufferOptions &options);
 
+    /**
+     * Returns the framebuffer to render the contents of the buffer into before downloading
+     * them with startDownload(), or @c null if @p context can't download asynchronously.
+     * The framebuffer is laid out like a dmabuf, so the pixels need no vertical mirroring.
+     */
+    GLFramebuffer *framebuffer(EglContext *context);
+
+    /**
+     * Starts copying the @p region of the framebuffer into a pixel buffer on the GPU. The
+     * rest of the memfd keeps its previous contents. Nothing is copied if @p region is empty.
+     */
+    void startDownload(const Region &region);
+    bool isDownloading() const;
+    /**
+     * Returns whether the GPU has finished the copy started by startDownload().
+     */
+    bool isDownloadFinished() const;
+    /**
+     * Copies the downloaded pixels into the memfd. The copy must have finished.
+     */
+    bool finishDownload();
+
     GraphicsBufferView view;
 
 private:
     MemFdScreenCastBuffer(GraphicsBuffer *buffer, GraphicsBufferView &&view);
+
+    EglContext *m_context = nullptr;
+    std::shared_ptr<GLTexture> m_texture;
+    std::unique_ptr<GLFramebuffer> m_framebuffer;
+    GLuint m_pixelBuffer = 0;
+    GLsync m_fence = nullptr;
+    Region m_downloadRegion;
 };
 
 } // namespace KWin
@@ -316,6 +316,7 @@ void ScreenCastStream::onStreamRemoveBuffer(pw_buffer *pwBuffer)
     }
 
     m_dequeuedBuffers.removeOne(pwBuffer);
+    m_pendingDownloads.removeOne(pwBuffer);
 }
 
 ScreenCastStream::ScreenCastStream(ScreenCastSource *source, std::shared_ptr<PipeWireCore> pwCore, QObject *parent)
@@ -352,6 +353,16 @@ ScreenCastStream::ScreenCastStream(ScreenCastSource *source, std::shared_ptr<Pip
         record(m_pendingContents);
         m_pendingContents = Contents();
     });
+
+    m_downloadTimer.setSingleShot(true);
+    m_downloadTimer.setTimerType(Qt::PreciseTimer);
+    m_downloadTimer.setInterval(std::chrono::milliseconds(1));
+    connect(&m_downloadTimer, &QTimer::timeout, this, [this] {
+        if (EglBackend *backend = qobject_cast<EglBackend *>(Compositor::self()->backend())) {
+            backend->openglContext()->makeCurrent();
+            queueFinishedDownloads();
+        }
+    });
 }
 
 ScreenCastStream::~ScreenCastStream()
@@ -468,6 +479,8 @@ void ScreenCastStream::close()
 
     m_closed = true;
     m_pendingFrame.stop();
+    m_downloadTimer.stop();
+    m_pendingDownloads.clear();
 
     disconnect(m_cursor.changedConnection);
     m_cursor.changedConnection = {};
@@ -573,6 +586,11 @@ void ScreenCastStream::record(Contents contents)
         return;
     }
 
+    EglContext *context = backend->openglContext();
+    context->makeCurrent();
+
+    queueFinishedDownloads();
+
     struct pw_buffer *pwBuffer = dequeueBuffer();
     if (!pwBuffer) {
         return;
@@ -601,15 +619,20 @@ void ScreenCastStream::record(Contents contents)
         break;
     }
 
-    EglContext *context = backend->openglContext();
-    context->makeCurrent();
-
     spa_meta_sync_timeline *synctmeta = nullptr;
 
     Region damage;
     if (effectiveContents & Content::Video) {
         if (auto memfd = dynamic_cast<MemFdScreenCastBuffer *>(buffer)) {
-            damage = m_source->render(memfd->view.image(), m_damageJournal.accumulate(memfd->m_age, Region::infinite()));
+            if (GLFramebuffer *framebuffer = memfd->framebuffer(context)) {
+                // the contents are copied into the memfd once the gpu is done, see queueFinishedDownloads().
+                // Only what changed since the buffer was last recorded has to be copied
+                const Region repair = m_damageJournal.accumulate(memfd->m_age, Region::infinite());
+                damage = m_source->render(framebuffer, repair);
+                memfd->startDownload(repair | damage);
+            } else {
+                damage = m_source->render(memfd->view.image(), m_damageJournal.accumulate(memfd->m_age, Region::infinite()));
+            }
             bumpBufferAge(memfd);
         } else if (auto dmabuf = dynamic_cast<DmaBufScreenCastBuffer *>(buffer)) {
             if (dmabuf->synctimeline) {
@@ -658,12 +681,45 @@ void ScreenCastStream::record(Contents contents)
         spa_data->chunk->flags = SPA_CHUNK_FLAG_CORRUPTED;
     }
 
-    pw_stream_queue_buffer(m_pwStream, pwBuffer);
+    // keep the buffers in order, a buffer without video must not overtake a download
+    auto memfd = dynamic_cast<MemFdScreenCastBuffer *>(buffer);
+    if ((memfd && memfd->isDownloading()) || !m_pendingDownloads.isEmpty()) {
+        m_pendingDownloads.append(pwBuffer);
+        queueFinishedDownloads();
+    } else {
+        pw_stream_queue_buffer(m_pwStream, pwBuffer);
+    }
     m_lastSent = std::chrono::steady_clock::now();
 
     resize(m_source->textureSize());
 }
 
+void ScreenCastStream::queueFinishedDownloads()
+{
+    while (!m_pendingDownloads.isEmpty()) {
+        pw_buffer *pwBuffer = m_pendingDownloads.constFirst();
+        auto memfd = dynamic_cast<MemFdScreenCastBuffer *>(static_cast<ScreenCastBuffer *>(pwBuffer->user_data));
+        if (memfd && memfd->isDownloading()) {
+            if (!memfd->isDownloadFinished()) {
+                break;
+            }
+            if (!memfd->finishDownload()) {
+                qCWarning(KWIN_SCREENCAST) << objectName() << "Failed to download the frame contents";
+                pwBuffer->buffer->datas[0].chunk->flags = SPA_CHUNK_FLAG_CORRUPTED;
+            }
+        }
+        m_pendingDownloads.removeFirst();
+        pw_stream_queue_buffer(m_pwStream, pwBuffer);
+    }
+
+    // the gpu usually finishes well within a frame, poll until it does
+    if (!m_pendingDownloads.isEmpty()) {
+        m_downloadTimer.start();
+    } else {
+        m_downloadTimer.stop();
+    }
+}
+
 void ScreenCastStream::bumpBufferAge(ScreenCastBuffer *renderedBuffer)
 {
     for (ScreenCastBuffer *buffer : std::as_const(m_allBuffers)) {
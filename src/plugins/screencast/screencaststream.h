@@ -99,6 +99,7 @@ private:
                          const QList<uint64_t> &modifiers, quint32 modifiersFlags);
     pw_buffer *dequeueBuffer();
     void record(Contents contents);
+    void queueFinishedDownloads();
     void bumpBufferAge(ScreenCastBuffer *renderedBuffer);
 
     std::optional<ScreenCastDmaBufTextureParams> testCreateDmaBuf(const QSize &size, quint32 format, const QList<uint64_t> &modifiers);
@@ -137,6 +138,9 @@ private:
     QTimer m_pendingFrame;
     Contents m_pendingContents = Content::None;
     QList<pw_buffer *> m_dequeuedBuffers;
+    // recorded buffers waiting for their memfd contents to be downloaded, in recording order
+    QList<pw_buffer *> m_pendingDownloads;
+    QTimer m_downloadTimer;
 
     QList<ScreenCastBuffer *> m_allBuffers;
     DamageJournal m_damageJournal;
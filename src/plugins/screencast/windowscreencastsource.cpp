@@ -7,6 +7,7 @@
 
 #include "windowscreencastsource.h"
 #include "screencastutils.h"
+#include "windowscreencastview.h"
 
 #include "compositor.h"
 #include "core/backendoutput.h"
@@ -77,12 +78,18 @@ void WindowScreenCastSource::watch(Window *window)
 {
     window->refOffscreenRendering();
     connect(window, &Window::damaged, this, &WindowScreenCastSource::frame);
+    if (m_view) {
+        m_view->addWindow(window);
+    }
 }
 
 void WindowScreenCastSource::unwatch(Window *window)
 {
     window->unrefOffscreenRendering();
     disconnect(window, &Window::damaged, this, &WindowScreenCastSource::frame);
+    if (m_view) {
+        m_view->removeWindow(window);
+    }
 }
 
 quint32 WindowScreenCastSource::drmFormat() const
@@ -105,7 +112,7 @@ void WindowScreenCastSource::setRenderCursor(bool enable)
     m_renderCursor = enable;
 }
 
-Region WindowScreenCastSource::render(QImage *target, const Region &bufferDamage)
+Region WindowScreenCastSource::render(QImage *target, const Region &bufferRepair)
 {
     const auto offscreenTexture = GLTexture::allocate(GL_RGBA8, target->size());
     if (!offscreenTexture) {
@@ -113,30 +120,48 @@ Region WindowScreenCastSource::render(QImage *target, const Region &bufferDamage
     }
     offscreenTexture->setContentTransform(OutputTransform::FlipY);
 
+    // the texture is new, so everything has to be rendered
     GLFramebuffer offscreenTarget(offscreenTexture.get());
     render(&offscreenTarget, Region::infinite());
     grabTexture(offscreenTexture.get(), target);
     return Rect(QPoint(), target->size());
 }
 
-Region WindowScreenCastSource::render(GLFramebuffer *target, const Region &bufferDamage)
+Region WindowScreenCastSource::render(GLFramebuffer *target, const Region &bufferRepair)
 {
+    const Rect bufferRect(QPoint(), target->size());
+
+    // only the parts of the windows that changed since the buffer was used last have to be
+    // rendered. The embedded cursor isn't part of the windows, so it repaints everything
+    Region damage = Region::infinite();
+    if (m_view) {
+        m_view->setViewport(boundingRect(), devicePixelRatio());
+        damage = m_view->collectDamage();
+    }
+    if (m_renderCursor || std::exchange(m_cursorRendered, m_renderCursor)) {
+        damage = Region::infinite();
+    }
+    damage &= bufferRect;
+    const Region repaint = (damage | bufferRepair) & bufferRect;
+    if (repaint.isEmpty()) {
+        return Region{};
+    }
+
     RenderTarget renderTarget(target);
     RenderViewport viewport(boundingRect(), devicePixelRatio(), renderTarget, QPoint());
 
     WorkspaceScene *scene = kwinApp()->scene();
 
     scene->renderer()->beginFrame(renderTarget, viewport);
-    glClearColor(0.0, 0.0, 0.0, 0.0);
-    glClear(GL_COLOR_BUFFER_BIT);
+    scene->renderer()->renderBackground(renderTarget, viewport, repaint);
     for (const auto &window : m_windows) {
-        scene->renderer()->renderItem(renderTarget, viewport, window->windowItem(), Scene::PAINT_WINDOW_TRANSFORMED, Region::infinite(), WindowPaintData{}, {}, {});
+        scene->renderer()->renderItem(renderTarget, viewport, window->windowItem(), Scene::PAINT_WINDOW_TRANSFORMED, repaint, WindowPaintData{}, {}, {});
     }
     if (m_renderCursor && scene->cursorItem()->isVisible()) {
-        scene->renderer()->renderItem(renderTarget, viewport, scene->cursorItem(), 0, Region::infinite(), WindowPaintData{}, {}, {});
+        scene->renderer()->renderItem(renderTarget, viewport, scene->cursorItem(), 0, repaint, WindowPaintData{}, {}, {});
     }
     scene->renderer()->endFrame();
-    return Rect(QPoint(), target->size());
+    return damage;
 }
 
 std::chrono::nanoseconds WindowScreenCastSource::clock() const
@@ -158,6 +183,7 @@ void WindowScreenCastSource::pause()
     for (const auto &window : std::as_const(m_windows)) {
         unwatch(window);
     }
+    m_view.reset();
     m_active = false;
 }
 
@@ -167,6 +193,7 @@ void WindowScreenCastSource::resume()
         return;
     }
 
+    m_view = std::make_unique<WindowScreenCastView>(kwinApp()->scene());
     for (const auto &window : std::as_const(m_windows)) {
         watch(window);
     }
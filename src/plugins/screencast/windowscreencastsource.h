@@ -15,6 +15,8 @@
 namespace KWin
 {
 
+class WindowScreenCastView;
+
 class WindowScreenCastSource : public ScreenCastSource
 {
     Q_OBJECT
@@ -29,8 +31,8 @@ public:
     uint refreshRate() const override;
 
     void setRenderCursor(bool enable) override;
-    Region render(GLFramebuffer *target, const Region &bufferDamage) override;
-    Region render(QImage *target, const Region &bufferDamage) override;
+    Region render(GLFramebuffer *target, const Region &bufferRepair) override;
+    Region render(QImage *target, const Region &bufferRepair) override;
     std::chrono::nanoseconds clock() const override;
 
     void resume() override;
@@ -48,8 +50,10 @@ private:
     RectF boundingRect() const;
 
     QList<Window *> m_windows;
+    std::unique_ptr<WindowScreenCastView> m_view;
     bool m_active = false;
     bool m_renderCursor = false;
+    bool m_cursorRendered = false;
 };
 
 } // namespace KWin
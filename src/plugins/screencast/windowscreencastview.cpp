@@ -0,0 +1,125 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "windowscreencastview.h"
+#include "scene/windowitem.h"
+#include "window.h"
+
+namespace KWin
+{
+
+WindowScreenCastView::WindowScreenCastView(Scene *scene)
+    : RenderView(nullptr, nullptr, nullptr)
+    , m_scene(scene)
+{
+    m_scene->addView(this);
+}
+
+WindowScreenCastView::~WindowScreenCastView()
+{
+    m_scene->removeView(this);
+}
+
+void WindowScreenCastView::addWindow(Window *window)
+{
+    m_windows.append(window);
+    m_fullRepaint = true;
+}
+
+void WindowScreenCastView::removeWindow(Window *window)
+{
+    m_windows.removeOne(window);
+    m_fullRepaint = true;
+}
+
+void WindowScreenCastView::setViewport(const RectF &viewport, qreal scale)
+{
+    // the repaints are in the coordinates of the old viewport, they can't be used anymore
+    if (m_viewport != viewport || m_scale != scale) {
+        m_viewport = viewport;
+        m_scale = scale;
+        m_fullRepaint = true;
+    }
+}
+
+RectF WindowScreenCastView::viewport() const
+{
+    return m_viewport;
+}
+
+qreal WindowScreenCastView::scale() const
+{
+    return m_scale;
+}
+
+QList<SurfaceItem *> WindowScreenCastView::scanoutCandidates(ssize_t maxCount) const
+{
+    return {};
+}
+
+void WindowScreenCastView::prePaint()
+{
+}
+
+static void accumulateRepaints(Item *item, RenderView *view, Region *repaints)
+{
+    *repaints += item->takeDeviceRepaints(view);
+
+    const auto childItems = item->childItems();
+    for (Item *childItem : childItems) {
+        accumulateRepaints(childItem, view, repaints);
+    }
+}
+
+Region WindowScreenCastView::collectDamage()
+{
+    Region damage;
+    for (Window *window : std::as_const(m_windows)) {
+        if (WindowItem *item = window->windowItem()) {
+            accumulateRepaints(item, this, &damage);
+        }
+    }
+    if (std::exchange(m_fullRepaint, false)) {
+        return Region::infinite();
+    }
+    return damage;
+}
+
+void WindowScreenCastView::paint(const RenderTarget &renderTarget, const QPoint &deviceOffset, const Region &logicalRegion)
+{
+    // the screencast source renders the windows itself
+}
+
+void WindowScreenCastView::postPaint()
+{
+}
+
+bool WindowScreenCastView::shouldRenderItem(Item *item) const
+{
+    return std::ranges::any_of(m_windows, [item](Window *window) {
+        WindowItem *windowItem = window->windowItem();
+        return windowItem && (windowItem == item || windowItem->isAncestorOf(item));
+    });
+}
+
+double WindowScreenCastView::desiredHdrHeadroom() const
+{
+    return 1.0;
+}
+
+std::chrono::nanoseconds WindowScreenCastView::nextPresentationTimestamp() const
+{
+    return std::chrono::steady_clock::now().time_since_epoch();
+}
+
+uint WindowScreenCastView::refreshRate() const
+{
+    return m_windows.isEmpty() ? 60000 : m_windows.constFirst()->output()->refreshRate();
+}
+
+} // namespace KWin
+
+#include "moc_windowscreencastview.cpp"
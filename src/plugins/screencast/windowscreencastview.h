@@ -0,0 +1,51 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "scene/scene.h"
+
+namespace KWin
+{
+
+/**
+ * The WindowScreenCastView class tracks the damage of the windows in a window screencast. It
+ * isn't painted by the compositor, it only collects the repaints of the window item trees in
+ * the coordinates of the stream buffer.
+ */
+class WindowScreenCastView : public RenderView
+{
+    Q_OBJECT
+
+public:
+    explicit WindowScreenCastView(Scene *scene);
+    ~WindowScreenCastView() override;
+
+    void addWindow(Window *window);
+    void removeWindow(Window *window);
+    void setViewport(const RectF &viewport, qreal scale);
+
+    RectF viewport() const override;
+    qreal scale() const override;
+    QList<SurfaceItem *> scanoutCandidates(ssize_t maxCount) const override;
+    void prePaint() override;
+    Region collectDamage() override;
+    void paint(const RenderTarget &renderTarget, const QPoint &deviceOffset, const Region &logicalRegion) override;
+    void postPaint() override;
+    bool shouldRenderItem(Item *item) const override;
+    double desiredHdrHeadroom() const override;
+    std::chrono::nanoseconds nextPresentationTimestamp() const override;
+    uint refreshRate() const override;
+
+private:
+    Scene *const m_scene;
+    QList<Window *> m_windows;
+    RectF m_viewport;
+    qreal m_scale = 1.0;
+    bool m_fullRepaint = true;
+};
+
+} // namespace KWin
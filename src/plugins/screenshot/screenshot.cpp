@@ -18,6 +18,7 @@
 #include "core/renderviewport.h"
 #include "effect/effect.h"
 #include "opengl/eglbackend.h"
+#include "opengl/eglcontext.h"
 #include "opengl/glplatform.h"
 #include "opengl/glutils.h"
 #include "scene/decorationitem.h"
@@ -33,65 +34,169 @@
 
 #include <QPainter>
 
+#include <cstring>
+
 namespace KWin
 {
 
-static void convertFromGLImage(QImage &img, int w, int h, const OutputTransform &renderTargetTransformation)
+class ScreenShotDownload
 {
-    // from QtOpenGL/qgl.cpp
-    // SPDX-FileCopyrightText: 2010 Nokia Corporation and /or its subsidiary(-ies)
-    // see https://github.com/qt/qtbase/blob/dev/src/opengl/qgl.cpp
-    if (QSysInfo::ByteOrder == QSysInfo::BigEndian) {
-        // OpenGL gives RGBA; Qt wants ARGB
-        uint *p = reinterpret_cast<uint *>(img.bits());
-        uint *end = p + w * h;
-        while (p < end) {
-            uint a = *p << 24;
-            *p = (*p >> 8) | a;
-            p++;
-        }
-    } else {
-        // OpenGL gives ABGR (i.e. RGBA backwards); Qt wants ARGB
-        for (int y = 0; y < h; y++) {
-            uint *q = reinterpret_cast<uint *>(img.scanLine(y));
-            for (int x = 0; x < w; ++x) {
-                const uint pixel = *q;
-                *q = ((pixel << 16) & 0xff0000) | ((pixel >> 16) & 0xff)
-                    | (pixel & 0xff00ff00);
-
-                q++;
-            }
-        }
+public:
+    ScreenShotDownload(EglContext *context, GLFramebuffer *framebuffer, qreal scale, const ScreenShotCallback &callback);
+    ~ScreenShotDownload();
+
+    bool isFinished() const;
+    std::optional<QImage> finish();
+
+    ScreenShotCallback callback;
+
+private:
+    EglContext *m_context;
+    QSize m_size;
+    qreal m_scale;
+    GLuint m_pixelBuffer = 0;
+    GLsync m_fence = nullptr;
+};
+
+ScreenShotDownload::ScreenShotDownload(EglContext *context, GLFramebuffer *framebuffer, qreal scale, const ScreenShotCallback &callback)
+    : callback(callback)
+    , m_context(context)
+    , m_size(framebuffer->size())
+    , m_scale(scale)
+{
+    const qsizetype size = qsizetype(m_size.width()) * m_size.height() * 4;
+
+    glGenBuffers(1, &m_pixelBuffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    GLFramebuffer::pushFramebuffer(framebuffer);
+    context->glReadnPixels(0, 0, m_size.width(), m_size.height(), GL_RGBA, GL_UNSIGNED_BYTE, size, nullptr);
+    GLFramebuffer::popFramebuffer();
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+}
+
+ScreenShotDownload::~ScreenShotDownload()
+{
+    m_context->makeCurrent();
+    if (m_fence) {
+        glDeleteSync(m_fence);
+    }
+    glDeleteBuffers(1, &m_pixelBuffer);
+}
+
+bool ScreenShotDownload::isFinished() const
+{
+    GLint value = GL_UNSIGNALED;
+    glGetSynciv(m_fence, GL_SYNC_STATUS, 1, nullptr, &value);
+    return value == GL_SIGNALED;
+}
+
+std::optional<QImage> ScreenShotDownload::finish()
+{
+    const qsizetype stride = qsizetype(m_size.width()) * 4;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffer);
+    const auto pixels = static_cast<const uchar *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, stride * m_size.height(), GL_MAP_READ_BIT));
+    if (!pixels) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return std::nullopt;
     }
 
-    QMatrix4x4 matrix;
-    // apply render target transformation
-    matrix *= renderTargetTransformation.inverted().toMatrix();
-    // OpenGL textures are flipped vs QImage
-    matrix.scale(1, -1);
-    img = img.transformed(matrix.toTransform());
+    // OpenGL textures are flipped vs QImage, mirror the rows while copying them
+    QImage snapshot(m_size, QImage::Format_RGBA8888_Premultiplied);
+    for (int y = 0; y < m_size.height(); ++y) {
+        std::memcpy(snapshot.scanLine(m_size.height() - y - 1), pixels + y * stride, stride);
+    }
+
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    snapshot.setDevicePixelRatio(m_scale);
+    return snapshot;
 }
 
 ScreenShotManager::ScreenShotManager()
     : m_dbusInterface2(new ScreenShotDBusInterface2(this))
 {
+    m_downloadTimer.setSingleShot(true);
+    m_downloadTimer.setTimerType(Qt::PreciseTimer);
+    m_downloadTimer.setInterval(std::chrono::milliseconds(1));
+    connect(&m_downloadTimer, &QTimer::timeout, this, &ScreenShotManager::finishDownloads);
+    // the pixel buffers must be released while the context still exists
+    connect(Compositor::self(), &Compositor::aboutToToggleCompositing, this, &ScreenShotManager::cancelDownloads);
 }
 
 ScreenShotManager::~ScreenShotManager()
 {
+    cancelDownloads();
+}
+
+void ScreenShotManager::download(EglContext *context, GLFramebuffer *framebuffer, qreal scale, const ScreenShotCallback &callback)
+{
+    // mapping pixel pack buffers needs either desktop OpenGL or GLES 3
+    if (!context->haveSyncFences() || !context->hasMapBufferRange() || (context->isOpenGLES() && !context->hasVersion(Version(3, 0)))) {
+        const QSize size = framebuffer->size();
+        QImage snapshot(size, QImage::Format_RGBA8888_Premultiplied);
+        GLFramebuffer::pushFramebuffer(framebuffer);
+        context->glReadnPixels(0, 0, size.width(), size.height(), GL_RGBA, GL_UNSIGNED_BYTE, snapshot.sizeInBytes(), static_cast<GLvoid *>(snapshot.bits()));
+        GLFramebuffer::popFramebuffer();
+        // OpenGL textures are flipped vs QImage
+        snapshot.flip(Qt::Vertical);
+        snapshot.setDevicePixelRatio(scale);
+        callback(snapshot);
+        return;
+    }
+
+    m_pendingDownloads.push_back(std::make_unique<ScreenShotDownload>(context, framebuffer, scale, callback));
+    m_downloadTimer.start();
+}
+
+void ScreenShotManager::finishDownloads()
+{
+    const auto eglBackend = dynamic_cast<EglBackend *>(Compositor::self()->backend());
+    if (!eglBackend || !eglBackend->openglContext() || !eglBackend->openglContext()->makeCurrent()) {
+        cancelDownloads();
+        return;
+    }
+
+    // the fences are signaled in the order the downloads have been started
+    while (!m_pendingDownloads.empty() && m_pendingDownloads.front()->isFinished()) {
+        const std::unique_ptr<ScreenShotDownload> download = std::move(m_pendingDownloads.front());
+        m_pendingDownloads.pop_front();
+        download->callback(download->finish());
+    }
+
+    if (!m_pendingDownloads.empty()) {
+        m_downloadTimer.start();
+    }
+}
+
+void ScreenShotManager::cancelDownloads()
+{
+    m_downloadTimer.stop();
+    while (!m_pendingDownloads.empty()) {
+        const std::unique_ptr<ScreenShotDownload> download = std::move(m_pendingDownloads.front());
+        m_pendingDownloads.pop_front();
+        download->callback(std::nullopt);
+    }
 }
 
 // TODO share code with the screencast plugin?
 
-std::optional<QImage> ScreenShotManager::takeScreenShot(LogicalOutput *screen, ScreenShotFlags flags, std::optional<pid_t> pidToHide)
+void ScreenShotManager::takeScreenShot(LogicalOutput *screen, ScreenShotFlags flags, std::optional<pid_t> pidToHide, const ScreenShotCallback &callback)
 {
     const auto eglBackend = dynamic_cast<EglBackend *>(Compositor::self()->backend());
     if (!eglBackend) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
     const auto context = eglBackend->openglContext();
     if (!context || !context->makeCurrent()) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
 
     qreal scale = 1.0;
@@ -102,22 +207,26 @@ std::optional<QImage> ScreenShotManager::takeScreenShot(LogicalOutput *screen, S
 
     const auto offscreenTexture = GLTexture::allocate(GL_RGBA8, nativeSize);
     if (!offscreenTexture) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
     offscreenTexture->setFilter(GL_LINEAR);
     offscreenTexture->setWrapMode(GL_CLAMP_TO_EDGE);
     const auto target = std::make_unique<GLFramebuffer>(offscreenTexture.get());
     if (!target->valid()) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
 
     ScreenshotLayer layer(screen, target.get());
     if (!layer.preparePresentationTest()) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
     const auto beginInfo = layer.beginFrame();
     if (!beginInfo) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
     SceneView sceneView(kwinApp()->scene(), screen, nullptr, &layer);
     std::unique_ptr<ItemTreeView> cursorView;
@@ -137,28 +246,24 @@ std::optional<QImage> ScreenShotManager::takeScreenShot(LogicalOutput *screen, S
     sceneView.paint(beginInfo->renderTarget, QPoint(), fullDamage);
     sceneView.postPaint();
     if (!layer.endFrame(fullDamage, fullDamage, nullptr)) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
 
-    GLFramebuffer::pushFramebuffer(target.get());
-    QImage snapshot = QImage(offscreenTexture->size(), QImage::Format_ARGB32_Premultiplied);
-    context->glReadnPixels(0, 0, snapshot.width(), snapshot.height(), GL_RGBA, GL_UNSIGNED_BYTE, snapshot.sizeInBytes(), static_cast<GLvoid *>(snapshot.bits()));
-    convertFromGLImage(snapshot, snapshot.width(), snapshot.height(), OutputTransform::Normal);
-    GLFramebuffer::popFramebuffer();
-
-    snapshot.setDevicePixelRatio(scale);
-    return snapshot;
+    download(context, target.get(), scale, callback);
 }
 
-std::optional<QImage> ScreenShotManager::takeScreenShot(const Rect &area, ScreenShotFlags flags, std::optional<pid_t> pidToHide)
+void ScreenShotManager::takeScreenShot(const Rect &area, ScreenShotFlags flags, std::optional<pid_t> pidToHide, const ScreenShotCallback &callback)
 {
     const auto eglBackend = dynamic_cast<EglBackend *>(Compositor::self()->backend());
     if (!eglBackend) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
     const auto context = eglBackend->openglContext();
     if (!context || !context->makeCurrent()) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
 
     qreal scale = 1.0;
@@ -172,22 +277,26 @@ std::optional<QImage> ScreenShotManager::takeScreenShot(const Rect &area, Screen
 
     const auto offscreenTexture = GLTexture::allocate(GL_RGBA8, nativeSize);
     if (!offscreenTexture) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
     offscreenTexture->setFilter(GL_LINEAR);
     offscreenTexture->setWrapMode(GL_CLAMP_TO_EDGE);
     const auto target = std::make_unique<GLFramebuffer>(offscreenTexture.get());
     if (!target->valid()) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
 
     ScreenshotLayer layer(workspace()->outputs().front(), target.get());
     if (!layer.preparePresentationTest()) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
     const auto beginInfo = layer.beginFrame();
     if (!beginInfo) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
     SceneView sceneView(kwinApp()->scene(), workspace()->outputs().front(), nullptr, &layer);
     std::unique_ptr<ItemTreeView> cursorView;
@@ -207,28 +316,24 @@ std::optional<QImage> ScreenShotManager::takeScreenShot(const Rect &area, Screen
     sceneView.paint(beginInfo->renderTarget, QPoint(), fullDamage);
     sceneView.postPaint();
     if (!layer.endFrame(fullDamage, fullDamage, nullptr)) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
 
-    GLFramebuffer::pushFramebuffer(target.get());
-    QImage snapshot = QImage(offscreenTexture->size(), QImage::Format_ARGB32_Premultiplied);
-    context->glReadnPixels(0, 0, snapshot.width(), snapshot.height(), GL_RGBA, GL_UNSIGNED_BYTE, snapshot.sizeInBytes(), static_cast<GLvoid *>(snapshot.bits()));
-    convertFromGLImage(snapshot, snapshot.width(), snapshot.height(), OutputTransform::Normal);
-    GLFramebuffer::popFramebuffer();
-
-    snapshot.setDevicePixelRatio(scale);
-    return snapshot;
+    download(context, target.get(), scale, callback);
 }
 
-std::optional<QImage> ScreenShotManager::takeScreenShot(Window *window, ScreenShotFlags flags)
+void ScreenShotManager::takeScreenShot(Window *window, ScreenShotFlags flags, const ScreenShotCallback &callback)
 {
     const auto eglBackend = dynamic_cast<EglBackend *>(Compositor::self()->backend());
     if (!eglBackend) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
     const auto context = eglBackend->openglContext();
     if (!context || !context->makeCurrent()) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
 
     const qreal scale = window->targetScale();
@@ -241,7 +346,8 @@ std::optional<QImage> ScreenShotManager::takeScreenShot(Window *window, ScreenSh
     const QSize nativeSize = (geometry.size() * scale).toSize();
     const auto offscreenTexture = GLTexture::allocate(GL_RGBA8, nativeSize);
     if (!offscreenTexture) {
-        return std::nullopt;
+        callback(std::nullopt);
+        return;
     }
 
     GLFramebuffer offscreenTarget(offscreenTexture.get());
@@ -265,14 +371,7 @@ std::optional<QImage> ScreenShotManager::takeScreenShot(Window *window, ScreenSh
     }
     scene->renderer()->endFrame();
 
-    GLFramebuffer::pushFramebuffer(&offscreenTarget);
-    QImage snapshot = QImage(offscreenTexture->size(), QImage::Format_ARGB32_Premultiplied);
-    context->glReadnPixels(0, 0, snapshot.width(), snapshot.height(), GL_RGBA, GL_UNSIGNED_BYTE, snapshot.sizeInBytes(), static_cast<GLvoid *>(snapshot.bits()));
-    convertFromGLImage(snapshot, snapshot.width(), snapshot.height(), OutputTransform::Normal);
-    GLFramebuffer::popFramebuffer();
-
-    snapshot.setDevicePixelRatio(scale);
-    return snapshot;
+    download(context, &offscreenTarget, scale, callback);
 }
 
 } // namespace KWin
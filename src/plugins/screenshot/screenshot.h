@@ -12,6 +12,11 @@
 
 #include "plugin.h"
 
+#include <QTimer>
+
+#include <deque>
+#include <functional>
+
 namespace KWin
 {
 
@@ -27,13 +32,28 @@ enum ScreenShotFlag {
 Q_DECLARE_FLAGS(ScreenShotFlags, ScreenShotFlag)
 
 class LogicalOutput;
+class EglContext;
+class GLFramebuffer;
 class Rect;
 class ScreenShotDBusInterface2;
+class ScreenShotDownload;
 class Window;
 
+/**
+ * The callback that receives the screenshot, or @c std::nullopt if no screenshot could be taken.
+ *
+ * The pixels of the image are in QImage::Format_RGBA8888_Premultiplied, it's up to the receiver
+ * to convert them to a different format, preferably off the main thread.
+ */
+using ScreenShotCallback = std::function<void(std::optional<QImage> image)>;
+
 /**
  * The ScreenShotManager provides a convenient way to capture the contents of a given window,
  * screen or an area in the global coordinates.
+ *
+ * If the OpenGL context supports fences and mapping pixel pack buffers, the pixels are downloaded
+ * asynchronously and the callback is invoked once the GPU has finished copying them, so that
+ * large screenshots don't stall compositing. Otherwise, the callback is invoked immediately.
  */
 class ScreenShotManager : public Plugin
 {
@@ -41,12 +61,18 @@ public:
     ScreenShotManager();
     ~ScreenShotManager() override;
 
-    std::optional<QImage> takeScreenShot(LogicalOutput *screen, ScreenShotFlags flags, std::optional<pid_t> pidToHide);
-    std::optional<QImage> takeScreenShot(const Rect &area, ScreenShotFlags flags, std::optional<pid_t> pidToHide);
-    std::optional<QImage> takeScreenShot(Window *window, ScreenShotFlags flags = {});
+    void takeScreenShot(LogicalOutput *screen, ScreenShotFlags flags, std::optional<pid_t> pidToHide, const ScreenShotCallback &callback);
+    void takeScreenShot(const Rect &area, ScreenShotFlags flags, std::optional<pid_t> pidToHide, const ScreenShotCallback &callback);
+    void takeScreenShot(Window *window, ScreenShotFlags flags, const ScreenShotCallback &callback);
 
 private:
+    void download(EglContext *context, GLFramebuffer *framebuffer, qreal scale, const ScreenShotCallback &callback);
+    void finishDownloads();
+    void cancelDownloads();
+
     std::unique_ptr<ScreenShotDBusInterface2> m_dbusInterface2;
+    std::deque<std::unique_ptr<ScreenShotDownload>> m_pendingDownloads;
+    QTimer m_downloadTimer;
 };
 
 } // namespace KWin
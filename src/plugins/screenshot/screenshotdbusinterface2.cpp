@@ -31,6 +31,9 @@
 namespace KWin
 {
 
+// the format that clients get the pixels in
+static const QImage::Format s_imageFormat = QImage::Format_ARGB32_Premultiplied;
+
 class ScreenShotWriter2 : public QRunnable
 {
 public:
@@ -42,6 +45,11 @@ public:
 
     void run() override
     {
+        // converting large images takes a while, so it's done here rather than on the main thread
+        if (m_image.format() != s_imageFormat) {
+            m_image.convertTo(s_imageFormat);
+        }
+
         const int flags = fcntl(m_fileDescriptor.get(), F_GETFL, 0);
         if (flags == -1) {
             qCWarning(KWIN_SCREENSHOT) << "failed to get screenshot fd flags:" << strerror(errno);
@@ -196,7 +204,8 @@ void ScreenShotSinkPipe2::flush(const QImage &image, const QVariantMap &attribut
     // Note that the type of the data stored in the vardict matters. Be careful.
     QVariantMap results = attributes;
     results.insert(QStringLiteral("type"), QStringLiteral("raw"));
-    results.insert(QStringLiteral("format"), quint32(image.format()));
+    // the writer converts the image to a format with the same depth, so the stride stays the same
+    results.insert(QStringLiteral("format"), quint32(s_imageFormat));
     results.insert(QStringLiteral("width"), quint32(image.width()));
     results.insert(QStringLiteral("height"), quint32(image.height()));
     results.insert(QStringLiteral("stride"), quint32(image.bytesPerLine()));
@@ -472,38 +481,44 @@ QVariantMap ScreenShotDBusInterface2::CaptureWorkspace(const QVariantMap &option
 void ScreenShotDBusInterface2::takeScreenShot(LogicalOutput *screen, ScreenShotFlags flags,
                                               ScreenShotSinkPipe2 *sink, std::optional<pid_t> pid)
 {
-    if (const auto result = m_effect->takeScreenShot(screen, flags, pid)) {
-        sink->flush(*result, QVariantMap{
-                                 {QStringLiteral("screen"), screen->name()},
-                             });
-    } else {
-        sink->cancel();
-    }
-    sink->deleteLater();
+    const QVariantMap attributes{
+        {QStringLiteral("screen"), screen->name()},
+    };
+    m_effect->takeScreenShot(screen, flags, pid, [sink = std::shared_ptr<ScreenShotSinkPipe2>(sink), attributes](std::optional<QImage> result) {
+        if (result) {
+            sink->flush(*result, attributes);
+        } else {
+            sink->cancel();
+        }
+    });
 }
 
 void ScreenShotDBusInterface2::takeScreenShot(const Rect &area, ScreenShotFlags flags,
                                               ScreenShotSinkPipe2 *sink, std::optional<pid_t> pid)
 {
-    if (const auto result = m_effect->takeScreenShot(area, flags, pid)) {
-        sink->flush(*result, {});
-    } else {
-        sink->cancel();
-    }
-    sink->deleteLater();
+    m_effect->takeScreenShot(area, flags, pid, [sink = std::shared_ptr<ScreenShotSinkPipe2>(sink)](std::optional<QImage> result) {
+        if (result) {
+            sink->flush(*result, {});
+        } else {
+            sink->cancel();
+        }
+    });
 }
 
 void ScreenShotDBusInterface2::takeScreenShot(Window *window, ScreenShotFlags flags,
                                               ScreenShotSinkPipe2 *sink)
 {
-    if (const auto result = m_effect->takeScreenShot(window, flags)) {
-        sink->flush(*result, QVariantMap{
-                                 {QStringLiteral("windowId"), window->internalId().toString()},
-                             });
-    } else {
-        sink->cancel();
-    }
-    sink->deleteLater();
+    // the window can be gone by the time the pixels have been downloaded
+    const QVariantMap attributes{
+        {QStringLiteral("windowId"), window->internalId().toString()},
+    };
+    m_effect->takeScreenShot(window, flags, [sink = std::shared_ptr<ScreenShotSinkPipe2>(sink), attributes](std::optional<QImage> result) {
+        if (result) {
+            sink->flush(*result, attributes);
+        } else {
+            sink->cancel();
+        }
+    });
 }
 
 } // namespace KWin
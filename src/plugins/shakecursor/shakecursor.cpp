@@ -39,7 +39,8 @@ void ShakeCursorItem::refresh()
 }
 
 ShakeCursorEffect::ShakeCursorEffect()
-    : m_cursor(Cursors::self()->mouse())
+    : InputEventSpy(InputEventType::Pointer)
+    , m_cursor(Cursors::self()->mouse())
 {
     input()->installInputEventSpy(this);
 
@@ -21,6 +21,10 @@ Rectangle {
             text: root.effect.fps + "/" + root.effect.maximumFps
         }
 
+        Text {
+            text: i18nc("@label", "Render time: %1 ms, missed frames: %2", (root.effect.renderTime / 1000).toFixed(1), root.effect.missedFrames)
+        }
+
         Text {
             Layout.fillWidth: true
             text: i18nc("@label", "This effect is not a benchmark")
@@ -187,6 +187,37 @@ Rectangle {
             }
         }
 
+        RowLayout {
+            Layout.fillWidth: true
+
+            ChartControls.LegendDelegate {
+                Layout.fillWidth: true
+                Layout.preferredWidth: 0
+
+                name: i18nc("@label", "Render Time")
+                value: i18nc("@label duration in milliseconds", "%1 ms", (root.effect.renderTime / 1000).toFixed(1))
+                color: root.effect.paintColor
+            }
+
+            ChartControls.LegendDelegate {
+                Layout.fillWidth: true
+                Layout.preferredWidth: 0
+
+                name: i18nc("@label", "Missed Frames")
+                value: root.effect.missedFrames
+                color: root.effect.missedFrames > 0 ? Kirigami.Theme.negativeTextColor : Kirigami.Theme.positiveTextColor
+            }
+
+            ChartControls.LegendDelegate {
+                Layout.fillWidth: true
+                Layout.preferredWidth: 0
+
+                name: i18nc("@label", "Direct Scanout")
+                value: root.effect.directScanout ? i18nc("@label direct scanout state", "On") : i18nc("@label direct scanout state", "Off")
+                color: Kirigami.Theme.neutralTextColor
+            }
+        }
+
         Label {
             Layout.fillWidth: true
             text: i18nc("@label", "This effect is not a benchmark")
@@ -7,7 +7,9 @@
 */
 
 #include "showfpseffect.h"
+#include "core/backendoutput.h"
 #include "core/output.h"
+#include "core/renderloop.h"
 #include "core/renderviewport.h"
 #include "effect/effecthandler.h"
 
@@ -16,8 +18,14 @@
 namespace KWin
 {
 
+static constexpr std::chrono::milliseconds s_updateInterval{250};
+
 ShowFpsEffect::ShowFpsEffect()
 {
+    m_updateTimer.setInterval(s_updateInterval);
+    connect(&m_updateTimer, &QTimer::timeout, this, &ShowFpsEffect::update);
+    m_updateTimer.start();
+    update();
 }
 
 ShowFpsEffect::~ShowFpsEffect() = default;
@@ -48,14 +56,60 @@ QColor ShowFpsEffect::paintColor() const
     return QColor::fromHsvF(0.3 - (0.3 * normalizedDuration), 1.0, 1.0);
 }
 
-void ShowFpsEffect::prePaintScreen(ScreenPrePaintData &data)
+int ShowFpsEffect::renderTime() const
 {
-    effects->prePaintScreen(data);
+    return m_renderTime;
+}
 
-    m_newFps += 1;
+int ShowFpsEffect::missedFrames() const
+{
+    return m_missedFrames;
+}
 
-    m_paintDurationTimer.restart();
-    m_paintAmount = 0;
+bool ShowFpsEffect::directScanout() const
+{
+    return m_directScanout;
+}
+
+QRect ShowFpsEffect::overlayGeometry(const QRect &screenGeometry)
+{
+    return QRect(screenGeometry.x() + screenGeometry.width() - 300, screenGeometry.y(), 300, 180);
+}
+
+void ShowFpsEffect::trackRenderLoop(RenderLoop *renderLoop)
+{
+    if (m_renderLoop == renderLoop) {
+        return;
+    }
+    if (m_renderLoop) {
+        disconnect(m_renderLoop, &RenderLoop::framePresented, this, nullptr);
+    }
+    m_renderLoop = renderLoop;
+    m_presentations.clear();
+    m_missedFrames = 0;
+    m_lastMissedDeadlines.reset();
+    if (m_renderLoop) {
+        // count the frames that actually reached the screen, not the ones that were painted
+        connect(m_renderLoop, &RenderLoop::framePresented, this, [this]() {
+            m_presentations.push_back(std::chrono::steady_clock::now());
+        });
+    }
+}
+
+void ShowFpsEffect::update()
+{
+    LogicalOutput *screen = effects->activeScreen();
+    BackendOutput *output = screen ? screen->backendOutput() : nullptr;
+    trackRenderLoop(output ? output->renderLoop() : nullptr);
+
+    const auto now = std::chrono::steady_clock::now();
+    while (!m_presentations.empty() && now - m_presentations.front() > std::chrono::seconds(1)) {
+        m_presentations.pop_front();
+    }
+    if (m_fps != int(m_presentations.size())) {
+        m_fps = m_presentations.size();
+        Q_EMIT fpsChanged();
+    }
 
     // detect highest monitor refresh rate
     uint32_t maximumFps = 0;
@@ -70,6 +124,34 @@ void ShowFpsEffect::prePaintScreen(ScreenPrePaintData &data)
         Q_EMIT maximumFpsChanged();
     }
 
+    if (m_renderLoop) {
+        m_renderTime = std::chrono::duration_cast<std::chrono::microseconds>(m_renderLoop->predictedRenderTime()).count();
+        m_directScanout = m_renderLoop->isDirectScanoutActive();
+        const qulonglong missedDeadlines = output->presentationStatistics().value(QStringLiteral("missedDeadlines")).toULongLong();
+        if (m_lastMissedDeadlines) {
+            m_missedFrames += missedDeadlines - *m_lastMissedDeadlines;
+        }
+        m_lastMissedDeadlines = missedDeadlines;
+        Q_EMIT telemetryChanged();
+    }
+
+    m_paintDuration = m_intervalPaintDuration;
+    m_paintAmount = m_intervalPaintAmount;
+    m_intervalPaintDuration = 0;
+    m_intervalPaintAmount = 0;
+    Q_EMIT paintChanged();
+
+    for (LogicalOutput *screen : screens) {
+        effects->addRepaint(overlayGeometry(screen->geometry()));
+    }
+}
+
+void ShowFpsEffect::prePaintScreen(ScreenPrePaintData &data)
+{
+    effects->prePaintScreen(data);
+
+    m_paintDurationTimer.restart();
+
     if (!m_scene) {
         m_scene = std::make_unique<OffscreenQuickScene>();
         m_scene->loadFromModule(QStringLiteral("org.kde.kwin.showfps"), QStringLiteral("Main"), {{QStringLiteral("effect"), QVariant::fromValue(this)}});
@@ -84,16 +166,7 @@ void ShowFpsEffect::paintScreen(const RenderTarget &renderTarget, const RenderVi
 {
     effects->paintScreen(renderTarget, viewport, mask, deviceRegion, screen);
 
-    auto now = std::chrono::steady_clock::now();
-    if ((now - m_lastFpsTime) >= std::chrono::milliseconds(1000)) {
-        m_fps = m_newFps;
-        m_newFps = 0;
-        m_lastFpsTime = now;
-        Q_EMIT fpsChanged();
-    }
-
-    const auto rect = viewport.renderRect();
-    m_scene->setGeometry(QRect(rect.x() + rect.width() - 300, rect.y(), 300, 150));
+    m_scene->setGeometry(overlayGeometry(viewport.renderRect().toRect()));
     effects->renderOffscreenQuickView(renderTarget, viewport, m_scene.get());
 }
 
@@ -106,7 +179,7 @@ void ShowFpsEffect::paintWindow(const RenderTarget &renderTarget, const RenderVi
     Region repaintRegion = deviceRegion & viewport.mapToDeviceCoordinatesAligned(w->frameGeometry());
     repaintRegion -= viewport.mapToDeviceCoordinatesAligned(Rect(m_scene->geometry()));
     for (const Rect &rect : repaintRegion.rects()) {
-        m_paintAmount += rect.width() * rect.height();
+        m_intervalPaintAmount += rect.width() * rect.height();
     }
 }
 
@@ -114,10 +187,13 @@ void ShowFpsEffect::postPaintScreen()
 {
     effects->postPaintScreen();
 
-    m_paintDuration = m_paintDurationTimer.elapsed();
-    Q_EMIT paintChanged();
+    m_intervalPaintDuration = std::max<int>(m_intervalPaintDuration, m_paintDurationTimer.elapsed());
+}
 
-    effects->addRepaint(m_scene->geometry());
+bool ShowFpsEffect::blocksDirectScanout() const
+{
+    // the overlay isn't worth giving up direct scanout over, it would change what is measured
+    return false;
 }
 
 bool ShowFpsEffect::supported()
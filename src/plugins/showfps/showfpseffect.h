@@ -12,10 +12,17 @@
 #include "effect/offscreenquickview.h"
 
 #include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
+
+#include <deque>
+#include <optional>
 
 namespace KWin
 {
 
+class RenderLoop;
+
 class ShowFpsEffect : public Effect
 {
     Q_OBJECT
@@ -24,6 +31,9 @@ class ShowFpsEffect : public Effect
     Q_PROPERTY(int paintDuration READ paintDuration NOTIFY paintChanged)
     Q_PROPERTY(int paintAmount READ paintAmount NOTIFY paintChanged)
     Q_PROPERTY(QColor paintColor READ paintColor NOTIFY paintChanged)
+    Q_PROPERTY(int renderTime READ renderTime NOTIFY telemetryChanged)
+    Q_PROPERTY(int missedFrames READ missedFrames NOTIFY telemetryChanged)
+    Q_PROPERTY(bool directScanout READ directScanout NOTIFY telemetryChanged)
 
 public:
     ShowFpsEffect();
@@ -34,11 +44,15 @@ public:
     int paintDuration() const;
     int paintAmount() const;
     QColor paintColor() const;
+    int renderTime() const;
+    int missedFrames() const;
+    bool directScanout() const;
 
     void prePaintScreen(ScreenPrePaintData &data) override;
     void paintScreen(const RenderTarget &renderTarget, const RenderViewport &viewport, int mask, const Region &deviceRegion, LogicalOutput *screen) override;
     void paintWindow(const RenderTarget &renderTarget, const RenderViewport &viewport, EffectWindow *w, int mask, const Region &deviceRegion, KWin::WindowPaintData &data) override;
     void postPaintScreen() override;
+    bool blocksDirectScanout() const override;
 
     static bool supported();
 
@@ -46,18 +60,33 @@ Q_SIGNALS:
     void fpsChanged();
     void maximumFpsChanged();
     void paintChanged();
+    void telemetryChanged();
 
 private:
+    void update();
+    void trackRenderLoop(RenderLoop *renderLoop);
+    static QRect overlayGeometry(const QRect &screenGeometry);
+
     std::unique_ptr<OffscreenQuickScene> m_scene;
 
     uint32_t m_maximumFps = 0;
 
+    // the numbers are updated a few times per second instead of after every frame, so that
+    // the overlay doesn't keep the compositor busy and the measurements stay meaningful
+    QTimer m_updateTimer;
+    QPointer<RenderLoop> m_renderLoop;
+    std::deque<std::chrono::steady_clock::time_point> m_presentations;
     int m_fps = 0;
-    int m_newFps = 0;
-    std::chrono::steady_clock::time_point m_lastFpsTime;
+
+    int m_renderTime = 0;
+    int m_missedFrames = 0;
+    std::optional<qulonglong> m_lastMissedDeadlines;
+    bool m_directScanout = false;
 
     int m_paintDuration = 0;
     int m_paintAmount = 0;
+    int m_intervalPaintDuration = 0;
+    int m_intervalPaintAmount = 0;
     QElapsedTimer m_paintDurationTimer;
 };
 
@@ -16,7 +16,7 @@ namespace KWin
 {
 
 SlowKeysFilter::SlowKeysFilter()
-    : InputEventFilter(InputFilterOrder::SlowKeys)
+    : InputEventFilter(InputFilterOrder::SlowKeys, InputEventType::Keyboard)
     , m_configWatcher(KConfigWatcher::create(KSharedConfig::openConfig("kaccessrc")))
 {
     const QLatin1StringView groupName("Keyboard");
@@ -18,6 +18,9 @@ def main():
     with open(args.source, "r") as src:
         original_json = json.load(src)
         stripped_json["KPlugin"]["EnabledByDefault"] = original_json["KPlugin"]["EnabledByDefault"]
+        # the shortcuts of an effect that is only created when it's used for the first time
+        if "X-KWin-Deferred-Shortcuts" in original_json:
+            stripped_json["X-KWin-Deferred-Shortcuts"] = original_json["X-KWin-Deferred-Shortcuts"]
 
     with open(args.output, "w") as dst:
         json.dump(stripped_json, dst)
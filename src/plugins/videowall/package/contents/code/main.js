@@ -7,6 +7,11 @@
     SPDX-License-Identifier: GPL-2.0-or-later
 */
 
+// Every output still presents on its own vblank, so panels that aren't genlocked can show
+// neighbouring frames of the video for a moment. Starting the frames of all outputs at the
+// same point of their refresh cycle with KWIN_FRAME_SCHEDULING_POLICY=fixedcadence keeps
+// that to at most one frame.
+
 var applyTo = readConfig("ApplyTo", true);
 var whitelist = readConfig("Whitelist", "vlc, xv, vdpau, smplayer, dragon, xine, ffplay, mplayer").toString().toLowerCase().split(",");
 for (i = 0; i < whitelist.length; ++i)
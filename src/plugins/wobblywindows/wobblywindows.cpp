@@ -268,11 +268,32 @@ void WobblyWindowsEffect::apply(EffectWindow *w, int mask, WindowPaintData &data
         double bottom = w->height();
 
         quads = quads.makeRegularGrid(m_xTessellation, m_yTessellation);
+
+        // the sub-quads are emitted row by row, so the vertices mostly lie on the top or the
+        // bottom row of the previous quad and its curves can be reused
+        struct Row
+        {
+            qreal v = -1.0;
+            Pair curve[4];
+        };
+        Row rows[2];
+        int lastRow = 0;
+        auto curveAt = [&](qreal v) -> const Pair * {
+            for (const Row &row : rows) {
+                if (row.v == v) {
+                    return row.curve;
+                }
+            }
+            lastRow = 1 - lastRow;
+            rows[lastRow].v = v;
+            computeBezierCurve(wwi, v, rows[lastRow].curve);
+            return rows[lastRow].curve;
+        };
+
         for (int i = 0; i < quads.count(); ++i) {
             for (int j = 0; j < 4; ++j) {
                 WindowVertex &v = quads[i][j];
-                Pair uv = {v.x() / width, v.y() / height};
-                Pair newPos = computeBezierPoint(wwi, uv);
+                const Pair newPos = computeBezierPoint(curveAt(v.y() / height), v.x() / width);
                 v.move(newPos.x - tx, newPos.y - ty);
             }
             left = std::min(left, quads[i].left());
@@ -469,10 +490,6 @@ void WobblyWindowsEffect::initWobblyInfo(WindowWobblyInfos &wwi, QRectF geometry
     wwi.width = 4;
     wwi.height = 4;
 
-    wwi.bezierWidth = m_xTessellation;
-    wwi.bezierHeight = m_yTessellation;
-    wwi.bezierCount = m_xTessellation * m_yTessellation;
-
     wwi.origin.resize(wwi.count);
     wwi.position.resize(wwi.count);
     wwi.velocity.resize(wwi.count);
@@ -480,8 +497,6 @@ void WobblyWindowsEffect::initWobblyInfo(WindowWobblyInfos &wwi, QRectF geometry
     wwi.buffer.resize(wwi.count);
     wwi.constraint.resize(wwi.count);
 
-    wwi.bezierSurface.resize(wwi.bezierCount);
-
     wwi.status = Moving;
 
     qreal x = geometry.x(), y = geometry.y();
@@ -518,35 +533,41 @@ void WobblyWindowsEffect::initWobblyInfo(WindowWobblyInfos &wwi, QRectF geometry
     }
 }
 
-WobblyWindowsEffect::Pair WobblyWindowsEffect::computeBezierPoint(const WindowWobblyInfos &wwi, Pair point) const
+void WobblyWindowsEffect::computeBezierCurve(const WindowWobblyInfos &wwi, qreal ty, Pair curve[4])
 {
-    const qreal tx = point.x;
-    const qreal ty = point.y;
-
     // compute polynomial coeff
+    const qreal py[4] = {
+        (1 - ty) * (1 - ty) * (1 - ty),
+        3 * (1 - ty) * (1 - ty) * ty,
+        3 * (1 - ty) * ty * ty,
+        ty * ty * ty,
+    };
+
+    // this assume the grid is 4*4
+    const Pair *position = wwi.position.constData();
+    for (unsigned int i = 0; i < 4; ++i) {
+        curve[i] = {0.0, 0.0};
+        for (unsigned int j = 0; j < 4; ++j) {
+            curve[i].x += py[j] * position[i + j * wwi.width].x;
+            curve[i].y += py[j] * position[i + j * wwi.width].y;
+        }
+    }
+}
 
-    qreal px[4];
-    px[0] = (1 - tx) * (1 - tx) * (1 - tx);
-    px[1] = 3 * (1 - tx) * (1 - tx) * tx;
-    px[2] = 3 * (1 - tx) * tx * tx;
-    px[3] = tx * tx * tx;
-
-    qreal py[4];
-    py[0] = (1 - ty) * (1 - ty) * (1 - ty);
-    py[1] = 3 * (1 - ty) * (1 - ty) * ty;
-    py[2] = 3 * (1 - ty) * ty * ty;
-    py[3] = ty * ty * ty;
+WobblyWindowsEffect::Pair WobblyWindowsEffect::computeBezierPoint(const Pair curve[4], qreal tx)
+{
+    const qreal px[4] = {
+        (1 - tx) * (1 - tx) * (1 - tx),
+        3 * (1 - tx) * (1 - tx) * tx,
+        3 * (1 - tx) * tx * tx,
+        tx * tx * tx,
+    };
 
     Pair res = {0.0, 0.0};
-
-    for (unsigned int j = 0; j < 4; ++j) {
-        for (unsigned int i = 0; i < 4; ++i) {
-            // this assume the grid is 4*4
-            res.x += px[i] * py[j] * wwi.position[i + j * wwi.width].x;
-            res.y += px[i] * py[j] * wwi.position[i + j * wwi.width].y;
-        }
+    for (unsigned int i = 0; i < 4; ++i) {
+        res.x += px[i] * curve[i].x;
+        res.y += px[i] * curve[i].y;
     }
-
     return res;
 }
 
@@ -1083,9 +1104,7 @@ void WobblyWindowsEffect::heightRingLinearMean(QList<Pair> &data, WindowWobblyIn
         }
     }
 
-    auto tmp = data;
-    data = wwi.buffer;
-    wwi.buffer = tmp;
+    data.swap(wwi.buffer);
 }
 
 bool WobblyWindowsEffect::isActive() const
@@ -1093,6 +1112,11 @@ bool WobblyWindowsEffect::isActive() const
     return !windows.isEmpty();
 }
 
+bool WobblyWindowsEffect::isActiveForWindow(EffectWindow *w) const
+{
+    return windows.contains(w);
+}
+
 qreal WobblyWindowsEffect::stiffness() const
 {
     return m_stiffness;
@@ -45,6 +45,7 @@ public:
     void prePaintWindow(RenderView *view, EffectWindow *w, WindowPrePaintData &data) override;
     void postPaintScreen() override;
     bool isActive() const override;
+    bool isActiveForWindow(EffectWindow *w) const override;
 
     int requestedEffectChainPosition() const override
     {
@@ -119,11 +120,6 @@ private:
         unsigned int height;
         unsigned int count;
 
-        QList<Pair> bezierSurface;
-        unsigned int bezierWidth;
-        unsigned int bezierHeight;
-        unsigned int bezierCount;
-
         WindowStatus status;
         bool wobblying = false;
 
@@ -160,7 +156,13 @@ private:
 
     void initWobblyInfo(WindowWobblyInfos &wwi, QRectF geometry) const;
 
-    WobblyWindowsEffect::Pair computeBezierPoint(const WindowWobblyInfos &wwi, Pair point) const;
+    /**
+     * Collapses the rows of the control grid into the 4 control points of the horizontal
+     * bezier curve at @p ty. The vertices of a regular grid share their rows, so the curve
+     * only has to be computed once per row and not once per vertex.
+     */
+    static void computeBezierCurve(const WindowWobblyInfos &wwi, qreal ty, Pair curve[4]);
+    static Pair computeBezierPoint(const Pair curve[4], qreal tx);
 
     static void heightRingLinearMean(QList<Pair> &data, WindowWobblyInfos &wwi);
 
@@ -15,6 +15,7 @@
 #include "cursor.h"
 #include "effect/effecthandler.h"
 #include "focustracker.h"
+#include "opengl/glrendertargetpool.h"
 #include "opengl/glutils.h"
 #include "scene/cursoritem.h"
 #include "scene/workspacescene.h"
@@ -153,6 +154,18 @@ ZoomEffect::~ZoomEffect()
     saveInitialZoom();
 }
 
+void ZoomEffect::scheduleZoomRepaint()
+{
+    // As long as the content of the screens doesn't change, the offscreen textures can be
+    // reused, so only ask for a new frame instead of damaging everything.
+    const auto views = effects->scene()->views();
+    for (RenderView *view : views) {
+        if (qobject_cast<SceneView *>(view)) {
+            view->scheduleRepaint(nullptr);
+        }
+    }
+}
+
 QPointF ZoomEffect::calculateCursorItemPosition() const
 {
     return Cursors::self()->mouse()->pos() * m_zoom + QPoint(m_xTranslation, m_yTranslation);
@@ -310,38 +323,9 @@ void ZoomEffect::prePaintScreen(ScreenPrePaintData &data)
         m_yTranslation = std::min(0, std::max(int(screenSize.height() - screenSize.height() * m_zoom), int(screenSize.height() / 2 - m_prevPoint.y() * m_zoom)));
         break;
     case MouseTrackingPush: {
-        // touching an edge of the screen moves the zoom-area in that direction.
-        const int x = trackPoint.x() * m_zoom - m_prevPoint.x() * (m_zoom - 1.0);
-        const int y = trackPoint.y() * m_zoom - m_prevPoint.y() * (m_zoom - 1.0);
-        const int threshold = 4;
-        const RectF currScreen = effects->screenAt(QPoint(x, y))->geometry();
-
-        // bounds of the screen the cursor's on
-        const int screenTop = currScreen.top();
-        const int screenLeft = currScreen.left();
-        const int screenRight = currScreen.right();
-        const int screenBottom = currScreen.bottom();
-        const int screenCenterX = currScreen.center().x();
-        const int screenCenterY = currScreen.center().y();
-
-        // figure out whether we have adjacent displays in all 4 directions
-        // We pan within the screen in directions where there are no adjacent screens.
-        const bool adjacentLeft = screenExistsAt(QPoint(screenLeft - 1, screenCenterY));
-        const bool adjacentRight = screenExistsAt(QPoint(screenRight + 1, screenCenterY));
-        const bool adjacentTop = screenExistsAt(QPoint(screenCenterX, screenTop - 1));
-        const bool adjacentBottom = screenExistsAt(QPoint(screenCenterX, screenBottom + 1));
-
-        m_xMove = m_yMove = 0;
-        if (x < screenLeft + threshold && !adjacentLeft) {
-            m_xMove = (x - threshold - screenLeft) / m_zoom;
-        } else if (x > screenRight - threshold && !adjacentRight) {
-            m_xMove = (x + threshold - screenRight) / m_zoom;
-        }
-        if (y < screenTop + threshold && !adjacentTop) {
-            m_yMove = (y - threshold - screenTop) / m_zoom;
-        } else if (y > screenBottom - threshold && !adjacentBottom) {
-            m_yMove = (y + threshold - screenBottom) / m_zoom;
-        }
+        const QPoint move = pushMovement(trackPoint);
+        m_xMove = move.x();
+        m_yMove = move.y();
         if (m_xMove) {
             m_prevPoint.setX(m_prevPoint.x() + m_xMove);
         }
@@ -362,24 +346,81 @@ void ZoomEffect::prePaintScreen(ScreenPrePaintData &data)
     effects->prePaintScreen(data);
 }
 
+QPoint ZoomEffect::pushMovement(const QPoint &trackPoint) const
+{
+    // touching an edge of the screen moves the zoom-area in that direction.
+    const int x = trackPoint.x() * m_zoom - m_prevPoint.x() * (m_zoom - 1.0);
+    const int y = trackPoint.y() * m_zoom - m_prevPoint.y() * (m_zoom - 1.0);
+    const int threshold = 4;
+    const RectF currScreen = effects->screenAt(QPoint(x, y))->geometry();
+
+    // bounds of the screen the cursor's on
+    const int screenTop = currScreen.top();
+    const int screenLeft = currScreen.left();
+    const int screenRight = currScreen.right();
+    const int screenBottom = currScreen.bottom();
+    const int screenCenterX = currScreen.center().x();
+    const int screenCenterY = currScreen.center().y();
+
+    // figure out whether we have adjacent displays in all 4 directions
+    // We pan within the screen in directions where there are no adjacent screens.
+    const bool adjacentLeft = screenExistsAt(QPoint(screenLeft - 1, screenCenterY));
+    const bool adjacentRight = screenExistsAt(QPoint(screenRight + 1, screenCenterY));
+    const bool adjacentTop = screenExistsAt(QPoint(screenCenterX, screenTop - 1));
+    const bool adjacentBottom = screenExistsAt(QPoint(screenCenterX, screenBottom + 1));
+
+    QPoint move;
+    if (x < screenLeft + threshold && !adjacentLeft) {
+        move.setX((x - threshold - screenLeft) / m_zoom);
+    } else if (x > screenRight - threshold && !adjacentRight) {
+        move.setX((x + threshold - screenRight) / m_zoom);
+    }
+    if (y < screenTop + threshold && !adjacentTop) {
+        move.setY((y - threshold - screenTop) / m_zoom);
+    } else if (y > screenBottom - threshold && !adjacentBottom) {
+        move.setY((y + threshold - screenBottom) / m_zoom);
+    }
+    return move;
+}
+
+bool ZoomEffect::isPannedByPointer() const
+{
+    if (m_zoom != m_targetZoom || m_focusPoint) {
+        return true;
+    }
+    switch (m_mouseTracking) {
+    case MouseTrackingDisabled:
+        return false;
+    case MouseTrackingPush:
+        return !pushMovement(m_cursorPoint).isNull();
+    default:
+        return true;
+    }
+}
+
 ZoomEffect::OffscreenData *ZoomEffect::ensureOffscreenData(const RenderTarget &renderTarget, const RenderViewport &viewport, LogicalOutput *screen)
 {
     const QSize nativeSize = viewport.deviceSize();
 
     // TODO this should be per view, rather than per logical screen.
     OffscreenData &data = m_offscreenData[screen];
+    if (data.viewport != viewport.renderRect() || data.color != renderTarget.colorDescription()) {
+        data.valid = false;
+    }
     data.viewport = viewport.renderRect();
     data.color = renderTarget.colorDescription();
 
     const GLenum textureFormat = renderTarget.colorDescription() == ColorDescription::sRGB ? GL_RGBA8 : GL_RGBA16F;
     if (!data.texture || data.texture->size() != nativeSize || data.texture->internalFormat() != textureFormat) {
-        data.texture = GLTexture::allocate(textureFormat, nativeSize);
-        if (!data.texture) {
+        GLRenderTargetPool *pool = EglContext::currentContext()->renderTargetPool();
+        pool->release(GLRenderTarget(std::move(data.texture), std::move(data.framebuffer)));
+        GLRenderTarget target = pool->acquire(textureFormat, nativeSize);
+        if (!target) {
             return nullptr;
         }
-        data.texture->setFilter(GL_LINEAR);
-        data.texture->setWrapMode(GL_CLAMP_TO_EDGE);
-        data.framebuffer = std::make_unique<GLFramebuffer>(data.texture.get());
+        data.texture = std::move(target.texture);
+        data.framebuffer = std::move(target.framebuffer);
+        data.valid = false;
     }
 
     return &data;
@@ -405,12 +446,20 @@ void ZoomEffect::paintScreen(const RenderTarget &renderTarget, const RenderViewp
         return;
     }
 
-    // Render the scene in an offscreen texture and then upscale it.
-    RenderTarget offscreenRenderTarget(offscreenData->framebuffer.get(), renderTarget.colorDescription());
-    RenderViewport offscreenViewport(viewport.renderRect(), viewport.scale(), offscreenRenderTarget, QPoint());
-    GLFramebuffer::pushFramebuffer(offscreenData->framebuffer.get());
-    effects->paintScreen(offscreenRenderTarget, offscreenViewport, mask, deviceRegion, screen);
-    GLFramebuffer::popFramebuffer();
+    // Render the scene in an offscreen texture and then upscale it. The texture is not magnified
+    // yet, so moving the zoom area or changing the zoom level doesn't invalidate it.
+    Region offscreenRegion = Region::infinite();
+    if (offscreenData->valid) {
+        offscreenRegion = effects->scene()->contentDamage().translated(-viewport.renderOffset());
+    }
+    if (!offscreenRegion.isEmpty()) {
+        RenderTarget offscreenRenderTarget(offscreenData->framebuffer.get(), renderTarget.colorDescription());
+        RenderViewport offscreenViewport(viewport.renderRect(), viewport.scale(), offscreenRenderTarget, QPoint());
+        GLFramebuffer::pushFramebuffer(offscreenData->framebuffer.get());
+        effects->paintScreen(offscreenRenderTarget, offscreenViewport, mask, offscreenRegion, screen);
+        GLFramebuffer::popFramebuffer();
+        offscreenData->valid = true;
+    }
 
     const auto scale = viewport.scale();
 
@@ -442,9 +491,11 @@ void ZoomEffect::postPaintScreen()
         m_clock.reset();
     }
 
-    if (m_zoom == 1.0 || m_zoom != m_targetZoom) {
-        // Either animation is running or the zoom effect has stopped.
+    if (m_zoom == 1.0) {
+        // The zoom effect has stopped, the screens have to show the unmagnified contents again.
         effects->addRepaintFull();
+    } else if (m_zoom != m_targetZoom) {
+        scheduleZoomRepaint();
     }
 
     effects->postPaintScreen();
@@ -493,7 +544,7 @@ void ZoomEffect::timelineFrameChanged(int /* frame */)
     m_prevPoint.setX(std::max(0, std::min(screenSize.width(), m_prevPoint.x() + m_xMove)));
     m_prevPoint.setY(std::max(0, std::min(screenSize.height(), m_prevPoint.y() + m_yMove)));
     m_cursorPoint = m_prevPoint;
-    effects->addRepaintFull();
+    scheduleZoomRepaint();
 }
 
 void ZoomEffect::moveZoom(int x, int y)
@@ -566,7 +617,11 @@ void ZoomEffect::slotMouseChanged(const QPointF &pos, const QPointF &old)
     m_cursorPoint = pos.toPoint();
     if (pos != old) {
         m_lastMouseEvent = QTime::currentTime();
-        effects->addRepaintFull();
+        // if the zoom area stays where it is, only the cursor item has to move, which
+        // doesn't need a repaint of the whole screen, or none at all on a cursor plane
+        if (isPannedByPointer()) {
+            scheduleZoomRepaint();
+        }
     }
 }
 
@@ -578,7 +633,7 @@ void ZoomEffect::slotWindowAdded(EffectWindow *w)
 void ZoomEffect::slotWindowDamaged()
 {
     if (m_zoom != 1.0) {
-        effects->addRepaintFull();
+        scheduleZoomRepaint();
     }
 }
 
@@ -597,7 +652,7 @@ void ZoomEffect::moveFocus(const QPointF &point)
     }
     m_focusPoint = point.toPoint();
     m_lastFocusEvent = QTime::currentTime();
-    effects->addRepaintFull();
+    scheduleZoomRepaint();
 }
 
 bool ZoomEffect::isActive() const
@@ -679,7 +734,7 @@ void ZoomEffect::setTargetZoom(double value)
     }
     m_targetZoom = value;
     m_configurationTimer->start();
-    effects->addRepaintFull();
+    scheduleZoomRepaint();
 }
 
 void ZoomEffect::realtimeZoom(double delta)
@@ -100,15 +100,20 @@ private:
         std::unique_ptr<GLFramebuffer> framebuffer;
         QRectF viewport;
         std::shared_ptr<ColorDescription> color = ColorDescription::sRGB;
+        // whether the texture holds the whole screen as of the last frame
+        bool valid = false;
     };
 
     void moveZoom(int x, int y);
     bool screenExistsAt(const QPoint &point) const;
+    QPoint pushMovement(const QPoint &trackPoint) const;
+    bool isPannedByPointer() const;
     void realtimeZoom(double delta);
 
     QPointF calculateCursorItemPosition() const;
     void showCursor();
     void hideCursor();
+    void scheduleZoomRepaint();
     GLTexture *ensureCursorTexture();
     OffscreenData *ensureOffscreenData(const RenderTarget &renderTarget, const RenderViewport &viewport, LogicalOutput *screen);
     void markCursorTextureDirty();
@@ -22,6 +22,7 @@
 #include "mousebuttons.h"
 #include "osd.h"
 #include "screenedge.h"
+#include "utils/envvar.h"
 #include "wayland/abstract_data_source.h"
 #include "wayland/display.h"
 #include "wayland/pointer.h"
@@ -63,6 +64,8 @@ static bool screenContainsPos(const QPointF &pos)
     return false;
 }
 
+static const bool s_coalesceMotion = environmentVariableBoolValue("KWIN_POINTER_MOTION_COALESCING").value_or(true);
+
 static QPointF confineToBoundingBox(const QPointF &pos, const RectF &boundingBox)
 {
     return QPointF(
@@ -74,6 +77,9 @@ PointerInputRedirection::PointerInputRedirection(InputRedirection *parent)
     : InputDeviceHandler(parent)
     , m_cursor(nullptr)
 {
+    m_coalescedMotionTimer.setSingleShot(true);
+    m_coalescedMotionTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_coalescedMotionTimer, &QTimer::timeout, this, &PointerInputRedirection::flushCoalescedMotion);
 }
 
 PointerInputRedirection::~PointerInputRedirection() = default;
@@ -283,9 +289,14 @@ void PointerInputRedirection::processMotionInternal(const QPointF &pos, const QP
         .timestamp = time,
     };
 
-    update();
-    input()->processSpies(&InputEventSpy::pointerMotion, &event);
-    input()->processFilters(&InputEventFilter::pointerMotion, &event);
+    // A locked pointer doesn't move, so the window under it can only change if the stacking
+    // order changes, which triggers an update on its own. Games that lock the pointer produce
+    // motion at the full mouse rate, looking up the window every time isn't necessary.
+    if (!m_locked) {
+        update();
+    }
+    input()->processSpies(InputEventType::Pointer, &InputEventSpy::pointerMotion, &event);
+    input()->processFilters(InputEventType::Pointer, &InputEventFilter::pointerMotion, &event);
 }
 
 void PointerInputRedirection::processButton(uint32_t button, PointerButtonState state, std::chrono::microseconds time, InputDevice *device)
@@ -294,6 +305,7 @@ void PointerInputRedirection::processButton(uint32_t button, PointerButtonState
     if (!inited()) {
         return;
     }
+    flushCoalescedMotion();
 
     if (state == PointerButtonState::Pressed) {
         update();
@@ -313,8 +325,8 @@ void PointerInputRedirection::processButton(uint32_t button, PointerButtonState
         .timestamp = time,
     };
 
-    input()->processSpies(&InputEventSpy::pointerButton, &event);
-    input()->processFilters(&InputEventFilter::pointerButton, &event);
+    input()->processSpies(InputEventType::Pointer, &InputEventSpy::pointerButton, &event);
+    input()->processFilters(InputEventType::Pointer, &InputEventFilter::pointerButton, &event);
     if (state == PointerButtonState::Pressed) {
         input()->setLastInteractionSerial(waylandServer()->seat()->display()->serial());
         if (auto f = focus()) {
@@ -334,6 +346,7 @@ void PointerInputRedirection::processAxis(PointerAxis axis, qreal delta, qint32
     if (!inited()) {
         return;
     }
+    flushCoalescedMotion();
 
     update();
 
@@ -353,8 +366,8 @@ void PointerInputRedirection::processAxis(PointerAxis axis, qreal delta, qint32
         .timestamp = time,
     };
 
-    input()->processSpies(&InputEventSpy::pointerAxis, &event);
-    input()->processFilters(&InputEventFilter::pointerAxis, &event);
+    input()->processSpies(InputEventType::Pointer, &InputEventSpy::pointerAxis, &event);
+    input()->processFilters(InputEventType::Pointer, &InputEventFilter::pointerAxis, &event);
 }
 
 void PointerInputRedirection::processSwipeGestureBegin(int fingerCount, std::chrono::microseconds time, KWin::InputDevice *device)
@@ -363,6 +376,7 @@ void PointerInputRedirection::processSwipeGestureBegin(int fingerCount, std::chr
     if (!inited()) {
         return;
     }
+    flushCoalescedMotion();
     update();
 
     PointerSwipeGestureBeginEvent event{
@@ -370,8 +384,8 @@ void PointerInputRedirection::processSwipeGestureBegin(int fingerCount, std::chr
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::swipeGestureBegin, &event);
-    input()->processFilters(&InputEventFilter::swipeGestureBegin, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::swipeGestureBegin, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::swipeGestureBegin, &event);
 }
 
 void PointerInputRedirection::processSwipeGestureUpdate(const QPointF &delta, std::chrono::microseconds time, KWin::InputDevice *device)
@@ -387,8 +401,8 @@ void PointerInputRedirection::processSwipeGestureUpdate(const QPointF &delta, st
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::swipeGestureUpdate, &event);
-    input()->processFilters(&InputEventFilter::swipeGestureUpdate, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::swipeGestureUpdate, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::swipeGestureUpdate, &event);
 }
 
 void PointerInputRedirection::processSwipeGestureEnd(std::chrono::microseconds time, KWin::InputDevice *device)
@@ -403,8 +417,8 @@ void PointerInputRedirection::processSwipeGestureEnd(std::chrono::microseconds t
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::swipeGestureEnd, &event);
-    input()->processFilters(&InputEventFilter::swipeGestureEnd, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::swipeGestureEnd, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::swipeGestureEnd, &event);
 }
 
 void PointerInputRedirection::processSwipeGestureCancelled(std::chrono::microseconds time, KWin::InputDevice *device)
@@ -419,8 +433,8 @@ void PointerInputRedirection::processSwipeGestureCancelled(std::chrono::microsec
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::swipeGestureCancelled, &event);
-    input()->processFilters(&InputEventFilter::swipeGestureCancelled, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::swipeGestureCancelled, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::swipeGestureCancelled, &event);
 }
 
 void PointerInputRedirection::processPinchGestureBegin(int fingerCount, std::chrono::microseconds time, KWin::InputDevice *device)
@@ -429,6 +443,7 @@ void PointerInputRedirection::processPinchGestureBegin(int fingerCount, std::chr
     if (!inited()) {
         return;
     }
+    flushCoalescedMotion();
     update();
 
     PointerPinchGestureBeginEvent event{
@@ -436,8 +451,8 @@ void PointerInputRedirection::processPinchGestureBegin(int fingerCount, std::chr
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::pinchGestureBegin, &event);
-    input()->processFilters(&InputEventFilter::pinchGestureBegin, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::pinchGestureBegin, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::pinchGestureBegin, &event);
 }
 
 void PointerInputRedirection::processPinchGestureUpdate(qreal scale, qreal angleDelta, const QPointF &delta, std::chrono::microseconds time, KWin::InputDevice *device)
@@ -455,8 +470,8 @@ void PointerInputRedirection::processPinchGestureUpdate(qreal scale, qreal angle
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::pinchGestureUpdate, &event);
-    input()->processFilters(&InputEventFilter::pinchGestureUpdate, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::pinchGestureUpdate, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::pinchGestureUpdate, &event);
 }
 
 void PointerInputRedirection::processPinchGestureEnd(std::chrono::microseconds time, KWin::InputDevice *device)
@@ -471,8 +486,8 @@ void PointerInputRedirection::processPinchGestureEnd(std::chrono::microseconds t
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::pinchGestureEnd, &event);
-    input()->processFilters(&InputEventFilter::pinchGestureEnd, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::pinchGestureEnd, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::pinchGestureEnd, &event);
 }
 
 void PointerInputRedirection::processPinchGestureCancelled(std::chrono::microseconds time, KWin::InputDevice *device)
@@ -487,8 +502,8 @@ void PointerInputRedirection::processPinchGestureCancelled(std::chrono::microsec
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::pinchGestureCancelled, &event);
-    input()->processFilters(&InputEventFilter::pinchGestureCancelled, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::pinchGestureCancelled, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::pinchGestureCancelled, &event);
 }
 
 void PointerInputRedirection::processHoldGestureBegin(int fingerCount, std::chrono::microseconds time, KWin::InputDevice *device)
@@ -496,6 +511,7 @@ void PointerInputRedirection::processHoldGestureBegin(int fingerCount, std::chro
     if (!inited()) {
         return;
     }
+    flushCoalescedMotion();
     update();
 
     PointerHoldGestureBeginEvent event{
@@ -503,8 +519,8 @@ void PointerInputRedirection::processHoldGestureBegin(int fingerCount, std::chro
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::holdGestureBegin, &event);
-    input()->processFilters(&InputEventFilter::holdGestureBegin, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::holdGestureBegin, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::holdGestureBegin, &event);
 }
 
 void PointerInputRedirection::processHoldGestureEnd(std::chrono::microseconds time, KWin::InputDevice *device)
@@ -518,8 +534,8 @@ void PointerInputRedirection::processHoldGestureEnd(std::chrono::microseconds ti
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::holdGestureEnd, &event);
-    input()->processFilters(&InputEventFilter::holdGestureEnd, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::holdGestureEnd, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::holdGestureEnd, &event);
 }
 
 void PointerInputRedirection::processHoldGestureCancelled(std::chrono::microseconds time, KWin::InputDevice *device)
@@ -533,8 +549,8 @@ void PointerInputRedirection::processHoldGestureCancelled(std::chrono::microseco
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::holdGestureCancelled, &event);
-    input()->processFilters(&InputEventFilter::holdGestureCancelled, &event);
+    input()->processSpies(InputEventType::Gesture, &InputEventSpy::holdGestureCancelled, &event);
+    input()->processFilters(InputEventType::Gesture, &InputEventFilter::holdGestureCancelled, &event);
 }
 
 void PointerInputRedirection::processFrame(KWin::InputDevice *device)
@@ -543,7 +559,51 @@ void PointerInputRedirection::processFrame(KWin::InputDevice *device)
         return;
     }
 
-    input()->processFilters(&InputEventFilter::pointerFrame);
+    input()->processFilters(InputEventType::Pointer, &InputEventFilter::pointerFrame);
+}
+
+bool PointerInputRedirection::coalesceMotion(const PointerMotionEvent *event)
+{
+    auto seat = waylandServer()->seat();
+    // relative pointer consumers like games want every motion, and warps must not be delayed
+    if (!s_coalesceMotion || event->warp || !seat->focusedPointerSurface() || seat->isFocusedPointerRelative()) {
+        // the new position supersedes anything that's still pending
+        m_coalescedMotion.reset();
+        m_coalescedMotionTimer.stop();
+        return false;
+    }
+    m_coalescedMotion = CoalescedMotion{
+        .surface = seat->focusedPointerSurface(),
+        .position = event->position,
+        .timestamp = event->timestamp,
+    };
+    if (!m_coalescedMotionTimer.isActive()) {
+        const LogicalOutput *output = workspace()->outputAt(event->position);
+        const uint32_t refreshRate = output && output->refreshRate() ? output->refreshRate() : 60000;
+        m_coalescedMotionTimer.start(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::microseconds(1'000'000'000 / refreshRate)));
+    }
+    return true;
+}
+
+bool PointerInputRedirection::hasCoalescedMotion() const
+{
+    return m_coalescedMotion.has_value();
+}
+
+void PointerInputRedirection::flushCoalescedMotion()
+{
+    m_coalescedMotionTimer.stop();
+    const std::optional<CoalescedMotion> motion = std::exchange(m_coalescedMotion, std::nullopt);
+    if (!motion) {
+        return;
+    }
+    auto seat = waylandServer()->seat();
+    if (!motion->surface || seat->focusedPointerSurface() != motion->surface) {
+        return;
+    }
+    seat->setTimestamp(motion->timestamp);
+    seat->notifyPointerMotion(motion->position);
+    seat->notifyPointerFrame();
 }
 
 bool PointerInputRedirection::areButtonsPressed() const
@@ -624,6 +684,9 @@ void PointerInputRedirection::cleanupDecoration(Decoration::DecoratedWindowImpl
 
 void PointerInputRedirection::focusUpdate(Window *focusOld, Window *focusNow)
 {
+    // the motion belongs to the surface that's about to lose focus
+    flushCoalescedMotion();
+
     if (focusOld && focusOld->isClient()) {
         focusOld->pointerLeaveEvent();
         breakPointerConstraints(focusOld->surface());
@@ -18,6 +18,9 @@
 #include <QObject>
 #include <QPointF>
 #include <QPointer>
+#include <QTimer>
+
+#include <optional>
 
 class QWindow;
 
@@ -145,6 +148,24 @@ public:
      */
     void processFrame(KWin::InputDevice *device = nullptr);
 
+    /**
+     * @internal
+     * Defers sending the motion in @p event to the focused client, so that it can be merged with
+     * the motion that follows until the next refresh of the output under the pointer. Returns
+     * @c false if the motion has to be sent right away, e.g. because the client listens to
+     * relative pointer motion.
+     */
+    bool coalesceMotion(const PointerMotionEvent *event);
+    /**
+     * @internal
+     */
+    bool hasCoalescedMotion() const;
+    /**
+     * @internal
+     * Sends the deferred motion, if any, to the focused client.
+     */
+    void flushCoalescedMotion();
+
 private:
     enum class EdgeBarrierType {
         NormalBarrier,
@@ -196,6 +217,14 @@ private:
     bool m_lastOutputWasPlaceholder = true;
     QPointF m_movementInEdgeBarrier;
     std::chrono::microseconds m_lastMoveTime = std::chrono::microseconds::zero();
+    struct CoalescedMotion
+    {
+        QPointer<SurfaceInterface> surface;
+        QPointF position;
+        std::chrono::microseconds timestamp;
+    };
+    std::optional<CoalescedMotion> m_coalescedMotion;
+    QTimer m_coalescedMotionTimer;
     friend class PositionUpdateBlocker;
     EdgeBarrierType m_lastEdgeBarrierType = EdgeBarrierType::NormalBarrier;
 };
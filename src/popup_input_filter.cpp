@@ -21,8 +21,9 @@ namespace KWin
 
 PopupInputFilter::PopupInputFilter()
     : QObject()
-    , InputEventFilter(InputFilterOrder::Popup)
+    , InputEventFilter(InputFilterOrder::Popup, InputEventType::Pointer | InputEventType::Keyboard | InputEventType::Touch | InputEventType::Tablet)
 {
+    setActive(false);
     connect(workspace(), &Workspace::windowAdded, this, &PopupInputFilter::handleWindowAdded);
     connect(workspace(), &Workspace::windowActivated, this, &PopupInputFilter::handleWindowFocusChanged);
 }
@@ -35,10 +36,12 @@ void PopupInputFilter::handleWindowAdded(Window *window)
     if (window->hasPopupGrab()) {
         // TODO: verify that the Window is allowed as a popup
         m_popupWindows << window;
+        setActive(true);
         focus(window);
 
         connect(window, &Window::closed, this, [this, window]() {
             m_popupWindows.removeOne(window);
+            setActive(!m_popupWindows.isEmpty());
             // Move focus to the parent popup. If that's the last popup, then move focus back to the parent
             if (!m_popupWindows.isEmpty()) {
                 focus(m_popupWindows.constLast());
@@ -175,6 +178,7 @@ void PopupInputFilter::cancelPopups()
         auto c = m_popupWindows.takeLast();
         c->popupDone();
     }
+    setActive(false);
 }
 
 }
@@ -9,6 +9,7 @@
 
 #include "rules.h"
 
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
@@ -84,9 +85,10 @@ Rules::Rules()
 {
 }
 
-#define READ_MATCH_STRING(var, func) \
-    var = settings->var() func;      \
-    var##match = static_cast<StringMatch>(settings->var##match())
+#define READ_MATCH_STRING(var, func)                                \
+    var = settings->var() func;                                     \
+    var##match = static_cast<StringMatch>(settings->var##match()); \
+    var##regexp = compileRegExp(var, var##match)
 
 #define READ_SET_RULE(var) \
     var = settings->var(); \
@@ -96,6 +98,17 @@ Rules::Rules()
     var = func(settings->var());   \
     var##rule = convertForceRule(settings->var##rule())
 
+static QRegularExpression compileRegExp(const QString &pattern, Rules::StringMatch match)
+{
+    if (match != Rules::RegExpMatch) {
+        return QRegularExpression();
+    }
+    // compile it once when loading the rules rather than every time a window is matched
+    QRegularExpression regexp(pattern);
+    regexp.optimize();
+    return regexp;
+}
+
 Rules::Rules(const RuleSettings *settings)
 {
     readFromSettings(settings);
@@ -381,7 +394,7 @@ bool Rules::matchWMClass(const QString &match_class, const QString &match_name)
         QString cwmclass = wmclasscomplete
             ? match_name + ' ' + match_class
             : match_class;
-        if (wmclassmatch == RegExpMatch && !QRegularExpression(wmclass).match(cwmclass).hasMatch()) {
+        if (wmclassmatch == RegExpMatch && !wmclassregexp.match(cwmclass).hasMatch()) {
             return false;
         }
         if (wmclassmatch == ExactMatch && cwmclass != wmclass) {
@@ -397,7 +410,7 @@ bool Rules::matchWMClass(const QString &match_class, const QString &match_name)
 bool Rules::matchRole(const QString &match_role) const
 {
     if (windowrolematch != UnimportantMatch) {
-        if (windowrolematch == RegExpMatch && !QRegularExpression(windowrole).match(match_role).hasMatch()) {
+        if (windowrolematch == RegExpMatch && !windowroleregexp.match(match_role).hasMatch()) {
             return false;
         }
         if (windowrolematch == ExactMatch && match_role != windowrole) {
@@ -413,7 +426,7 @@ bool Rules::matchRole(const QString &match_role) const
 bool Rules::matchTitle(const QString &match_title) const
 {
     if (titlematch != UnimportantMatch) {
-        if (titlematch == RegExpMatch && !QRegularExpression(title).match(match_title).hasMatch()) {
+        if (titlematch == RegExpMatch && !titleregexp.match(match_title).hasMatch()) {
             return false;
         }
         if (titlematch == ExactMatch && title != match_title) {
@@ -435,7 +448,7 @@ bool Rules::matchClientMachine(const QString &match_machine, bool local) const
             return true;
         }
         if (clientmachinematch == RegExpMatch
-            && !QRegularExpression(clientmachine).match(match_machine).hasMatch()) {
+            && !clientmachineregexp.match(match_machine).hasMatch()) {
             return false;
         }
         if (clientmachinematch == ExactMatch
@@ -453,7 +466,7 @@ bool Rules::matchClientMachine(const QString &match_machine, bool local) const
 bool Rules::matchTag(const QString &match_tag) const
 {
     if (tagmatch != UnimportantMatch) {
-        if (tagmatch == RegExpMatch && !QRegularExpression(tag).match(match_tag).hasMatch()) {
+        if (tagmatch == RegExpMatch && !tagregexp.match(match_tag).hasMatch()) {
             return false;
         }
         if (tagmatch == ExactMatch && tag != match_tag) {
@@ -485,7 +498,7 @@ bool Rules::match(const Window *c) const
         return false;
     }
     if (titlematch != UnimportantMatch) { // track title changes to rematch rules
-        QObject::connect(c, &Window::captionNormalChanged, c, &Window::evaluateWindowRules, Qt::UniqueConnection);
+        QObject::connect(c, &Window::captionNormalChanged, c, &Window::evaluateCaptionWindowRules, Qt::UniqueConnection);
     }
     if (!matchTitle(c->captionNormal())) {
         return false;
@@ -967,12 +980,40 @@ void RuleBook::deleteAll()
 {
     qDeleteAll(m_rules);
     m_rules.clear();
+    updateIndex();
+}
+
+void RuleBook::updateIndex()
+{
+    m_rulesByClass.clear();
+    m_rulesByCompleteClass.clear();
+    m_unindexedRules.clear();
+    for (qsizetype i = 0; i < m_rules.size(); ++i) {
+        const Rules *rule = m_rules[i];
+        if (!rule->m_enabled) {
+            continue;
+        }
+        if (rule->wmclassmatch != Rules::ExactMatch) {
+            m_unindexedRules.append(i);
+        } else if (rule->wmclasscomplete) {
+            m_rulesByCompleteClass[rule->wmclass].append(i);
+        } else {
+            m_rulesByClass[rule->wmclass].append(i);
+        }
+    }
 }
 
 WindowRules RuleBook::find(const Window *window) const
 {
+    // only the rules that can match the window class need to be checked, in their original order
+    QList<qsizetype> candidates = m_unindexedRules;
+    candidates += m_rulesByClass.value(window->resourceClass());
+    candidates += m_rulesByCompleteClass.value(window->resourceName() + QLatin1Char(' ') + window->resourceClass());
+    std::sort(candidates.begin(), candidates.end());
+
     QList<Rules *> ret;
-    for (Rules *rule : m_rules) {
+    for (const qsizetype index : std::as_const(candidates)) {
+        Rules *rule = m_rules[index];
         if (rule->match(window)) {
             qCDebug(KWIN_CORE) << "Rule found:" << rule << ":" << window;
             ret.append(rule);
@@ -1009,18 +1050,48 @@ void RuleBook::edit(Window *c, bool whole_app)
 void RuleBook::setConfig(const KSharedConfig::Ptr &config)
 {
     m_book = std::make_unique<RuleBookSettings>(config);
+    m_configDigest.clear();
 }
 
-void RuleBook::load()
+static QByteArray configDigest(const KConfig *config)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    QStringList groups = config->groupList();
+    groups.sort();
+    for (const QString &groupName : std::as_const(groups)) {
+        hash.addData(groupName.toUtf8());
+        hash.addData(QByteArrayView("\0", 1));
+        const QMap<QString, QString> entries = config->group(groupName).entryMap();
+        for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+            hash.addData(it.key().toUtf8());
+            hash.addData(QByteArrayView("=", 1));
+            hash.addData(it.value().toUtf8());
+            hash.addData(QByteArrayView("\0", 1));
+        }
+    }
+    return hash.result();
+}
+
+bool RuleBook::load()
 {
-    deleteAll();
     if (!m_book) {
         m_book = std::make_unique<RuleBookSettings>();
     } else {
         m_book->sharedConfig()->reparseConfiguration();
     }
+
+    // windows keep pointers to the rules, so avoid recreating them if kwinrulesrc is the same
+    const QByteArray digest = configDigest(m_book->sharedConfig().data());
+    if (digest == m_configDigest && !m_updateTimer->isActive()) {
+        return false;
+    }
+
+    deleteAll();
     m_book->load();
     m_rules = m_book->rules();
+    updateIndex();
+    m_configDigest = digest;
+    return true;
 }
 
 void RuleBook::save()
@@ -1058,6 +1129,7 @@ void RuleBook::discardUsed(Window *c, bool withdrawn)
         }
         ++it;
     }
+    updateIndex();
     if (m_book->usrIsSaveNeeded()) {
         requestDiskStorage();
     }
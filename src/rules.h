@@ -9,7 +9,9 @@
 
 #pragma once
 
+#include <QHash>
 #include <QList>
+#include <QRegularExpression>
 
 #include "options.h"
 #include "utils/common.h"
@@ -39,6 +41,7 @@ public:
     void update(Window *, int selection);
     bool contains(const Rules *rule) const;
     void remove(Rules *rule);
+    bool operator==(const WindowRules &other) const = default;
     PlacementPolicy checkPlacement(PlacementPolicy placement) const;
     RectF checkGeometry(RectF rect, bool init = false) const;
     RectF checkGeometrySafe(RectF rect, bool init = false) const;
@@ -220,15 +223,20 @@ private:
     QString description;
     QString wmclass;
     StringMatch wmclassmatch;
+    QRegularExpression wmclassregexp;
     bool wmclasscomplete;
     QString windowrole;
     StringMatch windowrolematch;
+    QRegularExpression windowroleregexp;
     QString title;
     StringMatch titlematch;
+    QRegularExpression titleregexp;
     QString clientmachine;
     StringMatch clientmachinematch;
+    QRegularExpression clientmachineregexp;
     QString tag;
     StringMatch tagmatch;
+    QRegularExpression tagregexp;
     WindowTypes types; // types for matching
     PlacementPolicy placement;
     ForceRule placementrule;
@@ -305,6 +313,9 @@ private:
     bool excludefromcapture;
     SetRule excludefromcapturerule;
     friend QDebug &operator<<(QDebug &stream, const Rules *);
+#ifndef KCMRULES
+    friend class RuleBook;
+#endif
 };
 
 #ifndef KCMRULES
@@ -318,7 +329,11 @@ public:
     void discardUsed(Window *c, bool withdraw);
     void setUpdatesDisabled(bool disable);
     bool areUpdatesDisabled() const;
-    void load();
+    /**
+     * Reloads the rules from kwinrulesrc. Returns @c false if the rules are unchanged since
+     * the last load, in which case the existing rules are kept.
+     */
+    bool load();
     void edit(Window *c, bool whole_app);
     void requestDiskStorage();
     void setConfig(const KSharedConfig::Ptr &config);
@@ -328,10 +343,17 @@ private Q_SLOTS:
 
 private:
     void deleteAll();
+    void updateIndex();
     QTimer *m_updateTimer;
     bool m_updatesDisabled;
     QList<Rules *> m_rules;
+    // the indices of the rules that match an exact window class, with or without the
+    // resource name, and of the enabled rules that can't be looked up by the window class
+    QHash<QString, QList<qsizetype>> m_rulesByClass;
+    QHash<QString, QList<qsizetype>> m_rulesByCompleteClass;
+    QList<qsizetype> m_unindexedRules;
     std::unique_ptr<RuleBookSettings> m_book;
+    QByteArray m_configDigest;
 };
 
 inline bool RuleBook::areUpdatesDisabled() const
@@ -24,7 +24,12 @@ public:
 
     virtual Sprite sprite(uint spriteId) const = 0;
     virtual bool update(uint spriteId, const QImage &image, const Rect &damage) = 0;
-    virtual bool reset(const QList<QImage> &images) = 0;
+    /**
+     * Replaces all sprites with @p images. If @p damage is not empty, it holds the rect of each
+     * image that changed since it was last uploaded. Sprites that keep their place in the atlas
+     * then upload only that rect; all other sprites are uploaded as a whole.
+     */
+    virtual bool reset(const QList<QImage> &images, const QList<Rect> &damage = {}) = 0;
 
 protected:
     Atlas();
@@ -91,8 +91,6 @@ Atlas *DecorationRenderer::atlas() const
 
 void DecorationRenderer::render(ItemRenderer *itemRenderer, const RegionF &region)
 {
-    const RectF geometry = region.boundingRect();
-
     RectF decorationRects[4];
     m_client->window()->layoutDecorationRects(decorationRects[int(DecorationPart::Left)],
                                               decorationRects[int(DecorationPart::Top)],
@@ -116,17 +114,14 @@ void DecorationRenderer::render(ItemRenderer *itemRenderer, const RegionF &regio
         }
     }
 
-    const auto renderPart = [this](QImage &image, const RectF &partRect, const RectF &damageRect) {
-        const RectF dirtyRect = partRect.intersected(damageRect);
-        if (dirtyRect.isEmpty()) {
+    const auto renderPart = [this](QImage &image, const RectF &partRect, const RegionF &damage) {
+        // Repaint only the damaged rects of the part rather than the bounding rect of the whole
+        // damage, which spans all parts if e.g. a button and the opposite border are damaged
+        const RegionF dirtyRegion = damage.intersected(partRect);
+        if (dirtyRegion.isEmpty()) {
             return Rect();
         }
 
-        const Rect nativeDirtyRect = dirtyRect
-            .scaled(image.devicePixelRatio())
-            .roundedOut();
-        const RectF snappedDirtyRect = nativeDirtyRect.scaled(1 / image.devicePixelRatio());
-
         const Rect nativePartRect = partRect
             .scaled(image.devicePixelRatio())
             .rounded();
@@ -135,24 +130,33 @@ void DecorationRenderer::render(ItemRenderer *itemRenderer, const RegionF &regio
         QPainter painter(&image);
         painter.setRenderHint(QPainter::Antialiasing);
         painter.translate(-snappedPartRect.topLeft());
-        painter.setClipRect(snappedDirtyRect);
 
-        // clear existing part
-        painter.save();
-        painter.setCompositionMode(QPainter::CompositionMode_Source);
-        painter.fillRect(snappedDirtyRect, Qt::transparent);
-        painter.restore();
+        Rect repainted;
+        for (const RectF &dirtyRect : dirtyRegion.rects()) {
+            const Rect nativeDirtyRect = dirtyRect
+                .scaled(image.devicePixelRatio())
+                .roundedOut();
+            const RectF snappedDirtyRect = nativeDirtyRect.scaled(1 / image.devicePixelRatio());
+
+            painter.setClipRect(snappedDirtyRect);
 
-        m_client->decoration()->paint(&painter, snappedDirtyRect);
+            // clear existing part
+            painter.save();
+            painter.setCompositionMode(QPainter::CompositionMode_Source);
+            painter.fillRect(snappedDirtyRect, Qt::transparent);
+            painter.restore();
 
-        return nativeDirtyRect
-            .translated(-nativePartRect.topLeft())
-            .intersected(image.rect());
+            m_client->decoration()->paint(&painter, snappedDirtyRect);
+
+            repainted |= nativeDirtyRect.translated(-nativePartRect.topLeft());
+        }
+
+        return repainted.intersected(image.rect());
     };
 
     Rect repainted[4];
     for (int i = 0; i < 4; ++i) {
-        repainted[i] = renderPart(m_images[i], decorationRects[i], geometry);
+        repainted[i] = renderPart(m_images[i], decorationRects[i], region);
     }
 
     if (!m_atlas) {
@@ -161,7 +165,8 @@ void DecorationRenderer::render(ItemRenderer *itemRenderer, const RegionF &regio
     }
 
     if (resized) {
-        m_atlas->reset({m_images[0], m_images[1], m_images[2], m_images[3]});
+        m_atlas->reset({m_images[0], m_images[1], m_images[2], m_images[3]},
+                       {repainted[0], repainted[1], repainted[2], repainted[3]});
     } else {
         for (int i = 0; i < 4; ++i) {
             if (!repainted[i].isEmpty()) {
@@ -174,6 +179,8 @@ void DecorationRenderer::render(ItemRenderer *itemRenderer, const RegionF &regio
 void DecorationRenderer::releaseResources()
 {
     m_atlas.reset();
+    // the atlas is created again only when the decoration is rendered
+    invalidate();
 }
 
 DecorationItem::DecorationItem(KDecoration3::Decoration *decoration, Window *window, Item *parent)
@@ -42,7 +42,10 @@ ItemEffect &ItemEffect::operator=(ItemEffect &&move)
     return *this;
 }
 
+static quint64 s_lastQuadsSerial = 0;
+
 Item::Item(Item *parent)
+    : m_quadsSerial(++s_lastQuadsSerial)
 {
     setParentItem(parent);
 }
@@ -545,6 +548,12 @@ WindowQuadList Item::buildQuads() const
 void Item::discardQuads()
 {
     m_quads.reset();
+    m_quadsSerial = ++s_lastQuadsSerial;
+}
+
+quint64 Item::quadsSerial() const
+{
+    return m_quadsSerial;
 }
 
 WindowQuadList Item::quads() const
@@ -561,6 +570,11 @@ bool Item::hasRepaints(RenderView *view) const
     return it != m_deviceRepaints.end() && !it->isEmpty();
 }
 
+Region Item::deviceRepaints(RenderView *view) const
+{
+    return m_deviceRepaints.value(view);
+}
+
 Region Item::takeDeviceRepaints(RenderView *view)
 {
     auto &repaints = m_deviceRepaints[view];
@@ -724,7 +738,7 @@ void Item::framePainted(RenderView *view, LogicalOutput *output, OutputFrame *fr
     // things like screncasts or thumbnails
     handleFramePainted(output, frame, timestamp);
     for (const auto child : std::as_const(m_childItems)) {
-        if (child->explicitVisible() && workspace()->outputAt(child->mapToScene(child->boundingRect()).center()) == output) {
+        if (child->explicitVisible() && workspace()->outputAt(child->mapToScene(child->boundingRect()).center()) == output && !child->isFramePaintedThrottled(output, timestamp)) {
             child->framePainted(view, output, frame, timestamp);
         }
     }
@@ -741,6 +755,11 @@ void Item::handleFramePainted(LogicalOutput *output, OutputFrame *frame, std::ch
 {
 }
 
+bool Item::isFramePaintedThrottled(LogicalOutput *output, std::chrono::milliseconds timestamp)
+{
+    return false;
+}
+
 void Item::releaseResources()
 {
 }
@@ -161,10 +161,19 @@ public:
     void scheduleRepaint(RenderView *delegate, const RegionF &region);
     void scheduleFrame();
     bool hasRepaints(RenderView *view) const;
+    /**
+     * Returns the repaints of this item that haven't been taken for @p delegate yet.
+     */
+    Region deviceRepaints(RenderView *delegate) const;
     Region takeDeviceRepaints(RenderView *delegate);
     void resetRepaints(RenderView *delegate);
 
     WindowQuadList quads() const;
+    /**
+     * Returns a serial number that changes every time the quads of this item are discarded.
+     * The serial is unique across all items, so it can be used to detect stale cached geometry.
+     */
+    quint64 quadsSerial() const;
     virtual void preprocess();
     const std::shared_ptr<ColorDescription> &colorDescription() const;
     RenderingIntent renderingIntent() const;
@@ -204,6 +213,11 @@ Q_SIGNALS:
 protected:
     virtual WindowQuadList buildQuads() const;
     virtual void handleFramePainted(LogicalOutput *output, OutputFrame *frame, std::chrono::milliseconds timestamp);
+    /**
+     * Returns @c true if the frame painted on @p output at @p timestamp should not be reported
+     * to this item and its children, e.g. because nothing of them has been seen.
+     */
+    virtual bool isFramePaintedThrottled(LogicalOutput *output, std::chrono::milliseconds timestamp);
     virtual void releaseResources();
     void discardQuads();
     void setColorDescription(const std::shared_ptr<ColorDescription> &description);
@@ -243,6 +257,7 @@ private:
     bool m_effectiveVisible = true;
     QMap<RenderView *, Region> m_deviceRepaints;
     mutable std::optional<WindowQuadList> m_quads;
+    quint64 m_quadsSerial;
     mutable std::optional<QList<Item *>> m_sortedChildItems;
     std::shared_ptr<ColorDescription> m_colorDescription = ColorDescription::sRGB;
     RenderingIntent m_renderingIntent = RenderingIntent::Perceptual;
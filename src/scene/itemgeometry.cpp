@@ -121,7 +121,10 @@ WindowQuadList WindowQuadList::makeGrid(int maxQuadSize) const
         bottom = std::max(bottom, quad.bottom());
     }
 
+    // the quads usually tile the bounding rectangle, so reserve for one sub-quad per grid cell
+    // plus the cells split by the quad edges, rather than growing the list while appending
     WindowQuadList ret;
+    ret.reserve((qCeil((right - left) / maxQuadSize) + 1) * (qCeil((bottom - top) / maxQuadSize) + 1) + size());
 
     for (const WindowQuad &quad : std::as_const(*this)) {
         const double quadLeft = quad.left();
@@ -179,6 +182,7 @@ WindowQuadList WindowQuadList::makeRegularGrid(int xSubdivisions, int ySubdivisi
     double yIncrement = (bottom - top) / ySubdivisions;
 
     WindowQuadList ret;
+    ret.reserve((xSubdivisions + 1) * (ySubdivisions + 1) + size());
 
     for (const WindowQuad &quad : *this) {
         const double quadLeft = quad.left();
@@ -248,6 +252,65 @@ void RenderGeometry::appendWindowQuad(const WindowQuad &quad, qreal deviceScale)
     appendWindowVertex(quad[2], deviceScale);
 }
 
+template<RenderGeometry::VertexSnappingMode snappingMode>
+static void writeQuads(GLVertex2D *out, const WindowQuad *quads, qsizetype count, double deviceScale, const QVector2D &coeff, const QVector2D &offset)
+{
+    for (qsizetype i = 0; i < count; ++i) {
+        const WindowQuad &quad = quads[i];
+
+        // the snapping mode is a template parameter, so this loop has no branches and can
+        // be vectorized by the compiler
+        GLVertex2D corners[4];
+        for (int j = 0; j < 4; ++j) {
+            double x = quad[j].x() * deviceScale;
+            double y = quad[j].y() * deviceScale;
+            if constexpr (snappingMode == RenderGeometry::VertexSnappingMode::Round) {
+                x = std::round(x);
+                y = std::round(y);
+            }
+            corners[j].position = QVector2D(x, y);
+            corners[j].texcoord = QVector2D(quad[j].u(), quad[j].v()) * coeff + offset;
+        }
+
+        // see appendWindowQuad() for the vertex order
+        out[0] = corners[0];
+        out[1] = corners[3];
+        out[2] = corners[1];
+        out[3] = corners[1];
+        out[4] = corners[3];
+        out[5] = corners[2];
+        out += 6;
+    }
+}
+
+static void writeQuads(GLVertex2D *out, const WindowQuadList &quads, qreal deviceScale, RenderGeometry::VertexSnappingMode snappingMode,
+                       const QVector2D &coeff, const QVector2D &offset)
+{
+    switch (snappingMode) {
+    case RenderGeometry::VertexSnappingMode::None:
+        writeQuads<RenderGeometry::VertexSnappingMode::None>(out, quads.constData(), quads.size(), deviceScale, coeff, offset);
+        break;
+    case RenderGeometry::VertexSnappingMode::Round:
+        writeQuads<RenderGeometry::VertexSnappingMode::Round>(out, quads.constData(), quads.size(), deviceScale, coeff, offset);
+        break;
+    }
+}
+
+void RenderGeometry::appendWindowQuads(const WindowQuadList &quads, qreal deviceScale)
+{
+    const qsizetype first = size();
+    resize(first + quads.size() * 6);
+    writeQuads(data() + first, quads, deviceScale, m_vertexSnappingMode, QVector2D(1, 1), QVector2D(0, 0));
+}
+
+void RenderGeometry::writeWindowQuads(std::span<GLVertex2D> destination, const WindowQuadList &quads, qreal deviceScale,
+                                      VertexSnappingMode snappingMode, const QMatrix4x4 &textureMatrix)
+{
+    Q_ASSERT(qsizetype(destination.size()) >= quads.size() * 6);
+    writeQuads(destination.data(), quads, deviceScale, snappingMode,
+               QVector2D(textureMatrix(0, 0), textureMatrix(1, 1)), QVector2D(textureMatrix(0, 3), textureMatrix(1, 3)));
+}
+
 void RenderGeometry::appendSubQuad(const WindowQuad &quad, const RectF &subquad, qreal deviceScale)
 {
     std::array<GLVertex2D, 4> vertices;
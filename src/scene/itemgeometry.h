@@ -48,8 +48,9 @@ public:
 private:
     friend class WindowQuad;
     friend class WindowQuadList;
-    double px, py; // position
-    double tx, ty; // texture coords
+    // stored as floats, like the vertices they end up in, because grids of quads can get huge
+    float px, py; // position
+    float tx, ty; // texture coords
 };
 
 /**
@@ -171,6 +172,21 @@ public:
      *                    coordinates.
      */
     void appendWindowQuad(const WindowQuad &quad, qreal deviceScale);
+    /**
+     * Append all quads in @a quads as pairs of triangles.
+     *
+     * This produces the same vertices as calling appendWindowQuad() for every quad, but the
+     * snapping mode is only looked at once and the vertices are written in bulk.
+     */
+    void appendWindowQuads(const WindowQuadList &quads, qreal deviceScale);
+    /**
+     * Write the vertices of @a quads directly into @a destination, e.g. a mapped vertex buffer,
+     * applying @a textureMatrix to the texture coordinates like postProcessTextureCoordinates().
+     *
+     * @a destination needs room for six vertices per quad.
+     */
+    static void writeWindowQuads(std::span<GLVertex2D> destination, const WindowQuadList &quads, qreal deviceScale,
+                                 VertexSnappingMode snappingMode, const QMatrix4x4 &textureMatrix);
     /**
      * Append a sub-quad of a WindowQuad as two triangles.
      *
@@ -212,35 +228,35 @@ inline WindowVertex::WindowVertex()
 }
 
 inline WindowVertex::WindowVertex(double _x, double _y, double _tx, double _ty)
-    : px(_x)
-    , py(_y)
-    , tx(_tx)
-    , ty(_ty)
+    : px(float(_x))
+    , py(float(_y))
+    , tx(float(_tx))
+    , ty(float(_ty))
 {
 }
 
 inline WindowVertex::WindowVertex(const QPointF &position, const QPointF &texturePosition)
-    : px(position.x())
-    , py(position.y())
-    , tx(texturePosition.x())
-    , ty(texturePosition.y())
+    : px(float(position.x()))
+    , py(float(position.y()))
+    , tx(float(texturePosition.x()))
+    , ty(float(texturePosition.y()))
 {
 }
 
 inline void WindowVertex::move(double x, double y)
 {
-    px = x;
-    py = y;
+    px = float(x);
+    py = float(y);
 }
 
 inline void WindowVertex::setX(double x)
 {
-    px = x;
+    px = float(x);
 }
 
 inline void WindowVertex::setY(double y)
 {
-    py = y;
+    py = float(y);
 }
 
 inline WindowQuad::WindowQuad()
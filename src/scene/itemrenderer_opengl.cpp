@@ -23,6 +23,10 @@
 #include "scene/workspacescene.h"
 #include "utils/common.h"
 
+#include <QtConcurrentMap>
+
+#include <limits>
+
 namespace KWin
 {
 
@@ -81,6 +85,13 @@ void ItemRendererOpenGL::endFrame()
     GLVertexBuffer::streamingBuffer()->endOfFrame();
     GLFramebuffer::popFramebuffer();
 
+    // Drop the geometry of items that haven't been painted for a while, e.g. destroyed or hidden items.
+    static constexpr quint64 maxGeometryCacheAge = 120;
+    std::erase_if(m_geometryCache, [this](const auto &entry) {
+        return m_frameCounter - entry.second.lastUsedFrame > maxGeometryCacheAge;
+    });
+    m_frameCounter++;
+
     if (m_eglDisplay) {
         EGLNativeFence fence(m_eglDisplay);
         if (fence.isValid()) {
@@ -112,45 +123,252 @@ void ItemRendererOpenGL::setBlendEnabled(bool enabled)
     m_blendingEnabled = enabled;
 }
 
-static RenderGeometry clipQuads(const Item *item, const ItemRendererOpenGL::RenderContext *context)
+/**
+ * Returns @c true if the buffer of @p item is drawn at less than half of its size, e.g. as a
+ * thumbnail. Sampling it through a mipmapped copy then reads far less memory and doesn't alias.
+ */
+static bool isDrawnDownscaled(const SurfaceItem *item, const ItemRendererOpenGL::RenderContext *context)
 {
-    const WindowQuadList quads = item->quads();
+    const QSizeF bufferSize = item->bufferSourceBox().size();
+    if (bufferSize.isEmpty()) {
+        return false;
+    }
+    const QMatrix4x4 &matrix = context->transformStack.top();
+    const qreal xScale = QVector2D(matrix(0, 0), matrix(1, 0)).length();
+    const qreal yScale = QVector2D(matrix(0, 1), matrix(1, 1)).length();
+    const QSizeF deviceSize(item->size().width() * context->renderTargetScale * xScale,
+                            item->size().height() * context->renderTargetScale * yScale);
+    // compare the areas, the buffer may be rotated
+    return deviceSize.width() * deviceSize.height() * 4 < bufferSize.width() * bufferSize.height();
+}
 
+static RenderGeometry clipQuads(const WindowQuadList &quads, const ItemRendererOpenGL::RenderContext *context, const QPointF &itemToDeviceTranslation, bool softwareClipped)
+{
     const qreal scale = context->renderTargetScale;
-    const QPointF itemToDeviceTranslation = context->transformStack.top().map(QPointF(0., 0.))
-                                          - context->viewportOrigin
-                                          + context->renderOffset;
 
     RenderGeometry geometry;
+    if (!softwareClipped) {
+        geometry.appendWindowQuads(quads, scale);
+        return geometry;
+    }
+
     geometry.reserve(quads.count() * 6);
 
     // split all quads in bounding rect with the actual rects in the region
     for (const WindowQuad &quad : std::as_const(quads)) {
-        if (context->deviceClip != Region::infinite() && !context->hardwareClipping) {
-            // Scale to device coordinates, rounding as needed.
-            const RectF deviceBounds = snapToPixelGridF(scaledRect(quad.bounds(), scale));
-
-            for (const Rect &deviceClipRect : context->deviceClip.rects()) {
-                const RectF relativeDeviceClipRect = RectF(deviceClipRect).translated(-itemToDeviceTranslation);
-                const RectF intersected = relativeDeviceClipRect.intersected(deviceBounds);
-                if (intersected.isValid()) {
-                    if (deviceBounds == intersected) {
-                        // case 1: completely contains, include and do not check other rects
-                        geometry.appendWindowQuad(quad, scale);
-                        break;
-                    }
-                    // case 2: intersection
-                    geometry.appendSubQuad(quad, intersected, scale);
+        // Scale to device coordinates, rounding as needed.
+        const RectF deviceBounds = snapToPixelGridF(scaledRect(quad.bounds(), scale));
+
+        for (const Rect &deviceClipRect : context->deviceClip.rects()) {
+            const RectF relativeDeviceClipRect = RectF(deviceClipRect).translated(-itemToDeviceTranslation);
+            const RectF intersected = relativeDeviceClipRect.intersected(deviceBounds);
+            if (intersected.isValid()) {
+                if (deviceBounds == intersected) {
+                    // case 1: completely contains, include and do not check other rects
+                    geometry.appendWindowQuad(quad, scale);
+                    break;
                 }
+                // case 2: intersection
+                geometry.appendSubQuad(quad, intersected, scale);
             }
-        } else {
-            geometry.appendWindowQuad(quad, scale);
         }
     }
 
     return geometry;
 }
 
+/**
+ * Splits the quads of an item with rounded corners into the parts that lie in the @a interior,
+ * which don't need the rounded corners shader, and the rest.
+ */
+static std::pair<WindowQuadList, WindowQuadList> splitCornerQuads(const WindowQuadList &quads, const RegionF &interior)
+{
+    WindowQuadList inside;
+    WindowQuadList outside;
+    for (const WindowQuad &quad : quads) {
+        // quads that were deformed by effects can't be split along the axes
+        const bool rectangular = quad[0].y() == quad[1].y() && quad[2].y() == quad[3].y()
+            && quad[0].x() == quad[3].x() && quad[1].x() == quad[2].x();
+        const RectF bounds = quad.bounds();
+        const RegionF contained = rectangular ? interior.intersected(bounds) : RegionF();
+        if (contained.isEmpty()) {
+            outside.append(quad);
+            continue;
+        }
+        const RegionF remainder = RegionF(bounds).subtracted(contained);
+        if (remainder.isEmpty()) {
+            inside.append(quad);
+            continue;
+        }
+        for (const RectF &rect : contained.rects()) {
+            inside.append(quad.makeSubQuad(rect.left(), rect.top(), rect.right(), rect.bottom()));
+        }
+        for (const RectF &rect : remainder.rects()) {
+            outside.append(quad.makeSubQuad(rect.left(), rect.top(), rect.right(), rect.bottom()));
+        }
+    }
+    return {inside, outside};
+}
+
+static bool isSoftwareClipped(const ItemRendererOpenGL::RenderContext *context)
+{
+    return context->deviceClip != Region::infinite() && !context->hardwareClipping;
+}
+
+/**
+ * Returns the part of the @a scissorRegion that the given render nodes can touch. Every scissor
+ * rect costs a draw call, so the rects that are far away from the geometry are dropped.
+ */
+static Region clipScissorRegion(const Region &scissorRegion, std::span<const ItemRendererOpenGL::RenderNode> nodes, const QMatrix4x4 &projectionMatrix)
+{
+    if (scissorRegion.rects().size() < 2) {
+        return scissorRegion;
+    }
+
+    const QSize framebufferSize = GLFramebuffer::currentFramebuffer()->size();
+    RectF bounds;
+    for (const ItemRendererOpenGL::RenderNode &node : nodes) {
+        if (node.geometry.isEmpty()) {
+            continue;
+        }
+
+        float left = node.geometry.first().position.x();
+        float top = node.geometry.first().position.y();
+        float right = left;
+        float bottom = top;
+        for (const GLVertex2D &vertex : node.geometry) {
+            left = std::min(left, vertex.position.x());
+            top = std::min(top, vertex.position.y());
+            right = std::max(right, vertex.position.x());
+            bottom = std::max(bottom, vertex.position.y());
+        }
+
+        const QMatrix4x4 matrix = projectionMatrix * node.transformMatrix;
+        for (const QPointF &corner : {QPointF(left, top), QPointF(right, top), QPointF(right, bottom), QPointF(left, bottom)}) {
+            const QVector4D clip = matrix * QVector4D(corner.x(), corner.y(), 0, 1);
+            // give up if the geometry crosses the camera plane, the projected bounds are meaningless then
+            if (clip.w() <= 0) {
+                return scissorRegion;
+            }
+            // the scissor rects have a top-left origin
+            const QPointF point((clip.x() / clip.w() + 1) * 0.5 * framebufferSize.width(),
+                                (1 - clip.y() / clip.w()) * 0.5 * framebufferSize.height());
+            bounds = bounds.isEmpty() ? RectF(point, point + QPointF(1, 1)) : bounds.united(RectF(point, point + QPointF(1, 1)));
+        }
+    }
+
+    return scissorRegion & bounds.roundedOut().adjusted(-1, -1, 1, 1);
+}
+
+static QPointF computeItemToDeviceTranslation(const ItemRendererOpenGL::RenderContext *context)
+{
+    return context->transformStack.top().map(QPointF(0., 0.))
+        - context->viewportOrigin
+        + context->renderOffset;
+}
+
+void ItemRendererOpenGL::generateGeometry(RenderContext *context)
+{
+    struct GeometryJob
+    {
+        RenderNode *node;
+        CachedGeometry *cached;
+        WindowQuadList quads;
+        WindowQuadList cornerQuads;
+    };
+
+    const bool softwareClipped = isSoftwareClipped(context);
+
+    // Quads are built and the geometry cache is accessed only on the main thread.
+    QList<GeometryJob> jobs;
+    qsizetype quadCount = 0;
+    for (RenderNode &node : context->renderNodes) {
+        CachedGeometry &cached = m_geometryCache[node.item];
+        cached.lastUsedFrame = m_frameCounter;
+
+        // The translation and the clip region only matter if the quads are clipped on the CPU.
+        const bool valid = cached.quadsSerial == node.item->quadsSerial()
+            && cached.scale == context->renderTargetScale
+            && cached.softwareClipped == softwareClipped
+            && cached.interior == node.interior
+            && (!softwareClipped || (cached.itemToDeviceTranslation == node.deviceTranslation && cached.deviceClip == context->deviceClip));
+        if (valid) {
+            node.geometry = cached.geometry;
+            node.cornerGeometry = cached.cornerGeometry;
+            continue;
+        }
+
+        cached.quadsSerial = node.item->quadsSerial();
+        cached.scale = context->renderTargetScale;
+        cached.softwareClipped = softwareClipped;
+        cached.interior = node.interior;
+        if (softwareClipped) {
+            cached.itemToDeviceTranslation = node.deviceTranslation;
+            cached.deviceClip = context->deviceClip;
+        } else {
+            cached.itemToDeviceTranslation = QPointF();
+            cached.deviceClip = Region();
+        }
+
+        WindowQuadList quads = node.item->quads();
+        WindowQuadList cornerQuads;
+        if (!node.interior.isEmpty()) {
+            std::tie(quads, cornerQuads) = splitCornerQuads(quads, node.interior);
+        }
+        quadCount += quads.size() + cornerQuads.size();
+        jobs.append(GeometryJob{
+            .node = &node,
+            .cached = &cached,
+            .quads = quads,
+            .cornerQuads = cornerQuads,
+        });
+    }
+
+    // Clipping quads is a pure function of the quads and the render context, so it can be spread
+    // across worker threads if there is enough work to make it worthwhile.
+    const auto clip = [context, softwareClipped](GeometryJob &job) {
+        job.node->geometry = clipQuads(job.quads, context, job.node->deviceTranslation, softwareClipped);
+        job.node->cornerGeometry = clipQuads(job.cornerQuads, context, job.node->deviceTranslation, softwareClipped);
+    };
+    static constexpr qsizetype parallelQuadThreshold = 512;
+    if (jobs.size() > 1 && quadCount >= parallelQuadThreshold) {
+        QtConcurrent::blockingMap(jobs, clip);
+    } else {
+        for (GeometryJob &job : jobs) {
+            clip(job);
+        }
+    }
+
+    for (const GeometryJob &job : std::as_const(jobs)) {
+        job.cached->geometry = job.node->geometry;
+        job.cached->cornerGeometry = job.node->cornerGeometry;
+    }
+
+    // the rounded corners of split items are drawn by a separate node right after the interior
+    for (qsizetype i = 0; i < context->renderNodes.size(); ++i) {
+        RenderNode &node = context->renderNodes[i];
+        if (node.cornerGeometry.isEmpty()) {
+            continue;
+        }
+        RenderNode corners = node;
+        corners.traits |= ShaderTrait::RoundedCorners;
+        corners.hasAlpha = true;
+        corners.geometry = std::exchange(node.cornerGeometry, RenderGeometry());
+        corners.cornerGeometry = RenderGeometry();
+        context->renderNodes.insert(++i, std::move(corners));
+    }
+
+    context->renderNodes.removeIf([](const RenderNode &node) {
+        return node.geometry.isEmpty();
+    });
+
+    for (RenderNode &node : context->renderNodes) {
+        if (node.textureMatrix) {
+            node.geometry.postProcessTextureCoordinates(*node.textureMatrix);
+        }
+    }
+}
+
 void ItemRendererOpenGL::createRenderNode(Item *item, RenderContext *context, const std::function<bool(Item *)> &filter, const std::function<bool(Item *)> &holeFilter)
 {
     bool hole = false;
@@ -177,6 +395,16 @@ void ItemRendererOpenGL::createRenderNode(Item *item, RenderContext *context, co
     }
     context->transformStack.push(context->transformStack.top() * matrix);
 
+    // If the quads are clipped on the CPU, the item is only translated. Skip the item and its
+    // children if they are entirely outside of the clip region, e.g. covered by opaque windows.
+    if (isSoftwareClipped(context)) {
+        const RectF deviceBounds = scaledRect(item->boundingRect(), scale).translated(computeItemToDeviceTranslation(context));
+        if (!context->deviceClip.intersects(deviceBounds.roundedOut())) {
+            context->transformStack.pop();
+            return;
+        }
+    }
+
     context->opacityStack.push(context->opacityStack.top() * item->opacity());
 
     for (Item *childItem : sortedChildItems) {
@@ -205,124 +433,153 @@ void ItemRendererOpenGL::createRenderNode(Item *item, RenderContext *context, co
 
     item->preprocess();
 
-    RenderGeometry geometry = clipQuads(item, context);
+    // The geometry of the render nodes is generated after all items have been visited, see
+    // ItemRendererOpenGL::generateGeometry().
+    const QPointF deviceTranslation = computeItemToDeviceTranslation(context);
 
     if (auto shadowItem = qobject_cast<ShadowItem *>(item)) {
-        if (!geometry.isEmpty()) {
-            const auto ninePatch = static_cast<NinePatchOpenGL *>(shadowItem->ninePatch());
-            if (ninePatch->texture()) {
-                RenderNode &renderNode = context->renderNodes.emplace_back(RenderNode{
-                    .traits = ShaderTrait::MapTexture,
-                    .textures = {ninePatch->texture()},
-                    .geometry = geometry,
-                    .transformMatrix = context->transformStack.top(),
-                    .opacity = context->opacityStack.top(),
-                    .hasAlpha = true,
-                    .colorDescription = item->colorDescription(),
-                    .renderingIntent = item->renderingIntent(),
-                    .bufferReleasePoint = nullptr,
-                    .paintHole = hole,
-                });
-                renderNode.geometry.postProcessTextureCoordinates(ninePatch->texture()->matrix(UnnormalizedCoordinates));
-            }
+        const auto ninePatch = static_cast<NinePatchOpenGL *>(shadowItem->ninePatch());
+        if (ninePatch->texture()) {
+            context->renderNodes.append(RenderNode{
+                .traits = ShaderTrait::MapTexture,
+                .textures = {ninePatch->texture()},
+                .transformMatrix = context->transformStack.top(),
+                .opacity = context->opacityStack.top(),
+                .hasAlpha = true,
+                .colorDescription = item->colorDescription(),
+                .renderingIntent = item->renderingIntent(),
+                .bufferReleasePoint = nullptr,
+                .paintHole = hole,
+                .item = item,
+                .deviceTranslation = deviceTranslation,
+                .textureMatrix = ninePatch->texture()->matrix(UnnormalizedCoordinates),
+            });
         }
     } else if (auto decorationItem = qobject_cast<DecorationItem *>(item)) {
-        if (!geometry.isEmpty()) {
-            auto atlas = static_cast<const AtlasOpenGL *>(decorationItem->atlas());
-            if (atlas && atlas->texture()) {
-                RenderNode &renderNode = context->renderNodes.emplace_back(RenderNode{
-                    .traits = ShaderTrait::MapTexture,
-                    .textures = {atlas->texture()},
-                    .geometry = geometry,
-                    .transformMatrix = context->transformStack.top(),
-                    .opacity = context->opacityStack.top(),
-                    .hasAlpha = true,
-                    .colorDescription = item->colorDescription(),
-                    .renderingIntent = item->renderingIntent(),
-                    .bufferReleasePoint = nullptr,
-                    .paintHole = hole,
-                });
-                renderNode.geometry.postProcessTextureCoordinates(atlas->texture()->matrix(UnnormalizedCoordinates));
-            }
+        auto atlas = static_cast<const AtlasOpenGL *>(decorationItem->atlas());
+        if (atlas && atlas->texture()) {
+            context->renderNodes.append(RenderNode{
+                .traits = ShaderTrait::MapTexture,
+                .textures = {atlas->texture()},
+                .transformMatrix = context->transformStack.top(),
+                .opacity = context->opacityStack.top(),
+                .hasAlpha = true,
+                .colorDescription = item->colorDescription(),
+                .renderingIntent = item->renderingIntent(),
+                .bufferReleasePoint = nullptr,
+                .paintHole = hole,
+                .item = item,
+                .deviceTranslation = deviceTranslation,
+                .textureMatrix = atlas->texture()->matrix(UnnormalizedCoordinates),
+            });
         }
     } else if (auto surfaceItem = qobject_cast<SurfaceItem *>(item)) {
-        auto texture = static_cast<TextureOpenGL *>(surfaceItem->texture());
-        if (texture && !texture->planes().isEmpty()) {
-            if (!geometry.isEmpty()) {
-                RenderNode &renderNode = context->renderNodes.emplace_back(RenderNode{
-                    .traits = texture->planes().count() == 1 ? ShaderTrait::MapTexture : ShaderTrait::MapMultiPlaneTexture,
-                    .textures = texture->planes(),
-                    .geometry = geometry,
-                    .transformMatrix = context->transformStack.top(),
-                    .opacity = context->opacityStack.top(),
-                    .hasAlpha = surfaceItem->hasAlphaChannel(),
-                    .colorDescription = item->colorDescription(),
-                    .renderingIntent = item->renderingIntent(),
-                    .bufferReleasePoint = surfaceItem->bufferReleasePoint(),
-                    .paintHole = hole,
-                    .hasFloatingPointColor = texture->isFloatingPoint(),
-                });
-                renderNode.geometry.postProcessTextureCoordinates(texture->planes().at(0)->matrix(UnnormalizedCoordinates));
-                if (surfaceItem->colorDescription()->yuvCoefficients() != YUVMatrixCoefficients::Identity) {
-                    renderNode.traits |= ShaderTrait::YuvConversion;
-                }
-
-                if (!context->cornerStack.isEmpty()) {
-                    const auto &top = context->cornerStack.top();
-
+        const auto clipCorners = [context](RenderNode &renderNode) {
+            if (!context->cornerStack.isEmpty()) {
+                const auto &top = context->cornerStack.top();
+
+                renderNode.box = QVector4D(top.box.x() + top.box.width() * 0.5,
+                                           top.box.y() + top.box.height() * 0.5,
+                                           top.box.width() * 0.5,
+                                           top.box.height() * 0.5),
+                renderNode.borderRadius = top.radius.toVector();
+                // only the corners need the shader, the rest is drawn like any other surface. The
+                // interior stays a pixel away from the edges of the box, which the shader anti-aliases
+                renderNode.interior = top.radius.clip(RegionF(top.box.adjusted(1, 1, -1, -1)), top.box).scaled(1 / context->renderTargetScale);
+                if (renderNode.interior.isEmpty()) {
                     renderNode.traits |= ShaderTrait::RoundedCorners;
                     renderNode.hasAlpha = true;
-                    renderNode.box = QVector4D(top.box.x() + top.box.width() * 0.5,
-                                               top.box.y() + top.box.height() * 0.5,
-                                               top.box.width() * 0.5,
-                                               top.box.height() * 0.5),
-                    renderNode.borderRadius = top.radius.toVector();
                 }
             }
-        }
-    } else if (auto imageItem = qobject_cast<ImageItem *>(item)) {
-        if (!geometry.isEmpty()) {
-            auto texture = static_cast<TextureOpenGL *>(imageItem->texture());
-            if (texture && !texture->planes().isEmpty()) {
-                RenderNode &renderNode = context->renderNodes.emplace_back(RenderNode{
-                    .traits = ShaderTrait::MapTexture,
-                    .textures = texture->planes(),
-                    .geometry = geometry,
-                    .transformMatrix = context->transformStack.top(),
-                    .opacity = context->opacityStack.top(),
-                    .hasAlpha = imageItem->image().hasAlphaChannel(),
-                    .colorDescription = item->colorDescription(),
-                    .renderingIntent = item->renderingIntent(),
-                    .bufferReleasePoint = nullptr,
-                    .paintHole = hole,
-                });
-                renderNode.geometry.postProcessTextureCoordinates(texture->planes()[0]->matrix(UnnormalizedCoordinates));
+        };
+
+        const GraphicsBuffer *buffer = surfaceItem->buffer();
+        auto texture = static_cast<TextureOpenGL *>(surfaceItem->texture());
+        if (const SinglePixelAttributes *pixel = buffer ? buffer->singlePixelAttributes() : nullptr) {
+            // a single pixel buffer is a solid color, there is no need to sample a texture for it
+            constexpr float max = std::numeric_limits<uint32_t>::max();
+            RenderNode &renderNode = context->renderNodes.emplace_back(RenderNode{
+                .traits = ShaderTrait::UniformColor,
+                .transformMatrix = context->transformStack.top(),
+                .opacity = context->opacityStack.top(),
+                .hasAlpha = surfaceItem->hasAlphaChannel(),
+                .colorDescription = item->colorDescription(),
+                .renderingIntent = item->renderingIntent(),
+                .bufferReleasePoint = surfaceItem->bufferReleasePoint(),
+                .paintHole = hole,
+                .item = item,
+                .deviceTranslation = deviceTranslation,
+                .color = QVector4D(pixel->red / max, pixel->green / max, pixel->blue / max, pixel->alpha / max),
+            });
+            clipCorners(renderNode);
+        } else if (texture && !texture->planes().isEmpty()) {
+            QVarLengthArray<GLTexture *, 4> planes = texture->planes();
+            if (isDrawnDownscaled(surfaceItem, context)) {
+                if (GLTexture *mipmapped = texture->mipmappedTexture()) {
+                    planes = {mipmapped};
+                }
             }
+            RenderNode &renderNode = context->renderNodes.emplace_back(RenderNode{
+                .traits = planes.count() == 1 ? ShaderTrait::MapTexture : ShaderTrait::MapMultiPlaneTexture,
+                .textures = planes,
+                .transformMatrix = context->transformStack.top(),
+                .opacity = context->opacityStack.top(),
+                .hasAlpha = surfaceItem->hasAlphaChannel(),
+                .colorDescription = item->colorDescription(),
+                .renderingIntent = item->renderingIntent(),
+                .bufferReleasePoint = surfaceItem->bufferReleasePoint(),
+                .paintHole = hole,
+                .hasFloatingPointColor = texture->isFloatingPoint(),
+                .item = item,
+                .deviceTranslation = deviceTranslation,
+                .textureMatrix = planes.at(0)->matrix(UnnormalizedCoordinates),
+            });
+            if (surfaceItem->colorDescription()->yuvCoefficients() != YUVMatrixCoefficients::Identity) {
+                renderNode.traits |= ShaderTrait::YuvConversion;
+            }
+            clipCorners(renderNode);
         }
-    } else if (auto borderItem = qobject_cast<OutlinedBorderItem *>(item)) {
-        if (!geometry.isEmpty()) {
-            const BorderOutline outline = borderItem->outline();
-            const int thickness = std::round(outline.thickness() * context->renderTargetScale);
-            const RectF outerRect = snapToPixelGridF(scaledRect(borderItem->rect(), context->renderTargetScale));
-            const RectF innerRect = outerRect.adjusted(thickness, thickness, -thickness, -thickness);
+    } else if (auto imageItem = qobject_cast<ImageItem *>(item)) {
+        auto texture = static_cast<TextureOpenGL *>(imageItem->texture());
+        if (texture && !texture->planes().isEmpty()) {
             context->renderNodes.append(RenderNode{
-                .traits = ShaderTrait::Border,
-                .geometry = geometry,
+                .traits = ShaderTrait::MapTexture,
+                .textures = texture->planes(),
                 .transformMatrix = context->transformStack.top(),
                 .opacity = context->opacityStack.top(),
-                .hasAlpha = true,
-                .colorDescription = borderItem->colorDescription(),
-                .renderingIntent = borderItem->renderingIntent(),
-                .box = QVector4D(innerRect.x() + innerRect.width() * 0.5,
-                                 innerRect.y() + innerRect.height() * 0.5,
-                                 innerRect.width() * 0.5,
-                                 innerRect.height() * 0.5),
-                .borderRadius = outline.radius().scaled(context->renderTargetScale).rounded().toVector(),
-                .borderThickness = thickness,
-                .borderColor = outline.color(),
+                .hasAlpha = imageItem->image().hasAlphaChannel(),
+                .colorDescription = item->colorDescription(),
+                .renderingIntent = item->renderingIntent(),
+                .bufferReleasePoint = nullptr,
                 .paintHole = hole,
+                .item = item,
+                .deviceTranslation = deviceTranslation,
+                .textureMatrix = texture->planes()[0]->matrix(UnnormalizedCoordinates),
             });
         }
+    } else if (auto borderItem = qobject_cast<OutlinedBorderItem *>(item)) {
+        const BorderOutline outline = borderItem->outline();
+        const int thickness = std::round(outline.thickness() * context->renderTargetScale);
+        const RectF outerRect = snapToPixelGridF(scaledRect(borderItem->rect(), context->renderTargetScale));
+        const RectF innerRect = outerRect.adjusted(thickness, thickness, -thickness, -thickness);
+        context->renderNodes.append(RenderNode{
+            .traits = ShaderTrait::Border,
+            .transformMatrix = context->transformStack.top(),
+            .opacity = context->opacityStack.top(),
+            .hasAlpha = true,
+            .colorDescription = borderItem->colorDescription(),
+            .renderingIntent = borderItem->renderingIntent(),
+            .box = QVector4D(innerRect.x() + innerRect.width() * 0.5,
+                             innerRect.y() + innerRect.height() * 0.5,
+                             innerRect.width() * 0.5,
+                             innerRect.height() * 0.5),
+            .borderRadius = outline.radius().scaled(context->renderTargetScale).rounded().toVector(),
+            .borderThickness = thickness,
+            .borderColor = outline.color(),
+            .paintHole = hole,
+            .item = item,
+            .deviceTranslation = deviceTranslation,
+        });
     }
 
     for (Item *childItem : sortedChildItems) {
@@ -341,6 +598,24 @@ void ItemRendererOpenGL::createRenderNode(Item *item, RenderContext *context, co
     }
 }
 
+static bool canBatch(const ItemRendererOpenGL::RenderNode &first, const ItemRendererOpenGL::RenderNode &next)
+{
+    return first.traits == next.traits
+        && first.textures == next.textures
+        && first.transformMatrix == next.transformMatrix
+        && first.opacity == next.opacity
+        && first.hasAlpha == next.hasAlpha
+        && first.colorDescription == next.colorDescription
+        && first.renderingIntent == next.renderingIntent
+        && first.box == next.box
+        && first.borderRadius == next.borderRadius
+        && first.borderThickness == next.borderThickness
+        && first.borderColor == next.borderColor
+        && first.paintHole == next.paintHole
+        && first.color == next.color
+        && first.hasFloatingPointColor == next.hasFloatingPointColor;
+}
+
 void ItemRendererOpenGL::renderBackground(const RenderTarget &renderTarget, const RenderViewport &viewport, const Region &deviceRegion)
 {
     const auto clipped = deviceRegion & renderTarget.transformedRect();
@@ -382,6 +657,7 @@ void ItemRendererOpenGL::renderItem(const RenderTarget &renderTarget, const Rend
     renderContext.opacityStack.push(data.opacity());
 
     createRenderNode(item, &renderContext, filter, holeFilter);
+    generateGeometry(&renderContext);
 
     int totalVertexCount = 0;
     for (const RenderNode &node : std::as_const(renderContext.renderNodes)) {
@@ -426,10 +702,24 @@ void ItemRendererOpenGL::renderItem(const RenderTarget &renderTarget, const Rend
     }
 
     ShaderTraits lastTraits;
+    std::optional<ColorspaceShape> lastShape;
     GLShader *shader = nullptr;
-    for (int i = 0; i < renderContext.renderNodes.count(); i++) {
+    // consecutive nodes often share the blend function or even the textures, every state
+    // change that can be skipped saves the driver from validating it again
+    bool holeBlendFunc = false;
+    QVarLengthArray<GLTexture *, 4> boundTextures;
+    for (int i = 0; i < renderContext.renderNodes.count();) {
         const RenderNode &renderNode = renderContext.renderNodes[i];
 
+        // Adjacent nodes occupy adjacent ranges in the vertex buffer, so nodes with identical
+        // state can be drawn with a single draw call.
+        int batchEnd = i + 1;
+        int batchVertexCount = renderNode.vertexCount;
+        while (batchEnd < renderContext.renderNodes.count() && canBatch(renderNode, renderContext.renderNodes[batchEnd])) {
+            batchVertexCount += renderContext.renderNodes[batchEnd].vertexCount;
+            batchEnd++;
+        }
+
         ShaderTraits traits = renderNode.traits;
         if (renderNode.opacity != 1.0 || data.brightness() != 1.0) {
             traits |= ShaderTrait::Modulate;
@@ -448,21 +738,33 @@ void ItemRendererOpenGL::renderItem(const RenderTarget &renderTarget, const Rend
             }
         }
 
+        if (renderNode.paintHole != holeBlendFunc) {
+            holeBlendFunc = renderNode.paintHole;
+            if (holeBlendFunc) {
+                glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            } else {
+                glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            }
+        }
         if (renderNode.paintHole) {
             traits = (traits & ShaderTrait::RoundedCorners) | ShaderTrait::UniformColor;
-            glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             setBlendEnabled(true);
         } else {
-            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
             setBlendEnabled(renderNode.hasAlpha || renderNode.opacity < 1.0);
         }
 
-        if (!shader || traits != lastTraits) {
+        std::optional<ColorspaceShape> shape;
+        if (traits & ShaderTrait::TransformColorspace) {
+            shape = ColorspaceShape::create(renderNode.colorDescription, renderTarget.colorDescription(), renderNode.renderingIntent);
+        }
+
+        if (!shader || traits != lastTraits || shape != lastShape) {
             lastTraits = traits;
+            lastShape = shape;
             if (shader) {
                 ShaderManager::instance()->popShader();
             }
-            shader = ShaderManager::instance()->pushShader(traits);
+            shader = shape ? ShaderManager::instance()->pushShader(traits, *shape) : ShaderManager::instance()->pushShader(traits);
             if (traits & ShaderTrait::AdjustSaturation) {
                 const auto toXYZ = renderTarget.colorDescription()->containerColorimetry().toXYZ();
                 shader->setUniform(GLShader::FloatUniform::Saturation, data.saturation());
@@ -498,25 +800,45 @@ void ItemRendererOpenGL::renderItem(const RenderTarget &renderTarget, const Rend
         }
         if (renderNode.paintHole) {
             shader->setUniform(GLShader::ColorUniform::Color, QColor(0, 0, 0, 255));
+        } else if (renderNode.traits & ShaderTrait::UniformColor) {
+            shader->setUniform(GLShader::ColorUniform::Color, renderNode.color);
         }
 
         for (int i = 0; i < renderNode.textures.count() && !renderNode.paintHole; ++i) {
+            GLTexture *texture = renderNode.textures[i];
+            if (i < boundTextures.count() && boundTextures[i] == texture) {
+                continue;
+            }
             glActiveTexture(GL_TEXTURE0 + i);
-            renderNode.textures[i]->bind();
+            if (i < boundTextures.count()) {
+                if (boundTextures[i]->target() != texture->target()) {
+                    boundTextures[i]->unbind();
+                }
+                boundTextures[i] = texture;
+            } else {
+                boundTextures.append(texture);
+            }
+            texture->bind();
         }
 
-        vbo->draw(scissorRegion, GL_TRIANGLES, renderNode.firstVertex,
-                  renderNode.vertexCount, renderContext.hardwareClipping);
-
-        for (int i = 0; i < renderNode.textures.count() && !renderNode.paintHole; ++i) {
-            glActiveTexture(GL_TEXTURE0 + i);
-            renderNode.textures[i]->unbind();
+        if (renderContext.hardwareClipping) {
+            const std::span<const RenderNode> batch(renderContext.renderNodes.constData() + i, batchEnd - i);
+            vbo->draw(clipScissorRegion(scissorRegion, batch, renderContext.projectionMatrix), GL_TRIANGLES, renderNode.firstVertex,
+                      batchVertexCount, true);
+        } else {
+            vbo->draw(scissorRegion, GL_TRIANGLES, renderNode.firstVertex, batchVertexCount, false);
         }
 
-        if (renderNode.bufferReleasePoint) {
-            m_releasePoints.insert(renderNode.bufferReleasePoint);
+        for (; i < batchEnd; ++i) {
+            if (const auto &releasePoint = renderContext.renderNodes[i].bufferReleasePoint) {
+                m_releasePoints.insert(releasePoint);
+            }
         }
     }
+    for (int i = 0; i < boundTextures.count(); ++i) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        boundTextures[i]->unbind();
+    }
     if (shader) {
         // some other code assumes texture 0 is active
         glActiveTexture(GL_TEXTURE0);
@@ -10,6 +10,8 @@
 #include "scene/itemrenderer.h"
 #include "scene/surfaceitem.h"
 
+#include <optional>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace KWin
@@ -39,6 +41,14 @@ public:
         QColor borderColor;
         bool paintHole = false;
         bool hasFloatingPointColor = false;
+        const Item *item = nullptr;
+        QPointF deviceTranslation;
+        std::optional<QMatrix4x4> textureMatrix;
+        // the premultiplied color of nodes drawn with ShaderTrait::UniformColor
+        QVector4D color;
+        // the part of an item with rounded corners that can be drawn without the shader, in item coordinates
+        RegionF interior;
+        RenderGeometry cornerGeometry;
     };
 
     struct RenderCorner
@@ -89,12 +99,32 @@ private:
     QVector4D modulate(float opacity, float brightness) const;
     void setBlendEnabled(bool enabled);
     void createRenderNode(Item *item, RenderContext *context, const std::function<bool(Item *)> &filter, const std::function<bool(Item *)> &holeFilter);
+    void generateGeometry(RenderContext *context);
     void visualizeFractional(const RenderViewport &viewport, const Region &logicalRegion, const RenderContext &renderContext);
 
     bool m_blendingEnabled = false;
     EglDisplay *const m_eglDisplay;
     std::unordered_set<std::shared_ptr<SyncReleasePoint>> m_releasePoints;
 
+    /**
+     * The geometry of an item is retained across frames, and it's regenerated only if the
+     * quads, the scale, or the clip region change.
+     */
+    struct CachedGeometry
+    {
+        quint64 quadsSerial = 0;
+        qreal scale = 1;
+        bool softwareClipped = false;
+        QPointF itemToDeviceTranslation;
+        Region deviceClip;
+        RegionF interior;
+        RenderGeometry geometry;
+        RenderGeometry cornerGeometry;
+        quint64 lastUsedFrame = 0;
+    };
+    std::unordered_map<const Item *, CachedGeometry> m_geometryCache;
+    quint64 m_frameCounter = 0;
+
     struct
     {
         bool fractionalEnabled = false;
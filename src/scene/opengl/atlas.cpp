@@ -5,6 +5,7 @@
 */
 
 #include "scene/opengl/atlas.h"
+#include "core/gpumemorystatistics.h"
 #include "main.h"
 #include "opengl/eglcontext.h"
 #include "opengl/gltexture.h"
@@ -187,7 +188,7 @@ void AtlasOpenGL::upload(uint spriteId, const QImage &image, const Rect &damage)
     }
 }
 
-bool AtlasOpenGL::reset(const QList<QImage> &images)
+bool AtlasOpenGL::reset(const QList<QImage> &images, const QList<Rect> &damage)
 {
     const QMargins padding(1, 1, 1, 1);
 
@@ -228,22 +229,40 @@ bool AtlasOpenGL::reset(const QList<QImage> &images)
         return false;
     }
 
-    if (!m_texture || m_texture->size() != textureSize) {
+    // Keep the texture if the sprites still fit, a window that is being resized changes the
+    // size of its decoration with every step. Drop it only once it gets much too big
+    const bool reuseTexture = m_texture
+        && m_texture->width() >= textureSize.width()
+        && m_texture->height() >= textureSize.height()
+        && m_texture->width() * m_texture->height() <= 2 * textureSize.width() * textureSize.height();
+    if (!reuseTexture) {
         m_texture = GLTexture::allocate(GL_RGBA8, textureSize);
         if (!m_texture) {
             m_sprites.clear();
             return false;
         }
+        m_texture->setMemoryCategory(GpuMemoryCategory::Decorations);
         m_texture->setContentTransform(OutputTransform::FlipY);
         m_texture->setFilter(GL_LINEAR);
         m_texture->setWrapMode(GL_CLAMP_TO_EDGE);
     }
 
+    // sprites are stacked from top to bottom in a fixed order, so resizing a window in one
+    // direction changes only the size of two sprites and leaves the other two where they are
+    const QList<Sprite> previousSprites = reuseTexture ? m_sprites : QList<Sprite>();
     m_sprites = sprites;
 
     for (int i = 0; i < images.size(); ++i) {
-        if (!images[i].isNull()) {
+        if (images[i].isNull()) {
+            continue;
+        }
+        const bool unmoved = i < damage.size() && i < previousSprites.size()
+            && previousSprites[i].geometry == sprites[i].geometry
+            && previousSprites[i].rotated == sprites[i].rotated;
+        if (!unmoved) {
             upload(i, images[i], images[i].rect());
+        } else if (!damage[i].isEmpty()) {
+            upload(i, images[i], damage[i]);
         }
     }
 
@@ -24,7 +24,7 @@ public:
 
     Sprite sprite(uint spriteId) const override;
     bool update(uint spriteId, const QImage &image, const Rect &damage) override;
-    bool reset(const QList<QImage> &images) override;
+    bool reset(const QList<QImage> &images, const QList<Rect> &damage = {}) override;
 
 private:
     void upload(uint spriteId, const QImage &data, const Rect &damage);
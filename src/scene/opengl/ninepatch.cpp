@@ -5,6 +5,7 @@
 */
 
 #include "scene/opengl/ninepatch.h"
+#include "core/gpumemorystatistics.h"
 #include "main.h"
 #include "opengl/eglcontext.h"
 #include "opengl/gltexture.h"
@@ -22,6 +23,7 @@ std::unique_ptr<NinePatchOpenGL> NinePatchOpenGL::create(const QImage &image)
         return nullptr;
     }
 
+    texture->setMemoryCategory(GpuMemoryCategory::Shadows);
     texture->setFilter(GL_LINEAR);
     texture->setWrapMode(GL_CLAMP_TO_EDGE);
 
@@ -104,6 +106,7 @@ std::unique_ptr<NinePatchOpenGL> NinePatchOpenGL::create(const QImage &topLeftPa
         return nullptr;
     }
 
+    texture->setMemoryCategory(GpuMemoryCategory::Shadows);
     texture->setFilter(GL_LINEAR);
     texture->setWrapMode(GL_CLAMP_TO_EDGE);
 
@@ -6,12 +6,17 @@
 
 #include "scene/opengl/texture.h"
 #include "compositor.h"
+#include "core/gpumemorystatistics.h"
 #include "core/graphicsbufferview.h"
 #include "opengl/eglbackend.h"
+#include "opengl/eglcontext.h"
+#include "opengl/glframebuffer.h"
 #include "opengl/gltexture.h"
 #include "utils/common.h"
 #include "utils/drm_format_helper.h"
 
+#include <bit>
+
 namespace KWin
 {
 
@@ -25,6 +30,62 @@ QVarLengthArray<GLTexture *, 4> TextureOpenGL::planes() const
     return m_planes;
 }
 
+void TextureOpenGL::invalidateMipmaps()
+{
+    if (m_mipmapsDirty) {
+        m_mipmapped.reset();
+    }
+    m_mipmapsDirty = true;
+}
+
+GLTexture *TextureOpenGL::mipmappedTexture()
+{
+    if (m_planes.count() != 1 || m_planes[0]->target() != GL_TEXTURE_2D) {
+        return nullptr;
+    }
+    if (m_mipmapped && !m_mipmapsDirty) {
+        return m_mipmapped.get();
+    }
+    if (!EglContext::currentContext()->supportsBlits()) {
+        return nullptr;
+    }
+
+    GLTexture *source = m_planes[0];
+    const QSize size = source->size();
+    if (!m_mipmapped || m_mipmapped->size() != size) {
+        const int levels = std::bit_width(uint(std::max(size.width(), size.height())));
+        m_mipmapped = GLTexture::allocate(m_isFloatingPoint ? GL_RGBA16F : GL_RGBA8, size, levels);
+        if (!m_mipmapped) {
+            return nullptr;
+        }
+        m_mipmapped->setMemoryCategory(GpuMemoryCategory::WindowContents);
+        m_mipmapped->setFilter(GL_LINEAR_MIPMAP_LINEAR);
+        m_mipmapped->setWrapMode(GL_CLAMP_TO_EDGE);
+    }
+    m_mipmapped->setContentTransform(source->contentTransform());
+
+    GLFramebuffer sourceFramebuffer(source);
+    GLFramebuffer targetFramebuffer(m_mipmapped.get());
+    if (!sourceFramebuffer.valid() || !targetFramebuffer.valid()) {
+        m_mipmapped.reset();
+        return nullptr;
+    }
+
+    // both textures have the same layout, so the first level is a plain copy
+    GLFramebuffer::pushFramebuffer(&targetFramebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, sourceFramebuffer.handle());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetFramebuffer.handle());
+    glBlitFramebuffer(0, 0, size.width(), size.height(), 0, 0, size.width(), size.height(), GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    GLFramebuffer::popFramebuffer();
+
+    m_mipmapped->bind();
+    m_mipmapped->generateMipmaps();
+    m_mipmapped->unbind();
+
+    m_mipmapsDirty = false;
+    return m_mipmapped.get();
+}
+
 std::unique_ptr<ImageTextureOpenGL> ImageTextureOpenGL::create(const QImage &image)
 {
     auto texture = std::make_unique<ImageTextureOpenGL>();
@@ -58,6 +119,7 @@ bool ImageTextureOpenGL::upload(const QImage &image)
 
 void ImageTextureOpenGL::upload(const QImage &image, const Rect &rect)
 {
+    invalidateMipmaps();
     m_planes[0]->update(image, rect);
 }
 
@@ -79,8 +141,15 @@ std::unique_ptr<BufferTextureOpenGL> BufferTextureOpenGL::create(GraphicsBuffer
 bool BufferTextureOpenGL::attach(GraphicsBuffer *buffer)
 {
     if (buffer->dmabufAttributes()) {
-        return loadDmabufTexture(buffer);
-    } else if (buffer->shmAttributes()) {
+        if (loadDmabufTexture(buffer)) {
+            return true;
+        } else if (!buffer->shmAttributes()) {
+            return false;
+        }
+        // shared memory buffers wrapped in a dmabuf may not be importable, upload them instead
+    }
+
+    if (buffer->shmAttributes()) {
         return loadShmTexture(buffer);
     } else if (buffer->singlePixelAttributes()) {
         return loadSinglePixelTexture(buffer);
@@ -92,7 +161,9 @@ bool BufferTextureOpenGL::attach(GraphicsBuffer *buffer)
 
 void BufferTextureOpenGL::attach(GraphicsBuffer *buffer, const Region &region)
 {
-    if (buffer->dmabufAttributes()) {
+    invalidateMipmaps();
+    // once importing a shared memory buffer as dmabuf failed, keep uploading it
+    if (buffer->dmabufAttributes() && (m_bufferType != BufferType::Shm || !buffer->shmAttributes())) {
         updateDmabufTexture(buffer);
     } else if (buffer->shmAttributes()) {
         updateShmTexture(buffer, region);
@@ -112,6 +183,7 @@ void BufferTextureOpenGL::reset()
 {
     qDeleteAll(m_planes);
     m_planes.clear();
+    m_mipmapped.reset();
     m_bufferType = BufferType::None;
     m_size = QSize();
 }
@@ -128,6 +200,7 @@ bool BufferTextureOpenGL::loadShmTexture(GraphicsBuffer *buffer)
         return false;
     }
 
+    texture->setMemoryCategory(GpuMemoryCategory::WindowContents);
     texture->setFilter(GL_LINEAR);
     texture->setWrapMode(GL_CLAMP_TO_EDGE);
     texture->setContentTransform(OutputTransform::FlipY);
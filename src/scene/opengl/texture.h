@@ -11,6 +11,8 @@
 #include <QImage>
 #include <QVarLengthArray>
 
+#include <memory>
+
 namespace KWin
 {
 
@@ -27,8 +29,23 @@ public:
 
     QVarLengthArray<GLTexture *, 4> planes() const;
 
+    /**
+     * Returns a mipmapped copy of the texture for drawing it at a fraction of its size, e.g.
+     * as a thumbnail, or @c nullptr if the texture can't be copied. The copy is refreshed
+     * lazily after the contents have changed.
+     */
+    GLTexture *mipmappedTexture();
+
 protected:
+    /**
+     * Marks the mipmapped copy as out of date. The copy is released if it hasn't been used
+     * since the previous change, so textures that are no longer drawn downscaled don't keep it.
+     */
+    void invalidateMipmaps();
+
     QVarLengthArray<GLTexture *, 4> m_planes;
+    std::unique_ptr<GLTexture> m_mipmapped;
+    bool m_mipmapsDirty = true;
 };
 
 class ImageTextureOpenGL : public TextureOpenGL
@@ -38,7 +38,7 @@ bool AtlasQPainter::update(uint spriteId, const QImage &image, const Rect &damag
     return true;
 }
 
-bool AtlasQPainter::reset(const QList<QImage> &images)
+bool AtlasQPainter::reset(const QList<QImage> &images, const QList<Rect> &damage)
 {
     m_images = images;
 
@@ -20,7 +20,7 @@ public:
 
     Sprite sprite(uint spriteId) const override;
     bool update(uint spriteId, const QImage &image, const Rect &damage) override;
-    bool reset(const QList<QImage> &images) override;
+    bool reset(const QList<QImage> &images, const QList<Rect> &damage = {}) override;
 
 private:
     QList<QImage> m_images;
@@ -242,6 +242,12 @@ public:
     void addView(RenderView *view);
     void removeView(RenderView *view);
 
+    /**
+     * Releases the textures and other renderer resources of the @a item and its children. They
+     * are created again the next time the items are painted.
+     */
+    void releaseResources(Item *item);
+
     virtual QList<SurfaceItem *> scanoutCandidates(ssize_t maxCount) const;
     struct OverlayCandidates
     {
@@ -260,8 +266,6 @@ Q_SIGNALS:
     void viewRemoved(RenderView *delegate);
 
 protected:
-    void releaseResources(Item *item);
-
     std::unique_ptr<ItemRenderer> m_renderer;
     QList<RenderView *> m_views;
     Rect m_geometry;
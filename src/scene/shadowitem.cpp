@@ -34,6 +34,32 @@ private:
     QHash<KDecoration3::DecorationShadow *, Data> m_cache;
 };
 
+/**
+ * Shares the textures of shadows that are made of the same images, e.g. the shadows that every
+ * menu and panel of the same style provides, between all the windows using them.
+ */
+class ShadowElementsTextureCache
+{
+public:
+    ~ShadowElementsTextureCache();
+    ShadowElementsTextureCache(const ShadowElementsTextureCache &) = delete;
+    static ShadowElementsTextureCache &instance();
+
+    void unregister(ShadowItem *shadowItem);
+    std::shared_ptr<NinePatch> ninePatch(ShadowItem *shadowItem);
+
+private:
+    ShadowElementsTextureCache() = default;
+    struct Data
+    {
+        size_t hash;
+        QList<QImage> elements;
+        std::shared_ptr<NinePatch> ninePatch;
+        QList<ShadowItem *> shadowItems;
+    };
+    QList<Data> m_cache;
+};
+
 ShadowItem::ShadowItem(Shadow *shadow, Window *window, Item *parent)
     : Item(parent)
     , m_window(window)
@@ -51,6 +77,7 @@ ShadowItem::~ShadowItem()
 {
     if (m_ninePatch) {
         DecorationShadowTextureCache::instance().unregister(this);
+        ShadowElementsTextureCache::instance().unregister(this);
         m_ninePatch.reset();
     }
 }
@@ -322,21 +349,18 @@ void ShadowItem::preprocess()
     m_textureDirty = false;
 
     if (m_shadow->hasDecorationShadow()) {
+        ShadowElementsTextureCache::instance().unregister(this);
         m_ninePatch = DecorationShadowTextureCache::instance().ninePatch(this);
     } else {
-        m_ninePatch = scene()->renderer()->createNinePatch(m_shadow->shadowElement(Shadow::ShadowElementTopLeft),
-                                                           m_shadow->shadowElement(Shadow::ShadowElementTop),
-                                                           m_shadow->shadowElement(Shadow::ShadowElementTopRight),
-                                                           m_shadow->shadowElement(Shadow::ShadowElementRight),
-                                                           m_shadow->shadowElement(Shadow::ShadowElementBottomRight),
-                                                           m_shadow->shadowElement(Shadow::ShadowElementBottom),
-                                                           m_shadow->shadowElement(Shadow::ShadowElementBottomLeft),
-                                                           m_shadow->shadowElement(Shadow::ShadowElementLeft));
+        DecorationShadowTextureCache::instance().unregister(this);
+        m_ninePatch = ShadowElementsTextureCache::instance().ninePatch(this);
     }
 }
 
 void ShadowItem::releaseResources()
 {
+    DecorationShadowTextureCache::instance().unregister(this);
+    ShadowElementsTextureCache::instance().unregister(this);
     m_ninePatch.reset();
     m_textureDirty = true;
 }
@@ -398,6 +422,80 @@ std::shared_ptr<NinePatch> DecorationShadowTextureCache::ninePatch(ShadowItem *s
     return d.ninePatch;
 }
 
+ShadowElementsTextureCache &ShadowElementsTextureCache::instance()
+{
+    static ShadowElementsTextureCache s_instance;
+    return s_instance;
+}
+
+ShadowElementsTextureCache::~ShadowElementsTextureCache()
+{
+    Q_ASSERT(m_cache.isEmpty());
+}
+
+void ShadowElementsTextureCache::unregister(ShadowItem *shadowItem)
+{
+    for (auto it = m_cache.begin(); it != m_cache.end();) {
+        it->shadowItems.removeAll(shadowItem);
+        if (it->shadowItems.isEmpty()) {
+            it = m_cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+static size_t hashShadowElements(const QList<QImage> &elements)
+{
+    size_t hash = 0;
+    for (const QImage &element : elements) {
+        hash = qHashMulti(hash, element.width(), element.height(), int(element.format()));
+        if (!element.isNull()) {
+            hash = qHashBits(element.constBits(), element.sizeInBytes(), hash);
+        }
+    }
+    return hash;
+}
+
+std::shared_ptr<NinePatch> ShadowElementsTextureCache::ninePatch(ShadowItem *shadowItem)
+{
+    Shadow *shadow = shadowItem->shadow();
+    unregister(shadowItem);
+
+    QList<QImage> elements;
+    elements.reserve(Shadow::ShadowElementsCount);
+    for (int i = 0; i < Shadow::ShadowElementsCount; ++i) {
+        elements.append(shadow->shadowElement(Shadow::ShadowElements(i)));
+    }
+    const size_t hash = hashShadowElements(elements);
+
+    for (Data &data : m_cache) {
+        if (data.hash == hash && data.elements == elements) {
+            data.shadowItems << shadowItem;
+            return data.ninePatch;
+        }
+    }
+
+    std::shared_ptr<NinePatch> ninePatch = shadowItem->scene()->renderer()->createNinePatch(shadow->shadowElement(Shadow::ShadowElementTopLeft),
+                                                                                            shadow->shadowElement(Shadow::ShadowElementTop),
+                                                                                            shadow->shadowElement(Shadow::ShadowElementTopRight),
+                                                                                            shadow->shadowElement(Shadow::ShadowElementRight),
+                                                                                            shadow->shadowElement(Shadow::ShadowElementBottomRight),
+                                                                                            shadow->shadowElement(Shadow::ShadowElementBottom),
+                                                                                            shadow->shadowElement(Shadow::ShadowElementBottomLeft),
+                                                                                            shadow->shadowElement(Shadow::ShadowElementLeft));
+    if (!ninePatch) {
+        return nullptr;
+    }
+    m_cache.append(Data{
+        .hash = hash,
+        .elements = elements,
+        .ninePatch = ninePatch,
+        .shadowItems = {shadowItem},
+    });
+    return ninePatch;
+}
+
 } // namespace KWin
 
 #include "moc_shadowitem.cpp"
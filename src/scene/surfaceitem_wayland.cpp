@@ -37,6 +37,8 @@ SurfaceItemWayland::SurfaceItemWayland(SurfaceInterface *surface, Item *parent)
             this, &SurfaceItemWayland::handleChildSubSurfacesChanged);
     connect(surface, &SurfaceInterface::committed,
             this, &SurfaceItemWayland::handleSurfaceCommitted);
+    connect(surface, &SurfaceInterface::timedStatePending,
+            this, &SurfaceItemWayland::scheduleFrame);
     connect(surface, &SurfaceInterface::damaged,
             this, &SurfaceItemWayland::addDamage);
     connect(surface, &SurfaceInterface::childSubSurfaceRemoved,
@@ -247,6 +249,15 @@ void SurfaceItemWayland::handleFramePainted(LogicalOutput *output, OutputFrame *
         if (auto feedback = m_surface->presentationFeedback(output)) {
             frame->addFeedback(std::move(feedback));
         }
+        if (auto feedback = m_surface->inputLatencyFeedback(output)) {
+            frame->addFeedback(std::move(feedback));
+        }
+    }
+    if (frame) {
+        // states applied now are shown with the next frame, let through the ones that want
+        // to be presented closer to that than to the frame after it
+        const auto nextPresentation = frame->targetPageflipTime().time_since_epoch() + frame->refreshDuration();
+        m_surface->releaseTimedStates(nextPresentation + frame->refreshDuration() / 2);
     }
     // TODO only call this once per refresh cycle
     m_surface->clearFifoBarrier();
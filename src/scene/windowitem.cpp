@@ -8,9 +8,11 @@
 #include "effect/effecthandler.h"
 #include "internalwindow.h"
 #include "scene/decorationitem.h"
+#include "scene/scene.h"
 #include "scene/shadowitem.h"
 #include "scene/surfaceitem_internal.h"
 #include "scene/surfaceitem_wayland.h"
+#include "utils/envvar.h"
 #include "virtualdesktops.h"
 #include "wayland_server.h"
 #include "window.h"
@@ -24,11 +26,19 @@
 namespace KWin
 {
 
+static const bool s_throttleOccludedWindows = environmentVariableBoolValue("KWIN_THROTTLE_OCCLUDED_WINDOWS").value_or(true);
+// how long a window has to stay hidden until its textures are released, 0 keeps them forever
+static const std::chrono::seconds s_releaseHiddenResourcesDelay(environmentVariableIntValue("KWIN_RELEASE_HIDDEN_WINDOW_RESOURCES_DELAY").value_or(300));
+
 WindowItem::WindowItem(Window *window, Item *parent)
     : Item(parent)
     , m_windowContainer(std::make_unique<Item>(this))
     , m_window(window)
 {
+    m_releaseResourcesTimer.setSingleShot(true);
+    m_releaseResourcesTimer.setInterval(s_releaseHiddenResourcesDelay);
+    connect(&m_releaseResourcesTimer, &QTimer::timeout, this, &WindowItem::releaseHiddenResources);
+
     connect(window, &Window::decorationChanged, this, &WindowItem::updateDecorationItem);
     updateDecorationItem();
 
@@ -50,7 +60,7 @@ WindowItem::WindowItem(Window *window, Item *parent)
     connect(window, &Window::offscreenRenderingChanged, this, &WindowItem::updateVisibility);
     connect(waylandServer(), &WaylandServer::lockStateChanged, this, &WindowItem::updateVisibility);
     connect(workspace(), &Workspace::currentActivityChanged, this, &WindowItem::updateVisibility);
-    connect(workspace(), &Workspace::currentDesktopChanged, this, &WindowItem::updateVisibility);
+    connect(workspace(), &Workspace::currentDesktopChanged, this, &WindowItem::handleCurrentDesktopChanged);
     updateVisibility();
 
     connect(window, &Window::opacityChanged, this, &WindowItem::updateOpacity);
@@ -149,6 +159,28 @@ void WindowItem::deelevate()
     updateStackingOrder();
 }
 
+void WindowItem::setOccluded(LogicalOutput *output, bool occluded)
+{
+    if (occluded) {
+        if (!m_occludedOutputs.contains(output)) {
+            m_occludedOutputs.append(output);
+        }
+    } else {
+        m_occludedOutputs.removeOne(output);
+    }
+}
+
+bool WindowItem::isFramePaintedThrottled(LogicalOutput *output, std::chrono::milliseconds timestamp)
+{
+    // the contents of a window that is being captured are seen even if it's covered
+    const bool occluded = s_throttleOccludedWindows && m_occludedOutputs.contains(output) && !m_window->isOffscreenRendering();
+    if (occluded && timestamp - m_lastFramePainted < s_occludedFrameInterval) {
+        return true;
+    }
+    m_lastFramePainted = timestamp;
+    return false;
+}
+
 bool WindowItem::computeVisibility() const
 {
     if (!m_window->readyForPainting()) {
@@ -188,6 +220,35 @@ void WindowItem::updateVisibility()
     if (m_window->readyForPainting()) {
         m_window->setSuspended(!visible && !m_window->isOffscreenRendering());
     }
+
+    if (visible) {
+        m_releaseResourcesTimer.stop();
+    } else if (s_releaseHiddenResourcesDelay.count() > 0 && !m_releaseResourcesTimer.isActive()) {
+        m_releaseResourcesTimer.start();
+    }
+}
+
+void WindowItem::releaseHiddenResources()
+{
+    // Thumbnails and screencasts keep painting the window even though it's hidden
+    if (isVisible() || m_window->isOffscreenRendering() || !scene()) {
+        return;
+    }
+
+    // The textures are imported and the decoration is rendered again on the first paint after
+    // the window has been shown, e.g. by a desktop switch or an overview effect
+    scene()->releaseResources(this);
+}
+
+void WindowItem::handleCurrentDesktopChanged(VirtualDesktop *previousDesktop)
+{
+    // The desktop switch changes the visibility only of the windows that are on either the
+    // previous or the new desktop but not on both, skip all others rather than to evaluate
+    // the visibility of every window in the scene
+    if (previousDesktop && m_window->isOnDesktop(previousDesktop) == m_window->isOnCurrentDesktop()) {
+        return;
+    }
+    updateVisibility();
 }
 
 void WindowItem::updateGeometry()
@@ -10,6 +10,8 @@
 
 #include "scene/item.h"
 
+#include <QTimer>
+
 namespace KDecoration3
 {
 class Decoration;
@@ -24,6 +26,7 @@ class InternalWindow;
 class Shadow;
 class ShadowItem;
 class SurfaceItem;
+class VirtualDesktop;
 class X11Window;
 
 /**
@@ -58,10 +61,19 @@ public:
     void elevate();
     void deelevate();
 
+    /**
+     * Sets whether the window is completely covered by other windows on @p output. The frame
+     * callbacks of an occluded window are throttled to s_occludedFrameInterval.
+     */
+    void setOccluded(LogicalOutput *output, bool occluded);
+
+    static constexpr std::chrono::milliseconds s_occludedFrameInterval{1000};
+
 protected:
     explicit WindowItem(Window *window, Item *parent = nullptr);
     void updateSurfaceItem(std::unique_ptr<SurfaceItem> &&surfaceItem);
     Item *windowContainer() const;
+    bool isFramePaintedThrottled(LogicalOutput *output, std::chrono::milliseconds timestamp) override;
 
     const std::unique_ptr<Item> m_windowContainer;
 
@@ -78,6 +90,8 @@ private Q_SLOTS:
 private:
     bool computeVisibility() const;
     void updateVisibility();
+    void releaseHiddenResources();
+    void handleCurrentDesktopChanged(VirtualDesktop *previousDesktop);
     void markDamaged();
     void freeze();
 
@@ -91,6 +105,9 @@ private:
     int m_forceVisibleByDesktopCount = 0;
     int m_forceVisibleByMinimizeCount = 0;
     int m_forceVisibleByActivityCount = 0;
+    QList<LogicalOutput *> m_occludedOutputs;
+    std::chrono::milliseconds m_lastFramePainted{0};
+    QTimer m_releaseResourcesTimer;
 };
 
 #if KWIN_BUILD_X11
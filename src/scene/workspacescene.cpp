@@ -55,14 +55,17 @@
 #include "scene/workspacescene.h"
 #include "compositor.h"
 #include "core/backendoutput.h"
+#include "core/gpumemorystatistics.h"
 #include "core/graphicsbufferview.h"
 #include "core/output.h"
+#include "core/outputlayer.h"
 #include "core/pixelgrid.h"
 #include "core/renderbackend.h"
 #include "core/renderloop.h"
 #include "core/renderviewport.h"
 #include "cursoritem.h"
 #include "effect/effecthandler.h"
+#include "ftrace.h"
 #include "opengl/eglbackend.h"
 #include "opengl/eglcontext.h"
 #include "scene/decorationitem.h"
@@ -72,6 +75,7 @@
 #include "scene/surfaceitem.h"
 #include "scene/windowitem.h"
 #include "utils/envvar.h"
+#include "wayland/display.h"
 #include "wayland/seat.h"
 #include "wayland_server.h"
 #include "window.h"
@@ -167,6 +171,11 @@ Item *WorkspaceScene::overlayItem() const
     return m_overlayItem.get();
 }
 
+Region WorkspaceScene::contentDamage() const
+{
+    return m_paintContext.contentDamage;
+}
+
 Item *WorkspaceScene::cursorItem() const
 {
     return m_cursorItem.get();
@@ -430,17 +439,27 @@ static const bool s_forceSoftwareCursor = environmentVariableBoolValue("KWIN_FOR
 
 Scene::OverlayCandidates WorkspaceScene::overlayCandidates(ssize_t maxTotalCount, ssize_t maxOverlayCount, ssize_t maxUnderlayCount) const
 {
+    const auto overlayItems = m_overlayItem->sortedChildItems();
+    const auto isVisibleCursor = [this](Item *item) {
+        // effects like zoom replace the real cursor with their own cursor item, which can
+        // be put on the cursor plane just as well
+        return qobject_cast<CursorItem *>(item)
+            && item->isVisible()
+            && painted_delegate->viewport().intersects(item->mapToView(item->boundingRect(), painted_delegate));
+    };
     const auto fallback = [&]() {
-        if (s_forceSoftwareCursor
-            || maxOverlayCount == 0
-            || !cursorItem()->isVisible()
-            || !painted_delegate->viewport().intersects(cursorItem()->mapToView(cursorItem()->boundingRect(), painted_delegate))) {
+        if (s_forceSoftwareCursor || maxOverlayCount == 0) {
             return OverlayCandidates{};
         }
-        return OverlayCandidates{
-            .overlays = {cursorItem()},
-            .underlays = {},
-        };
+        for (Item *item : overlayItems | std::views::reverse) {
+            if (isVisibleCursor(item)) {
+                return OverlayCandidates{
+                    .overlays = {item},
+                    .underlays = {},
+                };
+            }
+        }
+        return OverlayCandidates{};
     };
     Region occupied;
     Region opaque;
@@ -448,12 +467,11 @@ Scene::OverlayCandidates WorkspaceScene::overlayCandidates(ssize_t maxTotalCount
     QList<Item *> overlays;
     QList<Item *> underlays;
     QStack<ClipCorner> cornerStack;
-    const auto overlayItems = m_overlayItem->sortedChildItems();
     for (Item *item : overlayItems | std::views::reverse) {
         if (!item->isVisible() || !painted_delegate->viewport().intersects(item->mapToView(item->boundingRect(), painted_delegate))) {
             continue;
         }
-        if (item == cursorItem()) {
+        if (qobject_cast<CursorItem *>(item)) {
             if (s_forceSoftwareCursor) {
                 continue;
             }
@@ -522,6 +540,8 @@ void WorkspaceScene::frame(SceneView *delegate, OutputFrame *frame)
     if (m_overlayItem) {
         m_overlayItem->framePainted(delegate, logicalOutput, frame, frameTime);
     }
+    // the clients need the frame callbacks to start on their next frame in time
+    waylandServer()->display()->scheduleFlush();
 }
 
 void WorkspaceScene::prePaint(SceneView *delegate)
@@ -544,6 +564,7 @@ void WorkspaceScene::prePaint(SceneView *delegate)
 
     effects->prePaintScreen(prePaintData);
     m_paintContext.deviceDamage = painted_delegate->mapToDeviceCoordinatesAligned(prePaintData.paint) & painted_delegate->deviceRect();
+    m_paintContext.contentDamage = Region();
     m_paintContext.mask = prePaintData.mask;
     m_paintContext.phase2Data.clear();
 
@@ -581,12 +602,15 @@ static void accumulateRepaints(Item *item, SceneView *delegate, Region *repaints
 void WorkspaceScene::preparePaintGenericScreen()
 {
     for (WindowItem *windowItem : std::as_const(stacking_order)) {
-        resetRepaintsHelper(windowItem, painted_delegate);
+        accumulateRepaints(windowItem, painted_delegate, &m_paintContext.contentDamage);
 
         WindowPrePaintData data;
         data.mask = m_paintContext.mask;
         data.devicePaint = Region::infinite(); // no clipping, so doesn't really matter
 
+        // the windows can be painted anywhere, so nothing is known to be covered
+        windowItem->setOccluded(painted_screen, false);
+
         effects->prePaintWindow(painted_delegate, windowItem->effectWindow(), data);
         m_paintContext.phase2Data.append(Phase2Data{
             .item = windowItem,
@@ -640,6 +664,12 @@ Region WorkspaceScene::collectDamage()
 {
     if (m_paintContext.mask & (PAINT_SCREEN_TRANSFORMED | PAINT_SCREEN_WITH_TRANSFORMED_WINDOWS)) {
         resetRepaintsHelper(m_overlayItem.get(), painted_delegate);
+        // repaints requested by effects don't belong to any item
+        m_paintContext.contentDamage += m_paintContext.deviceDamage;
+        if (painted_delegate->layer()) {
+            m_paintContext.contentDamage += painted_delegate->layer()->deviceRepaints();
+        }
+        m_paintContext.contentDamage &= painted_delegate->deviceRect();
         m_paintContext.deviceDamage = painted_delegate->deviceRect();
         return m_paintContext.deviceDamage;
     } else {
@@ -649,6 +679,12 @@ Region WorkspaceScene::collectDamage()
             auto &paintData = m_paintContext.phase2Data[i];
             accumulateRepaints(paintData.item, painted_delegate, &paintData.deviceRegion);
             m_paintContext.deviceDamage += paintData.deviceRegion - opaque;
+            if (paintData.mask & PAINT_WINDOW_TRANSFORMED) {
+                paintData.item->setOccluded(painted_screen, false);
+            } else {
+                const Rect deviceBounds = snapToPixelGrid(painted_delegate->mapToDeviceCoordinates(paintData.item->mapToView(paintData.item->boundingRect(), painted_delegate)));
+                paintData.item->setOccluded(painted_screen, (opaque & painted_delegate->deviceRect()).contains(deviceBounds));
+            }
             // TODO change effects API, so occlusion culling is per item, rather than per window
             const bool canCover = painted_delegate->shouldRenderItem(paintData.item->surfaceItem())
                 || painted_delegate->shouldRenderHole(paintData.item->surfaceItem());
@@ -670,6 +706,46 @@ void WorkspaceScene::postPaint()
     painted_delegate = nullptr;
     painted_screen = nullptr;
     clearStackingOrder();
+
+    if (GpuMemoryStatistics::isOverBudget()) {
+        reclaimGpuMemory();
+    }
+}
+
+static void releaseShmTextures(Item *item)
+{
+    // textures of dmabufs don't hold any memory of their own
+    if (auto surfaceItem = qobject_cast<SurfaceItem *>(item)) {
+        if (surfaceItem->buffer() && surfaceItem->buffer()->shmAttributes()) {
+            surfaceItem->destroyTexture();
+        }
+    }
+
+    const auto childItems = item->childItems();
+    for (Item *childItem : childItems) {
+        releaseShmTextures(childItem);
+    }
+}
+
+void WorkspaceScene::reclaimGpuMemory()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_lastGpuMemoryReclaim < std::chrono::seconds(1)) {
+        return;
+    }
+    m_lastGpuMemoryReclaim = now;
+
+    // The contents of hidden windows are uploaded again when they are shown the next time
+    const qint64 usage = GpuMemoryStatistics::totalUsage();
+    const auto windows = workspace()->windows();
+    for (Window *window : windows) {
+        WindowItem *windowItem = window->windowItem();
+        if (windowItem && !windowItem->isVisible() && windowItem->surfaceItem()) {
+            releaseShmTextures(windowItem->surfaceItem());
+        }
+    }
+
+    qCDebug(KWIN_CORE) << "GPU memory usage is over budget, released" << (usage - GpuMemoryStatistics::totalUsage()) / 1024 << "KiB of hidden window contents";
 }
 
 void WorkspaceScene::paint(const RenderTarget &renderTarget, const QPoint &deviceOffset, const Region &deviceRegion)
@@ -700,9 +776,11 @@ void WorkspaceScene::paint(const RenderTarget &renderTarget, const QPoint &devic
 // the function that'll be eventually called by paintScreen() above
 void WorkspaceScene::finalPaintScreen(const RenderTarget &renderTarget, const RenderViewport &viewport, int mask, const Region &deviceRegion, LogicalOutput *screen)
 {
+    // everything before this point in the "Render layer" block is spent in the effect chain
+    fTraceDuration("Render items (", screen ? screen->name() : QString(), ")");
     m_paintScreenCount++;
     if (mask & (PAINT_SCREEN_TRANSFORMED | PAINT_SCREEN_WITH_TRANSFORMED_WINDOWS)) {
-        paintGenericScreen(renderTarget, viewport, mask, screen);
+        paintGenericScreen(renderTarget, viewport, mask, deviceRegion, screen);
     } else {
         paintSimpleScreen(renderTarget, viewport, mask, deviceRegion);
     }
@@ -710,18 +788,21 @@ void WorkspaceScene::finalPaintScreen(const RenderTarget &renderTarget, const Re
 
 // The generic painting code that can handle even transformations.
 // It simply paints bottom-to-top.
-void WorkspaceScene::paintGenericScreen(const RenderTarget &renderTarget, const RenderViewport &viewport, int, LogicalOutput *screen)
+void WorkspaceScene::paintGenericScreen(const RenderTarget &renderTarget, const RenderViewport &viewport, int, const Region &deviceRegion, LogicalOutput *screen)
 {
+    // effects that keep the untransformed screen around may ask for only a part of it
+    const Region region = deviceRegion.contains(viewport.deviceRect()) ? Region::infinite() : deviceRegion;
+
     if (m_paintContext.mask & PAINT_SCREEN_BACKGROUND_FIRST) {
         if (m_paintScreenCount == 1) {
-            m_renderer->renderBackground(renderTarget, viewport, Region::infinite());
+            m_renderer->renderBackground(renderTarget, viewport, region);
         }
     } else {
-        m_renderer->renderBackground(renderTarget, viewport, Region::infinite());
+        m_renderer->renderBackground(renderTarget, viewport, region);
     }
 
     for (const Phase2Data &paintData : std::as_const(m_paintContext.phase2Data)) {
-        paintWindow(renderTarget, viewport, paintData.item, paintData.mask, paintData.deviceRegion);
+        paintWindow(renderTarget, viewport, paintData.item, paintData.mask, paintData.deviceRegion & region);
     }
 }
 
@@ -12,6 +12,8 @@
 #include "core/renderviewport.h"
 #include "scene/scene.h"
 
+#include <chrono>
+
 namespace KWin
 {
 
@@ -38,6 +40,14 @@ public:
     Item *overlayItem() const;
     Item *cursorItem() const;
 
+    /**
+     * Returns the damage of the screen that is being painted, in device coordinates and before any
+     * screen transformation. While the screen is painted transformed, the whole screen is reported
+     * as damaged, effects that keep the untransformed screen around can use this to only update
+     * what has actually changed.
+     */
+    Region contentDamage() const;
+
     void attachRenderer(std::unique_ptr<ItemRenderer> &&renderer) override;
     void detachRenderer() override;
 
@@ -73,7 +83,7 @@ protected:
     // shared implementation of painting the screen in the generic
     // (unoptimized) way
     void preparePaintGenericScreen();
-    void paintGenericScreen(const RenderTarget &renderTarget, const RenderViewport &viewport, int mask, LogicalOutput *screen);
+    void paintGenericScreen(const RenderTarget &renderTarget, const RenderViewport &viewport, int mask, const Region &deviceRegion, LogicalOutput *screen);
     // shared implementation of painting the screen in an optimized way
     void preparePaintSimpleScreen();
     void paintSimpleScreen(const RenderTarget &renderTarget, const RenderViewport &viewport, int mask, const Region &deviceRegion);
@@ -96,6 +106,7 @@ protected:
     struct PaintContext
     {
         Region deviceDamage;
+        Region contentDamage;
         int mask = 0;
         QList<Phase2Data> phase2Data;
     };
@@ -111,6 +122,7 @@ private:
     void createDndIconItem();
     void destroyDndIconItem();
     void updateCursor();
+    void reclaimGpuMemory();
 
     // how many times finalPaintScreen() has been called
     int m_paintScreenCount = 0;
@@ -119,6 +131,7 @@ private:
     std::unique_ptr<Item> m_overlayItem;
     std::unique_ptr<DragAndDropIconItem> m_dndIcon;
     std::unique_ptr<CursorItem> m_cursorItem;
+    std::chrono::steady_clock::time_point m_lastGpuMemoryReclaim;
 };
 
 } // namespace
@@ -43,6 +43,7 @@
 #include <QAbstractEventDispatcher>
 #include <QAction>
 #include <QDBusInterface>
+#include <algorithm>
 #include <span>
 
 using namespace std::chrono_literals;
@@ -332,6 +333,11 @@ bool Edge::check(const QPoint &cursorPos, const std::chrono::microseconds &trigg
     return false;
 }
 
+bool Edge::isIdle() const
+{
+    return !m_approaching && !m_lastReset.has_value();
+}
+
 void Edge::markAsTriggered(const QPoint &cursorPos, const std::chrono::microseconds &triggerTime)
 {
     m_lastTrigger = triggerTime;
@@ -1110,6 +1116,7 @@ void ScreenEdges::recreateEdges()
             oldEdge->client()->showOnScreenEdge();
         }
     }
+    updatePointerBounds();
 }
 
 void ScreenEdges::createVerticalEdge(ElectricBorder border, const Rect &screen, const Rect &fullArea, LogicalOutput *output)
@@ -1302,6 +1309,7 @@ bool ScreenEdges::reserve(Window *client, ElectricBorder border)
     });
     const bool hadBorder = it != m_edges.end();
     m_edges.erase(it, m_edges.end());
+    updatePointerBounds();
 
     if (border != ElectricNone) {
         return createEdgeForClient(client, border);
@@ -1378,6 +1386,7 @@ bool ScreenEdges::createEdgeForClient(Window *client, ElectricBorder border)
     connect(client, &Window::closed, edge.get(), [this, client]() {
         deleteEdgeForClient(client);
     });
+    updatePointerBounds();
     return true;
 }
 
@@ -1387,6 +1396,29 @@ void ScreenEdges::deleteEdgeForClient(Window *window)
         return edge->client() == window;
     });
     m_edges.erase(it, m_edges.end());
+    updatePointerBounds();
+}
+
+void ScreenEdges::updatePointerBounds()
+{
+    m_pointerBounds.fill(Rect());
+    for (const auto &edge : m_edges) {
+        const Rect area = edge->geometry() | edge->approachGeometry();
+        if (edge->isTop()) {
+            m_pointerBounds[0] |= area;
+        }
+        if (edge->isRight()) {
+            m_pointerBounds[1] |= area;
+        }
+        if (edge->isBottom()) {
+            m_pointerBounds[2] |= area;
+        }
+        if (edge->isLeft()) {
+            m_pointerBounds[3] |= area;
+        }
+    }
+    // the new edges have to see the next motion event
+    m_pointerIdle = false;
 }
 
 bool ScreenEdges::inApproachGeometry(const QPoint &pos) const
@@ -1401,6 +1433,18 @@ bool ScreenEdges::inApproachGeometry(const QPoint &pos) const
 
 void ScreenEdges::handlePointerMotion(const QPointF &pos, std::chrono::microseconds timestamp)
 {
+    // Far away from every edge, the motion can only matter to an edge that is still approaching
+    // or waiting for the pointer to come back after having pushed it back
+    if (m_pointerIdle) {
+        const QPoint point = pos.toPoint();
+        const bool nearEdge = std::ranges::any_of(m_pointerBounds, [&point](const Rect &bounds) {
+            return bounds.contains(point);
+        });
+        if (!nearEdge) {
+            return;
+        }
+    }
+
     bool activatedForClient = false;
     for (const auto &edge : m_edges) {
         if (!edge->isReserved() || edge->isBlocked()) {
@@ -1443,6 +1487,10 @@ void ScreenEdges::handlePointerMotion(const QPointF &pos, std::chrono::microseco
             }
         }
     }
+
+    m_pointerIdle = std::ranges::all_of(m_edges, [](const auto &edge) {
+        return edge->isIdle();
+    });
 }
 
 void ScreenEdges::setRemainActiveOnFullscreen(bool remainActive)
@@ -27,6 +27,7 @@
 #include <QList>
 #include <QObject>
 
+#include <array>
 #include <memory>
 #include <xcb/xcb.h>
 
@@ -129,6 +130,7 @@ private:
     void handleTouchCallback();
     void switchDesktop(const QPoint &cursorPos);
     void pushCursorBack(const QPoint &cursorPos);
+    bool isIdle() const;
     void reserveTouchCallBack(const TouchCallback &callback);
     QList<TouchCallback> touchCallBacks() const
     {
@@ -377,6 +379,7 @@ private:
     ElectricBorderAction actionForTouchEdge(Edge *edge) const;
     bool createEdgeForClient(Window *client, ElectricBorder border);
     void deleteEdgeForClient(Window *client);
+    void updatePointerBounds();
     bool m_desktopSwitching;
     bool m_desktopSwitchingMovingClients;
     QSize m_cursorPushBackDistance;
@@ -384,6 +387,10 @@ private:
     std::chrono::milliseconds m_reactivateThreshold = std::chrono::milliseconds::zero();
     Qt::Orientations m_virtualDesktopLayout;
     std::vector<std::unique_ptr<Edge>> m_edges;
+    // the area covered by the edges along the top, right, bottom and left border
+    std::array<Rect, 4> m_pointerBounds;
+    // no edge has any state that the pointer moving away from the edges could change
+    bool m_pointerIdle = false;
     KSharedConfig::Ptr m_config;
     KConfigWatcher::Ptr m_configWatcher;
     ElectricBorderAction m_actionTopLeft;
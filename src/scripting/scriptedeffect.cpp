@@ -299,7 +299,7 @@ bool ScriptedEffect::init(const QString &effectName, const QString &pathToScript
         globalObject.setProperty(propertyName, selfObject.property(propertyName));
     }
 
-    const QJSValue result = m_engine->evaluate(QString::fromUtf8(scriptFile.readAll()));
+    const QJSValue result = m_engine->evaluate(QString::fromUtf8(scriptFile.readAll()), pathToScript);
 
     if (result.isError()) {
         qCWarning(KWIN_SCRIPTING, "%s:%d: error: %s", qPrintable(scriptFile.fileName()),
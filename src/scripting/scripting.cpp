@@ -21,12 +21,14 @@
 #include "scriptingutils.h"
 #include "shortcuthandler.h"
 #include "virtualdesktopmodel.h"
+#include "windowchangewatcher.h"
 #include "windowmodel.h"
 #include "windowthumbnailitem.h"
 #include "workspace_wrapper.h"
 
 #include "core/output.h"
 #include "core/rect.h"
+#include "core/stallstatistics.h"
 #include "input.h"
 #include "options.h"
 #include "screenedge.h"
@@ -274,6 +276,7 @@ void KWin::Script::slotScriptLoadedFromFile()
     )"));
     Q_ASSERT(!result.isError());
 
+    const StallStatistics::Scope stallScope(StallSource::Scripting);
     result = m_engine->evaluate(QString::fromUtf8(watcher->result()), fileName());
     if (result.isError()) {
         qCWarning(KWIN_SCRIPTING, "%s:%d: error: %s", qPrintable(fileName()),
@@ -369,6 +372,7 @@ void KWin::Script::callDBus(const QString &service, const QString &path, const Q
             arguments << m_engine->toScriptValue(dbusToVariant(variant));
         }
 
+        const StallStatistics::Scope stallScope(StallSource::Scripting);
         QJSValue(callback).call(arguments);
     });
 }
@@ -388,6 +392,7 @@ bool KWin::Script::registerShortcut(const QString &objectName, const QString &te
     KGlobalAccel::self()->setShortcut(action, {shortcut});
 
     connect(action, &QAction::triggered, this, [this, action, callback]() {
+        const StallStatistics::Scope stallScope(StallSource::Scripting);
         QJSValue(callback).call({m_engine->toScriptValue(action)});
     });
 
@@ -439,6 +444,7 @@ bool KWin::Script::registerTouchScreenEdge(int edge, const QJSValue &callback)
     m_touchScreenEdgeCallbacks.insert(edge, action);
 
     connect(action, &QAction::triggered, this, [callback]() {
+        const StallStatistics::Scope stallScope(StallSource::Scripting);
         QJSValue(callback).call();
     });
 
@@ -473,6 +479,7 @@ QList<QAction *> KWin::Script::actionsForUserActionMenu(KWin::Window *client, QM
     actions.reserve(m_userActionsMenuCallbacks.count());
 
     for (QJSValue callback : std::as_const(m_userActionsMenuCallbacks)) {
+        const StallStatistics::Scope stallScope(StallSource::Scripting);
         const QJSValue result = callback.call({m_engine->toScriptValue(client)});
         if (result.isError()) {
             continue;
@@ -495,6 +502,7 @@ bool KWin::Script::slotBorderActivated(ElectricBorder border)
         return false;
     }
     std::for_each(callbacks.begin(), callbacks.end(), [](QJSValue callback) {
+        const StallStatistics::Scope stallScope(StallSource::Scripting);
         callback.call();
     });
     return true;
@@ -531,6 +539,7 @@ QAction *KWin::Script::createAction(const QString &title, const QJSValue &item,
     action->setChecked(checked);
 
     connect(action, &QAction::triggered, this, [this, action, callback]() {
+        const StallStatistics::Scope stallScope(StallSource::Scripting);
         QJSValue(callback).call({m_engine->toScriptValue(action)});
     });
 
@@ -697,6 +706,7 @@ void KWin::Scripting::init()
     qmlRegisterType<ShortcutHandler>("org.kde.kwin", 3, 0, "ShortcutHandler");
     qmlRegisterType<SwipeGestureHandler>("org.kde.kwin", 3, 0, "SwipeGestureHandler");
     qmlRegisterType<PinchGestureHandler>("org.kde.kwin", 3, 0, "PinchGestureHandler");
+    qmlRegisterType<WindowChangeWatcher>("org.kde.kwin", 3, 0, "WindowChangeWatcher");
     qmlRegisterType<WindowModel>("org.kde.kwin", 3, 0, "WindowModel");
     qmlRegisterType<WindowFilterModel>("org.kde.kwin", 3, 0, "WindowFilterModel");
     qmlRegisterType<VirtualDesktopModel>("org.kde.kwin", 3, 0, "VirtualDesktopModel");
@@ -0,0 +1,130 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "windowchangewatcher.h"
+#include "core/output.h"
+#include "scripting_logging.h"
+#include "window.h"
+#include "workspace.h"
+
+#include <QMetaMethod>
+
+#include <algorithm>
+
+namespace KWin
+{
+
+WindowChangeWatcher::WindowChangeWatcher(QObject *parent)
+    : QObject(parent)
+{
+    m_deliveryTimer.setSingleShot(true);
+    m_deliveryTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_deliveryTimer, &QTimer::timeout, this, &WindowChangeWatcher::deliver);
+
+    connect(workspace(), &Workspace::windowAdded, this, &WindowChangeWatcher::watch);
+    connect(workspace(), &Workspace::windowRemoved, this, &WindowChangeWatcher::unwatch);
+}
+
+QStringList WindowChangeWatcher::properties() const
+{
+    return m_properties;
+}
+
+void WindowChangeWatcher::setProperties(const QStringList &properties)
+{
+    if (m_properties == properties) {
+        return;
+    }
+
+    const QList<Window *> windows = workspace()->windows();
+    for (Window *window : windows) {
+        unwatch(window);
+    }
+
+    m_properties = properties;
+    m_propertiesBySignal.clear();
+    for (const QString &name : properties) {
+        const int index = Window::staticMetaObject.indexOfProperty(name.toUtf8().constData());
+        if (index == -1) {
+            qCWarning(KWIN_SCRIPTING) << "WindowChangeWatcher: there is no window property" << name;
+            continue;
+        }
+        const QMetaProperty property = Window::staticMetaObject.property(index);
+        if (!property.hasNotifySignal()) {
+            qCWarning(KWIN_SCRIPTING) << "WindowChangeWatcher: window property" << name << "has no change notifications";
+            continue;
+        }
+        // several properties can share the same change signal, e.g. the frame geometry and its size
+        m_propertiesBySignal[property.notifySignalIndex()].append(name);
+    }
+
+    for (Window *window : windows) {
+        watch(window);
+    }
+
+    Q_EMIT propertiesChanged();
+}
+
+void WindowChangeWatcher::watch(Window *window)
+{
+    static const QMetaMethod slot = staticMetaObject.method(staticMetaObject.indexOfSlot("handlePropertyChanged()"));
+    for (auto it = m_propertiesBySignal.cbegin(); it != m_propertiesBySignal.cend(); ++it) {
+        connect(window, Window::staticMetaObject.method(it.key()), this, slot);
+    }
+}
+
+void WindowChangeWatcher::unwatch(Window *window)
+{
+    disconnect(window, nullptr, this, nullptr);
+    if (m_changedProperties.remove(window)) {
+        m_changedWindows.removeOne(window);
+    }
+}
+
+void WindowChangeWatcher::handlePropertyChanged()
+{
+    Window *window = static_cast<Window *>(sender());
+    const QStringList properties = m_propertiesBySignal.value(senderSignalIndex());
+
+    auto it = m_changedProperties.find(window);
+    if (it == m_changedProperties.end()) {
+        it = m_changedProperties.insert(window, QStringList());
+        m_changedWindows.append(window);
+    }
+    for (const QString &property : properties) {
+        if (!it->contains(property)) {
+            it->append(property);
+        }
+    }
+
+    if (!m_deliveryTimer.isActive()) {
+        const LogicalOutput *output = workspace()->activeOutput();
+        const uint32_t refreshRate = output && output->refreshRate() ? output->refreshRate() : 60000;
+        m_deliveryTimer.start(std::max(1u, 1000000 / refreshRate));
+    }
+}
+
+void WindowChangeWatcher::deliver()
+{
+    QVariantList changes;
+    changes.reserve(m_changedWindows.size());
+    for (Window *window : std::as_const(m_changedWindows)) {
+        changes.append(QVariantMap{
+            {QStringLiteral("window"), QVariant::fromValue(window)},
+            {QStringLiteral("properties"), m_changedProperties.value(window)},
+        });
+    }
+    m_changedWindows.clear();
+    m_changedProperties.clear();
+
+    if (!changes.isEmpty()) {
+        Q_EMIT windowsChanged(changes);
+    }
+}
+
+} // namespace KWin
+
+#include "moc_windowchangewatcher.cpp"
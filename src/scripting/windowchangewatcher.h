@@ -0,0 +1,74 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <QVariantList>
+
+namespace KWin
+{
+class Window;
+
+/*!
+ * \qmltype WindowChangeWatcher
+ * \inqmlmodule org.kde.kwin
+ *
+ * \brief Reports changes of window properties in batches.
+ *
+ * Instead of connecting to the change signals of every window, scripts can list the window
+ * properties they are interested in and get notified about all changes at most once per refresh
+ * cycle of the active screen. Every burst of changes, e.g. while a window is being dragged, wakes
+ * up the script only once per frame with the windows and properties that have changed since.
+ *
+ * In plain JavaScript scripts, a watcher is created with workspace.createWindowChangeWatcher().
+ */
+class WindowChangeWatcher : public QObject
+{
+    Q_OBJECT
+
+    /*!
+     * \qmlproperty list<string> WindowChangeWatcher::properties
+     *
+     * The names of the window properties to watch, for example "frameGeometry" or "caption".
+     */
+    Q_PROPERTY(QStringList properties READ properties WRITE setProperties NOTIFY propertiesChanged)
+
+public:
+    explicit WindowChangeWatcher(QObject *parent = nullptr);
+
+    QStringList properties() const;
+    void setProperties(const QStringList &properties);
+
+Q_SIGNALS:
+    void propertiesChanged();
+    /*!
+     * \qmlsignal WindowChangeWatcher::windowsChanged(list<var> changes)
+     *
+     * Emitted with a list of objects with a \c window and a \c properties field, one for every
+     * window that had any of the watched properties changed since the last time.
+     */
+    void windowsChanged(const QVariantList &changes);
+
+private Q_SLOTS:
+    void handlePropertyChanged();
+
+private:
+    void watch(Window *window);
+    void unwatch(Window *window);
+    void deliver();
+
+    QStringList m_properties;
+    QHash<int, QStringList> m_propertiesBySignal;
+    QList<Window *> m_changedWindows;
+    QHash<Window *, QStringList> m_changedProperties;
+    QTimer m_deliveryTimer;
+};
+
+} // namespace KWin
@@ -18,6 +18,7 @@
 #include "scene/windowitem.h"
 #include "scene/workspacescene.h"
 #include "scripting_logging.h"
+#include "wayland_server.h"
 #include "window.h"
 #include "workspace.h"
 
@@ -29,6 +30,8 @@
 #include <QSGImageNode>
 #include <QSGTextureProvider>
 
+#include <cmath>
+
 namespace KWin
 {
 
@@ -109,16 +112,55 @@ WindowThumbnailSource::Frame WindowThumbnailSource::acquire()
     };
 }
 
+void WindowThumbnailSource::setRequestedScale(const WindowThumbnailItem *item, qreal scale)
+{
+    m_requestedScales.insert(item, scale);
+    updateTextureScale();
+}
+
+void WindowThumbnailSource::unsetRequestedScale(const WindowThumbnailItem *item)
+{
+    if (m_requestedScales.remove(item)) {
+        updateTextureScale();
+    }
+}
+
+void WindowThumbnailSource::updateTextureScale()
+{
+    qreal requestedScale = m_requestedScales.isEmpty() ? 1.0 : 0.0;
+    for (const qreal scale : std::as_const(m_requestedScales)) {
+        requestedScale = std::max(requestedScale, scale);
+    }
+
+    // Snap to powers of two so that resizing thumbnails, e.g. while animating, doesn't
+    // reallocate the texture all the time, and don't go below an eighth of the window size
+    qreal textureScale = 1.0;
+    if (requestedScale > 0.0 && requestedScale < 1.0) {
+        const int level = std::clamp(int(std::floor(std::log2(1.0 / requestedScale))), 0, 3);
+        textureScale = 1.0 / (1 << level);
+    }
+
+    if (m_textureScale != textureScale) {
+        m_textureScale = textureScale;
+        m_dirty = true;
+        Q_EMIT changed();
+    }
+}
+
 void WindowThumbnailSource::update()
 {
     if (m_acquireFence || !m_dirty || !m_handle) {
         return;
     }
+    // nothing but the lock screen can be seen, the thumbnail is brought up to date after unlocking
+    if (waylandServer()->isScreenLocked()) {
+        return;
+    }
     Q_ASSERT(m_view);
 
     const QRectF geometry = m_handle->visibleGeometry();
-    const qreal devicePixelRatio = m_view->devicePixelRatio();
-    const QSize textureSize = geometry.toAlignedRect().size() * devicePixelRatio;
+    const qreal scale = m_view->devicePixelRatio() * m_textureScale;
+    const QSize textureSize = (geometry.toAlignedRect().size() * scale).expandedTo(QSize(1, 1));
 
     if (!m_offscreenTexture || m_offscreenTexture->size() != textureSize) {
         m_offscreenTexture = GLTexture::allocate(GL_RGBA8, textureSize);
@@ -132,7 +174,7 @@ void WindowThumbnailSource::update()
     }
 
     RenderTarget offscreenRenderTarget(m_offscreenTarget.get());
-    RenderViewport offscreenViewport(geometry, devicePixelRatio, offscreenRenderTarget, QPoint());
+    RenderViewport offscreenViewport(geometry, scale, offscreenRenderTarget, QPoint());
     GLFramebuffer::pushFramebuffer(m_offscreenTarget.get());
     glClearColor(0.0, 0.0, 0.0, 0.0);
     glClear(GL_COLOR_BUFFER_BIT);
@@ -231,6 +273,9 @@ WindowThumbnailItem::WindowThumbnailItem(QQuickItem *parent)
 
 WindowThumbnailItem::~WindowThumbnailItem()
 {
+    if (m_source) {
+        m_source->unsetRequestedScale(this);
+    }
     if (m_provider) {
         if (window()) {
             window()->scheduleRenderJob(new ThumbnailTextureProviderCleanupJob(m_provider),
@@ -256,6 +301,14 @@ void WindowThumbnailItem::invalidateSceneGraph()
     m_provider = nullptr;
 }
 
+void WindowThumbnailItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        updateSourceScale();
+    }
+}
+
 void WindowThumbnailItem::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value)
 {
     if (change == QQuickItem::ItemSceneChange) {
@@ -282,17 +335,35 @@ QSGTextureProvider *WindowThumbnailItem::textureProvider() const
 
 void WindowThumbnailItem::resetSource()
 {
+    if (m_source) {
+        m_source->unsetRequestedScale(this);
+    }
     m_source.reset();
 }
 
 void WindowThumbnailItem::updateSource()
 {
+    resetSource();
     if (useGlThumbnails() && window() && m_client) {
         m_source = WindowThumbnailSource::getOrCreate(window(), m_client);
         connect(m_source.get(), &WindowThumbnailSource::changed, this, &WindowThumbnailItem::update);
-    } else {
-        m_source.reset();
+        updateSourceScale();
+    }
+}
+
+void WindowThumbnailItem::updateSourceScale()
+{
+    if (!m_source || !m_client) {
+        return;
+    }
+    const QSizeF frameSize = m_client->frameGeometry().size();
+    if (frameSize.isEmpty() || size().isEmpty()) {
+        // not laid out yet, it can't tell how big the window is going to be shown
+        m_source->unsetRequestedScale(this);
+        return;
     }
+    // the window is fitted into the item, see paintedRect()
+    m_source->setRequestedScale(this, std::min(width() / frameSize.width(), height() / frameSize.height()));
 }
 
 QSGNode *WindowThumbnailItem::updatePaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *)
@@ -386,6 +457,7 @@ void WindowThumbnailItem::updateImplicitSize()
         frameSize = m_client->frameGeometry().toAlignedRect().size();
     }
     setImplicitSize(frameSize.width(), frameSize.height());
+    updateSourceScale();
 }
 
 QRectF WindowThumbnailItem::paintedRect() const
@@ -19,6 +19,7 @@ class GLFramebuffer;
 class GLTexture;
 class ThumbnailTextureProvider;
 class WindowThumbnailSource;
+class WindowThumbnailItem;
 
 class WindowThumbnailSource : public QObject
 {
@@ -38,11 +39,20 @@ public:
 
     Frame acquire();
 
+    /**
+     * Sets the @\p scale at which @\p item shows the window. The window is rendered at the
+     * largest scale requested by the items showing it, rounded up to a power of two, so that
+     * small thumbnails don't hold textures as big as the window.
+     */
+    void setRequestedScale(const WindowThumbnailItem *item, qreal scale);
+    void unsetRequestedScale(const WindowThumbnailItem *item);
+
 Q_SIGNALS:
     void changed();
 
 private:
     void update();
+    void updateTextureScale();
 
     QPointer<QQuickWindow> m_view;
     QPointer<Window> m_handle;
@@ -51,6 +61,8 @@ private:
     std::unique_ptr<GLFramebuffer> m_offscreenTarget;
     GLsync m_acquireFence = 0;
     bool m_dirty = true;
+    QHash<const WindowThumbnailItem *, qreal> m_requestedScales;
+    qreal m_textureScale = 1.0;
 };
 
 /*!
@@ -89,6 +101,7 @@ public:
 
 protected:
     void releaseResources() override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
     void itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value) override;
 
 Q_SIGNALS:
@@ -112,6 +125,7 @@ private:
     QRectF paintedRect() const;
     void updateImplicitSize();
     void updateSource();
+    void updateSourceScale();
     void resetSource();
 
     QUuid m_wId;
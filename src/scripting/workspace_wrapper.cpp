@@ -13,11 +13,13 @@
 #include "core/outputbackend.h"
 #include "cursor.h"
 #include "effect/effecthandler.h"
+#include "geometryupdatebarrier.h"
 #include "outline.h"
 #include "scripting_logging.h"
 #include "tiles/tilemanager.h"
 #include "virtualdesktops.h"
 #include "window.h"
+#include "windowchangewatcher.h"
 #include "workspace.h"
 #if KWIN_BUILD_ACTIVITIES
 #include "activities.h"
@@ -335,6 +337,11 @@ void WorkspaceWrapper::unconstrain(KWin::Window *below, KWin::Window *above)
     KWin::Workspace::self()->unconstrain(below, above);
 }
 
+void WorkspaceWrapper::synchronizeGeometryUpdates(const QList<KWin::Window *> &windows)
+{
+    GeometryUpdateBarrier::synchronize(windows);
+}
+
 #if KWIN_BUILD_X11
 Window *WorkspaceWrapper::getClient(qulonglong windowId)
 {
@@ -373,6 +380,14 @@ QList<KWin::Window *> WorkspaceWrapper::windowAt(const QPointF &pos, int count)
     return result;
 }
 
+WindowChangeWatcher *WorkspaceWrapper::createWindowChangeWatcher(const QStringList &properties) const
+{
+    // without a parent, the js engine takes the ownership
+    auto watcher = new WindowChangeWatcher();
+    watcher->setProperties(properties);
+    return watcher;
+}
+
 bool WorkspaceWrapper::isEffectActive(const QString &pluginId) const
 {
     if (!effects) {
@@ -25,6 +25,7 @@ class TileManager;
 class Window;
 class LogicalOutput;
 class VirtualDesktop;
+class WindowChangeWatcher;
 
 class WorkspaceWrapper : public QObject
 {
@@ -324,6 +325,15 @@ public:
      */
     Q_INVOKABLE QList<KWin::Window *> windowAt(const QPointF &pos, int count = 1) const;
 
+    /**
+     * Creates a watcher that reports changes of the given window @p properties in batches,
+     * at most once per frame, see WindowChangeWatcher.
+     * @param properties The names of the window properties to watch
+     * @return A new WindowChangeWatcher owned by the script
+     * @since 6.7
+     */
+    Q_INVOKABLE KWin::WindowChangeWatcher *createWindowChangeWatcher(const QStringList &properties) const;
+
     /**
      * Checks if a specific effect is currently active.
      * @param pluginId The plugin Id of the effect to check.
@@ -352,6 +362,15 @@ public:
      */
     Q_INVOKABLE void unconstrain(KWin::Window *below, KWin::Window *above);
 
+    /**
+     * Shows the new geometry of the given @a windows in the same frame. Call it right after
+     * changing the geometry of several windows, e.g. when arranging them, so they don't move
+     * one after another as each client catches up.
+     *
+     * @since 6.7
+     */
+    Q_INVOKABLE void synchronizeGeometryUpdates(const QList<KWin::Window *> &windows);
+
 public Q_SLOTS:
     // all the available key bindings
     void slotSwitchDesktopNext();
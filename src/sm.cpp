@@ -100,6 +100,16 @@ void SessionManager::storeSession(const QString &sessionName, SMSavePhase phase)
     int active_client = -1;
 
 #if KWIN_BUILD_X11
+    // looking up every window in the stacking order would be quadratic in the number of windows
+    QHash<Window *, int> stackingOrder;
+    if (phase == SMSavePhase2 || phase == SMSavePhase2Full) {
+        const QList<Window *> unconstrainedStackingOrder = workspace()->unconstrainedStackingOrder();
+        stackingOrder.reserve(unconstrainedStackingOrder.size());
+        for (int i = 0; i < unconstrainedStackingOrder.size(); ++i) {
+            stackingOrder.insert(unconstrainedStackingOrder[i], i);
+        }
+    }
+
     const QList<Window *> windows = workspace()->windows();
     for (auto it = windows.begin(); it != windows.end(); ++it) {
         X11Window *c = qobject_cast<X11Window *>(*it);
@@ -125,7 +135,7 @@ void SessionManager::storeSession(const QString &sessionName, SMSavePhase phase)
             active_client = count;
         }
         if (phase == SMSavePhase2 || phase == SMSavePhase2Full) {
-            storeClient(cg, count, c);
+            storeClient(cg, count, c, stackingOrder.value(c, -1));
         }
     }
 #endif
@@ -147,7 +157,7 @@ void SessionManager::storeSession(const QString &sessionName, SMSavePhase phase)
 }
 
 #if KWIN_BUILD_X11
-void SessionManager::storeClient(KConfigGroup &cg, int num, X11Window *c)
+void SessionManager::storeClient(KConfigGroup &cg, int num, X11Window *c, int stackingOrder)
 {
     c->setSessionActivityOverride(false); // make sure we get the real values
     QString n = QString::number(num);
@@ -177,7 +187,7 @@ void SessionManager::storeClient(KConfigGroup &cg, int num, X11Window *c)
     cg.writeEntry(QLatin1StringView("decorationPolicy") + n, uint(c->decorationPolicy()));
     cg.writeEntry(QLatin1StringView("windowType") + n, windowTypeToTxt(c->windowType()));
     cg.writeEntry(QLatin1StringView("shortcut") + n, c->shortcut().toString());
-    cg.writeEntry(QLatin1StringView("stackingOrder") + n, workspace()->unconstrainedStackingOrder().indexOf(c));
+    cg.writeEntry(QLatin1StringView("stackingOrder") + n, stackingOrder);
     cg.writeEntry(QLatin1StringView("activities") + n, c->activities());
 }
 #endif
@@ -260,43 +270,33 @@ std::optional<SessionInfo> SessionManager::takeSessionInfo(X11Window *c)
     QString resourceClass = c->resourceClass();
 
     // First search ``session''
+    auto it = session.end();
     if (!sessionId.isEmpty()) {
         // look for a real session managed client (algorithm suggested by ICCCM)
-        for (const SessionInfo &info : std::as_const(session)) {
-            if (realInfo) {
-                break;
+        it = std::ranges::find_if(session, [&](const SessionInfo &info) {
+            if (info.sessionId != sessionId || !sessionInfoWindowTypeMatch(c, info)) {
+                return false;
             }
-            if (info.sessionId == sessionId && sessionInfoWindowTypeMatch(c, info)) {
-                if (!windowRole.isEmpty()) {
-                    if (info.windowRole == windowRole) {
-                        realInfo = info;
-                        session.removeAll(info);
-                    }
-                } else {
-                    if (info.windowRole.isEmpty()
-                        && info.resourceName == resourceName
-                        && info.resourceClass == resourceClass) {
-                        realInfo = info;
-                        session.removeAll(info);
-                    }
-                }
+            if (!windowRole.isEmpty()) {
+                return info.windowRole == windowRole;
             }
-        }
+            return info.windowRole.isEmpty()
+                && info.resourceName == resourceName
+                && info.resourceClass == resourceClass;
+        });
     } else {
         // look for a sessioninfo with matching features.
-        for (const SessionInfo &info : std::as_const(session)) {
-            if (realInfo) {
-                break;
-            }
-            if (info.resourceName == resourceName
+        it = std::ranges::find_if(session, [&](const SessionInfo &info) {
+            return info.resourceName == resourceName
                 && info.resourceClass == resourceClass
-                && sessionInfoWindowTypeMatch(c, info)) {
-                if (wmCommand.isEmpty() || info.wmCommand == wmCommand) {
-                    realInfo = info;
-                    session.removeAll(info);
-                }
-            }
-        }
+                && sessionInfoWindowTypeMatch(c, info)
+                && (wmCommand.isEmpty() || info.wmCommand == wmCommand);
+        });
+    }
+    if (it != session.end()) {
+        // only remove the matched entry, identical entries belong to other windows
+        realInfo = std::move(*it);
+        session.erase(it);
     }
     return realInfo;
 }
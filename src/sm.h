@@ -70,7 +70,7 @@ private:
 
     void storeSession(const QString &sessionName, SMSavePhase phase);
 #if KWIN_BUILD_X11
-    void storeClient(KConfigGroup &cg, int num, X11Window *c);
+    void storeClient(KConfigGroup &cg, int num, X11Window *c, int stackingOrder);
 #endif
     void loadSessionInfo(const QString &sessionName);
     void addSessionInfo(KConfigGroup &cg);
@@ -0,0 +1,107 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "startupprofiler.h"
+#include "ftrace.h"
+#include "utils/common.h"
+#include "utils/envvar.h"
+
+#include <time.h>
+
+namespace KWin
+{
+
+static std::chrono::nanoseconds processCpuTime()
+{
+    timespec ts;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+        return std::chrono::nanoseconds::zero();
+    }
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+static double toMilliseconds(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+StartupProfiler::StartupProfiler()
+    : m_enabled(environmentVariableBoolValue("KWIN_STARTUP_PROFILE").value_or(false))
+    , m_start(std::chrono::steady_clock::now())
+{
+}
+
+StartupProfiler::~StartupProfiler() = default;
+
+bool StartupProfiler::isEnabled() const
+{
+    return m_enabled;
+}
+
+void StartupProfiler::beginStage(const QByteArray &name)
+{
+    if (!m_enabled) {
+        return;
+    }
+    endStage();
+    m_currentStage = name;
+    m_stageStart = std::chrono::steady_clock::now();
+    m_stageCpuStart = processCpuTime();
+    if (FTraceLogger::self() && FTraceLogger::self()->isEnabled()) {
+        m_stageTrace = std::make_unique<FTraceDuration>("Startup: ", name);
+    }
+}
+
+void StartupProfiler::endStage()
+{
+    if (!m_enabled || m_currentStage.isEmpty()) {
+        return;
+    }
+    m_stageTrace.reset();
+    m_stages.append(Stage{
+        .name = m_currentStage,
+        .wallTime = std::chrono::steady_clock::now() - m_stageStart,
+        .cpuTime = processCpuTime() - m_stageCpuStart,
+    });
+    m_currentStage.clear();
+}
+
+void StartupProfiler::addMilestone(const QByteArray &name)
+{
+    if (!m_enabled) {
+        return;
+    }
+    const std::chrono::nanoseconds timestamp = std::chrono::steady_clock::now() - m_start;
+    fTrace("Startup: ", name);
+    if (m_finished) {
+        qCInfo(KWIN_CORE, "Startup milestone %s: %.1f ms", name.constData(), toMilliseconds(timestamp));
+    } else {
+        m_milestones.append(Milestone{
+            .name = name,
+            .timestamp = timestamp,
+        });
+    }
+}
+
+void StartupProfiler::finish()
+{
+    if (!m_enabled || m_finished) {
+        return;
+    }
+    endStage();
+    m_finished = true;
+
+    qCInfo(KWIN_CORE, "Startup profile, %.1f ms since start:", toMilliseconds(std::chrono::steady_clock::now() - m_start));
+    for (const Stage &stage : std::as_const(m_stages)) {
+        qCInfo(KWIN_CORE, "  %-24s wall %8.1f ms  cpu %8.1f ms", stage.name.constData(), toMilliseconds(stage.wallTime), toMilliseconds(stage.cpuTime));
+    }
+    for (const Milestone &milestone : std::as_const(m_milestones)) {
+        qCInfo(KWIN_CORE, "  %-24s at   %8.1f ms", milestone.name.constData(), toMilliseconds(milestone.timestamp));
+    }
+    m_stages.clear();
+    m_milestones.clear();
+}
+
+} // namespace KWin
@@ -0,0 +1,78 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "kwin_export.h"
+
+#include <QByteArray>
+#include <QList>
+
+#include <chrono>
+#include <memory>
+
+namespace KWin
+{
+
+class FTraceDuration;
+
+/**
+ * The StartupProfiler class measures how long the stages of bringing up the session take.
+ *
+ * Every stage records the wall clock time and the CPU time of the process that were spent in
+ * it, and shows up as a span in ftrace if tracing is enabled. Milestones, such as the first
+ * presented frame, record the time elapsed since the profiler was created. The report is
+ * written to the log once finish() is called.
+ *
+ * The profiler is enabled by setting the KWIN_STARTUP_PROFILE environment variable to 1.
+ */
+class KWIN_EXPORT StartupProfiler
+{
+public:
+    StartupProfiler();
+    ~StartupProfiler();
+
+    bool isEnabled() const;
+
+    /**
+     * Ends the current stage, if any, and starts the stage @p name.
+     */
+    void beginStage(const QByteArray &name);
+    void endStage();
+
+    void addMilestone(const QByteArray &name);
+
+    /**
+     * Ends the current stage and writes the report. Milestones added afterwards are logged
+     * right away.
+     */
+    void finish();
+
+private:
+    struct Stage
+    {
+        QByteArray name;
+        std::chrono::nanoseconds wallTime;
+        std::chrono::nanoseconds cpuTime;
+    };
+
+    struct Milestone
+    {
+        QByteArray name;
+        std::chrono::nanoseconds timestamp;
+    };
+
+    const bool m_enabled;
+    const std::chrono::steady_clock::time_point m_start;
+    QByteArray m_currentStage;
+    std::chrono::steady_clock::time_point m_stageStart;
+    std::chrono::nanoseconds m_stageCpuStart{0};
+    std::unique_ptr<FTraceDuration> m_stageTrace;
+    QList<Stage> m_stages;
+    QList<Milestone> m_milestones;
+    bool m_finished = false;
+};
+
+} // namespace KWin
@@ -14,6 +14,7 @@
 #include <KLocalizedString>
 
 #include <QIcon>
+#include <QSet>
 #include <QUuid>
 
 #include <cmath>
@@ -235,13 +236,48 @@ void ClientModel::createClientList(bool partialReset)
         }
     }
 
-    if (m_clientList == m_mutableClientList) {
+    updateClientList(m_mutableClientList);
+}
+
+void ClientModel::updateClientList(const QList<Window *> &clients)
+{
+    if (m_clientList == clients) {
         return;
     }
 
-    beginResetModel();
-    m_clientList = m_mutableClientList;
-    endResetModel();
+    // Apply the new list row by row rather than resetting the model, so the delegates of the
+    // windows that stay in the list, and their thumbnails, don't have to be recreated
+    const QSet<Window *> kept(clients.cbegin(), clients.cend());
+    for (int i = m_clientList.size() - 1; i >= 0; --i) {
+        if (!kept.contains(m_clientList[i])) {
+            beginRemoveRows(QModelIndex(), i, i);
+            m_clientList.removeAt(i);
+            endRemoveRows();
+        }
+    }
+
+    for (int i = 0; i < clients.size(); ++i) {
+        Window *client = clients[i];
+        if (i < m_clientList.size() && m_clientList[i] == client) {
+            continue;
+        }
+        const int from = m_clientList.indexOf(client, i);
+        if (from != -1) {
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), i);
+            m_clientList.move(from, i);
+            endMoveRows();
+        } else {
+            beginInsertRows(QModelIndex(), i, i);
+            m_clientList.insert(i, client);
+            endInsertRows();
+        }
+    }
+
+    if (m_clientList.size() > clients.size()) {
+        beginRemoveRows(QModelIndex(), clients.size(), m_clientList.size() - 1);
+        m_clientList.resize(clients.size());
+        endRemoveRows();
+    }
 }
 
 void ClientModel::close(int i)
@@ -63,7 +63,7 @@ public:
 
     /**
      * Generates a new list of Windows based on the current config.
-     * Calling this method will reset the model. If partialReset is true
+     * The model is updated with row inserts, removals and moves. If partialReset is true
      * the top of the list is kept as a starting point. If not the
      * current active client is used as the starting point to generate the
      * list.
@@ -89,6 +89,10 @@ public Q_SLOTS:
 private:
     void createFocusChainClientList(Window *start);
     void createStackingOrderClientList(Window *start);
+    /**
+     * Turns the current list of Windows into @p clients with fine grained row changes.
+     */
+    void updateClientList(const QList<Window *> &clients);
 
     QList<Window *> m_clientList;
     QList<Window *> m_mutableClientList;
@@ -252,8 +252,8 @@ void TabletInputRedirection::tabletToolAxisEvent(const QPointF &pos, qreal press
         .tool = tool,
     };
 
-    input()->processSpies(&InputEventSpy::tabletToolAxisEvent, &ev);
-    input()->processFilters(&InputEventFilter::tabletToolAxisEvent, &ev);
+    input()->processSpies(InputEventType::Tablet, &InputEventSpy::tabletToolAxisEvent, &ev);
+    input()->processFilters(InputEventType::Tablet, &InputEventFilter::tabletToolAxisEvent, &ev);
     input()->setLastInputHandler(this);
 }
 
@@ -284,8 +284,8 @@ void TabletInputRedirection::tabletToolAxisEventRelative(const QPointF &delta,
         .tool = tool,
     };
 
-    input()->processSpies(&InputEventSpy::tabletToolAxisEvent, &ev);
-    input()->processFilters(&InputEventFilter::tabletToolAxisEvent, &ev);
+    input()->processSpies(InputEventType::Tablet, &InputEventSpy::tabletToolAxisEvent, &ev);
+    input()->processFilters(InputEventType::Tablet, &InputEventFilter::tabletToolAxisEvent, &ev);
     input()->setLastInputHandler(this);
 }
 
@@ -322,8 +322,8 @@ void TabletInputRedirection::tabletToolProximityEvent(const QPointF &pos, qreal
         .tool = tool,
     };
 
-    input()->processSpies(&InputEventSpy::tabletToolProximityEvent, &ev);
-    input()->processFilters(&InputEventFilter::tabletToolProximityEvent, &ev);
+    input()->processSpies(InputEventType::Tablet, &InputEventSpy::tabletToolProximityEvent, &ev);
+    input()->processFilters(InputEventType::Tablet, &InputEventFilter::tabletToolProximityEvent, &ev);
     input()->setLastInputHandler(this);
 }
 
@@ -363,8 +363,8 @@ void TabletInputRedirection::tabletToolTipEvent(const QPointF &pos, qreal pressu
         .tool = tool,
     };
 
-    input()->processSpies(&InputEventSpy::tabletToolTipEvent, &ev);
-    input()->processFilters(&InputEventFilter::tabletToolTipEvent, &ev);
+    input()->processSpies(InputEventType::Tablet, &InputEventSpy::tabletToolTipEvent, &ev);
+    input()->processFilters(InputEventType::Tablet, &InputEventFilter::tabletToolTipEvent, &ev);
     input()->setLastInputHandler(this);
     if (tipDown) {
         input()->setLastInteractionSerial(waylandServer()->seat()->display()->serial());
@@ -388,8 +388,8 @@ void KWin::TabletInputRedirection::tabletToolButtonEvent(uint button, bool isPre
 
     m_buttonDown = isPressed;
 
-    input()->processSpies(&InputEventSpy::tabletToolButtonEvent, &event);
-    input()->processFilters(&InputEventFilter::tabletToolButtonEvent, &event);
+    input()->processSpies(InputEventType::Tablet, &InputEventSpy::tabletToolButtonEvent, &event);
+    input()->processFilters(InputEventType::Tablet, &InputEventFilter::tabletToolButtonEvent, &event);
     input()->setLastInputHandler(this);
     if (isPressed) {
         input()->setLastInteractionSerial(waylandServer()->seat()->display()->serial());
@@ -410,8 +410,8 @@ void KWin::TabletInputRedirection::tabletPadButtonEvent(uint button, bool isPres
         .isModeSwitch = isModeSwitch,
         .time = time,
     };
-    input()->processSpies(&InputEventSpy::tabletPadButtonEvent, &event);
-    input()->processFilters(&InputEventFilter::tabletPadButtonEvent, &event);
+    input()->processSpies(InputEventType::Tablet, &InputEventSpy::tabletPadButtonEvent, &event);
+    input()->processFilters(InputEventType::Tablet, &InputEventFilter::tabletPadButtonEvent, &event);
     input()->setLastInputHandler(this);
     if (isPressed) {
         input()->setLastInteractionSerial(waylandServer()->seat()->display()->serial());
@@ -433,8 +433,8 @@ void KWin::TabletInputRedirection::tabletPadStripEvent(int number, qreal positio
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::tabletPadStripEvent, &event);
-    input()->processFilters(&InputEventFilter::tabletPadStripEvent, &event);
+    input()->processSpies(InputEventType::Tablet, &InputEventSpy::tabletPadStripEvent, &event);
+    input()->processFilters(InputEventType::Tablet, &InputEventFilter::tabletPadStripEvent, &event);
     input()->setLastInputHandler(this);
 }
 
@@ -450,8 +450,8 @@ void KWin::TabletInputRedirection::tabletPadRingEvent(int number, qreal position
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::tabletPadRingEvent, &event);
-    input()->processFilters(&InputEventFilter::tabletPadRingEvent, &event);
+    input()->processSpies(InputEventType::Tablet, &InputEventSpy::tabletPadRingEvent, &event);
+    input()->processFilters(InputEventType::Tablet, &InputEventFilter::tabletPadRingEvent, &event);
     input()->setLastInputHandler(this);
 }
 
@@ -466,8 +466,8 @@ void KWin::TabletInputRedirection::tabletPadDialEvent(int number, double delta,
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::tabletPadDialEvent, &event);
-    input()->processFilters(&InputEventFilter::tabletPadDialEvent, &event);
+    input()->processSpies(InputEventType::Tablet, &InputEventSpy::tabletPadDialEvent, &event);
+    input()->processFilters(InputEventType::Tablet, &InputEventFilter::tabletPadDialEvent, &event);
     input()->setLastInputHandler(this);
 }
 
@@ -56,6 +56,9 @@ void CustomTile::setRelativeGeometry(const RectF &geom)
         return;
     }
 
+    // The neighbours and children get adjusted along, resize their windows only once at the end
+    TileGeometryUpdatesBlocker blocker(m_tiling);
+
     RectF finalGeom = geom.intersected(RectF(0, 0, 1, 1));
     finalGeom.setWidth(std::max(finalGeom.width(), minimumSize().width()));
     finalGeom.setHeight(std::max(finalGeom.height(), minimumSize().height()));
@@ -193,6 +196,7 @@ bool CustomTile::supportsResizeGravity(KWin::Gravity gravity)
 QList<CustomTile *> CustomTile::split(KWin::Tile::LayoutDirection newDirection)
 {
     auto *parentT = static_cast<CustomTile *>(parentTile());
+    TileGeometryUpdatesBlocker blocker(m_tiling);
 
     QList<CustomTile *> splitTiles;
 
@@ -278,6 +282,7 @@ void CustomTile::remove()
 
     auto *prev = previousSibling();
     auto *next = nextSibling();
+    TileGeometryUpdatesBlocker blocker(m_tiling);
 
     TileModel *model = static_cast<RootTile *>(rootTile())->model();
     model->beginRemoveTile(this);
@@ -133,15 +133,32 @@ void Tile::setRelativeGeometry(const RectF &geom)
 
     m_relativeGeometry = constrainedGeom;
 
+    if (!m_tiling->deferGeometryChange(this)) {
+        notifyGeometryChanged();
+    }
+
+    updateWindowGeometries();
+}
+
+void Tile::notifyGeometryChanged()
+{
     Q_EMIT relativeGeometryChanged();
     Q_EMIT absoluteGeometryChanged();
     Q_EMIT windowGeometryChanged();
+}
 
-    if (isActive()) {
-        for (auto *w : std::as_const(m_windows)) {
-            // Resize only if we are the currently managing tile for that window
-            w->moveResize(windowGeometry());
-        }
+void Tile::updateWindowGeometries()
+{
+    // Resize only if we are the currently managing tile for that window
+    if (!isActive() || m_tiling->deferWindowGeometryUpdate(this)) {
+        return;
+    }
+    if (m_windows.isEmpty()) {
+        return;
+    }
+    const RectF geometry = windowGeometry();
+    for (auto *w : std::as_const(m_windows)) {
+        w->moveResize(geometry);
     }
 }
 
@@ -243,12 +260,7 @@ void Tile::setPadding(qreal padding)
     for (auto *t : std::as_const(m_children)) {
         t->setPadding(padding);
     }
-    if (isActive()) {
-        for (auto *w : std::as_const(m_windows)) {
-            // Resize only if we are the currently managing tile for that window
-            w->moveResize(windowGeometry());
-        }
-    }
+    updateWindowGeometries();
 
     Q_EMIT paddingChanged(padding);
     Q_EMIT windowGeometryChanged();
@@ -59,6 +59,16 @@ public:
 
     virtual bool supportsResizeGravity(Gravity gravity);
 
+    /**
+     * Resizes the windows in this tile to windowGeometry() if it's the tile managing them.
+     */
+    void updateWindowGeometries();
+    /**
+     * Emits the geometry change signals, TileManager calls it for the tiles whose
+     * signals have been deferred.
+     */
+    void notifyGeometryChanged();
+
     /**
      * Geometry of the tile in units between 0 and 1 relative to the screen geometry
      */
@@ -9,6 +9,7 @@
 
 #include "tilemanager.h"
 #include "core/backendoutput.h"
+#include "geometryupdatebarrier.h"
 #include "quicktile.h"
 #include "virtualdesktops.h"
 #include "window.h"
@@ -97,6 +98,57 @@ TileManager::~TileManager()
     m_tearingDown = true;
 }
 
+void TileManager::blockWindowGeometryUpdates()
+{
+    m_windowGeometryUpdatesBlocked++;
+}
+
+void TileManager::unblockWindowGeometryUpdates()
+{
+    Q_ASSERT(m_windowGeometryUpdatesBlocked > 0);
+    if (--m_windowGeometryUpdatesBlocked > 0) {
+        return;
+    }
+    const QList<QPointer<Tile>> changedTiles = std::exchange(m_pendingGeometryChanges, {});
+    for (Tile *tile : changedTiles) {
+        if (tile) {
+            tile->notifyGeometryChanged();
+        }
+    }
+    const QList<QPointer<Tile>> tiles = std::exchange(m_pendingWindowGeometryUpdates, {});
+    QList<Window *> windows;
+    for (Tile *tile : tiles) {
+        if (tile) {
+            tile->updateWindowGeometries();
+            windows.append(tile->windows());
+        }
+    }
+    // show the windows in their new tiles together, not as each client gets to it
+    GeometryUpdateBarrier::synchronize(windows);
+}
+
+bool TileManager::deferWindowGeometryUpdate(Tile *tile)
+{
+    if (!m_windowGeometryUpdatesBlocked) {
+        return false;
+    }
+    if (!m_pendingWindowGeometryUpdates.contains(tile)) {
+        m_pendingWindowGeometryUpdates.append(tile);
+    }
+    return true;
+}
+
+bool TileManager::deferGeometryChange(Tile *tile)
+{
+    if (!m_windowGeometryUpdatesBlocked) {
+        return false;
+    }
+    if (!m_pendingGeometryChanges.contains(tile)) {
+        m_pendingGeometryChanges.append(tile);
+    }
+    return true;
+}
+
 bool TileManager::tearingDown() const
 {
     return m_tearingDown;
@@ -18,6 +18,7 @@
 
 #include <QAbstractItemModel>
 #include <QObject>
+#include <QPointer>
 
 #include <QJsonValue>
 
@@ -59,6 +60,26 @@ public:
     Tile *tileForWindow(Window *window, VirtualDesktop *desktop);
     void forgetWindow(Window *window, VirtualDesktop *desktop);
 
+    /**
+     * While blocked, the windows of tiles whose geometry changes aren't resized right away,
+     * but once when the outermost block is lifted. A layout change usually touches a tile
+     * several times, e.g. its neighbours and parent adjust it, and resizing the windows only
+     * for the final geometry avoids configuring clients with intermediate geometries.
+     *
+     * The geometry change signals of the tiles are deferred the same way, so a splitter drag
+     * in the tiles editor updates each tile once per step rather than once per adjustment.
+     */
+    void blockWindowGeometryUpdates();
+    void unblockWindowGeometryUpdates();
+    /**
+     * Returns @c true if the window geometry updates of @p tile have been deferred.
+     */
+    bool deferWindowGeometryUpdate(Tile *tile);
+    /**
+     * Returns @c true if the geometry change signals of @p tile have been deferred.
+     */
+    bool deferGeometryChange(Tile *tile);
+
 Q_SIGNALS:
     void tileRemoved(KWin::Tile *tile);
     void rootTileChanged(CustomTile *rootTile);
@@ -79,9 +100,29 @@ private:
     QHash<VirtualDesktop *, QuickRootTile *> m_quickRootTiles;
 
     bool m_tearingDown = false;
+    int m_windowGeometryUpdatesBlocked = 0;
+    QList<QPointer<Tile>> m_pendingWindowGeometryUpdates;
+    QList<QPointer<Tile>> m_pendingGeometryChanges;
     friend class CustomTile;
 };
 
+class TileGeometryUpdatesBlocker
+{
+public:
+    explicit TileGeometryUpdatesBlocker(TileManager *manager)
+        : m_manager(manager)
+    {
+        m_manager->blockWindowGeometryUpdates();
+    }
+    ~TileGeometryUpdatesBlocker()
+    {
+        m_manager->unblockWindowGeometryUpdates();
+    }
+
+private:
+    TileManager *m_manager;
+};
+
 KWIN_EXPORT QDebug operator<<(QDebug debug, const TileManager *tileManager);
 
 } // namespace KWin
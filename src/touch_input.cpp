@@ -11,10 +11,12 @@
 
 #include "config-kwin.h"
 
+#include "core/output.h"
 #include "decorations/decoratedwindow.h"
 #include "input_event.h"
 #include "input_event_spy.h"
 #include "pointer_input.h"
+#include "utils/envvar.h"
 #include "wayland/display.h"
 #include "wayland/seat.h"
 #include "wayland_server.h"
@@ -33,9 +35,14 @@
 namespace KWin
 {
 
+static const bool s_coalesceMotion = environmentVariableBoolValue("KWIN_TOUCH_MOTION_COALESCING").value_or(true);
+
 TouchInputRedirection::TouchInputRedirection(InputRedirection *parent)
     : InputDeviceHandler(parent)
 {
+    m_coalescedMotionTimer.setSingleShot(true);
+    m_coalescedMotionTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_coalescedMotionTimer, &QTimer::timeout, this, &TouchInputRedirection::flushCoalescedMotion);
 }
 
 TouchInputRedirection::~TouchInputRedirection() = default;
@@ -111,6 +118,7 @@ void TouchInputRedirection::processDown(qint32 id, const QPointF &pos, std::chro
     if (!inited()) {
         return;
     }
+    flushCoalescedMotion();
     m_lastPosition = pos;
     m_windowUpdatedInCycle = false;
     m_activeTouchPoints.insert(id);
@@ -126,8 +134,8 @@ void TouchInputRedirection::processDown(qint32 id, const QPointF &pos, std::chro
         .time = time,
     };
 
-    input()->processSpies(&InputEventSpy::touchDown, &event);
-    input()->processFilters(&InputEventFilter::touchDown, &event);
+    input()->processSpies(InputEventType::Touch, &InputEventSpy::touchDown, &event);
+    input()->processFilters(InputEventType::Touch, &InputEventFilter::touchDown, &event);
     m_windowUpdatedInCycle = false;
     input()->setLastInteractionSerial(waylandServer()->seat()->display()->serial());
     if (auto f = focus()) {
@@ -143,6 +151,7 @@ void TouchInputRedirection::processUp(qint32 id, std::chrono::microseconds time,
     if (!m_activeTouchPoints.remove(id)) {
         return;
     }
+    flushCoalescedMotion();
     input()->setLastInputHandler(this);
 
     TouchUpEvent event{
@@ -151,8 +160,8 @@ void TouchInputRedirection::processUp(qint32 id, std::chrono::microseconds time,
     };
 
     m_windowUpdatedInCycle = false;
-    input()->processSpies(&InputEventSpy::touchUp, &event);
-    input()->processFilters(&InputEventFilter::touchUp, &event);
+    input()->processSpies(InputEventType::Touch, &InputEventSpy::touchUp, &event);
+    input()->processFilters(InputEventType::Touch, &InputEventFilter::touchUp, &event);
     m_windowUpdatedInCycle = false;
     if (m_activeTouchPoints.count() == 0) {
         update();
@@ -177,8 +186,8 @@ void TouchInputRedirection::processMotion(qint32 id, const QPointF &pos, std::ch
     };
 
     m_windowUpdatedInCycle = false;
-    input()->processSpies(&InputEventSpy::touchMotion, &event);
-    input()->processFilters(&InputEventFilter::touchMotion, &event);
+    input()->processSpies(InputEventType::Touch, &InputEventSpy::touchMotion, &event);
+    input()->processFilters(InputEventType::Touch, &InputEventFilter::touchMotion, &event);
     m_windowUpdatedInCycle = false;
 }
 
@@ -191,9 +200,12 @@ void TouchInputRedirection::cancel()
     // up events will be silently ignored and won't be passed down through the event filter chain.
     // If the touch sequence is cancelled because we received a TOUCH_CANCEL event from libinput,
     // the compositor will not receive any TOUCH_MOTION or TOUCH_UP events for that slot.
+    // the cancelled touch points won't get motion events anymore
+    m_coalescedMotion.clear();
+    m_coalescedMotionTimer.stop();
     if (!m_activeTouchPoints.isEmpty()) {
         m_activeTouchPoints.clear();
-        input()->processFilters(&InputEventFilter::touchCancel);
+        input()->processFilters(InputEventType::Touch, &InputEventFilter::touchCancel);
     }
 }
 
@@ -202,7 +214,42 @@ void TouchInputRedirection::frame()
     if (!inited() || !waylandServer()->seat()->hasTouch()) {
         return;
     }
-    input()->processFilters(&InputEventFilter::touchFrame);
+    input()->processFilters(InputEventType::Touch, &InputEventFilter::touchFrame);
+}
+
+bool TouchInputRedirection::coalesceMotion(const TouchMotionEvent *event)
+{
+    if (!s_coalesceMotion) {
+        return false;
+    }
+    m_coalescedMotion[event->id] = event->pos;
+    m_coalescedMotionTime = event->time;
+    if (!m_coalescedMotionTimer.isActive()) {
+        const LogicalOutput *output = workspace()->outputAt(event->pos);
+        const uint32_t refreshRate = output && output->refreshRate() ? output->refreshRate() : 60000;
+        m_coalescedMotionTimer.start(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::microseconds(1'000'000'000 / refreshRate)));
+    }
+    return true;
+}
+
+bool TouchInputRedirection::hasCoalescedMotion() const
+{
+    return !m_coalescedMotion.empty();
+}
+
+void TouchInputRedirection::flushCoalescedMotion()
+{
+    m_coalescedMotionTimer.stop();
+    const std::map<qint32, QPointF> motion = std::exchange(m_coalescedMotion, {});
+    if (motion.empty()) {
+        return;
+    }
+    auto seat = waylandServer()->seat();
+    seat->setTimestamp(m_coalescedMotionTime);
+    for (const auto &[id, position] : motion) {
+        seat->notifyTouchMotion(id, position);
+    }
+    seat->notifyTouchFrame();
 }
 
 }
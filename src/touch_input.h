@@ -14,6 +14,9 @@
 #include <QObject>
 #include <QPointF>
 #include <QPointer>
+#include <QTimer>
+
+#include <map>
 
 namespace KWin
 {
@@ -63,6 +66,23 @@ public:
         return m_activeTouchPoints.count();
     }
 
+    /**
+     * @internal
+     * Defers sending the motion in @p event to the client, so that it can be merged with the
+     * motion of the same touch point that follows until the next refresh of the output under
+     * the touch point. Returns @c false if the motion has to be sent right away.
+     */
+    bool coalesceMotion(const TouchMotionEvent *event);
+    /**
+     * @internal
+     */
+    bool hasCoalescedMotion() const;
+    /**
+     * @internal
+     * Sends the deferred motion of all touch points, if any, followed by a frame.
+     */
+    void flushCoalescedMotion();
+
 private:
     void cleanupDecoration(Decoration::DecoratedWindowImpl *old, Decoration::DecoratedWindowImpl *now) override;
 
@@ -72,6 +92,9 @@ private:
     qint32 m_decorationId = -1;
     bool m_windowUpdatedInCycle = false;
     QPointF m_lastPosition;
+    std::map<qint32, QPointF> m_coalescedMotion;
+    std::chrono::microseconds m_coalescedMotionTime = std::chrono::microseconds::zero();
+    QTimer m_coalescedMotionTimer;
 };
 
 }
@@ -266,10 +266,49 @@ CursorTheme::CursorTheme()
 {
 }
 
+namespace
+{
+struct CursorThemeCacheEntry
+{
+    QString name;
+    int size;
+    qreal devicePixelRatio;
+    QStringList searchPaths;
+    QSharedDataPointer<CursorThemePrivate> theme;
+};
+}
+
+// The pointer needs the theme at the scale of the output it's on, and it goes back and forth
+// between outputs with different scales. Keep the last few themes around together with their
+// already loaded sprites so coming back to an output doesn't discover and load the theme again.
+static constexpr int s_cursorThemeCacheSize = 4;
+
 CursorTheme::CursorTheme(const QString &themeName, int size, qreal devicePixelRatio, const QStringList &searchPaths)
-    : d(new CursorThemePrivate(themeName, size, devicePixelRatio))
 {
+    static QList<CursorThemeCacheEntry> cache;
+
+    const auto it = std::find_if(cache.begin(), cache.end(), [&](const CursorThemeCacheEntry &entry) {
+        return entry.name == themeName && entry.size == size && entry.devicePixelRatio == devicePixelRatio && entry.searchPaths == searchPaths;
+    });
+    if (it != cache.end()) {
+        d = it->theme;
+        cache.move(std::distance(cache.begin(), it), 0);
+        return;
+    }
+
+    d = new CursorThemePrivate(themeName, size, devicePixelRatio);
     d->discover(searchPaths);
+
+    cache.prepend(CursorThemeCacheEntry{
+        .name = themeName,
+        .size = size,
+        .devicePixelRatio = devicePixelRatio,
+        .searchPaths = searchPaths,
+        .theme = d,
+    });
+    if (cache.size() > s_cursorThemeCacheSize) {
+        cache.removeLast();
+    }
 }
 
 CursorTheme::CursorTheme(const CursorTheme &other)
@@ -10,11 +10,17 @@
 
 #include <QList>
 
+#include <algorithm>
+
 namespace KWin
 {
 
 /**
  * The DamageJournal class is a helper that tracks last N damage regions.
+ *
+ * The damage regions are stored in a ring buffer. The unions of the most recent regions are
+ * cached, so accumulating the damage for the same or a smaller buffer age again is cheap until
+ * a new damage region is added.
  */
 class KWIN_EXPORT DamageJournal
 {
@@ -33,7 +39,22 @@ public:
      */
     void setCapacity(int capacity)
     {
+        if (m_capacity == capacity) {
+            return;
+        }
+
+        QList<Region> ring;
+        ring.reserve(capacity);
+        const int count = std::min(m_count, capacity);
+        for (int i = count - 1; i >= 0; --i) {
+            ring.append(at(i));
+        }
+
+        m_ring = ring;
         m_capacity = capacity;
+        m_count = count;
+        m_head = count - 1;
+        m_unions.clear();
     }
 
     /**
@@ -41,10 +62,20 @@ public:
      */
     void add(const Region &region)
     {
-        while (m_log.size() >= m_capacity) {
-            m_log.removeLast();
+        if (m_capacity <= 0) {
+            return;
         }
-        m_log.prepend(region);
+
+        if (m_ring.size() < m_capacity) {
+            m_ring.append(region);
+            m_head = m_ring.size() - 1;
+        } else {
+            m_head = (m_head + 1) % m_capacity;
+            m_ring[m_head] = region;
+        }
+
+        m_count = std::min(m_count + 1, m_capacity);
+        m_unions.clear();
     }
 
     /**
@@ -53,7 +84,10 @@ public:
      */
     void clear()
     {
-        m_log.clear();
+        m_ring.clear();
+        m_unions.clear();
+        m_count = 0;
+        m_head = -1;
     }
 
     /**
@@ -64,25 +98,43 @@ public:
      */
     Region accumulate(int bufferAge, const Region &fallback = Region()) const
     {
-        Region region;
-        if (bufferAge > 0 && bufferAge <= m_log.size()) {
-            for (int i = 0; i < bufferAge - 1; ++i) {
-                region += m_log[i];
-            }
-        } else {
-            region = fallback;
+        if (bufferAge <= 0 || bufferAge > m_count) {
+            return fallback;
         }
-        return region;
+
+        // m_unions[i] is the union of the i most recent damage regions.
+        if (m_unions.isEmpty()) {
+            m_unions.reserve(m_count);
+            m_unions.append(Region());
+        }
+        while (m_unions.size() < bufferAge) {
+            const qsizetype age = m_unions.size();
+            m_unions.append(m_unions.constLast() | at(age - 1));
+        }
+
+        return m_unions[bufferAge - 1];
     }
 
     Region lastDamage() const
     {
-        return m_log.first();
+        return at(0);
     }
 
 private:
-    QList<Region> m_log;
+    /**
+     * Returns the damage region that was added @a index frames ago.
+     */
+    const Region &at(int index) const
+    {
+        Q_ASSERT(index >= 0 && index < m_count);
+        return m_ring[(m_head - index + m_capacity) % m_capacity];
+    }
+
+    QList<Region> m_ring;
+    mutable QList<Region> m_unions;
     int m_capacity = 10;
+    int m_count = 0;
+    int m_head = -1;
 };
 
 } // namespace KWin
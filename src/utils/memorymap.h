@@ -65,6 +65,25 @@ public:
         return m_size;
     }
 
+    /**
+     * Resizes the mapping to @p size, it may be moved to another address in the process.
+     * The mapping is left untouched if it can't be resized.
+     */
+    bool resize(int size)
+    {
+#ifdef MREMAP_MAYMOVE
+        void *data = mremap(m_data, m_size, size, MREMAP_MAYMOVE);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        m_data = data;
+        m_size = size;
+        return true;
+#else
+        return false;
+#endif
+    }
+
 private:
     void *m_data;
     int m_size;
@@ -19,6 +19,20 @@ SubSurfaceMonitor::SubSurfaceMonitor(SurfaceInterface *surface, QObject *parent)
     : QObject(parent)
 {
     registerSurface(surface);
+
+    // the signals of the sub-surfaces come before this one, so a commit of the whole tree
+    // is reported only once
+    connect(surface, &SurfaceInterface::treeCommitted, this, [this]() {
+        if (m_treeChanged) {
+            m_treeChanged = false;
+            Q_EMIT subSurfaceTreeChanged();
+        }
+    });
+}
+
+void SubSurfaceMonitor::markTreeChanged()
+{
+    m_treeChanged = true;
 }
 
 void SubSurfaceMonitor::registerSubSurface(SubSurfaceInterface *subSurface)
@@ -27,8 +41,12 @@ void SubSurfaceMonitor::registerSubSurface(SubSurfaceInterface *subSurface)
 
     connect(subSurface, &SubSurfaceInterface::positionChanged,
             this, &SubSurfaceMonitor::subSurfaceMoved);
+    connect(subSurface, &SubSurfaceInterface::positionChanged,
+            this, &SubSurfaceMonitor::markTreeChanged);
     connect(surface, &SurfaceInterface::sizeChanged,
             this, &SubSurfaceMonitor::subSurfaceResized);
+    connect(surface, &SurfaceInterface::sizeChanged,
+            this, &SubSurfaceMonitor::markTreeChanged);
     connect(surface, &SurfaceInterface::mapped,
             this, &SubSurfaceMonitor::subSurfaceMapped);
     connect(surface, &SurfaceInterface::unmapped,
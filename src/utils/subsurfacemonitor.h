@@ -60,12 +60,21 @@ Q_SIGNALS:
      */
     void subSurfaceUnmapped();
     void subSurfaceCommitted(SubSurfaceInterface *subSurface);
+    /**
+     * This signal is emitted once after a commit of the tree that moved or resized any of its
+     * sub-surfaces, no matter how many sub-surfaces have changed.
+     */
+    void subSurfaceTreeChanged();
 
 private:
+    void markTreeChanged();
+
     void registerSubSurface(SubSurfaceInterface *subSurface);
     void unregisterSubSurface(SubSurfaceInterface *subSurface);
     void registerSurface(SurfaceInterface *surface);
     void unregisterSurface(SurfaceInterface *surface);
+
+    bool m_treeChanged = false;
 };
 
 } // namespace KWin
@@ -5,6 +5,7 @@
 */
 
 #include "abstract_data_source.h"
+#include "selectioncache.h"
 
 namespace KWin
 {
@@ -14,6 +15,26 @@ AbstractDataSource::AbstractDataSource(QObject *parent)
 {
 }
 
+AbstractDataSource::~AbstractDataSource() = default;
+
+void AbstractDataSource::transferData(const QString &mimeType, FileDescriptor fd)
+{
+    if (m_selectionCache) {
+        m_selectionCache->requestData(mimeType, std::move(fd));
+    } else {
+        requestData(mimeType, std::move(fd));
+    }
+}
+
+void AbstractDataSource::setSelectionCacheEnabled(bool enabled)
+{
+    if (!enabled) {
+        m_selectionCache.reset();
+    } else if (!m_selectionCache) {
+        m_selectionCache = std::make_unique<SelectionCache>(this);
+    }
+}
+
 void AbstractDataSource::setKeyboardModifiers(Qt::KeyboardModifiers heldModifiers)
 {
     if (m_heldModifiers == heldModifiers) {
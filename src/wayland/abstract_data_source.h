@@ -11,11 +11,15 @@
 #include "clientconnection.h"
 #include "utils/filedescriptor.h"
 
+#include <memory>
+
 struct wl_client;
 
 namespace KWin
 {
 
+class SelectionCache;
+
 /**
  * Drag and Drop actions supported by the data source.
  */
@@ -41,6 +45,8 @@ class KWIN_EXPORT AbstractDataSource : public QObject
 {
     Q_OBJECT
 public:
+    ~AbstractDataSource() override;
+
     virtual bool isAccepted() const
     {
         return false;
@@ -50,6 +56,12 @@ public:
     {
     };
     virtual void requestData(const QString &mimeType, FileDescriptor fd) = 0;
+    /**
+     * Writes the data of @p mimeType to @p fd on behalf of a receiver. Unlike requestData(),
+     * the data is served from the compositor if the selection cache is enabled and
+     * another receiver has asked for the same mime type before.
+     */
+    void transferData(const QString &mimeType, FileDescriptor fd);
     virtual void cancel() = 0;
 
     virtual QStringList mimeTypes() const = 0;
@@ -123,6 +135,12 @@ public:
     void setExclusiveAction(DnDAction action);
     std::optional<DnDAction> exclusiveAction() const;
 
+    /**
+     * Keeps the data that receivers ask for in the compositor, so it only has to be read from
+     * the source once. The seat enables this for the sources of the selections.
+     */
+    void setSelectionCacheEnabled(bool enabled);
+
 Q_SIGNALS:
     void aboutToBeDestroyed();
 
@@ -137,6 +155,7 @@ protected:
     explicit AbstractDataSource(QObject *parent = nullptr);
 
 private:
+    std::unique_ptr<SelectionCache> m_selectionCache;
     std::optional<DnDAction> m_exclusiveAction;
     Qt::KeyboardModifiers m_heldModifiers;
     bool m_dndCancelled = false;
@@ -29,6 +29,17 @@ public:
     qreal scaleOverride = 1.0;
     bool tearingDown = false;
 
+    uint64_t requests = 0;
+    uint64_t commits = 0;
+    uint64_t frameCallbacks = 0;
+    uint64_t bufferBytes = 0;
+    qint64 shmPoolBytes = 0;
+    std::chrono::nanoseconds dispatchTime{0};
+    // the commit rate is measured over windows of at least one second
+    std::chrono::steady_clock::time_point commitRateStart = std::chrono::steady_clock::now();
+    uint64_t commitRateCount = 0;
+    double commitRate = 0;
+
 private:
     static void destroyListenerCallback(wl_listener *listener, void *data);
 
@@ -149,6 +160,56 @@ ClientConnection *ClientConnection::get(wl_client *native)
 {
     return static_cast<ClientConnection *>(wl_client_get_user_data(native));
 }
+
+void ClientConnection::recordRequest(std::chrono::nanoseconds duration)
+{
+    d->requests++;
+    d->dispatchTime += duration;
+}
+
+void ClientConnection::recordCommit(uint64_t bufferBytes)
+{
+    d->commits++;
+    d->bufferBytes += bufferBytes;
+
+    const auto now = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> elapsed = now - d->commitRateStart;
+    if (elapsed >= std::chrono::seconds(1)) {
+        d->commitRate = d->commitRateCount / elapsed.count();
+        d->commitRateStart = now;
+        d->commitRateCount = 0;
+    }
+    d->commitRateCount++;
+}
+
+void ClientConnection::recordFrameCallback()
+{
+    d->frameCallbacks++;
+}
+
+void ClientConnection::recordShmPoolResize(qint64 delta)
+{
+    d->shmPoolBytes += delta;
+}
+
+QVariantMap ClientConnection::statistics() const
+{
+    // a client that has stopped committing doesn't update the rate, so fall back to the
+    // current window once it's complete
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - d->commitRateStart;
+    const double commitRate = elapsed >= std::chrono::seconds(1) ? d->commitRateCount / elapsed.count() : d->commitRate;
+
+    return QVariantMap{
+        {QStringLiteral("pid"), qlonglong(d->pid)},
+        {QStringLiteral("requests"), qulonglong(d->requests)},
+        {QStringLiteral("dispatchTime"), double(std::chrono::duration_cast<std::chrono::microseconds>(d->dispatchTime).count())},
+        {QStringLiteral("commits"), qulonglong(d->commits)},
+        {QStringLiteral("commitsPerSecond"), commitRate},
+        {QStringLiteral("bufferBytes"), qulonglong(d->bufferBytes)},
+        {QStringLiteral("shmPoolBytes"), qlonglong(d->shmPoolBytes)},
+        {QStringLiteral("frameCallbacks"), qulonglong(d->frameCallbacks)},
+    };
+}
 }
 
 #include "moc_clientconnection.cpp"
@@ -10,6 +10,8 @@
 #include <sys/types.h>
 
 #include <QObject>
+#include <QVariantMap>
+#include <chrono>
 #include <memory>
 
 struct wl_client;
@@ -134,6 +136,29 @@ public:
      */
     static ClientConnection *get(wl_client *native);
 
+    /**
+     * Records a request of the client that took @p duration to dispatch.
+     */
+    void recordRequest(std::chrono::nanoseconds duration);
+    /**
+     * Records a commit of the client that attached a new buffer of @p bufferBytes, or no
+     * buffer if it is 0.
+     */
+    void recordCommit(uint64_t bufferBytes);
+    void recordFrameCallback();
+    /**
+     * Adds @p delta to the size of all shm pools of the client, in bytes.
+     */
+    void recordShmPoolResize(qint64 delta);
+
+    /**
+     * Returns the counters of the work that the client has caused in the compositor since it
+     * connected. Durations are in microseconds.
+     *
+     * @since 6.7
+     */
+    QVariantMap statistics() const;
+
 Q_SIGNALS:
     /**
      * This signal is emitted when the client is about to be destroyed.
@@ -0,0 +1,81 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+#include "committiming_v1.h"
+
+#include "display.h"
+#include "surface_p.h"
+
+namespace KWin
+{
+
+static constexpr uint32_t s_version = 1;
+
+CommitTimingManagerV1::CommitTimingManagerV1(Display *display, QObject *parent)
+    : QObject(parent)
+    , QtWaylandServer::wp_commit_timing_manager_v1(*display, s_version)
+{
+}
+
+void CommitTimingManagerV1::wp_commit_timing_manager_v1_destroy(Resource *resource)
+{
+    wl_resource_destroy(resource->handle);
+}
+
+void CommitTimingManagerV1::wp_commit_timing_manager_v1_get_timer(Resource *resource, uint32_t id, struct ::wl_resource *wlSurface)
+{
+    const auto surface = SurfaceInterface::get(wlSurface);
+    const auto surfacePrivate = SurfaceInterfacePrivate::get(surface);
+    if (surfacePrivate->commitTimer) {
+        wl_resource_post_error(resource->handle, error_commit_timer_exists, "Attempted to create a second commit timer for the wl_surface");
+        return;
+    }
+    surfacePrivate->commitTimer = new CommitTimerV1(resource->client(), id, resource->version(), surface);
+}
+
+CommitTimerV1::CommitTimerV1(wl_client *client, uint32_t id, uint32_t version, SurfaceInterface *surface)
+    : QtWaylandServer::wp_commit_timer_v1(client, id, version)
+    , m_surface(surface)
+{
+}
+
+CommitTimerV1::~CommitTimerV1()
+{
+    if (m_surface) {
+        SurfaceInterfacePrivate::get(m_surface)->commitTimer = nullptr;
+    }
+}
+
+void CommitTimerV1::wp_commit_timer_v1_destroy_resource(Resource *resource)
+{
+    delete this;
+}
+
+void CommitTimerV1::wp_commit_timer_v1_destroy(Resource *resource)
+{
+    wl_resource_destroy(resource->handle);
+}
+
+void CommitTimerV1::wp_commit_timer_v1_set_timestamp(Resource *resource, uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec)
+{
+    if (!m_surface) {
+        wl_resource_post_error(resource->handle, error_surface_destroyed, "called set_timestamp on a destroyed surface");
+        return;
+    }
+    if (tv_nsec >= 1'000'000'000) {
+        wl_resource_post_error(resource->handle, error_invalid_timestamp, "tv_nsec must be less than one second");
+        return;
+    }
+    SurfaceState *pending = SurfaceInterfacePrivate::get(m_surface)->pending.get();
+    if (pending->presentationTimestamp) {
+        wl_resource_post_error(resource->handle, error_timestamp_exists, "a timestamp has already been set for this commit");
+        return;
+    }
+    // the timestamp is in the presentation clock domain, which is CLOCK_MONOTONIC
+    const uint64_t seconds = (uint64_t(tv_sec_hi) << 32) | tv_sec_lo;
+    pending->presentationTimestamp = std::chrono::seconds(seconds) + std::chrono::nanoseconds(tv_nsec);
+}
+
+}
@@ -0,0 +1,43 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+#pragma once
+#include <QObject>
+#include <QPointer>
+
+#include "wayland/qwayland-server-commit-timing-v1.h"
+
+namespace KWin
+{
+
+class Display;
+class SurfaceInterface;
+
+class CommitTimingManagerV1 : public QObject, public QtWaylandServer::wp_commit_timing_manager_v1
+{
+    Q_OBJECT
+public:
+    explicit CommitTimingManagerV1(Display *display, QObject *parent);
+
+private:
+    void wp_commit_timing_manager_v1_destroy(Resource *resource) override;
+    void wp_commit_timing_manager_v1_get_timer(Resource *resource, uint32_t id, struct ::wl_resource *surface) override;
+};
+
+class CommitTimerV1 : public QtWaylandServer::wp_commit_timer_v1
+{
+public:
+    explicit CommitTimerV1(wl_client *client, uint32_t id, uint32_t version, SurfaceInterface *surface);
+    ~CommitTimerV1();
+
+private:
+    void wp_commit_timer_v1_destroy_resource(Resource *resource) override;
+    void wp_commit_timer_v1_destroy(Resource *resource) override;
+    void wp_commit_timer_v1_set_timestamp(Resource *resource, uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec) override;
+
+    const QPointer<SurfaceInterface> m_surface;
+};
+
+}
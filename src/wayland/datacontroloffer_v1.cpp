@@ -50,7 +50,7 @@ void DataControlOfferV1InterfacePrivate::ext_data_control_offer_v1_receive(Resou
     FileDescriptor pipe(fd);
 
     if (source) {
-        source->requestData(mimeType, std::move(pipe));
+        source->transferData(mimeType, std::move(pipe));
     }
 }
 
@@ -60,7 +60,7 @@ void DataOfferInterfacePrivate::data_offer_receive(Resource *resource, const QSt
     FileDescriptor pipe(fd);
 
     if (source && source->mimeTypes().contains(mime_type)) {
-        source->requestData(mime_type, std::move(pipe));
+        source->transferData(mime_type, std::move(pipe));
     }
 }
 
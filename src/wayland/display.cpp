@@ -10,12 +10,16 @@
 
 #include "clientconnection.h"
 #include "display_p.h"
+#include "inputlatency.h"
 #include "linuxdmabufv1clientbuffer_p.h"
 #include "output.h"
+#include "protocoltrace.h"
 #include "shmclientbuffer_p.h"
 #include "singlepixelbuffer.h"
+#include "core/stallstatistics.h"
 #include "utils/common.h"
 #include "utils/containerof.h"
+#include "utils/envvar.h"
 
 #include <poll.h>
 #include <string.h>
@@ -24,9 +28,13 @@
 #include <QAbstractEventDispatcher>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QFileInfo>
 
 namespace KWin
 {
+static const bool s_clientStatistics = environmentVariableBoolValue("KWIN_CLIENT_STATISTICS").value_or(true);
+static const bool s_hashTracedBuffers = environmentVariableBoolValue("KWIN_WAYLAND_PROTOCOL_TRACE_BUFFERS").value_or(false);
+
 DisplayPrivate *DisplayPrivate::get(Display *display)
 {
     return display->d.get();
@@ -53,20 +61,54 @@ void DisplayPrivate::clientCreatedCallback(wl_listener *listener, void *data)
     Q_EMIT display->clientConnected(connection);
 }
 
+void DisplayPrivate::protocolLoggerCallback(void *userData, wl_protocol_logger_type type, const wl_protocol_logger_message *message)
+{
+    if (type != WL_PROTOCOL_LOGGER_REQUEST) {
+        return;
+    }
+    // the logger is called right before a request is dispatched, so the previous one is done
+    DisplayPrivate *displayPrivate = static_cast<DisplayPrivate *>(userData);
+    displayPrivate->finishRequest();
+    displayPrivate->requestClient = ClientConnection::get(wl_resource_get_client(message->resource));
+    displayPrivate->requestStart = std::chrono::steady_clock::now();
+}
+
+void DisplayPrivate::finishRequest()
+{
+    if (requestClient) {
+        requestClient->recordRequest(std::chrono::steady_clock::now() - requestStart);
+        requestClient.clear();
+    }
+}
+
 Display::Display(QObject *parent)
     : QObject(parent)
     , d(new DisplayPrivate(this))
 {
+    d->inputLatencyTracker = std::make_unique<InputLatencyTracker>();
     d->display = wl_display_create();
     d->loop = wl_display_get_event_loop(d->display);
 
     d->clientCreatedListener.notify = DisplayPrivate::clientCreatedCallback;
     wl_display_add_client_created_listener(d->display, &d->clientCreatedListener);
+
+    if (s_clientStatistics) {
+        d->protocolLogger = wl_display_add_protocol_logger(d->display, DisplayPrivate::protocolLoggerCallback, d.get());
+    }
+
+    const QString traceFileName = qEnvironmentVariable("KWIN_WAYLAND_PROTOCOL_TRACE");
+    if (!traceFileName.isEmpty()) {
+        startProtocolTrace(traceFileName, s_hashTracedBuffers);
+    }
 }
 
 Display::~Display()
 {
     wl_list_remove(&d->clientCreatedListener.link);
+    d->protocolTrace.reset();
+    if (d->protocolLogger) {
+        wl_protocol_logger_destroy(d->protocolLogger);
+    }
 
     wl_display_destroy_clients(d->display);
     wl_display_destroy(d->display);
@@ -134,13 +176,32 @@ bool Display::start()
 
 void Display::dispatchEvents()
 {
+    const StallStatistics::Scope stallScope(StallSource::WaylandDispatch);
     if (wl_event_loop_dispatch(d->loop, 0) != 0) {
         qCWarning(KWIN_CORE) << "Error on dispatching Wayland event loop";
     }
+    d->finishRequest();
+    // a client that floods the socket can keep the event loop from ever blocking, don't let
+    // it hold back the replies and events of all the other clients
+    scheduleFlush();
+}
+
+void Display::scheduleFlush()
+{
+    if (d->flushScheduled) {
+        return;
+    }
+    d->flushScheduled = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        if (d->flushScheduled) {
+            flush();
+        }
+    }, Qt::QueuedConnection);
 }
 
 void Display::flush()
 {
+    d->flushScheduled = false;
     wl_display_flush_clients(d->display);
 }
 
@@ -227,6 +288,11 @@ ClientConnection *Display::createClient(int fd)
     return ClientConnection::get(c);
 }
 
+InputLatencyTracker *Display::inputLatencyTracker() const
+{
+    return d->inputLatencyTracker.get();
+}
+
 GraphicsBuffer *Display::bufferForResource(wl_resource *resource)
 {
     if (auto buffer = LinuxDmaBufV1ClientBuffer::get(resource)) {
@@ -241,6 +307,37 @@ GraphicsBuffer *Display::bufferForResource(wl_resource *resource)
     }
 }
 
+QVariantMap Display::clientStatistics() const
+{
+    QVariantMap ret;
+    wl_client *client;
+    wl_client_for_each(client, wl_display_get_client_list(d->display)) {
+        const ClientConnection *connection = ClientConnection::get(client);
+        QString name = QFileInfo(connection->executablePath()).fileName();
+        if (name.isEmpty()) {
+            name = QStringLiteral("unknown");
+        }
+        ret[QStringLiteral("%1 (%2)").arg(name).arg(connection->processId())] = connection->statistics();
+    }
+    return ret;
+}
+
+bool Display::startProtocolTrace(const QString &fileName, bool hashBuffers)
+{
+    d->protocolTrace.reset();
+    auto trace = std::make_unique<ProtocolTrace>(this, fileName, hashBuffers ? ProtocolTrace::BufferContents::Hash : ProtocolTrace::BufferContents::None);
+    if (!trace->isValid()) {
+        return false;
+    }
+    d->protocolTrace = std::move(trace);
+    return true;
+}
+
+void Display::stopProtocolTrace()
+{
+    d->protocolTrace.reset();
+}
+
 void Display::setDefaultMaxBufferSize(size_t max)
 {
     wl_display_set_default_max_buffer_size(d->display, max);
@@ -25,6 +25,7 @@ class OutputInterface;
 class OutputDeviceV2Interface;
 class SeatInterface;
 class GraphicsBuffer;
+class InputLatencyTracker;
 
 /**
  * @brief Class holding the Wayland server display loop.
@@ -109,12 +110,49 @@ public:
      */
     static GraphicsBuffer *bufferForResource(wl_resource *resource);
 
+    /**
+     * Returns the tracker that measures the input-to-photon latency of the clients.
+     */
+    InputLatencyTracker *inputLatencyTracker() const;
+
+    /**
+     * Maps every connected client to its statistics, the keys are the executable and pid of
+     * the client.
+     *
+     * @see ClientConnection::statistics
+     * @since 6.7
+     */
+    QVariantMap clientStatistics() const;
+
+    /**
+     * Starts recording the requests and events of all clients to @a fileName, a trace that
+     * is already being recorded is stopped. If @a hashBuffers is @c true, the pixels of every
+     * attached buffer are hashed as well. Returns @c false if the file can't be written.
+     *
+     * The KWIN_WAYLAND_PROTOCOL_TRACE environment variable can be set to the file name to
+     * start a trace when the display is created, KWIN_WAYLAND_PROTOCOL_TRACE_BUFFERS enables
+     * hashing the buffers.
+     *
+     * @see ProtocolTrace
+     * @since 6.7
+     */
+    bool startProtocolTrace(const QString &fileName, bool hashBuffers = false);
+    void stopProtocolTrace();
+
     /**
      * Sets the default maximum size for connection buffers of new clients. The size is in bytes.
      * The minimum buffer size is 4096.
      */
     void setDefaultMaxBufferSize(size_t max);
 
+    /**
+     * Requests that the pending events are sent to the clients as soon as the control returns
+     * to the event loop, even if it doesn't block. Several requests are coalesced into one flush.
+     *
+     * @since 6.7
+     */
+    void scheduleFlush();
+
 public Q_SLOTS:
     void flush();
 
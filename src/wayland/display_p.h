@@ -11,17 +11,23 @@
 
 #include "utils/filedescriptor.h"
 #include <QList>
+#include <QPointer>
 #include <QSocketNotifier>
 #include <QString>
 
+#include <chrono>
+#include <memory>
+
 struct wl_resource;
 
 namespace KWin
 {
 class ClientConnection;
 class Display;
+class InputLatencyTracker;
 class OutputInterface;
 class OutputDeviceV2Interface;
+class ProtocolTrace;
 class SeatInterface;
 
 class DisplayPrivate
@@ -33,17 +39,29 @@ public:
     void registerSocketName(const QString &socketName);
 
     static void clientCreatedCallback(wl_listener *listener, void *data);
+    static void protocolLoggerCallback(void *userData, wl_protocol_logger_type type, const wl_protocol_logger_message *message);
+
+    /**
+     * Attributes the time since the last request to the client that sent it.
+     */
+    void finishRequest();
 
     Display *q;
     QSocketNotifier *socketNotifier = nullptr;
     wl_display *display = nullptr;
     wl_event_loop *loop = nullptr;
     bool running = false;
+    bool flushScheduled = false;
     QList<OutputInterface *> outputs;
     QList<OutputDeviceV2Interface *> outputdevicesV2;
     QList<SeatInterface *> seats;
     QStringList socketNames;
     wl_listener clientCreatedListener;
+    wl_protocol_logger *protocolLogger = nullptr;
+    QPointer<ClientConnection> requestClient;
+    std::chrono::steady_clock::time_point requestStart;
+    std::unique_ptr<InputLatencyTracker> inputLatencyTracker;
+    std::unique_ptr<ProtocolTrace> protocolTrace;
 };
 
 /**
@@ -63,6 +63,12 @@ void ExternalBrightnessDeviceV1::setBrightness(double brightness)
 
     const uint32_t minBrightness = m_internal ? 1 : 0; // some laptop screens turn off at brightness 0
     const uint32_t val = std::round(std::lerp(minBrightness, m_maxBrightness, std::clamp(brightness, 0.0, 1.0)));
+    // brightness animations set a new value every frame, but most of them map to the same step,
+    // and every request makes the client write to sysfs or, even slower, over DDC/CI
+    if (m_requestedBrightness == val) {
+        return;
+    }
+    m_requestedBrightness = val;
     send_requested_brightness(val);
 }
 
@@ -124,11 +130,14 @@ void ExternalBrightnessDeviceV1::kde_external_brightness_device_v1_set_uses_ddc_
 void ExternalBrightnessDeviceV1::kde_external_brightness_device_v1_set_max_brightness(Resource *resource, uint32_t value)
 {
     m_maxBrightness = value;
+    m_requestedBrightness.reset();
 }
 
 void ExternalBrightnessDeviceV1::kde_external_brightness_device_v1_set_observed_brightness(Resource *resource, uint32_t value)
 {
     m_observedBrightness = value;
+    // the brightness may have been changed behind our back, the next request has to be sent
+    m_requestedBrightness.reset();
 }
 
 void ExternalBrightnessDeviceV1::kde_external_brightness_device_v1_commit(Resource *resource)
@@ -68,6 +68,7 @@ private:
     QPointer<ExternalBrightnessV1> m_global;
     QByteArray m_edidBeginning;
     std::optional<uint32_t> m_observedBrightness;
+    std::optional<uint32_t> m_requestedBrightness;
     uint32_t m_maxBrightness = 1;
     bool m_internal = false;
     bool m_usesDdcCi = false;
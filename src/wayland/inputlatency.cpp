@@ -0,0 +1,162 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+#include "inputlatency.h"
+#include "clientconnection.h"
+#include "utils/envvar.h"
+
+#include <QFileInfo>
+
+#include <algorithm>
+#include <cmath>
+
+namespace KWin
+{
+
+static const bool s_inputLatencyStatistics = environmentVariableBoolValue("KWIN_INPUT_LATENCY_STATISTICS").value_or(true);
+
+void InputLatencyHistogram::record(std::chrono::nanoseconds latency)
+{
+    const size_t bucket = std::min<size_t>(latency / s_bucketSize, s_bucketCount);
+    m_buckets[bucket]++;
+    m_count++;
+    m_sum += latency;
+    m_maximum = std::max(m_maximum, latency);
+}
+
+uint64_t InputLatencyHistogram::count() const
+{
+    return m_count;
+}
+
+std::chrono::microseconds InputLatencyHistogram::percentile(double percentile) const
+{
+    if (m_count == 0) {
+        return std::chrono::microseconds::zero();
+    }
+    const uint64_t rank = std::max<uint64_t>(1, std::ceil(m_count * percentile / 100.0));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < s_bucketCount; i++) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(s_bucketSize * (i + 1));
+        }
+    }
+    return maximum();
+}
+
+std::chrono::microseconds InputLatencyHistogram::average() const
+{
+    if (m_count == 0) {
+        return std::chrono::microseconds::zero();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(m_sum / m_count);
+}
+
+std::chrono::microseconds InputLatencyHistogram::maximum() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(m_maximum);
+}
+
+QVariantMap InputLatencyHistogram::toVariantMap() const
+{
+    // leave out the empty buckets at the end, they'd only bloat the result
+    const auto last = std::find_if(m_buckets.crbegin(), m_buckets.crend(), [](uint64_t count) {
+        return count != 0;
+    });
+    QVariantList buckets;
+    for (auto it = m_buckets.cbegin(); it != last.base(); ++it) {
+        buckets.append(qulonglong(*it));
+    }
+    return QVariantMap{
+        {QStringLiteral("count"), qulonglong(m_count)},
+        {QStringLiteral("average"), double(average().count())},
+        {QStringLiteral("p50"), double(percentile(50).count())},
+        {QStringLiteral("p90"), double(percentile(90).count())},
+        {QStringLiteral("p99"), double(percentile(99).count())},
+        {QStringLiteral("maximum"), double(maximum().count())},
+        {QStringLiteral("bucketSize"), double(std::chrono::duration_cast<std::chrono::microseconds>(s_bucketSize).count())},
+        {QStringLiteral("buckets"), buckets},
+    };
+}
+
+InputLatencyFeedback::InputLatencyFeedback(InputLatencyTracker *tracker, const QString &client, std::chrono::microseconds inputTimestamp)
+    : m_tracker(tracker)
+    , m_client(client)
+    , m_inputTimestamp(inputTimestamp)
+{
+}
+
+void InputLatencyFeedback::presented(std::chrono::nanoseconds refreshCycleDuration, std::chrono::nanoseconds timestamp, PresentationMode mode)
+{
+    if (m_presented) {
+        return;
+    }
+    m_presented = true;
+    if (m_tracker && timestamp > m_inputTimestamp) {
+        m_tracker->record(m_client, timestamp - m_inputTimestamp);
+    }
+}
+
+bool InputLatencyFeedback::isPresented() const
+{
+    return m_presented;
+}
+
+InputLatencyTracker::InputLatencyTracker(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void InputLatencyTracker::inputDelivered(ClientConnection *client, std::chrono::microseconds timestamp)
+{
+    if (!s_inputLatencyStatistics || !client || timestamp == std::chrono::microseconds::zero()) {
+        return;
+    }
+    auto it = m_pendingInput.find(client);
+    if (it == m_pendingInput.end()) {
+        m_pendingInput.insert(client, timestamp);
+        connect(client, &ClientConnection::aboutToBeDestroyed, this, [this, client]() {
+            m_pendingInput.remove(client);
+        }, Qt::SingleShotConnection);
+    }
+    // otherwise keep the older timestamp, the latency is measured from the oldest input the
+    // client hasn't had a chance to react to yet
+}
+
+std::shared_ptr<InputLatencyFeedback> InputLatencyTracker::takeFeedback(ClientConnection *client)
+{
+    const auto it = m_pendingInput.find(client);
+    if (it == m_pendingInput.end()) {
+        return nullptr;
+    }
+    const std::chrono::microseconds timestamp = *it;
+    m_pendingInput.erase(it);
+    disconnect(client, &ClientConnection::aboutToBeDestroyed, this, nullptr);
+
+    QString name = QFileInfo(client->executablePath()).fileName();
+    if (name.isEmpty()) {
+        name = QStringLiteral("pid %1").arg(client->processId());
+    }
+    return std::make_shared<InputLatencyFeedback>(this, name, timestamp);
+}
+
+void InputLatencyTracker::record(const QString &client, std::chrono::nanoseconds latency)
+{
+    m_histograms[client].record(latency);
+}
+
+QVariantMap InputLatencyTracker::statistics() const
+{
+    QVariantMap ret;
+    for (const auto &[client, histogram] : m_histograms) {
+        ret[client] = histogram.toVariantMap();
+    }
+    return ret;
+}
+
+} // namespace KWin
+
+#include "moc_inputlatency.cpp"
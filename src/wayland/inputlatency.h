@@ -0,0 +1,117 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+#pragma once
+
+#include "kwin_export.h"
+
+#include "core/renderbackend.h"
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QVariantMap>
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <memory>
+
+namespace KWin
+{
+
+class ClientConnection;
+class InputLatencyTracker;
+
+/**
+ * The InputLatencyHistogram class counts input-to-photon latencies in buckets of one millisecond.
+ */
+class KWIN_EXPORT InputLatencyHistogram
+{
+public:
+    void record(std::chrono::nanoseconds latency);
+
+    uint64_t count() const;
+    /**
+     * Returns the upper bound of the bucket that contains the @p percentile of all samples,
+     * in the range from 0 to 100.
+     */
+    std::chrono::microseconds percentile(double percentile) const;
+    std::chrono::microseconds average() const;
+    std::chrono::microseconds maximum() const;
+
+    QVariantMap toVariantMap() const;
+
+    static constexpr std::chrono::milliseconds s_bucketSize{1};
+    static constexpr size_t s_bucketCount = 200;
+
+private:
+    // the last bucket is for everything that doesn't fit into the others
+    std::array<uint64_t, s_bucketCount + 1> m_buckets{};
+    uint64_t m_count = 0;
+    std::chrono::nanoseconds m_sum{0};
+    std::chrono::nanoseconds m_maximum{0};
+};
+
+/**
+ * The InputLatencyFeedback class records the time from the oldest input event that was
+ * delivered to a client before it committed a buffer, until the buffer got presented.
+ */
+class KWIN_EXPORT InputLatencyFeedback : public PresentationFeedback
+{
+public:
+    explicit InputLatencyFeedback(InputLatencyTracker *tracker, const QString &client, std::chrono::microseconds inputTimestamp);
+
+    void presented(std::chrono::nanoseconds refreshCycleDuration, std::chrono::nanoseconds timestamp, PresentationMode mode) override;
+
+    bool isPresented() const;
+
+private:
+    QPointer<InputLatencyTracker> m_tracker;
+    QString m_client;
+    std::chrono::microseconds m_inputTimestamp;
+    bool m_presented = false;
+};
+
+/**
+ * The InputLatencyTracker class measures the input-to-photon latency of every client.
+ *
+ * The seat reports every input event it delivers to a client together with its timestamp,
+ * the next buffer the client commits is tagged with the oldest of those timestamps, and
+ * when the buffer is presented, the difference to the presentation timestamp is added to
+ * the histogram of the client. Both timestamps are in the CLOCK_MONOTONIC domain.
+ *
+ * Tracking can be disabled by setting the KWIN_INPUT_LATENCY_STATISTICS environment
+ * variable to 0.
+ */
+class KWIN_EXPORT InputLatencyTracker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit InputLatencyTracker(QObject *parent = nullptr);
+
+    void inputDelivered(ClientConnection *client, std::chrono::microseconds timestamp);
+
+    /**
+     * Returns the feedback for the buffer that @p client is committing, or @c null if no
+     * input has been delivered to the client since its last commit.
+     */
+    std::shared_ptr<InputLatencyFeedback> takeFeedback(ClientConnection *client);
+
+    void record(const QString &client, std::chrono::nanoseconds latency);
+
+    /**
+     * Maps the executable of every client to the statistics of its histogram. Durations
+     * are in microseconds.
+     */
+    QVariantMap statistics() const;
+
+private:
+    QHash<ClientConnection *, std::chrono::microseconds> m_pendingInput;
+    std::map<QString, InputLatencyHistogram> m_histograms;
+};
+
+} // namespace KWin
@@ -30,6 +30,9 @@ void KeyboardInterfacePrivate::keyboard_release(Resource *resource)
 
 void KeyboardInterfacePrivate::keyboard_bind_resource(Resource *resource)
 {
+    cachedKeyboardsClient = nullptr;
+    cachedKeyboards.clear();
+
     const ClientConnection *focusedClient = focusedSurface ? focusedSurface->client() : nullptr;
 
     sendRepeatInfo(resource);
@@ -46,9 +49,19 @@ void KeyboardInterfacePrivate::keyboard_bind_resource(Resource *resource)
     }
 }
 
+void KeyboardInterfacePrivate::keyboard_destroy_resource(Resource *resource)
+{
+    cachedKeyboardsClient = nullptr;
+    cachedKeyboards.clear();
+}
+
 QList<KeyboardInterfacePrivate::Resource *> KeyboardInterfacePrivate::keyboardsForClient(ClientConnection *client) const
 {
-    return resourceMap().values(client->client());
+    if (cachedKeyboardsClient != client->client()) {
+        cachedKeyboards = resourceMap().values(client->client());
+        cachedKeyboardsClient = client->client();
+    }
+    return cachedKeyboards;
 }
 
 void KeyboardInterfacePrivate::sendLeave(SurfaceInterface *surface, quint32 serial)
@@ -87,7 +100,8 @@ void KeyboardInterfacePrivate::sendKeymap(Resource *resource)
 {
     // From version 7 on, keymaps must be mapped privately, so that
     // we can seal the fd and reuse it between clients.
-    if (resource->version() >= 7 && sharedKeymapFile.effectiveFlags().testFlag(RamFile::Flag::SealWrite)) {
+    if (resource->version() >= 7 && sharedKeymaps.front().file.effectiveFlags().testFlag(RamFile::Flag::SealWrite)) {
+        const RamFile &sharedKeymapFile = sharedKeymaps.front().file;
         send_keymap(resource->handle, keymap_format::keymap_format_xkb_v1, sharedKeymapFile.fd(), sharedKeymapFile.size());
         // otherwise give each client its own unsealed copy.
     } else {
@@ -98,13 +112,26 @@ void KeyboardInterfacePrivate::sendKeymap(Resource *resource)
 
 void KeyboardInterface::setKeymap(const QByteArray &content)
 {
-    if (content.isNull()) {
+    if (content.isNull() || content == d->keymap) {
         return;
     }
 
     d->keymap = content;
-    // +1 to include QByteArray null terminator.
-    d->sharedKeymapFile = RamFile("kwin-xkb-keymap-shared", content.constData(), content.size() + 1, RamFile::Flag::SealWrite);
+
+    // switching back and forth between a few keymaps is common, e.g. when fake input types a
+    // character that is not in the layout, so keep the files of the last few around
+    auto it = std::ranges::find(d->sharedKeymaps, content, &KeyboardInterfacePrivate::SharedKeymap::content);
+    if (it != d->sharedKeymaps.end()) {
+        std::rotate(d->sharedKeymaps.begin(), it, it + 1);
+    } else {
+        static constexpr size_t s_maxSharedKeymaps = 4;
+        if (d->sharedKeymaps.size() == s_maxSharedKeymaps) {
+            d->sharedKeymaps.pop_back();
+        }
+        // +1 to include QByteArray null terminator.
+        RamFile file("kwin-xkb-keymap-shared", content.constData(), content.size() + 1, RamFile::Flag::SealWrite);
+        d->sharedKeymaps.insert(d->sharedKeymaps.begin(), KeyboardInterfacePrivate::SharedKeymap{content, std::move(file)});
+    }
 
     const auto keyboardResources = d->resourceMap();
     for (KeyboardInterfacePrivate::Resource *resource : keyboardResources) {
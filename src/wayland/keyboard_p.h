@@ -13,6 +13,8 @@
 #include <QHash>
 #include <QPointer>
 
+#include <vector>
+
 namespace KWin
 {
 class ClientConnection;
@@ -42,7 +44,14 @@ public:
     QMetaObject::Connection destroyConnection;
     QPointer<SurfaceInterface> modifierFocusSurface;
     QByteArray keymap;
-    RamFile sharedKeymapFile;
+
+    struct SharedKeymap
+    {
+        QByteArray content;
+        RamFile file;
+    };
+    // the sealed files of the most recently used keymaps, the current one first
+    std::vector<SharedKeymap> sharedKeymaps;
 
     struct
     {
@@ -65,6 +74,12 @@ public:
 protected:
     void keyboard_release(Resource *resource) override;
     void keyboard_bind_resource(Resource *resource) override;
+    void keyboard_destroy_resource(Resource *resource) override;
+
+private:
+    // every key and modifier event looks up the keyboards of the focused client
+    mutable wl_client *cachedKeyboardsClient = nullptr;
+    mutable QList<Resource *> cachedKeyboards;
 };
 
 }
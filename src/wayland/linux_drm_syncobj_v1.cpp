@@ -177,7 +177,8 @@ bool LinuxDrmSyncObjSurfaceV1::maybeEmitProtocolErrors()
         wl_resource_post_error(resource()->handle, error_no_buffer, "explicit sync is used, but no buffer is attached");
         return true;
     }
-    if (!priv->pending->buffer->dmabufAttributes()) {
+    // shared memory buffers may be wrapped in a dmabuf internally, but that's not visible to clients
+    if (!priv->pending->buffer->dmabufAttributes() || priv->pending->buffer->shmAttributes()) {
         wl_resource_post_error(resource()->handle, error_unsupported_buffer, "only linux dmabuf buffers are allowed to use explicit sync");
         return true;
     }
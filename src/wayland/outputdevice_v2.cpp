@@ -18,6 +18,8 @@
 #include <QString>
 #include <QTimer>
 
+#include <algorithm>
+
 #include "qwayland-server-kde-output-device-v2.h"
 
 namespace KWin
@@ -163,6 +165,8 @@ public:
     std::vector<std::unique_ptr<OutputDeviceModeV2Interface>> m_modes;
     OutputDeviceModeV2Interface *m_currentMode = nullptr;
     QByteArray m_edid;
+    // the edid is sent to every client that binds the output, encode it only when it changes
+    QByteArray m_encodedEdid;
     bool m_enabled = true;
     QString m_uuid;
     uint32_t m_capabilities = 0;
@@ -227,6 +231,7 @@ public:
     QSize m_size;
     int m_refreshRate = 60000;
     OutputMode::Flags m_flags;
+    uint32_t m_protocolFlags = 0;
 
 protected:
     Resource *kde_output_device_mode_v2_allocate() override;
@@ -487,7 +492,7 @@ void OutputDeviceV2InterfacePrivate::sendDone(Resource *resource)
 
 void OutputDeviceV2InterfacePrivate::sendEdid(Resource *resource)
 {
-    send_edid(resource->handle, QString::fromStdString(m_edid.toBase64().toStdString()));
+    kde_output_device_v2_send_edid(resource->handle, m_encodedEdid.constData());
 }
 
 void OutputDeviceV2InterfacePrivate::sendEnabled(Resource *resource)
@@ -738,11 +743,21 @@ void OutputDeviceV2Interface::updateScale()
 
 void OutputDeviceV2Interface::updateModes()
 {
+    const auto nativeModes = d->m_handle->modes();
+
+    // the modes are often announced again without any change, e.g. when the output is enabled
+    const bool modesChanged = !std::ranges::equal(nativeModes, d->m_modes, [](const std::shared_ptr<OutputMode> &mode, const std::unique_ptr<OutputDeviceModeV2Interface> &deviceMode) {
+        return deviceMode->handle().lock() == mode;
+    });
+    if (!modesChanged) {
+        updateCurrentMode();
+        return;
+    }
+
     auto oldModes = std::move(d->m_modes);
     d->m_currentMode = nullptr;
 
     const auto clientResources = d->resourceMap();
-    const auto nativeModes = d->m_handle->modes();
 
     for (const std::shared_ptr<OutputMode> &mode : nativeModes) {
         d->m_modes.push_back(std::make_unique<OutputDeviceModeV2Interface>(mode));
@@ -785,7 +800,16 @@ void OutputDeviceV2Interface::updateCurrentMode()
 
 void OutputDeviceV2Interface::updateEdid()
 {
-    d->m_edid = d->m_handle->edid().raw();
+    const QByteArray edid = d->m_handle->edid().raw();
+    if (!d->m_encodedEdid.isNull() && d->m_edid == edid) {
+        return;
+    }
+    d->m_edid = edid;
+    d->m_encodedEdid = edid.toBase64();
+    // toBase64() of an empty array is null, the edid is sent as an empty string then
+    if (d->m_encodedEdid.isNull()) {
+        d->m_encodedEdid = QByteArrayLiteral("");
+    }
     const auto clientResources = d->resourceMap();
     for (auto resource : clientResources) {
         d->sendEdid(resource);
@@ -1150,6 +1174,12 @@ OutputDeviceModeV2InterfacePrivate::OutputDeviceModeV2InterfacePrivate(OutputDev
     , m_refreshRate(handle->refreshRate())
     , m_flags(handle->flags())
 {
+    if (m_flags & OutputMode::Flag::Custom) {
+        m_protocolFlags |= KDE_OUTPUT_DEVICE_MODE_V2_FLAGS_CUSTOM;
+    }
+    if (m_flags & OutputMode::Flag::ReducedBlanking) {
+        m_protocolFlags |= KDE_OUTPUT_DEVICE_MODE_V2_FLAGS_REDUCED_BLANKING;
+    }
 }
 
 OutputDeviceModeV2Interface::OutputDeviceModeV2Interface(std::shared_ptr<OutputMode> handle)
@@ -1205,14 +1235,7 @@ void OutputDeviceModeV2InterfacePrivate::bindResource(Resource *resource)
         send_preferred(resource->handle);
     }
     if (resource->version() >= KDE_OUTPUT_DEVICE_MODE_V2_FLAGS_CUSTOM) {
-        uint32_t flags = 0;
-        if (m_flags & OutputMode::Flag::Custom) {
-            flags |= KDE_OUTPUT_DEVICE_MODE_V2_FLAGS_CUSTOM;
-        }
-        if (m_flags & OutputMode::Flag::ReducedBlanking) {
-            flags |= KDE_OUTPUT_DEVICE_MODE_V2_FLAGS_REDUCED_BLANKING;
-        }
-        send_flags(resource->handle, flags);
+        send_flags(resource->handle, m_protocolFlags);
     }
 }
 
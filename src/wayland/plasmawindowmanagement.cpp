@@ -15,6 +15,7 @@
 #include <QHash>
 #include <QIcon>
 #include <QList>
+#include <QMutex>
 #include <QPointer>
 #include <QThreadPool>
 #include <QUuid>
@@ -38,6 +39,8 @@ public:
     void sendStackingOrderUuidsChanged(wl_resource *resource);
     void sendStackingOrderChanged2();
     void sendStackingOrderChanged2(Resource *resource);
+    void scheduleStackingOrderUpdate();
+    void sendStackingOrderUpdate();
 
     PlasmaWindowManagementInterface::ShowingDesktopState state = PlasmaWindowManagementInterface::ShowingDesktopState::Disabled;
     QList<PlasmaWindowInterface *> windows;
@@ -45,6 +48,10 @@ public:
     quint32 windowIdCounter = 0;
     QList<quint32> stackingOrder;
     QList<QString> stackingOrderUuids;
+    // the stacking order that the clients have been told about, changes are coalesced
+    QList<quint32> sentStackingOrder;
+    QList<QString> sentStackingOrderUuids;
+    bool stackingOrderUpdateScheduled = false;
     PlasmaWindowManagementInterface *q;
 
 protected:
@@ -55,6 +62,17 @@ protected:
     void org_kde_plasma_window_management_get_stacking_order(Resource *resource, uint32_t id) override;
 };
 
+/**
+ * The icon of a window serialized the way get_icon sends it. Serializing an icon is expensive, so
+ * it's done at most once per icon in a worker thread no matter how many clients request it.
+ */
+struct PlasmaWindowIconData
+{
+    QMutex mutex;
+    QIcon icon;
+    QByteArray data;
+};
+
 class PlasmaWindowInterfacePrivate : public QtWaylandServer::org_kde_plasma_window
 {
 public:
@@ -82,6 +100,15 @@ public:
     wl_resource *resourceForParent(PlasmaWindowInterface *parent, Resource *child) const;
     void setClientGeometry(const Rect &geometry);
 
+    enum PendingChange {
+        TitleChange = 1 << 0,
+        StateChange = 1 << 1,
+        GeometryChange = 1 << 2,
+        ClientGeometryChange = 1 << 3,
+    };
+    void scheduleChange(PendingChange change);
+    void sendPendingChanges();
+
     quint32 windowId = 0;
     QHash<SurfaceInterface *, Rect> minimizedGeometries;
     PlasmaWindowManagementInterface *wm;
@@ -100,10 +127,14 @@ public:
     QString m_appServiceName;
     QString m_appObjectPath;
     QIcon m_icon;
+    std::shared_ptr<PlasmaWindowIconData> m_iconData;
     quint32 m_state = 0;
     QString uuid;
     QString m_resourceName;
     Rect clientGeometry;
+    // the title, the state and the geometries can change many times per frame, e.g. during an
+    // interactive move, so they are sent when the control returns to the event loop
+    quint32 pendingChanges = 0;
 
 protected:
     Resource *org_kde_plasma_window_allocate() override;
@@ -216,6 +247,32 @@ void PlasmaWindowManagementInterfacePrivate::sendStackingOrderChanged2(Resource
     org_kde_plasma_window_management_send_stacking_order_changed_2(resource->handle);
 }
 
+void PlasmaWindowManagementInterfacePrivate::scheduleStackingOrderUpdate()
+{
+    if (stackingOrderUpdateScheduled) {
+        return;
+    }
+    stackingOrderUpdateScheduled = true;
+    // a single raise can change the stacking order several times, the clients only need the result
+    QMetaObject::invokeMethod(q, [this]() {
+        sendStackingOrderUpdate();
+    }, Qt::QueuedConnection);
+}
+
+void PlasmaWindowManagementInterfacePrivate::sendStackingOrderUpdate()
+{
+    stackingOrderUpdateScheduled = false;
+    if (sentStackingOrder != stackingOrder) {
+        sentStackingOrder = stackingOrder;
+        sendStackingOrderChanged();
+    }
+    if (sentStackingOrderUuids != stackingOrderUuids) {
+        sentStackingOrderUuids = stackingOrderUuids;
+        sendStackingOrderUuidsChanged();
+        sendStackingOrderChanged2();
+    }
+}
+
 void PlasmaWindowManagementInterfacePrivate::org_kde_plasma_window_management_bind_resource(Resource *resource)
 {
     for (const auto window : std::as_const(windows)) {
@@ -339,7 +396,7 @@ void PlasmaWindowManagementInterface::setStackingOrder(const QList<quint32> &sta
         return;
     }
     d->stackingOrder = stackingOrder;
-    d->sendStackingOrderChanged();
+    d->scheduleStackingOrderUpdate();
 }
 
 void PlasmaWindowManagementInterface::setStackingOrderUuids(const QList<QString> &stackingOrderUuids)
@@ -348,8 +405,7 @@ void PlasmaWindowManagementInterface::setStackingOrderUuids(const QList<QString>
         return;
     }
     d->stackingOrderUuids = stackingOrderUuids;
-    d->sendStackingOrderUuidsChanged();
-    d->sendStackingOrderChanged2();
+    d->scheduleStackingOrderUpdate();
 }
 
 void PlasmaWindowManagementInterface::setPlasmaVirtualDesktopManagementInterface(PlasmaVirtualDesktopManagementInterface *manager)
@@ -482,6 +538,7 @@ void PlasmaWindowInterfacePrivate::setThemedIconName(const QString &iconName)
 void PlasmaWindowInterfacePrivate::setIcon(const QIcon &icon)
 {
     m_icon = icon;
+    m_iconData.reset();
     setThemedIconName(m_icon.name());
 
     const auto clientResources = resourceMap();
@@ -509,15 +566,27 @@ void PlasmaWindowInterfacePrivate::setResourceName(const QString &resourceName)
 
 void PlasmaWindowInterfacePrivate::org_kde_plasma_window_get_icon(Resource *resource, int32_t fd)
 {
-    QThreadPool::globalInstance()->start([fd, icon = m_icon]() {
+    if (!m_iconData) {
+        m_iconData = std::make_shared<PlasmaWindowIconData>();
+        m_iconData->icon = m_icon;
+    }
+    QThreadPool::globalInstance()->start([fd, iconData = m_iconData]() {
         QFile file;
         if (!file.open(fd, QIODevice::WriteOnly, QFileDevice::AutoCloseHandle)) {
             close(fd);
             qCWarning(KWIN_CORE) << Q_FUNC_INFO << "failed to open file:" << file.errorString();
             return;
         }
-        QDataStream ds(&file);
-        ds << icon;
+        QByteArray data;
+        {
+            QMutexLocker locker(&iconData->mutex);
+            if (iconData->data.isEmpty()) {
+                QDataStream ds(&iconData->data, QIODevice::WriteOnly);
+                ds << iconData->icon;
+            }
+            data = iconData->data;
+        }
+        file.write(data);
         file.close();
     });
 }
@@ -558,10 +627,41 @@ void PlasmaWindowInterfacePrivate::setTitle(const QString &title)
         return;
     }
     m_title = title;
-    const auto clientResources = resourceMap();
+    scheduleChange(TitleChange);
+}
+
+void PlasmaWindowInterfacePrivate::scheduleChange(PendingChange change)
+{
+    if (!pendingChanges) {
+        QMetaObject::invokeMethod(q, [this]() {
+            sendPendingChanges();
+        }, Qt::QueuedConnection);
+    }
+    pendingChanges |= change;
+}
+
+void PlasmaWindowInterfacePrivate::sendPendingChanges()
+{
+    if (!pendingChanges) {
+        return;
+    }
+    const quint32 changes = pendingChanges;
+    pendingChanges = 0;
 
+    const auto clientResources = resourceMap();
     for (auto resource : clientResources) {
-        send_title_changed(resource->handle, truncate(m_title));
+        if (changes & TitleChange) {
+            send_title_changed(resource->handle, truncate(m_title));
+        }
+        if (changes & StateChange) {
+            send_state_changed(resource->handle, m_state);
+        }
+        if ((changes & GeometryChange) && geometry.isValid() && resource->version() >= ORG_KDE_PLASMA_WINDOW_GEOMETRY_SINCE_VERSION) {
+            send_geometry(resource->handle, geometry.x(), geometry.y(), geometry.width(), geometry.height());
+        }
+        if ((changes & ClientGeometryChange) && clientGeometry.isValid() && resource->version() >= ORG_KDE_PLASMA_WINDOW_CLIENT_GEOMETRY_SINCE_VERSION) {
+            send_client_geometry(resource->handle, clientGeometry.x(), clientGeometry.y(), clientGeometry.width(), clientGeometry.height());
+        }
     }
 }
 
@@ -571,6 +671,7 @@ void PlasmaWindowInterfacePrivate::unmap()
         return;
     }
     unmapped = true;
+    sendPendingChanges();
     const auto clientResources = resourceMap();
 
     for (auto resource : clientResources) {
@@ -590,11 +691,7 @@ void PlasmaWindowInterfacePrivate::setState(org_kde_plasma_window_management_sta
         return;
     }
     m_state = newState;
-    const auto clientResources = resourceMap();
-
-    for (auto resource : clientResources) {
-        send_state_changed(resource->handle, m_state);
-    }
+    scheduleChange(StateChange);
 }
 
 wl_resource *PlasmaWindowInterfacePrivate::resourceForParent(PlasmaWindowInterface *parent, Resource *child) const
@@ -643,17 +740,7 @@ void PlasmaWindowInterfacePrivate::setGeometry(const Rect &geo)
         return;
     }
     geometry = geo;
-    if (!geometry.isValid()) {
-        return;
-    }
-
-    const auto clientResources = resourceMap();
-    for (auto resource : clientResources) {
-        if (resource->version() < ORG_KDE_PLASMA_WINDOW_GEOMETRY_SINCE_VERSION) {
-            continue;
-        }
-        send_geometry(resource->handle, geometry.x(), geometry.y(), geometry.width(), geometry.height());
-    }
+    scheduleChange(GeometryChange);
 }
 
 void PlasmaWindowInterfacePrivate::setApplicationMenuPaths(const QString &service, const QString &object)
@@ -1176,17 +1263,7 @@ void PlasmaWindowInterfacePrivate::setClientGeometry(const Rect &geometry)
         return;
     }
     clientGeometry = geometry;
-    if (!clientGeometry.isValid()) {
-        return;
-    }
-
-    const auto clientResources = resourceMap();
-    for (auto resource : clientResources) {
-        if (resource->version() < ORG_KDE_PLASMA_WINDOW_CLIENT_GEOMETRY_SINCE_VERSION) {
-            continue;
-        }
-        send_client_geometry(resource->handle, clientGeometry.x(), clientGeometry.y(), clientGeometry.width(), clientGeometry.height());
-    }
+    scheduleChange(ClientGeometryChange);
 }
 }
 
@@ -90,6 +90,9 @@ public:
 
     /**
      * Associate stacking order to this window management
+     *
+     * The clients are told about the new stacking order when the control returns to the event
+     * loop, so several changes in a row result in one event.
      */
     void setStackingOrder(const QList<quint32> &stackingOrder);
 
@@ -53,7 +53,7 @@ void PrimarySelectionOfferV1InterfacePrivate::zwp_primary_selection_offer_v1_rec
     FileDescriptor pipe(fd);
 
     if (source && source->mimeTypes().contains(mimeType)) {
-        source->requestData(mimeType, std::move(pipe));
+        source->transferData(mimeType, std::move(pipe));
     }
 }
 
@@ -0,0 +1,174 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+#include "protocoltrace.h"
+#include "clientconnection.h"
+#include "core/graphicsbuffer.h"
+#include "display.h"
+#include "utils/common.h"
+
+#include <cctype>
+#include <cstring>
+
+namespace KWin
+{
+
+ProtocolTrace::ProtocolTrace(Display *display, const QString &fileName, BufferContents bufferContents)
+    : m_display(display)
+    , m_file(fileName)
+    , m_bufferContents(bufferContents)
+    , m_start(std::chrono::steady_clock::now())
+{
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(KWIN_CORE) << "Failed to open the protocol trace" << fileName << m_file.errorString();
+        return;
+    }
+    m_file.write("# kwin protocol trace 1\n");
+    m_logger = wl_display_add_protocol_logger(*display, loggerCallback, this);
+}
+
+ProtocolTrace::~ProtocolTrace()
+{
+    if (m_logger) {
+        wl_protocol_logger_destroy(m_logger);
+    }
+}
+
+bool ProtocolTrace::isValid() const
+{
+    return m_logger;
+}
+
+qint64 ProtocolTrace::timestamp() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+void ProtocolTrace::loggerCallback(void *userData, wl_protocol_logger_type type, const wl_protocol_logger_message *message)
+{
+    static_cast<ProtocolTrace *>(userData)->record(type, message);
+}
+
+int ProtocolTrace::clientId(wl_client *client)
+{
+    auto it = m_clients.find(client);
+    if (it != m_clients.end()) {
+        return *it;
+    }
+
+    const int id = m_nextClient++;
+    m_clients.insert(client, id);
+
+    ClientConnection *connection = ClientConnection::get(client);
+    QByteArray executable = connection->executablePath().toUtf8().toPercentEncoding();
+    if (executable.isEmpty()) {
+        executable = "-";
+    }
+    m_file.write(QByteArray::number(timestamp()) + ' ' + QByteArray::number(id) + " connect " + executable + '\n');
+    connect(connection, &ClientConnection::aboutToBeDestroyed, this, [this, client, id]() {
+        m_clients.remove(client);
+        m_file.write(QByteArray::number(timestamp()) + ' ' + QByteArray::number(id) + " disconnect\n");
+        m_file.flush();
+    });
+    return id;
+}
+
+void ProtocolTrace::record(wl_protocol_logger_type type, const wl_protocol_logger_message *message)
+{
+    const int client = clientId(wl_resource_get_client(message->resource));
+    const bool request = type == WL_PROTOCOL_LOGGER_REQUEST;
+
+    QByteArray line = QByteArray::number(timestamp()) + ' ' + QByteArray::number(client) + (request ? " request " : " event ")
+        + wl_resource_get_class(message->resource) + ' ' + QByteArray::number(wl_resource_get_id(message->resource)) + ' '
+        + QByteArray::number(message->message_opcode) + ' ' + message->message->name;
+
+    const char *signature = message->message->signature;
+    for (int i = 0; i < message->arguments_count; ++i) {
+        // skip the "since" version and the nullability markers
+        while (*signature && (std::isdigit(*signature) || *signature == '?')) {
+            ++signature;
+        }
+
+        // objects are always resources on the server side
+        const wl_argument &argument = message->arguments[i];
+        const auto resourceId = [](wl_object *object) {
+            return object ? wl_resource_get_id(reinterpret_cast<wl_resource *>(object)) : 0;
+        };
+
+        switch (*signature) {
+        case 'i':
+            line += " i:" + QByteArray::number(argument.i);
+            break;
+        case 'u':
+            line += " u:" + QByteArray::number(argument.u);
+            break;
+        case 'f':
+            // keep the raw fixed point value, so nothing is lost
+            line += " f:" + QByteArray::number(argument.f);
+            break;
+        case 's':
+            line += argument.s ? " s:" + QByteArray(argument.s).toPercentEncoding() : QByteArray(" s!");
+            break;
+        case 'o':
+            line += " o:" + QByteArray::number(resourceId(argument.o));
+            break;
+        case 'n':
+            // the compositor creates the objects in events, the client in requests
+            line += " n:" + QByteArray::number(request ? argument.n : resourceId(argument.o));
+            break;
+        case 'a':
+            line += " a:" + (argument.a ? QByteArray(static_cast<const char *>(argument.a->data), argument.a->size).toHex() : QByteArray());
+            break;
+        case 'h':
+            line += " h:-";
+            break;
+        default:
+            break;
+        }
+        if (*signature) {
+            ++signature;
+        }
+    }
+
+    line += '\n';
+    m_file.write(line);
+
+    if (request && message->arguments_count > 0 && message->arguments[0].o
+        && !std::strcmp(message->message->name, "attach") && !std::strcmp(wl_resource_get_class(message->resource), "wl_surface")) {
+        recordBuffer(client, reinterpret_cast<wl_resource *>(message->arguments[0].o));
+    }
+}
+
+void ProtocolTrace::recordBuffer(int client, wl_resource *resource)
+{
+    GraphicsBuffer *buffer = Display::bufferForResource(resource);
+    if (!buffer) {
+        return;
+    }
+
+    uint32_t format = 0;
+    if (const ShmAttributes *attributes = buffer->shmAttributes()) {
+        format = attributes->format;
+    } else if (const DmaBufAttributes *attributes = buffer->dmabufAttributes()) {
+        format = attributes->format;
+    }
+
+    QByteArray hash = "-";
+    if (m_bufferContents == BufferContents::Hash) {
+        const GraphicsBuffer::Map map = buffer->map(GraphicsBuffer::Read);
+        if (map.data) {
+            hash = QByteArray::number(qHashBits(map.data, size_t(map.stride) * buffer->size().height()), 16);
+            buffer->unmap();
+        }
+    }
+
+    m_file.write(QByteArray::number(timestamp()) + ' ' + QByteArray::number(client) + " buffer " + QByteArray::number(wl_resource_get_id(resource)) + ' '
+                 + QByteArray::number(buffer->size().width()) + ' ' + QByteArray::number(buffer->size().height()) + ' '
+                 + QByteArray::number(format, 16) + ' ' + hash + '\n');
+}
+
+} // namespace KWin
+
+#include "moc_protocoltrace.cpp"
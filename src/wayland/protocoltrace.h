@@ -0,0 +1,77 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+#pragma once
+
+#include "kwin_export.h"
+
+#include <QFile>
+#include <QHash>
+#include <QObject>
+
+#include <chrono>
+
+#include <wayland-server-core.h>
+
+namespace KWin
+{
+
+class Display;
+
+/**
+ * The ProtocolTrace class records the requests and events of all clients together with their
+ * timing, so the traffic can be replayed against another compositor later.
+ *
+ * The trace is a text file with one record per line, all fields are separated by spaces:
+ *
+ * @code
+ * # kwin protocol trace 1
+ * <time> <client> connect <executable>
+ * <time> <client> disconnect
+ * <time> <client> request <interface> <id> <opcode> <message> <arguments>...
+ * <time> <client> event <interface> <id> <opcode> <message> <arguments>...
+ * <time> <client> buffer <id> <width> <height> <format> <hash>
+ * @endcode
+ *
+ * The time is in microseconds since the start of the trace. Every argument is prefixed with
+ * its type, e.g. "u:42", "s:xdg_wm_base" or "o:12". Strings are percent-encoded, a null string
+ * is written as "s!". The contents of file descriptors aren't recorded.
+ *
+ * The buffer record follows every wl_surface.attach and describes the attached buffer. The hash
+ * of the pixels is only recorded if requested because computing it is expensive, otherwise
+ * it's "-".
+ */
+class KWIN_EXPORT ProtocolTrace : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class BufferContents {
+        None,
+        Hash,
+    };
+
+    explicit ProtocolTrace(Display *display, const QString &fileName, BufferContents bufferContents);
+    ~ProtocolTrace() override;
+
+    bool isValid() const;
+
+private:
+    static void loggerCallback(void *userData, wl_protocol_logger_type type, const wl_protocol_logger_message *message);
+    void record(wl_protocol_logger_type type, const wl_protocol_logger_message *message);
+    void recordBuffer(int client, wl_resource *resource);
+    int clientId(wl_client *client);
+    qint64 timestamp() const;
+
+    Display *m_display;
+    QFile m_file;
+    wl_protocol_logger *m_logger = nullptr;
+    BufferContents m_bufferContents;
+    std::chrono::steady_clock::time_point m_start;
+    QHash<wl_client *, int> m_clients;
+    int m_nextClient = 1;
+};
+
+} // namespace KWin
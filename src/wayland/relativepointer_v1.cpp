@@ -93,6 +93,14 @@ void RelativePointerV1Interface::sendRelativeMotion(const QPointF &delta, const
     }
 }
 
+bool RelativePointerV1Interface::hasFocusedClientResource() const
+{
+    if (!pointer->focusedSurface()) {
+        return false;
+    }
+    return resourceMap().contains(pointer->focusedSurface()->client()->client());
+}
+
 } // namespace KWin
 
 #include "moc_relativepointer_v1.cpp"
@@ -34,6 +34,7 @@ public:
 
     static RelativePointerV1Interface *get(PointerInterface *pointer);
     void sendRelativeMotion(const QPointF &delta, const QPointF &deltaNonAccelerated, std::chrono::microseconds time);
+    bool hasFocusedClientResource() const;
 
 protected:
     void zwp_relative_pointer_v1_destroy(Resource *resource) override;
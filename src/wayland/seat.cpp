@@ -15,6 +15,7 @@
 #include "datasource.h"
 #include "display.h"
 #include "display_p.h"
+#include "inputlatency.h"
 #include "keyboard.h"
 #include "keyboard_p.h"
 #include "pointer.h"
@@ -31,6 +32,7 @@
 #include "textinput_v3_p.h"
 #include "touch_p.h"
 #include "utils/common.h"
+#include "utils/envvar.h"
 #include "utils/resource.h"
 #include "xdgtopleveldrag_v1.h"
 
@@ -41,6 +43,7 @@
 namespace KWin
 {
 static const int s_version = 10;
+static const bool s_selectionCache = environmentVariableBoolValue("KWIN_WAYLAND_SELECTION_CACHE").value_or(true);
 
 SeatInterfacePrivate *SeatInterfacePrivate::get(SeatInterface *seat)
 {
@@ -107,6 +110,13 @@ SeatInterface::~SeatInterface()
     }
 }
 
+void SeatInterfacePrivate::inputDelivered(SurfaceInterface *surface)
+{
+    if (surface && display) {
+        display->inputLatencyTracker()->inputDelivered(surface->client(), inputTimestamp);
+    }
+}
+
 void SeatInterfacePrivate::updatePointerButtonSerial(quint32 button, quint32 serial)
 {
     auto it = globalPointer.buttonSerials.find(button);
@@ -451,6 +461,7 @@ void SeatInterface::notifyPointerMotion(const QPointF &pos)
     }
 
     d->pointer->sendMotion(localPosition);
+    d->inputDelivered(effectiveFocusedSurface);
 }
 
 std::chrono::milliseconds SeatInterface::timestamp() const
@@ -461,6 +472,7 @@ std::chrono::milliseconds SeatInterface::timestamp() const
 void SeatInterface::setTimestamp(std::chrono::microseconds time)
 {
     d->timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(time);
+    d->inputTimestamp = time;
 }
 
 void SeatInterface::setDragTarget(AbstractDropHandler *dropTarget,
@@ -654,6 +666,7 @@ void SeatInterface::notifyPointerAxis(Qt::Orientation orientation, qreal delta,
         return;
     }
     d->pointer->sendAxis(orientation, delta, deltaV120, source, inverted);
+    d->inputDelivered(d->pointer->focusedSurface());
 }
 
 void SeatInterface::notifyPointerButton(Qt::MouseButton button, PointerButtonState state)
@@ -699,6 +712,7 @@ void SeatInterface::notifyPointerButton(quint32 button, PointerButtonState state
     }
 
     d->pointer->sendButton(button, state, serial);
+    d->inputDelivered(d->pointer->focusedSurface());
 }
 
 void SeatInterface::notifyPointerFrame()
@@ -739,6 +753,15 @@ void SeatInterface::relativePointerMotion(const QPointF &delta, const QPointF &d
     }
 }
 
+bool SeatInterface::isFocusedPointerRelative() const
+{
+    if (!d->pointer) {
+        return false;
+    }
+    const RelativePointerV1Interface *relativePointer = RelativePointerV1Interface::get(pointer());
+    return relativePointer && relativePointer->hasFocusedClientResource();
+}
+
 void SeatInterface::startPointerSwipeGesture(quint32 fingerCount)
 {
     if (!d->pointer) {
@@ -902,6 +925,7 @@ void SeatInterface::notifyKeyboardKey(quint32 keyCode, KeyboardKeyState state, u
         return;
     }
     d->keyboard->sendKey(keyCode, state, serial);
+    d->inputDelivered(d->keyboard->focusedSurface());
 }
 
 void SeatInterface::notifyKeyboardModifiers(quint32 depressed, quint32 latched, quint32 locked, quint32 group)
@@ -972,6 +996,7 @@ TouchPoint *SeatInterface::notifyTouchDown(SurfaceInterface *surface, const QPoi
     const auto [effectiveTouchedSurface, pos] = surface->mapToInputSurface(globalPosition - surfacePosition);
     const quint32 serial = display()->nextSerial();
     d->touch->sendDown(effectiveTouchedSurface, id, serial, pos);
+    d->inputDelivered(effectiveTouchedSurface);
 
     auto touchPoint = std::make_unique<TouchPoint>(id, serial, surface, this);
     touchPoint->position = globalPosition;
@@ -1002,6 +1027,7 @@ void SeatInterface::notifyTouchMotion(qint32 id, const QPointF &globalPosition)
     if (touchPoint->surface) {
         const auto [effectiveTouchedSurface, pos] = touchPoint->surface->mapToInputSurface(globalPosition - touchPoint->offset);
         d->touch->sendMotion(effectiveTouchedSurface, id, pos);
+        d->inputDelivered(effectiveTouchedSurface);
     }
 
     Q_EMIT touchMoved(id, touchPoint->serial, globalPosition);
@@ -1023,6 +1049,7 @@ void SeatInterface::notifyTouchUp(qint32 id)
     TouchPoint *touchPoint = it->second.get();
     if (touchPoint->client) {
         d->touch->sendUp(touchPoint->client, id, d->display->nextSerial());
+        d->display->inputLatencyTracker()->inputDelivered(touchPoint->client, d->inputTimestamp);
     }
 
     d->touchPoints.erase(it);
@@ -1166,6 +1193,7 @@ void SeatInterface::setSelection(AbstractDataSource *selection, UInt32Serial ser
             setSelection(nullptr, serial);
         };
         connect(selection, &AbstractDataSource::aboutToBeDestroyed, this, cleanup);
+        selection->setSelectionCacheEnabled(s_selectionCache);
     }
 
     d->currentSelection = selection;
@@ -1205,6 +1233,7 @@ void SeatInterface::setPrimarySelection(AbstractDataSource *selection, UInt32Ser
             setPrimarySelection(nullptr, serial);
         };
         connect(selection, &AbstractDataSource::aboutToBeDestroyed, this, cleanup);
+        selection->setSelectionCacheEnabled(s_selectionCache);
     }
 
     d->currentPrimarySelection = selection;
@@ -372,6 +372,10 @@ public:
      * @see setPointerPos
      */
     void relativePointerMotion(const QPointF &delta, const QPointF &deltaNonAccelerated, std::chrono::microseconds timestamp);
+    /**
+     * @returns true if the client with pointer focus listens to relative pointer motion
+     */
+    bool isFocusedPointerRelative() const;
 
     /**
      * Starts a multi-finger swipe gesture for the currently focused pointer surface.
@@ -46,6 +46,7 @@ public:
     void registerDataDevice(DataDeviceInterface *dataDevice);
     void registerDataControlDevice(DataControlDeviceV1Interface *dataDevice);
     bool dragInhibitsPointer(SurfaceInterface *surface) const;
+    void inputDelivered(SurfaceInterface *surface);
 
     void offerSelection(DataDeviceInterface *device);
     void offerSelection(DataControlDeviceV1Interface *device);
@@ -56,6 +57,8 @@ public:
     QPointer<Display> display;
     QString name;
     std::chrono::milliseconds timestamp = std::chrono::milliseconds::zero();
+    // the full resolution timestamp, for measuring the input latency
+    std::chrono::microseconds inputTimestamp = std::chrono::microseconds::zero();
     quint32 capabilities = 0;
     std::unique_ptr<KeyboardInterface> keyboard;
     std::unique_ptr<PointerInterface> pointer;
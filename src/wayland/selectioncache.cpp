@@ -0,0 +1,184 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+#include "selectioncache.h"
+#include "abstract_data_source.h"
+#include "utils/common.h"
+#include "utils/pipe.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace KWin
+{
+
+static constexpr qsizetype s_readSize = 64 * 1024;
+
+static void disposeNotifier(std::unique_ptr<QSocketNotifier> &notifier)
+{
+    // the notifier can be the sender of the signal that is being handled
+    if (notifier) {
+        notifier->setEnabled(false);
+        notifier.release()->deleteLater();
+    }
+}
+
+SelectionCache::SelectionCache(AbstractDataSource *source)
+    : m_source(source)
+{
+}
+
+SelectionCache::~SelectionCache() = default;
+
+void SelectionCache::requestData(const QString &mimeType, FileDescriptor fd)
+{
+    auto it = m_entries.find(mimeType);
+    if (it == m_entries.end()) {
+        auto entry = std::make_shared<Entry>();
+        fetch(mimeType, *entry);
+        if (!entry->fd.isValid()) {
+            m_source->requestData(mimeType, std::move(fd));
+            return;
+        }
+        it = m_entries.insert(mimeType, entry);
+    } else if ((*it)->overflown) {
+        // the data is not kept, so it has to come from the source again
+        m_source->requestData(mimeType, std::move(fd));
+        return;
+    }
+
+    addReader(mimeType, **it, std::move(fd));
+    flush(mimeType);
+}
+
+void SelectionCache::fetch(const QString &mimeType, Entry &entry)
+{
+    std::optional<Pipe> pipe = Pipe::create(O_CLOEXEC);
+    if (!pipe) {
+        qCWarning(KWIN_CORE) << "Failed to create a pipe for the selection cache:" << strerror(errno);
+        return;
+    }
+    // only the end of the compositor is non-blocking, the source gets a regular pipe
+    if (fcntl(pipe->readEndpoint.get(), F_SETFL, O_NONBLOCK) == -1) {
+        qCWarning(KWIN_CORE) << "Failed to set O_NONBLOCK for the selection cache:" << strerror(errno);
+        return;
+    }
+
+    m_source->requestData(mimeType, std::move(pipe->writeEndpoint));
+
+    entry.fd = std::move(pipe->readEndpoint);
+    entry.notifier = std::make_unique<QSocketNotifier>(entry.fd.get(), QSocketNotifier::Read);
+    connect(entry.notifier.get(), &QSocketNotifier::activated, this, [this, mimeType]() {
+        readSource(mimeType);
+    });
+}
+
+void SelectionCache::addReader(const QString &mimeType, Entry &entry, FileDescriptor fd)
+{
+    auto reader = std::make_unique<Reader>();
+    reader->fd = std::move(fd);
+    reader->offset = entry.base;
+    // a slow reader must not block the compositor
+    fcntl(reader->fd.get(), F_SETFL, fcntl(reader->fd.get(), F_GETFL) | O_NONBLOCK);
+    reader->notifier = std::make_unique<QSocketNotifier>(reader->fd.get(), QSocketNotifier::Write);
+    reader->notifier->setEnabled(false);
+    connect(reader->notifier.get(), &QSocketNotifier::activated, this, [this, mimeType]() {
+        flush(mimeType);
+    });
+    entry.readers.push_back(std::move(reader));
+}
+
+void SelectionCache::readSource(const QString &mimeType)
+{
+    const std::shared_ptr<Entry> entry = m_entries.value(mimeType);
+    if (!entry) {
+        return;
+    }
+
+    const qsizetype size = entry->data.size();
+    entry->data.resize(size + s_readSize);
+    const ssize_t length = read(entry->fd.get(), entry->data.data() + size, s_readSize);
+    if (length > 0) {
+        entry->data.resize(size + length);
+        if (entry->base + entry->data.size() > s_maxSize) {
+            entry->overflown = true;
+        }
+    } else {
+        entry->data.resize(size);
+        if (length == -1 && (errno == EAGAIN || errno == EINTR)) {
+            return;
+        }
+        if (length == -1) {
+            qCWarning(KWIN_CORE) << "Failed to read the selection data:" << strerror(errno);
+            // pass on what has arrived so far, but don't keep it
+            entry->overflown = true;
+        }
+        entry->complete = true;
+        disposeNotifier(entry->notifier);
+        entry->fd = FileDescriptor();
+    }
+
+    flush(mimeType);
+}
+
+bool SelectionCache::writeReader(Entry &entry, Reader &reader)
+{
+    const qsizetype end = entry.base + entry.data.size();
+    while (reader.offset < end) {
+        const ssize_t length = write(reader.fd.get(), entry.data.constData() + (reader.offset - entry.base), end - reader.offset);
+        if (length == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN) {
+                reader.notifier->setEnabled(true);
+                return true;
+            }
+            // the reader has gone away
+            return false;
+        }
+        reader.offset += length;
+    }
+    reader.notifier->setEnabled(false);
+    return !entry.complete;
+}
+
+void SelectionCache::flush(const QString &mimeType)
+{
+    const std::shared_ptr<Entry> entry = m_entries.value(mimeType);
+    if (!entry) {
+        return;
+    }
+
+    std::erase_if(entry->readers, [&entry](std::unique_ptr<Reader> &reader) {
+        if (writeReader(*entry, *reader)) {
+            return false;
+        }
+        disposeNotifier(reader->notifier);
+        return true;
+    });
+
+    if (entry->overflown) {
+        if (entry->readers.empty()) {
+            // nobody is interested in the rest of the data anymore
+            disposeNotifier(entry->notifier);
+            m_entries.remove(mimeType);
+            return;
+        }
+        // only keep the part that hasn't been written to every reader yet
+        const auto slowest = std::ranges::min_element(entry->readers, {}, [](const std::unique_ptr<Reader> &reader) {
+            return reader->offset;
+        });
+        const qsizetype written = (*slowest)->offset - entry->base;
+        entry->data.remove(0, written);
+        entry->base += written;
+    }
+}
+
+} // namespace KWin
+
+#include "moc_selectioncache.cpp"
@@ -0,0 +1,74 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+#pragma once
+
+#include "utils/filedescriptor.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QSocketNotifier>
+
+#include <memory>
+#include <vector>
+
+namespace KWin
+{
+
+class AbstractDataSource;
+
+/**
+ * The SelectionCache class keeps the data of a selection source in the compositor.
+ *
+ * The first request for a mime type reads the data from the source once and streams it to
+ * the requestor while it arrives. Every later request for the same mime type, e.g. by the
+ * clipboard manager or the Xwayland bridge, is served from memory without asking the source
+ * again. Data bigger than s_maxSize is passed through but not kept.
+ */
+class SelectionCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SelectionCache(AbstractDataSource *source);
+    ~SelectionCache() override;
+
+    void requestData(const QString &mimeType, FileDescriptor fd);
+
+    static constexpr qsizetype s_maxSize = 32 * 1024 * 1024;
+
+private:
+    struct Reader
+    {
+        FileDescriptor fd;
+        // the offset of the next byte to write, relative to the start of the whole data
+        qsizetype offset = 0;
+        std::unique_ptr<QSocketNotifier> notifier;
+    };
+
+    struct Entry
+    {
+        FileDescriptor fd;
+        std::unique_ptr<QSocketNotifier> notifier;
+        QByteArray data;
+        // the offset of data in the whole data, only non-zero if the data is not kept
+        qsizetype base = 0;
+        bool complete = false;
+        bool overflown = false;
+        std::vector<std::unique_ptr<Reader>> readers;
+    };
+
+    void fetch(const QString &mimeType, Entry &entry);
+    void readSource(const QString &mimeType);
+    void flush(const QString &mimeType);
+    static bool writeReader(Entry &entry, Reader &reader);
+    void addReader(const QString &mimeType, Entry &entry, FileDescriptor fd);
+
+    AbstractDataSource *const m_source;
+    QHash<QString, std::shared_ptr<Entry>> m_entries;
+};
+
+} // namespace KWin
@@ -7,6 +7,7 @@
 #include "config-kwin.h"
 
 #include "utils/drm_format_helper.h"
+#include "wayland/clientconnection.h"
 #include "wayland/display.h"
 #include "wayland/shmclientbuffer.h"
 #include "wayland/shmclientbuffer_p.h"
@@ -15,8 +16,14 @@
 #include <fcntl.h>
 #include <mutex>
 #include <signal.h>
+#include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
+
+#if HAVE_UDMABUF
+#include <linux/udmabuf.h>
+#endif
 
 namespace KWin
 {
@@ -58,19 +65,82 @@ ShmPool::ShmPool(ShmClientBufferIntegration *integration, wl_client *client, int
     : QtWaylandServer::wl_shm_pool(client, id, version)
     , integration(integration)
     , mapping(std::move(mapping))
+    , clientConnection(ClientConnection::get(client))
     , fd(std::move(fd))
 {
+    updateSeals();
+    clientConnection->recordShmPoolResize(this->mapping->size());
+}
+
+ShmPool::~ShmPool()
+{
+    if (clientConnection) {
+        clientConnection->recordShmPoolResize(-qint64(mapping->size()));
+    }
+}
+
+void ShmPool::updateSeals()
+{
+    sigbusImpossible = false;
 #if HAVE_MEMFD
-    const int seals = fcntl(this->fd.get(), F_GET_SEALS);
+    const int seals = fcntl(fd.get(), F_GET_SEALS);
     if (seals != -1) {
         struct stat statbuf;
-        if ((seals & F_SEAL_SHRINK) && fstat(this->fd.get(), &statbuf) >= 0) {
-            sigbusImpossible = statbuf.st_size >= this->mapping->size();
+        if ((seals & F_SEAL_SHRINK) && fstat(fd.get(), &statbuf) >= 0) {
+            sigbusImpossible = statbuf.st_size >= mapping->size();
         }
+        writeSealed = seals & F_SEAL_WRITE;
     }
 #endif
 }
 
+#if HAVE_UDMABUF
+static const FileDescriptor &udmabufDevice()
+{
+    static const FileDescriptor device = []() {
+        if (qEnvironmentVariableIntValue("KWIN_SHM_UDMABUF") != 1) {
+            return FileDescriptor{};
+        }
+        return FileDescriptor{open("/dev/udmabuf", O_RDWR | O_CLOEXEC)};
+    }();
+    return device;
+}
+#endif
+
+const FileDescriptor &ShmPool::udmabuf()
+{
+    if (udmabufFd) {
+        return *udmabufFd;
+    }
+
+    udmabufFd = FileDescriptor{};
+#if HAVE_UDMABUF
+    // the kernel only accepts memfds that can't shrink and can still be written to
+    if (!sigbusImpossible || writeSealed || !udmabufDevice().isValid()) {
+        return *udmabufFd;
+    }
+
+    const off_t pageSize = sysconf(_SC_PAGESIZE);
+    const off_t size = off_t(mapping->size()) / pageSize * pageSize;
+    if (size == 0) {
+        return *udmabufFd;
+    }
+
+    udmabuf_create create{
+        .memfd = uint32_t(fd.get()),
+        .flags = UDMABUF_FLAGS_CLOEXEC,
+        .offset = 0,
+        .size = uint64_t(size),
+    };
+    const int ret = ioctl(udmabufDevice().get(), UDMABUF_CREATE, &create);
+    if (ret >= 0) {
+        udmabufFd = FileDescriptor{ret};
+        udmabufSize = size;
+    }
+#endif
+    return *udmabufFd;
+}
+
 void ShmPool::ref()
 {
     ++refCount;
@@ -145,12 +215,33 @@ void ShmPool::shm_pool_resize(Resource *resource, int32_t size)
         return;
     }
 
-    auto remapping = std::make_shared<MemoryMap>(size, PROT_READ | PROT_WRITE, MAP_SHARED, fd.get(), 0);
-    if (remapping->isValid()) {
+    if (size == mapping->size()) {
+        return;
+    }
+
+    // If no buffer is being read from the pool right now, grow the mapping in place, which
+    // is a lot cheaper for clients that resize their pool all the time, e.g. while a window
+    // is being resized. Otherwise the buffers that are being read keep the old mapping alive
+    // until they are done with it.
+    const qint64 previousSize = mapping->size();
+    if (mapping.use_count() != 1 || !mapping->resize(size)) {
+        auto remapping = std::make_shared<MemoryMap>(size, PROT_READ | PROT_WRITE, MAP_SHARED, fd.get(), 0);
+        if (!remapping->isValid()) {
+            wl_resource_post_error(resource->handle, WL_SHM_ERROR_INVALID_FD, "failed to map shm pool with the new size");
+            return;
+        }
         mapping = std::move(remapping);
-    } else {
-        wl_resource_post_error(resource->handle, WL_SHM_ERROR_INVALID_FD, "failed to map shm pool with the new size");
     }
+
+    if (clientConnection) {
+        clientConnection->recordShmPoolResize(mapping->size() - previousSize);
+    }
+
+    // the pool may have outgrown the file, in which case accessing the new pages faults
+    updateSeals();
+    // buffers created from now on may not fit in the old udmabuf
+    udmabufFd.reset();
+    udmabufSize = 0;
 }
 
 void ShmClientBuffer::buffer_destroy_resource(wl_resource *resource)
@@ -200,6 +291,34 @@ bool ShmClientBuffer::hasAlphaChannel() const
     return alphaChannelFromDrmFormat(m_shmAttributes.format);
 }
 
+const DmaBufAttributes *ShmClientBuffer::dmabufAttributes() const
+{
+    // If the pool can be wrapped in a udmabuf, the buffer can be imported by the GPU and used
+    // for direct scanout like a linear dmabuf, without copying it. Users of the dmabuf must be
+    // prepared for the import to fail though, and fall back to the shared memory attributes
+    if (!m_dmabufChecked) {
+        m_dmabufChecked = true;
+        const FileDescriptor &udmabuf = m_shmPool->udmabuf();
+        const off_t end = m_shmAttributes.offset + off_t(m_shmAttributes.stride) * m_shmAttributes.size.height();
+        if (udmabuf.isValid() && end <= m_shmPool->udmabufSize) {
+            DmaBufAttributes attributes{
+                .planeCount = 1,
+                .width = m_shmAttributes.size.width(),
+                .height = m_shmAttributes.size.height(),
+                .format = m_shmAttributes.format,
+                .modifier = DRM_FORMAT_MOD_LINEAR,
+            };
+            attributes.fd[0] = udmabuf.duplicate();
+            attributes.offset[0] = m_shmAttributes.offset;
+            attributes.pitch[0] = m_shmAttributes.stride;
+            if (attributes.fd[0].isValid()) {
+                m_dmabufAttributes = std::move(attributes);
+            }
+        }
+    }
+    return m_dmabufAttributes ? &m_dmabufAttributes.value() : nullptr;
+}
+
 const ShmAttributes *ShmClientBuffer::shmAttributes() const
 {
     return &m_shmAttributes;
@@ -13,9 +13,13 @@
 
 #include "qwayland-server-wayland.h"
 
+#include <QPointer>
+
 namespace KWin
 {
 
+class ClientConnection;
+
 class ShmClientBufferIntegrationPrivate : public QtWaylandServer::wl_shm
 {
 public:
@@ -33,15 +37,29 @@ class ShmPool : public QtWaylandServer::wl_shm_pool
 {
 public:
     ShmPool(ShmClientBufferIntegration *integration, wl_client *client, int id, uint32_t version, FileDescriptor &&fd, std::shared_ptr<MemoryMap> mapping);
+    ~ShmPool() override;
 
     void ref();
     void unref();
 
+    /**
+     * Returns a udmabuf wrapping the pool, or an invalid file descriptor if the pool
+     * can't be wrapped in one.
+     */
+    const FileDescriptor &udmabuf();
+
+    void updateSeals();
+
     ShmClientBufferIntegration *integration;
+    // the pool can outlive the client if its buffers are still in use
+    QPointer<ClientConnection> clientConnection;
     std::shared_ptr<MemoryMap> mapping;
     FileDescriptor fd;
     int refCount = 1;
     bool sigbusImpossible = false;
+    bool writeSealed = false;
+    std::optional<FileDescriptor> udmabufFd;
+    off_t udmabufSize = 0;
 
 protected:
     void shm_pool_destroy_resource(Resource *resource) override;
@@ -70,6 +88,7 @@ public:
 
     QSize size() const override;
     bool hasAlphaChannel() const override;
+    const DmaBufAttributes *dmabufAttributes() const override;
     const ShmAttributes *shmAttributes() const override;
 
     static ShmClientBuffer *get(wl_resource *resource);
@@ -83,6 +102,8 @@ private:
     ShmPool *m_shmPool;
     ShmAttributes m_shmAttributes;
     std::optional<ShmAccess> m_shmAccess;
+    mutable std::optional<DmaBufAttributes> m_dmabufAttributes;
+    mutable bool m_dmabufChecked = false;
 };
 
 } // namespace KWin
@@ -13,6 +13,7 @@
 #include "fractionalscale_v1_p.h"
 #include "frog_colormanagement_v1.h"
 #include "idleinhibit_v1_p.h"
+#include "inputlatency.h"
 #include "linux_drm_syncobj_v1.h"
 #include "linuxdmabufv1clientbuffer.h"
 #include "output.h"
@@ -49,6 +50,14 @@ SurfaceInterfacePrivate::SurfaceInterfacePrivate(SurfaceInterface *q)
     , current(std::make_unique<SurfaceState>())
     , pending(std::make_unique<SurfaceState>())
 {
+    timedStateTimer.setSingleShot(true);
+    timedStateTimer.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&timedStateTimer, &QTimer::timeout, q, [this]() {
+        if (firstTransaction) {
+            firstTransaction->tryApply();
+        }
+        scheduleTimedStates();
+    });
 }
 
 void SurfaceInterfacePrivate::addChild(SubSurfaceInterface *child)
@@ -316,6 +325,7 @@ void SurfaceInterfacePrivate::surface_frame(Resource *resource, uint32_t callbac
     });
 
     wl_list_insert(pending->frameCallbacks.prev, wl_resource_get_link(callbackResource));
+    client->recordFrameCallback();
 }
 
 void SurfaceInterfacePrivate::surface_set_opaque_region(Resource *resource, struct ::wl_resource *region)
@@ -332,6 +342,21 @@ void SurfaceInterfacePrivate::surface_set_input_region(Resource *resource, struc
     pending->committed |= SurfaceState::Field::Input;
 }
 
+static uint64_t bufferBytes(const GraphicsBuffer *buffer)
+{
+    if (const ShmAttributes *attributes = buffer->shmAttributes()) {
+        return uint64_t(attributes->stride) * attributes->size.height();
+    }
+    if (const DmaBufAttributes *attributes = buffer->dmabufAttributes()) {
+        uint64_t bytes = 0;
+        for (int i = 0; i < attributes->planeCount; ++i) {
+            bytes += uint64_t(attributes->pitch[i]) * attributes->height;
+        }
+        return bytes;
+    }
+    return 0;
+}
+
 void SurfaceInterfacePrivate::surface_commit(Resource *resource)
 {
     const bool sync = subsurface.handle && subsurface.handle->isSynchronized();
@@ -347,6 +372,12 @@ void SurfaceInterfacePrivate::surface_commit(Resource *resource)
         pending->damage = Region();
         pending->bufferDamage = Region();
     }
+    if ((pending->committed & SurfaceState::Field::Buffer) && pending->buffer) {
+        pending->inputLatencyFeedback = compositor->display()->inputLatencyTracker()->takeFeedback(client);
+        client->recordCommit(bufferBytes(pending->buffer));
+    } else {
+        client->recordCommit(0);
+    }
 
     // unless a protocol overrides the properties, we need to assume some YUV->RGB conversion
     // matrix and color space to be attached to YUV formats
@@ -403,8 +434,9 @@ void SurfaceInterfacePrivate::surface_commit(Resource *resource)
     Transaction *transaction;
     if (sync) {
         // if the surface is in effectively synchronized mode at commit time,
-        // the fifo wait condition must be ignored
+        // the fifo wait condition and the commit timestamp must be ignored
         pending->hasFifoWaitCondition = false;
+        pending->presentationTimestamp.reset();
         if (!subsurface.transaction) {
             subsurface.transaction = std::make_unique<Transaction>();
         }
@@ -428,9 +460,45 @@ void SurfaceInterfacePrivate::surface_commit(Resource *resource)
         }
     }
 
+    const bool timed = pending->presentationTimestamp.has_value();
     transaction->add(q);
     if (!sync) {
         transaction->commit();
+        if (timed) {
+            scheduleTimedStates();
+        }
+    }
+}
+
+/**
+ * Makes sure that the earliest committed state that waits for its presentation time gets
+ * applied in time. Shortly before that time, the compositor is asked to repaint the surface
+ * on every frame so it can release the state for the frame closest to the requested time.
+ * If the surface isn't painted, the state is applied once its time has come.
+ */
+void SurfaceInterfacePrivate::scheduleTimedStates()
+{
+    // ask for frames a few refresh cycles ahead so the timing of the outputs is known
+    static constexpr std::chrono::milliseconds s_leadTime(50);
+
+    std::optional<std::chrono::nanoseconds> earliest;
+    for (auto transaction = firstTransaction; transaction; transaction = transaction->next(q)) {
+        const auto timestamp = transaction->presentationTimestamp(q);
+        if (timestamp && *timestamp > releasedPresentationTimestamp && (!earliest || *timestamp < *earliest)) {
+            earliest = timestamp;
+        }
+    }
+    if (!earliest) {
+        timedStateTimer.stop();
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    if (*earliest - now <= s_leadTime) {
+        Q_EMIT q->timedStatePending();
+        timedStateTimer.start(std::chrono::ceil<std::chrono::milliseconds>(std::max(*earliest - now, std::chrono::nanoseconds::zero())));
+    } else {
+        timedStateTimer.start(std::chrono::ceil<std::chrono::milliseconds>(*earliest - now - s_leadTime));
     }
 }
 
@@ -565,6 +633,14 @@ std::shared_ptr<PresentationFeedback> SurfaceInterface::presentationFeedback(Log
     return d->current->presentationFeedback;
 }
 
+std::shared_ptr<PresentationFeedback> SurfaceInterface::inputLatencyFeedback(LogicalOutput *output)
+{
+    if (output && (!d->primaryOutput || d->primaryOutput->handle() != output)) {
+        return nullptr;
+    }
+    return d->current->inputLatencyFeedback;
+}
+
 bool SurfaceInterface::hasPresentationFeedback() const
 {
     return d->current->presentationFeedback.get();
@@ -621,41 +697,80 @@ void SurfaceState::mergeInto(SurfaceState *target)
     damage = Region();
     target->bufferDamage |= bufferDamage;
     bufferDamage = Region();
-    target->viewport.sourceGeometry = viewport.sourceGeometry;
-    target->viewport.destinationSize = viewport.destinationSize;
-    target->subsurface = subsurface;
-    target->shadow = shadow;
-    target->slide = slide;
-    target->input = input;
-    target->opaque = opaque;
-    target->bufferScale = bufferScale;
-    target->bufferTransform = bufferTransform;
-    target->contentType = contentType;
-    target->presentationHint = presentationHint;
-    target->colorDescription = colorDescription;
-    target->colorDescriptionType = colorDescriptionType;
-    target->renderingIntent = renderingIntent;
-    target->alphaMultiplier = alphaMultiplier;
-    target->yuvCoefficients = yuvCoefficients;
+
+    // the fields that haven't been committed still hold the values of the previous commits,
+    // which the target has already got back then
+    if (committed & SurfaceState::Field::SourceGeometry) {
+        target->viewport.sourceGeometry = viewport.sourceGeometry;
+    }
+    if (committed & SurfaceState::Field::DestinationSize) {
+        target->viewport.destinationSize = viewport.destinationSize;
+    }
+    if (committed & (SurfaceState::Field::SubsurfaceOrder | SurfaceState::Field::SubsurfacePosition)) {
+        target->subsurface = subsurface;
+    }
+    if (committed & SurfaceState::Field::Shadow) {
+        target->shadow = shadow;
+    }
+    if (committed & SurfaceState::Field::Slide) {
+        target->slide = slide;
+    }
+    if (committed & SurfaceState::Field::Input) {
+        target->input = input;
+    }
+    if (committed & SurfaceState::Field::Opaque) {
+        target->opaque = opaque;
+    }
+    if (committed & SurfaceState::Field::BufferScale) {
+        target->bufferScale = bufferScale;
+    }
+    if (committed & SurfaceState::Field::BufferTransform) {
+        target->bufferTransform = bufferTransform;
+    }
+    if (committed & SurfaceState::Field::ContentType) {
+        target->contentType = contentType;
+    }
+    if (committed & SurfaceState::Field::PresentationModeHint) {
+        target->presentationHint = presentationHint;
+    }
+    if (committed & SurfaceState::Field::ColorDescription) {
+        target->colorDescription = colorDescription;
+        target->colorDescriptionType = colorDescriptionType;
+        target->renderingIntent = renderingIntent;
+    }
+    if (committed & SurfaceState::Field::AlphaMultiplier) {
+        target->alphaMultiplier = alphaMultiplier;
+    }
+    if (committed & SurfaceState::Field::YuvCoefficients) {
+        target->yuvCoefficients = yuvCoefficients;
+        target->range = range;
+    }
+    if (committed & SurfaceState::Field::Blur) {
+        target->blurRegion = blurRegion;
+    }
     target->fifoBarrier |= std::exchange(fifoBarrier, false);
     target->hasFifoWaitCondition = std::exchange(hasFifoWaitCondition, false);
-    target->yuvCoefficients = yuvCoefficients;
-    target->range = range;
+    target->presentationTimestamp = std::exchange(presentationTimestamp, std::nullopt);
     target->presentationFeedback = std::move(presentationFeedback);
-    target->blurRegion = blurRegion;
+    if (inputLatencyFeedback) {
+        // if the previous buffer hasn't been presented yet, the new one is the first to
+        // reflect the older input, so keep measuring from that
+        if (!target->inputLatencyFeedback || target->inputLatencyFeedback->isPresented()) {
+            target->inputLatencyFeedback = std::move(inputLatencyFeedback);
+        }
+        inputLatencyFeedback.reset();
+    }
 
-    auto previousExtensions = std::exchange(target->extensions, {});
+    // update the extension states in place rather than rebuilding the map on every commit
+    std::erase_if(target->extensions, [this](const auto &entry) {
+        return !extensions.contains(entry.first);
+    });
     for (const auto &[extension, sourceState] : extensions) {
-        std::unique_ptr<RawSurfaceAttachedState> targetState;
-
-        if (auto it = previousExtensions.find(extension); it != previousExtensions.end()) {
-            targetState = std::move(it->second);
-        } else {
+        std::unique_ptr<RawSurfaceAttachedState> &targetState = target->extensions[extension];
+        if (!targetState) {
             targetState = extension->createState();
         }
-
         sourceState->mergeInto(targetState.get());
-        target->extensions[extension] = std::move(targetState);
     }
 
     target->committed |= std::exchange(committed, SurfaceState::Fields{});
@@ -690,6 +805,7 @@ void SurfaceInterfacePrivate::applyState(SurfaceState *next)
     if (!bufferRef) {
         // we can't present an unmapped surface
         current->presentationFeedback.reset();
+        current->inputLatencyFeedback.reset();
     }
     scaleOverride = pendingScaleOverride;
 
@@ -798,6 +914,10 @@ void SurfaceInterfacePrivate::applyState(SurfaceState *next)
         extension->applyState(state.get());
     }
 
+    // sub-surfaces are applied before their parents, so the whole tree is done now
+    if (!subsurface.handle) {
+        Q_EMIT q->treeCommitted();
+    }
     Q_EMIT q->committed();
 }
 
@@ -1313,6 +1433,19 @@ bool SurfaceInterface::hasFifoBarrier() const
     return d->current->fifoBarrier;
 }
 
+void SurfaceInterface::releaseTimedStates(std::chrono::nanoseconds timestamp)
+{
+    if (timestamp <= d->releasedPresentationTimestamp) {
+        return;
+    }
+    d->releasedPresentationTimestamp = timestamp;
+    if (d->firstTransaction) {
+        d->firstTransaction->tryApply();
+        d->scheduleTimedStates();
+    }
+}
+
+
 } // namespace KWin
 
 #include "moc_surface.cpp"
@@ -131,6 +131,11 @@ public:
     bool hasFrameCallbacks() const;
 
     std::shared_ptr<PresentationFeedback> presentationFeedback(LogicalOutput *output);
+    /**
+     * Returns the feedback that measures the input latency of the current buffer, if input
+     * has been delivered to the client before it was committed.
+     */
+    std::shared_ptr<PresentationFeedback> inputLatencyFeedback(LogicalOutput *output);
     bool hasPresentationFeedback() const;
 
     Region opaque() const;
@@ -359,6 +364,15 @@ public:
     void clearFifoBarrier();
     bool hasFifoBarrier() const;
 
+    /**
+     * Applies the committed states that asked, with the commit-timing protocol, to be
+     * presented at @p timestamp or earlier. Should be called after compositing a frame
+     * with the presentation time of the next frame that can show the surface.
+     *
+     * @see timedStatePending()
+     */
+    void releaseTimedStates(std::chrono::nanoseconds timestamp);
+
     /**
      * Registers the specified @a extension. Returns the pending state for the extension.
      *
@@ -461,6 +475,18 @@ Q_SIGNALS:
      * for this commit are emitted.
      */
     void committed();
+    /**
+     * Emitted on the main surface once per applied transaction that affects its sub-surface
+     * tree, after the states of all affected sub-surfaces have been applied. If the main
+     * surface is part of the transaction, this is emitted right before its committed()
+     * signal. This is the point to react to changes of the tree as a whole.
+     */
+    void treeCommitted();
+    /**
+     * Emitted when a committed state is going to be presented soon, the surface should be
+     * repainted on every frame until releaseTimedStates() has let the state through.
+     */
+    void timedStatePending();
 
 private:
     std::unique_ptr<SurfaceInterfacePrivate> d;
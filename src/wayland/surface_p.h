@@ -13,6 +13,7 @@
 #include <QHash>
 #include <QList>
 #include <QPointer>
+#include <QTimer>
 // Wayland
 #include "qwayland-server-wayland.h"
 // C++
@@ -27,11 +28,13 @@ class ContentTypeV1Interface;
 class TearingControlV1Interface;
 class FractionalScaleV1Interface;
 class FrogColorManagementSurfaceV1;
+class InputLatencyFeedback;
 class PresentationTimeFeedback;
 class ColorSurfaceV1;
 class ColorFeedbackSurfaceV1;
 class LinuxDrmSyncObjSurfaceV1;
 class AlphaModifierSurfaceV1;
+class CommitTimerV1;
 class FifoV1Surface;
 class FifoBarrier;
 class ColorRepresentationSurfaceV1;
@@ -86,6 +89,7 @@ struct SurfaceState
     ColorDescriptionType colorDescriptionType = ColorDescriptionType::Normal;
     RenderingIntent renderingIntent = RenderingIntent::Perceptual;
     std::shared_ptr<PresentationTimeFeedback> presentationFeedback;
+    std::shared_ptr<InputLatencyFeedback> inputLatencyFeedback;
     struct
     {
         std::shared_ptr<SyncTimeline> timeline;
@@ -97,6 +101,11 @@ struct SurfaceState
     EncodingRange range = EncodingRange::Full;
     bool fifoBarrier = false;
     bool hasFifoWaitCondition = false;
+    /**
+     * The time at which the client wants the state to be presented, set with the
+     * commit-timing protocol. The state is held back until then.
+     */
+    std::optional<std::chrono::nanoseconds> presentationTimestamp;
     Region blurRegion;
 
     struct
@@ -144,6 +153,7 @@ public:
 
     RectF computeBufferSourceBox() const;
     void applyState(SurfaceState *next);
+    void scheduleTimedStates();
 
     bool computeEffectiveMapped() const;
     void updateEffectiveMapped();
@@ -199,6 +209,10 @@ public:
     LinuxDrmSyncObjSurfaceV1 *syncObjV1 = nullptr;
     AlphaModifierSurfaceV1 *alphaModifier = nullptr;
     FifoV1Surface *fifoSurface = nullptr;
+    CommitTimerV1 *commitTimer = nullptr;
+    // committed states that want to be presented up to this time can be applied
+    std::chrono::nanoseconds releasedPresentationTimestamp = std::chrono::nanoseconds::zero();
+    QTimer timedStateTimer;
     ColorRepresentationSurfaceV1 *colorRepresentation = nullptr;
     ExtBlurSurfaceV1 *extBlur = nullptr;
     ExtBackgroundEffectSurfaceV1 *extBackgroundeffect = nullptr;
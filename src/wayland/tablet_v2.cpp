@@ -219,6 +219,19 @@ public:
     std::optional<quint32> m_downSerial;
     bool m_cleanup = false;
     bool m_removed = false;
+    // The axis values last sent to the surface, in protocol units. Axis events only need to
+    // be sent when the value changes, so they are skipped if a tool reports the same value
+    // in every frame. Reset whenever the tool enters or leaves a surface.
+    struct SentAxes
+    {
+        std::optional<std::pair<wl_fixed_t, wl_fixed_t>> position;
+        std::optional<uint32_t> pressure;
+        std::optional<uint32_t> distance;
+        std::optional<std::pair<wl_fixed_t, wl_fixed_t>> tilt;
+        std::optional<wl_fixed_t> rotation;
+        std::optional<int32_t> slider;
+    };
+    SentAxes m_sentAxes;
     QPointer<InputDeviceTabletTool> m_device;
     QPointer<SurfaceInterface> m_surface;
     QPointer<TabletV2Interface> m_lastTablet;
@@ -328,15 +341,23 @@ void TabletToolV2Interface::sendButton(uint32_t button, bool pressed)
 void TabletToolV2Interface::sendMotion(const QPointF &pos)
 {
     const QPointF surfacePos = d->m_surface->toSurfaceLocal(pos);
+    const auto position = std::make_pair(wl_fixed_from_double(surfacePos.x()), wl_fixed_from_double(surfacePos.y()));
+    if (std::exchange(d->m_sentAxes.position, position) == position) {
+        return;
+    }
     for (auto *resource : d->targetResources()) {
-        d->send_motion(resource->handle, wl_fixed_from_double(surfacePos.x()), wl_fixed_from_double(surfacePos.y()));
+        d->send_motion(resource->handle, position.first, position.second);
     }
 }
 
 void TabletToolV2Interface::sendDistance(qreal distance)
 {
+    const uint32_t value = 65535 * distance;
+    if (std::exchange(d->m_sentAxes.distance, value) == value) {
+        return;
+    }
     for (auto *resource : d->targetResources()) {
-        d->send_distance(resource->handle, 65535 * distance);
+        d->send_distance(resource->handle, value);
     }
 }
 
@@ -355,29 +376,45 @@ void TabletToolV2Interface::sendFrame(uint32_t time)
 
 void TabletToolV2Interface::sendPressure(qreal pressure)
 {
+    const uint32_t value = 65535 * pressure;
+    if (std::exchange(d->m_sentAxes.pressure, value) == value) {
+        return;
+    }
     for (auto *resource : d->targetResources()) {
-        d->send_pressure(resource->handle, 65535 * pressure);
+        d->send_pressure(resource->handle, value);
     }
 }
 
 void TabletToolV2Interface::sendRotation(qreal rotation)
 {
+    const wl_fixed_t value = wl_fixed_from_double(rotation);
+    if (std::exchange(d->m_sentAxes.rotation, value) == value) {
+        return;
+    }
     for (auto *resource : d->targetResources()) {
-        d->send_rotation(resource->handle, wl_fixed_from_double(rotation));
+        d->send_rotation(resource->handle, value);
     }
 }
 
 void TabletToolV2Interface::sendSlider(qreal position)
 {
+    const int32_t value = 65535 * position;
+    if (std::exchange(d->m_sentAxes.slider, value) == value) {
+        return;
+    }
     for (auto *resource : d->targetResources()) {
-        d->send_slider(resource->handle, 65535 * position);
+        d->send_slider(resource->handle, value);
     }
 }
 
 void TabletToolV2Interface::sendTilt(qreal degreesX, qreal degreesY)
 {
+    const auto tilt = std::make_pair(wl_fixed_from_double(degreesX), wl_fixed_from_double(degreesY));
+    if (std::exchange(d->m_sentAxes.tilt, tilt) == tilt) {
+        return;
+    }
     for (auto *resource : d->targetResources()) {
-        d->send_tilt(resource->handle, wl_fixed_from_double(degreesX), wl_fixed_from_double(degreesY));
+        d->send_tilt(resource->handle, tilt.first, tilt.second);
     }
 }
 
@@ -397,6 +434,7 @@ void TabletToolV2Interface::sendProximityIn(TabletV2Interface *tablet)
     }
     d->m_proximitySerial = serial;
     d->m_lastTablet = tablet;
+    d->m_sentAxes = {};
 }
 
 void TabletToolV2Interface::sendProximityOut()
@@ -405,6 +443,7 @@ void TabletToolV2Interface::sendProximityOut()
         d->send_proximity_out(resource->handle);
     }
     d->m_cleanup = true;
+    d->m_sentAxes = {};
 }
 
 void TabletToolV2Interface::sendDown()
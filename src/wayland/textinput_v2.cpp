@@ -370,6 +370,10 @@ void TextInputV2InterfacePrivate::zwp_text_input_v2_hide_input_panel(Resource *r
 
 void TextInputV2InterfacePrivate::zwp_text_input_v2_set_surrounding_text(Resource *resource, const QString &text, int32_t cursor, int32_t anchor)
 {
+    // clients tend to send the surrounding text along with every other state change
+    if (surroundingText == text && surroundingTextCursorPosition == cursor && surroundingTextSelectionAnchor == anchor) {
+        return;
+    }
     surroundingText = text;
     surroundingTextCursorPosition = cursor;
     surroundingTextSelectionAnchor = anchor;
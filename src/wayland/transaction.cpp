@@ -11,6 +11,8 @@
 #include "wayland/subcompositor.h"
 #include "wayland/surface_p.h"
 
+#include <QVarLengthArray>
+
 #if defined(Q_OS_LINUX)
 #include <linux/dma-buf.h>
 #include <xf86drm.h>
@@ -61,10 +63,28 @@ bool Transaction::isReady() const
             }
         }
 
+        if (entry.state->presentationTimestamp) {
+            const std::chrono::nanoseconds timestamp = *entry.state->presentationTimestamp;
+            if (timestamp > SurfaceInterfacePrivate::get(entry.surface)->releasedPresentationTimestamp
+                && timestamp > std::chrono::steady_clock::now().time_since_epoch()) {
+                return true;
+            }
+        }
+
         return entry.state->hasFifoWaitCondition && entry.surface->hasFifoBarrier();
     });
 }
 
+std::optional<std::chrono::nanoseconds> Transaction::presentationTimestamp(SurfaceInterface *surface) const
+{
+    for (const TransactionEntry &entry : m_entries) {
+        if (entry.surface == surface) {
+            return entry.state->presentationTimestamp;
+        }
+    }
+    return std::nullopt;
+}
+
 Transaction *Transaction::next(SurfaceInterface *surface) const
 {
     for (const TransactionEntry &entry : m_entries) {
@@ -164,9 +184,25 @@ void Transaction::apply()
         return mainSurface(a.surface) < mainSurface(b.surface);
     });
 
+    // the main surfaces that are part of the transaction have already announced their trees
+    QVarLengthArray<QPointer<SurfaceInterface>, 4> mainSurfaces;
     for (TransactionEntry &entry : m_entries) {
         if (!entry.isDiscarded()) {
             SurfaceInterfacePrivate::get(entry.surface)->applyState(entry.state.get());
+            if (entry.surface && entry.surface->subSurface()) {
+                SurfaceInterface *main = mainSurface(entry.surface);
+                if (main && !mainSurfaces.contains(main)) {
+                    mainSurfaces.append(main);
+                }
+            }
+        }
+    }
+    for (TransactionEntry &entry : m_entries) {
+        mainSurfaces.removeAll(entry.surface);
+    }
+    for (const QPointer<SurfaceInterface> &main : std::as_const(mainSurfaces)) {
+        if (main) {
+            Q_EMIT main->treeCommitted();
         }
     }
 
@@ -194,8 +230,68 @@ void Transaction::apply()
     delete this;
 }
 
+/**
+ * If the previous transaction for the surface can't be applied yet, for example because the
+ * client's GPU is still rendering into its buffer, but this transaction replaces that buffer
+ * with one that's ready, fold the previous transaction into this one. Its buffer would never
+ * be shown anyway, this transaction would be applied right after it, so this only prevents a
+ * slow frame from holding back a newer one that is ready to be presented.
+ */
+bool Transaction::skipPreviousTransaction()
+{
+    // transactions that affect several surfaces must stay atomic
+    if (m_entries.size() != 1) {
+        return false;
+    }
+
+    TransactionEntry &entry = m_entries.front();
+    Transaction *previous = entry.previousTransaction;
+    if (!previous || previous->m_entries.size() != 1 || entry.isDiscarded()) {
+        return false;
+    }
+    if (!(entry.state->committed & SurfaceState::Field::Buffer)) {
+        return false;
+    }
+    if (std::ranges::any_of(entry.fences, &TransactionFence::isWaiting)) {
+        return false;
+    }
+
+    TransactionEntry &previousEntry = previous->m_entries.front();
+    // the fifo and commit-timing protocols require the previous state to be presented
+    if (entry.state->hasFifoWaitCondition || previousEntry.state->hasFifoWaitCondition || previousEntry.state->fifoBarrier) {
+        return false;
+    }
+    if (entry.state->presentationTimestamp || previousEntry.state->presentationTimestamp) {
+        return false;
+    }
+    if (previous->isReady()) {
+        return false;
+    }
+
+    entry.state->mergeInto(previousEntry.state.get());
+    entry.state = std::move(previousEntry.state);
+
+    entry.previousTransaction = previousEntry.previousTransaction;
+    if (entry.previousTransaction) {
+        for (TransactionEntry &otherEntry : entry.previousTransaction->m_entries) {
+            if (otherEntry.nextTransaction == previous) {
+                otherEntry.nextTransaction = this;
+                break;
+            }
+        }
+    } else {
+        entry.surface->setFirstTransaction(this);
+    }
+
+    delete previous;
+    return true;
+}
+
 void Transaction::tryApply()
 {
+    while (skipPreviousTransaction()) {
+    }
+
     if (isReady()) {
         apply();
     }
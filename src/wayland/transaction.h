@@ -11,8 +11,10 @@
 #include <QPointer>
 #include <QSocketNotifier>
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace KWin
@@ -108,6 +110,12 @@ public:
      */
     Transaction *next(SurfaceInterface *surface) const;
 
+    /**
+     * Returns the time at which the state for the specified \a surface should be presented,
+     * if the client has asked for one.
+     */
+    std::optional<std::chrono::nanoseconds> presentationTimestamp(SurfaceInterface *surface) const;
+
     /**
      * Adds the specified \a surface to this transaction. The transaction will move the pending
      * surface state and apply it when it's possible.
@@ -143,6 +151,7 @@ public:
 
 private:
     void apply();
+    bool skipPreviousTransaction();
 
     void watchSyncObj(TransactionEntry *entry);
     void watchDmaBuf(TransactionEntry *entry);
@@ -350,9 +350,10 @@ void XdgToplevelSessionV1Interface::write(const QVariant &value)
 }
 
 XdgSessionStorageV1::XdgSessionStorageV1(const QString &cacheName, unsigned defaultCacheSize, unsigned expectedItemSize)
-    : m_store(std::make_unique<KSharedDataCache>(cacheName, defaultCacheSize, expectedItemSize))
+    : m_cacheName(cacheName)
+    , m_defaultCacheSize(defaultCacheSize)
+    , m_expectedItemSize(expectedItemSize)
 {
-    m_store->setEvictionPolicy(KSharedDataCache::EvictOldest);
 }
 
 XdgSessionStorageV1::~XdgSessionStorageV1()
@@ -361,6 +362,10 @@ XdgSessionStorageV1::~XdgSessionStorageV1()
 
 KSharedDataCache *XdgSessionStorageV1::store() const
 {
+    if (!m_store) {
+        m_store = std::make_unique<KSharedDataCache>(m_cacheName, m_defaultCacheSize, m_expectedItemSize);
+        m_store->setEvictionPolicy(KSharedDataCache::EvictOldest);
+    }
     return m_store.get();
 }
 
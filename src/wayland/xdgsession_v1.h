@@ -42,10 +42,17 @@ public:
     XdgSessionStorageV1(const QString &cacheName, unsigned defaultCacheSize, unsigned expectedItemSize = 0);
     ~XdgSessionStorageV1();
 
+    /**
+     * Returns the cache that holds the session data. It's opened only when the first session
+     * is created or restored, most sessions never use it.
+     */
     KSharedDataCache *store() const;
 
 private:
-    std::unique_ptr<KSharedDataCache> m_store;
+    const QString m_cacheName;
+    const unsigned m_defaultCacheSize;
+    const unsigned m_expectedItemSize;
+    mutable std::unique_ptr<KSharedDataCache> m_store;
 };
 
 /**
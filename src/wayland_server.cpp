@@ -31,6 +31,7 @@
 #include "wayland/clientconnection.h"
 #include "wayland/colormanagement_v1.h"
 #include "wayland/colorrepresentation_v1.h"
+#include "wayland/committiming_v1.h"
 #include "wayland/compositor.h"
 #include "wayland/contenttype_v1.h"
 #include "wayland/cursorshape_v1.h"
@@ -531,6 +532,7 @@ bool WaylandServer::init()
     m_alphaModifierManager = new AlphaModifierManagerV1(m_display, m_display);
     new FixesInterface(m_display, m_display);
     m_fifoManager = new FifoManagerV1(m_display, m_display);
+    new CommitTimingManagerV1(m_display, m_display);
     m_singlePixelBuffer = new SinglePixelBufferManagerV1(m_display, m_display);
     m_toplevelTag = new XdgToplevelTagManagerV1(m_display, m_display);
     m_colorRepresentation = new ColorRepresentationManagerV1(m_display, m_display);
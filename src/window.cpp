@@ -701,6 +701,7 @@ void Window::setDesktops(QList<VirtualDesktop *> desktops)
     }
 
     m_desktops = desktops;
+    m_onCurrentDesktopCacheKey = nullptr;
 
     if (windowManagementInterface()) {
         if (m_desktops.isEmpty()) {
@@ -812,7 +813,17 @@ bool Window::isOnDesktop(VirtualDesktop *desktop) const
 
 bool Window::isOnCurrentDesktop() const
 {
-    return isOnDesktop(VirtualDesktopManager::self()->currentDesktop());
+    // this is checked for every window in the stacking order, e.g. on every pointer motion,
+    // while the desktops of a window and the current desktop rarely change
+    VirtualDesktop *current = VirtualDesktopManager::self()->currentDesktop();
+    if (!current) {
+        return isOnAllDesktops();
+    }
+    if (m_onCurrentDesktopCacheKey != current) {
+        m_onCurrentDesktopCacheKey = current;
+        m_onCurrentDesktopCache = isOnDesktop(current);
+    }
+    return m_onCurrentDesktopCache;
 }
 
 Qt::Edge Window::titlebarPosition() const
@@ -2428,6 +2439,11 @@ bool Window::isWaitingForInteractiveResizeSync() const
     return false;
 }
 
+bool Window::hasPendingConfigure() const
+{
+    return false;
+}
+
 void Window::doInteractiveResizeSync(const RectF &rect)
 {
     moveResize(rect);
@@ -2659,6 +2675,7 @@ void Window::updateDecorationInputShape()
 {
     if (!isDecorated()) {
         m_decoration.inputRegion = Region();
+        Q_EMIT decorationInputRegionChanged();
         return;
     }
 
@@ -2669,6 +2686,7 @@ void Window::updateDecorationInputShape()
     const RectF outerRect = innerRect + borders + resizeBorders;
 
     m_decoration.inputRegion = Region(outerRect.roundedOut()) - innerRect.roundedIn();
+    Q_EMIT decorationInputRegionChanged();
 }
 
 void Window::updateDecorationBorderRadius()
@@ -4395,9 +4413,19 @@ void Window::evaluateWindowRules()
     applyWindowRules();
 }
 
+void Window::evaluateCaptionWindowRules()
+{
+    const WindowRules previousRules = m_rules;
+    setupWindowRules();
+    // the caption changes often, don't apply the rules again if none of them started or stopped matching
+    if (m_rules != previousRules) {
+        applyWindowRules();
+    }
+}
+
 void Window::setupWindowRules()
 {
-    disconnect(this, &Window::captionNormalChanged, this, &Window::evaluateWindowRules);
+    disconnect(this, &Window::captionNormalChanged, this, &Window::evaluateCaptionWindowRules);
     m_rules = workspace()->rulebook()->find(this);
     // check only after getting the rules, because there may be a rule forcing window type
 }
@@ -4412,7 +4440,7 @@ void Window::updateWindowRules(Rules::Types selection)
 
 void Window::finishWindowRules()
 {
-    disconnect(this, &Window::captionNormalChanged, this, &Window::evaluateWindowRules);
+    disconnect(this, &Window::captionNormalChanged, this, &Window::evaluateCaptionWindowRules);
     updateWindowRules(Rules::All);
     m_rules = WindowRules();
 }
@@ -4545,6 +4573,11 @@ bool Window::isShown() const
     return !isDeleted() && !isHidden() && !isHiddenByShowDesktop() && !isMinimized();
 }
 
+bool Window::isShownOnCurrentDesktop() const
+{
+    return isShown() && isOnCurrentDesktop() && isOnCurrentActivity();
+}
+
 bool Window::isHidden() const
 {
     return m_hidden;
@@ -768,6 +768,13 @@ public:
      */
     void moveResize(const RectF &geometry);
 
+    /**
+     * Returns @c true if the window has been asked to change its geometry and hasn't applied
+     * the change yet. The pendingConfigureApplied() signal is emitted once it has.
+     * Default implementation returns @c false.
+     */
+    virtual bool hasPendingConfigure() const;
+
     /**
      * Returns @c true if the window has already been placed in the workspace; otherwise returns @c false.
      */
@@ -1028,6 +1035,11 @@ public:
     virtual bool isPlaceable() const;
     virtual bool isCloseable() const = 0;
     bool isShown() const;
+    /**
+     * Returns @c true if the window is shown and on the current virtual desktop and activity,
+     * i.e. the user can see it unless other windows cover it.
+     */
+    bool isShownOnCurrentDesktop() const;
     bool isHidden() const;
     void setHidden(bool hidden);
     bool isHiddenByShowDesktop() const;
@@ -1120,6 +1132,7 @@ public:
     void setupWindowRules();
     void finishWindowRules();
     void evaluateWindowRules();
+    void evaluateCaptionWindowRules();
     virtual void updateWindowRules(Rules::Types selection);
     virtual void applyWindowRules();
     virtual bool supportsWindowRules() const;
@@ -1228,6 +1241,13 @@ public:
     {
         return m_decoration.decoration != nullptr;
     }
+    /**
+     * The region of the decoration that accepts input, relative to the frame geometry.
+     */
+    const Region &decorationInputRegion() const
+    {
+        return m_decoration.inputRegion;
+    }
     Decoration::DecoratedWindowImpl *decoratedWindow() const;
     void setDecoratedWindow(Decoration::DecoratedWindowImpl *client);
     bool decorationHasAlpha() const;
@@ -1419,6 +1439,7 @@ Q_SIGNALS:
     void damaged(KWin::Window *window);
     void inputTransformationChanged();
     void closed();
+    void pendingConfigureApplied();
     /**
      * Emitted whenever the Window's screen changes. This can happen either in consequence to
      * a screen being removed/added or if the Window's geometry changes.
@@ -1510,6 +1531,7 @@ Q_SIGNALS:
     void applicationMenuActiveChanged(bool);
     void unresponsiveChanged(bool);
     void decorationChanged();
+    void decorationInputRegionChanged();
     void hiddenChanged();
     void hiddenByShowDesktopChanged();
     void lockScreenOverlayChanged();
@@ -1847,6 +1869,9 @@ protected:
     bool m_excludeFromCapture = false;
     QTimer *m_autoRaiseTimer = nullptr;
     QList<VirtualDesktop *> m_desktops;
+    // isOnCurrentDesktop() for the desktop that was current when it was last called
+    mutable VirtualDesktop *m_onCurrentDesktopCacheKey = nullptr;
+    mutable bool m_onCurrentDesktopCache = false;
 
     QStringList m_activityList;
     int m_activityUpdatesBlocked = 0;
@@ -0,0 +1,145 @@
+/*
+    KWin - the KDE window manager
+    This file is part of the KDE project.
+
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "windowhittestindex.h"
+#include "virtualdesktops.h"
+#include "wayland/surface.h"
+#include "window.h"
+#include "workspace.h"
+#if KWIN_BUILD_ACTIVITIES
+#include "activities.h"
+#endif
+
+#include <cmath>
+
+namespace KWin
+{
+
+// big enough that fullscreen windows only cover a few dozen cells
+static constexpr int s_cellSize = 512;
+
+WindowHitTestIndex::WindowHitTestIndex(Workspace *workspace)
+    : m_workspace(workspace)
+{
+    connect(workspace, &Workspace::stackingOrderChanged, this, &WindowHitTestIndex::invalidate);
+    connect(VirtualDesktopManager::self(), &VirtualDesktopManager::currentChanged, this, &WindowHitTestIndex::invalidate);
+#if KWIN_BUILD_ACTIVITIES
+    if (Activities *activities = workspace->activities()) {
+        connect(activities, &Activities::currentChanged, this, &WindowHitTestIndex::invalidate);
+    }
+#endif
+}
+
+void WindowHitTestIndex::add(Window *window)
+{
+    connect(window, &Window::closed, this, &WindowHitTestIndex::invalidate);
+    connect(window, &Window::bufferGeometryChanged, this, &WindowHitTestIndex::invalidate);
+    connect(window, &Window::frameGeometryChanged, this, &WindowHitTestIndex::invalidate);
+    connect(window, &Window::decorationInputRegionChanged, this, &WindowHitTestIndex::invalidate);
+    connect(window, &Window::desktopsChanged, this, &WindowHitTestIndex::invalidate);
+    connect(window, &Window::activitiesChanged, this, &WindowHitTestIndex::invalidate);
+    connect(window, &Window::minimizedChanged, this, &WindowHitTestIndex::invalidate);
+    connect(window, &Window::hiddenChanged, this, &WindowHitTestIndex::invalidate);
+    connect(window, &Window::hiddenByShowDesktopChanged, this, &WindowHitTestIndex::invalidate);
+    connect(window, &Window::readyForPaintingChanged, this, &WindowHitTestIndex::invalidate);
+    connect(window, &Window::surfaceChanged, this, [this, window]() {
+        trackSurface(window);
+    });
+    trackSurface(window);
+    invalidate();
+}
+
+void WindowHitTestIndex::remove(Window *window)
+{
+    disconnect(m_surfaceConnections.take(window));
+    invalidate();
+}
+
+void WindowHitTestIndex::trackSurface(Window *window)
+{
+    disconnect(m_surfaceConnections.take(window));
+    // sub-surfaces can extend the input bounds beyond the buffer geometry
+    if (SurfaceInterface *surface = window->surface()) {
+        m_surfaceConnections.insert(window, connect(surface, &SurfaceInterface::committed, this, &WindowHitTestIndex::invalidate));
+    }
+    invalidate();
+}
+
+void WindowHitTestIndex::invalidate()
+{
+    m_dirty = true;
+}
+
+bool WindowHitTestIndex::acceptsInput(const Window *window)
+{
+    if (window->isDeleted()) {
+        // a deleted window doesn't get mouse events
+        return false;
+    }
+    if (!window->isOnCurrentActivity() || !window->isOnCurrentDesktop() || window->isMinimized() || window->isHidden() || window->isHiddenByShowDesktop()) {
+        return false;
+    }
+    return window->readyForPainting();
+}
+
+RectF WindowHitTestIndex::inputBounds(const Window *window)
+{
+    RectF bounds = window->bufferGeometry() | window->frameGeometry();
+    if (window->isDecorated()) {
+        bounds |= RectF(window->decorationInputRegion().boundingRect()).translated(window->frameGeometry().topLeft());
+    }
+    if (const SurfaceInterface *surface = window->surface()) {
+        bounds |= surface->boundingRect().translated(window->bufferGeometry().topLeft());
+    }
+    return bounds;
+}
+
+quint64 WindowHitTestIndex::cellKey(int x, int y)
+{
+    return (quint64(quint32(x)) << 32) | quint32(y);
+}
+
+void WindowHitTestIndex::rebuild()
+{
+    m_cells.clear();
+    const QList<Window *> &stacking = m_workspace->stackingOrder();
+    for (auto it = stacking.crbegin(); it != stacking.crend(); ++it) {
+        Window *window = *it;
+        if (!acceptsInput(window)) {
+            continue;
+        }
+        const RectF bounds = inputBounds(window);
+        if (bounds.isEmpty()) {
+            continue;
+        }
+        const int left = std::floor(bounds.left() / s_cellSize);
+        const int top = std::floor(bounds.top() / s_cellSize);
+        const int right = std::floor(bounds.right() / s_cellSize);
+        const int bottom = std::floor(bounds.bottom() / s_cellSize);
+        for (int y = top; y <= bottom; y++) {
+            for (int x = left; x <= right; x++) {
+                m_cells[cellKey(x, y)].append(window);
+            }
+        }
+    }
+    m_dirty = false;
+}
+
+const QList<Window *> &WindowHitTestIndex::candidatesAt(const QPointF &pos)
+{
+    if (m_dirty) {
+        rebuild();
+    }
+    static const QList<Window *> empty;
+    const auto it = m_cells.constFind(cellKey(std::floor(pos.x() / s_cellSize), std::floor(pos.y() / s_cellSize)));
+    return it != m_cells.constEnd() ? *it : empty;
+}
+
+} // namespace KWin
+
+#include "moc_windowhittestindex.cpp"
@@ -0,0 +1,63 @@
+/*
+    KWin - the KDE window manager
+    This file is part of the KDE project.
+
+    SPDX-FileCopyrightText: 2026 The KWin developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "core/rect.h"
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+
+namespace KWin
+{
+
+class Window;
+class Workspace;
+
+/**
+ * The WindowHitTestIndex class is a spatial index of the windows that can receive input.
+ *
+ * Windows that are deleted, minimized, hidden or not on the current desktop and activity
+ * are left out, and the remaining ones are sorted into a grid of cells by their input bounds.
+ * Every cell lists the windows overlapping it from the top to the bottom of the stacking order,
+ * so finding the window at a position only needs to hit test the few windows in its cell.
+ *
+ * The index is rebuilt lazily on the next lookup after anything it depends on has changed.
+ */
+class WindowHitTestIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit WindowHitTestIndex(Workspace *workspace);
+
+    /**
+     * Returns the windows whose input bounds may contain @p pos, topmost first. The caller
+     * still has to hit test the windows.
+     */
+    const QList<Window *> &candidatesAt(const QPointF &pos);
+
+    void add(Window *window);
+    void remove(Window *window);
+
+private:
+    void invalidate();
+    void rebuild();
+    void trackSurface(Window *window);
+    static bool acceptsInput(const Window *window);
+    static RectF inputBounds(const Window *window);
+    static quint64 cellKey(int x, int y);
+
+    Workspace *const m_workspace;
+    QHash<quint64, QList<Window *>> m_cells;
+    QHash<Window *, QMetaObject::Connection> m_surfaceConnections;
+    bool m_dirty = true;
+};
+
+} // namespace KWin
@@ -14,6 +14,7 @@
 // kwin libs
 #include "opengl/glplatform.h"
 // kwin
+#include "core/gpumemorystatistics.h"
 #include "core/output.h"
 #if KWIN_BUILD_ACTIVITIES
 #include "activities.h"
@@ -65,6 +66,7 @@
 #include "wayland/externalbrightness_v1.h"
 #include "wayland/surface.h"
 #include "wayland_server.h"
+#include "windowhittestindex.h"
 #if KWIN_BUILD_X11
 #include "atoms.h"
 #include "core/brightnessdevice.h"
@@ -158,6 +160,10 @@ Workspace::Workspace()
     }
 #endif
 
+    m_hitTestIndex = std::make_unique<WindowHitTestIndex>(this);
+    connect(this, &Workspace::windowAdded, m_hitTestIndex.get(), &WindowHitTestIndex::add);
+    connect(this, &Workspace::windowRemoved, m_hitTestIndex.get(), &WindowHitTestIndex::remove);
+
 #if KWIN_BUILD_TABBOX
     // need to create the tabbox before compositing scene is setup
     m_tabbox = std::make_unique<TabBox::TabBox>();
@@ -1011,11 +1017,12 @@ void Workspace::slotReconfigure()
     Q_EMIT configChanged();
     m_userActionsMenu->discard();
 
-    m_rulebook->load();
-    for (Window *window : std::as_const(m_windows)) {
-        if (window->supportsWindowRules()) {
-            window->evaluateWindowRules();
-            m_rulebook->discardUsed(window, false);
+    if (m_rulebook->load()) {
+        for (Window *window : std::as_const(m_windows)) {
+            if (window->supportsWindowRules()) {
+                window->evaluateWindowRules();
+                m_rulebook->discardUsed(window, false);
+            }
         }
     }
 
@@ -1123,7 +1130,7 @@ void Workspace::activateWindowOnDesktop(VirtualDesktop *desktop)
     // If "unreasonable focus policy" and m_activeWindow is on_all_desktops and
     // under mouse (Hence == old_active_window), conserve focus.
     // (Thanks to Volker Schatz <V.Schatz at thphys.uni-heidelberg.de>)
-    else if (m_activeWindow && m_activeWindow->isShown() && m_activeWindow->isOnCurrentDesktop() && m_activeWindow->isOnCurrentActivity()) {
+    else if (m_activeWindow && m_activeWindow->isShownOnCurrentDesktop()) {
         window = m_activeWindow;
     }
 
@@ -1142,7 +1149,7 @@ void Workspace::activateWindowOnDesktop(VirtualDesktop *desktop)
 
 Window *Workspace::findWindowToActivateOnDesktop(VirtualDesktop *desktop)
 {
-    if (m_moveResizeWindow != nullptr && m_activeWindow == m_moveResizeWindow && m_focusChain->contains(m_activeWindow, desktop) && m_activeWindow->isShown() && m_activeWindow->isOnCurrentDesktop() && m_activeWindow->isOnCurrentActivity()) {
+    if (m_moveResizeWindow != nullptr && m_activeWindow == m_moveResizeWindow && m_focusChain->contains(m_activeWindow, desktop) && m_activeWindow->isShownOnCurrentDesktop()) {
         // A requestFocus call will fail, as the window is already active
         return m_activeWindow;
     }
@@ -1184,7 +1191,10 @@ void Workspace::updateCurrentActivity(const QString &new_activity)
         return;
     }
 
-    updateWindowVisibilityAndActivateOnDesktopChange(VirtualDesktopManager::self()->currentDesktop());
+    // don't go through all windows a second time if the desktop switch did it already
+    if (!m_activities->switchedDesktop()) {
+        updateWindowVisibilityAndActivateOnDesktopChange(VirtualDesktopManager::self()->currentDesktop());
+    }
 
     Q_EMIT currentActivityChanged();
 #endif
@@ -1946,6 +1956,7 @@ QString Workspace::supportInformation() const
             }
 
             support.append(QStringLiteral("OpenGL 2 Shaders are used\n"));
+            support.append(GpuMemoryStatistics::supportInformation());
             break;
         }
         case QPainterCompositing:
@@ -3079,6 +3090,11 @@ Outline *Workspace::outline() const
     return m_outline.get();
 }
 
+WindowHitTestIndex *Workspace::hitTestIndex() const
+{
+    return m_hitTestIndex.get();
+}
+
 Placement *Workspace::placement() const
 {
     return m_placement.get();
@@ -380,6 +380,11 @@ bool X11Window::manage(xcb_window_t w, bool isMapped)
     auto applicationMenuServiceNameCookie = fetchApplicationMenuServiceName();
     auto applicationMenuObjectPathCookie = fetchApplicationMenuObjectPath();
     auto pidCookie = fetchPid();
+    auto syncCounterCookie = fetchSyncCounter();
+    // only needed if the window has no _NET_WM_NAME or _NET_WM_ICON_NAME, but it's cheaper to
+    // discard the replies than to wait for them one by one after the NETWinInfo roundtrip
+    auto nameCookie = fetchNameProperty(XCB_ATOM_WM_NAME);
+    auto iconicNameCookie = fetchNameProperty(XCB_ATOM_WM_ICON_NAME);
 
     m_geometryHints.init(window());
     m_motif.init(window());
@@ -397,8 +402,8 @@ bool X11Window::manage(xcb_window_t w, bool isMapped)
     getResourceClass();
     readWmClientLeader(wmClientLeaderCookie);
     getWmClientMachine();
-    getSyncCounter();
-    setCaption(readName());
+    readSyncCounter(syncCounterCookie);
+    setCaption(readName(nameCookie));
 
     // Sending ConfigureNotify is done when setting mapping state below, getting the
     // first sync response means window is ready for compositing.
@@ -416,7 +421,7 @@ bool X11Window::manage(xcb_window_t w, bool isMapped)
     }
     updateShapeRegion();
     detectNoBorder();
-    fetchIconicName();
+    readIconicName(iconicNameCookie);
     setClientFrameExtents(info->gtkFrameExtents());
 
     // Needs to be done before readTransient() because of reading the group
@@ -1660,29 +1665,40 @@ void X11Window::fetchName()
     setCaption(readName());
 }
 
-static inline QString readNameProperty(xcb_window_t w, xcb_atom_t atom)
+Xcb::Property X11Window::fetchNameProperty(xcb_atom_t atom) const
 {
-    const auto cookie = xcb_icccm_get_text_property_unchecked(kwinApp()->x11Connection(), w, atom);
-    xcb_icccm_get_text_property_reply_t reply;
-    if (xcb_icccm_get_wm_name_reply(kwinApp()->x11Connection(), cookie, &reply, nullptr)) {
-        QString retVal;
-        if (reply.encoding == atoms->utf8_string) {
-            retVal = QString::fromUtf8(QByteArray(reply.name, reply.name_len));
-        } else if (reply.encoding == XCB_ATOM_STRING) {
-            retVal = QString::fromLatin1(QByteArray(reply.name, reply.name_len));
-        }
-        xcb_icccm_get_text_property_reply_wipe(&reply);
-        return retVal.simplified();
+    return Xcb::Property(false, window(), atom, XCB_ATOM_ANY, 0, 10000);
+}
+
+static inline QString readNameProperty(Xcb::Property &property)
+{
+    const xcb_get_property_reply_t *reply = property.data();
+    if (!reply) {
+        return QString();
+    }
+    if (reply->type == atoms->utf8_string) {
+        return QString::fromUtf8(property.toByteArray(8, reply->type).value_or(QByteArray())).simplified();
+    } else if (reply->type == XCB_ATOM_STRING) {
+        return QString::fromLatin1(property.toByteArray(8, reply->type).value_or(QByteArray())).simplified();
     }
     return QString();
 }
 
 QString X11Window::readName() const
+{
+    Xcb::Property property;
+    if (!info->name() || info->name()[0] == '\0') {
+        property = fetchNameProperty(XCB_ATOM_WM_NAME);
+    }
+    return readName(property);
+}
+
+QString X11Window::readName(Xcb::Property &property) const
 {
     if (info->name() && info->name()[0] != '\0') {
         return QString::fromUtf8(info->name()).simplified();
     } else {
-        return readNameProperty(window(), XCB_ATOM_WM_NAME);
+        return readNameProperty(property);
     }
 }
 
@@ -1745,12 +1761,21 @@ void X11Window::updateCaption()
 }
 
 void X11Window::fetchIconicName()
+{
+    Xcb::Property property;
+    if (!info->iconName() || info->iconName()[0] == '\0') {
+        property = fetchNameProperty(XCB_ATOM_WM_ICON_NAME);
+    }
+    readIconicName(property);
+}
+
+void X11Window::readIconicName(Xcb::Property &property)
 {
     QString s;
     if (info->iconName() && info->iconName()[0] != '\0') {
         s = QString::fromUtf8(info->iconName());
     } else {
-        s = readNameProperty(window(), XCB_ATOM_WM_ICON_NAME);
+        s = readNameProperty(property);
     }
     if (s != cap_iconic) {
         bool was_set = !cap_iconic.isEmpty();
@@ -1835,19 +1860,33 @@ void X11Window::getIcons()
     setIcon(icon);
 }
 
-void X11Window::getSyncCounter()
+static bool isSyncRequestSupported()
 {
-    if (!Xcb::Extensions::self()->isSyncAvailable()) {
-        return;
+    static bool noXsync = qEnvironmentVariableIntValue("KWIN_X11_NO_SYNC_REQUEST") == 1;
+    return Xcb::Extensions::self()->isSyncAvailable() && !noXsync;
+}
+
+Xcb::Property X11Window::fetchSyncCounter() const
+{
+    if (!isSyncRequestSupported()) {
+        return Xcb::Property();
     }
+    return Xcb::Property(false, window(), atoms->net_wm_sync_request_counter, XCB_ATOM_CARDINAL, 0, 1);
+}
 
-    static bool noXsync = qEnvironmentVariableIntValue("KWIN_X11_NO_SYNC_REQUEST") == 1;
-    if (noXsync) {
+void X11Window::getSyncCounter()
+{
+    Xcb::Property property = fetchSyncCounter();
+    readSyncCounter(property);
+}
+
+void X11Window::readSyncCounter(Xcb::Property &property)
+{
+    if (!isSyncRequestSupported()) {
         return;
     }
 
-    Xcb::Property syncProp(false, window(), atoms->net_wm_sync_request_counter, XCB_ATOM_CARDINAL, 0, 1);
-    const xcb_sync_counter_t counter = syncProp.value<xcb_sync_counter_t>().value_or(XCB_NONE);
+    const xcb_sync_counter_t counter = property.value<xcb_sync_counter_t>().value_or(XCB_NONE);
     if (counter != XCB_NONE) {
         m_syncRequest.enabled = true;
         m_syncRequest.counter = counter;
@@ -1909,6 +1948,7 @@ void X11Window::sendSyncRequest()
                       m_syncRequest.value.lo, m_syncRequest.value.hi);
     m_syncRequest.pending = true;
     m_syncRequest.interactiveResize = isInteractiveResize();
+    m_syncRequest.sent.start();
 }
 
 bool X11Window::wantsInput() const
@@ -2246,10 +2286,35 @@ void X11Window::ackSync()
     if (m_syncRequest.timeout) {
         m_syncRequest.timeout->stop();
     }
+    if (m_syncRequest.interactiveResize) {
+        updateSyncLatency();
+    }
 
     setAllowCommits(true);
 }
 
+void X11Window::updateSyncLatency()
+{
+    static const bool adaptive = qEnvironmentVariableIntValue("KWIN_X11_NO_ADAPTIVE_SYNC_REQUEST") != 1;
+    if (!adaptive || !output()) {
+        return;
+    }
+
+    // every resize step waits for the client, so a client that takes longer than a frame to
+    // respond caps the resize at its own pace. If that happens repeatedly, resize without
+    // waiting for the rest of the interactive resize, which looks less choppy
+    static constexpr int maxSlowAcks = 8;
+    const qint64 frameTime = 1'000'000'000'000 / std::max<uint32_t>(output()->refreshRate(), 1);
+    if (m_syncRequest.sent.nsecsElapsed() > frameTime) {
+        if (++m_syncRequest.slowAcks == maxSlowAcks) {
+            qCDebug(KWIN_CORE) << "Resizing" << this << "without waiting for sync requests";
+            m_syncRequest.unsynchronizedResize = true;
+        }
+    } else {
+        m_syncRequest.slowAcks = 0;
+    }
+}
+
 void X11Window::ackSyncTimeout()
 {
     // If a sync request times out, disable XSync temporarily until the client comes back to its senses.
@@ -3957,9 +4022,16 @@ Rect X11Window::fullscreenMonitorsArea(NETFullscreenMonitors requestedTopology)
     return total;
 }
 
+void X11Window::doFinishInteractiveMoveResize()
+{
+    // give the client another chance in the next interactive resize
+    m_syncRequest.slowAcks = 0;
+    m_syncRequest.unsynchronizedResize = false;
+}
+
 bool X11Window::isWaitingForInteractiveResizeSync() const
 {
-    return m_syncRequest.enabled && (m_syncRequest.pending || m_syncRequest.acked);
+    return m_syncRequest.enabled && !m_syncRequest.unsynchronizedResize && (m_syncRequest.pending || m_syncRequest.acked);
 }
 
 void X11Window::doInteractiveResizeSync(const RectF &rect)
@@ -3972,7 +4044,7 @@ void X11Window::doInteractiveResizeSync(const RectF &rect)
         return;
     }
 
-    if (!m_syncRequest.enabled) {
+    if (!m_syncRequest.enabled || m_syncRequest.unsynchronizedResize) {
         moveResize(rect);
     } else {
         setMoveResizeGeometry(moveResizeFrameGeometry);
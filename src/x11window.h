@@ -211,6 +211,13 @@ public:
     void readApplicationMenuObjectPath(Xcb::StringProperty &property);
     void checkApplicationMenuObjectPath();
 
+    enum class DeferredUpdate {
+        Name = 0x1,
+        IconicName = 0x2,
+        Icons = 0x4,
+    };
+    Q_DECLARE_FLAGS(DeferredUpdates, DeferredUpdate)
+
     struct SyncRequest
     {
         xcb_sync_counter_t counter = XCB_NONE;
@@ -221,6 +228,10 @@ public:
         bool pending = false;
         bool acked = false;
         bool interactiveResize = false;
+        // used to stop synchronizing the interactive resize with clients that can't keep up
+        QElapsedTimer sent;
+        int slowAcks = 0;
+        bool unsynchronizedResize = false;
     };
     const SyncRequest &syncRequest() const
     {
@@ -229,6 +240,7 @@ public:
     void ackSync();
     void ackSyncTimeout();
     void finishSync();
+    void updateSyncLatency();
 
     bool allowWindowActivation(xcb_timestamp_t time = -1U, bool focus_in = false);
 
@@ -267,6 +279,7 @@ protected:
     void doSetHiddenByShowDesktop() override;
     void doSetModal() override;
     bool belongsToDesktop() const override;
+    void doFinishInteractiveMoveResize() override;
     bool isWaitingForInteractiveResizeSync() const override;
     void doInteractiveResizeSync(const RectF &rect) override;
     QSizeF resizeIncrements() const override;
@@ -291,9 +304,19 @@ private:
     void getIcons();
     void getWmOpaqueRegion();
     void updateShapeRegion();
+    /**
+     * Schedules an update for the next event loop iteration, so a burst of property changes
+     * results in one caption or icon change.
+     */
+    void scheduleUpdate(DeferredUpdate update);
+    void performDeferredUpdates();
+
     void fetchName();
     void fetchIconicName();
+    void readIconicName(Xcb::Property &property);
+    Xcb::Property fetchNameProperty(xcb_atom_t atom) const;
     QString readName() const;
+    QString readName(Xcb::Property &property) const;
     void setCaption(const QString &s, bool force = false);
     bool hasTransientInternal(const X11Window *c, bool indirect, QList<const X11Window *> &set) const;
     void setShortcutInternal() override;
@@ -305,6 +328,8 @@ private:
     void getSkipCloseAnimation();
 
     void configureRequest(int value_mask, qreal rx, qreal ry, qreal rw, qreal rh, int gravity, bool from_tool);
+    Xcb::Property fetchSyncCounter() const;
+    void readSyncCounter(Xcb::Property &property);
     void getSyncCounter();
     void sendSyncRequest();
 
@@ -427,6 +452,7 @@ private:
     bool m_frameCallbackHeartbeat = false;
     quint64 m_surfaceSerial = 0;
     int m_inflightUnmaps = 0;
+    DeferredUpdates m_deferredUpdates;
 };
 
 /**
@@ -550,5 +576,6 @@ inline void X11Window::unblockGeometryUpdates()
 }
 
 } // namespace
+Q_DECLARE_OPERATORS_FOR_FLAGS(KWin::X11Window::DeferredUpdates)
 Q_DECLARE_METATYPE(KWin::X11Window *)
 Q_DECLARE_METATYPE(QList<KWin::X11Window *>)
@@ -73,9 +73,7 @@ XdgSurfaceWindow::XdgSurfaceWindow(XdgSurfaceInterface *shellSurface)
             this, &XdgSurfaceWindow::setHaveNextWindowGeometry);
     connect(treeMonitor, &SubSurfaceMonitor::subSurfaceRemoved,
             this, &XdgSurfaceWindow::setHaveNextWindowGeometry);
-    connect(treeMonitor, &SubSurfaceMonitor::subSurfaceMoved,
-            this, &XdgSurfaceWindow::setHaveNextWindowGeometry);
-    connect(treeMonitor, &SubSurfaceMonitor::subSurfaceResized,
+    connect(treeMonitor, &SubSurfaceMonitor::subSurfaceTreeChanged,
             this, &XdgSurfaceWindow::setHaveNextWindowGeometry);
     connect(shellSurface, &XdgSurfaceInterface::windowGeometryChanged,
             this, &XdgSurfaceWindow::setHaveNextWindowGeometry);
@@ -104,6 +102,11 @@ XdgSurfaceConfigure *XdgSurfaceWindow::lastAcknowledgedConfigure() const
     return m_lastAcknowledgedConfigure.get();
 }
 
+bool XdgSurfaceWindow::hasPendingConfigure() const
+{
+    return m_configureTimer->isActive() || !m_configureEvents.isEmpty();
+}
+
 void XdgSurfaceWindow::scheduleConfigure()
 {
     if (!isDeleted()) {
@@ -147,6 +150,7 @@ void XdgSurfaceWindow::handleCommit()
         return;
     }
 
+    const bool hadPendingConfigure = hasPendingConfigure();
     if (m_lastAcknowledgedConfigureSerial.has_value()) {
         const quint32 serial = m_lastAcknowledgedConfigureSerial.value();
         while (!m_configureEvents.isEmpty()) {
@@ -168,6 +172,10 @@ void XdgSurfaceWindow::handleCommit()
     m_lastAcknowledgedConfigureSerial.reset();
 
     markAsMapped();
+
+    if (hadPendingConfigure && !hasPendingConfigure()) {
+        Q_EMIT pendingConfigureApplied();
+    }
 }
 
 void XdgSurfaceWindow::handleRolePrecommit()
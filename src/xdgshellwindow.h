@@ -70,6 +70,8 @@ public:
 
     void installPlasmaShellSurface(PlasmaShellSurfaceInterface *shellSurface);
 
+    bool hasPendingConfigure() const override;
+
 protected:
     void moveResizeInternal(const RectF &rect, MoveResizeMode mode) override;
 
@@ -25,6 +25,7 @@
 #include <xkbcommon/xkbcommon-keysyms.h>
 // system
 #include "main.h"
+#include <algorithm>
 #include <bitset>
 #include <linux/input-event-codes.h>
 #include <sys/mman.h>
@@ -509,6 +510,9 @@ Xkb::~Xkb()
     xkb_compose_table_unref(m_compose.table);
     xkb_state_unref(m_state);
     xkb_keymap_unref(m_keymap);
+    for (const CachedKeymap &cached : m_keymapCache) {
+        xkb_keymap_unref(cached.keymap);
+    }
     xkb_context_unref(m_context);
 }
 
@@ -604,7 +608,7 @@ xkb_keymap *Xkb::loadKeymapFromConfig()
 
     m_layoutList = QString::fromLatin1(ruleNames.layout).split(QLatin1Char(','));
 
-    return xkb_keymap_new_from_names(m_context, &ruleNames, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    return compileKeymap(ruleNames);
 }
 
 xkb_keymap *Xkb::loadDefaultKeymap()
@@ -612,7 +616,7 @@ xkb_keymap *Xkb::loadDefaultKeymap()
     xkb_rule_names ruleNames = {};
     applyEnvironmentRules(ruleNames);
     m_layoutList = QString::fromLatin1(ruleNames.layout).split(QLatin1Char(','));
-    return xkb_keymap_new_from_names(m_context, &ruleNames, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    return compileKeymap(ruleNames);
 }
 
 xkb_keymap *Xkb::loadKeymapFromLocale1()
@@ -637,7 +641,52 @@ xkb_keymap *Xkb::loadKeymapFromLocale1()
 
     m_layoutList = QString::fromLatin1(ruleNames.layout).split(QLatin1Char(','));
 
-    return xkb_keymap_new_from_names(m_context, &ruleNames, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    return compileKeymap(ruleNames);
+}
+
+xkb_keymap *Xkb::compileKeymap(const xkb_rule_names &ruleNames)
+{
+    // a null field picks the default, an empty one doesn't, so keep them apart in the key
+    QByteArray key;
+    for (const char *name : {ruleNames.rules, ruleNames.model, ruleNames.layout, ruleNames.variant, ruleNames.options}) {
+        if (name) {
+            key += '=';
+            key += name;
+        }
+        key += '\0';
+    }
+    if (xkb_keymap *keymap = cachedKeymap(key)) {
+        return keymap;
+    }
+    xkb_keymap *keymap = xkb_keymap_new_from_names(m_context, &ruleNames, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    if (keymap) {
+        cacheKeymap(key, keymap);
+    }
+    return keymap;
+}
+
+xkb_keymap *Xkb::cachedKeymap(const QByteArray &key)
+{
+    auto it = std::ranges::find(m_keymapCache, key, &CachedKeymap::key);
+    if (it == m_keymapCache.end()) {
+        return nullptr;
+    }
+    std::rotate(m_keymapCache.begin(), it, it + 1);
+    return xkb_keymap_ref(m_keymapCache.front().keymap);
+}
+
+void Xkb::cacheKeymap(const QByteArray &key, xkb_keymap *keymap)
+{
+    static constexpr size_t s_maxCachedKeymaps = 4;
+    if (m_keymapCache.size() == s_maxCachedKeymaps) {
+        xkb_keymap_unref(m_keymapCache.back().keymap);
+        m_keymapCache.pop_back();
+    }
+    QByteArray contents;
+    if (UniqueCPtr<char> keymapString{xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1)}) {
+        contents = keymapString.get();
+    }
+    m_keymapCache.insert(m_keymapCache.begin(), CachedKeymap{key, xkb_keymap_ref(keymap), contents});
 }
 
 void Xkb::updateKeymap(xkb_keymap *keymap)
@@ -746,6 +795,12 @@ QByteArray Xkb::keymapContents() const
     if (!m_keymap) {
         return {};
     }
+    // the cache holds a reference, so a keymap in there can't have been replaced by another
+    // one at the same address
+    const auto it = std::ranges::find(m_keymapCache, m_keymap, &CachedKeymap::keymap);
+    if (it != m_keymapCache.end() && !it->contents.isEmpty()) {
+        return it->contents;
+    }
 
     UniqueCPtr<char> keymapString(xkb_keymap_get_as_string(m_keymap, XKB_KEYMAP_FORMAT_TEXT_V1));
     if (!keymapString) {
@@ -773,7 +828,7 @@ void Xkb::updateKey(uint32_t key, KeyboardKeyState state)
         return;
     }
     const auto sym = toKeysym(key);
-    xkb_state_update_key(m_state, key + EVDEV_OFFSET, static_cast<xkb_key_direction>(state));
+    const xkb_state_component changed = xkb_state_update_key(m_state, key + EVDEV_OFFSET, static_cast<xkb_key_direction>(state));
     if (m_compose.state) {
         if (state == KeyboardKeyState::Pressed) {
             xkb_compose_state_feed(m_compose.state, sym);
@@ -792,7 +847,13 @@ void Xkb::updateKey(uint32_t key, KeyboardKeyState state)
     } else {
         m_keysym = sym;
     }
-    updateModifiers();
+    if (changed) {
+        updateModifiers();
+    } else {
+        // most keys don't change the modifier, layout or led state, only the keypad modifier
+        // depends on the key itself
+        m_modifiers.setFlag(Qt::KeypadModifier, m_keysym >= XKB_KEY_KP_Space && m_keysym <= XKB_KEY_KP_Equal);
+    }
     updateConsumedModifiers(key);
 }
 
@@ -1328,11 +1389,10 @@ QByteArray Xkb::keymapContentsForKeysym(xkb_keycode_t newKeycode, xkb_keysym_t c
     if (!keymap) {
         return {};
     }
-    UniqueCPtr<char> keymapString(xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1));
-    if (!keymapString) {
-        return {};
-    }
-    return keymapString.get();
+    const auto it = std::ranges::find(m_keymapCache, keymap, &CachedKeymap::keymap);
+    const QByteArray contents = it != m_keymapCache.end() ? it->contents : QByteArray();
+    xkb_keymap_unref(keymap);
+    return contents;
 }
 
 bool Xkb::updateToKeymapForKeySym(xkb_keycode_t newKeycode, xkb_keysym_t customSym)
@@ -1356,6 +1416,11 @@ xkb_keymap *Xkb::createKeymapForKeysym(xkb_keycode_t newKeycode,
 
     const int keycode = newKeycode + EVDEV_OFFSET;
 
+    const QByteArray key = QByteArrayLiteral("custom:") + QByteArray::number(keycode) + ':' + symName;
+    if (xkb_keymap *keymap = cachedKeymap(key)) {
+        return keymap;
+    }
+
     const QString keyMapString = QString::asprintf(
         R"eof(xkb_keymap {
   xkb_keycodes "custom" {
@@ -1381,6 +1446,7 @@ xkb_keymap *Xkb::createKeymapForKeysym(xkb_keycode_t newKeycode,
         qWarning() << "Could not create new keymap for keysym" << customSym;
         return {};
     }
+    cacheKeymap(key, newMap);
     return newMap;
 }
 }
@@ -17,6 +17,7 @@
 #include <QLoggingCategory>
 
 #include <optional>
+#include <vector>
 
 Q_DECLARE_LOGGING_CATEGORY(KWIN_XKB)
 
@@ -166,6 +167,9 @@ private:
     xkb_keymap *loadDefaultKeymap();
     xkb_keymap *loadKeymapFromLocale1();
     xkb_keymap *createKeymapForKeysym(xkb_keycode_t newKeycode, xkb_keysym_t customSym);
+    xkb_keymap *compileKeymap(const xkb_rule_names &ruleNames);
+    xkb_keymap *cachedKeymap(const QByteArray &key);
+    void cacheKeymap(const QByteArray &key, xkb_keymap *keymap);
     void updateKeymap(xkb_keymap *keymap);
     void createKeymapFile();
     void updateModifiers();
@@ -207,6 +211,16 @@ private:
         xkb_mod_index_t locked = 0;
     } m_modifierState;
 
+    struct CachedKeymap
+    {
+        QByteArray key;
+        xkb_keymap *keymap;
+        QByteArray contents;
+    };
+    // the most recently used keymaps, the last one first, so reconfiguring or going back
+    // from a temporary keymap doesn't need to compile and serialize the keymap again
+    std::vector<CachedKeymap> m_keymapCache;
+
     QPointer<SeatInterface> m_seat;
     const bool m_followLocale1;
 };
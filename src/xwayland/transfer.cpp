@@ -25,8 +25,22 @@ namespace KWin
 namespace Xwl
 {
 
-// in Bytes: equals 64KB
-static const uint32_t s_incrChunkSize = 63 * 1024;
+// in Bytes: equals 64KB, that always fits into a single request
+static const uint32_t s_minIncrChunkSize = 63 * 1024;
+// in Bytes: bigger chunks don't save noticeably more round trips
+static const uint32_t s_maxIncrChunkSize = 1024 * 1024;
+// the wayland source is not read further ahead than this many chunks of the requestor
+static const int s_maxPendingChunks = 2;
+
+static uint32_t incrChunkSize()
+{
+    // the maximum request length is in units of 4 bytes, leave some room for the request header
+    const uint64_t maximumRequestLength = uint64_t(xcb_get_maximum_request_length(kwinApp()->x11Connection())) * 4;
+    if (maximumRequestLength <= s_minIncrChunkSize + 1024) {
+        return s_minIncrChunkSize;
+    }
+    return std::min<uint64_t>(maximumRequestLength - 1024, s_maxIncrChunkSize);
+}
 
 Transfer::Transfer(xcb_atom_t selection, FileDescriptor fd, xcb_timestamp_t timestamp, QObject *parent)
     : QObject(parent)
@@ -64,6 +78,7 @@ void Transfer::endTransfer()
 TransferWltoX::TransferWltoX(const xcb_selection_request_event_t &request, FileDescriptor fd, QObject *parent)
     : Transfer(request.selection, std::move(fd), 0, parent)
     , m_request(request)
+    , m_chunkSize(incrChunkSize())
 {
 }
 
@@ -117,7 +132,7 @@ void TransferWltoX::startIncr()
     }
 
     // spec says to make the available space larger
-    const uint32_t chunkSpace = 1024 + s_incrChunkSize;
+    const uint32_t chunkSpace = 1024 + m_chunkSize;
     xcb_change_property(xcbConn,
                         XCB_PROP_MODE_REPLACE,
                         m_request.requestor,
@@ -135,16 +150,16 @@ void TransferWltoX::startIncr()
 
 void TransferWltoX::readWlSource()
 {
-    if (m_chunks.size() == 0 || m_chunks.last().second == s_incrChunkSize) {
+    if (m_chunks.size() == 0 || m_chunks.last().second == int(m_chunkSize)) {
         // append new chunk
         auto next = QPair<QByteArray, int>();
-        next.first.resize(s_incrChunkSize);
+        next.first.resize(m_chunkSize);
         next.second = 0;
         m_chunks.append(next);
     }
 
     const auto oldLen = m_chunks.last().second;
-    const auto avail = s_incrChunkSize - m_chunks.last().second;
+    const auto avail = m_chunkSize - m_chunks.last().second;
     Q_ASSERT(avail > 0);
 
     ssize_t readLen = read(fd(), m_chunks.last().first.data() + oldLen, avail);
@@ -176,7 +191,7 @@ void TransferWltoX::readWlSource()
             Selection::sendSelectionNotify(&m_request, true);
             endTransfer();
         }
-    } else if (m_chunks.last().second == s_incrChunkSize) {
+    } else if (m_chunks.last().second == int(m_chunkSize)) {
         // first chunk full, but not yet at fd end -> go incremental
         if (incr()) {
             m_flushPropertyOnDelete = true;
@@ -184,6 +199,10 @@ void TransferWltoX::readWlSource()
                 // flush if target's property is not set at the moment
                 flushSourceData();
             }
+            if (m_chunks.size() >= s_maxPendingChunks) {
+                // the requestor is slower than the source, don't buffer the whole selection
+                socketNotifier()->setEnabled(false);
+            }
         } else {
             // starting incremental transfer
             startIncr();
@@ -232,6 +251,9 @@ void TransferWltoX::handlePropertyDelete()
             endTransfer();
         } else if (!m_chunks.isEmpty()) {
             flushSourceData();
+            if (socketNotifier()) {
+                socketNotifier()->setEnabled(true);
+            }
         }
     }
 }
@@ -115,6 +115,7 @@ private:
      * TODO: explain second QPair component
      */
     QList<QPair<QByteArray, int>> m_chunks;
+    const uint32_t m_chunkSize;
 
     bool m_propertyIsSet = false;
     bool m_flushPropertyOnDelete = false;
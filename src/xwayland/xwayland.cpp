@@ -21,6 +21,7 @@
 #include "core/backendoutput.h"
 #include "keyboard_input.h"
 #include "main_wayland.h"
+#include "utils/c_ptr.h"
 #include "utils/common.h"
 #include "utils/xcbutils.h"
 #include "wayland/display.h"
@@ -87,7 +88,7 @@ class XwaylandInputFilter : public QObject, public KWin::InputEventFilter
 {
 public:
     XwaylandInputFilter()
-        : KWin::InputEventFilter(InputFilterOrder::XWayland)
+        : KWin::InputEventFilter(InputFilterOrder::XWayland, KWin::InputEventType::Pointer | KWin::InputEventType::Keyboard)
     {
         connect(waylandServer()->seat(), &SeatInterface::focusedKeyboardSurfaceAboutToChange,
                 this, [this](SurfaceInterface *newSurface) {
@@ -396,12 +397,35 @@ void Xwayland::dispatchEvents(DispatchEventsMode mode)
 
     auto pollEventFunc = mode == DispatchEventsMode::Poll ? xcb_poll_for_event : xcb_poll_for_queued_event;
 
+    std::vector<UniqueCPtr<xcb_generic_event_t>> events;
     while (xcb_generic_event_t *event = pollEventFunc(connection)) {
-        qintptr result = 0;
+        events.emplace_back(event);
+    }
+
+    // The property handlers read the current value of the property from the server, so if a
+    // client changes a property many times in a row, only the last notification needs to be
+    // handled. Deletions are not coalesced, incremental selection transfers rely on each of them.
+    QHash<std::pair<xcb_window_t, xcb_atom_t>, size_t> lastPropertyChange;
+    for (size_t i = 0; i < events.size(); ++i) {
+        if ((events[i]->response_type & ~0x80) == XCB_PROPERTY_NOTIFY) {
+            const auto propertyEvent = reinterpret_cast<xcb_property_notify_event_t *>(events[i].get());
+            if (propertyEvent->state == XCB_PROPERTY_NEW_VALUE) {
+                lastPropertyChange[std::make_pair(propertyEvent->window, propertyEvent->atom)] = i;
+            }
+        }
+    }
 
-        QAbstractEventDispatcher *dispatcher = QCoreApplication::eventDispatcher();
-        dispatcher->filterNativeEvent(QByteArrayLiteral("xcb_generic_event_t"), event, &result);
-        free(event);
+    QAbstractEventDispatcher *dispatcher = QCoreApplication::eventDispatcher();
+    for (size_t i = 0; i < events.size(); ++i) {
+        if ((events[i]->response_type & ~0x80) == XCB_PROPERTY_NOTIFY) {
+            const auto propertyEvent = reinterpret_cast<xcb_property_notify_event_t *>(events[i].get());
+            if (propertyEvent->state == XCB_PROPERTY_NEW_VALUE && lastPropertyChange[std::make_pair(propertyEvent->window, propertyEvent->atom)] != i) {
+                continue;
+            }
+        }
+
+        qintptr result = 0;
+        dispatcher->filterNativeEvent(QByteArrayLiteral("xcb_generic_event_t"), events[i].get(), &result);
     }
 
     xcb_flush(connection);